@@ -23,11 +23,7 @@ int main(int argc, char* argv[]) {
   printf(" Clustering...");            TSnap::GetNodeClustCf(UGraph, CcfH);
   printf(" Betweenness (SLOW!)...");   TSnap::GetBetweennessCentr(UGraph, BtwH, 1);
   printf(" Constraint (SLOW!)...");    TNetConstraint<PUNGraph> NetC(UGraph, true);
-  printf(" Closeness (SLOW!)...");
-  for (TUNGraph::TNodeI NI = UGraph->BegNI(); NI < UGraph->EndNI(); NI++) {
-    const int NId = NI.GetId();
-    CloseH.AddDat(NId, TSnap::GetClosenessCentr<PUNGraph>(UGraph, NId, false));
-  }
+  printf(" Closeness...");             TSnap::GetClosenessCentr(UGraph, CloseH, false);
   printf("\nDONE! saving...");
   FILE *F = fopen(OutFNm.CStr(), "wt");
   fprintf(F,"#Network: %s\n", InFNm.CStr());
@@ -184,9 +184,11 @@
 #include "bits.h"
 #include "hash.h"
 #include "hashmp.h"
+#include "hashflat.h"
 #include "xml.h"
 
 #include "xmath.h"
+#include "vecarena.h"
 #include "xmlser.h"
 
 #include "unicode.h"
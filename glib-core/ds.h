@@ -825,7 +825,8 @@ TStr TVec<TVal, TSizeTy>::GetXOutOfBoundsErrMsg(const TSizeTy& ValN) const {
 
 template <class TVal, class TSizeTy>
 TVec<TVal, TSizeTy>::TVec(const TVec<TVal, TSizeTy>& Vec){
-  MxVals=Vec.MxVals;
+  // a copy of an external vector (MxVals==-1) owns its values
+  MxVals=(Vec.MxVals==-1) ? Vec.Vals : Vec.MxVals;
   Vals=Vec.Vals;
   if (MxVals==0) {ValT=NULL;} else {ValT=new TVal[MxVals];}
   for (TSizeTy ValN=0; ValN<Vec.Vals; ValN++){ValT[ValN]=Vec.ValT[ValN];}
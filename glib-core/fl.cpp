@@ -1398,7 +1398,11 @@ uint64 TFile::GetLastWriteTm(const TStr& FNm) {
 #elif defined(GLib_LINUX)
 
 uint64 TFile::GetSize(const TStr& FNm) {
-	Fail; return 0;
+	struct stat st;
+	if (stat(FNm.CStr(), &st) != 0) {
+		TExcept::Throw("Cannot read size of file " + FNm + "!");
+	}
+	return uint64(st.st_size);
 }
 
 uint64 TFile::GetCreateTm(const TStr& FNm) {
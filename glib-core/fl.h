@@ -394,6 +394,8 @@ public:
     ~TShMIn() {}
     bool Eof() { return SizeLeft<=0; }
     int Len() const { return TotalLength; }
+    /// Number of bytes after the cursor
+    TSize GetSizeLeft() const { return SizeLeft; }
     char GetCh() {
       char c;
       LoadAndAdvance(&c, sizeof(c));
@@ -0,0 +1,517 @@
+#ifndef hashflat_h
+#define hashflat_h
+
+#include "bd.h"
+
+/////////////////////////////////////////////////
+// Flat-Hash-Table
+//
+// THashFlat keeps the keys and data of THash in the same dense KeyDatV with
+// the same free list, so key ids, iteration order, iterators and the file
+// format are those of THash. Only the index is different: instead of ports
+// with chains through KeyDatV it is an open addressing table of groups of
+// 8 slots. Every slot has a 1-byte control (empty, deleted, or 7 bits of the
+// key hash) and the key id. The 8 controls of a group are one 64-bit word
+// and are matched at once (SIMD within a register), so a lookup reads one
+// group and, on a tag match, the key in KeyDatV. Groups are probed
+// quadratically; the table has a power of two groups and a load <= 7/8.
+
+//#//////////////////////////////////////////////
+/// Flat hash table with the interface of THash.
+template<class TKey, class TDat, class THashFunc = TDefaultHashFunc<TKey> >
+class THashFlat {
+public:
+  typedef THashKeyDatI<TKey, TDat> TIter;
+private:
+  typedef THashKeyDat<TKey, TDat> THKeyDat;
+  class TGroup {
+  public:
+    enum { Slots=8, CtrlEmpty=0x80, CtrlDel=0xFE };
+    uint64 Ctrl;
+    int KeyIdT[Slots];
+  public:
+    TGroup() : Ctrl(GetLsb()*CtrlEmpty) { for (int i = 0; i < Slots; i++) { KeyIdT[i] = -1; } }
+    static uint64 GetLsb() { return ~uint64(0)/0xFF; }
+    static uint64 GetMsb() { return GetLsb() << 7; }
+    /// Slots whose control is Cd, as the high bits of their bytes.
+    uint64 Match(const uint Cd) const {
+      const uint64 X = Ctrl ^ (GetLsb()*Cd);
+      return ~(((X & ~GetMsb()) + ~GetMsb()) | X | ~GetMsb()); }
+    uint64 MatchEmpty() const { return Ctrl & ~(Ctrl << 6) & GetMsb(); }
+    uint64 MatchFree() const { return Ctrl & GetMsb(); }
+    uint GetCtrl(const int& SlotN) const { return uint(Ctrl >> (8*SlotN)) & 0xFF; }
+    void SetCtrl(const int& SlotN, const uint Cd) {
+      Ctrl = (Ctrl & ~(uint64(0xFF) << (8*SlotN))) | (uint64(Cd) << (8*SlotN)); }
+  };
+  class THashKeyDatCmp {
+  public:
+    const THashFlat<TKey, TDat, THashFunc>& Hash;
+    bool CmpKey, Asc;
+    THashKeyDatCmp(THashFlat<TKey, TDat, THashFunc>& _Hash, const bool& _CmpKey, const bool& _Asc) :
+      Hash(_Hash), CmpKey(_CmpKey), Asc(_Asc) { }
+    bool operator () (const int& KeyId1, const int& KeyId2) const {
+      if (CmpKey) {
+        if (Asc) { return Hash.GetKey(KeyId1) < Hash.GetKey(KeyId2); }
+        else { return Hash.GetKey(KeyId2) < Hash.GetKey(KeyId1); } }
+      else {
+        if (Asc) { return Hash[KeyId1] < Hash[KeyId2]; }
+        else { return Hash[KeyId2] < Hash[KeyId1]; } } }
+  };
+  template<typename TDatInitFn>
+  class TLoadTHKeyDatInitializer {
+  private:
+    TDatInitFn DatInitFn;
+  public:
+    TLoadTHKeyDatInitializer(TDatInitFn Fn) { DatInitFn = Fn;}
+    void operator() (THKeyDat* HKeyDat, TShMIn& ShMIn) { HKeyDat->LoadShM(ShMIn, DatInitFn);}
+  };
+private:
+  TVec<TGroup> GroupV;
+  TVec<THKeyDat> KeyDatV;
+  TBool AutoSizeP;
+  TInt FFreeKeyId, FreeKeys;
+  TInt GroupBits, IdxKeys, IdxDels; // log2 of the groups, full and deleted slots of the index
+private:
+  /// Slot of the lowest byte set in a match.
+  static int GetMatchSlot(const uint64& Match) {
+#ifdef GLib_GCC
+    return __builtin_ctzll(Match) >> 3;
+#else
+    int SlotN = 0;
+    while (((Match >> (8*SlotN+7)) & 1) == 0) { SlotN++; }
+    return SlotN;
+#endif
+  }
+  /// Fibonacci hashing of the primary hash code: the high bits select the group, middle bits are the 7-bit tag.
+  static uint64 GetHash(const TKey& Key) {
+    const uint64 Mul = (uint64(0x9E3779B9) << 32) | uint64(0x7F4A7C15);
+    return uint64(uint(THashFunc::GetPrimHashCd(Key))) * Mul; }
+  int GetGroupN(const uint64& Hash) const { return int(Hash >> (64-GroupBits)); }
+  static uint GetTag(const uint64& Hash) { return uint(Hash >> 24) & 0x7F; }
+  THKeyDat& GetHashKeyDat(const int& KeyId){
+    THKeyDat& KeyDat=KeyDatV[KeyId];
+    Assert(KeyDat.HashCd!=-1); return KeyDat;}
+  const THKeyDat& GetHashKeyDat(const int& KeyId) const {
+    const THKeyDat& KeyDat=KeyDatV[KeyId];
+    Assert(KeyDat.HashCd!=-1); return KeyDat;}
+  /// Finds the group and slot of Key in the index, returns false if Key is not in the table.
+  bool FindSlot(const TKey& Key, const uint64& Hash, int& GroupN, int& SlotN) const;
+  /// Rebuilds the index for at least ExpectVals keys from KeyDatV.
+  void GenIdx(const int& ExpectVals);
+  void AddIdx(const int& KeyId, const uint64& Hash);
+  /// Removes the slot from the index and puts its key id on the free list.
+  int DelIdx(const int& GroupN, const int& SlotN);
+public:
+  THashFlat():
+    GroupV(), KeyDatV(), AutoSizeP(true), FFreeKeyId(-1), FreeKeys(0),
+    GroupBits(0), IdxKeys(0), IdxDels(0){}
+  THashFlat(const THashFlat& Hash):
+    GroupV(Hash.GroupV), KeyDatV(Hash.KeyDatV), AutoSizeP(Hash.AutoSizeP),
+    FFreeKeyId(Hash.FFreeKeyId), FreeKeys(Hash.FreeKeys),
+    GroupBits(Hash.GroupBits), IdxKeys(Hash.IdxKeys), IdxDels(Hash.IdxDels){}
+  /// The table always grows as needed, AutoSizeP is only kept for the file format of THash.
+  explicit THashFlat(const int& ExpectVals, const bool& _AutoSizeP=false):
+    GroupV(), KeyDatV(ExpectVals, 0), AutoSizeP(_AutoSizeP), FFreeKeyId(-1), FreeKeys(0),
+    GroupBits(0), IdxKeys(0), IdxDels(0){ GenIdx(ExpectVals); }
+  /// Loads a THash or THashFlat saved with Save().
+  explicit THashFlat(TSIn& SIn):
+    GroupV(), KeyDatV(), GroupBits(0), IdxKeys(0), IdxDels(0){ Load(SIn); }
+  void Load(TSIn& SIn){
+    TIntV PortV(SIn); KeyDatV.Load(SIn);
+    AutoSizeP=TBool(SIn); FFreeKeyId=TInt(SIn); FreeKeys=TInt(SIn);
+    SIn.LoadCs();
+    GenIdx(Len());}
+  /// Load THashFlat from shared memory passing in the Dat initializer. Copying/Deleting Keys is illegal.
+  template <typename TDatInitFn>
+  void LoadShM(TShMIn& ShMIn, TDatInitFn Fn) {
+    TLoadTHKeyDatInitializer<TDatInitFn> HKeyDatFn(Fn);
+    TIntV PortV;  PortV.LoadShM(ShMIn);
+    KeyDatV.LoadShM(ShMIn, HKeyDatFn);
+    AutoSizeP=TBool(ShMIn);
+    FFreeKeyId=TInt(ShMIn);
+    FreeKeys=TInt(ShMIn);
+    ShMIn.LoadCs();
+    GenIdx(Len());
+  }
+  /// Saves in the format of THash, so that THash and THashFlat load each other's files.
+  void Save(TSOut& SOut) const;
+
+  THashFlat& operator=(const THashFlat& Hash){
+    if (this!=&Hash){
+      GroupV=Hash.GroupV; KeyDatV=Hash.KeyDatV; AutoSizeP=Hash.AutoSizeP;
+      FFreeKeyId=Hash.FFreeKeyId; FreeKeys=Hash.FreeKeys;
+      GroupBits=Hash.GroupBits; IdxKeys=Hash.IdxKeys; IdxDels=Hash.IdxDels;}
+    return *this;}
+  bool operator==(const THashFlat& Hash) const;
+  bool operator < (const THashFlat& Hash) const { Fail; return true; }
+  /// The [] operator takes KeyId, use GetDat() if you need value access via the key.
+  const TDat& operator[](const int& KeyId) const {return GetHashKeyDat(KeyId).Dat;}
+  TDat& operator[](const int& KeyId){return GetHashKeyDat(KeyId).Dat;}
+  TDat& operator()(const TKey& Key){return AddDat(Key);}
+  ::TSize GetMemUsed() const {
+    int64 MemUsed = sizeof(bool)+5*sizeof(int);
+    MemUsed += int64(GroupV.Reserved()) * int64(sizeof(TGroup));
+    for (int KeyDatN = 0; KeyDatN < KeyDatV.Len(); KeyDatN++) {
+      MemUsed += int64(2 * sizeof(TInt));
+      MemUsed += int64(KeyDatV[KeyDatN].Key.GetMemUsed());
+      MemUsed += int64(KeyDatV[KeyDatN].Dat.GetMemUsed());
+    }
+    return ::TSize(MemUsed);
+  }
+
+  TIter BegI() const {
+    if (Len() == 0){return TIter(KeyDatV.EndI(), KeyDatV.EndI());}
+    if (IsKeyIdEqKeyN()) { return TIter(KeyDatV.BegI(), KeyDatV.EndI());}
+    int FKeyId=-1;  FNextKeyId(FKeyId);
+    return TIter(KeyDatV.BegI()+FKeyId, KeyDatV.EndI()); }
+  TIter EndI() const {return TIter(KeyDatV.EndI(), KeyDatV.EndI());}
+  TIter GetI(const TKey& Key) const {return TIter(&KeyDatV[GetKeyId(Key)], KeyDatV.EndI());}
+
+  void Gen(const int& ExpectVals){
+    KeyDatV.Gen(ExpectVals, 0); FFreeKeyId=-1; FreeKeys=0; GenIdx(ExpectVals);}
+
+  void Clr(const bool& DoDel=true, const int& NoDelLim=-1, const bool& ResetDat=true);
+  bool Empty() const {return Len()==0;}
+  int Len() const {return KeyDatV.Len()-FreeKeys;}
+  /// Number of slots of the index.
+  int GetSlots() const {return GroupV.Len()*TGroup::Slots;}
+  bool IsAutoSize() const {return AutoSizeP;}
+  int GetMxKeyIds() const {return KeyDatV.Len();}
+  int GetReservedKeyIds() const {return KeyDatV.Reserved();}
+  bool IsKeyIdEqKeyN() const {return FreeKeys==0;}
+
+  int AddKey(const TKey& Key);
+  TDat& AddDatId(const TKey& Key){
+    int KeyId=AddKey(Key); return KeyDatV[KeyId].Dat=KeyId;}
+  TDat& AddDat(const TKey& Key){return KeyDatV[AddKey(Key)].Dat;}
+  TDat& AddDat(const TKey& Key, const TDat& Dat){
+    return KeyDatV[AddKey(Key)].Dat=Dat;}
+
+  void DelKey(const TKey& Key);
+  bool DelIfKey(const TKey& Key){
+    int KeyId; if (IsKey(Key, KeyId)){DelKeyId(KeyId); return true;} return false;}
+  void DelKeyId(const int& KeyId){DelKey(GetKey(KeyId));}
+  void DelKeyIdV(const TIntV& KeyIdV){
+    for (int KeyIdN=0; KeyIdN<KeyIdV.Len(); KeyIdN++){DelKeyId(KeyIdV[KeyIdN]);}}
+
+  void MarkDelKey(const TKey& Key); // marks the record as deleted - doesn't delete Dat (to avoid fragmentation)
+  void MarkDelKeyId(const int& KeyId){MarkDelKey(GetKey(KeyId));}
+
+  const TKey& GetKey(const int& KeyId) const { return GetHashKeyDat(KeyId).Key;}
+  int GetKeyId(const TKey& Key) const {
+    int GroupN, SlotN;
+    return FindSlot(Key, GetHash(Key), GroupN, SlotN) ? GroupV[GroupN].KeyIdT[SlotN] : -1;}
+  /// Get an index of a random element. If the hash table has many deleted keys, this may take a long time.
+  int GetRndKeyId(TRnd& Rnd) const;
+  /// Get an index of a random element. If the hash table has many deleted keys, defrag the hash table first (that's why the function is non-const).
+  int GetRndKeyId(TRnd& Rnd, const double& EmptyFrac);
+  bool IsKey(const TKey& Key) const {return GetKeyId(Key)!=-1;}
+  bool IsKey(const TKey& Key, int& KeyId) const { KeyId=GetKeyId(Key); return KeyId!=-1;}
+  bool IsKeyId(const int& KeyId) const {
+    return (0<=KeyId)&&(KeyId<KeyDatV.Len())&&(KeyDatV[KeyId].HashCd!=-1);}
+  const TDat& GetDat(const TKey& Key) const {return KeyDatV[GetKeyId(Key)].Dat;}
+  TDat& GetDat(const TKey& Key){return KeyDatV[GetKeyId(Key)].Dat;}
+  TDat GetDatWithDefault(const TKey& Key, TDat DefaultValue) {
+    int KeyId = GetKeyId(Key);
+    return KeyId != -1 ? GetHashKeyDat(KeyId).Dat : DefaultValue; }
+  void GetKeyDat(const int& KeyId, TKey& Key, TDat& Dat) const {
+    const THKeyDat& KeyDat=GetHashKeyDat(KeyId);
+    Key=KeyDat.Key; Dat=KeyDat.Dat;}
+  bool IsKeyGetDat(const TKey& Key, TDat& Dat) const {int KeyId;
+    if (IsKey(Key, KeyId)){Dat=GetHashKeyDat(KeyId).Dat; return true;}
+    else {return false;}}
+
+  int FFirstKeyId() const {return 0-1;}
+  bool FNextKeyId(int& KeyId) const {
+    do {KeyId++;} while ((KeyId<KeyDatV.Len()) && (KeyDatV[KeyId].HashCd==-1));
+    return KeyId<KeyDatV.Len();}
+  void GetKeyV(TVec<TKey>& KeyV) const;
+  void GetDatV(TVec<TDat>& DatV) const;
+  void GetKeyDatPrV(TVec<TPair<TKey, TDat> >& KeyDatPrV) const;
+  void GetDatKeyPrV(TVec<TPair<TDat, TKey> >& DatKeyPrV) const;
+  void GetKeyDatKdV(TVec<TKeyDat<TKey, TDat> >& KeyDatKdV) const;
+  void GetDatKeyKdV(TVec<TKeyDat<TDat, TKey> >& DatKeyKdV) const;
+
+  void Swap(THashFlat& Hash);
+  void Defrag();
+  void Pack(){KeyDatV.Pack();}
+  void Sort(const bool& CmpKey, const bool& Asc);
+  void SortByKey(const bool& Asc=true) { Sort(true, Asc); }
+  void SortByDat(const bool& Asc=true) { Sort(false, Asc); }
+};
+
+template<class TKey, class TDat, class THashFunc>
+bool THashFlat<TKey, TDat, THashFunc>::FindSlot(const TKey& Key, const uint64& Hash, int& GroupN, int& SlotN) const {
+  if (GroupV.Empty()) { return false; }
+  const uint Tag = GetTag(Hash);
+  const int GroupMask = GroupV.Len()-1;
+  GroupN = GetGroupN(Hash);
+  for (int Step = 1; ; Step++) {
+    const TGroup& Group = GroupV[GroupN];
+    for (uint64 Match = Group.Match(Tag); Match != 0; Match &= Match-1) {
+      SlotN = GetMatchSlot(Match);
+      if (KeyDatV[Group.KeyIdT[SlotN]].Key == Key) { return true; }
+    }
+    if (Group.MatchEmpty() != 0) { return false; }
+    GroupN = (GroupN + Step) & GroupMask;
+  }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::AddIdx(const int& KeyId, const uint64& Hash) {
+  const int GroupMask = GroupV.Len()-1;
+  int GroupN = GetGroupN(Hash);
+  for (int Step = 1; ; Step++) {
+    TGroup& Group = GroupV[GroupN];
+    const uint64 Match = Group.MatchFree();
+    if (Match != 0) {
+      const int SlotN = GetMatchSlot(Match);
+      if (Group.GetCtrl(SlotN) == TGroup::CtrlDel) { IdxDels--; }
+      Group.SetCtrl(SlotN, GetTag(Hash));
+      Group.KeyIdT[SlotN] = KeyId;
+      IdxKeys++;
+      return;
+    }
+    GroupN = (GroupN + Step) & GroupMask;
+  }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GenIdx(const int& ExpectVals) {
+  int Bits = 1;
+  while (int64(TGroup::Slots) * 7 * (int64(1) << Bits) < int64(ExpectVals) * 8) { Bits++; }
+  GroupBits = Bits;
+  GroupV.Gen(1 << Bits);
+  IdxKeys = 0;  IdxDels = 0;
+  for (int KeyId = 0; KeyId < KeyDatV.Len(); KeyId++) {
+    if (KeyDatV[KeyId].HashCd != -1) { AddIdx(KeyId, GetHash(KeyDatV[KeyId].Key)); }
+  }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::Save(TSOut& SOut) const {
+  // ports and chains of THash over KeyDatV, as THash would have them after a resize
+  uint Ports = 17;
+  for (int p = 0; p < THash<TKey, TDat, THashFunc>::HashPrimes; p++) {
+    Ports = THash<TKey, TDat, THashFunc>::HashPrimeT[p];
+    if (Ports >= uint(KeyDatV.Len()/2)) { break; }
+  }
+  TIntV PortV(Ports), NextV(KeyDatV.Len());
+  PortV.PutAll(TInt(-1));
+  for (int KeyId = 0; KeyId < KeyDatV.Len(); KeyId++) {
+    const THKeyDat& KeyDat = KeyDatV[KeyId];
+    if (KeyDat.HashCd == -1) { NextV[KeyId] = KeyDat.Next; continue; }
+    const int PortN = abs(THashFunc::GetPrimHashCd(KeyDat.Key) % PortV.Len());
+    NextV[KeyId] = PortV[PortN];
+    PortV[PortN] = KeyId;
+  }
+  PortV.Save(SOut);
+  // KeyDatV as TVec::Save() writes it
+  SOut.Save(KeyDatV.Len());  SOut.Save(KeyDatV.Len());
+  for (int KeyId = 0; KeyId < KeyDatV.Len(); KeyId++) {
+    const THKeyDat& KeyDat = KeyDatV[KeyId];
+    NextV[KeyId].Save(SOut); KeyDat.HashCd.Save(SOut); KeyDat.Key.Save(SOut); KeyDat.Dat.Save(SOut);
+  }
+  AutoSizeP.Save(SOut); FFreeKeyId.Save(SOut); FreeKeys.Save(SOut);
+  SOut.SaveCs();
+}
+
+template<class TKey, class TDat, class THashFunc>
+bool THashFlat<TKey, TDat, THashFunc>::operator==(const THashFlat& Hash) const {
+  if (Len() != Hash.Len()) { return false; }
+  for (int i = FFirstKeyId(); FNextKeyId(i); ) {
+    const TKey& Key = GetKey(i);
+    if (! Hash.IsKey(Key)) { return false; }
+    if (GetDat(Key) != Hash.GetDat(Key)) { return false; }
+  }
+  return true;
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::Clr(const bool& DoDel, const int& NoDelLim, const bool& ResetDat){
+  if (DoDel){
+    GroupV.Clr(); KeyDatV.Clr();
+    GroupBits=0; IdxKeys=0; IdxDels=0;
+  } else {
+    KeyDatV.Clr(DoDel, NoDelLim);
+    if (ResetDat){KeyDatV.PutAll(THKeyDat());}
+    GenIdx(0);
+  }
+  FFreeKeyId=TInt(-1); FreeKeys=TInt(0);
+}
+
+template<class TKey, class TDat, class THashFunc>
+int THashFlat<TKey, TDat, THashFunc>::AddKey(const TKey& Key){
+  const uint64 Hash = GetHash(Key);
+  int GroupN, SlotN;
+  if (FindSlot(Key, Hash, GroupN, SlotN)) { return GroupV[GroupN].KeyIdT[SlotN]; }
+  // grow when full and deleted slots would exceed 7/8 of the index, or only drop the deleted slots
+  if (8 * (IdxKeys+IdxDels+1) > 7 * GetSlots()) {
+    GenIdx(16 * (IdxKeys+1) > 7 * GetSlots() ? 2 * (IdxKeys+1) : IdxKeys+1); }
+  const int HashCd=abs(THashFunc::GetSecHashCd(Key));
+  int KeyId;
+  if (FFreeKeyId==-1){
+    KeyId=KeyDatV.Add(THKeyDat(-1, HashCd, Key));
+  } else {
+    KeyId=FFreeKeyId; FFreeKeyId=KeyDatV[FFreeKeyId].Next; FreeKeys--;
+    KeyDatV[KeyId].Next=-1;
+    KeyDatV[KeyId].HashCd=HashCd;
+    KeyDatV[KeyId].Key=Key;
+  }
+  AddIdx(KeyId, Hash);
+  return KeyId;
+}
+
+template<class TKey, class TDat, class THashFunc>
+int THashFlat<TKey, TDat, THashFunc>::DelIdx(const int& GroupN, const int& SlotN){
+  TGroup& Group = GroupV[GroupN];
+  const int KeyId = Group.KeyIdT[SlotN];
+  // a group that still has an empty slot was never passed by a probe, so its slot can become empty again
+  if (Group.MatchEmpty() != 0) { Group.SetCtrl(SlotN, TGroup::CtrlEmpty); }
+  else { Group.SetCtrl(SlotN, TGroup::CtrlDel);  IdxDels++; }
+  Group.KeyIdT[SlotN] = -1;
+  IdxKeys--;
+  KeyDatV[KeyId].Next=FFreeKeyId; FFreeKeyId=KeyId; FreeKeys++;
+  KeyDatV[KeyId].HashCd=TInt(-1);
+  return KeyId;
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::DelKey(const TKey& Key){
+  int GroupN, SlotN;
+  const bool IsKey = FindSlot(Key, GetHash(Key), GroupN, SlotN);
+  IAssert(IsKey);
+  const int KeyId = DelIdx(GroupN, SlotN);
+  KeyDatV[KeyId].Key=TKey();
+  KeyDatV[KeyId].Dat=TDat();
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::MarkDelKey(const TKey& Key){
+  int GroupN, SlotN;
+  const bool IsKey = FindSlot(Key, GetHash(Key), GroupN, SlotN);
+  IAssert(IsKey);
+  DelIdx(GroupN, SlotN);
+}
+
+template<class TKey, class TDat, class THashFunc>
+int THashFlat<TKey, TDat, THashFunc>::GetRndKeyId(TRnd& Rnd) const  {
+  IAssert(! Empty());
+  int KeyId = abs(Rnd.GetUniDevInt(KeyDatV.Len()));
+  while (KeyDatV[KeyId].HashCd == -1) { // if the index is empty, just try again
+    KeyId = abs(Rnd.GetUniDevInt(KeyDatV.Len())); }
+  return KeyId;
+}
+
+template<class TKey, class TDat, class THashFunc>
+int THashFlat<TKey, TDat, THashFunc>::GetRndKeyId(TRnd& Rnd, const double& EmptyFrac) {
+  IAssert(! Empty());
+  if (FreeKeys/double(Len()+FreeKeys) > EmptyFrac) { Defrag(); }
+  int KeyId = Rnd.GetUniDevInt(KeyDatV.Len());
+  while (KeyDatV[KeyId].HashCd == -1) { // if the index is empty, just try again
+    KeyId = Rnd.GetUniDevInt(KeyDatV.Len());
+  }
+  return KeyId;
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GetKeyV(TVec<TKey>& KeyV) const {
+  KeyV.Gen(Len(), 0);
+  int KeyId=FFirstKeyId();
+  while (FNextKeyId(KeyId)){
+    KeyV.Add(GetKey(KeyId));}
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GetDatV(TVec<TDat>& DatV) const {
+  DatV.Gen(Len(), 0);
+  int KeyId=FFirstKeyId();
+  while (FNextKeyId(KeyId)){
+    DatV.Add(GetHashKeyDat(KeyId).Dat);}
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GetKeyDatPrV(TVec<TPair<TKey, TDat> >& KeyDatPrV) const {
+  KeyDatPrV.Gen(Len(), 0);
+  int KeyId=FFirstKeyId();
+  while (FNextKeyId(KeyId)){
+    KeyDatPrV.Add(TPair<TKey, TDat>(KeyDatV[KeyId].Key, KeyDatV[KeyId].Dat));}
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GetDatKeyPrV(TVec<TPair<TDat, TKey> >& DatKeyPrV) const {
+  DatKeyPrV.Gen(Len(), 0);
+  int KeyId=FFirstKeyId();
+  while (FNextKeyId(KeyId)){
+    DatKeyPrV.Add(TPair<TDat, TKey>(KeyDatV[KeyId].Dat, KeyDatV[KeyId].Key));}
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GetKeyDatKdV(TVec<TKeyDat<TKey, TDat> >& KeyDatKdV) const {
+  KeyDatKdV.Gen(Len(), 0);
+  int KeyId=FFirstKeyId();
+  while (FNextKeyId(KeyId)){
+    KeyDatKdV.Add(TKeyDat<TKey, TDat>(KeyDatV[KeyId].Key, KeyDatV[KeyId].Dat));}
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::GetDatKeyKdV(TVec<TKeyDat<TDat, TKey> >& DatKeyKdV) const {
+  DatKeyKdV.Gen(Len(), 0);
+  int KeyId=FFirstKeyId();
+  while (FNextKeyId(KeyId)){
+    DatKeyKdV.Add(TKeyDat<TDat, TKey>(KeyDatV[KeyId].Dat, KeyDatV[KeyId].Key));}
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::Swap(THashFlat& Hash) {
+  if (this!=&Hash){
+    GroupV.Swap(Hash.GroupV);
+    KeyDatV.Swap(Hash.KeyDatV);
+    ::Swap(AutoSizeP, Hash.AutoSizeP);
+    ::Swap(FFreeKeyId, Hash.FFreeKeyId);
+    ::Swap(FreeKeys, Hash.FreeKeys);
+    ::Swap(GroupBits, Hash.GroupBits);
+    ::Swap(IdxKeys, Hash.IdxKeys);
+    ::Swap(IdxDels, Hash.IdxDels);
+  }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::Defrag(){
+  if (!IsKeyIdEqKeyN()){
+    // keys keep their order, as when THash re-adds them to a new table
+    int NewKeyId = 0;
+    for (int KeyId = 0; KeyId < KeyDatV.Len(); KeyId++) {
+      if (KeyDatV[KeyId].HashCd == -1) { continue; }
+      if (NewKeyId != KeyId) { KeyDatV[NewKeyId] = KeyDatV[KeyId]; }
+      KeyDatV[NewKeyId].Next = -1;
+      NewKeyId++;
+    }
+    KeyDatV.Reduce(NewKeyId);
+    Pack();
+    FFreeKeyId=-1; FreeKeys=0;
+    GenIdx(Len());
+  }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashFlat<TKey, TDat, THashFunc>::Sort(const bool& CmpKey, const bool& Asc) {
+  IAssertR(IsKeyIdEqKeyN(), "THashFlat::Sort only works when table has no deleted keys.");
+  TIntV TargV(Len());
+  for (int i = 0; i < TargV.Len(); i++) { TargV[i] = i; }
+  THashKeyDatCmp HashCmp(*this, CmpKey, Asc);
+  TargV.SortCmp(HashCmp);
+  TVec<THKeyDat> NewKeyDatV(TargV.Len(), 0);
+  for (int i = 0; i < TargV.Len(); i++) { NewKeyDatV.Add(KeyDatV[TargV[i]]); }
+  KeyDatV.Swap(NewKeyDatV);
+  GenIdx(Len());
+}
+
+/////////////////////////////////////////////////
+// Common-Flat-Hash-Types
+typedef THashFlat<TInt, TInt> TIntIntFH;
+typedef THashFlat<TInt, TFlt> TIntFltFH;
+typedef THashFlat<TInt, TIntV> TIntIntVFH;
+typedef THashFlat<TUInt64, TInt> TUInt64IntFH;
+
+#endif
@@ -566,6 +566,309 @@ int THashMP<TKey, TDat, THashFunc>::GetRndKeyId(TRnd& Rnd, const double& EmptyFr
   return 0;
 }
 
+/////////////////////////////////////////////////
+// Growing-Concurrent-Hash-Table
+//
+// THashMP has to be sized up front and its AddKey() can not grow the table.
+// THashMPGrow can be filled from OpenMP loops without knowing the number of
+// keys. Keys and data are stored in segments of doubling size that are never
+// moved, so key ids are dense in the order of insertion and a reference to
+// the data stays valid while the table grows. The index is a separate open
+// addressing table of 64-bit slots (32 bits of the hash and the key id + 1)
+// that are claimed with CAS. Once it is half full, the thread that notices it
+// links an index of twice the size, and the old index is copied in chunks by
+// every thread that touches it (cooperative resize), so no thread ever waits
+// for another. A slot changes only once, from empty to a key or to Moved, and
+// a probe that meets Moved goes on in the next index, so a key is never added
+// twice. Retired indexes are freed by Clr() and the destructor.
+// Keys can not be deleted; concurrent updates of the same data must be
+// synchronized by the caller, e.g. with __sync_fetch_and_add().
+
+//#//////////////////////////////////////////////
+/// Lock-free hash table that grows during concurrent inserts.
+template<class TKey, class TDat, class THashFunc = TDefaultHashFunc<TKey> >
+class THashMPGrow {
+private:
+  enum { SegBits0=10, Segs=22, MnIdxBits=6, MxIdxBits=30, ChunkSlots=1024 };
+  class TKeyDat {
+  public:
+    TInt HashCd; // -1 until the key is in the index
+    TKey Key;
+    TDat Dat;
+  public:
+    TKeyDat() : HashCd(-1), Key(), Dat() { }
+  };
+  class TIdx {
+  public:
+    volatile uint64* SlotV;
+    int Bits, Chunks;
+    volatile int Keys, NextChunk, DoneChunks;
+    TIdx* volatile Next;
+  public:
+    TIdx(const int& _Bits) : SlotV(new uint64[1 << _Bits]), Bits(_Bits),
+     Chunks(_Bits > 10 ? 1 << (_Bits - 10) : 1), Keys(0), NextChunk(0), DoneChunks(0), Next(NULL) {
+      memset((void*) SlotV, 0, sizeof(uint64) << Bits); }
+    ~TIdx() { delete [] SlotV; }
+    int GetSlots() const { return 1 << Bits; }
+    UndefCopyAssign(TIdx);
+  };
+private:
+  TKeyDat* volatile SegV[Segs];
+  TIdx* volatile CurIdx;
+  TIdx* FirstIdx;
+  volatile int KeyIds, NumVals;
+private:
+  static uint64 GetMoved() { return ~uint64(0); }
+  static uint GetHash(const TKey& Key) {
+    const uint64 Mul = (uint64(0x9E3779B9) << 32) | uint64(0x7F4A7C15);
+    return uint((uint64(uint(THashFunc::GetPrimHashCd(Key))) * Mul) >> 32); }
+  static int GetSegN(const int& KeyId) {
+    return 31 - __builtin_clz(uint(KeyId) + (1u << SegBits0)) - SegBits0; }
+  TKeyDat& GetKeyDat(const int& KeyId) const {
+    const int SegN = GetSegN(KeyId);
+    return SegV[SegN][uint(KeyId) + (1u << SegBits0) - (1u << (SegN + SegBits0))]; }
+  int NewKeyId(const TKey& Key);
+  TIdx* GetIdx();
+  int AddIdx(TIdx* Idx, const TKey& Key, const uint& Hash, int& KeyId, bool& Found);
+  TIdx* GetNextIdx(TIdx* Idx);
+  void Migrate(TIdx* Idx);
+  void Free();
+  UndefCopyAssign(THashMPGrow);
+public:
+  THashMPGrow() : CurIdx(NULL), FirstIdx(NULL), KeyIds(0), NumVals(0) {
+    memset((void*) SegV, 0, sizeof(SegV)); Gen(0); }
+  explicit THashMPGrow(const int& ExpectVals) : CurIdx(NULL), FirstIdx(NULL), KeyIds(0), NumVals(0) {
+    memset((void*) SegV, 0, sizeof(SegV)); Gen(ExpectVals); }
+  ~THashMPGrow() { Free(); }
+
+  const TDat& operator[](const int& KeyId) const { return GetKeyDat(KeyId).Dat; }
+  TDat& operator[](const int& KeyId) { return GetKeyDat(KeyId).Dat; }
+  ::TSize GetMemUsed() const;
+
+  /// Clears the table and reserves space for ExpectVals keys. Not thread safe.
+  void Gen(const int& ExpectVals);
+  /// Removes all keys. Not thread safe.
+  void Clr() { Gen(0); }
+  bool Empty() const { return Len() == 0; }
+  int Len() const { return NumVals; }
+  /// Key ids are in [0, GetMxKeyIds()); ids lost to concurrent inserts of the same key are not keys.
+  int GetMxKeyIds() const { return KeyIds; }
+  /// Number of slots of the current index.
+  int GetIdxSlots() const { return CurIdx->GetSlots(); }
+
+  /// Adds Key if it is not in the table yet and returns its key id. Thread safe.
+  int AddKey(const TKey& Key) { bool Found; return AddKey(Key, Found); }
+  /// Adds Key and sets Found if another call already added it. Thread safe.
+  int AddKey(const TKey& Key, bool& Found);
+  TDat& AddDat(const TKey& Key) { return GetKeyDat(AddKey(Key)).Dat; }
+  TDat& AddDat(const TKey& Key, const TDat& Dat) { return GetKeyDat(AddKey(Key)).Dat = Dat; }
+
+  const TKey& GetKey(const int& KeyId) const { return GetKeyDat(KeyId).Key; }
+  /// Returns the key id of Key or -1. Thread safe, also during AddKey().
+  int GetKeyId(const TKey& Key) const;
+  bool IsKey(const TKey& Key) const { return GetKeyId(Key) != -1; }
+  bool IsKey(const TKey& Key, int& KeyId) const { KeyId = GetKeyId(Key); return KeyId != -1; }
+  bool IsKeyId(const int& KeyId) const {
+    return 0 <= KeyId && KeyId < KeyIds && GetKeyDat(KeyId).HashCd != -1; }
+  const TDat& GetDat(const TKey& Key) const { return GetKeyDat(GetKeyId(Key)).Dat; }
+  TDat& GetDat(const TKey& Key) { return GetKeyDat(GetKeyId(Key)).Dat; }
+  bool IsKeyGetDat(const TKey& Key, TDat& Dat) const { int KeyId;
+    if (IsKey(Key, KeyId)) { Dat = GetKeyDat(KeyId).Dat; return true; }
+    else { return false; } }
+
+  int FFirstKeyId() const { return 0-1; }
+  bool FNextKeyId(int& KeyId) const;
+  void GetKeyV(TVec<TKey>& KeyV) const;
+  void GetDatV(TVec<TDat>& DatV) const;
+  void GetKeyDatPrV(TVec<TPair<TKey, TDat> >& KeyDatPrV) const;
+};
+
+template<class TKey, class TDat, class THashFunc>
+int THashMPGrow<TKey, TDat, THashFunc>::NewKeyId(const TKey& Key) {
+  const int KeyId = __sync_fetch_and_add(&KeyIds, 1);
+  IAssertR(KeyId >= 0, "THashMPGrow: too many keys");
+  const int SegN = GetSegN(KeyId);
+  if (SegV[SegN] == NULL) {
+    TKeyDat* Seg = new TKeyDat[1 << (SegN + SegBits0)];
+    if (! __sync_bool_compare_and_swap(&SegV[SegN], (TKeyDat*) NULL, Seg)) { delete [] Seg; }
+  }
+  GetKeyDat(KeyId).Key = Key;
+  return KeyId;
+}
+
+// Returns the index to start from and helps to migrate the older ones.
+template<class TKey, class TDat, class THashFunc>
+typename THashMPGrow<TKey, TDat, THashFunc>::TIdx* THashMPGrow<TKey, TDat, THashFunc>::GetIdx() {
+  TIdx* Idx = CurIdx;
+  while (Idx->Next != NULL) {
+    Migrate(Idx);
+    if (Idx->DoneChunks < Idx->Chunks) { break; }
+    __sync_bool_compare_and_swap(&CurIdx, Idx, Idx->Next);
+    Idx = Idx->Next;
+  }
+  return Idx;
+}
+
+// Finds or adds Key in Idx. KeyId is the id for a new key (-1 to allocate
+// one when needed). Returns -1 if the key has to be added to Idx->Next.
+template<class TKey, class TDat, class THashFunc>
+int THashMPGrow<TKey, TDat, THashFunc>::AddIdx(TIdx* Idx, const TKey& Key, const uint& Hash, int& KeyId, bool& Found) {
+  const int Mask = Idx->GetSlots() - 1;
+  int SlotN = int(Hash >> (32 - Idx->Bits));
+  for (int Probes = 0; Probes <= Mask; Probes++, SlotN = (SlotN + 1) & Mask) {
+    volatile uint64* Slot = &Idx->SlotV[SlotN];
+    uint64 Val = *Slot;
+    while (Val == 0) {
+      if (Idx->Next != NULL) {
+        // the index is being migrated, close the probe sequence
+        if (__sync_bool_compare_and_swap(Slot, uint64(0), GetMoved())) { return -1; }
+      } else {
+        if (KeyId == -1) { KeyId = NewKeyId(Key); }
+        if (__sync_bool_compare_and_swap(Slot, uint64(0), (uint64(Hash) << 32) | uint(KeyId + 1))) {
+          if (__sync_add_and_fetch(&Idx->Keys, 1) > Mask/2 && Idx->Next == NULL) { GetNextIdx(Idx); }
+          Found = false;
+          return KeyId;
+        }
+      }
+      Val = *Slot;
+    }
+    // no key is after Moved: Moved replaced an empty slot
+    if (Val == GetMoved()) { return -1; }
+    if (uint(Val >> 32) == Hash) {
+      const int SlotKeyId = int(uint(Val)) - 1;
+      if (GetKeyDat(SlotKeyId).Key == Key) { Found = true; return SlotKeyId; }
+    }
+  }
+  return -1;
+}
+
+// Returns Idx->Next and links it first if no other thread has done so yet.
+template<class TKey, class TDat, class THashFunc>
+typename THashMPGrow<TKey, TDat, THashFunc>::TIdx* THashMPGrow<TKey, TDat, THashFunc>::GetNextIdx(TIdx* Idx) {
+  if (Idx->Next == NULL) {
+    IAssertR(Idx->Bits < MxIdxBits, "THashMPGrow: index too large");
+    TIdx* NextIdx = new TIdx(Idx->Bits + 1);
+    if (! __sync_bool_compare_and_swap(&Idx->Next, (TIdx*) NULL, NextIdx)) { delete NextIdx; }
+  }
+  TIdx* NextIdx = Idx->Next;
+  IAssert(NextIdx != NULL);
+  return NextIdx;
+}
+
+// Copies unclaimed chunks of Idx to Idx->Next.
+template<class TKey, class TDat, class THashFunc>
+void THashMPGrow<TKey, TDat, THashFunc>::Migrate(TIdx* Idx) {
+  const int Slots = Idx->GetSlots() / Idx->Chunks;
+  while (Idx->NextChunk < Idx->Chunks) {
+    const int ChunkN = __sync_fetch_and_add(&Idx->NextChunk, 1);
+    if (ChunkN >= Idx->Chunks) { break; }
+    for (int SlotN = ChunkN*Slots; SlotN < (ChunkN+1)*Slots; SlotN++) {
+      volatile uint64* Slot = &Idx->SlotV[SlotN];
+      if (*Slot == 0 && __sync_bool_compare_and_swap(Slot, uint64(0), GetMoved())) { continue; }
+      const uint64 Val = *Slot;
+      if (Val == GetMoved()) { continue; }
+      int KeyId = int(uint(Val)) - 1;
+      bool Found;
+      TIdx* NextIdx = GetNextIdx(Idx);
+      while (AddIdx(NextIdx, GetKeyDat(KeyId).Key, uint(Val >> 32), KeyId, Found) == -1) {
+        NextIdx = GetNextIdx(NextIdx); }
+    }
+    __sync_fetch_and_add(&Idx->DoneChunks, 1);
+  }
+}
+
+template<class TKey, class TDat, class THashFunc>
+int THashMPGrow<TKey, TDat, THashFunc>::AddKey(const TKey& Key, bool& Found) {
+  const uint Hash = GetHash(Key);
+  int KeyId = -1, AddKeyId;
+  TIdx* Idx = GetIdx();
+  // an index that is full before its successor is linked links the successor itself
+  while ((AddKeyId = AddIdx(Idx, Key, Hash, KeyId, Found)) == -1) {
+    Idx = GetNextIdx(Idx); }
+  if (! Found) {
+    GetKeyDat(AddKeyId).HashCd = int(Hash >> 1);
+    __sync_fetch_and_add(&NumVals, 1);
+  }
+  return AddKeyId;
+}
+
+template<class TKey, class TDat, class THashFunc>
+int THashMPGrow<TKey, TDat, THashFunc>::GetKeyId(const TKey& Key) const {
+  const uint Hash = GetHash(Key);
+  for (const TIdx* Idx = CurIdx; Idx != NULL; Idx = Idx->Next) {
+    const int Mask = Idx->GetSlots() - 1;
+    int SlotN = int(Hash >> (32 - Idx->Bits));
+    for (int Probes = 0; Probes <= Mask; Probes++, SlotN = (SlotN + 1) & Mask) {
+      const uint64 Val = Idx->SlotV[SlotN];
+      if (Val == 0 || Val == GetMoved()) { break; }
+      if (uint(Val >> 32) == Hash && GetKeyDat(int(uint(Val)) - 1).Key == Key) {
+        return int(uint(Val)) - 1; }
+    }
+  }
+  return -1;
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashMPGrow<TKey, TDat, THashFunc>::Gen(const int& ExpectVals) {
+  Free();
+  int Bits = MnIdxBits;
+  while (Bits < MxIdxBits && (1 << (Bits - 1)) < ExpectVals) { Bits++; }
+  FirstIdx = CurIdx = new TIdx(Bits);
+  for (int SegN = 0; SegN < Segs && (1 << (SegN + SegBits0)) - (1 << SegBits0) < ExpectVals; SegN++) {
+    SegV[SegN] = new TKeyDat[1 << (SegN + SegBits0)]; }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashMPGrow<TKey, TDat, THashFunc>::Free() {
+  for (int SegN = 0; SegN < Segs; SegN++) {
+    delete [] SegV[SegN];  SegV[SegN] = NULL; }
+  while (FirstIdx != NULL) {
+    TIdx* Idx = FirstIdx;  FirstIdx = Idx->Next;  delete Idx; }
+  CurIdx = NULL;
+  KeyIds = 0;  NumVals = 0;
+}
+
+template<class TKey, class TDat, class THashFunc>
+::TSize THashMPGrow<TKey, TDat, THashFunc>::GetMemUsed() const {
+  int64 MemUsed = sizeof(THashMPGrow);
+  for (int SegN = 0; SegN < Segs; SegN++) {
+    if (SegV[SegN] == NULL) { continue; }
+    MemUsed += int64(sizeof(TKeyDat)) << (SegN + SegBits0); }
+  for (const TIdx* Idx = FirstIdx; Idx != NULL; Idx = Idx->Next) {
+    MemUsed += sizeof(TIdx) + int64(sizeof(uint64)) * Idx->GetSlots(); }
+  return ::TSize(MemUsed);
+}
+
+template<class TKey, class TDat, class THashFunc>
+bool THashMPGrow<TKey, TDat, THashFunc>::FNextKeyId(int& KeyId) const {
+  do { KeyId++; } while (KeyId < KeyIds && GetKeyDat(KeyId).HashCd == -1);
+  return KeyId < KeyIds;
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashMPGrow<TKey, TDat, THashFunc>::GetKeyV(TVec<TKey>& KeyV) const {
+  KeyV.Gen(Len(), 0);
+  int KeyId = FFirstKeyId();
+  while (FNextKeyId(KeyId)) {
+    KeyV.Add(GetKey(KeyId)); }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashMPGrow<TKey, TDat, THashFunc>::GetDatV(TVec<TDat>& DatV) const {
+  DatV.Gen(Len(), 0);
+  int KeyId = FFirstKeyId();
+  while (FNextKeyId(KeyId)) {
+    DatV.Add(GetKeyDat(KeyId).Dat); }
+}
+
+template<class TKey, class TDat, class THashFunc>
+void THashMPGrow<TKey, TDat, THashFunc>::GetKeyDatPrV(TVec<TPair<TKey, TDat> >& KeyDatPrV) const {
+  KeyDatPrV.Gen(Len(), 0);
+  int KeyId = FFirstKeyId();
+  while (FNextKeyId(KeyId)) {
+    KeyDatPrV.Add(TPair<TKey, TDat>(GetKey(KeyId), GetKeyDat(KeyId).Dat)); }
+}
+
 #endif // GCC_ATOMIC
 
 #endif // hashmp_h
@@ -193,3 +193,13 @@ double TSsParserMP::GetFltFromFldV(TVec<char*>& FieldsV, const int& FldN) {
   return atof(FieldsV[FldN]);
 }
 
+void TSsParserMP::GetStrFromFldV(TVec<char*>& FieldsV, const int& FldN, TChA& Str) {
+  // fields are not terminated, they end at the separator or at the end of the line
+  const char *Beg = FieldsV[FldN];
+  const char *End = Beg;
+  if (SsFmt == ssfWhiteSep) { while (*End && (*End != '\n') && ! TCh::IsWs(*End)) { End++; } }
+  else { while (*End && *End!=SplitCh && (*End != '\n')) { End++; } }
+  if (End > Beg && *End == '\n' && *(End-1) == '\r') { End--; }
+  Str.Clr();
+  Str.AddBf((char*) Beg, int(End - Beg));
+}
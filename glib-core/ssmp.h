@@ -93,5 +93,8 @@ public:
   /// Gets float at field \c FldN
   double GetFltFromFldV(TVec<char*>& FieldsV, const int& FldN);
 
+  /// Copies the string at field \c FldN to \c Str
+  void GetStrFromFldV(TVec<char*>& FieldsV, const int& FldN, TChA& Str);
+
   const char* DumpStr() const;
 };
@@ -0,0 +1,321 @@
+#ifndef vecarena_h
+#define vecarena_h
+
+#include "bd.h"
+
+/////////////////////////////////////////////////
+// Vector-Arena
+//
+// TVecArena keeps many small growing vectors, like the adjacency lists of a
+// graph, in a few large chunks instead of one heap allocation per vector. The
+// vectors stay TVec<TVal> objects of the caller: a vector in the arena is an
+// external vector (see TVec::GenExt()) that points into a block of a chunk.
+// A block is one value, the header, followed by the values; the header holds
+// the capacity of the block, or its bitwise complement when the block is free.
+// A vector that is full moves to a block of twice the capacity (a power of
+// two) and its old block goes to the free list of its size class. A block is
+// taken from the free lists, splitting a larger block when needed, or else
+// from the end of the current chunk. Before a new chunk is allocated, a sweep
+// merges adjacent free blocks, so that the blocks left behind by growing
+// vectors serve larger ones. Chunks grow geometrically from MnChunkVals to
+// MxChunkVals values. Defrag() slides the blocks of a given set of vectors to
+// the front of the arena without spare capacity and frees the chunks left
+// empty; it needs no memory besides an int per vector.
+// Vectors that are not external (their memory is owned by the TVec) are used
+// in place while they have room and move into the arena once they are full.
+// TVal must be a plain value type such as TInt or TFlt, since block headers
+// and free list links are stored in the bytes of the values.
+
+//#//////////////////////////////////////////////
+/// Arena of growing vectors, allocated in large chunks.
+template <class TVal>
+class TVecArena {
+private:
+  enum { MnChunkVals=1<<12, MxChunkVals=1<<24, Classes=32 };
+  TVec<TVal*> ChunkV;
+  TVec<int64> ChunkLenV;
+  TVal* ChunkT;
+  int64 ChunkVals, ChunkMxVals, NextChunkVals, AllChunkVals;
+  TVal* FreeT[Classes];
+  int64 FreeVals, SweepVals;
+private:
+  /// Smallest capacity of a block in a free list, a free block holds a pointer.
+  static int GetMnCap() { return int((sizeof(TVal*)+sizeof(TVal)-1)/sizeof(TVal)); }
+  /// Capacity (a power of two) of a block for Vals values.
+  static int GetGrowCap(const int& Vals) {
+    if (Vals > (1<<30)) { return TInt::Mx; }
+    int Cap = 1;  while (Cap < Vals || Cap < GetMnCap()) { Cap *= 2; }
+    return Cap; }
+  /// Size class of a block, floor(log2(Cap)).
+  static int GetClass(int Cap) { int Class = 0;  while (Cap > 1) { Cap >>= 1;  Class++; }  return Class; }
+  static int GetHdr(const TVal* ValT) { int Hdr;  memcpy(&Hdr, (const void*)(ValT-1), sizeof(int));  return Hdr; }
+  static void SetHdr(TVal* ValT, const int& Hdr) { memcpy((void*)(ValT-1), &Hdr, sizeof(int)); }
+  static int GetCap(const TVal* ValT) { return GetHdr(ValT); }
+  static TVal* GetNext(const TVal* ValT) { TVal* NextT;  memcpy(&NextT, (const void*)ValT, sizeof(TVal*));  return NextT; }
+  static void SetNext(TVal* ValT, TVal* NextT) { memcpy((void*)ValT, &NextT, sizeof(TVal*)); }
+  int64 GetChunkEnd(const int& ChunkN) const { return ChunkN == ChunkV.Len()-1 ? ChunkVals : ChunkLenV[ChunkN]; }
+  void ClrFree();
+  void AddFree(TVal* ValT, const int& Cap);
+  TVal* GetFree(const int& Cap);
+  void Sweep();
+  void NewChunk(const int64& MnVals);
+  TVal* NewBlock(const int& Cap);
+  void DelBlock(TVal* ValT) { AddFree(ValT, GetCap(ValT)); }
+  void Move(TVec<TVal>& ValV, const int& Cap);
+  UndefCopyAssign(TVecArena);
+public:
+  TVecArena() : ChunkV(), ChunkLenV(), ChunkT(NULL), ChunkVals(0), ChunkMxVals(0),
+    NextChunkVals(MnChunkVals), AllChunkVals(0) { IAssert(sizeof(TVal) >= sizeof(int));  ClrFree(); }
+  ~TVecArena() { Clr(); }
+
+  /// Appends Val to ValV. Returns the index of Val.
+  int Add(TVec<TVal>& ValV, const TVal& Val);
+  /// Adds Val to the sorted vector ValV so that it stays sorted (ascending). Returns the index of Val.
+  int AddSorted(TVec<TVal>& ValV, const TVal& Val);
+  /// Appends the values of SrcV to ValV.
+  void AddV(TVec<TVal>& ValV, const TVec<TVal>& SrcV);
+  /// Deletes the value at index ValN of ValV.
+  void Del(TVec<TVal>& ValV, const int& ValN);
+  /// Makes room for MxVals values in ValV.
+  void Reserve(TVec<TVal>& ValV, const int& MxVals);
+  /// Frees the block of ValV and makes ValV an empty vector.
+  void Clr(TVec<TVal>& ValV);
+  /// Returns the number of values ValV holds before it has to move.
+  static int GetMxVals(const TVec<TVal>& ValV) { return ValV.IsExt() ? GetCap(ValV.BegI()) : ValV.Reserved(); }
+
+  /// Moves the vectors ValVV into blocks without spare capacity at the front of the arena and frees the empty chunks.
+  /// ValVV has to contain every vector that points into the arena.
+  void Defrag(const TVec<TVec<TVal>*>& ValVV);
+  /// Frees all chunks. No vector may point into the arena anymore.
+  void Clr();
+  /// Returns the number of chunks.
+  int GetChunks() const { return ChunkV.Len(); }
+  /// Returns the number of values (including headers) in free blocks.
+  int64 GetFreeVals() const { return FreeVals; }
+  /// Returns the memory footprint (the number of bytes) of the arena.
+  uint64 GetMemUsed() const { return sizeof(TVecArena) + ChunkV.Reserved()*(sizeof(TVal*)+sizeof(int64)) + AllChunkVals*sizeof(TVal); }
+};
+
+template <class TVal>
+void TVecArena<TVal>::ClrFree() {
+  for (int Class = 0; Class < Classes; Class++) { FreeT[Class] = NULL; }
+  FreeVals = 0;  SweepVals = 0;
+}
+
+// blocks smaller than GetMnCap() are not in a free list, a sweep merges them
+template <class TVal>
+void TVecArena<TVal>::AddFree(TVal* ValT, const int& Cap) {
+  SetHdr(ValT, ~Cap);
+  FreeVals += int64(Cap) + 1;
+  if (Cap >= GetMnCap()) {
+    const int Class = GetClass(Cap);
+    SetNext(ValT, FreeT[Class]);
+    FreeT[Class] = ValT;
+  }
+}
+
+// a free block of class Class holds from 2^Class to 2^(Class+1)-1 values
+template <class TVal>
+TVal* TVecArena<TVal>::GetFree(const int& Cap) {
+  int Class = GetClass(Cap);
+  if (Cap > (1<<Class)) { Class++; }
+  for (; Class < Classes; Class++) {
+    if (FreeT[Class] == NULL) { continue; }
+    TVal* ValT = FreeT[Class];
+    FreeT[Class] = GetNext(ValT);
+    const int FreeCap = ~GetHdr(ValT);
+    FreeVals -= int64(FreeCap) + 1;
+    if (FreeCap - Cap - 1 >= GetMnCap()) {
+      SetHdr(ValT, Cap);
+      AddFree(ValT + Cap + 1, FreeCap - Cap - 1);
+    } else {
+      SetHdr(ValT, FreeCap);
+    }
+    return ValT;
+  }
+  return NULL;
+}
+
+// merges runs of free blocks and rebuilds the free lists
+template <class TVal>
+void TVecArena<TVal>::Sweep() {
+  ClrFree();
+  for (int ChunkN = 0; ChunkN < ChunkV.Len(); ChunkN++) {
+    TVal* T = ChunkV[ChunkN];
+    const int64 End = GetChunkEnd(ChunkN);
+    int64 ValN = 0, RunN = -1;
+    while (ValN < End) {
+      const int Hdr = GetHdr(T + ValN + 1);
+      if (Hdr < 0) {
+        if (RunN == -1) { RunN = ValN; }
+        ValN += int64(~Hdr) + 1;
+      } else {
+        if (RunN != -1) { AddFree(T + RunN + 1, int(ValN - RunN - 1));  RunN = -1; }
+        ValN += int64(Hdr) + 1;
+      }
+    }
+    if (RunN != -1) {
+      // a run at the end of the current chunk goes back to the chunk
+      if (ChunkN == ChunkV.Len()-1) { ChunkVals = RunN; }
+      else { AddFree(T + RunN + 1, int(End - RunN - 1)); }
+    }
+  }
+  SweepVals = FreeVals + AllChunkVals/8;
+}
+
+template <class TVal>
+void TVecArena<TVal>::NewChunk(const int64& MnVals) {
+  if (ChunkVals < ChunkMxVals) {
+    AddFree(ChunkT + ChunkVals + 1, int(ChunkMxVals - ChunkVals - 1)); }
+  const int64 Vals = TMath::Mx(NextChunkVals, MnVals);
+  ChunkT = new TVal[Vals];
+  ChunkV.Add(ChunkT);  ChunkLenV.Add(Vals);
+  ChunkVals = 0;  ChunkMxVals = Vals;
+  AllChunkVals += Vals;
+  NextChunkVals = TMath::Mn(2*NextChunkVals, int64(MxChunkVals));
+}
+
+// the sweeps are spaced by an eighth of the arena freed in between
+template <class TVal>
+TVal* TVecArena<TVal>::NewBlock(const int& Cap) {
+  TVal* ValT = GetFree(Cap);
+  if (ValT != NULL) { return ValT; }
+  if (ChunkVals + Cap + 1 > ChunkMxVals && FreeVals > 0 && FreeVals >= SweepVals) {
+    Sweep();
+    if ((ValT = GetFree(Cap)) != NULL) { return ValT; }
+  }
+  if (ChunkVals + Cap + 1 > ChunkMxVals) { NewChunk(int64(Cap) + 1); }
+  ValT = ChunkT + ChunkVals + 1;
+  ChunkVals += int64(Cap) + 1;
+  SetHdr(ValT, Cap);
+  return ValT;
+}
+
+template <class TVal>
+void TVecArena<TVal>::Move(TVec<TVal>& ValV, const int& Cap) {
+  const int Vals = ValV.Len();
+  TVal* ValT = NewBlock(Cap);
+  for (int ValN = 0; ValN < Vals; ValN++) { ValT[ValN] = ValV[ValN]; }
+  if (ValV.IsExt() && ValV.BegI() != NULL) { DelBlock(ValV.BegI()); }
+  ValV.GenExt(ValT, Vals);
+}
+
+template <class TVal>
+int TVecArena<TVal>::Add(TVec<TVal>& ValV, const TVal& Val) {
+  const int Vals = ValV.Len();
+  if (! ValV.IsExt() && Vals < ValV.Reserved()) { return ValV.Add(Val); }
+  if (! ValV.IsExt() || Vals == GetCap(ValV.BegI())) { Move(ValV, GetGrowCap(Vals+1)); }
+  ValV.BegI()[Vals] = Val;
+  ValV.GenExt(ValV.BegI(), Vals+1);
+  return Vals;
+}
+
+template <class TVal>
+int TVecArena<TVal>::AddSorted(TVec<TVal>& ValV, const TVal& Val) {
+  int ValN = Add(ValV, Val);
+  TVal* ValT = ValV.BegI();
+  while (ValN > 0 && Val < ValT[ValN-1]) { ValT[ValN] = ValT[ValN-1];  ValN--; }
+  ValT[ValN] = Val;
+  return ValN;
+}
+
+template <class TVal>
+void TVecArena<TVal>::AddV(TVec<TVal>& ValV, const TVec<TVal>& SrcV) {
+  const int Vals = ValV.Len();
+  Reserve(ValV, Vals + SrcV.Len());
+  if (! ValV.IsExt()) { ValV.AddV(SrcV);  return; }
+  TVal* ValT = ValV.BegI();
+  for (int ValN = 0; ValN < SrcV.Len(); ValN++) { ValT[Vals+ValN] = SrcV[ValN]; }
+  ValV.GenExt(ValT, Vals + SrcV.Len());
+}
+
+template <class TVal>
+void TVecArena<TVal>::Del(TVec<TVal>& ValV, const int& ValN) {
+  if (! ValV.IsExt()) { ValV.Del(ValN);  return; }
+  const int Vals = ValV.Len();
+  AssertR((0<=ValN)&&(ValN<Vals), TStr::Fmt("Index:%d Vals:%d", ValN, Vals));
+  TVal* ValT = ValV.BegI();
+  for (int MValN = ValN+1; MValN < Vals; MValN++) { ValT[MValN-1] = ValT[MValN]; }
+  ValV.GenExt(ValT, Vals-1);
+}
+
+template <class TVal>
+void TVecArena<TVal>::Reserve(TVec<TVal>& ValV, const int& MxVals) {
+  if (MxVals > GetMxVals(ValV)) { Move(ValV, TMath::Mx(MxVals, GetMnCap())); }
+}
+
+template <class TVal>
+void TVecArena<TVal>::Clr(TVec<TVal>& ValV) {
+  if (ValV.IsExt() && ValV.BegI() != NULL) { DelBlock(ValV.BegI()); }
+  ValV.Clr();
+}
+
+// The blocks are visited in address order and slide down, so a block never
+// overwrites a block that has not moved yet. While sliding, the header of a
+// block holds the index of its vector in ValVV and CapV holds its capacity.
+template <class TVal>
+void TVecArena<TVal>::Defrag(const TVec<TVec<TVal>*>& ValVV) {
+  TIntV CapV(ValVV.Len());
+  for (int i = 0; i < ValVV.Len(); i++) {
+    TVec<TVal>& ValV = *ValVV[i];
+    CapV[i] = -1;
+    if (! ValV.IsExt()) { continue; }
+    if (ValV.Empty()) { Clr(ValV);  continue; }
+    CapV[i] = GetCap(ValV.BegI());
+    SetHdr(ValV.BegI(), i);
+  }
+  ClrFree();
+  int DstChunkN = 0;
+  int64 DstValN = 0;
+  for (int ChunkN = 0; ChunkN < ChunkV.Len(); ChunkN++) {
+    TVal* T = ChunkV[ChunkN];
+    const int64 End = GetChunkEnd(ChunkN);
+    for (int64 ValN = 0; ValN < End; ) {
+      const int Hdr = GetHdr(T + ValN + 1);
+      if (Hdr < 0) { ValN += int64(~Hdr) + 1;  continue; }
+      TVec<TVal>& ValV = *ValVV[Hdr];
+      const int Vals = ValV.Len();
+      const int Cap = TMath::Mx(Vals, GetMnCap());
+      while (DstValN + Cap + 1 > ChunkLenV[DstChunkN]) {
+        // the rest of a destination chunk is free, the next one ends no later than this block
+        if (DstValN < ChunkLenV[DstChunkN]) {
+          AddFree(ChunkV[DstChunkN] + DstValN + 1, int(ChunkLenV[DstChunkN] - DstValN - 1)); }
+        DstChunkN++;  DstValN = 0;
+      }
+      TVal* SrcT = T + ValN + 1;
+      TVal* DstT = ChunkV[DstChunkN] + DstValN + 1;
+      ValN += int64(CapV[Hdr]) + 1;
+      for (int ValN1 = 0; ValN1 < Vals; ValN1++) { DstT[ValN1] = SrcT[ValN1]; }
+      SetHdr(DstT, Cap);
+      ValV.GenExt(DstT, Vals);
+      DstValN += int64(Cap) + 1;
+    }
+  }
+  // the chunks after the last destination chunk are empty
+  if (! ChunkV.Empty()) {
+    for (int ChunkN = DstChunkN+1; ChunkN < ChunkV.Len(); ChunkN++) {
+      AllChunkVals -= ChunkLenV[ChunkN];
+      delete[] ChunkV[ChunkN];
+    }
+    ChunkV.Trunc(DstChunkN+1);  ChunkLenV.Trunc(DstChunkN+1);
+    ChunkT = ChunkV[DstChunkN];
+    ChunkVals = DstValN;  ChunkMxVals = ChunkLenV[DstChunkN];
+  }
+  // vectors owned by TVec move into the arena
+  for (int i = 0; i < ValVV.Len(); i++) {
+    TVec<TVal>& ValV = *ValVV[i];
+    if (! ValV.IsExt() && ! ValV.Empty()) { Move(ValV, TMath::Mx(ValV.Len(), GetMnCap())); }
+  }
+  SweepVals = FreeVals + AllChunkVals/8;
+}
+
+template <class TVal>
+void TVecArena<TVal>::Clr() {
+  for (int ChunkN = 0; ChunkN < ChunkV.Len(); ChunkN++) { delete[] ChunkV[ChunkN]; }
+  ChunkV.Clr();  ChunkLenV.Clr();
+  ChunkT = NULL;  ChunkVals = 0;  ChunkMxVals = 0;
+  NextChunkVals = MnChunkVals;  AllChunkVals = 0;
+  ClrFree();
+}
+
+#endif
@@ -21,14 +21,17 @@
 #include "mmnet.cpp"         // multimodal networks
 
 // table data structures and algorithms
+#include "colpack.cpp"       // compressed table columns
 #include "table.cpp"         // table
 #include "conv.cpp"
 #include "numpy.cpp"         // numpy conversion
 
 // algorithms
 #include "subgraph.cpp"      // subgraph manipulations
+#include "reorder.cpp"       // node reordering for locality
 #include "anf.cpp"           // approximate diameter calculation
 #include "cncom.cpp"         // connected components
+#include "kcore.cpp"         // k-core decomposition
 #include "alg.cpp"           // misc graph algorithms
 #include "gsvd.cpp"          // SVD and eigenvector computations
 #include "gstat.cpp"         // graph statistics
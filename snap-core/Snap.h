@@ -20,16 +20,19 @@
 #include "network.h"         // networks
 #include "networkmp.h"       // networks OMP
 #include "bignet.h"          // large networks
+#include "csrgraph.h"        // compressed sparse row graphs
 #include "timenet.h"         // time evolving networks
 #include "mmnet.h"           // multimodal networks
 
 // table data structures and algorithms
+#include "colpack.h"         // compressed table columns
 #include "table.h"           // table
 #include "conv.h" 	         // conversion functions - table to graph
 #include "numpy.h" 	         // numpy conversion
 
 // algorithms
 #include "subgraph.h"        // subgraph manipulations
+#include "reorder.h"         // node reordering for locality
 #include "anf.h"             // approximate diameter calculation
 #include "bfsdfs.h"          // breadth and depth first search
 #include "cncom.h"           // connected components
@@ -10,10 +10,11 @@ namespace TSnap {
 template <class PGraph> void GetAnf(const PGraph& Graph, const int& SrcNId, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox=32); 
 /// Approximate Neighborhood Function of a Graph: Returns the number of pairs of nodes reachable in less than H hops.
 /// For example, DistNbrsV.GetDat(0) is the number of nodes in the graph, DistNbrsV.GetDat(1) is the number of nodes+edges and so on.
+/// Uses HyperLogLog counters (see THyperAnf).
 /// @param DistNbrsV Maps between the distance H (in hops) and the number of nodes reachable in <=H hops.
 /// @param MxDist Maximum number of hops the algorithm spreads from SrcNId.
 /// @param IsDir false: consider links as undirected (drop link directions).
-/// @param NApprox Quality of approximation. See the ANF paper.
+/// @param NApprox Quality of approximation, each node gets 2*NApprox HyperLogLog registers.
 template <class PGraph> void GetAnf(const PGraph& Graph, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox=32);
 /// Returns a given Percentile of the shortest path length distribution of a Graph (based on a single run of ANF of approximation quality NApprox).
 /// @param IsDir false: consider links as undirected (drop link directions).
@@ -181,6 +182,145 @@ void TGraphAnf<PGraph>::GetGraphAnf(TIntFltKdV& DistNbrsV, const int& MxDist, co
     //TGnuPlot::SaveTs(DistNbrsV, "hops.tab", "HOPS, REACHABLE PAIRS");
   }
 }
+
+/////////////////////////////////////////////////
+/// HyperANF: Approximate Neighborhood Function based on HyperLogLog counters.
+/// Each node keeps a HyperLogLog counter of the nodes it can reach, stored as a block of byte registers in one flat array. In every iteration a node takes the register-wise maximum of its own counter and the counters of its neighbors. Only the neighbors whose counters changed in the previous iteration are merged, the iteration ends early once no counter changes. Nodes are processed in parallel.
+/// For more details see P. Boldi, M. Rosa and S. Vigna, HyperANF: Approximating the Neighbourhood Function of Very Large Graphs on a Budget, WWW 2011.
+template <class PGraph>
+class THyperAnf {
+private:
+  PGraph Graph;
+  TInt LogRegs;                 // each node has 2^LogRegs registers
+  TRnd Rnd;
+  THash<TInt, TInt> NIdToNH;    // nodes are numbered 0...N-1
+  TIntV NbrOffV, NbrV;          // neighbors of node n are NbrV[NbrOffV[n]...NbrOffV[n+1]-1]
+  TVec<uchar, int64> RegV, NextRegV; // registers of node n start at n*2^LogRegs
+  TBoolV ChangedV, NextChangedV;     // registers of node n changed in the last iteration
+  TFltV CntV;                   // estimated number of nodes reachable from node n
+  TFltV InvPow2V;               // InvPow2V[r] = 2^-r
+private:
+  UndefDefaultCopyAssign(THyperAnf);
+  void InitRegs(const bool& IsDir);
+  double GetRegCnt(const uchar* RegI) const;
+  static bool MaxMerge(uchar* DstI, const uchar* SrcI, const int& Regs);
+public:
+  /// Creates the counters, Approx plays the role of the number of parallel approximations of TGraphAnf, each node gets 2*Approx registers (rounded up to a power of 2).
+  THyperAnf(const PGraph& GraphPt, const int& Approx=32, const int& RndSeed=0) : Graph(GraphPt), LogRegs(4), Rnd(RndSeed) {
+    while ((1 << LogRegs) < 2*Approx && LogRegs < 16) { LogRegs++; } }
+  /// Returns the number of registers of each node.
+  int GetRegs() const { return 1 << LogRegs; }
+  /// Returns the number of pairs of nodes reachable in less than H hops, the same as TGraphAnf::GetGraphAnf().
+  /// For example, DistNbrsV.GetDat(0) is the number of nodes in the graph, DistNbrsV.GetDat(1) is the number of nodes+edges and so on.
+  /// @param DistNbrsV Maps between the distance H (in hops) and the number of nodes reachable in <=H hops.
+  /// @param MxDist Maximum number of hops the algorithm spreads from SrcNId.
+  /// @param IsDir false: consider links as undirected (drop link directions).
+  /// @param EarlyStop true: stop when the number of pairs grows by less than 0.1% (as TGraphAnf), false: stop when no counter changes.
+  void GetGraphAnf(TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const bool& EarlyStop=true);
+  /// Returns the estimated number of nodes reachable from node NId, as computed by the last call of GetGraphAnf().
+  double GetNodeCnt(const int& NId) const;
+};
+
+template <class PGraph>
+void THyperAnf<PGraph>::InitRegs(const bool& IsDir) {
+  const int Nodes = Graph->GetNodes();
+  const int Regs = GetRegs();
+  // renumber the nodes 0...N-1
+  NIdToNH.Clr();
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdToNH.AddDat(NI.GetId(), NIdToNH.Len()); }
+  const bool InNbrs = ! IsDir && HasGraphFlag(typename PGraph::TObj, gfDirected);
+  NbrOffV.Gen(Nodes + 1, 0);  NbrOffV.Add(0);
+  NbrV.Gen(InNbrs ? 2*Graph->GetEdges() : Graph->GetEdges(), 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) { NbrV.Add(NIdToNH.GetDat(NI.GetOutNId(e))); }
+    if (InNbrs) {
+      for (int e = 0; e < NI.GetInDeg(); e++) { NbrV.Add(NIdToNH.GetDat(NI.GetInNId(e))); }
+    }
+    NbrOffV.Add(NbrV.Len());
+  }
+  // every node adds itself to its counter, the register index is uniform and the rank geometric
+  const int MxRank = 64 - LogRegs + 1;
+  RegV.Gen(int64(Nodes) * Regs);  RegV.PutAll(0);
+  NextRegV.Gen(int64(Nodes) * Regs);
+  for (int n = 0; n < Nodes; n++) {
+    const int Reg = Rnd.GetUniDevInt(Regs);
+    RegV[int64(n) * Regs + Reg] = uchar(TMath::Mn(Rnd.GetGeoDev(0.5), MxRank));
+  }
+  ChangedV.Gen(Nodes);  ChangedV.PutAll(true);
+  NextChangedV.Gen(Nodes);
+  InvPow2V.Gen(MxRank + 1);
+  for (int r = 0; r <= MxRank; r++) { InvPow2V[r] = pow(2.0, -r); }
+  CntV.Gen(Nodes);
+  for (int n = 0; n < Nodes; n++) { CntV[n] = GetRegCnt(&RegV[int64(n) * Regs]); }
+}
+
+// HyperLogLog estimate with the small range correction
+template <class PGraph>
+double THyperAnf<PGraph>::GetRegCnt(const uchar* RegI) const {
+  const int Regs = GetRegs();
+  double Sum = 0.0;
+  int Zeros = 0;
+  for (int r = 0; r < Regs; r++) {
+    Sum += InvPow2V[RegI[r]];
+    Zeros += RegI[r] == 0;
+  }
+  const double Alpha = Regs == 16 ? 0.673 : (Regs == 32 ? 0.697 : (Regs == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / Regs)));
+  const double Cnt = Alpha * Regs * Regs / Sum;
+  if (Cnt <= 2.5 * Regs && Zeros > 0) { return Regs * log(Regs / double(Zeros)); }
+  return Cnt;
+}
+
+// register-wise maximum, written so that the compiler turns it into vector max instructions
+template <class PGraph>
+bool THyperAnf<PGraph>::MaxMerge(uchar* DstI, const uchar* SrcI, const int& Regs) {
+  uchar Diff = 0;
+  for (int r = 0; r < Regs; r++) {
+    const uchar Mx = DstI[r] > SrcI[r] ? DstI[r] : SrcI[r];
+    Diff |= Mx ^ DstI[r];
+    DstI[r] = Mx;
+  }
+  return Diff != 0;
+}
+
+template <class PGraph>
+void THyperAnf<PGraph>::GetGraphAnf(TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const bool& EarlyStop) {
+  InitRegs(IsDir);
+  const int Nodes = Graph->GetNodes();
+  const int Regs = GetRegs();
+  DistNbrsV.Clr();
+  DistNbrsV.Add(TIntFltKd(0, Nodes));
+  for (int dist = 1; dist < (MxDist==-1 ? TInt::Mx : MxDist); dist++) {
+    int Changed = 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:Changed)
+#endif
+    for (int n = 0; n < Nodes; n++) {
+      uchar* DstI = &NextRegV[int64(n) * Regs];
+      memcpy(DstI, &RegV[int64(n) * Regs], Regs);
+      bool NodeChanged = false;
+      for (int e = NbrOffV[n]; e < NbrOffV[n+1]; e++) {
+        const int Nbr = NbrV[e];
+        // counters that did not change in the last iteration are already merged
+        if (ChangedV[Nbr] && MaxMerge(DstI, &RegV[int64(Nbr) * Regs], Regs)) { NodeChanged = true; }
+      }
+      NextChangedV[n] = NodeChanged;
+      if (NodeChanged) { CntV[n] = GetRegCnt(DstI);  Changed++; }
+    }
+    RegV.Swap(NextRegV);
+    ChangedV.Swap(NextChangedV);
+    double NPairs = 0.0;
+    for (int n = 0; n < Nodes; n++) { NPairs += CntV[n]; }
+    DistNbrsV.Add(TIntFltKd(dist, NPairs));
+    if (NPairs == 0 || Changed == 0) { break; }
+    if (EarlyStop && DistNbrsV.Len() > 1 && NPairs < 1.001*DistNbrsV.LastLast().Dat) { break; } // 0.1%  change
+  }
+}
+
+template <class PGraph>
+double THyperAnf<PGraph>::GetNodeCnt(const int& NId) const {
+  return CntV[NIdToNH.GetDat(NId)];
+}
 /////////////////////////////////////////////////
 // Approximate Neighborhood Function
 namespace TSnap {
@@ -208,14 +348,14 @@ void GetAnf(const PGraph& Graph, const int& SrcNId, TIntFltKdV& DistNbrsV, const
 
 template <class PGraph>
 void GetAnf(const PGraph& Graph, TIntFltKdV& DistNbrsV, const int& MxDist, const bool& IsDir, const int& NApprox) {
-  TGraphAnf<PGraph> Anf(Graph, NApprox, 5, 0);
+  THyperAnf<PGraph> Anf(Graph, NApprox, 0);
   Anf.GetGraphAnf(DistNbrsV, MxDist, IsDir);
 }
 
 template <class PGraph>
 double GetAnfEffDiam(const PGraph& Graph, const bool& IsDir, const double& Percentile, const int& NApprox) {
   TIntFltKdV DistNbrsV;
-  TGraphAnf<PGraph> Anf(Graph, NApprox, 5, 0);
+  THyperAnf<PGraph> Anf(Graph, NApprox, 0);
   Anf.GetGraphAnf(DistNbrsV, -1, IsDir);
   return TSnap::TSnapDetail::CalcEffDiam(DistNbrsV, Percentile);
 }
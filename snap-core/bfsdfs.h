@@ -10,6 +10,8 @@ template <class PGraph> int GetSubTreeSz(const PGraph& Graph, const int& StartNI
 template <class PGraph> int GetNodesAtHop(const PGraph& Graph, const int& StartNId, const int& Hop, TIntV& NIdV, const bool& IsDir=false);
 /// Returns the number of nodes at each hop distance from the starting node StartNId. ##GetNodesAtHops
 template <class PGraph> int GetNodesAtHops(const PGraph& Graph, const int& StartNId, TIntPrV& HopCntV, const bool& IsDir=false);
+/// Returns the number of nodes at each hop distance from every node in SrcNIdV, computed with a multi-source BFS. ##GetNodesAtHopsV
+template <class PGraph> void GetNodesAtHopsV(const PGraph& Graph, const TIntV& SrcNIdV, TVec<TIntV>& HopCntVV, const bool& IsDir=false);
 
 /////////////////////////////////////////////////
 // Shortest paths
@@ -62,13 +64,20 @@ public:
   TIntH NIdDistH;
 public:
   TBreathFS(const PGraph& GraphPt, const bool& InitBigQ=true) :
-    Graph(GraphPt), Queue(InitBigQ?Graph->GetNodes():1024), NIdDistH(InitBigQ?Graph->GetNodes():1024) { }
+    Graph(GraphPt), Queue(InitBigQ?Graph->GetNodes():1024), NIdDistH(InitBigQ?Graph->GetNodes():1024), GraphMP(NULL), NodesMP(0), MxNIdMP(0) { }
   /// Sets the graph to be used by the BFS to GraphPt and resets the data structures.
+  /// Call it also after deleting and adding nodes of the same graph, the node arrays of DoBfsMP() are reused while the number of nodes and the largest node id do not change.
   void SetGraph(const PGraph& GraphPt);
   /// Performs BFS from node id StartNode for at maps MxDist steps by only following in-links (parameter FollowIn = true) and/or out-links (parameter FollowOut = true).
   int DoBfs(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId=-1, const int& MxDist=TInt::Mx);
   /// Same functionality as DoBfs with better performance.
   int DoBfsHybrid(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId=-1, const int& MxDist=TInt::Mx);
+  /// Multi-threaded direction-optimizing BFS, computes the same distances as DoBfs(). NIdDistH is filled level by level, by node index within a level. ##TBreathFS::DoBfsMP
+  int DoBfsMP(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId=-1, const int& MxDist=TInt::Mx, const bool& FillNIdDistH=true);
+  /// Returns the number of nodes at each hop distance (0, 1, 2, ...) from the start node of the last DoBfsMP() call.
+  void GetHopCntV(TIntV& HopCntV) const;
+  /// Multi-source BFS from all nodes in SrcNIdV, returns the number of nodes at each hop distance from each source. ##TBreathFS::DoMsBfs
+  void DoMsBfs(const TIntV& SrcNIdV, const bool& FollowOut, const bool& FollowIn, TVec<TIntV>& HopCntVV);
   /// Returns the number of nodes visited/reached by the BFS.
   int GetNVisited() const { return NIdDistH.Len(); }
   /// Returns the IDs of the nodes visited/reached by the BFS.
@@ -88,6 +97,39 @@ private:
   /* Private functions */
   bool TopDownStep(TIntV &NIdDistV, TIntV *Frontier, TIntV *NextFrontier, int& MaxDist, const int& TargetNId, const bool& FollowOut, const bool& FollowIn);
   bool BottomUpStep(TIntV &NIdDistV, TIntV *Frontier, TIntV *NextFrontier, int& MaxDist, const int& TargetNId, const bool& FollowOut, const bool& FollowIn);
+
+/* Private variables and functions for DoBfsMP */
+private:
+  const typename PGraph::TObj* GraphMP; // graph of the arrays below, they are rebuilt when it or its number of nodes or largest node id changes
+  int NodesMP, MxNIdMP;
+  TVec<typename PGraph::TObj::TNodeI> NIV; // node iterators by node index
+  TNIdxMap NIdxMap; // node ID to node index
+  TIntV DistV; // distance of each node, -1 if not visited
+  TIntV VisitV; // indices of the visited nodes in the order of levels
+  TIntV LevelV; // start of each level in VisitV
+  TVec<TUInt64> FrontierBitV; // bitmap of the frontier for the bottom up steps
+  TVec<TIntV> ThreadVisitVV; // per-thread queues of the nodes discovered in the current step
+  /* Private functions */
+  void InitMP();
+  int GetNIdxMP(const int& NId) const { return NIdxMap.GetIdx(NId); }
+  void TopDownStepMP(const int& FBeg, const int& FEnd, const int& Dist, const bool& ScanOut, const bool& ScanIn);
+  void BottomUpStepMP(const int& FBeg, const int& FEnd, const int& Dist, const bool& ScanOut, const bool& ScanIn);
+  void AddThreadVisitV(TIntV& DstV);
+
+/* Private variables and functions for DoMsBfs */
+private:
+  enum { MsBfsWords = 4 }; // up to 64*MsBfsWords sources share a pass over the graph
+  TVec<TUInt64> SeenBitV; // sources that reached each node, MsBfsWords words per node
+  TVec<TUInt64> VisitBitV; // sources that reached each node at the previous hop
+  TVec<TUInt64> NextBitV; // sources that reach each node at the current hop
+  TIntV MarkV; // last hop at which each node was reached
+  TIntV ActiveV; // nodes with a nonempty VisitBitV
+  TVec<TIntV> ThreadCntVV; // per-thread number of nodes reached by each source at the current hop
+  /* Private functions */
+  void MsBfsBatch(const TIntV& SrcNIdV, const int& SrcN, const int& Srcs, const bool& ScanOut, const bool& ScanIn, TVec<TIntV>& HopCntVV);
+  void MsBfsPush(const int& NIdx, const int& DstNIdx, const int& Words, const int& Hop, TIntV& NewV);
+  bool MsBfsPull(const int& ParentNIdx, const int& Words, const uint64* OpenBits, uint64* NewBits) const;
+  static int GetLowBitN(const uint64& Bits);
 };
 
 template<class PGraph>
@@ -96,6 +138,7 @@ void TBreathFS<PGraph>::SetGraph(const PGraph& GraphPt) {
   const int N=GraphPt->GetNodes();
   if (Queue.Reserved() < N) { Queue.Gen(N); }
   if (NIdDistH.GetReservedKeyIds() < N) { NIdDistH.Gen(N); }
+  GraphMP = NULL;
 }
 
 template<class PGraph>
@@ -264,6 +307,370 @@ bool TBreathFS<PGraph>::BottomUpStep(TIntV &NIdDistV, TIntV *Frontier, TIntV *Ne
   return false;
 }
 
+template<class PGraph>
+int TBreathFS<PGraph>::DoBfsMP(const int& StartNode, const bool& FollowOut, const bool& FollowIn, const int& TargetNId, const int& MxDist, const bool& FillNIdDistH) {
+  StartNId = StartNode;
+  IAssert(Graph->IsNode(StartNId));
+  InitMP();
+  // in-links of undirected graphs are the same as out-links
+  const bool IsDirGraph = HasGraphFlag(typename PGraph::TObj, gfDirected);
+  const bool ScanOut = FollowOut || (FollowIn && ! IsDirGraph);
+  const bool ScanIn = FollowIn && IsDirGraph;
+  const int StartNIdx = GetNIdxMP(StartNId);
+  const int TargetNIdx = (TargetNId != StartNId && Graph->IsNode(TargetNId)) ? GetNIdxMP(TargetNId) : -1;
+  DistV[StartNIdx] = 0;
+  VisitV.Clr(false);  VisitV.Add(StartNIdx);
+  LevelV.Clr(false);  LevelV.Add(0);
+  Stage = 0;
+  const int TotalNodes = NodesMP;
+  int UnvisitedNodes = TotalNodes;
+  int Dist = 0;
+  while (Dist != MxDist) {
+    // the frontier is the last level, VisitV[FBeg...FEnd-1]
+    const int FBeg = LevelV.Last(), FEnd = VisitV.Len();
+    UnvisitedNodes -= FEnd - FBeg;
+    if (Stage == 0 && UnvisitedNodes / (FEnd - FBeg) < int(alpha)) {
+      Stage = 1;
+    } else if (Stage == 1 && TotalNodes / (FEnd - FBeg) > int(beta)) {
+      Stage = 2;
+    }
+    if (Stage == 0 || Stage == 2) {
+      TopDownStepMP(FBeg, FEnd, Dist, ScanOut, ScanIn);
+    } else {
+      BottomUpStepMP(FBeg, FEnd, Dist, ScanOut, ScanIn);
+    }
+    if (VisitV.Len() == FEnd) { break; } // no new nodes
+    LevelV.Add(FEnd);  Dist++;
+    if (TargetNIdx != -1 && DistV[TargetNIdx] != -1) { break; } // target reached
+  }
+  NIdDistH.Clr(false);
+  if (FillNIdDistH) {
+    // the order of the nodes within a level depends on the threads, sort it so that NIdDistH is the same on every run
+    for (int l = 0; l < LevelV.Len(); l++) {
+      const int LevelEnd = l+1 < LevelV.Len() ? LevelV[l+1].Val : VisitV.Len();
+      if (LevelEnd - LevelV[l] > 1) { VisitV.QSort(LevelV[l], LevelEnd-1, true); }
+      for (int i = LevelV[l]; i < LevelEnd; i++) {
+        NIdDistH.AddDat(NIV[VisitV[i]].GetId(), DistV[VisitV[i]]); }
+    }
+  }
+  return Dist;
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::GetHopCntV(TIntV& HopCntV) const {
+  HopCntV.Gen(LevelV.Len(), 0);
+  for (int i = 0; i < LevelV.Len(); i++) {
+    const int LevelEnd = i+1 < LevelV.Len() ? LevelV[i+1].Val : VisitV.Len();
+    HopCntV.Add(LevelEnd - LevelV[i]);
+  }
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::InitMP() {
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  if (ThreadVisitVV.Len() < Threads) { ThreadVisitVV.Gen(Threads); }
+  // the node arrays are kept while the nodes do not change, the distances of the previous search are reset through its visited nodes
+  const int Nodes = Graph->GetNodes();
+  if (GraphMP == Graph() && NodesMP == Nodes && MxNIdMP == Graph->GetMxNId()) {
+    for (int i = 0; i < VisitV.Len(); i++) { DistV[VisitV[i]] = -1; }
+    VisitV.Clr(false);  LevelV.Clr(false);
+    return;
+  }
+  GraphMP = Graph();  NodesMP = Nodes;  MxNIdMP = Graph->GetMxNId();
+  NIV.Gen(Nodes, 0);
+  TIntV NIdV(Nodes, 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIV.Add(NI);  NIdV.Add(NI.GetId()); }
+  NIdxMap.Gen(NIdV);
+  DistV.Gen(Nodes);  DistV.PutAll(-1);
+  VisitV.Gen(Nodes, 0);
+  LevelV.Clr();
+  FrontierBitV.Gen((NIV.Len() + 63) / 64);
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::TopDownStepMP(const int& FBeg, const int& FEnd, const int& Dist, const bool& ScanOut, const bool& ScanIn) {
+  // frontier nodes are processed in small dynamically scheduled chunks, so idle threads take over the remaining work
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(dynamic, 64) if (FEnd - FBeg > 256)
+#endif
+  for (int i = FBeg; i < FEnd; i++) {
+#ifdef GCC_ATOMIC
+    TIntV& NextV = ThreadVisitVV[omp_get_thread_num()];
+#else
+    TIntV& NextV = ThreadVisitVV[0];
+#endif
+    const typename PGraph::TObj::TNodeI& NodeI = NIV[VisitV[i]];
+    if (ScanOut) {
+      for (int v = 0; v < NodeI.GetOutDeg(); v++) {
+        const int NIdx = GetNIdxMP(NodeI.GetOutNId(v));
+        if (DistV[NIdx] != -1) { continue; }
+#ifdef GCC_ATOMIC
+        if (__sync_bool_compare_and_swap(&DistV[NIdx].Val, -1, Dist+1)) { NextV.Add(NIdx); }
+#else
+        DistV[NIdx] = Dist+1;  NextV.Add(NIdx);
+#endif
+      }
+    }
+    if (ScanIn) {
+      for (int v = 0; v < NodeI.GetInDeg(); v++) {
+        const int NIdx = GetNIdxMP(NodeI.GetInNId(v));
+        if (DistV[NIdx] != -1) { continue; }
+#ifdef GCC_ATOMIC
+        if (__sync_bool_compare_and_swap(&DistV[NIdx].Val, -1, Dist+1)) { NextV.Add(NIdx); }
+#else
+        DistV[NIdx] = Dist+1;  NextV.Add(NIdx);
+#endif
+      }
+    }
+  }
+  AddThreadVisitV(VisitV);
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::BottomUpStepMP(const int& FBeg, const int& FEnd, const int& Dist, const bool& ScanOut, const bool& ScanIn) {
+  FrontierBitV.PutAll(TUInt64(uint64(0)));
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(static) if (FEnd - FBeg > 4096)
+#endif
+  for (int i = FBeg; i < FEnd; i++) {
+    const int NIdx = VisitV[i];
+#ifdef GCC_ATOMIC
+    __sync_fetch_and_or(&FrontierBitV[NIdx / 64].Val, uint64(1) << (NIdx % 64));
+#else
+    FrontierBitV[NIdx / 64].Val |= uint64(1) << (NIdx % 64);
+#endif
+  }
+  // each unvisited node looks for a parent in the frontier, only the thread owning the node writes its distance
+  const int Len = NIV.Len();
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (int NIdx = 0; NIdx < Len; NIdx++) {
+    if (DistV[NIdx] != -1) { continue; }
+    const typename PGraph::TObj::TNodeI& NodeI = NIV[NIdx];
+    bool Found = false;
+    if (ScanOut) {
+      for (int v = 0; v < NodeI.GetInDeg() && ! Found; v++) {
+        const int ParentNIdx = GetNIdxMP(NodeI.GetInNId(v));
+        Found = (FrontierBitV[ParentNIdx / 64].Val >> (ParentNIdx % 64)) & 1;
+      }
+    }
+    if (ScanIn) {
+      for (int v = 0; v < NodeI.GetOutDeg() && ! Found; v++) {
+        const int ParentNIdx = GetNIdxMP(NodeI.GetOutNId(v));
+        Found = (FrontierBitV[ParentNIdx / 64].Val >> (ParentNIdx % 64)) & 1;
+      }
+    }
+    if (Found) {
+      DistV[NIdx] = Dist+1;
+#ifdef GCC_ATOMIC
+      ThreadVisitVV[omp_get_thread_num()].Add(NIdx);
+#else
+      ThreadVisitVV[0].Add(NIdx);
+#endif
+    }
+  }
+  AddThreadVisitV(VisitV);
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::AddThreadVisitV(TIntV& DstV) {
+  for (int t = 0; t < ThreadVisitVV.Len(); t++) {
+    DstV.AddV(ThreadVisitVV[t]);
+    ThreadVisitVV[t].Clr(false);
+  }
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::DoMsBfs(const TIntV& SrcNIdV, const bool& FollowOut, const bool& FollowIn, TVec<TIntV>& HopCntVV) {
+  HopCntVV.Gen(SrcNIdV.Len());
+  if (SrcNIdV.Empty()) { return; }
+  InitMP();
+  if (ThreadCntVV.Len() < ThreadVisitVV.Len()) { ThreadCntVV.Gen(ThreadVisitVV.Len()); }
+  // in-links of undirected graphs are the same as out-links
+  const bool IsDirGraph = HasGraphFlag(typename PGraph::TObj, gfDirected);
+  const bool ScanOut = FollowOut || (FollowIn && ! IsDirGraph);
+  const bool ScanIn = FollowIn && IsDirGraph;
+  for (int SrcN = 0; SrcN < SrcNIdV.Len(); SrcN += 64*MsBfsWords) {
+    const int Srcs = TMath::Mn(64*int(MsBfsWords), SrcNIdV.Len() - SrcN);
+    MsBfsBatch(SrcNIdV, SrcN, Srcs, ScanOut, ScanIn, HopCntVV);
+  }
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::MsBfsBatch(const TIntV& SrcNIdV, const int& SrcN, const int& Srcs, const bool& ScanOut, const bool& ScanIn, TVec<TIntV>& HopCntVV) {
+  const int Len = NIV.Len();
+  const int Words = (Srcs + 63) / 64;
+  // bits of unused sources are set in SeenBitV, so that fully reached nodes have all bits set
+  SeenBitV.Gen(Len * Words);
+  for (int NIdx = 0; NIdx < Len; NIdx++) {
+    for (int w = 0; w < Words; w++) {
+      const int WordSrcs = TMath::Mn(64, Srcs - 64*w);
+      if (WordSrcs < 64) { SeenBitV[NIdx*Words + w].Val = ~uint64(0) << WordSrcs; }
+    }
+  }
+  VisitBitV.Gen(Len * Words);
+  NextBitV.Gen(Len * Words);
+  MarkV.Gen(Len);  MarkV.PutAll(-1);
+  for (int t = 0; t < ThreadCntVV.Len(); t++) {
+    ThreadCntVV[t].Gen(64*Words);  ThreadCntVV[t].PutAll(0); }
+  ActiveV.Clr(false);
+  for (int s = 0; s < Srcs; s++) {
+    IAssert(Graph->IsNode(SrcNIdV[SrcN + s]));
+    const int NIdx = GetNIdxMP(SrcNIdV[SrcN + s]);
+    const uint64 Bit = uint64(1) << (s % 64);
+    SeenBitV[NIdx*Words + s/64].Val |= Bit;
+    VisitBitV[NIdx*Words + s/64].Val |= Bit;
+    if (MarkV[NIdx] != 0) { MarkV[NIdx] = 0;  ActiveV.Add(NIdx); }
+    HopCntVV[SrcN + s].Gen(8, 0);
+    HopCntVV[SrcN + s].Add(1);
+  }
+  for (int Hop = 1; ! ActiveV.Empty(); Hop++) {
+    if (Len / ActiveV.Len() > int(beta)) {
+      // few active nodes, push their bits to the neighbors
+#ifdef GCC_ATOMIC
+      #pragma omp parallel for schedule(dynamic, 64) if (ActiveV.Len() > 256)
+#endif
+      for (int i = 0; i < ActiveV.Len(); i++) {
+#ifdef GCC_ATOMIC
+        TIntV& NewV = ThreadVisitVV[omp_get_thread_num()];
+#else
+        TIntV& NewV = ThreadVisitVV[0];
+#endif
+        const int NIdx = ActiveV[i];
+        const typename PGraph::TObj::TNodeI& NodeI = NIV[NIdx];
+        if (ScanOut) {
+          for (int v = 0; v < NodeI.GetOutDeg(); v++) {
+            MsBfsPush(NIdx, GetNIdxMP(NodeI.GetOutNId(v)), Words, Hop, NewV); }
+        }
+        if (ScanIn) {
+          for (int v = 0; v < NodeI.GetInDeg(); v++) {
+            MsBfsPush(NIdx, GetNIdxMP(NodeI.GetInNId(v)), Words, Hop, NewV); }
+        }
+      }
+    } else {
+      // many active nodes, each node pulls the bits of its parents
+#ifdef GCC_ATOMIC
+      #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+      for (int NIdx = 0; NIdx < Len; NIdx++) {
+        uint64 OpenBits[MsBfsWords], NewBits[MsBfsWords];
+        bool Open = false;
+        for (int w = 0; w < Words; w++) {
+          OpenBits[w] = ~SeenBitV[NIdx*Words + w].Val;  NewBits[w] = 0;
+          Open = Open || OpenBits[w] != 0;
+        }
+        if (! Open) { continue; }
+        // stop as soon as the node is reached from all remaining sources
+        const typename PGraph::TObj::TNodeI& NodeI = NIV[NIdx];
+        bool Done = false;
+        if (ScanOut) {
+          for (int v = 0; v < NodeI.GetInDeg() && ! Done; v++) {
+            Done = MsBfsPull(GetNIdxMP(NodeI.GetInNId(v)), Words, OpenBits, NewBits); }
+        }
+        if (ScanIn) {
+          for (int v = 0; v < NodeI.GetOutDeg() && ! Done; v++) {
+            Done = MsBfsPull(GetNIdxMP(NodeI.GetOutNId(v)), Words, OpenBits, NewBits); }
+        }
+        bool Reached = false;
+        for (int w = 0; w < Words; w++) {
+          NextBitV[NIdx*Words + w].Val = NewBits[w];
+          Reached = Reached || NewBits[w] != 0;
+        }
+        if (Reached) {
+#ifdef GCC_ATOMIC
+          ThreadVisitVV[omp_get_thread_num()].Add(NIdx);
+#else
+          ThreadVisitVV[0].Add(NIdx);
+#endif
+        }
+      }
+    }
+    // the reached nodes become the new active nodes
+#ifdef GCC_ATOMIC
+    #pragma omp parallel for schedule(static) if (ActiveV.Len() > 4096)
+#endif
+    for (int i = 0; i < ActiveV.Len(); i++) {
+      for (int w = 0; w < Words; w++) { VisitBitV[ActiveV[i]*Words + w].Val = 0; }
+    }
+    ActiveV.Clr(false);
+    AddThreadVisitV(ActiveV);
+#ifdef GCC_ATOMIC
+    #pragma omp parallel for schedule(static) if (ActiveV.Len() > 4096)
+#endif
+    for (int i = 0; i < ActiveV.Len(); i++) {
+#ifdef GCC_ATOMIC
+      TIntV& CntV = ThreadCntVV[omp_get_thread_num()];
+#else
+      TIntV& CntV = ThreadCntVV[0];
+#endif
+      const int NIdx = ActiveV[i];
+      for (int w = 0; w < Words; w++) {
+        uint64 Bits = NextBitV[NIdx*Words + w].Val;
+        NextBitV[NIdx*Words + w].Val = 0;
+        SeenBitV[NIdx*Words + w].Val |= Bits;
+        VisitBitV[NIdx*Words + w].Val = Bits;
+        for (; Bits != 0; Bits &= Bits - 1) { CntV[64*w + GetLowBitN(Bits)]++; }
+      }
+    }
+    // a source without nodes at this hop has no nodes at later hops either
+    for (int s = 0; s < Srcs; s++) {
+      int Cnt = 0;
+      for (int t = 0; t < ThreadCntVV.Len(); t++) { Cnt += ThreadCntVV[t][s];  ThreadCntVV[t][s] = 0; }
+      if (Cnt > 0) { HopCntVV[SrcN + s].Add(Cnt); }
+    }
+  }
+}
+
+template<class PGraph>
+void TBreathFS<PGraph>::MsBfsPush(const int& NIdx, const int& DstNIdx, const int& Words, const int& Hop, TIntV& NewV) {
+  bool Reached = false;
+  for (int w = 0; w < Words; w++) {
+    const uint64 Bits = VisitBitV[NIdx*Words + w].Val & ~SeenBitV[DstNIdx*Words + w].Val;
+    if ((NextBitV[DstNIdx*Words + w].Val & Bits) == Bits) { continue; }
+#ifdef GCC_ATOMIC
+    __sync_fetch_and_or(&NextBitV[DstNIdx*Words + w].Val, Bits);
+#else
+    NextBitV[DstNIdx*Words + w].Val |= Bits;
+#endif
+    Reached = true;
+  }
+  if (! Reached) { return; }
+  // the first thread that marks the node at this hop adds it to its queue
+#ifdef GCC_ATOMIC
+  const int Mark = MarkV[DstNIdx];
+  if (Mark != Hop && __sync_bool_compare_and_swap(&MarkV[DstNIdx].Val, Mark, Hop)) { NewV.Add(DstNIdx); }
+#else
+  if (MarkV[DstNIdx] != Hop) { MarkV[DstNIdx] = Hop;  NewV.Add(DstNIdx); }
+#endif
+}
+
+template<class PGraph>
+bool TBreathFS<PGraph>::MsBfsPull(const int& ParentNIdx, const int& Words, const uint64* OpenBits, uint64* NewBits) const {
+  bool Done = true;
+  for (int w = 0; w < Words; w++) {
+    NewBits[w] |= VisitBitV[ParentNIdx*Words + w].Val & OpenBits[w];
+    Done = Done && NewBits[w] == OpenBits[w];
+  }
+  return Done;
+}
+
+template<class PGraph>
+int TBreathFS<PGraph>::GetLowBitN(const uint64& Bits) {
+#ifdef GLib_GCC
+  return __builtin_ctzll(Bits);
+#else
+  int BitN = 0;
+  while (((Bits >> BitN) & 1) == 0) { BitN++; }
+  return BitN;
+#endif
+}
+
 template<class PGraph>
 int TBreathFS<PGraph>::GetHops(const int& SrcNId, const int& DstNId) const {
   TInt Dist;
@@ -359,21 +766,29 @@ int GetNodesAtHop(const PGraph& Graph, const int& StartNId, const int& Hop, TInt
 
 template <class PGraph>
 int GetNodesAtHops(const PGraph& Graph, const int& StartNId, TIntPrV& HopCntV, const bool& IsDir) {
-  TBreathFS<PGraph> BFS(Graph);
-  BFS.DoBfs(StartNId, true, !IsDir, -1, TInt::Mx);
-  TIntH HopCntH;
-  for (int i = 0; i < BFS.NIdDistH.Len(); i++) {
-    HopCntH.AddDat(BFS.NIdDistH[i]) += 1;
+  TBreathFS<PGraph> BFS(Graph, false);
+  BFS.DoBfsMP(StartNId, true, !IsDir, -1, TInt::Mx, false);
+  TIntV CntV;
+  BFS.GetHopCntV(CntV);
+  HopCntV.Gen(CntV.Len(), 0);
+  for (int Hop = 0; Hop < CntV.Len(); Hop++) {
+    HopCntV.Add(TIntPr(Hop, CntV[Hop]));
   }
-  HopCntH.GetKeyDatPrV(HopCntV);
-  HopCntV.Sort();
   return HopCntV.Len();
 }
 
+template <class PGraph>
+void GetNodesAtHopsV(const PGraph& Graph, const TIntV& SrcNIdV, TVec<TIntV>& HopCntVV, const bool& IsDir) {
+  TBreathFS<PGraph> BFS(Graph, false);
+  BFS.DoMsBfs(SrcNIdV, true, !IsDir, HopCntVV);
+}
+
 template <class PGraph>
 int GetShortPath(const PGraph& Graph, const int& SrcNId, TIntH& NIdToDistH, const bool& IsDir, const int& MaxDist) {
   TBreathFS<PGraph> BFS(Graph);
-  BFS.DoBfs(SrcNId, true, ! IsDir, -1, MaxDist);
+  // a search limited to a few hops stays local, the hash based search does not touch the rest of the graph
+  if (MaxDist == TInt::Mx) { BFS.DoBfsMP(SrcNId, true, ! IsDir, -1, MaxDist); }
+  else { BFS.DoBfs(SrcNId, true, ! IsDir, -1, MaxDist); }
   NIdToDistH.Clr();
   NIdToDistH.Swap(BFS.NIdDistH);
   return NIdToDistH[NIdToDistH.Len()-1];
@@ -382,6 +797,7 @@ int GetShortPath(const PGraph& Graph, const int& SrcNId, TIntH& NIdToDistH, cons
 template <class PGraph>
 int GetShortPath(const PGraph& Graph, const int& SrcNId, const int& DstNId, const bool& IsDir) {
   TBreathFS<PGraph> BFS(Graph);
+  // a point query stops at DstNId, usually long before DoBfsMP() would pay for its node arrays
   BFS.DoBfs(SrcNId, true, ! IsDir, DstNId, TInt::Mx);
   return BFS.GetHops(SrcNId, DstNId);
 }
@@ -413,15 +829,16 @@ template <class PGraph>
 double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const bool& IsDir, double& EffDiam, int& FullDiam, double& AvgSPL) {
   EffDiam = -1;  FullDiam = -1;  AvgSPL = -1;
   TIntFltH DistToCntH;
-  TBreathFS<PGraph> BFS(Graph);
-  // shotest paths
+  TBreathFS<PGraph> BFS(Graph, false);
+  // shotest paths, from all test nodes at once
   TIntV NodeIdV;
   Graph->GetNIdV(NodeIdV);  NodeIdV.Shuffle(TInt::Rnd);
-  for (int tries = 0; tries < TMath::Mn(NTestNodes, Graph->GetNodes()); tries++) {
-    const int NId = NodeIdV[tries];
-    BFS.DoBfs(NId, true, ! IsDir, -1, TInt::Mx);
-    for (int i = 0; i < BFS.NIdDistH.Len(); i++) {
-      DistToCntH.AddDat(BFS.NIdDistH[i]) += 1; }
+  NodeIdV.Reduce(TMath::Mx(TMath::Mn(NTestNodes, Graph->GetNodes()), 0));
+  TVec<TIntV> HopCntVV;
+  BFS.DoMsBfs(NodeIdV, true, ! IsDir, HopCntVV);
+  for (int tries = 0; tries < HopCntVV.Len(); tries++) {
+    for (int Hop = 0; Hop < HopCntVV[tries].Len(); Hop++) {
+      DistToCntH.AddDat(Hop) += HopCntVV[tries][Hop]; }
   }
   TIntFltKdV DistNbrsPdfV;
   double SumPathL=0, PathCnt=0;
@@ -454,7 +871,7 @@ double GetBfsEffDiam(const PGraph& Graph, const int& NTestNodes, const TIntV& Su
   TInt Dist;
   for (int tries = 0; tries < TMath::Mn(NTestNodes, SubGraphNIdV.Len()); tries++) {
     const int NId = NodeIdV[tries];
-    BFS.DoBfs(NId, true, ! IsDir, -1, TInt::Mx);
+    BFS.DoBfsMP(NId, true, ! IsDir, -1, TInt::Mx);
     for (int i = 0; i < SubGraphNIdV.Len(); i++) {
       if (BFS.NIdDistH.IsKeyGetDat(SubGraphNIdV[i], Dist)) {
         DistToCntH.AddDat(Dist) += 1;
@@ -1,5 +1,718 @@
 namespace TSnap {
 
+namespace TSnapDetail {
+double CalcFarnessCentr(const TIntV& HopCntV, const int& Nodes, const bool& Normalized) {
+  double Sum = 0;
+  int Reached = 0;
+  for (int Hop = 0; Hop < HopCntV.Len(); Hop++) {
+    Sum += double(Hop) * HopCntV[Hop];
+    Reached += HopCntV[Hop];
+  }
+  if (Reached <= 1) { return 0.0; }
+  double Centr = Sum/double(Reached-1);
+  if (Normalized) {
+    Centr *= (Nodes - 1)/double(Reached-1);
+  }
+  return Centr;
+}
+
+int TRadixHeap::GetBucket(const uint64& Bits) const {
+  if (Bits == Last) { return 0; }
+  const uint64 Diff = Bits ^ Last;
+#ifdef GLib_GCC
+  return 64 - __builtin_clzll(Diff);
+#else
+  int Bucket = 0;
+  for (uint64 Rest = Diff; Rest != 0; Rest >>= 1) { Bucket++; }
+  return Bucket;
+#endif
+}
+
+void TRadixHeap::Clr() {
+  for (int b = 0; b < Buckets; b++) {
+    KeyV[b].Clr(false);  ValV[b].Clr(false);
+  }
+  Last = 0;  Size = 0;
+}
+
+void TRadixHeap::Push(const double& Key, const int& Val) {
+  const uint64 Bits = GetBits(Key);
+  IAssert(Bits >= Last);
+  const int Bucket = GetBucket(Bits);
+  KeyV[Bucket].Add(TUInt64(Bits));
+  ValV[Bucket].Add(Val);
+  Size++;
+}
+
+int TRadixHeap::PopMin(double& Key) {
+  IAssert(Size > 0);
+  if (KeyV[0].Empty()) {
+    // the smallest key of the first non-empty bucket becomes the new minimum, redistribute the bucket
+    int Bucket = 1;
+    while (KeyV[Bucket].Empty()) { Bucket++; }
+    TVec<TUInt64>& BKeyV = KeyV[Bucket];
+    TIntV& BValV = ValV[Bucket];
+    uint64 MnBits = BKeyV[0].Val;
+    for (int i = 1; i < BKeyV.Len(); i++) {
+      if (BKeyV[i].Val < MnBits) { MnBits = BKeyV[i].Val; }
+    }
+    Last = MnBits;
+    for (int i = 0; i < BKeyV.Len(); i++) {
+      const int NewBucket = GetBucket(BKeyV[i].Val);
+      KeyV[NewBucket].Add(BKeyV[i]);
+      ValV[NewBucket].Add(BValV[i]);
+    }
+    BKeyV.Clr(false);  BValV.Clr(false);
+  }
+  memcpy(&Key, &Last, sizeof(double));
+  const int Val = ValV[0].Last();
+  KeyV[0].DelLast();  ValV[0].DelLast();
+  Size--;
+  return Val;
+}
+
+void TBtwGraph::TState::Gen(const int& Nodes) {
+  DistV.Gen(Nodes);  DistV.PutAll(-1);
+  SigmaV.Gen(Nodes);  DeltaV.Gen(Nodes);
+  OrderV.Gen(Nodes, 0);  VisitV.Gen(Nodes, 0);
+}
+
+void TBtwGraph::TState::Reset(const bool& Weighted) {
+  // BFS visits nodes in OrderV, Dijkstra can also touch nodes it does not settle
+  const TIntV& TouchV = Weighted ? VisitV : OrderV;
+  for (int i = 0; i < TouchV.Len(); i++) {
+    const int NIdx = TouchV[i];
+    DistV[NIdx] = -1;  SigmaV[NIdx] = 0;  DeltaV[NIdx] = 0;
+  }
+  OrderV.Clr(false);  VisitV.Clr(false);
+}
+
+void TBtwGraph::Finish(const bool& IsDirEdges) {
+  DirEdges = IsDirEdges;
+  const int Nodes = GetNodes();
+  ROffV.Gen(Nodes+1);
+  for (int i = 0; i < NbrV.Len(); i++) {
+    ROffV[NbrV[i]+1]++; }
+  for (int n = 0; n < Nodes; n++) {
+    ROffV[n+1] += ROffV[n]; }
+  TIntV PosV(ROffV);
+  RNbrV.Gen(NbrV.Len());
+  if (IsWeighted()) { RWgtV.Gen(NbrV.Len()); }
+  for (int n = 0; n < Nodes; n++) {
+    for (int e = OffV[n]; e < OffV[n+1]; e++) {
+      const int Pos = PosV[NbrV[e]];
+      PosV[NbrV[e]] += 1;
+      RNbrV[Pos] = n;
+      if (IsWeighted()) { RWgtV[Pos] = WgtV[e]; }
+    }
+  }
+}
+
+// Computes distances, shortest path counts and the settling order from SrcIdx.
+// Stops once DstIdx is settled (DstIdx=-1 explores everything reachable).
+void TBtwGraph::GetSPDag(const int& SrcIdx, const int& DstIdx, TState& State) const {
+  TFltV& DistV = State.DistV;
+  TFltV& SigmaV = State.SigmaV;
+  TIntV& OrderV = State.OrderV;
+  DistV[SrcIdx] = 0;  SigmaV[SrcIdx] = 1;
+  if (! IsWeighted()) {
+    // BFS, OrderV is the queue
+    OrderV.Add(SrcIdx);
+    for (int q = 0; q < OrderV.Len(); q++) {
+      const int NIdx = OrderV[q];
+      const double Dist = DistV[NIdx];
+      if (DstIdx >= 0 && DistV[DstIdx] >= 0 && Dist >= DistV[DstIdx]) { break; }
+      for (int e = OffV[NIdx]; e < OffV[NIdx+1]; e++) {
+        const int Nbr = NbrV[e];
+        if (DistV[Nbr] < 0) { // find Nbr for the first time
+          DistV[Nbr] = Dist+1;
+          OrderV.Add(Nbr);
+        }
+        if (DistV[Nbr] == Dist+1) { // shortest path to Nbr via NIdx
+          SigmaV[Nbr] += SigmaV[NIdx]; }
+      }
+    }
+    return;
+  }
+  // Dijkstra, edge weights must be positive for the settling order to be a topological order of the shortest path DAG
+  TRadixHeap& Heap = State.Heap;
+  Heap.Clr();
+  State.VisitV.Add(SrcIdx);
+  Heap.Push(0, SrcIdx);
+  while (! Heap.Empty()) {
+    double Dist;
+    const int NIdx = Heap.PopMin(Dist);
+    if (Dist > DistV[NIdx]) { continue; } // outdated entry
+    OrderV.Add(NIdx);
+    if (NIdx == DstIdx) { break; }
+    for (int e = OffV[NIdx]; e < OffV[NIdx+1]; e++) {
+      const int Nbr = NbrV[e];
+      const double NbrDist = Dist + WgtV[e];
+      if (DistV[Nbr] < 0 || NbrDist < DistV[Nbr]) {
+        if (DistV[Nbr] < 0) { State.VisitV.Add(Nbr); }
+        DistV[Nbr] = NbrDist;
+        SigmaV[Nbr] = SigmaV[NIdx];
+        Heap.Push(NbrDist, Nbr);
+      } else if (NbrDist == DistV[Nbr]) {
+        SigmaV[Nbr] += SigmaV[NIdx];
+      }
+    }
+  }
+}
+
+// Brandes' dependency accumulation for a single source. Predecessors are found
+// again on the reverse lists instead of being stored during the search.
+void TBtwGraph::AddSrcBtw(const int& SrcIdx, TState& State, TFltV& NodeBtwV, const TIntV& REdgeV, TFltV& EdgeBtwV) const {
+  GetSPDag(SrcIdx, -1, State);
+  const TIntV& OrderV = State.OrderV;
+  for (int i = OrderV.Len()-1; i >= 0; i--) {
+    const int NIdx = OrderV[i];
+    const double Dist = State.DistV[NIdx];
+    const double SigmaW = State.SigmaV[NIdx];
+    const double DeltaW = State.DeltaV[NIdx];
+    for (int e = ROffV[NIdx]; e < ROffV[NIdx+1]; e++) {
+      const int Pred = RNbrV[e];
+      if (! IsPred(Pred, e, Dist, State)) { continue; }
+      const double c = (State.SigmaV[Pred]/SigmaW) * (1+DeltaW);
+      State.DeltaV[Pred] += c;
+      if (! EdgeBtwV.Empty() && REdgeV[e] >= 0) {
+        EdgeBtwV[REdgeV[e]] += c; }
+    }
+    if (! NodeBtwV.Empty() && NIdx != SrcIdx) {
+      NodeBtwV[NIdx] += DeltaW/2.0; }
+  }
+  State.Reset(IsWeighted());
+}
+
+void TBtwGraph::GetBtw(const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent) const {
+  const int Nodes = GetNodes();
+  // EdgeBtwH key of every reverse list entry
+  TIntV REdgeV;
+  if (DoEdgeCent) {
+    REdgeV.Gen(RNbrV.Len());
+    for (int n = 0; n < Nodes; n++) {
+      for (int e = ROffV[n]; e < ROffV[n+1]; e++) {
+        const int SrcNId = NIdV[RNbrV[e]], DstNId = NIdV[n];
+        REdgeV[e] = DirEdges ? EdgeBtwH.GetKeyId(TIntPr(SrcNId, DstNId)) :
+          EdgeBtwH.GetKeyId(TIntPr(TMath::Mn(SrcNId, DstNId), TMath::Mx(SrcNId, DstNId)));
+      }
+    }
+  }
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  // thread-local dependencies, reduced in thread order at the end
+  TVec<TFltV> NodeBtwVV(Threads), EdgeBtwVV(Threads);
+#ifdef USE_OPENMP
+  #pragma omp parallel num_threads(Threads)
+#endif
+  {
+#ifdef USE_OPENMP
+    const int ThreadN = omp_get_thread_num();
+#else
+    const int ThreadN = 0;
+#endif
+    TState State;
+    State.Gen(Nodes);
+    if (DoNodeCent) { NodeBtwVV[ThreadN].Gen(Nodes); }
+    if (DoEdgeCent) { EdgeBtwVV[ThreadN].Gen(EdgeBtwH.GetMxKeyIds()); }
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic,1)
+#endif
+    for (int k = 0; k < BtwNIdV.Len(); k++) {
+      AddSrcBtw(NIdxH.GetDat(BtwNIdV[k]), State, NodeBtwVV[ThreadN], REdgeV, EdgeBtwVV[ThreadN]);
+    }
+  }
+  for (int t = 0; t < Threads; t++) {
+    for (int n = 0; n < NodeBtwVV[t].Len(); n++) {
+      NodeBtwH.AddDat(NIdV[n]) += NodeBtwVV[t][n]; }
+    for (int e = 0; e < EdgeBtwVV[t].Len(); e++) {
+      if (EdgeBtwH.IsKeyId(e)) { EdgeBtwH[e] += EdgeBtwVV[t][e]; }
+    }
+  }
+}
+
+// Samples a shortest path from SrcIdx to DstIdx uniformly at random and counts its inner nodes in CntV.
+void TBtwGraph::AddPathCnt(const int& SrcIdx, const int& DstIdx, TState& State, TRnd& Rnd, TIntV& CntV) const {
+  GetSPDag(SrcIdx, DstIdx, State);
+  int NIdx = DstIdx;
+  while (State.DistV[DstIdx] >= 0 && NIdx != SrcIdx) {
+    // walk back choosing each predecessor with probability proportional to its number of shortest paths
+    const double Dist = State.DistV[NIdx];
+    double Rest = Rnd.GetUniDev() * State.SigmaV[NIdx];
+    int Pred = -1;
+    for (int e = ROffV[NIdx]; e < ROffV[NIdx+1]; e++) {
+      if (! IsPred(RNbrV[e], e, Dist, State)) { continue; }
+      Pred = RNbrV[e];
+      Rest -= State.SigmaV[Pred];
+      if (Rest < 0) { break; }
+    }
+    IAssert(Pred >= 0);
+    if (Pred != SrcIdx) { CntV[Pred]++; }
+    NIdx = Pred;
+  }
+  State.Reset(IsWeighted());
+}
+
+// Upper bound on the number of nodes on a shortest path. For undirected unweighted graphs
+// this is 2*eccentricity+1 of any node in the component, otherwise the size of the largest weakly connected component.
+int TBtwGraph::GetVertexDiamBound() const {
+  const int Nodes = GetNodes();
+  const bool EccBound = ! DirEdges && ! IsWeighted();
+  TIntV DistV(Nodes), QueueV(Nodes, 0);
+  DistV.PutAll(-1);
+  int MxVD = 0;
+  for (int n = 0; n < Nodes; n++) {
+    if (DistV[n] >= 0) { continue; }
+    QueueV.Clr(false);
+    QueueV.Add(n);  DistV[n] = 0;
+    for (int q = 0; q < QueueV.Len(); q++) {
+      const int NIdx = QueueV[q];
+      for (int e = OffV[NIdx]; e < OffV[NIdx+1]; e++) {
+        if (DistV[NbrV[e]] < 0) { DistV[NbrV[e]] = DistV[NIdx]+1;  QueueV.Add(NbrV[e]); }
+      }
+      for (int e = ROffV[NIdx]; e < ROffV[NIdx+1]; e++) {
+        if (DistV[RNbrV[e]] < 0) { DistV[RNbrV[e]] = DistV[NIdx]+1;  QueueV.Add(RNbrV[e]); }
+      }
+    }
+    const int Ecc = DistV[QueueV.Last()];
+    MxVD = TMath::Mx(MxVD, EccBound ? TMath::Mn(2*Ecc+1, QueueV.Len()) : QueueV.Len());
+  }
+  return MxVD;
+}
+
+int TBtwGraph::GetBtwApprox(TIntFltH& NodeBtwH, const double& Eps, const double& Delta, const int& RndSeed) const {
+  const int Nodes = GetNodes();
+  NodeBtwH.Gen(Nodes);
+  for (int n = 0; n < Nodes; n++) {
+    NodeBtwH.AddDat(NIdV[n], 0); }
+  if (Nodes < 3) { return 0; }
+  // Riondato-Kornaropoulos sample size Omega, which is enough for any graph with vertex diameter VD
+  const int VD = GetVertexDiamBound();
+  int LogVD = 0;
+  for (int Val = VD-2; Val > 1; Val >>= 1) { LogVD++; }
+  const double Omega = 0.5/(Eps*Eps) * (LogVD + 1 + log(2.0/Delta));
+  // the failure probability left for the adaptive stopping rule is split evenly among the 2*N bounds
+  const double LogDeltaN = log(4.0*Nodes/Delta);
+#ifdef USE_OPENMP
+  const int Threads = omp_get_max_threads();
+#else
+  const int Threads = 1;
+#endif
+  TVec<TState> StateV(Threads);
+  TVec<TRnd> RndV(Threads);
+  TVec<TIntV> CntVV(Threads);
+  TRnd SeedRnd(RndSeed);
+  for (int t = 0; t < Threads; t++) {
+    StateV[t].Gen(Nodes);
+    RndV[t].PutSeed(SeedRnd.GetUniDevInt(1, TInt::Mx-1));
+    CntVV[t].Gen(Nodes);
+  }
+  TIntV CntV(Nodes);
+  int Samples = 0, Batch = 100;
+  while (Samples < Omega) {
+    Batch = (int) TMath::Mn(double(Batch), ceil(Omega) - Samples);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic,16) num_threads(Threads)
+#endif
+    for (int i = 0; i < Batch; i++) {
+#ifdef USE_OPENMP
+      const int ThreadN = omp_get_thread_num();
+#else
+      const int ThreadN = 0;
+#endif
+      const int SrcIdx = RndV[ThreadN].GetUniDevInt(Nodes);
+      int DstIdx = RndV[ThreadN].GetUniDevInt(Nodes-1);
+      if (DstIdx >= SrcIdx) { DstIdx++; }
+      AddPathCnt(SrcIdx, DstIdx, StateV[ThreadN], RndV[ThreadN], CntVV[ThreadN]);
+    }
+    Samples += Batch;
+    // KADABRA stopping rule, both bounds grow with the estimate so only the largest one is checked
+    int MxCnt = 0;
+    for (int n = 0; n < Nodes; n++) {
+      CntV[n] = 0;
+      for (int t = 0; t < Threads; t++) { CntV[n] += CntVV[t][n]; }
+      MxCnt = TMath::Mx(MxCnt, CntV[n].Val);
+    }
+    const double Btw = MxCnt / double(Samples);
+    const double Tau = Samples, Ratio = Omega / Tau;
+    const double LoErr = LogDeltaN/Tau * (1.0/3.0 - Ratio + sqrt(TMath::Sqr(1.0/3.0 - Ratio) + 2*Btw*Omega/LogDeltaN));
+    const double HiErr = LogDeltaN/Tau * (1.0/3.0 + Ratio + sqrt(TMath::Sqr(1.0/3.0 + Ratio) + 2*Btw*Omega/LogDeltaN));
+    if (LoErr < Eps && HiErr < Eps) { break; }
+    Batch = TMath::Mx(100, Samples/8);
+  }
+  // scale the fraction of paths through each node to the scale of the exact betweenness
+  const double Scale = 0.5 * Nodes * (Nodes-1.0) / double(Samples);
+  for (int n = 0; n < Nodes; n++) {
+    NodeBtwH[n] = CntV[n] * Scale; }
+  return Samples;
+}
+
+// Throws an exception if an edge of the network has no positive weight in Attr,
+// zero weights can close cycles of equal distance that the path counts do not handle.
+void AssertPositiveWgt(const PNEANet& Graph, const TFltV& Attr) {
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    const int EId = EI.GetId();
+    EAssertR(EId < Attr.Len() && Attr[EId] > 0, TStr::Fmt("Edge %d (%d, %d) has no positive weight, weighted betweenness requires positive edge weights.",
+      EId, EI.GetSrcNId(), EI.GetDstNId()));
+  }
+}
+
+// Collects the weighted neighbors of every node of a network, see GetBtwGraph().
+void GetWeightedBtwGraph(const PNEANet& Graph, const TFltV& Attr, const bool& IsDir, TBtwGraph& BtwG) {
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    BtwG.AddNode(NI.GetId());
+  }
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      BtwG.AddNbr(NI.GetOutNId(e), Attr[NI.GetOutEId(e)]);
+    }
+    // if ignoring direction, add incoming edges that are not also outgoing
+    if (! IsDir) {
+      for (int e = 0; e < NI.GetInDeg(); e++) {
+        if (! Graph->IsEdge(NI.GetId(), NI.GetInNId(e))) {
+          BtwG.AddNbr(NI.GetInNId(e), Attr[NI.GetInEId(e)]); }
+      }
+    }
+    BtwG.EndNode();
+  }
+  BtwG.Finish(IsDir);
+}
+
+// Adds Add to Val, atomically if Atomic is set. Returns the value before the addition.
+static double AddRank(TFlt& Val, const double& Add, const bool& Atomic) {
+#ifdef GCC_ATOMIC
+  if (Atomic) {
+    uint64* Bits = (uint64*) &Val.Val;
+    while (true) {
+      const uint64 OldBits = *(volatile uint64*) Bits;
+      double Old, New;
+      memcpy(&Old, &OldBits, sizeof(double));
+      New = Old + Add;
+      uint64 NewBits;
+      memcpy(&NewBits, &New, sizeof(double));
+      if (__sync_bool_compare_and_swap(Bits, OldBits, NewBits)) { return Old; }
+    }
+  }
+#endif
+  const double Old = Val;
+  Val += Add;
+  return Old;
+}
+
+// Sets Flag from 0 to 1, atomically if Atomic is set. Returns false if it was already set.
+static bool SetFlag(TInt& Flag, const bool& Atomic) {
+#ifdef GCC_ATOMIC
+  if (Atomic) { return __sync_bool_compare_and_swap(&Flag.Val, 0, 1); }
+#endif
+  if (Flag != 0) { return false; }
+  Flag = 1;
+  return true;
+}
+
+void TRankGraph::Finish() {
+  const int Nodes = GetNodes();
+  ROffV.Gen(Nodes+1);
+  for (int64 i = 0; i < NbrV.Len(); i++) {
+    ROffV[NbrV[i]+1]++; }
+  for (int n = 0; n < Nodes; n++) {
+    ROffV[n+1] += ROffV[n]; }
+  TVec<TInt64> PosV(ROffV);
+  RNbrV.Gen(NbrV.Len());
+  if (IsWeighted()) { RWgtV.Gen(NbrV.Len()); }
+  InvOutV.Gen(Nodes);
+  for (int n = 0; n < Nodes; n++) {
+    double Out = 0;
+    for (int64 e = OffV[n]; e < OffV[n+1]; e++) {
+      const int64 Pos = PosV[NbrV[e]];
+      PosV[NbrV[e]] += 1;
+      RNbrV[Pos] = n;
+      if (IsWeighted()) { RWgtV[Pos] = WgtV[e];  Out += WgtV[e]; }
+      else { Out += 1; }
+    }
+    InvOutV[n] = Out > 0 ? 1.0 / Out : 0.0;
+  }
+}
+
+int TRankGraph::GetPageRank(TFltV& RankV, const TPageRankMode& Mode, TFltV& ResidualV, const double& C, const double& Eps, const int& MaxIter) const {
+  ResidualV.Clr();
+  if (GetNodes() == 0) { RankV.Clr();  return 0; }
+  switch (Mode) {
+    case prmPull : return GetPageRankPull(RankV, C, Eps, MaxIter, ResidualV);
+    case prmGaussSeidel : return GetPageRankGS(RankV, C, Eps, MaxIter, ResidualV);
+    case prmPush : return GetPageRankPush(RankV, C, Eps, MaxIter, ResidualV);
+    default : FailR("Unknown PageRank mode.");
+  }
+  return 0;
+}
+
+// Power iteration, every node pulls the rank of its in-neighbors.
+int TRankGraph::GetPageRankPull(TFltV& RankV, const double& C, const double& Eps, const int& MaxIter, TFltV& ResidualV) const {
+  const int Nodes = GetNodes();
+  RankV.Gen(Nodes);
+  RankV.PutAll(1.0 / Nodes);
+  TFltV ContribV(Nodes), TmpV(Nodes);
+  int Iters = 0;
+  while (Iters < MaxIter) {
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 4096)
+#endif
+    for (int n = 0; n < Nodes; n++) {
+      ContribV[n] = RankV[n] * InvOutV[n]; }
+    double Sum = 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 4096) reduction(+:Sum)
+#endif
+    for (int n = 0; n < Nodes; n++) {
+      double Tmp = 0;
+      if (IsWeighted()) {
+        for (int64 e = ROffV[n]; e < ROffV[n+1]; e++) {
+          Tmp += ContribV[RNbrV[e]] * RWgtV[e]; }
+      } else {
+        for (int64 e = ROffV[n]; e < ROffV[n+1]; e++) {
+          Tmp += ContribV[RNbrV[e]]; }
+      }
+      TmpV[n] = C * Tmp;
+      Sum += TmpV[n];
+    }
+    const double Leaked = (1.0 - Sum) / double(Nodes);
+    double Diff = 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 4096) reduction(+:Diff)
+#endif
+    for (int n = 0; n < Nodes; n++) {
+      const double NewVal = TmpV[n] + Leaked;
+      Diff += fabs(NewVal - RankV[n]);
+      RankV[n] = NewVal;
+    }
+    Iters++;
+    ResidualV.Add(Diff);
+    if (Diff < Eps) { break; }
+  }
+  return Iters;
+}
+
+// Gauss-Seidel sweeps update the ranks in place, so later nodes of a sweep already see the new ranks.
+// The leaked rank is computed at the start of every sweep. The sweeps are sequential.
+int TRankGraph::GetPageRankGS(TFltV& RankV, const double& C, const double& Eps, const int& MaxIter, TFltV& ResidualV) const {
+  const int Nodes = GetNodes();
+  RankV.Gen(Nodes);
+  RankV.PutAll(1.0 / Nodes);
+  int Iters = 0;
+  while (Iters < MaxIter) {
+    // rank that follows the edges, the rest is spread evenly
+    double Linked = 0;
+    for (int n = 0; n < Nodes; n++) {
+      if (InvOutV[n] > 0) { Linked += RankV[n]; } }
+    const double Leaked = (1.0 - C * Linked) / double(Nodes);
+    double Diff = 0;
+    for (int n = 0; n < Nodes; n++) {
+      double Tmp = 0;
+      for (int64 e = ROffV[n]; e < ROffV[n+1]; e++) {
+        const int Src = RNbrV[e];
+        Tmp += RankV[Src] * InvOutV[Src] * (IsWeighted() ? RWgtV[e].Val : 1.0);
+      }
+      const double NewVal = C * Tmp + Leaked;
+      Diff += fabs(NewVal - RankV[n]);
+      RankV[n] = NewVal;
+    }
+    Iters++;
+    ResidualV.Add(Diff);
+    if (Diff < Eps) { break; }
+  }
+  double Sum = 0;
+  for (int n = 0; n < Nodes; n++) { Sum += RankV[n]; }
+  for (int n = 0; n < Nodes; n++) { RankV[n] /= Sum; }
+  return Iters;
+}
+
+// Delta-based push. ResV holds the residuals, the change the next power iteration would make to RankV: a node adds its
+// residual to its rank and pushes C times the residual to its out-neighbors. The rank of nodes without out-edges is not
+// spread over all nodes, it would add the same amount to every residual just like the teleport does, so it only scales
+// all ranks by a common factor and is applied once at the end by normalizing the ranks. The residuals of the initial
+// uniform ranks come from one pull iteration. An iteration only processes the frontier, the nodes whose residual exceeds
+// Eps/N of the rank sum in absolute value, and collects the next frontier from the nodes it pushed to. The sum of absolute
+// residuals is updated by the pushes, all residuals are only rescanned to confirm that it dropped below Eps.
+// See "A uniform approach to accelerated PageRank computation", McSherry, WWW 2005.
+int TRankGraph::GetPageRankPush(TFltV& RankV, const double& C, const double& Eps, const int& MaxIter, TFltV& ResidualV) const {
+  const int Nodes = GetNodes();
+  RankV.Gen(Nodes);
+  RankV.PutAll(1.0 / Nodes);
+  TFltV ResV(Nodes), DeltaV(Nodes);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 4096)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    double Tmp = 0;
+    for (int64 e = ROffV[n]; e < ROffV[n+1]; e++) {
+      const int Src = RNbrV[e];
+      Tmp += RankV[Src] * InvOutV[Src] * (IsWeighted() ? RWgtV[e].Val : 1.0);
+    }
+    ResV[n] = C * Tmp + (1.0 - C) / Nodes - RankV[n];
+  }
+  bool Atomic = false;
+  int Threads = 1;
+#ifdef GCC_ATOMIC
+  Threads = omp_get_max_threads();
+  Atomic = Threads > 1;
+#endif
+  // FlagV marks the nodes of FrontV, every thread collects its part of the next frontier
+  TIntV FrontV(Nodes, 0), FlagV(Nodes);
+  TVec<TIntV> ThreadFrontVV(Threads);
+  double Residual = 0, RankSum = 1.0;
+  int Iters = 0;
+  while (true) {
+    const double Thresh = Eps * RankSum / Nodes;
+    if (FrontV.Empty() || Residual < Eps * RankSum) {
+      // exact residual and frontier, the running sum accumulates rounding errors
+      for (int i = 0; i < FrontV.Len(); i++) { FlagV[FrontV[i]] = 0; }
+      FrontV.Clr(false);
+      Residual = 0;
+      for (int n = 0; n < Nodes; n++) {
+        const double AbsRes = fabs(ResV[n]);
+        Residual += AbsRes;
+        if (AbsRes > Thresh) { FrontV.Add(n);  FlagV[n] = 1; }
+      }
+    }
+    if (Iters > 0) { ResidualV.Add(Residual / RankSum); }
+    if (Iters == MaxIter || Residual < Eps * RankSum || FrontV.Empty()) { break; }
+    const int FrontLen = FrontV.Len();
+    double Pushed = 0, Added = 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static, 4096) reduction(+:Pushed,Added)
+#endif
+    for (int i = 0; i < FrontLen; i++) {
+      const int NIdx = FrontV[i];
+      DeltaV[i] = ResV[NIdx];
+      ResV[NIdx] = 0;
+      FlagV[NIdx] = 0;
+      RankV[NIdx] += DeltaV[i];
+      Pushed += fabs(DeltaV[i]);
+      Added += DeltaV[i];
+    }
+    double Changed = 0;
+#ifdef GCC_ATOMIC
+    #pragma omp parallel num_threads(Threads) reduction(+:Changed) if (Atomic)
+#endif
+    {
+#ifdef GCC_ATOMIC
+      const int ThreadN = omp_get_thread_num();
+#else
+      const int ThreadN = 0;
+#endif
+      TIntV& NextV = ThreadFrontVV[ThreadN];
+      NextV.Clr(false);
+#ifdef GCC_ATOMIC
+      #pragma omp for schedule(dynamic, 256)
+#endif
+      for (int i = 0; i < FrontLen; i++) {
+        const int NIdx = FrontV[i];
+        if (InvOutV[NIdx] == 0.0) { continue; }
+        const double Push = C * DeltaV[i] * InvOutV[NIdx];
+        for (int64 e = OffV[NIdx]; e < OffV[NIdx+1]; e++) {
+          const double Add = IsWeighted() ? Push * WgtV[e] : Push;
+          const double Old = AddRank(ResV[NbrV[e]], Add, Atomic);
+          Changed += fabs(Old + Add) - fabs(Old);
+          if (fabs(Old + Add) > Thresh && SetFlag(FlagV[NbrV[e]], Atomic)) { NextV.Add(NbrV[e]); }
+        }
+      }
+    }
+    Residual += Changed - Pushed;
+    RankSum += Added;
+    FrontV.Clr(false);
+    for (int t = 0; t < Threads; t++) { FrontV.AddV(ThreadFrontVV[t]); }
+    Iters++;
+  }
+  // the residual left is too small to push, keep it where it is
+  double Sum = 0;
+  for (int n = 0; n < Nodes; n++) {
+    RankV[n] += ResV[n];
+    Sum += RankV[n];
+  }
+  for (int n = 0; n < Nodes; n++) { RankV[n] /= Sum; }
+  return Iters;
+}
+
+void TRankGraph::GetHits(TFltV& HubV, TFltV& AuthV, const int& MaxIter) const {
+  const int Nodes = GetNodes();
+  HubV.Gen(Nodes);  HubV.PutAll(1.0);
+  AuthV.Gen(Nodes);  AuthV.PutAll(1.0);
+  for (int Iter = 0; Iter < MaxIter; Iter++) {
+    // authority scores sum the hub scores of the in-neighbors
+    double Norm = 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 4096) reduction(+:Norm)
+#endif
+    for (int n = 0; n < Nodes; n++) {
+      double Auth = 0;
+      for (int64 e = ROffV[n]; e < ROffV[n+1]; e++) {
+        Auth += HubV[RNbrV[e]]; }
+      AuthV[n] = Auth;
+      Norm += Auth * Auth;
+    }
+    if (Norm > 0) {
+      Norm = sqrt(Norm);
+      for (int n = 0; n < Nodes; n++) { AuthV[n] /= Norm; }
+    }
+    // hub scores sum the authority scores of the out-neighbors
+    Norm = 0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 4096) reduction(+:Norm)
+#endif
+    for (int n = 0; n < Nodes; n++) {
+      double Hub = 0;
+      for (int64 e = OffV[n]; e < OffV[n+1]; e++) {
+        Hub += AuthV[NbrV[e]]; }
+      HubV[n] = Hub;
+      Norm += Hub * Hub;
+    }
+    if (Norm > 0) {
+      Norm = sqrt(Norm);
+      for (int n = 0; n < Nodes; n++) { HubV[n] /= Norm; }
+    }
+  }
+  // make sure Hub and Authority scores normalize to L2 norm 1
+  TFltV* ScoreV[2] = { &HubV, &AuthV };
+  for (int s = 0; s < 2; s++) {
+    double Norm = 0;
+    for (int n = 0; n < Nodes; n++) { Norm += TMath::Sqr((*ScoreV[s])[n]); }
+    if (Norm == 0) { continue; }
+    Norm = sqrt(Norm);
+    for (int n = 0; n < Nodes; n++) { (*ScoreV[s])[n] /= Norm; }
+  }
+}
+
+void TRankGraph::GetNIdValH(const TFltV& ValV, TIntFltH& NIdValH) const {
+  NIdValH.Gen(GetNodes());
+  for (int n = 0; n < GetNodes(); n++) {
+    NIdValH.AddDat(NIdV[n], ValV[n]); }
+}
+
+void GetWeightedRankGraph(const PNEANet& Graph, const TNEANet::TFltAttrCol& WgtCol, TRankGraph& RankG) {
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    RankG.AddNode(NI.GetId()); }
+  TNIdxMap NIdxMap;
+  NIdxMap.Gen(RankG.GetNIdV());
+  // destination and weight of every edge by edge id, so the out-edges below need no hash lookups
+  TIntV DstIdxV(Graph->GetMxEId());
+  TFltV WgtV(Graph->GetMxEId());
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    DstIdxV[EI.GetId()] = NIdxMap.GetIdx(EI.GetDstNId());
+    WgtV[EI.GetId()] = EI.GetFltAttrDat(WgtCol);
+  }
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      const int EId = NI.GetOutEId(e);
+      RankG.AddNbr(DstIdxV[EId], WgtV[EId]);
+    }
+    RankG.EndNode();
+  }
+  RankG.Finish();
+}
+} // TSnapDetail
+
 /////////////////////////////////////////////////
 // Node centrality measures
 double GetDegreeCentr(const PUNGraph& Graph, const int& NId) {
@@ -394,133 +1107,25 @@ TIntH MaxCPGreedyBetter3(const PUNGraph& Graph, const int k) {
 
 //Weighted PageRank
 int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C, const double& Eps, const int& MaxIter) {
-  if (!Graph->IsFltAttrE(Attr)) return -1;
-
-  TFltV Weights = Graph->GetFltAttrVecE(Attr);
-
-  int mxid = Graph->GetMxNId();
-  TFltV OutWeights(mxid);
-  Graph->GetWeightOutEdgesV(OutWeights, Weights);
-
-  const int NNodes = Graph->GetNodes();
-  //const double OneOver = 1.0/double(NNodes);
-  PRankH.Gen(NNodes);
-  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    PRankH.AddDat(NI.GetId(), 1.0/NNodes);
-    //IAssert(NI.GetId() == PRankH.GetKey(PRankH.Len()-1));
-  }
-  TFltV TmpV(NNodes);
-  for (int iter = 0; iter < MaxIter; iter++) {
-    int j = 0;
-    for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++, j++) {
-      TmpV[j] = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
-        const TFlt OutWeight = OutWeights[InNId];
-        int EId = Graph->GetEId(InNId, NI.GetId());
-        const TFlt Weight = Weights[Graph->GetFltKeyIdE(EId)];
-        if (OutWeight > 0) {
-          TmpV[j] += PRankH.GetDat(InNId) * Weight / OutWeight; }
-      }
-      TmpV[j] =  C*TmpV[j]; // Berkhin (the correct way of doing it)
-      //TmpV[j] =  C*TmpV[j] + (1.0-C)*OneOver; // iGraph
-    }
-    double diff=0, sum=0, NewVal;
-    for (int i = 0; i < TmpV.Len(); i++) { sum += TmpV[i]; }
-    const double Leaked = (1.0-sum) / double(NNodes);
-    for (int i = 0; i < PRankH.Len(); i++) { // re-instert leaked PageRank
-      NewVal = TmpV[i] + Leaked; // Berkhin
-      //NewVal = TmpV[i] / sum;  // iGraph
-      diff += fabs(NewVal-PRankH[i]);
-      PRankH[i] = NewVal;
-    }
-    if (diff < Eps) { break; }
-  }
+  TFltV ResidualV;
+  if (GetWeightedPageRank(Graph, PRankH, Attr, prmPull, ResidualV, C, Eps, MaxIter) < 0) { return -1; }
   return 0;
 }
 
-#ifdef USE_OPENMP
-int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C, const double& Eps, const int& MaxIter) {
+int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const TPageRankMode& Mode, TFltV& ResidualV, const double& C, const double& Eps, const int& MaxIter) {
   if (!Graph->IsFltAttrE(Attr)) return -1;
-  const int NNodes = Graph->GetNodes();
-  TVec<TNEANet::TNodeI> NV;
-
-  //const double OneOver = 1.0/double(NNodes);
-  PRankH.Gen(NNodes);
-  int MxId = 0;
-
-  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    NV.Add(NI);
-    PRankH.AddDat(NI.GetId(), 1.0/NNodes);
-    int Id = NI.GetId();
-    if (Id > MxId) {
-      MxId = Id;
-    }
-  }
-
-  TFltV PRankV(MxId+1);
-  TFltV OutWeights(MxId+1);
-
-  TFltV Weights = Graph->GetFltAttrVecE(Attr);
-
-  #pragma omp parallel for schedule(dynamic,10000)
-  for (int j = 0; j < NNodes; j++) {
-    TNEANet::TNodeI NI = NV[j];
-    int Id = NI.GetId();
-    OutWeights[Id] = Graph->GetWeightOutEdges(NI, Attr);
-    PRankV[Id] = 1/NNodes;
-  }
-
-  TFltV TmpV(NNodes);
-  for (int iter = 0; iter < MaxIter; iter++) {
-
-    #pragma omp parallel for schedule(dynamic,10000)
-    for (int j = 0; j < NNodes; j++) {
-      TNEANet::TNodeI NI = NV[j];
-      TFlt Tmp = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
-
-        const TFlt OutWeight = OutWeights[InNId];
-
-        int EId = Graph->GetEId(InNId, NI.GetId());
-        const TFlt Weight = Weights[Graph->GetFltKeyIdE(EId)];
-
-        if (OutWeight > 0) {
-          Tmp += PRankH.GetDat(InNId) * Weight / OutWeight;
-        }
-      }
-      TmpV[j] =  C*Tmp; // Berkhin (the correct way of doing it)
-      //TmpV[j] =  C*TmpV[j] + (1.0-C)*OneOver; // iGraph
-    }
-
-    double sum = 0;
-    #pragma omp parallel for reduction(+:sum) schedule(dynamic,10000)
-    for (int i = 0; i < TmpV.Len(); i++) { sum += TmpV[i]; }
-    const double Leaked = (1.0-sum) / double(NNodes);
-
-    double diff = 0;
-    #pragma omp parallel for reduction(+:diff) schedule(dynamic,10000)
-    for (int i = 0; i < NNodes; i++) {
-      TNEANet::TNodeI NI = NV[i];
-      double NewVal = TmpV[i] + Leaked; // Berkhin
-      //NewVal = TmpV[i] / sum;  // iGraph
-      int Id = NI.GetId();
-      diff += fabs(NewVal-PRankV[Id]);
-      PRankV[Id] = NewVal;
-    }
-    if (diff < Eps) { break; }
-  }
-
-  #pragma omp parallel for schedule(dynamic,10000)
-  for (int i = 0; i < NNodes; i++) {
-    TNEANet::TNodeI NI = NV[i];
-    PRankH[i] = PRankV[NI.GetId()];
-  }
-
-  return 0;
+  TSnapDetail::TRankGraph RankG(Graph->GetNodes());
+  TSnapDetail::GetWeightedRankGraph(Graph, Graph->GetFltAttrColE(Attr), RankG);
+  TFltV RankV;
+  const int Iters = RankG.GetPageRank(RankV, Mode, ResidualV, C, Eps, MaxIter);
+  RankG.GetNIdValH(RankV, PRankH);
+  return Iters;
 }
 
+#ifdef USE_OPENMP
+int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C, const double& Eps, const int& MaxIter) {
+  return GetWeightedPageRank(Graph, PRankH, Attr, C, Eps, MaxIter);
+}
 #endif // USE_OPENMP
 
 //Event importance
@@ -750,14 +1355,9 @@ double GetWeightedClosenessCentr(const PNEANet Graph, const int& NId, const TFlt
 }
 
 void GetWeightedBetweennessCentr(const PNEANet Graph, const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent, const TFltV& Attr, const bool& IsDir) {
+  TSnapDetail::AssertPositiveWgt(Graph, Attr);
   if (DoNodeCent) { NodeBtwH.Clr(); }
   if (DoEdgeCent) { EdgeBtwH.Clr(); }
-  const int nodes = Graph->GetNodes();
-  TIntS S(nodes);
-  TIntQ Q(nodes);
-  TIntIntVH P(nodes); // one vector for every node
-  TIntFltH delta(nodes);
-  TIntFltH sigma(nodes), d(nodes);
   // init
   for (PNEANet::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
     if (DoNodeCent) {
@@ -784,88 +1384,18 @@ void GetWeightedBetweennessCentr(const PNEANet Graph, const TIntV& BtwNIdV, TInt
         }
       }
     }
-    sigma.AddDat(NI.GetId(), 0);
-    d.AddDat(NI.GetId(), -1);
-    P.AddDat(NI.GetId(), TIntV());
-    delta.AddDat(NI.GetId(), 0);
-  }
-  // calc betweeness
-  for (int k=0; k < BtwNIdV.Len(); k++) {
-    const PNEANet::TObj::TNodeI NI = Graph->GetNI(BtwNIdV[k]);
-    // reset
-    for (int i = 0; i < sigma.Len(); i++) {
-      sigma[i]=0;  d[i]=-1;  delta[i]=0;  P[i].Clr(false);
-    }
-    S.Clr(false);
-    Q.Clr(false);
-    sigma.AddDat(NI.GetId(), 1);
-    d.AddDat(NI.GetId(), 0);
-    Q.Push(NI.GetId());
-    while (! Q.Empty()) {
-      const int v = Q.Top();  Q.Pop();
-      const PNEANet::TObj::TNodeI NI2 = Graph->GetNI(v);
-      S.Push(v);
-      const double VDat = d.GetDat(v);
-      // iterate over all outgoing edges
-      for (int e = 0; e < NI2.GetOutDeg(); e++) {
-        const int w = NI2.GetOutNId(e);
-        const int eid = NI2.GetOutEId(e);
-
-        if (d.GetDat(w) < 0) { // find w for the first time
-          Q.Push(w);
-          d.AddDat(w, VDat+Attr[eid]);
-        }
-        //shortest path to w via v ?
-        if (d.GetDat(w) == VDat+Attr[eid]) {
-          sigma.AddDat(w) += sigma.GetDat(v);
-          P.GetDat(w).Add(v);
-        }
-      }
-      // if ignoring direction in directed networks, iterate over incoming edges
-      if (Graph->HasFlag(gfDirected) && !IsDir) {
-        for (int e = 0; e < NI2.GetInDeg(); e++) {
-          const int w = NI2.GetInNId(e);
-          // skip neighbors that are also outgoing
-          if (Graph->IsEdge(NI2.GetId(), w)) {
-            continue;
-          }
-          const int eid = NI2.GetInEId(e);
-
-          if (d.GetDat(w) < 0) { // find w for the first time
-            Q.Push(w);
-            d.AddDat(w, VDat+Attr[eid]);
-          }
-          //shortest path to w via v ?
-          if (d.GetDat(w) == VDat+Attr[eid]) {
-            sigma.AddDat(w) += sigma.GetDat(v);
-            P.GetDat(w).Add(v);
-          }
-        }
-      }
-    }
-    
-    while (! S.Empty()) {
-      const int w = S.Top();
-      const double SigmaW = sigma.GetDat(w);
-      const double DeltaW = delta.GetDat(w);
-      const TIntV NIdV = P.GetDat(w);
-      S.Pop();
-      for (int i = 0; i < NIdV.Len(); i++) {
-        const int NId = NIdV[i];
-        const double c = (sigma.GetDat(NId)*1.0/SigmaW) * (1+DeltaW);
-        delta.AddDat(NId) += c;
-        if (DoEdgeCent) {
-          if (Graph->HasFlag(gfDirected) && IsDir) {
-            EdgeBtwH.AddDat(TIntPr(NId, w)) += c;
-          } else {
-            EdgeBtwH.AddDat(TIntPr(TMath::Mn(NId, w), TMath::Mx(NId, w))) += c;
-          }
-        }
-      }
-      if (DoNodeCent && w != NI.GetId()) {
-        NodeBtwH.AddDat(w) += delta.GetDat(w)/2.0; }
-    }
   }
+  // calc betweeness, shortest paths are found with Dijkstra's algorithm on a radix heap
+  TSnapDetail::TBtwGraph BtwG(Graph->GetNodes());
+  TSnapDetail::GetWeightedBtwGraph(Graph, Attr, IsDir, BtwG);
+  BtwG.GetBtw(BtwNIdV, NodeBtwH, DoNodeCent, EdgeBtwH, DoEdgeCent);
+}
+
+int GetWeightedBetweennessCentrApprox(const PNEANet Graph, TIntFltH& NIdBtwH, const TFltV& Attr, const double& Eps, const double& Delta, const bool& IsDir, const int& RndSeed) {
+  TSnapDetail::AssertPositiveWgt(Graph, Attr);
+  TSnapDetail::TBtwGraph BtwG(Graph->GetNodes());
+  TSnapDetail::GetWeightedBtwGraph(Graph, Attr, IsDir, BtwG);
+  return BtwG.GetBtwApprox(NIdBtwH, Eps, Delta, RndSeed);
 }
 
 void GetWeightedBetweennessCentr(const PNEANet Graph, TIntFltH& NodeBtwH, TIntPrFltH& EdgeBtwH, const TFltV& Attr, const double& NodeFrac, const bool& IsDir) {
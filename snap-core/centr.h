@@ -1,3 +1,7 @@
+/// PageRank iteration methods: pull-based power iteration over the in-edges (prmPull), in-place Gauss-Seidel
+/// sweeps (prmGaussSeidel) and delta-based push that only reprocesses nodes whose residual exceeds a threshold (prmPush).
+typedef enum TPageRankMode_ { prmPull, prmGaussSeidel, prmPush } TPageRankMode;
+
 namespace TSnap {
 
 /////////////////////////////////////////////////
@@ -39,6 +43,9 @@ TIntH LoadNodeList(TStr InFNmNodes);
 template <class PGraph> double GetFarnessCentr(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
 
 template <class PGraph> double GetFarnessCentrMP(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
+/// Computes Farness centrality of all nodes in the graph.
+/// @param NIdFarH hash table mapping node ids to their corresponding farness centrality values.
+template <class PGraph> void GetFarnessCentr(const PGraph& Graph, TIntFltH& NIdFarH, const bool& Normalized=true, const bool& IsDir=false);
 
 /// Returns weighted Farness centrality of a given node \c NId.
 /// Farness centrality of a node is the average shortest path length to all other nodes that reside is the same connected component as the given node.
@@ -48,6 +55,9 @@ double GetWeightedFarnessCentr(const PNEANet Graph, const int& NId, const TFltV&
 /// Closeness centrality of a node is defined as 1/FarnessCentrality.
 template <class PGraph> double GetClosenessCentr(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
 template <class PGraph> double GetClosenessCentrMP(const PGraph& Graph, const int& NId, const bool& Normalized=true, const bool& IsDir=false);
+/// Computes Closeness centrality of all nodes in the graph.
+/// @param NIdCloseH hash table mapping node ids to their corresponding closeness centrality values.
+template <class PGraph> void GetClosenessCentr(const PGraph& Graph, TIntFltH& NIdCloseH, const bool& Normalized=true, const bool& IsDir=false);
 /// Returns Closeness centrality of a given node \c NId. 
 /// Closeness centrality of a node is defined as 1/FarnessCentrality.
 double GetWeightedClosenessCentr(const PNEANet Graph, const int& NId, const TFltV& Attr, const bool& Normalized=true, const bool& IsDir=false);
@@ -59,7 +69,7 @@ template <class PGraph> int GetNodeEcc(const PGraph& Graph, const int& NId, cons
 /// @param NIdBtwH hash table mapping node ids to their corresponding betweenness centrality values.
 /// @param NodeFrac quality of approximation. NodeFrac=1.0 gives exact betweenness values.
 template<class PGraph> void GetBetweennessCentr(const PGraph& Graph, TIntFltH& NIdBtwH, const double& NodeFrac=1.0, const bool& IsDir=false);
-/// Computes (approximate) weighted Node Beetweenness Centrality based on a sample of NodeFrac nodes.
+/// Computes (approximate) weighted Node Beetweenness Centrality based on a sample of NodeFrac nodes. Edge weights must be positive, otherwise an exception is thrown.
 /// @param NIdBtwH hash table mapping node ids to their corresponding betweenness centrality values.
 /// @param NodeFrac quality of approximation. NodeFrac=1.0 gives exact betweenness values.
 void GetWeightedBetweennessCentr(const PNEANet Graph, TIntFltH& NIdBtwH, const TFltV& Attr, const double& NodeFrac=1.0, const bool& IsDir=false);
@@ -67,7 +77,7 @@ void GetWeightedBetweennessCentr(const PNEANet Graph, TIntFltH& NIdBtwH, const T
 /// @param EdgeBtwH hash table mapping edges (pairs of node ids) to their corresponding betweenness centrality values.
 /// @param NodeFrac quality of approximation. NodeFrac=1.0 gives exact betweenness values.
 template<class PGraph> void GetBetweennessCentr(const PGraph& Graph, TIntPrFltH& EdgeBtwH, const double& NodeFrac=1.0, const bool& IsDir=false);
-/// Computes (approximate) weighted Edge Beetweenness Centrality based on a sample of NodeFrac nodes.
+/// Computes (approximate) weighted Edge Beetweenness Centrality based on a sample of NodeFrac nodes. Edge weights must be positive, otherwise an exception is thrown.
 /// @param EdgeBtwH hash table mapping edges (pairs of node ids) to their corresponding betweenness centrality values.
 /// @param NodeFrac quality of approximation. NodeFrac=1.0 gives exact betweenness values.
 void GetWeightedBetweennessCentr(const PNEANet Graph, TIntPrFltH& EdgeBtwH, const TFltV& Attr, const double& NodeFrac=1.0, const bool& IsDir=false);
@@ -76,7 +86,7 @@ void GetWeightedBetweennessCentr(const PNEANet Graph, TIntPrFltH& EdgeBtwH, cons
 /// @param EdgeBtwH hash table mapping edges (pairs of node ids) to their corresponding betweenness centrality values.
 /// @param NodeFrac quality of approximation. NodeFrac=1.0 gives exact betweenness values.
 template<class PGraph> void GetBetweennessCentr(const PGraph& Graph, TIntFltH& NIdBtwH, TIntPrFltH& EdgeBtwH, const double& NodeFrac=1.0, const bool& IsDir=false);
-/// Computes (approximate) weighted Node and Edge Beetweenness Centrality based on a sample of NodeFrac nodes.
+/// Computes (approximate) weighted Node and Edge Beetweenness Centrality based on a sample of NodeFrac nodes. Edge weights must be positive, otherwise an exception is thrown.
 /// @param NIdBtwH hash table mapping node ids to their corresponding betweenness centrality values.
 /// @param EdgeBtwH hash table mapping edges (pairs of node ids) to their corresponding betweenness centrality values.
 /// @param NodeFrac quality of approximation. NodeFrac=1.0 gives exact betweenness values.
@@ -87,8 +97,16 @@ void GetWeightedBetweennessCentr(const PNEANet Graph, TIntFltH& NIdBtwH, TIntPrF
 /// See "A Faster Algorithm for Beetweenness Centrality", Ulrik Brandes, Journal of Mathematical Sociology, 2001, and
 /// "Centrality Estimation in Large Networks", Urlik Brandes and Christian Pich, 2006 for more details.
 template<class PGraph> void GetBetweennessCentr(const PGraph& Graph, const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent, const bool& IsDir);
-/// Computes (approximate) weighted Beetweenness Centrality of all nodes and all edges of the network.
+/// Computes (approximate) weighted Beetweenness Centrality of all nodes and all edges of the network. Edge weights must be positive, otherwise an exception is thrown.
 void GetWeightedBetweennessCentr(const PNEANet Graph, const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent, const TFltV& Attr, const bool& IsDir);
+/// Approximates Node Beetweenness Centrality by sampling random shortest paths until the estimates are accurate enough.
+/// Sampling stops as soon as, with probability at least 1-Delta, every value of NIdBtwH divided by N*(N-1)/2 is within Eps of the exact normalized betweenness (adaptive stopping rule of KADABRA, capped by the Riondato-Kornaropoulos sample size).
+/// The values are on the same scale as GetBetweennessCentr() with NodeFrac=1.0. Returns the number of sampled paths.
+/// See "Fast approximation of betweenness centrality through sampling", Riondato and Kornaropoulos, WSDM 2014, and
+/// "KADABRA is an ADaptive Algorithm for Betweenness via Random Approximation", Borassi and Natale, ESA 2016 for more details.
+template<class PGraph> int GetBetweennessCentrApprox(const PGraph& Graph, TIntFltH& NIdBtwH, const double& Eps=0.01, const double& Delta=0.1, const bool& IsDir=false, const int& RndSeed=1);
+/// Approximates weighted Node Beetweenness Centrality by sampling random shortest paths, see GetBetweennessCentrApprox(). Edge weights must be positive, otherwise an exception is thrown.
+int GetWeightedBetweennessCentrApprox(const PNEANet Graph, TIntFltH& NIdBtwH, const TFltV& Attr, const double& Eps=0.01, const double& Delta=0.1, const bool& IsDir=false, const int& RndSeed=1);
 /// Computes Eigenvector Centrality of all nodes in the network
 /// Eigenvector Centrality of a node N is defined recursively as the average of centrality values of N's neighbors in the network.
 void GetEigenVectorCentr(const PUNGraph& Graph, TIntFltH& NIdEigenH, const double& Eps=1e-4, const int& MaxIter=100);
@@ -100,9 +118,15 @@ template<class PGraph> void GetPageRank_v1(const PGraph& Graph, TIntFltH& PRankH
 #ifdef USE_OPENMP
 template<class PGraph> void GetPageRankMP(const PGraph& Graph, TIntFltH& PRankH, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
 #endif
+/// PageRank computed with the iteration method Mode. Returns the number of iterations and stores the residual after
+/// every iteration to ResidualV: the L1 change of the ranks for prmPull and prmGaussSeidel, the rank mass not yet
+/// pushed for prmPush. All methods stop once the residual drops below Eps.
+template<class PGraph> int GetPageRank(const PGraph& Graph, TIntFltH& PRankH, const TPageRankMode& Mode, TFltV& ResidualV, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
 
-/// Weighted PageRank (TODO: Use template)
+/// Weighted PageRank, the weights are taken from the float edge attribute Attr. Returns -1 if there is no such attribute.
 int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
+/// Weighted PageRank computed with the iteration method Mode, see GetPageRank(). Returns the number of iterations or -1 if there is no attribute Attr.
+int GetWeightedPageRank(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const TPageRankMode& Mode, TFltV& ResidualV, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
 #ifdef USE_OPENMP
 int GetWeightedPageRankMP(const PNEANet Graph, TIntFltH& PRankH, const TStr& Attr, const double& C=0.85, const double& Eps=1e-4, const int& MaxIter=100);
 #endif
@@ -119,42 +143,189 @@ template<class PGraph> void GetHitsMP(const PGraph& Graph, TIntFltH& NIdHubH, TI
 int GetWeightedShortestPath(const PNEANet Graph, const int& SrcNId, TIntFltH& NIdDistH, const TFltV& Attr);
 /////////////////////////////////////////////////
 // Implementation
-template <class PGraph>
-double GetFarnessCentr(const PGraph& Graph, const int& NId, const bool& Normalized, const bool& IsDir) {
-  TIntH NDistH(Graph->GetNodes());
-  TSnap::GetShortPath<PGraph>(Graph, NId, NDistH, IsDir, TInt::Mx);  
-  
-  double sum = 0;
-  for (TIntH::TIter I = NDistH.BegI(); I < NDistH.EndI(); I++) {
-    sum += I->Dat();
+namespace TSnapDetail {
+/// Helper function for computing Farness centrality from the number of nodes at each hop distance.
+double CalcFarnessCentr(const TIntV& HopCntV, const int& Nodes, const bool& Normalized);
+
+/// Monotone priority queue over non-negative double keys (radix heap, Ahuja et al., 1990).
+/// Keys are kept in buckets by the highest bit in which they differ from the last extracted minimum,
+/// so a pushed key must not be smaller than that minimum, which always holds in Dijkstra's algorithm.
+class TRadixHeap {
+private:
+  enum { Buckets = 65 };
+  uint64 Last;
+  int Size;
+  TVec<TUInt64> KeyV[Buckets];
+  TIntV ValV[Buckets];
+private:
+  static uint64 GetBits(const double& Key) { uint64 Bits;  memcpy(&Bits, &Key, sizeof(uint64));  return Bits; }
+  int GetBucket(const uint64& Bits) const;
+public:
+  TRadixHeap() : Last(0), Size(0) { }
+  void Clr();
+  bool Empty() const { return Size == 0; }
+  int Len() const { return Size; }
+  void Push(const double& Key, const int& Val);
+  /// Removes the element with the smallest key, returns its value and stores its key to Key.
+  int PopMin(double& Key);
+};
+
+/// Compact adjacency of a graph used by the betweenness centrality computations.
+/// Nodes are renumbered to 0..N-1. The forward lists hold the neighbors a shortest path can continue to,
+/// the reverse lists the neighbors it can come from. Edge weights are only stored for weighted graphs.
+class TBtwGraph {
+private:
+  /// Per-thread scratch space of a single-source shortest path computation.
+  class TState {
+  public:
+    TFltV DistV, SigmaV, DeltaV;
+    TIntV OrderV, VisitV;
+    TRadixHeap Heap;
+  public:
+    void Gen(const int& Nodes);
+    void Reset(const bool& Weighted);
+  };
+private:
+  TIntV NIdV;
+  TIntH NIdxH;
+  TIntV OffV, NbrV, ROffV, RNbrV;
+  TFltV WgtV, RWgtV;
+  bool DirEdges;
+private:
+  bool IsWeighted() const { return ! WgtV.Empty(); }
+  bool IsPred(const int& NIdx, const int& RIdx, const double& Dist, const TState& State) const {
+    return State.DistV[NIdx] >= 0 && State.DistV[NIdx] + (IsWeighted() ? RWgtV[RIdx].Val : 1.0) == Dist; }
+  void GetSPDag(const int& SrcIdx, const int& DstIdx, TState& State) const;
+  void AddSrcBtw(const int& SrcIdx, TState& State, TFltV& NodeBtwV, const TIntV& REdgeV, TFltV& EdgeBtwV) const;
+  void AddPathCnt(const int& SrcIdx, const int& DstIdx, TState& State, TRnd& Rnd, TIntV& CntV) const;
+  int GetVertexDiamBound() const;
+public:
+  TBtwGraph(const int& Nodes) : NIdV(Nodes, 0), NIdxH(Nodes), OffV(Nodes+1, 0), DirEdges(false) { OffV.Add(0); }
+  int GetNodes() const { return NIdV.Len(); }
+  void AddNode(const int& NId) { NIdxH.AddDat(NId, NIdV.Len());  NIdV.Add(NId); }
+  /// Adds the neighbor NbrNId to the node added by the last EndNode() call (all nodes must be added first).
+  void AddNbr(const int& NbrNId) { NbrV.Add(NIdxH.GetDat(NbrNId)); }
+  void AddNbr(const int& NbrNId, const double& Wgt) {
+    Assert(Wgt > 0);
+    NbrV.Add(NIdxH.GetDat(NbrNId));  WgtV.Add(Wgt); }
+  void EndNode() { OffV.Add(NbrV.Len()); }
+  /// Builds the reverse lists. DirEdges tells if edges (u,v) and (v,u) have separate edge betweenness values.
+  void Finish(const bool& IsDirEdges);
+  /// Runs Brandes' algorithm from the nodes in BtwNIdV in parallel and adds the dependencies to NodeBtwH and EdgeBtwH.
+  void GetBtw(const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent) const;
+  /// Estimates node betweenness from random shortest paths, see GetBetweennessCentrApprox().
+  int GetBtwApprox(TIntFltH& NodeBtwH, const double& Eps, const double& Delta, const int& RndSeed) const;
+};
+
+/// Fills BtwG with the neighbors of every node; with IsDir=false edges of directed graphs are followed in both directions.
+template<class PGraph>
+void GetBtwGraph(const PGraph& Graph, const bool& IsDir, TBtwGraph& BtwG) {
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    BtwG.AddNode(NI.GetId());
   }
-  if (NDistH.Len() > 1) { 
-    double centr = sum/double(NDistH.Len()-1); 
-    if (Normalized) {
-      centr *= (Graph->GetNodes() - 1)/double(NDistH.Len()-1);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      BtwG.AddNbr(NI.GetOutNId(e));
+    }
+    // if ignoring direction in directed networks, add incoming edges that are not also outgoing
+    if (Graph->HasFlag(gfDirected) && !IsDir) {
+      for (int e = 0; e < NI.GetInDeg(); e++) {
+        if (! Graph->IsEdge(NI.GetId(), NI.GetInNId(e))) {
+          BtwG.AddNbr(NI.GetInNId(e)); }
+      }
     }
-    return centr;
+    BtwG.EndNode();
   }
-  else { return 0.0; }
+  BtwG.Finish(Graph->HasFlag(gfDirected) && IsDir);
+}
+
+/// Compact adjacency of a graph used by the PageRank and HITS computations.
+/// Nodes are renumbered to 0..N-1 in the node order of the graph, the forward lists hold the out-edges and the
+/// reverse lists the in-edges. Edge weights are only stored for weighted graphs. InvOutV holds the reciprocal
+/// out-degree (out-weight) of every node, it is 0 for nodes without out-edges, whose PageRank leaks.
+class TRankGraph {
+private:
+  TIntV NIdV;
+  TVec<TInt64> OffV, ROffV;  // forward and reverse lists of node index n are NbrV[OffV[n]..OffV[n+1]) and RNbrV[ROffV[n]..ROffV[n+1])
+  TNIdxMap::TNbrV NbrV, RNbrV;
+  TVec<TFlt, int64> WgtV, RWgtV;
+  TFltV InvOutV;
+private:
+  bool IsWeighted() const { return ! WgtV.Empty(); }
+  int GetPageRankPull(TFltV& RankV, const double& C, const double& Eps, const int& MaxIter, TFltV& ResidualV) const;
+  int GetPageRankGS(TFltV& RankV, const double& C, const double& Eps, const int& MaxIter, TFltV& ResidualV) const;
+  int GetPageRankPush(TFltV& RankV, const double& C, const double& Eps, const int& MaxIter, TFltV& ResidualV) const;
+public:
+  TRankGraph(const int& Nodes) : NIdV(Nodes, 0), OffV(Nodes+1, 0) { OffV.Add(0); }
+  int GetNodes() const { return NIdV.Len(); }
+  int GetNId(const int& NIdx) const { return NIdV[NIdx]; }
+  const TIntV& GetNIdV() const { return NIdV; }
+  void AddNode(const int& NId) { NIdV.Add(NId); }
+  /// Adds an out-edge to the node with index NbrIdx to the node added by the last EndNode() call (all nodes must be added first).
+  void AddNbr(const int& NbrIdx) { NbrV.Add(NbrIdx); }
+  void AddNbr(const int& NbrIdx, const double& Wgt) { NbrV.Add(NbrIdx);  WgtV.Add(Wgt); }
+  void EndNode() { OffV.Add(NbrV.Len()); }
+  /// Builds the reverse lists and the reciprocal out-degrees.
+  void Finish();
+  /// PageRank of every node index, see TSnap::GetPageRank(). Returns the number of iterations.
+  int GetPageRank(TFltV& RankV, const TPageRankMode& Mode, TFltV& ResidualV, const double& C, const double& Eps, const int& MaxIter) const;
+  /// Hub and authority scores of every node index with L2 norm 1, see TSnap::GetHits().
+  void GetHits(TFltV& HubV, TFltV& AuthV, const int& MaxIter) const;
+  /// Stores the values of ValV to NIdValH with node ids as keys, in the node order of the graph.
+  void GetNIdValH(const TFltV& ValV, TIntFltH& NIdValH) const;
+};
+
+/// Fills RankG with the out-edges of every node, in undirected graphs every edge is followed in both directions.
+template<class PGraph>
+void GetRankGraph(const PGraph& Graph, TRankGraph& RankG) {
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    RankG.AddNode(NI.GetId()); }
+  TNIdxMap NIdxMap;
+  NIdxMap.Gen(RankG.GetNIdV());
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      RankG.AddNbr(NIdxMap.GetIdx(NI.GetOutNId(e))); }
+    RankG.EndNode();
+  }
+  RankG.Finish();
+}
+
+/// Fills RankG with the out-edges of every node weighted by the float edge attribute column WgtCol (see TNEANet::GetFltAttrColE()).
+void GetWeightedRankGraph(const PNEANet& Graph, const TNEANet::TFltAttrCol& WgtCol, TRankGraph& RankG);
+} // TSnapDetail
+
+template <class PGraph>
+double GetFarnessCentr(const PGraph& Graph, const int& NId, const bool& Normalized, const bool& IsDir) {
+  TBreathFS<PGraph> BFS(Graph, false);
+  BFS.DoBfsMP(NId, true, ! IsDir, -1, TInt::Mx, false);
+  TIntV HopCntV;
+  BFS.GetHopCntV(HopCntV);
+  return TSnapDetail::CalcFarnessCentr(HopCntV, Graph->GetNodes(), Normalized);
 }
 
 template <class PGraph>
 double GetFarnessCentrMP(const PGraph& Graph, const int& NId, const bool& Normalized, const bool& IsDir) {
-  TIntH NDistH(Graph->GetNodes());
-  TSnap::GetShortPath<PGraph>(Graph, NId, NDistH, IsDir, TInt::Mx);  
-  
-  double sum = 0;
-  for (TIntH::TIter I = NDistH.BegI(); I < NDistH.EndI(); I++) {
-    sum += I->Dat();
+  return GetFarnessCentr<PGraph>(Graph, NId, Normalized, IsDir);
+}
+
+template <class PGraph>
+void GetFarnessCentr(const PGraph& Graph, TIntFltH& NIdFarH, const bool& Normalized, const bool& IsDir) {
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  TVec<TIntV> HopCntVV;
+  TSnap::GetNodesAtHopsV(Graph, NIdV, HopCntVV, IsDir);
+  NIdFarH.Gen(NIdV.Len());
+  for (int i = 0; i < NIdV.Len(); i++) {
+    NIdFarH.AddDat(NIdV[i], TSnapDetail::CalcFarnessCentr(HopCntVV[i], Graph->GetNodes(), Normalized));
   }
-  if (NDistH.Len() > 1) { 
-    double centr = sum/double(NDistH.Len()-1); 
-    if (Normalized) {
-      centr *= (Graph->GetNodes() - 1)/double(NDistH.Len()-1);
-    }
-    return centr;
+}
+
+template <class PGraph>
+void GetClosenessCentr(const PGraph& Graph, TIntFltH& NIdCloseH, const bool& Normalized, const bool& IsDir) {
+  GetFarnessCentr(Graph, NIdCloseH, Normalized, IsDir);
+  for (int i = 0; i < NIdCloseH.Len(); i++) {
+    if (NIdCloseH[i] != 0.0) { NIdCloseH[i] = 1.0/NIdCloseH[i]; }
   }
-  else { return 0.0; }
 }
 
 template <class PGraph>
@@ -232,140 +403,31 @@ void GetPageRank_v1(const PGraph& Graph, TIntFltH& PRankH, const double& C, cons
   }
 }
 
-// Page Rank -- there are two different implementations (uncomment the desired 2 lines):
-//   Berkhin -- (the correct way) see Algorithm 1 of P. Berkhin, A Survey on PageRank Computing, Internet Mathematics, 2005
-//   iGraph -- iGraph implementation(which treats leaked PageRank in a funny way)
-// This implementation is an optimized version, it builds a vector and accesses nodes via the vector.
+// Page Rank -- Berkhin's formulation, see Algorithm 1 of P. Berkhin, A Survey on PageRank Computing, Internet Mathematics, 2005:
+// the rank leaked by the damping factor and by the nodes without out-edges is spread evenly over all nodes.
+// The iterations run on a renumbered dense copy of the graph, see TSnapDetail::TRankGraph.
 template<class PGraph>
 void GetPageRank(const PGraph& Graph, TIntFltH& PRankH, const double& C, const double& Eps, const int& MaxIter) {
-  const int NNodes = Graph->GetNodes();
-  TVec<typename PGraph::TObj::TNodeI> NV;
-  PRankH.Gen(NNodes);
-  int MxId = -1;
-  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    NV.Add(NI);
-    PRankH.AddDat(NI.GetId(), 1.0/NNodes);
-    int Id = NI.GetId();
-    if (Id > MxId) {
-      MxId = Id;
-    }
-  }
-
-  TFltV PRankV(MxId+1);
-  TIntV OutDegV(MxId+1);
-
-  for (int j = 0; j < NNodes; j++) {
-    typename PGraph::TObj::TNodeI NI = NV[j];
-    int Id = NI.GetId();
-    PRankV[Id] = 1.0/NNodes;
-    OutDegV[Id] = NI.GetOutDeg();
-  }
-
-  TFltV TmpV(NNodes);
-
-  for (int iter = 0; iter < MaxIter; iter++) {
-    for (int j = 0; j < NNodes; j++) {
-      typename PGraph::TObj::TNodeI NI = NV[j];
-      TFlt Tmp = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
-        const int OutDeg = OutDegV[InNId];
-        if (OutDeg > 0) {
-          Tmp += PRankV[InNId] / OutDeg;
-        }
-      }
-      TmpV[j] =  C*Tmp; // Berkhin (the correct way of doing it)
-    }
-    double sum = 0;
-    for (int i = 0; i < TmpV.Len(); i++) { sum += TmpV[i]; }
-    const double Leaked = (1.0-sum) / double(NNodes);
-
-    double diff = 0;
-    for (int i = 0; i < NNodes; i++) {
-      typename PGraph::TObj::TNodeI NI = NV[i];
-      double NewVal = TmpV[i] + Leaked; // Berkhin
-      int Id = NI.GetId();
-      diff += fabs(NewVal-PRankV[Id]);
-      PRankV[Id] = NewVal;
-    }
-    if (diff < Eps) { break; }
-  }
+  TFltV ResidualV;
+  GetPageRank(Graph, PRankH, prmPull, ResidualV, C, Eps, MaxIter);
+}
 
-  for (int i = 0; i < NNodes; i++) {
-    typename PGraph::TObj::TNodeI NI = NV[i];
-    PRankH[i] = PRankV[NI.GetId()];
-  }
+template<class PGraph>
+int GetPageRank(const PGraph& Graph, TIntFltH& PRankH, const TPageRankMode& Mode, TFltV& ResidualV, const double& C, const double& Eps, const int& MaxIter) {
+  TSnapDetail::TRankGraph RankG(Graph->GetNodes());
+  TSnapDetail::GetRankGraph(Graph, RankG);
+  TFltV RankV;
+  const int Iters = RankG.GetPageRank(RankV, Mode, ResidualV, C, Eps, MaxIter);
+  RankG.GetNIdValH(RankV, PRankH);
+  return Iters;
 }
 
 #ifdef USE_OPENMP
-// Page Rank -- there are two different implementations (uncomment the desired 2 lines):
-//   Berkhin -- (the correct way) see Algorithm 1 of P. Berkhin, A Survey on PageRank Computing, Internet Mathematics, 2005
-//   iGraph -- iGraph implementation(which treats leaked PageRank in a funny way)
-// This is a parallel, optimized version.
+// The engine behind GetPageRank() runs in parallel already.
 template<class PGraph>
 void GetPageRankMP(const PGraph& Graph, TIntFltH& PRankH, const double& C, const double& Eps, const int& MaxIter) {
-  const int NNodes = Graph->GetNodes();
-  TVec<typename PGraph::TObj::TNodeI> NV;
-  PRankH.Gen(NNodes);
-
-  int MxId = -1;
-  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    NV.Add(NI);
-    PRankH.AddDat(NI.GetId(), 1.0/NNodes);
-    int Id = NI.GetId();
-    if (Id > MxId) {
-      MxId = Id;
-    }
-  }
-
-  TFltV PRankV(MxId+1);
-  TIntV OutDegV(MxId+1);
-
-  #pragma omp parallel for schedule(dynamic,10000)
-  for (int j = 0; j < NNodes; j++) {
-    typename PGraph::TObj::TNodeI NI = NV[j];
-    int Id = NI.GetId();
-    PRankV[Id] = 1.0/NNodes;
-    OutDegV[Id] = NI.GetOutDeg();
-  }
-
-  TFltV TmpV(NNodes);
-  for (int iter = 0; iter < MaxIter; iter++) {
-    #pragma omp parallel for schedule(dynamic,10000)
-    for (int j = 0; j < NNodes; j++) {
-      typename PGraph::TObj::TNodeI NI = NV[j];
-      TFlt Tmp = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        const int InNId = NI.GetInNId(e);
-        const int OutDeg = OutDegV[InNId];
-        if (OutDeg > 0) {
-          Tmp += PRankV[InNId] / OutDeg;
-        }
-      }
-      TmpV[j] =  C*Tmp; // Berkhin (the correct way of doing it)
-    }
-
-    double sum = 0;
-    #pragma omp parallel for reduction(+:sum) schedule(dynamic,10000)
-    for (int i = 0; i < TmpV.Len(); i++) { sum += TmpV[i]; }
-    const double Leaked = (1.0-sum) / double(NNodes);
-
-    double diff = 0;
-    #pragma omp parallel for reduction(+:diff) schedule(dynamic,10000)
-    for (int i = 0; i < NNodes; i++) {
-      double NewVal = TmpV[i] + Leaked; // Berkhin
-      int Id = NV[i].GetId();
-      diff += fabs(NewVal-PRankV[Id]);
-      PRankV[Id] = NewVal;
-    }
-    if (diff < Eps) { break; }
-  }
-
-  #pragma omp parallel for schedule(dynamic,10000)
-  for (int i = 0; i < NNodes; i++) {
-    typename PGraph::TObj::TNodeI NI = NV[i];
-    PRankH[i] = PRankV[NI.GetId()];
-  }
+  TFltV ResidualV;
+  GetPageRank(Graph, PRankH, prmPull, ResidualV, C, Eps, MaxIter);
 }
 #endif // USE_OPENMP
 
@@ -374,12 +436,6 @@ template<class PGraph>
 void GetBetweennessCentr(const PGraph& Graph, const TIntV& BtwNIdV, TIntFltH& NodeBtwH, const bool& DoNodeCent, TIntPrFltH& EdgeBtwH, const bool& DoEdgeCent, const bool& IsDir) {
   if (DoNodeCent) { NodeBtwH.Clr(); }
   if (DoEdgeCent) { EdgeBtwH.Clr(); }
-  const int nodes = Graph->GetNodes();
-  TIntS S(nodes);
-  TIntQ Q(nodes);
-  TIntIntVH P(nodes); // one vector for every node
-  TIntFltH delta(nodes);
-  TIntH sigma(nodes), d(nodes);
   // init
   for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
     if (DoNodeCent) {
@@ -406,83 +462,11 @@ void GetBetweennessCentr(const PGraph& Graph, const TIntV& BtwNIdV, TIntFltH& No
         }
       }
     }
-    sigma.AddDat(NI.GetId(), 0);
-    d.AddDat(NI.GetId(), -1);
-    P.AddDat(NI.GetId(), TIntV());
-    delta.AddDat(NI.GetId(), 0);
   }
   // calc betweeness
-  for (int k=0; k < BtwNIdV.Len(); k++) {
-    const typename PGraph::TObj::TNodeI NI = Graph->GetNI(BtwNIdV[k]);
-    // reset
-    for (int i = 0; i < sigma.Len(); i++) {
-      sigma[i]=0;  d[i]=-1;  delta[i]=0;  P[i].Clr(false);
-    }
-    S.Clr(false);
-    Q.Clr(false);
-    sigma.AddDat(NI.GetId(), 1);
-    d.AddDat(NI.GetId(), 0);
-    Q.Push(NI.GetId());
-    while (! Q.Empty()) {
-      const int v = Q.Top();  Q.Pop();
-      const typename PGraph::TObj::TNodeI NI2 = Graph->GetNI(v);
-      S.Push(v);
-      const int VDat = d.GetDat(v);
-      // iterate over all outgoing edges
-      for (int e = 0; e < NI2.GetOutDeg(); e++) {
-        const int w = NI2.GetOutNId(e);
-        if (d.GetDat(w) < 0) { // find w for the first time
-          Q.Push(w);
-          d.AddDat(w, VDat+1);
-        }
-        //shortest path to w via v ?
-        if (d.GetDat(w) == VDat+1) {
-          sigma.AddDat(w) += sigma.GetDat(v);
-          P.GetDat(w).Add(v);
-        }
-      }
-      // if ignoring direction in directed networks, iterate over incoming edges
-      if (Graph->HasFlag(gfDirected) && !IsDir) {
-        for (int e = 0; e < NI2.GetInDeg(); e++) {
-          const int w = NI2.GetInNId(e);
-          // skip neighbors that are also outgoing
-          if (Graph->IsEdge(NI2.GetId(), w)) {
-            continue;
-          }
-          if (d.GetDat(w) < 0) { // find w for the first time
-            Q.Push(w);
-            d.AddDat(w, VDat+1);
-          }
-          //shortest path to w via v ?
-          if (d.GetDat(w) == VDat+1) {
-            sigma.AddDat(w) += sigma.GetDat(v);
-            P.GetDat(w).Add(v);
-          }
-        }
-      }
-    }
-    while (! S.Empty()) {
-      const int w = S.Top();
-      const double SigmaW = sigma.GetDat(w);
-      const double DeltaW = delta.GetDat(w);
-      const TIntV NIdV = P.GetDat(w);
-      S.Pop();
-      for (int i = 0; i < NIdV.Len(); i++) {
-        const int NId = NIdV[i];
-        const double c = (sigma.GetDat(NId)*1.0/SigmaW) * (1+DeltaW);
-        delta.AddDat(NId) += c;
-        if (DoEdgeCent) {
-          if (Graph->HasFlag(gfDirected) && IsDir) {
-            EdgeBtwH.AddDat(TIntPr(NId, w)) += c;
-          } else {
-            EdgeBtwH.AddDat(TIntPr(TMath::Mn(NId, w), TMath::Mx(NId, w))) += c;
-          }
-        }
-      }
-      if (DoNodeCent && w != NI.GetId()) {
-        NodeBtwH.AddDat(w) += delta.GetDat(w)/2.0; }
-    }
-  }
+  TSnapDetail::TBtwGraph BtwG(Graph->GetNodes());
+  TSnapDetail::GetBtwGraph(Graph, IsDir, BtwG);
+  BtwG.GetBtw(BtwNIdV, NodeBtwH, DoNodeCent, EdgeBtwH, DoEdgeCent);
 }
 
 template<class PGraph>
@@ -520,99 +504,27 @@ void GetBetweennessCentr(const PGraph& Graph, TIntFltH& NodeBtwH, TIntPrFltH& Ed
   GetBetweennessCentr<PGraph> (Graph, NIdV, NodeBtwH, true, EdgeBtwH, true, IsDir);
 }
 
+template<class PGraph>
+int GetBetweennessCentrApprox(const PGraph& Graph, TIntFltH& NIdBtwH, const double& Eps, const double& Delta, const bool& IsDir, const int& RndSeed) {
+  TSnapDetail::TBtwGraph BtwG(Graph->GetNodes());
+  TSnapDetail::GetBtwGraph(Graph, IsDir, BtwG);
+  return BtwG.GetBtwApprox(NIdBtwH, Eps, Delta, RndSeed);
+}
+
 template<class PGraph>
 void GetHits(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const int& MaxIter) {
-  const int NNodes = Graph->GetNodes();
-  NIdHubH.Gen(NNodes);
-  NIdAuthH.Gen(NNodes);
-  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    NIdHubH.AddDat(NI.GetId(), 1.0);
-    NIdAuthH.AddDat(NI.GetId(), 1.0);
-  }
-  double Norm=0;
-  for (int iter = 0; iter < MaxIter; iter++) {
-    // update authority scores
-    Norm = 0;
-    for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-      double& Auth = NIdAuthH.GetDat(NI.GetId()).Val;
-      Auth = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        Auth +=  NIdHubH.GetDat(NI.GetInNId(e)); }
-      Norm += Auth*Auth;
-    }
-    Norm = sqrt(Norm);
-    for (int i = 0; i < NIdAuthH.Len(); i++) { NIdAuthH[i] /= Norm; }
-    // update hub scores
-    for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-      double& Hub = NIdHubH.GetDat(NI.GetId()).Val;
-      Hub = 0;
-      for (int e = 0; e < NI.GetOutDeg(); e++) {
-        Hub += NIdAuthH.GetDat(NI.GetOutNId(e)); }
-      Norm += Hub*Hub;
-    }
-    Norm = sqrt(Norm);
-    for (int i = 0; i < NIdHubH.Len(); i++) { NIdHubH[i] /= Norm; }
-  }
-  // make sure Hub and Authority scores normalize to L2 norm 1
-  Norm = 0.0;
-  for (int i = 0; i < NIdHubH.Len(); i++) { Norm += TMath::Sqr(NIdHubH[i]); }
-  Norm = sqrt(Norm);
-  for (int i = 0; i < NIdHubH.Len(); i++) { NIdHubH[i] /= Norm; }
-  Norm = 0.0;
-  for (int i = 0; i < NIdAuthH.Len(); i++) { Norm += TMath::Sqr(NIdAuthH[i]); }
-  Norm = sqrt(Norm);
-  for (int i = 0; i < NIdAuthH.Len(); i++) { NIdAuthH[i] /= Norm; }
+  TSnapDetail::TRankGraph RankG(Graph->GetNodes());
+  TSnapDetail::GetRankGraph(Graph, RankG);
+  TFltV HubV, AuthV;
+  RankG.GetHits(HubV, AuthV, MaxIter);
+  RankG.GetNIdValH(HubV, NIdHubH);
+  RankG.GetNIdValH(AuthV, NIdAuthH);
 }
 
 #ifdef USE_OPENMP
 template<class PGraph>
 void GetHitsMP(const PGraph& Graph, TIntFltH& NIdHubH, TIntFltH& NIdAuthH, const int& MaxIter) {
-  const int NNodes = Graph->GetNodes();
-  TIntV NV;
-  NIdHubH.Gen(NNodes);
-  NIdAuthH.Gen(NNodes);
-  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    NV.Add(NI.GetId());
-    NIdHubH.AddDat(NI.GetId(), 1.0);
-    NIdAuthH.AddDat(NI.GetId(), 1.0);
-  }
-  double Norm=0;
-  for (int iter = 0; iter < MaxIter; iter++) {
-    // update authority scores
-    Norm = 0;
-    #pragma omp parallel for reduction(+:Norm) schedule(dynamic,1000)
-    for (int i = 0; i < NNodes; i++) {
-      typename PGraph::TObj::TNodeI NI = Graph->GetNI(NV[i]);
-      double& Auth = NIdAuthH.GetDat(NI.GetId()).Val;
-      Auth = 0;
-      for (int e = 0; e < NI.GetInDeg(); e++) {
-        Auth +=  NIdHubH.GetDat(NI.GetInNId(e)); }
-      Norm = Norm + Auth*Auth;
-    }
-    Norm = sqrt(Norm);
-    for (int i = 0; i < NIdAuthH.Len(); i++) { NIdAuthH[i] /= Norm; }
-    // update hub scores
-    #pragma omp parallel for reduction(+:Norm) schedule(dynamic,1000)
-    for (int i = 0; i < NNodes; i++) {
-      typename PGraph::TObj::TNodeI NI = Graph->GetNI(NV[i]);
-      double& Hub = NIdHubH.GetDat(NI.GetId()).Val;
-      Hub = 0;
-      for (int e = 0; e < NI.GetOutDeg(); e++) {
-        Hub += NIdAuthH.GetDat(NI.GetOutNId(e)); }
-      Norm = Norm + Hub*Hub;
-    }
-    Norm = sqrt(Norm);
-    for (int i = 0; i < NIdHubH.Len(); i++) { NIdHubH[i] /= Norm; }
-  }
-  // make sure Hub and Authority scores normalize to L2 norm 1
-  Norm = 0.0;
-  for (int i = 0; i < NIdHubH.Len(); i++) { Norm += TMath::Sqr(NIdHubH[i]); }
-  Norm = sqrt(Norm);
-  for (int i = 0; i < NIdHubH.Len(); i++) { NIdHubH[i] /= Norm; }
-  Norm = 0.0;
-  for (int i = 0; i < NIdAuthH.Len(); i++) { Norm += TMath::Sqr(NIdAuthH[i]); }
-  Norm = sqrt(Norm);
-  for (int i = 0; i < NIdAuthH.Len(); i++) { NIdAuthH[i] /= Norm; }
+  GetHits(Graph, NIdHubH, NIdAuthH, MaxIter);
 }
 #endif
 
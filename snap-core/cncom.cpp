@@ -24,10 +24,378 @@ void TCnCom::SaveTxt(const TCnComV& CnComV, const TStr& FNm, const TStr& Desc) {
   fclose(F);
 }
 
+/////////////////////////////////////////////////
+// Weakly connected components of an edge stream
+int TStreamWcc::AddNode(const int& NId) {
+  int NIdx = NIdSet.GetKeyId(NId);
+  if (NIdx == -1) {
+    NIdx = NIdSet.AddKey(NId);
+    ParentV.Add(NIdx);  Comps++;
+  }
+  return NIdx;
+}
+
+void TStreamWcc::AddEdge(const int& SrcNId, const int& DstNId) {
+  const int Root1 = GetRoot(AddNode(SrcNId));
+  const int Root2 = GetRoot(AddNode(DstNId));
+  if (Root1 == Root2) { return; }
+  // the root with the larger index is linked below the other one
+  if (Root1 < Root2) { ParentV[Root2] = Root1; }
+  else { ParentV[Root1] = Root2; }
+  Comps--;
+}
+
+void TStreamWcc::AddEdges(const TIntV& SrcNIdV, const TIntV& DstNIdV) {
+  IAssert(SrcNIdV.Len() == DstNIdV.Len());
+  for (int e = 0; e < SrcNIdV.Len(); e++) {
+    AddEdge(SrcNIdV[e], DstNIdV[e]);
+  }
+}
+
+void TStreamWcc::LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId) {
+  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
+  int SrcNId, DstNId;
+  while (Ss.Next()) {
+    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
+    AddEdge(SrcNId, DstNId);
+  }
+}
+
+void TStreamWcc::GetWccs(TCnComV& CnComV) {
+  const int Nodes = GetNodes();
+  TIntPrV NIdRootV(Nodes, 0);
+  for (int i = 0; i < Nodes; i++) {
+    NIdRootV.Add(TIntPr(NIdSet.GetKey(i), GetRoot(i)));
+  }
+  NIdRootV.Sort();
+  TIntV NIdV(Nodes), CompV(Nodes);
+  for (int i = 0; i < Nodes; i++) {
+    NIdV[i] = NIdRootV[i].Val1;  CompV[i] = NIdRootV[i].Val2;
+  }
+  TSnap::TSnapDetail::GetCnComV(NIdV, CompV, CnComV);
+}
+
+void TStreamWcc::GetWccSzCnt(TIntPrV& WccSzCnt) {
+  TIntV CompV(GetNodes());
+  for (int i = 0; i < CompV.Len(); i++) { CompV[i] = GetRoot(i); }
+  TSnap::TSnapDetail::GetCnComSzCnt(CompV, WccSzCnt);
+}
+
 /////////////////////////////////////////////////
 // Connected Components
 namespace TSnap {
 
+namespace TSnapDetail {
+
+void GetCnComV(const TIntV& NIdV, const TIntV& CompV, TCnComV& CnComV) {
+  const int Nodes = NIdV.Len();
+  // components are disjoint and their node ids are sorted, so TCnComV::Sort(false) orders them
+  // by size and then by the smallest node id, here without moving the node id vectors around
+  TIntV CntV(Nodes), CnComIdV(Nodes);
+  TIntTrV SzNIdCompV;
+  for (int i = 0; i < Nodes; i++) {
+    if (CntV[CompV[i]] == 0) { SzNIdCompV.Add(TIntTr(0, NIdV[i], CompV[i])); }
+    CntV[CompV[i]] += 1;
+  }
+  for (int c = 0; c < SzNIdCompV.Len(); c++) {
+    SzNIdCompV[c].Val1 = CntV[SzNIdCompV[c].Val3]; }
+  SzNIdCompV.Sort(false);
+  CnComV.Gen(SzNIdCompV.Len());
+  for (int c = 0; c < SzNIdCompV.Len(); c++) {
+    CnComIdV[SzNIdCompV[c].Val3] = c;
+    CnComV[c].NIdV.Gen(SzNIdCompV[c].Val1, 0);
+  }
+  for (int i = 0; i < Nodes; i++) {
+    CnComV[CnComIdV[CompV[i]]].Add(NIdV[i]); }
+}
+
+void GetCnComSzCnt(const TIntV& CompV, TIntPrV& SzCntV) {
+  TIntV CntV(CompV.Len());
+  for (int i = 0; i < CompV.Len(); i++) { CntV[CompV[i]] += 1; }
+  TIntH SzCntH;
+  for (int c = 0; c < CntV.Len(); c++) {
+    if (CntV[c] > 0) { SzCntH.AddDat(CntV[c]) += 1; }
+  }
+  SzCntH.GetKeyDatPrV(SzCntV);
+  SzCntV.Sort(true);
+}
+
+// Links the trees of nodes NIdx1 and NIdx2, roots are only ever linked below smaller indices.
+// Threads race on the roots with compare-and-swap, a failed swap retries from the new parents.
+void TCnComGraph::Link(int NIdx1, int NIdx2, TIntV& CompV) const {
+  int P1 = CompV[NIdx1], P2 = CompV[NIdx2];
+  while (P1 != P2) {
+    const int High = P1 > P2 ? P1 : P2;
+    const int Low = P1 > P2 ? P2 : P1;
+    const int PHigh = CompV[High];
+    if (PHigh == Low) { break; }
+    if (PHigh == High) {
+#ifdef GCC_ATOMIC
+      if (__sync_bool_compare_and_swap(&CompV[High].Val, High, Low)) { break; }
+#else
+      CompV[High] = Low;  break;
+#endif
+    }
+    P1 = CompV[CompV[High]];  P2 = CompV[Low];
+  }
+}
+
+// Points every node directly to the root of its tree.
+void TCnComGraph::Compress(TIntV& CompV) const {
+  const int Nodes = GetNodes();
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(static, 4096)
+#endif
+  for (int i = 0; i < Nodes; i++) {
+    while (CompV[i] != CompV[CompV[i]]) { CompV[i] = CompV[CompV[i]]; }
+  }
+}
+
+void TCnComGraph::GetWccIdxV(TIntV& CompV) const {
+  const int Nodes = GetNodes();
+  const int NbrRounds = 2;
+  CompV.Gen(Nodes);
+  for (int i = 0; i < Nodes; i++) { CompV[i] = i; }
+  // link every node to its first few neighbors, on most graphs this already builds the giant component
+  for (int r = 0; r < NbrRounds; r++) {
+#ifdef GCC_ATOMIC
+    #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for (int i = 0; i < Nodes; i++) {
+      if (OffV[i] + r < OffV[i+1]) { Link(i, NbrV[OffV[i]+r], CompV); }
+    }
+    Compress(CompV);
+  }
+  // the most frequent component in a sample of nodes is most likely the giant component
+  TRnd Rnd(1);
+  TIntH CompCntH;
+  int GiantComp = -1, MxCnt = 0;
+  for (int s = 0; s < TMath::Mn(Nodes, 1024); s++) {
+    const int Comp = CompV[Rnd.GetUniDevInt(Nodes)];
+    const int Cnt = CompCntH.AddDat(Comp) += 1;
+    if (Cnt > MxCnt) { MxCnt = Cnt;  GiantComp = Comp; }
+  }
+  // the remaining edges of the nodes outside of the giant component, edges from the giant component
+  // are linked from their other endpoint, which in directed graphs finds them among its in-edges
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (int i = 0; i < Nodes; i++) {
+    if (CompV[i] == GiantComp) { continue; }
+    for (int64 e = OffV[i] + NbrRounds; e < OffV[i+1]; e++) { Link(i, NbrV[e], CompV); }
+    if (! Dir) { continue; }
+    for (int64 e = InOffV[i]; e < InOffV[i+1]; e++) { Link(i, InNbrV[e], CompV); }
+  }
+  Compress(CompV);
+}
+
+// Nodes without an in-neighbor or an out-neighbor among the unassigned nodes (CompV[i]==-1)
+// are strongly connected components on their own. Removing them can expose further such nodes.
+void TCnComGraph::TrimScc(TIntV& CompV) const {
+  const int Nodes = GetNodes();
+  TIntV InDegV(Nodes), OutDegV(Nodes), QueueV;
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (int i = 0; i < Nodes; i++) {
+    if (CompV[i] != -1) { continue; }
+    int OutDeg = 0, InDeg = 0;
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) {
+      if (NbrV[e] != i && CompV[NbrV[e]] == -1) { OutDeg++; } }
+    for (int64 e = InOffV[i]; e < InOffV[i+1]; e++) {
+      if (InNbrV[e] != i && CompV[InNbrV[e]] == -1) { InDeg++; } }
+    OutDegV[i] = OutDeg;  InDegV[i] = InDeg;
+  }
+  for (int i = 0; i < Nodes; i++) {
+    if (CompV[i] == -1 && (InDegV[i] == 0 || OutDegV[i] == 0)) { CompV[i] = i;  QueueV.Add(i); }
+  }
+  for (int q = 0; q < QueueV.Len(); q++) {
+    const int NIdx = QueueV[q];
+    for (int64 e = OffV[NIdx]; e < OffV[NIdx+1]; e++) {
+      const int DstNIdx = NbrV[e];
+      if (CompV[DstNIdx] != -1) { continue; }
+      InDegV[DstNIdx] -= 1;
+      if (InDegV[DstNIdx] == 0) { CompV[DstNIdx] = DstNIdx;  QueueV.Add(DstNIdx); }
+    }
+    for (int64 e = InOffV[NIdx]; e < InOffV[NIdx+1]; e++) {
+      const int SrcNIdx = InNbrV[e];
+      if (CompV[SrcNIdx] != -1) { continue; }
+      OutDegV[SrcNIdx] -= 1;
+      if (OutDegV[SrcNIdx] == 0) { CompV[SrcNIdx] = SrcNIdx;  QueueV.Add(SrcNIdx); }
+    }
+  }
+}
+
+// Level synchronous BFS from SrcNIdx over out-edges (Fwd) or in-edges, which sets MarkV of reached nodes from From to To.
+void TCnComGraph::MarkReach(const int& SrcNIdx, const bool& Fwd, TIntV& MarkV, const int& From, const int& To) const {
+  const TVec<TInt64>& EOffV = Fwd ? OffV : InOffV;
+  const TNIdxMap::TNbrV& ENbrV = Fwd ? NbrV : InNbrV;
+#ifdef GCC_ATOMIC
+  TVec<TIntV> NextVV(omp_get_max_threads());
+#else
+  TVec<TIntV> NextVV(1);
+#endif
+  TIntV FrontV;
+  MarkV[SrcNIdx] = To;
+  FrontV.Add(SrcNIdx);
+  while (! FrontV.Empty()) {
+    const int FrontLen = FrontV.Len();
+#ifdef GCC_ATOMIC
+    #pragma omp parallel for schedule(dynamic, 64) if (FrontLen > 256)
+#endif
+    for (int i = 0; i < FrontLen; i++) {
+#ifdef GCC_ATOMIC
+      TIntV& NextV = NextVV[omp_get_thread_num()];
+#else
+      TIntV& NextV = NextVV[0];
+#endif
+      const int NIdx = FrontV[i];
+      for (int64 e = EOffV[NIdx]; e < EOffV[NIdx+1]; e++) {
+        const int NbrNIdx = ENbrV[e];
+        if (MarkV[NbrNIdx] != From) { continue; }
+#ifdef GCC_ATOMIC
+        if (__sync_bool_compare_and_swap(&MarkV[NbrNIdx].Val, From, To)) { NextV.Add(NbrNIdx); }
+#else
+        MarkV[NbrNIdx] = To;  NextV.Add(NbrNIdx);
+#endif
+      }
+    }
+    FrontV.Clr(false);
+    for (int t = 0; t < NextVV.Len(); t++) {
+      FrontV.AddV(NextVV[t]);  NextVV[t].Clr(false);
+    }
+  }
+}
+
+// Tarjan's algorithm on the unassigned nodes (CompV[i]==-1), with an explicit stack of nodes and edge positions.
+// Visited nodes that are not assigned yet are on the component stack.
+void TCnComGraph::TarjanScc(TIntV& CompV) const {
+  const int Nodes = GetNodes();
+  TIntV PreV(Nodes), LowV(Nodes), SccStackV, CallV;
+  TVec<TInt64> EdgeV;
+  PreV.PutAll(-1);
+  int Time = 0;
+  for (int Start = 0; Start < Nodes; Start++) {
+    if (CompV[Start] != -1 || PreV[Start] != -1) { continue; }
+    PreV[Start] = Time;  LowV[Start] = Time;  Time++;
+    SccStackV.Add(Start);  CallV.Add(Start);  EdgeV.Add(OffV[Start]);
+    while (! CallV.Empty()) {
+      const int NIdx = CallV.Last();
+      if (EdgeV.Last() < OffV[NIdx+1]) {
+        const int DstNIdx = NbrV[EdgeV.Last()];
+        EdgeV.Last() += 1;
+        if (CompV[DstNIdx] != -1) { continue; }
+        if (PreV[DstNIdx] == -1) {
+          PreV[DstNIdx] = Time;  LowV[DstNIdx] = Time;  Time++;
+          SccStackV.Add(DstNIdx);  CallV.Add(DstNIdx);  EdgeV.Add(OffV[DstNIdx]);
+        } else if (PreV[DstNIdx] < LowV[NIdx]) { LowV[NIdx] = PreV[DstNIdx]; }
+        continue;
+      }
+      CallV.DelLast();  EdgeV.DelLast();
+      if (! CallV.Empty() && LowV[NIdx] < LowV[CallV.Last()]) { LowV[CallV.Last()] = LowV[NIdx]; }
+      if (LowV[NIdx] != PreV[NIdx]) { continue; }
+      // NIdx is the root of a component, which consists of the nodes above it on the component stack
+      int SccNIdx;
+      do {
+        SccNIdx = SccStackV.Last();  SccStackV.DelLast();
+        CompV[SccNIdx] = NIdx;
+      } while (SccNIdx != NIdx);
+    }
+  }
+}
+
+void TCnComGraph::GetSccIdxV(TIntV& CompV) const {
+  if (! Dir) { GetWccIdxV(CompV);  return; }
+  const int Nodes = GetNodes();
+  CompV.Gen(Nodes);
+  CompV.PutAll(-1);
+  TrimScc(CompV);
+  // forward-backward search from the node with the largest product of in- and out-degree, which is most
+  // likely in the giant component: the nodes that are reached in both directions form its component
+  int Pivot = -1;
+  int64 MxDegPrd = -1;
+  for (int i = 0; i < Nodes; i++) {
+    const int64 DegPrd = int64(OffV[i+1] - OffV[i]) * int64(InOffV[i+1] - InOffV[i]);
+    if (CompV[i] == -1 && DegPrd > MxDegPrd) { MxDegPrd = DegPrd;  Pivot = i; }
+  }
+  if (Pivot != -1) {
+    TIntV MarkV(Nodes);
+    for (int i = 0; i < Nodes; i++) { MarkV[i] = CompV[i] == -1 ? 0 : -1; }
+    MarkReach(Pivot, true, MarkV, 0, 1);
+    MarkReach(Pivot, false, MarkV, 1, 2);
+    for (int i = 0; i < Nodes; i++) {
+      if (MarkV[i] == 2) { CompV[i] = Pivot; } }
+    TrimScc(CompV);
+  }
+  // coloring of the remaining nodes: every node takes the largest color of its in-neighbors until no color
+  // changes, so the color of a node is the largest node index that reaches it. A node that keeps its own
+  // color is a root, and the nodes of its color that reach it back form its component. Colors travel one
+  // edge per pass and a round can remove a single component, as on a chain of components, so coloring
+  // stops once a round needs more than MxPasses passes or removes fewer than 1/MnRemoveFrac of the nodes.
+  const int MxPasses = 64, MnRemoveFrac = 100;
+  TIntV ActV, ColorV(Nodes), RootV;
+  for (int i = 0; i < Nodes; i++) {
+    if (CompV[i] == -1) { ActV.Add(i); } }
+#ifdef USE_OPENMP
+  TVec<TIntV> StackVV(omp_get_max_threads());
+#else
+  TVec<TIntV> StackVV(1);
+#endif
+  while (! ActV.Empty()) {
+    const int Active = ActV.Len();
+    for (int a = 0; a < Active; a++) { ColorV[ActV[a]] = ActV[a]; }
+    int Changed = 1, Passes = 0;
+    while (Changed > 0 && Passes < MxPasses) {
+      Changed = 0;  Passes++;
+#ifdef USE_OPENMP
+      #pragma omp parallel for schedule(dynamic, 1024) reduction(+:Changed)
+#endif
+      for (int a = 0; a < Active; a++) {
+        const int NIdx = ActV[a];
+        int Color = ColorV[NIdx];
+        for (int64 e = InOffV[NIdx]; e < InOffV[NIdx+1]; e++) {
+          const int SrcNIdx = InNbrV[e];
+          if (CompV[SrcNIdx] == -1 && ColorV[SrcNIdx] > Color) { Color = ColorV[SrcNIdx]; }
+        }
+        if (Color != ColorV[NIdx]) { ColorV[NIdx] = Color;  Changed++; }
+      }
+    }
+    if (Changed > 0) { break; }
+    RootV.Clr(false);
+    for (int a = 0; a < Active; a++) {
+      if (ColorV[ActV[a]] == ActV[a]) { RootV.Add(ActV[a]); } }
+    // components of different roots have different colors, so the backward searches are independent
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int r = 0; r < RootV.Len(); r++) {
+#ifdef USE_OPENMP
+      TIntV& StackV = StackVV[omp_get_thread_num()];
+#else
+      TIntV& StackV = StackVV[0];
+#endif
+      const int Root = RootV[r];
+      CompV[Root] = Root;
+      StackV.Add(Root);
+      while (! StackV.Empty()) {
+        const int NIdx = StackV.Last();  StackV.DelLast();
+        for (int64 e = InOffV[NIdx]; e < InOffV[NIdx+1]; e++) {
+          const int SrcNIdx = InNbrV[e];
+          if (ColorV[SrcNIdx] == Root && CompV[SrcNIdx] == -1) { CompV[SrcNIdx] = Root;  StackV.Add(SrcNIdx); }
+        }
+      }
+    }
+    int NewActive = 0;
+    for (int a = 0; a < Active; a++) {
+      if (CompV[ActV[a]] == -1) { ActV[NewActive++] = ActV[a]; } }
+    ActV.Reduce(NewActive);
+    if (Active - NewActive < Active / MnRemoveFrac) { break; }
+  }
+  TarjanScc(CompV);
+}
+
+} // namespace TSnapDetail
+
 void GetBiConSzCnt(const PUNGraph& Graph, TIntPrV& SzCntV) {
   TCnComV BiCnComV;
   GetBiCon(Graph, BiCnComV);
@@ -235,10 +235,97 @@ public:
     return abs(TmRtH.GetDat(NId1).Val1) < abs(TmRtH.GetDat(NId2).Val1) ? NId1 : NId2; }
 };
 
+//#//////////////////////////////////////////////
+/// Weakly connected components of an edge stream. ##TStreamWcc
+class TStreamWcc {
+private:
+  TIntSet NIdSet;  // node ids, the key id of a node is its index
+  TIntV ParentV;   // union-find parent of every node index
+  int Comps;
+private:
+  int GetRoot(int NIdx) {
+    while (ParentV[NIdx] != NIdx) {
+      ParentV[NIdx] = ParentV[ParentV[NIdx]];  NIdx = ParentV[NIdx]; } // path halving
+    return NIdx; }
+public:
+  TStreamWcc(const int& ExpectNodes=0) : NIdSet(ExpectNodes), ParentV(ExpectNodes, 0), Comps(0) { }
+  void Clr() { NIdSet.Clr();  ParentV.Clr();  Comps = 0; }
+  /// Returns the number of nodes seen so far.
+  int GetNodes() const { return NIdSet.Len(); }
+  /// Returns the number of weakly connected components of the nodes and edges seen so far.
+  int GetWccCnt() const { return Comps; }
+  bool IsNode(const int& NId) const { return NIdSet.IsKey(NId); }
+  /// Adds node NId (if it is not present yet) and returns its index.
+  int AddNode(const int& NId);
+  /// Adds an edge between nodes SrcNId and DstNId, the nodes are added if they are not present yet.
+  void AddEdge(const int& SrcNId, const int& DstNId);
+  /// Adds edges (SrcNIdV[i], DstNIdV[i]), for example the output of TSnap::LoadEdgeListV().
+  void AddEdges(const TIntV& SrcNIdV, const TIntV& DstNIdV);
+  /// Adds all the edges of an edge list file line by line, the file is never loaded at once. ##TStreamWcc::LoadEdgeList
+  void LoadEdgeList(const TStr& InFNm, const int& SrcColId=0, const int& DstColId=1);
+  /// Tests whether nodes NId1 and NId2 are in the same weakly connected component.
+  bool IsSameWcc(const int& NId1, const int& NId2) {
+    return GetRoot(NIdSet.GetKeyId(NId1)) == GetRoot(NIdSet.GetKeyId(NId2)); }
+  /// Returns all weakly connected components, in the same order as TSnap::GetWccs() on the graph of the stream.
+  void GetWccs(TCnComV& CnComV);
+  /// Returns a distribution of weakly connected component sizes.
+  void GetWccSzCnt(TIntPrV& WccSzCnt);
+};
+
 //#//////////////////////////////////////////////
 // Implementation
 namespace TSnap {
 
+namespace TSnapDetail {
+/// Compact copy of a graph on node indices for the parallel connected components algorithms.
+/// Nodes are indexed in the order of their ids, so components come out with sorted node ids.
+class TCnComGraph {
+private:
+  bool Dir;
+  TIntV NIdV;            // node id of every node index
+  TVec<TInt64> OffV;              // out-neighbors (all neighbors for undirected graphs) of node index i are NbrV[OffV[i]..OffV[i+1])
+  TNIdxMap::TNbrV NbrV;
+  TVec<TInt64> InOffV;            // in-neighbors of directed graphs
+  TNIdxMap::TNbrV InNbrV;
+private:
+  void Link(int NIdx1, int NIdx2, TIntV& CompV) const;
+  void Compress(TIntV& CompV) const;
+  void TrimScc(TIntV& CompV) const;
+  void MarkReach(const int& SrcNIdx, const bool& Fwd, TIntV& MarkV, const int& From, const int& To) const;
+  void TarjanScc(TIntV& CompV) const;
+public:
+  template <class PGraph> TCnComGraph(const PGraph& Graph);
+  int GetNodes() const { return NIdV.Len(); }
+  const TIntV& GetNIdV() const { return NIdV; }
+  /// Weakly connected components with the Afforest union-find, CompV[i] is the smallest node index in the component of i.
+  void GetWccIdxV(TIntV& CompV) const;
+  /// Strongly connected components with trimming, forward-backward search and coloring, CompV[i] is a node index in the component of i.
+  /// Coloring stops when it makes little progress, Tarjan's algorithm finds the remaining components.
+  void GetSccIdxV(TIntV& CompV) const;
+};
+
+/// Groups sorted node ids NIdV by component labels CompV (in 0..NIdV.Len()-1) in the order of TCnComV::Sort(false).
+void GetCnComV(const TIntV& NIdV, const TIntV& CompV, TCnComV& CnComV);
+/// Returns the distribution of component sizes of the component labels CompV (in 0..CompV.Len()-1).
+void GetCnComSzCnt(const TIntV& CompV, TIntPrV& SzCntV);
+
+template <class PGraph>
+TCnComGraph::TCnComGraph(const PGraph& Graph) : Dir(Graph->HasFlag(gfDirected)) {
+  const int Nodes = Graph->GetNodes();
+  NIdV.Gen(Nodes, 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdV.Add(NI.GetId()); }
+  NIdV.Sort();
+  TNIdxMap NIdxMap;
+  NIdxMap.Gen(NIdV);
+  TVec<typename PGraph::TObj::TNodeI> NIV(Nodes, 0);
+  for (int i = 0; i < Nodes; i++) { NIV.Add(Graph->GetNI(NIdV[i])); }
+  NIdxMap.GetNbrIdxV(NIV, true, false, OffV, NbrV);
+  if (Dir) { NIdxMap.GetNbrIdxV(NIV, false, true, InOffV, InNbrV); }
+}
+} // namespace TSnapDetail
+
+
 template <class PGraph> 
 void GetNodeWcc(const PGraph& Graph, const int& NId, TIntV& CnCom) {
   typename PGraph::TObj::TNodeI NI;
@@ -301,101 +388,32 @@ bool IsWeaklyConn(const PGraph& Graph) {
 
 template <class PGraph>
 void GetWccSzCnt(const PGraph& Graph, TIntPrV& WccSzCnt) {
-  THashSet<TInt> VisitedNId(Graph->GetNodes());
-  TIntH SzToCntH;
-  TSnapQueue<int> NIdQ(Graph->GetNodes()+1);
-  typename PGraph::TObj::TNodeI NI;
-  int Cnt = 0;
-  // zero degree nodes
-  for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    if (NI.GetDeg() == 0) { Cnt++;  VisitedNId.AddKey(NI.GetId()); }
-  }
-  if (Cnt > 0) SzToCntH.AddDat(1, Cnt);
-  // the rest of the nodes
-  for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    if (! VisitedNId.IsKey(NI.GetId())) {
-      VisitedNId.AddKey(NI.GetId());
-      NIdQ.Clr(false);  NIdQ.Push(NI.GetId());
-      Cnt = 0;
-      while (! NIdQ.Empty()) {
-        const typename PGraph::TObj::TNodeI Node = Graph->GetNI(NIdQ.Top());  NIdQ.Pop();
-        if (HasGraphFlag(typename PGraph::TObj, gfDirected)) {
-          for (int e = 0; e < Node.GetInDeg(); e++) {
-            const int InNId = Node.GetInNId(e);
-            if (! VisitedNId.IsKey(InNId)) { NIdQ.Push(InNId);  VisitedNId.AddKey(InNId); }
-          }
-        }
-        for (int e = 0; e < Node.GetOutDeg(); e++) {
-          const int OutNId = Node.GetOutNId(e);
-          if (! VisitedNId.IsKey(OutNId)) { NIdQ.Push(OutNId);  VisitedNId.AddKey(OutNId); }
-        }
-        Cnt++;
-      }
-      SzToCntH.AddDat(Cnt) += 1;
-    }
-  }
-  SzToCntH.GetKeyDatPrV(WccSzCnt);
-  WccSzCnt.Sort(true);
+  TIntV CompV;
+  TSnapDetail::TCnComGraph(Graph).GetWccIdxV(CompV);
+  TSnapDetail::GetCnComSzCnt(CompV, WccSzCnt);
 }
 
 template <class PGraph>
 void GetWccs(const PGraph& Graph, TCnComV& CnComV) {
-  typename PGraph::TObj::TNodeI NI;
-  THashSet<TInt> VisitedNId(Graph->GetNodes()+1);
-  TSnapQueue<int> NIdQ(Graph->GetNodes()+1);
-  TIntV CcNIdV;
-  CnComV.Clr();  CcNIdV.Gen(1);
-  // zero degree nodes
-  for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    if (NI.GetDeg() == 0) {
-      const int NId = NI.GetId();
-      VisitedNId.AddKey(NId);
-      CcNIdV[0] = NId;  CnComV.Add(CcNIdV);
-    }
-  }
-  // the rest of the nodes
-  for (NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    const int NId = NI.GetId();
-    if (! VisitedNId.IsKey(NId)) {
-      VisitedNId.AddKey(NId);
-      NIdQ.Clr(false);  NIdQ.Push(NId);
-      CcNIdV.Clr();  CcNIdV.Add(NId);
-      while (! NIdQ.Empty()) {
-        const typename PGraph::TObj::TNodeI Node = Graph->GetNI(NIdQ.Top());  NIdQ.Pop();
-        if (HasGraphFlag(typename PGraph::TObj, gfDirected)) {
-          for (int e = 0; e < Node.GetInDeg(); e++) {
-            const int InNId = Node.GetInNId(e);
-            if (! VisitedNId.IsKey(InNId)) {
-              NIdQ.Push(InNId);  VisitedNId.AddKey(InNId);  CcNIdV.Add(InNId); }
-          }
-        }
-        for (int e = 0; e < Node.GetOutDeg(); e++) {
-          const int OutNId = Node.GetOutNId(e);
-          if (! VisitedNId.IsKey(OutNId)) {
-            NIdQ.Push(OutNId);  VisitedNId.AddKey(OutNId);  CcNIdV.Add(OutNId); }
-        }
-      }
-      CcNIdV.Sort(true);
-      CnComV.Add(TCnCom(CcNIdV)); // add wcc comoponent
-    }
-  }
-  CnComV.Sort(false);
+  const TSnapDetail::TCnComGraph CnComG(Graph);
+  TIntV CompV;
+  CnComG.GetWccIdxV(CompV);
+  TSnapDetail::GetCnComV(CnComG.GetNIdV(), CompV, CnComV);
 }
 
 template <class PGraph>
 void GetSccSzCnt(const PGraph& Graph, TIntPrV& SccSzCnt) {
-  TSccVisitor<PGraph, true> Visitor(Graph);
-  TCnCom::GetDfsVisitor(Graph, Visitor);
-  Visitor.SccCntH.GetKeyDatPrV(SccSzCnt);
-  SccSzCnt.Sort(true);
+  TIntV CompV;
+  TSnapDetail::TCnComGraph(Graph).GetSccIdxV(CompV);
+  TSnapDetail::GetCnComSzCnt(CompV, SccSzCnt);
 }
 
 template <class PGraph>
 void GetSccs(const PGraph& Graph, TCnComV& CnComV) {
-  TSccVisitor<PGraph, false> Visitor(Graph);
-  TCnCom::GetDfsVisitor(Graph, Visitor);
-  CnComV = Visitor.CnComV;
-  CnComV.Sort(false);
+  const TSnapDetail::TCnComGraph CnComG(Graph);
+  TIntV CompV;
+  CnComG.GetSccIdxV(CompV);
+  TSnapDetail::GetCnComV(CnComG.GetNIdV(), CompV, CnComV);
 }
 
 template <class PGraph> 
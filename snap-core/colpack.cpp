@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////
+// Block-compressed table columns
+
+void TColPack::PutPacked(uint64* WordV, const int64& ValN, const int& Bits, const uint64& Val) {
+  if (Bits == 0) { return; }
+  const int64 Pos = ValN * Bits;
+  const int Shift = int(Pos & 63);
+  WordV[Pos >> 6] |= Val << Shift;
+  if (Shift + Bits > 64) { WordV[(Pos >> 6) + 1] |= Val >> (64 - Shift); }
+}
+
+void TColPack::AddBlock(const int64* ValV, const int& Len, const TColEnc& Enc) {
+  TBlock Block;
+  memset(&Block, 0, sizeof(TBlock));
+  Block.Off = WordV.Len();
+  int64 Mn = ValV[0], Mx = ValV[0];
+  int Runs = 1;
+  for (int i = 1; i < Len; i++) {
+    Mn = TMath::Mn(Mn, ValV[i]);  Mx = TMath::Mx(Mx, ValV[i]);
+    if (ValV[i] != ValV[i-1]) { Runs++; }
+  }
+  const uint64 Range = uint64(Mx) - uint64(Mn);
+  // frame of reference
+  const int ForBits = GetBits(Range);
+  int64 Words = GetWords(Len, ForBits);
+  Block.Enc = ceFor;  Block.Bits = ForBits;  Block.Base = Mn;
+  // offsets from the line through the first and the last value are small for sorted and evenly
+  // spaced values, e.g. timestamps; the range limit keeps the offsets from overflowing
+  int64 Step = 0, MnOff = 0;
+  int DeltaBits = 64;
+  if (Len > 1 && Range < (uint64(1) << 52)) {
+    Step = (ValV[Len-1] - ValV[0]) / (Len - 1);
+    int64 MxOff = 0;
+    for (int i = 1; i < Len; i++) {
+      const int64 Off = ValV[i] - ValV[0] - i * Step;
+      MnOff = TMath::Mn(MnOff, Off);  MxOff = TMath::Mx(MxOff, Off);
+    }
+    DeltaBits = GetBits(uint64(MxOff - MnOff));
+  }
+  // dictionary of the distinct values
+  TVec<int64> DictV;
+  if (Enc == ceAuto || Enc == ceDict) {
+    DictV.Gen(Len, 0);
+    for (int i = 0; i < Len; i++) { DictV.Add(ValV[i]); }
+    DictV.Merge();
+  }
+  const int DictBits = DictV.Empty() ? 64 : GetBits(DictV.Len() - 1);
+  const int RunBits = BlockBits + 1;
+  if (Enc == ceAuto) {
+    if (DeltaBits < 64 && GetWords(Len, DeltaBits) < Words) {
+      Words = GetWords(Len, DeltaBits);  Block.Enc = ceDelta; }
+    if (DictV.Len() + GetWords(Len, DictBits) < Words) {
+      Words = DictV.Len() + GetWords(Len, DictBits);  Block.Enc = ceDict; }
+    if (Runs + GetWords(Runs, RunBits) < Words) {
+      Words = Runs + GetWords(Runs, RunBits);  Block.Enc = ceRle; }
+  } else if (Enc == ceDelta && DeltaBits < 64) {
+    Words = GetWords(Len, DeltaBits);  Block.Enc = ceDelta;
+  } else if (Enc == ceDict) {
+    Words = DictV.Len() + GetWords(Len, DictBits);  Block.Enc = ceDict;
+  } else if (Enc == ceRle) {
+    Words = Runs + GetWords(Runs, RunBits);  Block.Enc = ceRle;
+  }
+  for (int64 w = 0; w < Words; w++) { WordV.Add(0); }
+  uint64* BlockWordV = (uint64*) WordV.BegI() + Block.Off;
+  switch (Block.Enc) {
+    case ceFor:
+      for (int i = 0; i < Len; i++) { PutPacked(BlockWordV, i, ForBits, uint64(ValV[i]) - uint64(Mn)); }
+      break;
+    case ceDelta:
+      Block.Bits = DeltaBits;  Block.Base = ValV[0] + MnOff;  Block.Step = Step;
+      for (int i = 0; i < Len; i++) { PutPacked(BlockWordV, i, DeltaBits, uint64(ValV[i] - Block.Base - i * Step)); }
+      break;
+    case ceDict:
+      Block.Bits = DictBits;  Block.Vals = DictV.Len();
+      for (int k = 0; k < DictV.Len(); k++) { BlockWordV[k] = uint64(DictV[k]); }
+      for (int i = 0; i < Len; i++) { PutPacked(BlockWordV + DictV.Len(), i, DictBits, DictV.SearchBin(ValV[i])); }
+      break;
+    case ceRle: {
+      // run values followed by the packed ends of the runs
+      Block.Bits = RunBits;  Block.Vals = Runs;
+      int RunN = 0;
+      for (int i = 0; i < Len; i++) {
+        if (i + 1 < Len && ValV[i+1] == ValV[i]) { continue; }
+        BlockWordV[RunN] = uint64(ValV[i]);
+        PutPacked(BlockWordV + Runs, RunN, RunBits, i + 1);
+        RunN++;
+      }
+      break;
+    }
+  }
+  BlockV.Add(Block);
+}
+
+int TColPack::GetBlock(const int64& BlockN, int64* ValV) const {
+  const TBlock& Block = BlockV[BlockN];
+  const int Len = int(TMath::Mn(Vals - BlockN * BlockLen, int64(BlockLen)));
+  const uint64* BlockWordV = (const uint64*) WordV.BegI() + Block.Off;
+  const int Bits = Block.Bits;
+  switch (Block.Enc) {
+    case ceFor:
+      if (Bits == 0) { for (int i = 0; i < Len; i++) { ValV[i] = Block.Base; } break; }
+      for (int i = 0; i < Len; i++) { ValV[i] = int64(uint64(Block.Base) + GetPacked(BlockWordV, i, Bits)); }
+      break;
+    case ceDelta:
+      if (Bits == 0) { for (int i = 0; i < Len; i++) { ValV[i] = Block.Base + i * Block.Step; } break; }
+      for (int i = 0; i < Len; i++) { ValV[i] = Block.Base + i * Block.Step + int64(GetPacked(BlockWordV, i, Bits)); }
+      break;
+    case ceDict: {
+      const int64* DictV = (const int64*) BlockWordV;
+      if (Bits == 0) { for (int i = 0; i < Len; i++) { ValV[i] = DictV[0]; } break; }
+      for (int i = 0; i < Len; i++) { ValV[i] = DictV[GetPacked(BlockWordV + Block.Vals, i, Bits)]; }
+      break;
+    }
+    case ceRle: {
+      for (int RunN = 0, i = 0; RunN < Block.Vals; RunN++) {
+        const int End = int(GetPacked(BlockWordV + Block.Vals, RunN, Bits));
+        const int64 Val = int64(BlockWordV[RunN]);
+        for (; i < End; i++) { ValV[i] = Val; }
+      }
+      break;
+    }
+  }
+  return Len;
+}
+
+int64 TColPack::GetRawVal(const int64& ValN) const {
+  const TBlock& Block = BlockV[ValN >> BlockBits];
+  const int i = int(ValN & (BlockLen - 1));
+  const uint64* BlockWordV = (const uint64*) WordV.BegI() + Block.Off;
+  const int Bits = Block.Bits;
+  switch (Block.Enc) {
+    case ceFor:
+      return Bits == 0 ? Block.Base : int64(uint64(Block.Base) + GetPacked(BlockWordV, i, Bits));
+    case ceDelta:
+      return Block.Base + i * Block.Step + (Bits == 0 ? 0 : int64(GetPacked(BlockWordV, i, Bits)));
+    case ceDict:
+      return int64(BlockWordV[Bits == 0 ? 0 : GetPacked(BlockWordV + Block.Vals, i, Bits)]);
+    case ceRle: {
+      // the first run that ends after i
+      int Lo = 0, Hi = Block.Vals - 1;
+      while (Lo < Hi) {
+        const int Mid = (Lo + Hi) / 2;
+        if (int(GetPacked(BlockWordV + Block.Vals, Mid, Bits)) > i) { Hi = Mid; } else { Lo = Mid + 1; }
+      }
+      return int64(BlockWordV[Lo]);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*! \file colpack.h
+    \brief Block-compressed table columns.
+*/
+
+/// Encodings of a block of a packed column: frame of reference (ceFor), offsets from a linear ramp (ceDelta),
+/// run-length (ceRle) and dictionary (ceDict). ceAuto picks the smallest encoding for every block.
+typedef enum TColEnc_ { ceAuto, ceFor, ceDelta, ceRle, ceDict } TColEnc;
+
+//#//////////////////////////////////////////////
+/// Block-compressed column of integer or floating point values. ##TColPack::Class
+class TColPack {
+public:
+  enum { BlockBits = 10, BlockLen = 1 << BlockBits };
+private:
+  /// Header of a block of BlockLen values, the packed data of the block starts at WordV[Off].
+  struct TBlock {
+    int64 Off;
+    int64 Base, Step;   ///< Smallest value (ceFor) or the line Base + i*Step below the values (ceDelta).
+    int32 Enc, Bits;    ///< Encoding and width of the packed values.
+    int32 Vals, Pad;    ///< Number of runs (ceRle) or dictionary entries (ceDict).
+  };
+  int64 Vals;
+  TVec<TBlock, int64> BlockV;
+  TVec<TUInt64, int64> WordV;
+private:
+  static int GetBits(const uint64& Range) { int Bits = 0; while (Bits < 64 && (Range >> Bits) != 0) { Bits++; } return Bits; }
+  static int64 GetWords(const int64& Vals, const int& Bits) { return (Vals * Bits + 63) / 64; }
+  static void PutPacked(uint64* WordV, const int64& ValN, const int& Bits, const uint64& Val);
+  static uint64 GetPacked(const uint64* WordV, const int64& ValN, const int& Bits) {
+    const int64 Pos = ValN * Bits;
+    const int Shift = int(Pos & 63);
+    uint64 Val = WordV[Pos >> 6] >> Shift;
+    if (Shift + Bits > 64) { Val |= WordV[(Pos >> 6) + 1] << (64 - Shift); }
+    return Bits == 64 ? Val : Val & ((uint64(1) << Bits) - 1); }
+  static void GetVal(const int64& RawVal, int& Val) { Val = int(RawVal); }
+  static void GetVal(const int64& RawVal, double& Val) { memcpy(&Val, &RawVal, sizeof(Val)); }
+  static int64 GetRawVal(const int& Val) { return Val; }
+  static int64 GetRawVal(const double& Val) { int64 RawVal; memcpy(&RawVal, &Val, sizeof(Val)); return RawVal; }
+  void AddBlock(const int64* ValV, const int& Len, const TColEnc& Enc);
+  template <class TVal> void PackV(const TVal* ValV, const int64& Len, const TColEnc& Enc);
+  template <class TVal> void GetV(const int64& BegN, const int64& EndN, TVal* ValV) const;
+public:
+  TColPack() : Vals(0), BlockV(), WordV() { }
+
+  /// Packs the values of ValV. ##TColPack::Pack
+  void Pack(const TIntV& ValV, const TColEnc& Enc = ceAuto) { PackV((const int*) ValV.BegI(), ValV.Len(), Enc); }
+  /// Packs the values of ValV, floating point values are packed by their bit patterns.
+  void Pack(const TFltV& ValV, const TColEnc& Enc = ceAuto) { PackV((const double*) ValV.BegI(), ValV.Len(), Enc); }
+  /// Decodes all the values to ValV.
+  void GetV(TIntV& ValV) const { ValV.Gen(int(Vals)); GetV(0, Vals, (int*) ValV.BegI()); }
+  /// Decodes all the values to ValV.
+  void GetV(TFltV& ValV) const { ValV.Gen(int(Vals)); GetV(0, Vals, (double*) ValV.BegI()); }
+  /// Decodes the values [BegN, EndN) to ValV, a block at a time.
+  void GetV(const int64& BegN, const int64& EndN, int* ValV) const { GetV<int>(BegN, EndN, ValV); }
+  /// Decodes the values [BegN, EndN) to ValV, a block at a time.
+  void GetV(const int64& BegN, const int64& EndN, double* ValV) const { GetV<double>(BegN, EndN, ValV); }
+  /// Decodes the block BlockN to ValV, which must have room for BlockLen values. Returns the number of values of the block.
+  int GetBlock(const int64& BlockN, int64* ValV) const;
+  /// Returns the value ValN. Takes constant time for ceFor, ceDelta and ceDict blocks and logarithmic time for ceRle blocks.
+  int64 GetRawVal(const int64& ValN) const;
+  int GetInt(const int64& ValN) const { return int(GetRawVal(ValN)); }
+  double GetFlt(const int64& ValN) const { double Val; GetVal(GetRawVal(ValN), Val); return Val; }
+
+  int64 Len() const { return Vals; }
+  bool Empty() const { return Vals == 0; }
+  void Clr() { Vals = 0; BlockV.Clr(); WordV.Clr(); }
+  int64 GetBlocks() const { return BlockV.Len(); }
+  /// Returns the encoding of block BlockN.
+  TColEnc GetBlockEnc(const int64& BlockN) const { return TColEnc(BlockV[BlockN].Enc); }
+  /// Returns the number of bytes used by the packed column.
+  ::TSize GetMemUsed() const { return ::TSize(sizeof(TColPack) + BlockV.Len() * sizeof(TBlock) + WordV.Len() * sizeof(uint64)); }
+};
+
+template <class TVal>
+void TColPack::PackV(const TVal* ValV, const int64& Len, const TColEnc& Enc) {
+  Clr();
+  Vals = Len;
+  BlockV.Reserve((Len + BlockLen - 1) / BlockLen);
+  int64 RawValV[BlockLen];
+  for (int64 BegN = 0; BegN < Len; BegN += BlockLen) {
+    const int BlockVals = int(TMath::Mn(Len - BegN, int64(BlockLen)));
+    for (int i = 0; i < BlockVals; i++) { RawValV[i] = GetRawVal(ValV[BegN + i]); }
+    AddBlock(RawValV, BlockVals, Enc);
+  }
+  WordV.Pack();
+}
+
+template <class TVal>
+void TColPack::GetV(const int64& BegN, const int64& EndN, TVal* ValV) const {
+  int64 RawValV[BlockLen];
+  for (int64 BlockN = BegN / BlockLen; BlockN * BlockLen < EndN; BlockN++) {
+    const int BlockVals = GetBlock(BlockN, RawValV);
+    const int64 BlockBegN = BlockN * BlockLen;
+    const int Beg = int(TMath::Mx(BegN - BlockBegN, int64(0)));
+    const int End = int(TMath::Mn(EndN - BlockBegN, int64(BlockVals)));
+    for (int i = Beg; i < End; i++) { GetVal(RawValV[i], ValV[BlockBegN + i - BegN]); }
+  }
+}
@@ -28,9 +28,9 @@ int LoadMode(TModeNet& Graph, PTable Table, const TStr& NCol,
       return -1;
     } else if (NodeType == atInt || NodeType == atStr) {
       if (NodeType == atInt) {
-        NVal = (Table->IntCols)[NColIdx][CurrRowIdx];
+        NVal = Table->GetIntIdx(NColIdx, CurrRowIdx);
       } else {
-        NVal = (Table->StrColMaps)[NColIdx][CurrRowIdx];
+        NVal = Table->GetStrMapIdx(NColIdx, CurrRowIdx);
         if (strlen(Table->GetContextKey(NVal)) == 0) { continue; }  //illegal value
       }
       if (!Graph.IsNode(NVal)) {Graph.AddNode(NVal); }
@@ -43,10 +43,10 @@ int LoadMode(TModeNet& Graph, PTable Table, const TStr& NCol,
       TInt Index = Table->GetColIdx(ColName);
       switch (T) {
         case atInt:
-          Graph.AddIntAttrDatN(NVal, Table->IntCols[Index][CurrRowIdx], ColName);
+          Graph.AddIntAttrDatN(NVal, Table->GetIntIdx(Index, CurrRowIdx), ColName);
           break;
         case atFlt:
-          Graph.AddFltAttrDatN(NVal, Table->FltCols[Index][CurrRowIdx], ColName);
+          Graph.AddFltAttrDatN(NVal, Table->GetFltIdx(Index, CurrRowIdx), ColName);
           break;
         case atStr:
           Graph.AddStrAttrDatN(NVal, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -91,12 +91,12 @@ int LoadCrossNet(TCrossNet& Graph, PTable Table, const TStr& SrcCol, const TStr&
       return -1;
     } else if (NodeType == atInt || NodeType == atStr) {
       if (NodeType == atInt) {
-        SVal = (Table->IntCols)[SrcColIdx][CurrRowIdx];
-        DVal = (Table->IntCols)[DstColIdx][CurrRowIdx];
+        SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+        DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
       } else {
-        SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
+        SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
         if (strlen(Table->GetContextKey(SVal)) == 0) { continue; }  //illegal value
-        DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+        DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
         if (strlen(Table->GetContextKey(DVal)) == 0) { continue; }  //illegal value
       }
     }
@@ -111,10 +111,10 @@ int LoadCrossNet(TCrossNet& Graph, PTable Table, const TStr& SrcCol, const TStr&
       TInt Index = Table->GetColIdx(ColName);
       switch (T) {
         case atInt:
-          Graph.AddIntAttrDatE(CurrRowIdx, Table->IntCols[Index][CurrRowIdx], ColName);
+          Graph.AddIntAttrDatE(CurrRowIdx, Table->GetIntIdx(Index, CurrRowIdx), ColName);
           break;
         case atFlt:
-          Graph.AddFltAttrDatE(CurrRowIdx, Table->FltCols[Index][CurrRowIdx], ColName);
+          Graph.AddFltAttrDatE(CurrRowIdx, Table->GetFltIdx(Index, CurrRowIdx), ColName);
           break;
         case atStr:
           Graph.AddStrAttrDatE(CurrRowIdx, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -19,8 +19,8 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
     for (int CurrRowIdx = 0; CurrRowIdx < (Table->Next).Len(); CurrRowIdx++) {
       if ((Table->Next)[CurrRowIdx] == Table->Invalid) { continue; }
       // add src and dst nodes to graph if they are not seen earlier
-      TInt SVal = (Table->IntCols)[SrcColIdx][CurrRowIdx];
-      TInt DVal = (Table->IntCols)[DstColIdx][CurrRowIdx];
+      TInt SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+      TInt DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
       //Using AddNodeUnchecked ensures that no error is thrown when the same node is seen twice
       Graph->AddNodeUnchecked(SVal);
       Graph->AddNodeUnchecked(DVal);
@@ -34,9 +34,9 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
       if ((Table->Next)[CurrRowIdx] == Table->Invalid) { continue; }
       // add src and dst nodes to graph if they are not seen earlier
       TInt SVal, DVal;
-      TFlt FSVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FSVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       SVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FSVal);
-      TFlt FDVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FDVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       DVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FDVal);
       Graph->AddEdge(SVal, DVal);
     }
@@ -44,9 +44,9 @@ PGraph ToGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol, TAttrAggr A
     for (int CurrRowIdx = 0; CurrRowIdx < (Table->Next).Len(); CurrRowIdx++) {
       if ((Table->Next)[CurrRowIdx] == Table->Invalid) { continue; }
       // add src and dst nodes to graph if they are not seen earlier
-      TInt SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
+      TInt SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
 //      if (strlen(Table->GetContextKey(SVal)) == 0) { continue; }  //illegal value
-      TInt DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+      TInt DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
 //      if (strlen(Table->GetContextKey(DVal)) == 0) { continue; }  //illegal value
       //Using AddNodeUnchecked ensures that no error is thrown when the same node is seen twice
       Graph->AddNodeUnchecked(SVal);
@@ -95,18 +95,18 @@ PGraph ToNetwork(PTable Table,
     // add src and dst nodes to graph if they are not seen earlier
    TInt SVal, DVal;
     if (NodeType == atFlt) {
-      TFlt FSVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FSVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       SVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FSVal);
-      TFlt FDVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FDVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       DVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FDVal);
     } else if (NodeType == atInt || NodeType == atStr) {
       if (NodeType == atInt) {
-        SVal = (Table->IntCols)[SrcColIdx][CurrRowIdx];
-        DVal = (Table->IntCols)[DstColIdx][CurrRowIdx];
+        SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+        DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
       } else {
-        SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
+        SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
         if (strlen(Table->GetContextKey(SVal)) == 0) { continue; }  //illegal value
-        DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+        DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
         if (strlen(Table->GetContextKey(DVal)) == 0) { continue; }  //illegal value
       }
       if (!Graph->IsNode(SVal)) {Graph->AddNode(SVal); }
@@ -125,10 +125,10 @@ PGraph ToNetwork(PTable Table,
 			TInt Index = Table->GetColIdx(ColName);
 			switch (T) {
 				case atInt:
-					Graph->AddIntAttrDatE(CurrRowIdx, Table->IntCols[Index][CurrRowIdx], ColName);
+					Graph->AddIntAttrDatE(CurrRowIdx, Table->GetIntIdx(Index, CurrRowIdx), ColName);
 					break;
 				case atFlt:
-					Graph->AddFltAttrDatE(CurrRowIdx, Table->FltCols[Index][CurrRowIdx], ColName);
+					Graph->AddFltAttrDatE(CurrRowIdx, Table->GetFltIdx(Index, CurrRowIdx), ColName);
 					break;
 				case atStr:
 					Graph->AddStrAttrDatE(CurrRowIdx, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -556,14 +556,14 @@ PGraphMP ToGraphMP3(PTable Table, const TStr& SrcCol, const TStr& DstCol) {
   if (NodeType == atInt) {
     #pragma omp parallel for
       for (int i = 0; i < NumRows; i++) {
-        int vert = Table->IntCols[DstColIdx][i];
+        int vert = Table->GetIntIdx(DstColIdx, i);
         buckets[vert % sz] = 1;
       }
   }
   else if (NodeType == atStr ) {
     #pragma omp parallel for
       for (int i = 0; i < NumRows; i++) {
-        int vert = (Table->StrColMaps)[DstColIdx][i];
+        int vert = Table->GetStrMapIdx(DstColIdx, i);
         buckets[vert % sz] = 1;
       }
   }
@@ -602,12 +602,12 @@ PGraphMP ToGraphMP3(PTable Table, const TStr& SrcCol, const TStr& DstCol) {
 
         TInt SVal, DVal;
         if (NodeType == atInt) {
-          SVal = Table->IntCols[SrcColIdx][CurrRowIdx];
-          DVal = Table->IntCols[DstColIdx][CurrRowIdx];
+          SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+          DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
         }
         else if (NodeType == atStr ) {
-          SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
-          DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+          SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
+          DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
         }
         int SrcIdx = abs((SVal.GetPrimHashCd()) % Length);
         if (!Graph->AddOutEdge1(SrcIdx, SVal, DVal)) {
@@ -663,12 +663,12 @@ PGraphMP ToGraphMP3(PTable Table, const TStr& SrcCol, const TStr& DstCol) {
   for (int CurrRowIdx = 0; CurrRowIdx < Last; CurrRowIdx++) {
 	TInt SVal, DVal;
 	if (NodeType == atInt) {
-      SVal = Table->IntCols[SrcColIdx][CurrRowIdx];
-      DVal = Table->IntCols[DstColIdx][CurrRowIdx];
+      SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+      DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
 	}
 	else if (NodeType == atStr) {
-      SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
-      DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+      SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
+      DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
 	}
 
     Graph->AddOutEdge2(SVal, DVal);
@@ -1004,10 +1004,10 @@ inline PGraphMP ToNetworkMP(PTable Table,
           TInt Index = Table->GetColIdx(ColName);
           switch (T) {
             case atInt:
-              Graph->AddIntAttrDatE(RowId, Table->IntCols[Index][RowId], ColName);
+              Graph->AddIntAttrDatE(RowId, Table->GetIntIdx(Index, RowId), ColName);
               break;
             case atFlt:
-              Graph->AddFltAttrDatE(RowId, Table->FltCols[Index][RowId], ColName);
+              Graph->AddFltAttrDatE(RowId, Table->GetFltIdx(Index, RowId), ColName);
               break;
             case atStr:
               Graph->AddStrAttrDatE(RowId, Table->GetStrValIdx(Index, RowId), ColName);
@@ -1041,10 +1041,10 @@ inline PGraphMP ToNetworkMP(PTable Table,
           TInt Index = Table->GetColIdx(ColName);
           switch (T) {
             case atInt:
-              Graph->AddIntAttrDatE(RowId, Table->IntCols[Index][RowId], ColName);
+              Graph->AddIntAttrDatE(RowId, Table->GetIntIdx(Index, RowId), ColName);
               break;
             case atFlt:
-              Graph->AddFltAttrDatE(RowId, Table->FltCols[Index][RowId], ColName);
+              Graph->AddFltAttrDatE(RowId, Table->GetFltIdx(Index, RowId), ColName);
               break;
             case atStr:
               Graph->AddStrAttrDatE(RowId, Table->GetStrValIdx(Index, RowId), ColName);
@@ -1597,20 +1597,20 @@ PGraph ToNetwork(PTable Table,
     // add src and dst nodes to graph if they are not seen earlier
     TInt SVal, DVal;
     if (NodeType == atFlt) {
-      TFlt FSVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FSVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       SVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FSVal);
-      TFlt FDVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FDVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       DVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FDVal);
     }
     else if (NodeType == atInt || NodeType == atStr) {
       if (NodeType == atInt) {
-        SVal = (Table->IntCols)[SrcColIdx][CurrRowIdx];
-        DVal = (Table->IntCols)[DstColIdx][CurrRowIdx];
+        SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+        DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
       }
       else {
-        SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
+        SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
   //        if (strlen(Table->GetContextKey(SVal)) == 0) { continue; }  //illegal value
-        DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+        DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
   //        if (strlen(Table->GetContextKey(DVal)) == 0) { continue; }  //illegal value
       }
       if (!Graph->IsNode(SVal)) {Graph->AddNode(SVal); }
@@ -1629,10 +1629,10 @@ PGraph ToNetwork(PTable Table,
       TInt Index = Table->GetColIdx(ColName);
       switch (T) {
         case atInt:
-          Graph->AddIntAttrDatE(CurrRowIdx, Table->IntCols[Index][CurrRowIdx], ColName);
+          Graph->AddIntAttrDatE(CurrRowIdx, Table->GetIntIdx(Index, CurrRowIdx), ColName);
           break;
         case atFlt:
-          Graph->AddFltAttrDatE(CurrRowIdx, Table->FltCols[Index][CurrRowIdx], ColName);
+          Graph->AddFltAttrDatE(CurrRowIdx, Table->GetFltIdx(Index, CurrRowIdx), ColName);
           break;
         case atStr:
           Graph->AddStrAttrDatE(CurrRowIdx, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -1987,10 +1987,10 @@ inline PGraphMP ToNetworkMP(PTable Table,
       TInt Index = Table->GetColIdx(ColName);
       switch (T) {
         case atInt:
-          Graph->AddIntAttrDatE(CurrRowIdx, Table->IntCols[Index][CurrRowIdx], ColName);
+          Graph->AddIntAttrDatE(CurrRowIdx, Table->GetIntIdx(Index, CurrRowIdx), ColName);
           break;
         case atFlt:
-          Graph->AddFltAttrDatE(CurrRowIdx, Table->FltCols[Index][CurrRowIdx], ColName);
+          Graph->AddFltAttrDatE(CurrRowIdx, Table->GetFltIdx(Index, CurrRowIdx), ColName);
           break;
         case atStr:
           Graph->AddStrAttrDatE(CurrRowIdx, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -2043,20 +2043,20 @@ PGraph ToNetwork(PTable Table,
     // add src and dst nodes to graph if they are not seen earlier
     TInt SVal, DVal;
     if (NodeType == atFlt) {
-      TFlt FSVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FSVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       SVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FSVal);
-      TFlt FDVal = (Table->FltCols)[SrcColIdx][CurrRowIdx];
+      TFlt FDVal = Table->GetFltIdx(SrcColIdx, CurrRowIdx);
       DVal = Table->CheckAndAddFltNode(Graph, FltNodeVals, FDVal);
     }
     else if (NodeType == atInt || NodeType == atStr) {
       if (NodeType == atInt) {
-        SVal = (Table->IntCols)[SrcColIdx][CurrRowIdx];
-        DVal = (Table->IntCols)[DstColIdx][CurrRowIdx];
+        SVal = Table->GetIntIdx(SrcColIdx, CurrRowIdx);
+        DVal = Table->GetIntIdx(DstColIdx, CurrRowIdx);
       }
       else {
-        SVal = (Table->StrColMaps)[SrcColIdx][CurrRowIdx];
+        SVal = Table->GetStrMapIdx(SrcColIdx, CurrRowIdx);
   //        if (strlen(Table->GetContextKey(SVal)) == 0) { continue; }  //illegal value
-        DVal = (Table->StrColMaps)[DstColIdx][CurrRowIdx];
+        DVal = Table->GetStrMapIdx(DstColIdx, CurrRowIdx);
   //        if (strlen(Table->GetContextKey(DVal)) == 0) { continue; }  //illegal value
       }
       if (!Graph->IsNode(SVal)) {Graph->AddNode(SVal); }
@@ -2075,10 +2075,10 @@ PGraph ToNetwork(PTable Table,
       TInt Index = Table->GetColIdx(ColName);
       switch (T) {
         case atInt:
-          Graph->AddIntAttrDatE(CurrRowIdx, Table->IntCols[Index][CurrRowIdx], ColName);
+          Graph->AddIntAttrDatE(CurrRowIdx, Table->GetIntIdx(Index, CurrRowIdx), ColName);
           break;
         case atFlt:
-          Graph->AddFltAttrDatE(CurrRowIdx, Table->FltCols[Index][CurrRowIdx], ColName);
+          Graph->AddFltAttrDatE(CurrRowIdx, Table->GetFltIdx(Index, CurrRowIdx), ColName);
           break;
         case atStr:
           Graph->AddStrAttrDatE(CurrRowIdx, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -2096,10 +2096,10 @@ PGraph ToNetwork(PTable Table,
       }
       TInt NId;
       if (NodeTypeN == atInt) {
-        NId = (NodeTable->IntCols)[NodeColIdx][CurrRowIdx];
+        NId = NodeTable->GetIntIdx(NodeColIdx, CurrRowIdx);
       }
       else if (NodeTypeN == atStr){
-        NId = (NodeTable->StrColMaps)[NodeColIdx][CurrRowIdx];
+        NId = NodeTable->GetStrMapIdx(NodeColIdx, CurrRowIdx);
       }
       for (TInt i = 0; i < NodeAttrV.Len(); i++) {
         TStr ColName = NodeAttrV[i];
@@ -2107,10 +2107,10 @@ PGraph ToNetwork(PTable Table,
         TInt Index = NodeTable->GetColIdx(ColName);
         switch (T) {
           case atInt:
-            Graph->AddIntAttrDatN(NId, NodeTable->IntCols[Index][CurrRowIdx], ColName);
+            Graph->AddIntAttrDatN(NId, NodeTable->GetIntIdx(Index, CurrRowIdx), ColName);
             break;
           case atFlt:
-            Graph->AddFltAttrDatN(NId, NodeTable->FltCols[Index][CurrRowIdx], ColName);
+            Graph->AddFltAttrDatN(NId, NodeTable->GetFltIdx(Index, CurrRowIdx), ColName);
             break;
           case atStr:
             Graph->AddStrAttrDatN(NId, NodeTable->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -2469,10 +2469,10 @@ inline PGraphMP ToNetworkMP(PTable Table,
       TInt Index = Table->GetColIdx(ColName);
       switch (T) {
         case atInt:
-          Graph->AddIntAttrDatE(CurrRowIdx, Table->IntCols[Index][CurrRowIdx], ColName);
+          Graph->AddIntAttrDatE(CurrRowIdx, Table->GetIntIdx(Index, CurrRowIdx), ColName);
           break;
         case atFlt:
-          Graph->AddFltAttrDatE(CurrRowIdx, Table->FltCols[Index][CurrRowIdx], ColName);
+          Graph->AddFltAttrDatE(CurrRowIdx, Table->GetFltIdx(Index, CurrRowIdx), ColName);
           break;
         case atStr:
           Graph->AddStrAttrDatE(CurrRowIdx, Table->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -2489,10 +2489,10 @@ inline PGraphMP ToNetworkMP(PTable Table,
       }
       TInt NId;
       if (NodeTypeN == atInt) {
-        NId = (NodeTable->IntCols)[NodeColIdx][CurrRowIdx];
+        NId = NodeTable->GetIntIdx(NodeColIdx, CurrRowIdx);
       }
       else if (NodeTypeN == atStr){
-        NId = (NodeTable->StrColMaps)[NodeColIdx][CurrRowIdx];
+        NId = NodeTable->GetStrMapIdx(NodeColIdx, CurrRowIdx);
       }
       for (TInt i = 0; i < NodeAttrV.Len(); i++) {
         TStr ColName = NodeAttrV[i];
@@ -2500,10 +2500,10 @@ inline PGraphMP ToNetworkMP(PTable Table,
         TInt Index = NodeTable->GetColIdx(ColName);
         switch (T) {
           case atInt:
-            Graph->AddIntAttrDatN(NId, NodeTable->IntCols[Index][CurrRowIdx], ColName);
+            Graph->AddIntAttrDatN(NId, NodeTable->GetIntIdx(Index, CurrRowIdx), ColName);
             break;
           case atFlt:
-            Graph->AddFltAttrDatN(NId, NodeTable->FltCols[Index][CurrRowIdx], ColName);
+            Graph->AddFltAttrDatN(NId, NodeTable->GetFltIdx(Index, CurrRowIdx), ColName);
             break;
           case atStr:
             Graph->AddStrAttrDatN(NId, NodeTable->GetStrValIdx(Index, CurrRowIdx), ColName);
@@ -2519,6 +2519,46 @@ inline PGraphMP ToNetworkMP(PTable Table,
 }
 #endif // GCC_ATOMIC
 
+/// Converts the table into a CSR graph with links from nodes in \c SrcCol to those in \c DstCol. Edge lists of the nodes are built in parallel.
+template<class PCsrGraph>
+PCsrGraph ToCsrGraph(PTable Table, const TStr& SrcCol, const TStr& DstCol) {
+  const TAttrType NodeType = Table->GetColType(SrcCol);
+  IAssertR(NodeType == Table->GetColType(DstCol), "Source and destination columns must have the same type");
+  IAssertR(NodeType != atFlt, "Float columns cannot be used as node IDs");
+  const TInt SrcColIdx = Table->GetColIdx(SrcCol);
+  const TInt DstColIdx = Table->GetColIdx(DstCol);
+  TIntPrV Partitions;
+#ifdef USE_OPENMP
+  Table->GetPartitionRanges(Partitions, omp_get_max_threads());
+#else
+  Table->GetPartitionRanges(Partitions, 1);
+#endif
+  // rows of a partition are copied to consecutive positions of the edge vectors
+  TIntV PartOffV(Partitions.Len()+1);
+  PartOffV[0] = 0;
+  for (int i = 0; i < Partitions.Len(); i++) {
+    int Rows = 0;
+    for (TRowIterator RowI(Partitions[i].GetVal1(), Table()), EndI(Partitions[i].GetVal2(), Table()); RowI < EndI; RowI++) { Rows++; }
+    PartOffV[i+1] = PartOffV[i] + Rows;
+  }
+  TIntV SrcNIdV(PartOffV.Last()), DstNIdV(PartOffV.Last());
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < Partitions.Len(); i++) {
+    int EdgeN = PartOffV[i];
+    for (TRowIterator RowI(Partitions[i].GetVal1(), Table()), EndI(Partitions[i].GetVal2(), Table()); RowI < EndI; RowI++) {
+      if (NodeType == atInt) {
+        SrcNIdV[EdgeN] = RowI.GetIntAttr(SrcColIdx);  DstNIdV[EdgeN] = RowI.GetIntAttr(DstColIdx);
+      } else {
+        SrcNIdV[EdgeN] = RowI.GetStrMapById(SrcColIdx);  DstNIdV[EdgeN] = RowI.GetStrMapById(DstColIdx);
+      }
+      EdgeN++;
+    }
+  }
+  return PCsrGraph::TObj::New(SrcNIdV, DstNIdV);
+}
+
 }; // TSnap namespace
 
 #endif // CONV_H
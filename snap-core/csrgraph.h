@@ -0,0 +1,721 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+//#//////////////////////////////////////////////
+/// Compressed sparse row (CSR) graphs
+template <bool IsDir> class TCsrGraph;
+
+/// Undirected CSR graph
+typedef TCsrGraph<false> TUNCsrGraph;
+/// Directed CSR graph
+typedef TCsrGraph<true> TNCsrGraph;
+
+/// Pointer to an undirected CSR graph (TUNCsrGraph)
+typedef TPt<TUNCsrGraph> PUNCsrGraph;
+/// Pointer to a directed CSR graph (TNCsrGraph)
+typedef TPt<TNCsrGraph> PNCsrGraph;
+
+//#//////////////////////////////////////////////
+/// Immutable graph in the compressed sparse row format. ##TCsrGraph::Class
+template <bool IsDir>
+class TCsrGraph {
+public:
+  typedef TCsrGraph<IsDir> TNet;
+  typedef TPt<TCsrGraph<IsDir> > PNet;
+  /// Neighbor vector, it can hold more than 2^31 entries.
+  typedef TVec<TInt, int64> TNbrV;
+public:
+  /// Node iterator. Nodes are visited in the increasing order of node IDs.
+  class TNodeI {
+  private:
+    const TCsrGraph* Graph;
+    int NIdx;
+  public:
+    TNodeI() : Graph(NULL), NIdx(0) { }
+    TNodeI(const TCsrGraph* GraphPt, const int& NodeIdx) : Graph(GraphPt), NIdx(NodeIdx) { }
+    TNodeI(const TNodeI& NodeI) : Graph(NodeI.Graph), NIdx(NodeI.NIdx) { }
+    TNodeI& operator = (const TNodeI& NodeI) { Graph = NodeI.Graph; NIdx = NodeI.NIdx; return *this; }
+    /// Increment iterator.
+    TNodeI& operator++ (int) { NIdx++; return *this; }
+    /// Decrement iterator.
+    TNodeI& operator-- (int) { NIdx--; return *this; }
+    bool operator < (const TNodeI& NodeI) const { return NIdx < NodeI.NIdx; }
+    bool operator == (const TNodeI& NodeI) const { return NIdx == NodeI.NIdx; }
+    /// Returns ID of the current node.
+    int GetId() const { return Graph->GetNId(NIdx); }
+    /// Returns the dense index (0...GetNodes()-1) of the current node.
+    int GetIdx() const { return NIdx; }
+    /// Returns degree of the current node. For directed graphs this is the sum of in-degree and out-degree.
+    int GetDeg() const { return IsDir ? GetInDeg() + GetOutDeg() : GetOutDeg(); }
+    /// Returns in-degree of the current node.
+    int GetInDeg() const { return Graph->GetInDegIdx(NIdx); }
+    /// Returns out-degree of the current node.
+    int GetOutDeg() const { return Graph->GetOutDegIdx(NIdx); }
+    /// Returns ID of NodeN-th in-node (the node pointing to the current node).
+    int GetInNId(const int& NodeN) const { return Graph->GetNId(GetInNIdx(NodeN)); }
+    /// Returns ID of NodeN-th out-node (the node the current node points to).
+    int GetOutNId(const int& NodeN) const { return Graph->GetNId(GetOutNIdx(NodeN)); }
+    /// Returns ID of NodeN-th neighboring node.
+    int GetNbrNId(const int& NodeN) const { return NodeN < GetOutDeg() ? GetOutNId(NodeN) : GetInNId(NodeN - GetOutDeg()); }
+    /// Returns the dense index of NodeN-th in-node.
+    int GetInNIdx(const int& NodeN) const { return Graph->BegInNbrI(NIdx)[NodeN]; }
+    /// Returns the dense index of NodeN-th out-node.
+    int GetOutNIdx(const int& NodeN) const { return Graph->BegOutNbrI(NIdx)[NodeN]; }
+    /// Tests whether node with ID NId points to the current node.
+    bool IsInNId(const int& NId) const { return Graph->IsEdge(NId, GetId()); }
+    /// Tests whether the current node points to node with ID NId.
+    bool IsOutNId(const int& NId) const { return Graph->IsEdge(GetId(), NId); }
+    /// Tests whether node with ID NId is a neighbor of the current node.
+    bool IsNbrNId(const int& NId) const { return IsOutNId(NId) || (IsDir && IsInNId(NId)); }
+    friend class TCsrGraph;
+  };
+  /// Edge iterator. Only forward iteration (operator++) is supported.
+  class TEdgeI {
+  private:
+    TNodeI CurNode, EndNode;
+    int CurEdge;
+  public:
+    TEdgeI() : CurNode(), EndNode(), CurEdge(0) { }
+    TEdgeI(const TNodeI& NodeI, const TNodeI& EndNodeI, const int& EdgeN=0) : CurNode(NodeI), EndNode(EndNodeI), CurEdge(EdgeN) { }
+    TEdgeI(const TEdgeI& EdgeI) : CurNode(EdgeI.CurNode), EndNode(EdgeI.EndNode), CurEdge(EdgeI.CurEdge) { }
+    TEdgeI& operator = (const TEdgeI& EdgeI) { if (this!=&EdgeI) { CurNode=EdgeI.CurNode; EndNode=EdgeI.EndNode; CurEdge=EdgeI.CurEdge; } return *this; }
+    /// Increment iterator. Undirected edges are visited once, from the endpoint with the smaller ID.
+    TEdgeI& operator++ (int) { do { CurEdge++; if (CurEdge >= CurNode.GetOutDeg()) { CurEdge=0; CurNode++;
+      while (CurNode < EndNode && CurNode.GetOutDeg()==0) { CurNode++; } } } while (! IsDir && CurNode < EndNode && CurNode.GetIdx() > CurNode.GetOutNIdx(CurEdge)); return *this; }
+    bool operator < (const TEdgeI& EdgeI) const { return CurNode<EdgeI.CurNode || (CurNode==EdgeI.CurNode && CurEdge<EdgeI.CurEdge); }
+    bool operator == (const TEdgeI& EdgeI) const { return CurNode == EdgeI.CurNode && CurEdge == EdgeI.CurEdge; }
+    /// Returns edge ID. Always returns -1 since only edges in multigraphs have explicit IDs.
+    int GetId() const { return -1; }
+    /// Returns the source node of the edge.
+    int GetSrcNId() const { return CurNode.GetId(); }
+    /// Returns the destination node of the edge.
+    int GetDstNId() const { return CurNode.GetOutNId(CurEdge); }
+    friend class TCsrGraph;
+  };
+private:
+  TCRef CRef;
+  TInt MxNId, NEdges;
+  TIntV NIdV;              ///< Sorted node IDs, position in the vector is the dense node index.
+  TIntV NIdxV;             ///< Dense node index of each node ID, -1 if not a node. Empty if node IDs are too sparse.
+  TVec<TInt64> OutOffV;    ///< Start of the out-neighbors of each node in OutNbrV, has GetNodes()+1 entries.
+  TNbrV OutNbrV;           ///< Sorted out-neighbors (dense node indices) of all nodes.
+  TVec<TInt64> InOffV;     ///< Start of the in-neighbors of each node in InNbrV. Empty for undirected graphs.
+  TNbrV InNbrV;            ///< Sorted in-neighbors (dense node indices) of all nodes.
+  TStrV IntAttrNmV;        ///< Names of the integer node attributes.
+  TVec<TIntV> IntAttrVV;   ///< Integer node attribute columns, indexed by the dense node index.
+  TStrV FltAttrNmV;        ///< Names of the floating point node attributes.
+  TVec<TFltV> FltAttrVV;   ///< Floating point node attribute columns, indexed by the dense node index.
+private:
+  /// Header of the memory-mapped format, see SaveMmap(). All the offsets are relative to the start of the header.
+  struct TMmapHdr {
+    char Magic[8];
+    int32 ByteOrder, Version, IsDirected, Attrs;
+    int64 FileLen, Nodes, Edges, MxNId, NIdxLen, OutNbrs, InNbrs;
+    int64 NIdVOff, NIdxVOff, OutOffVOff, OutNbrVOff, InOffVOff, InNbrVOff;
+  };
+  /// Attribute column entry of the memory-mapped format. Entries follow the header.
+  struct TMmapAttr {
+    char Nm[48];
+    int32 IsFlt, Pad;
+    int64 Off;
+  };
+  enum { MmapVersion = 1, MmapPageSz = 4096, MmapByteOrder = 0x01020304 };
+  struct TLoadAttrShM {
+    template <class TAttrV> void operator() (TAttrV* AttrV, TShMIn& ShMIn) { AttrV->LoadShM(ShMIn); }
+  };
+private:
+  static int AtomicInc(TInt& Cnt) {
+#ifdef GCC_ATOMIC
+    return __sync_fetch_and_add(&Cnt.Val, 1);
+#else
+    return Cnt.Val++;
+#endif
+  }
+  static void SortNbrs(TInt* BI, TInt* EI);
+  void BuildNIdx();
+  void BuildNIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV);
+  void BuildFromEdges(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& SrcToDst, TVec<TInt64>& OffV, TNbrV& NbrV) const;
+  template <class PGraph> void BuildFromGraph(const PGraph& Graph, const bool& OutEdges, TVec<TInt64>& OffV, TNbrV& NbrV) const;
+  void SortAndMerge(TVec<TInt64>& OffV, TNbrV& NbrV) const;
+  void CountEdges();
+  static int64 MmapAlign(const int64& Pos) { return (Pos + MmapPageSz - 1) / MmapPageSz * MmapPageSz; }
+  static void PutMmapBf(TSOut& SOut, int64& Pos, const int64& Off, const void* Bf, const int64& BfL);
+  /// Tells whether Vals values of ValSz bytes at Off fit into the first FileLen bytes of the file.
+  static bool IsMmapSec(const int64& FileLen, const int64& Off, const int64& Vals, const int& ValSz) {
+    return Off >= 0 && Off % 8 == 0 && Off <= FileLen && Vals >= 0 && Vals <= (FileLen - Off) / ValSz; }
+public:
+  TCsrGraph() : CRef(), MxNId(0), NEdges(0), NIdV(), NIdxV(), OutOffV(), OutNbrV(), InOffV(), InNbrV(),
+    IntAttrNmV(), IntAttrVV(), FltAttrNmV(), FltAttrVV() { }
+  /// Constructor that loads the graph from a (binary) stream SIn.
+  TCsrGraph(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NIdV(SIn), NIdxV(SIn), OutOffV(SIn), OutNbrV(SIn), InOffV(SIn), InNbrV(SIn),
+    IntAttrNmV(SIn), IntAttrVV(SIn), FltAttrNmV(SIn), FltAttrVV(SIn) { }
+  /// Saves the graph to a (binary) stream SOut.
+  void Save(TSOut& SOut) const { MxNId.Save(SOut); NEdges.Save(SOut); NIdV.Save(SOut); NIdxV.Save(SOut);
+    OutOffV.Save(SOut); OutNbrV.Save(SOut); InOffV.Save(SOut); InNbrV.Save(SOut);
+    IntAttrNmV.Save(SOut); IntAttrVV.Save(SOut); FltAttrNmV.Save(SOut); FltAttrVV.Save(SOut); SOut.Flush(); }
+  /// Saves the graph in the page-aligned memory-mapped format. ##TCsrGraph::SaveMmap
+  void SaveMmap(TSOut& SOut) const;
+  /// Static constructor that returns a pointer to an empty graph.
+  static PNet New() { return new TCsrGraph(); }
+  /// Static constructor that builds the graph from another graph. ##TCsrGraph::New
+  template <class PGraph> static PNet New(const PGraph& Graph, const bool& InEdges=true);
+  /// Static constructor that builds the graph from the edge list (SrcNIdV[i], DstNIdV[i]). ##TCsrGraph::New-1
+  static PNet New(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& InEdges=true);
+  /// Static constructor that loads the graph from a stream SIn and returns a pointer to it.
+  static PNet Load(TSIn& SIn) { return PNet(new TCsrGraph(SIn)); }
+  /// Static constructor that loads the graph from shared memory without copying the graph arrays. ##TCsrGraph::LoadShM
+  static PNet LoadShM(TShMIn& ShMIn);
+  /// Static constructor that opens a graph saved with SaveMmap() in constant time. ##TCsrGraph::LoadMmap
+  static PNet LoadMmap(TShMIn& ShMIn);
+  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
+  bool HasFlag(const TGraphFlag& Flag) const { return HasGraphFlag(TCsrGraph::TNet, Flag); }
+
+  /// Returns the number of nodes in the graph.
+  int GetNodes() const { return NIdV.Len(); }
+  /// Tests whether ID NId is a node.
+  bool IsNode(const int& NId) const { return GetNIdx(NId) != -1; }
+  /// Returns an iterator referring to the first node in the graph.
+  TNodeI BegNI() const { return TNodeI(this, 0); }
+  /// Returns an iterator referring to the past-the-end node in the graph.
+  TNodeI EndNI() const { return TNodeI(this, GetNodes()); }
+  /// Returns an iterator referring to the node of ID NId in the graph.
+  TNodeI GetNI(const int& NId) const { return TNodeI(this, GetNIdx(NId)); }
+  /// Returns an iterator referring to the node with dense index NIdx.
+  TNodeI GetNIByIdx(const int& NIdx) const { return TNodeI(this, NIdx); }
+  /// Returns an ID that is larger than any node ID in the graph.
+  int GetMxNId() const { return MxNId; }
+  /// Returns the dense index of node NId or -1 if NId is not a node.
+  int GetNIdx(const int& NId) const {
+    if (! NIdxV.Empty()) { return (NId >= 0 && NId < NIdxV.Len()) ? NIdxV[NId].Val : -1; }
+    return NIdV.SearchBin(NId); }
+  /// Returns the ID of the node with dense index NIdx.
+  int GetNId(const int& NIdx) const { return NIdV[NIdx]; }
+  /// Returns the vector of node IDs, indexed by the dense node index.
+  const TIntV& GetNIdIdxV() const { return NIdV; }
+
+  /// Returns the out-degree of the node with dense index NIdx.
+  int GetOutDegIdx(const int& NIdx) const { return int(OutOffV[NIdx+1] - OutOffV[NIdx]); }
+  /// Returns the in-degree of the node with dense index NIdx.
+  int GetInDegIdx(const int& NIdx) const {
+    if (! IsDir) { return GetOutDegIdx(NIdx); }
+    return InOffV.Empty() ? 0 : int(InOffV[NIdx+1] - InOffV[NIdx]); }
+  /// Returns a pointer to the first out-neighbor index of the node with dense index NIdx.
+  const TInt* BegOutNbrI(const int& NIdx) const { return OutNbrV.BegI() + OutOffV[NIdx]; }
+  /// Returns a pointer past the last out-neighbor index of the node with dense index NIdx.
+  const TInt* EndOutNbrI(const int& NIdx) const { return OutNbrV.BegI() + OutOffV[NIdx+1]; }
+  /// Returns a pointer to the first in-neighbor index of the node with dense index NIdx.
+  const TInt* BegInNbrI(const int& NIdx) const {
+    if (! IsDir) { return BegOutNbrI(NIdx); }
+    return InOffV.Empty() ? NULL : InNbrV.BegI() + InOffV[NIdx]; }
+  /// Returns a pointer past the last in-neighbor index of the node with dense index NIdx.
+  const TInt* EndInNbrI(const int& NIdx) const {
+    if (! IsDir) { return EndOutNbrI(NIdx); }
+    return InOffV.Empty() ? NULL : InNbrV.BegI() + InOffV[NIdx+1]; }
+  /// Tests whether in-edges are stored. Undirected graphs always return true.
+  bool HasInEdges() const { return ! IsDir || ! InOffV.Empty(); }
+
+  /// Adds an integer node attribute AttrNm, ValV holds the values indexed by the dense node index.
+  void AddIntAttrN(const TStr& AttrNm, const TIntV& ValV);
+  /// Adds a floating point node attribute AttrNm, ValV holds the values indexed by the dense node index.
+  void AddFltAttrN(const TStr& AttrNm, const TFltV& ValV);
+  /// Tests whether the graph has an integer node attribute AttrNm.
+  bool IsIntAttrN(const TStr& AttrNm) const { return IntAttrNmV.SearchForw(AttrNm) != -1; }
+  /// Tests whether the graph has a floating point node attribute AttrNm.
+  bool IsFltAttrN(const TStr& AttrNm) const { return FltAttrNmV.SearchForw(AttrNm) != -1; }
+  /// Returns the column of integer node attribute AttrNm, indexed by the dense node index.
+  const TIntV& GetIntAttrVN(const TStr& AttrNm) const { const int AttrN = IntAttrNmV.SearchForw(AttrNm);
+    EAssertR(AttrN != -1, "Integer node attribute '" + AttrNm + "' does not exist."); return IntAttrVV[AttrN]; }
+  /// Returns the column of floating point node attribute AttrNm, indexed by the dense node index.
+  const TFltV& GetFltAttrVN(const TStr& AttrNm) const { const int AttrN = FltAttrNmV.SearchForw(AttrNm);
+    EAssertR(AttrN != -1, "Float node attribute '" + AttrNm + "' does not exist."); return FltAttrVV[AttrN]; }
+  /// Returns the value of integer attribute AttrNm of node NId.
+  int GetIntAttrDatN(const int& NId, const TStr& AttrNm) const { return GetIntAttrVN(AttrNm)[GetNIdx(NId)]; }
+  /// Returns the value of floating point attribute AttrNm of node NId.
+  double GetFltAttrDatN(const int& NId, const TStr& AttrNm) const { return GetFltAttrVN(AttrNm)[GetNIdx(NId)]; }
+  /// Gets the names of integer and floating point node attributes.
+  void GetAttrNmV(TStrV& IntNmV, TStrV& FltNmV) const { IntNmV = IntAttrNmV;  FltNmV = FltAttrNmV; }
+
+  /// Returns the number of edges in the graph.
+  int GetEdges() const { return NEdges; }
+  /// Tests whether an edge from node IDs SrcNId to DstNId exists in the graph.
+  bool IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDirected=true) const;
+  /// Tests whether an edge from dense index SrcNIdx to DstNIdx exists in the graph.
+  bool IsEdgeIdx(const int& SrcNIdx, const int& DstNIdx) const;
+  /// Tests whether an edge EId exists in the graph (for compatibility with TNEANet), always returns false.
+  bool IsEdge(const int& EId) const { return false; }
+  /// Returns an iterator referring to the first edge in the graph.
+  TEdgeI BegEI() const { TNodeI NI = BegNI(); while (NI < EndNI() && NI.GetOutDeg()==0) { NI++; }
+    TEdgeI EI(NI, EndNI(), 0); if (! IsDir && NI < EndNI() && NI.GetIdx() > NI.GetOutNIdx(0)) { EI++; } return EI; }
+  /// Returns an iterator referring to the past-the-end edge in the graph.
+  TEdgeI EndEI() const { return TEdgeI(EndNI(), EndNI()); }
+  /// Returns an iterator referring to edge (SrcNId, DstNId) in the graph.
+  TEdgeI GetEI(const int& SrcNId, const int& DstNId) const;
+
+  /// Returns an ID of a random node in the graph.
+  int GetRndNId(TRnd& Rnd=TInt::Rnd) { return NIdV[Rnd.GetUniDevInt(GetNodes())]; }
+  /// Returns an interator referring to a random node in the graph.
+  TNodeI GetRndNI(TRnd& Rnd=TInt::Rnd) { return GetNIByIdx(Rnd.GetUniDevInt(GetNodes())); }
+  /// Gets a vector IDs of all nodes in the graph.
+  void GetNIdV(TIntV& NodeIdV) const { NodeIdV = NIdV; }
+  /// Tests whether the graph is empty (has zero nodes).
+  bool Empty() const { return GetNodes()==0; }
+  /// Deletes all nodes and edges from the graph.
+  void Clr() { MxNId=0; NEdges=0; NIdV.Clr(); NIdxV.Clr(); OutOffV.Clr(); OutNbrV.Clr(); InOffV.Clr(); InNbrV.Clr();
+    IntAttrNmV.Clr(); IntAttrVV.Clr(); FltAttrNmV.Clr(); FltAttrVV.Clr(); }
+  /// Checks the graph data structure for internal consistency. ##TCsrGraph::IsOk
+  bool IsOk(const bool& ThrowExcept=true) const;
+  /// Print the graph in a human readable form to an output stream OutF.
+  void Dump(FILE *OutF=stdout) const;
+  friend class TPt<TCsrGraph>;
+};
+
+// set flags
+namespace TSnap {
+template <> struct IsDirected<TNCsrGraph> { enum { Val = 1 }; };
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::SortNbrs(TInt* BI, TInt* EI) {
+  // deterministic pivot, TVec::QSortCmp() draws pivots from the shared TInt::Rnd
+  while (EI - BI > 16) {
+    TInt* MI = BI + (EI - BI) / 2;
+    if (*MI < *BI) { TVec<TInt>::SwapI(MI, BI); }
+    if (*(EI-1) < *BI) { TVec<TInt>::SwapI(EI-1, BI); }
+    if (*(EI-1) < *MI) { TVec<TInt>::SwapI(EI-1, MI); }
+    const TInt Pivot = *MI;
+    TInt* LI = BI;  TInt* RI = EI - 1;
+    forever {
+      while (*LI < Pivot) { LI++; }
+      while (Pivot < *RI) { RI--; }
+      if (LI >= RI) { break; }
+      TVec<TInt>::SwapI(LI, RI);  LI++;  RI--;
+    }
+    if (RI + 1 - BI < EI - RI - 1) { SortNbrs(BI, RI + 1);  BI = RI + 1; }
+    else { SortNbrs(RI + 1, EI);  EI = RI + 1; }
+  }
+  TVec<TInt>::ISortCmp(BI, EI, TLss<TInt>());
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::BuildNIdx() {
+  MxNId = NIdV.Empty() ? 0 : NIdV.Last().Val + 1;
+  NIdxV.Clr();
+  // use a direct lookup table if node IDs are reasonably dense, binary search otherwise
+  if (! NIdV.Empty() && TNIdxMap::IsDense(NIdV[0], NIdV.Last(), NIdV.Len())) {
+    NIdxV.Gen(MxNId);
+    NIdxV.PutAll(-1);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < NIdV.Len(); i++) { NIdxV[NIdV[i]] = i; }
+  }
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::BuildNIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV) {
+  const int Edges = SrcNIdV.Len();
+  int MnId = TInt::Mx, MxId = -1;
+  for (int e = 0; e < Edges; e++) {
+    MnId = TMath::Mn(MnId, SrcNIdV[e].Val, DstNIdV[e].Val);
+    MxId = TMath::Mx(MxId, SrcNIdV[e].Val, DstNIdV[e].Val);
+  }
+  NIdV.Clr();
+  if (Edges == 0) { return; }
+  if (TNIdxMap::IsDense(MnId, MxId, Edges)) {
+    // mark the node IDs in a dense bitmap, then collect them in the increasing order
+    TIntV IsNIdV(MxId + 1);
+    IsNIdV.PutAll(0);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int e = 0; e < Edges; e++) {
+      IsNIdV[SrcNIdV[e]] = 1;  IsNIdV[DstNIdV[e]] = 1; }
+    for (int NId = 0; NId <= MxId; NId++) {
+      if (IsNIdV[NId] != 0) { NIdV.Add(NId); } }
+  } else {
+    NIdV.Reserve(2 * Edges);
+    NIdV.AddV(SrcNIdV);  NIdV.AddV(DstNIdV);
+    NIdV.Merge();
+  }
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::SortAndMerge(TVec<TInt64>& OffV, TNbrV& NbrV) const {
+  const int Nodes = GetNodes();
+  TIntV DegV(Nodes);
+  bool Dups = false;
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1000) reduction(||:Dups)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    TInt* BI = NbrV.BegI() + OffV[n];
+    TInt* EI = NbrV.BegI() + OffV[n+1];
+    SortNbrs(BI, EI);
+    int Deg = 0;
+    for (TInt* I = BI; I < EI; I++) {
+      if (Deg == 0 || *I != BI[Deg-1]) { BI[Deg++] = *I; } }
+    DegV[n] = Deg;
+    if (Deg != EI - BI) { Dups = true; }
+  }
+  if (! Dups) { return; }
+  // remove duplicate edges, compact neighbors into a new vector
+  TVec<TInt64> NewOffV(Nodes + 1);
+  NewOffV[0] = 0;
+  for (int n = 0; n < Nodes; n++) { NewOffV[n+1] = NewOffV[n] + DegV[n]; }
+  TNbrV NewNbrV(NewOffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    for (int e = 0; e < DegV[n]; e++) { NewNbrV[NewOffV[n] + e] = NbrV[OffV[n] + e]; } }
+  OffV.Swap(NewOffV);
+  NbrV.Swap(NewNbrV);
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::BuildFromEdges(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& SrcToDst, TVec<TInt64>& OffV, TNbrV& NbrV) const {
+  const int Nodes = GetNodes();
+  const int Edges = SrcNIdV.Len();
+  const TIntV& FromV = SrcToDst ? SrcNIdV : DstNIdV;
+  const TIntV& ToV = SrcToDst ? DstNIdV : SrcNIdV;
+  TIntV FromIdxV(Edges), ToIdxV(Edges);
+  TIntV DegV(Nodes);
+  DegV.PutAll(0);
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int e = 0; e < Edges; e++) {
+    FromIdxV[e] = GetNIdx(FromV[e]);  ToIdxV[e] = GetNIdx(ToV[e]);
+    AtomicInc(DegV[FromIdxV[e]]);
+    if (! IsDir && FromIdxV[e] != ToIdxV[e]) { AtomicInc(DegV[ToIdxV[e]]); }
+  }
+  OffV.Gen(Nodes + 1);
+  OffV[0] = 0;
+  for (int n = 0; n < Nodes; n++) { OffV[n+1] = OffV[n] + DegV[n]; }
+  NbrV.Gen(OffV[Nodes]);
+  DegV.PutAll(0);
+#ifdef GCC_ATOMIC
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int e = 0; e < Edges; e++) {
+    const int FromIdx = FromIdxV[e], ToIdx = ToIdxV[e];
+    NbrV[OffV[FromIdx] + AtomicInc(DegV[FromIdx])] = ToIdx;
+    if (! IsDir && FromIdx != ToIdx) { NbrV[OffV[ToIdx] + AtomicInc(DegV[ToIdx])] = FromIdx; }
+  }
+  SortAndMerge(OffV, NbrV);
+}
+
+template <bool IsDir>
+template <class PGraph>
+void TCsrGraph<IsDir>::BuildFromGraph(const PGraph& Graph, const bool& OutEdges, TVec<TInt64>& OffV, TNbrV& NbrV) const {
+  typedef typename PGraph::TObj::TNodeI TGraphNodeI;
+  const int Nodes = GetNodes();
+  // undirected CSR of a directed graph merges in- and out-neighbors
+  const bool AllNbrs = ! IsDir && HasGraphFlag(typename PGraph::TObj, gfDirected);
+  TVec<TGraphNodeI> NIV(Nodes);
+  OffV.Gen(Nodes + 1);
+  OffV[0] = 0;
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    NIV[n] = Graph->GetNI(NIdV[n]);
+    OffV[n+1] = AllNbrs ? NIV[n].GetDeg() : (OutEdges ? NIV[n].GetOutDeg() : NIV[n].GetInDeg());
+  }
+  for (int n = 0; n < Nodes; n++) { OffV[n+1] += OffV[n]; }
+  NbrV.Gen(OffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    const TGraphNodeI& NI = NIV[n];
+    const int Deg = int(OffV[n+1] - OffV[n]);
+    TInt* NbrI = NbrV.BegI() + OffV[n];
+    for (int e = 0; e < Deg; e++) {
+      NbrI[e] = GetNIdx(AllNbrs ? NI.GetNbrNId(e) : (OutEdges ? NI.GetOutNId(e) : NI.GetInNId(e))); }
+  }
+  SortAndMerge(OffV, NbrV);
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::CountEdges() {
+  if (IsDir) { NEdges = int(OutNbrV.Len()); return; }
+  // undirected edges are stored twice, self-loops once
+  int64 SelfEdges = 0;
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) reduction(+:SelfEdges)
+#endif
+  for (int n = 0; n < GetNodes(); n++) {
+    if (IsEdgeIdx(n, n)) { SelfEdges++; } }
+  NEdges = int((OutNbrV.Len() + SelfEdges) / 2);
+}
+
+template <bool IsDir>
+template <class PGraph>
+TPt<TCsrGraph<IsDir> > TCsrGraph<IsDir>::New(const PGraph& Graph, const bool& InEdges) {
+  PNet Net = New();
+  Graph->GetNIdV(Net->NIdV);
+  Net->NIdV.Sort();
+  Net->BuildNIdx();
+  Net->BuildFromGraph(Graph, true, Net->OutOffV, Net->OutNbrV);
+  if (IsDir && InEdges) {
+    Net->BuildFromGraph(Graph, false, Net->InOffV, Net->InNbrV); }
+  Net->CountEdges();
+  return Net;
+}
+
+template <bool IsDir>
+TPt<TCsrGraph<IsDir> > TCsrGraph<IsDir>::New(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& InEdges) {
+  IAssert(SrcNIdV.Len() == DstNIdV.Len());
+  PNet Net = New();
+  Net->BuildNIdV(SrcNIdV, DstNIdV);
+  Net->BuildNIdx();
+  Net->BuildFromEdges(SrcNIdV, DstNIdV, true, Net->OutOffV, Net->OutNbrV);
+  if (IsDir && InEdges) {
+    Net->BuildFromEdges(SrcNIdV, DstNIdV, false, Net->InOffV, Net->InNbrV); }
+  Net->CountEdges();
+  return Net;
+}
+
+template <bool IsDir>
+TPt<TCsrGraph<IsDir> > TCsrGraph<IsDir>::LoadShM(TShMIn& ShMIn) {
+  PNet Net = New();
+  Net->MxNId = TInt(ShMIn);
+  Net->NEdges = TInt(ShMIn);
+  Net->NIdV.LoadShM(ShMIn);
+  Net->NIdxV.LoadShM(ShMIn);
+  Net->OutOffV.LoadShM(ShMIn);
+  Net->OutNbrV.LoadShM(ShMIn);
+  Net->InOffV.LoadShM(ShMIn);
+  Net->InNbrV.LoadShM(ShMIn);
+  Net->IntAttrNmV.Load(ShMIn);
+  Net->IntAttrVV.LoadShM(ShMIn, TLoadAttrShM());
+  Net->FltAttrNmV.Load(ShMIn);
+  Net->FltAttrVV.LoadShM(ShMIn, TLoadAttrShM());
+  return Net;
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::PutMmapBf(TSOut& SOut, int64& Pos, const int64& Off, const void* Bf, const int64& BfL) {
+  static const char ZeroBf[MmapPageSz] = { 0 };
+  IAssert(Pos <= Off);
+  while (Pos < Off) {
+    const int64 PadL = TMath::Mn(Off - Pos, int64(MmapPageSz));
+    SOut.PutBf(ZeroBf, TSize(PadL));  Pos += PadL;
+  }
+  if (BfL > 0) { SOut.PutBf(Bf, TSize(BfL));  Pos += BfL; }
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::SaveMmap(TSOut& SOut) const {
+  const int Attrs = IntAttrNmV.Len() + FltAttrNmV.Len();
+  TMmapHdr Hdr;
+  memset(&Hdr, 0, sizeof(TMmapHdr));
+  memcpy(Hdr.Magic, "SNAPCSR", 8);
+  Hdr.ByteOrder = MmapByteOrder;  Hdr.Version = MmapVersion;
+  Hdr.IsDirected = IsDir;  Hdr.Attrs = Attrs;
+  Hdr.Nodes = GetNodes();  Hdr.Edges = GetEdges();  Hdr.MxNId = GetMxNId();
+  Hdr.NIdxLen = NIdxV.Len();  Hdr.OutNbrs = OutNbrV.Len();
+  Hdr.InNbrs = InOffV.Empty() ? -1 : InNbrV.Len();
+  // every array starts on a page boundary
+  int64 Off = MmapAlign(sizeof(TMmapHdr) + Attrs * sizeof(TMmapAttr));
+  Hdr.NIdVOff = Off;  Off = MmapAlign(Off + Hdr.Nodes * sizeof(TInt));
+  Hdr.NIdxVOff = Off;  Off = MmapAlign(Off + Hdr.NIdxLen * sizeof(TInt));
+  Hdr.OutOffVOff = Off;  Off = MmapAlign(Off + OutOffV.Len() * sizeof(TInt64));
+  Hdr.OutNbrVOff = Off;  Off = MmapAlign(Off + Hdr.OutNbrs * sizeof(TInt));
+  Hdr.InOffVOff = Off;  Off = MmapAlign(Off + InOffV.Len() * sizeof(TInt64));
+  Hdr.InNbrVOff = Off;  Off = MmapAlign(Off + InNbrV.Len() * sizeof(TInt));
+  TVec<TMmapAttr> AttrV(Attrs);
+  for (int AttrN = 0; AttrN < Attrs; AttrN++) {
+    const bool IsFlt = AttrN >= IntAttrNmV.Len();
+    const TStr& AttrNm = IsFlt ? FltAttrNmV[AttrN - IntAttrNmV.Len()] : IntAttrNmV[AttrN];
+    EAssertR(AttrNm.Len() < int(sizeof(AttrV[AttrN].Nm)), "Attribute name '" + AttrNm + "' is too long.");
+    memset(&AttrV[AttrN], 0, sizeof(TMmapAttr));
+    memcpy(AttrV[AttrN].Nm, AttrNm.CStr(), AttrNm.Len());
+    AttrV[AttrN].IsFlt = IsFlt;
+    AttrV[AttrN].Off = Off;
+    Off = MmapAlign(Off + Hdr.Nodes * (IsFlt ? sizeof(TFlt) : sizeof(TInt)));
+  }
+  Hdr.FileLen = Off;
+  int64 Pos = 0;
+  PutMmapBf(SOut, Pos, 0, &Hdr, sizeof(TMmapHdr));
+  for (int AttrN = 0; AttrN < Attrs; AttrN++) {
+    PutMmapBf(SOut, Pos, Pos, &AttrV[AttrN], sizeof(TMmapAttr)); }
+  PutMmapBf(SOut, Pos, Hdr.NIdVOff, NIdV.BegI(), Hdr.Nodes * sizeof(TInt));
+  PutMmapBf(SOut, Pos, Hdr.NIdxVOff, NIdxV.BegI(), Hdr.NIdxLen * sizeof(TInt));
+  PutMmapBf(SOut, Pos, Hdr.OutOffVOff, OutOffV.BegI(), OutOffV.Len() * sizeof(TInt64));
+  PutMmapBf(SOut, Pos, Hdr.OutNbrVOff, OutNbrV.BegI(), Hdr.OutNbrs * sizeof(TInt));
+  PutMmapBf(SOut, Pos, Hdr.InOffVOff, InOffV.BegI(), InOffV.Len() * sizeof(TInt64));
+  PutMmapBf(SOut, Pos, Hdr.InNbrVOff, InNbrV.BegI(), InNbrV.Len() * sizeof(TInt));
+  for (int AttrN = 0; AttrN < Attrs; AttrN++) {
+    if (AttrV[AttrN].IsFlt) {
+      PutMmapBf(SOut, Pos, AttrV[AttrN].Off, FltAttrVV[AttrN - IntAttrNmV.Len()].BegI(), Hdr.Nodes * sizeof(TFlt));
+    } else {
+      PutMmapBf(SOut, Pos, AttrV[AttrN].Off, IntAttrVV[AttrN].BegI(), Hdr.Nodes * sizeof(TInt)); }
+  }
+  PutMmapBf(SOut, Pos, Hdr.FileLen, NULL, 0);
+  SOut.Flush();
+}
+
+template <bool IsDir>
+TPt<TCsrGraph<IsDir> > TCsrGraph<IsDir>::LoadMmap(TShMIn& ShMIn) {
+  char* Bf = ShMIn.getCursor();
+  const TMmapHdr& Hdr = *(const TMmapHdr*) Bf;
+  EAssertR(ShMIn.GetSizeLeft() >= sizeof(TMmapHdr) && memcmp(Hdr.Magic, "SNAPCSR", 8) == 0, "Input is not a memory-mapped CSR graph.");
+  EAssertR(Hdr.ByteOrder == MmapByteOrder, "Memory-mapped CSR graph was saved with a different byte order.");
+  EAssertR(Hdr.Version == MmapVersion, TStr::Fmt("Unsupported memory-mapped CSR graph version %d.", Hdr.Version));
+  EAssertR(Hdr.IsDirected == IsDir, IsDir ? "Memory-mapped CSR graph is undirected." : "Memory-mapped CSR graph is directed.");
+  // the header and the sections must lie within the mapped input
+  const int64 FileLen = Hdr.FileLen;
+  EAssertR(FileLen >= 0 && uint64(FileLen) <= uint64(ShMIn.GetSizeLeft()), "Memory-mapped CSR graph is truncated.");
+  EAssertR(Hdr.Attrs >= 0 && IsMmapSec(FileLen, sizeof(TMmapHdr), Hdr.Attrs, sizeof(TMmapAttr)) &&
+    Hdr.Nodes >= 0 && Hdr.Nodes < TInt::Mx && Hdr.NIdxLen <= TInt::Mx && Hdr.OutNbrs <= TInt::Mx && Hdr.InNbrs <= TInt::Mx &&
+    Hdr.Edges >= 0 && Hdr.Edges <= TInt::Mx && Hdr.MxNId >= 0 && Hdr.MxNId <= TInt::Mx && Hdr.InNbrs >= -1 &&
+    IsMmapSec(FileLen, Hdr.NIdVOff, Hdr.Nodes, sizeof(TInt)) && IsMmapSec(FileLen, Hdr.NIdxVOff, Hdr.NIdxLen, sizeof(TInt)) &&
+    IsMmapSec(FileLen, Hdr.OutOffVOff, Hdr.Nodes + 1, sizeof(TInt64)) && IsMmapSec(FileLen, Hdr.OutNbrVOff, Hdr.OutNbrs, sizeof(TInt)) &&
+    (Hdr.InNbrs < 0 || (IsMmapSec(FileLen, Hdr.InOffVOff, Hdr.Nodes + 1, sizeof(TInt64)) &&
+    IsMmapSec(FileLen, Hdr.InNbrVOff, Hdr.InNbrs, sizeof(TInt)))), "Memory-mapped CSR graph has a corrupted header.");
+  const TMmapAttr* AttrV = (const TMmapAttr*) (Bf + sizeof(TMmapHdr));
+  for (int AttrN = 0; AttrN < Hdr.Attrs; AttrN++) {
+    EAssertR(memchr(AttrV[AttrN].Nm, 0, sizeof(AttrV[AttrN].Nm)) != NULL && IsMmapSec(FileLen, AttrV[AttrN].Off, Hdr.Nodes,
+      AttrV[AttrN].IsFlt ? sizeof(TFlt) : sizeof(TInt)), "Memory-mapped CSR graph has a corrupted attribute entry.");
+  }
+  // the neighbor offsets must end at the neighbor counts
+  const TInt64* OutOffV = (const TInt64*) (Bf + Hdr.OutOffVOff);
+  EAssertR(OutOffV[0] == 0 && OutOffV[Hdr.Nodes] == Hdr.OutNbrs, "Memory-mapped CSR graph has corrupted out-neighbor offsets.");
+  if (Hdr.InNbrs >= 0) {
+    const TInt64* InOffV = (const TInt64*) (Bf + Hdr.InOffVOff);
+    EAssertR(InOffV[0] == 0 && InOffV[Hdr.Nodes] == Hdr.InNbrs, "Memory-mapped CSR graph has corrupted in-neighbor offsets.");
+  }
+  PNet Net = New();
+  Net->MxNId = int(Hdr.MxNId);
+  Net->NEdges = int(Hdr.Edges);
+  // the vectors point into the mapped file, nothing is copied
+  Net->NIdV.GenExt((TInt*) (Bf + Hdr.NIdVOff), int(Hdr.Nodes));
+  if (Hdr.NIdxLen > 0) { Net->NIdxV.GenExt((TInt*) (Bf + Hdr.NIdxVOff), int(Hdr.NIdxLen)); }
+  Net->OutOffV.GenExt((TInt64*) (Bf + Hdr.OutOffVOff), int(Hdr.Nodes + 1));
+  Net->OutNbrV.GenExt((TInt*) (Bf + Hdr.OutNbrVOff), Hdr.OutNbrs);
+  if (Hdr.InNbrs >= 0) {
+    Net->InOffV.GenExt((TInt64*) (Bf + Hdr.InOffVOff), int(Hdr.Nodes + 1));
+    Net->InNbrV.GenExt((TInt*) (Bf + Hdr.InNbrVOff), Hdr.InNbrs);
+  }
+  for (int AttrN = 0; AttrN < Hdr.Attrs; AttrN++) {
+    if (AttrV[AttrN].IsFlt) { Net->FltAttrNmV.Add(AttrV[AttrN].Nm); } else { Net->IntAttrNmV.Add(AttrV[AttrN].Nm); } }
+  Net->IntAttrVV.Gen(Net->IntAttrNmV.Len());
+  Net->FltAttrVV.Gen(Net->FltAttrNmV.Len());
+  for (int AttrN = 0, IntAttrN = 0, FltAttrN = 0; AttrN < Hdr.Attrs; AttrN++) {
+    if (AttrV[AttrN].IsFlt) {
+      Net->FltAttrVV[FltAttrN++].GenExt((TFlt*) (Bf + AttrV[AttrN].Off), int(Hdr.Nodes));
+    } else {
+      Net->IntAttrVV[IntAttrN++].GenExt((TInt*) (Bf + AttrV[AttrN].Off), int(Hdr.Nodes)); }
+  }
+  ShMIn.AdvanceCursor(TSize(Hdr.FileLen));
+  return Net;
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::AddIntAttrN(const TStr& AttrNm, const TIntV& ValV) {
+  EAssertR(ValV.Len() == GetNodes(), "Attribute column must have one value per node.");
+  const int AttrN = IntAttrNmV.SearchForw(AttrNm);
+  if (AttrN != -1) { IntAttrVV[AttrN] = ValV; return; }
+  IntAttrNmV.Add(AttrNm);  IntAttrVV.Add(ValV);
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::AddFltAttrN(const TStr& AttrNm, const TFltV& ValV) {
+  EAssertR(ValV.Len() == GetNodes(), "Attribute column must have one value per node.");
+  const int AttrN = FltAttrNmV.SearchForw(AttrNm);
+  if (AttrN != -1) { FltAttrVV[AttrN] = ValV; return; }
+  FltAttrNmV.Add(AttrNm);  FltAttrVV.Add(ValV);
+}
+
+template <bool IsDir>
+bool TCsrGraph<IsDir>::IsEdgeIdx(const int& SrcNIdx, const int& DstNIdx) const {
+  const TInt* BI = BegOutNbrI(SrcNIdx);
+  int64 LValN = 0, RValN = EndOutNbrI(SrcNIdx) - BI - 1;
+  while (LValN <= RValN) {
+    const int64 ValN = (LValN + RValN) / 2;
+    if (BI[ValN] == DstNIdx) { return true; }
+    if (DstNIdx < BI[ValN]) { RValN = ValN - 1; } else { LValN = ValN + 1; }
+  }
+  return false;
+}
+
+template <bool IsDir>
+bool TCsrGraph<IsDir>::IsEdge(const int& SrcNId, const int& DstNId, const bool& IsDirected) const {
+  const int SrcNIdx = GetNIdx(SrcNId), DstNIdx = GetNIdx(DstNId);
+  if (SrcNIdx == -1 || DstNIdx == -1) { return false; }
+  if (IsDirected) { return IsEdgeIdx(SrcNIdx, DstNIdx); }
+  return IsEdgeIdx(SrcNIdx, DstNIdx) || IsEdgeIdx(DstNIdx, SrcNIdx);
+}
+
+template <bool IsDir>
+typename TCsrGraph<IsDir>::TEdgeI TCsrGraph<IsDir>::GetEI(const int& SrcNId, const int& DstNId) const {
+  int SrcNIdx = GetNIdx(SrcNId), DstNIdx = GetNIdx(DstNId);
+  if (! IsDir && SrcNIdx > DstNIdx) { int Tmp = SrcNIdx;  SrcNIdx = DstNIdx;  DstNIdx = Tmp; }
+  const TInt* BI = BegOutNbrI(SrcNIdx);
+  for (const TInt* I = BI; I < EndOutNbrI(SrcNIdx); I++) {
+    if (*I == DstNIdx) { return TEdgeI(GetNIByIdx(SrcNIdx), EndNI(), int(I - BI)); } }
+  return EndEI();
+}
+
+template <bool IsDir>
+bool TCsrGraph<IsDir>::IsOk(const bool& ThrowExcept) const {
+  bool RetVal = true;
+  TStr Msg;
+  if (OutOffV.Len() != GetNodes() + 1 || (IsDir && ! InOffV.Empty() && InOffV.Len() != GetNodes() + 1)) {
+    Msg = TStr::Fmt("Offset vectors do not match the number of nodes %d.", GetNodes());
+    if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+    return false;
+  }
+  for (int n = 0; n < GetNodes(); n++) {
+    if (n > 0 && NIdV[n-1] >= NIdV[n]) {
+      Msg = TStr::Fmt("Node IDs are not sorted at index %d.", n);
+      if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+      RetVal = false;
+    }
+    for (int Dir = 0; Dir < (IsDir && ! InOffV.Empty() ? 2 : 1); Dir++) {
+      const TInt* BI = Dir == 0 ? BegOutNbrI(n) : BegInNbrI(n);
+      const TInt* EI = Dir == 0 ? EndOutNbrI(n) : EndInNbrI(n);
+      for (const TInt* I = BI; I < EI; I++) {
+        if (*I < 0 || *I >= GetNodes()) {
+          Msg = TStr::Fmt("Edge of node %d points to invalid node index %d.", NIdV[n].Val, I->Val);
+          if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+          RetVal = false;
+        } else if (I > BI && *(I-1) >= *I) {
+          Msg = TStr::Fmt("Neighbor list of node %d is not sorted or has duplicates.", NIdV[n].Val);
+          if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+          RetVal = false;
+        } else if (Dir == 1 && ! IsEdgeIdx(*I, n)) {
+          Msg = TStr::Fmt("In-edge %d --> %d has no matching out-edge.", NIdV[I->Val].Val, NIdV[n].Val);
+          if (ThrowExcept) { EAssertR(false, Msg); } else { ErrNotify(Msg.CStr()); }
+          RetVal = false;
+        }
+      }
+    }
+  }
+  return RetVal;
+}
+
+template <bool IsDir>
+void TCsrGraph<IsDir>::Dump(FILE *OutF) const {
+  const int NodePlaces = (int) ceil(log10((double) GetNodes()));
+  fprintf(OutF, "-------------------------------------------------\n%s CSR Graph: nodes: %d, edges: %d\n",
+    IsDir ? "Directed" : "Undirected", GetNodes(), GetEdges());
+  for (TNodeI NI = BegNI(); NI < EndNI(); NI++) {
+    fprintf(OutF, "  %*d\n", NodePlaces, NI.GetId());
+    if (IsDir) {
+      fprintf(OutF, "    in [%d]", NI.GetInDeg());
+      for (int edge = 0; edge < NI.GetInDeg(); edge++) {
+        fprintf(OutF, " %*d", NodePlaces, NI.GetInNId(edge)); }
+      fprintf(OutF, "\n");
+    }
+    fprintf(OutF, "    %s [%d]", IsDir ? "out" : "nbr", NI.GetOutDeg());
+    for (int edge = 0; edge < NI.GetOutDeg(); edge++) {
+      fprintf(OutF, " %*d", NodePlaces, NI.GetOutNId(edge)); }
+    fprintf(OutF, "\n");
+  }
+  fprintf(OutF, "\n");
+}
+
+#endif // CSRGRAPH_H
@@ -1,7 +1,17 @@
 namespace TSnap {
 
+/// Gets the capacity of every edge by edge id, reading the capacity attribute column once.
+void GetCapV (const PNEANet &Net, TIntV &CapV) {
+  const TNEANet::TIntAttrCol CapCol = Net->GetIntAttrColE(CapAttrName);
+  CapV.Gen(Net->GetMxEId());
+  for (TNEANet::TEdgeI EI = Net->BegEI(); EI != Net->EndEI(); EI++) {
+    CapV[EI.GetId()] = EI.GetIntAttrDat(CapCol);
+    IAssert(CapV[EI.GetId()] >= 0);
+  }
+}
+
 // Returns the NId where the two directions of search meet up, or -1 if no augmenting path exists. ##TSnap::IntFlowBiDBFS
-int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, const int& SrcNId, const int& SnkNId) {
+int IntFlowBiDBFS (const PNEANet &Net, const TIntV& CapV, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, const int& SrcNId, const int& SnkNId) {
   FwdNodeQ.Push(SrcNId);
   PredEdgeH.AddDat(SrcNId, -1);
   BwdNodeQ.Push(SnkNId);
@@ -25,7 +35,7 @@ int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &
     for (int EdgeN = 0; EdgeN < FwdNI.GetOutDeg(); EdgeN++) {
       int NextNId = FwdNI.GetOutNId(EdgeN);
       int NextEId = FwdNI.GetOutEId(EdgeN);
-      if (!PredEdgeH.IsKey(NextNId) && Net->GetIntAttrIndDatE(NextEId, CapIndex) > Flow[NextEId]) {
+      if (!PredEdgeH.IsKey(NextNId) && CapV[NextEId] > Flow[NextEId]) {
         PredEdgeH.AddDat(NextNId, NextEId);
         if (SuccEdgeH.IsKey(NextNId)) {
           return NextNId;
@@ -51,7 +61,7 @@ int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &
     for (int EdgeN = 0; EdgeN < BwdNI.GetInDeg(); EdgeN++) {
       int PrevNId = BwdNI.GetInNId(EdgeN);
       int PrevEId = BwdNI.GetInEId(EdgeN);
-      if (!SuccEdgeH.IsKey(PrevNId) && Net->GetIntAttrIndDatE(PrevEId, CapIndex) > Flow[PrevEId]) {
+      if (!SuccEdgeH.IsKey(PrevNId) && CapV[PrevEId] > Flow[PrevEId]) {
         SuccEdgeH.AddDat(PrevNId, PrevEId);
         if (PredEdgeH.IsKey(PrevNId)) {
           return PrevNId;
@@ -64,8 +74,8 @@ int IntFlowBiDBFS (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &
 }
 
 /// Returns the amount the flow can be augmented over the paths, 0 if no path can be found. ##TSnap::FindAugV
-int FindAugV (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, TIntV &MidToSrcAugV, TIntV &MidToSnkAugV, const int& SrcNId, const int& SnkNId) {
-  int MidPtNId = IntFlowBiDBFS(Net, CapIndex, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, SrcNId, SnkNId);
+int FindAugV (const PNEANet &Net, const TIntV& CapV, TIntV &Flow, TIntQ &FwdNodeQ, TIntH &PredEdgeH, TIntQ &BwdNodeQ, TIntH &SuccEdgeH, TIntV &MidToSrcAugV, TIntV &MidToSnkAugV, const int& SrcNId, const int& SnkNId) {
+  int MidPtNId = IntFlowBiDBFS(Net, CapV, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, SrcNId, SnkNId);
   if (MidPtNId == -1) { return 0; }
   int MinAug = TInt::Mx, NId = MidPtNId, AugFlow = 0;
   // Build the path from the midpoint back to the source by tracing through the PredEdgeH
@@ -77,7 +87,7 @@ int FindAugV (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNo
       AugFlow = Flow[EId];
     } else {
       NId = EI.GetSrcNId();
-      AugFlow = Net->GetIntAttrIndDatE(EId, CapIndex) - Flow[EId];
+      AugFlow = CapV[EId] - Flow[EId];
     }
     if (AugFlow < MinAug) { MinAug = AugFlow; }
   }
@@ -91,7 +101,7 @@ int FindAugV (const PNEANet &Net, const int& CapIndex, TIntV &Flow, TIntQ &FwdNo
       AugFlow = Flow[EId];
     } else {
       NId = EI.GetDstNId();
-      AugFlow = Net->GetIntAttrIndDatE(EId, CapIndex) - Flow[EId];
+      AugFlow = CapV[EId] - Flow[EId];
     }
     if (AugFlow < MinAug) { MinAug = AugFlow; }
   }
@@ -102,13 +112,9 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
   IAssert(Net->IsNode(SrcNId));
   IAssert(Net->IsNode(SnkNId));
   if (SrcNId == SnkNId) { return 0; }
-  int CapIndex = Net->GetIntAttrIndE(CapAttrName);
-  TIntV Flow(Net->GetMxEId());
-  // Initialize flow values to 0, and make sure capacities are nonnegative
-  for (TNEANet::TEdgeI EI = Net->BegEI(); EI != Net->EndEI(); EI++) {
-    IAssert(Net->GetIntAttrIndDatE(EI, CapIndex) >= 0);
-    Flow[EI.GetId()] = 0;
-  }
+  // flow values start at 0, capacities have to be nonnegative
+  TIntV CapV, Flow(Net->GetMxEId());
+  GetCapV(Net, CapV);
   // Return 0 if user attempts to flow from a node to itself.
   if (SrcNId == SnkNId) { return 0; }
   int MaxFlow = 0, MinAug, CurNId;
@@ -116,7 +122,7 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
     TIntV MidToSrcAugV; TIntV MidToSnkAugV;
     TIntQ FwdNodeQ; TIntQ BwdNodeQ;
     TIntH PredEdgeH; TIntH SuccEdgeH;
-    MinAug = FindAugV(Net, CapIndex, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, MidToSrcAugV, MidToSnkAugV, SrcNId, SnkNId);
+    MinAug = FindAugV(Net, CapV, Flow, FwdNodeQ, PredEdgeH, BwdNodeQ, SuccEdgeH, MidToSrcAugV, MidToSnkAugV, SrcNId, SnkNId);
     if (MinAug == 0) { break; }
     MaxFlow += MinAug;
     CurNId = SrcNId;
@@ -150,14 +156,9 @@ int GetMaxFlowIntEK (PNEANet &Net, const int &SrcNId, const int &SnkNId) {
 /// Push relabel attr manager. ##PR_Manager
 class TPRManager {
 public:
-  TPRManager(PNEANet &Net) : Net(Net), CapIndex(0), FlowV(Net->GetMxEId()), ExcessV(Net->GetMxNId()), EdgeNumsV(Net->GetMxNId()), LabelsV(Net->GetMxNId()), LabelCounts(Net->GetNodes() + 1), LabelLimit(0), MaxLabel(Net->GetNodes()), ActiveNodeSet(Net->GetMxNId()), ActiveCount(0) {
-    CapIndex = Net->GetIntAttrIndE(CapAttrName);
+  TPRManager(PNEANet &Net) : Net(Net), CapV(), FlowV(Net->GetMxEId()), ExcessV(Net->GetMxNId()), EdgeNumsV(Net->GetMxNId()), LabelsV(Net->GetMxNId()), LabelCounts(Net->GetNodes() + 1), LabelLimit(0), MaxLabel(Net->GetNodes()), ActiveNodeSet(Net->GetMxNId()), ActiveCount(0) {
+    GetCapV(Net, CapV);
     for (int i = 0; i <= Net->GetNodes(); i++) { LabelCounts[i] = 0; }
-    for (TNEANet::TEdgeI EI = Net->BegEI(); EI != Net->EndEI(); EI++) {
-      int EId = EI.GetId();
-      IAssert(Capacity(EId) >= 0);
-      FlowV[EId] = 0;
-    }
     for (TNEANet::TNodeI NI = Net->BegNI(); NI != Net->EndNI(); NI++) {
       int NId = NI.GetId();
       ExcessV[NId] = 0;
@@ -168,7 +169,7 @@ public:
   }
 
   int Capacity (int EId) {
-    return Net->GetIntAttrIndDatE(EId, CapIndex);
+    return CapV[EId];
   }
 
   int &Flow (int EId) {
@@ -249,7 +250,7 @@ public:
 
 private:
   PNEANet &Net;
-  int CapIndex;
+  TIntV CapV;
   TIntV FlowV;
 
   TIntV ExcessV;
@@ -57,4 +57,86 @@ void TUnionFind::Dump() {
     printf("  %d\t%d\n", int(KIdSetH.GetKey(i)), Find(KIdSetH.GetKey(i)));
   }
   printf("\n");
-}
\ No newline at end of file
+}
+
+/////////////////////////////////////////////////
+// Edge Batch
+void TEdgeBatch::Gen(const TIntV& KeyV, const TIntV& ValV, const int& Keys) {
+  IAssert(KeyV.Len() == ValV.Len());
+  OffV.Gen(Keys+1);
+  for (int i = 0; i < KeyV.Len(); i++) { OffV[KeyV[i]+1]++; }
+  for (int KeyN = 0; KeyN < Keys; KeyN++) { OffV[KeyN+1] += OffV[KeyN]; }
+  // the values of a node keep their order in the batch
+  TIntV PosV(OffV);
+  ValIdxV.Gen(KeyV.Len());
+  for (int i = 0; i < KeyV.Len(); i++) {
+    TInt& Pos = PosV[KeyV[i]];
+    ValIdxV[Pos] = TIntPr(ValV[i], i);
+    Pos++;
+  }
+  MergeOffV.Clr();  MergeLenV.Clr();  MergeV.Clr();
+}
+
+// the values of each node are sorted (by value and batch index) and merged with the sorted vector,
+// of equal values only the first one in the batch can be new
+void TEdgeBatch::Merge(const TVec<TIntV*>& SortedVV, TBoolV& NewV, const bool& KeepMerged) {
+  const int Keys = GetKeys();
+  // the length is bounded explicitly, otherwise gcc warns (-Walloc-size-larger-than) on the allocation
+  NewV.Gen(TInt::GetMx(ValIdxV.Len(), 0));
+  MergeOffV.Gen(Keys);  MergeLenV.Gen(Keys);
+  // the merged vectors share one int-indexed vector, their total length is checked before it is allocated
+  int64 MergeVals = 0;
+  if (KeepMerged) {
+    for (int KeyN = 0; KeyN < Keys; KeyN++) {
+      if (GetVals(KeyN) == 0) { continue; }
+      MergeOffV[KeyN] = int(MergeVals);
+      MergeVals += SortedVV[KeyN]->Len() + GetVals(KeyN);
+      IAssertR(MergeVals <= TInt::Mx, "The merged edge batch has too many values.");
+    }
+  }
+  MergeV.Gen(int(MergeVals));
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+  for (int KeyN = 0; KeyN < Keys; KeyN++) {
+    if (GetVals(KeyN) == 0) { continue; }
+    const TIntV& SortedV = *SortedVV[KeyN];
+    const int BegN = OffV[KeyN], EndN = OffV[KeyN+1];
+    ValIdxV.QSort(BegN, EndN-1, true);
+    TInt* DstT = MergeV.BegI() + MergeOffV[KeyN];
+    int Dsts = 0, SortedN = 0;
+    for (int ValN = BegN; ValN < EndN; ValN++) {
+      const int Val = ValIdxV[ValN].Val1;
+      if (ValN > BegN && ValIdxV[ValN-1].Val1 == Val) { continue; }
+      while (SortedN < SortedV.Len() && SortedV[SortedN] < Val) {
+        if (KeepMerged) { DstT[Dsts++] = SortedV[SortedN]; }
+        SortedN++;
+      }
+      if (SortedN < SortedV.Len() && SortedV[SortedN] == Val) { continue; }
+      NewV[ValIdxV[ValN].Val2] = true;
+      if (KeepMerged) { DstT[Dsts++] = Val; }
+    }
+    if (KeepMerged) {
+      for (; SortedN < SortedV.Len(); SortedN++) { DstT[Dsts++] = SortedV[SortedN]; }
+      MergeLenV[KeyN] = Dsts;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+// Node Index Map
+void TNIdxMap::Gen(const TIntV& NIdV) {
+  const int Nodes = NIdV.Len();
+  int MnNId = TInt::Mx, MxNId = -1;
+  for (int i = 0; i < Nodes; i++) {
+    MnNId = TMath::Mn(MnNId, NIdV[i].Val);  MxNId = TMath::Mx(MxNId, NIdV[i].Val); }
+  IdxV.Clr();  IdxH.Clr();
+  if (Nodes == 0) { return; }
+  if (IsDense(MnNId, MxNId, Nodes)) {
+    IdxV.Gen(MxNId+1);  IdxV.PutAll(-1);
+    for (int i = 0; i < Nodes; i++) { IdxV[NIdV[i]] = i; }
+  } else {
+    IdxH.Gen(Nodes);
+    for (int i = 0; i < Nodes; i++) { IdxH.AddDat(NIdV[i], i); }
+  }
+}
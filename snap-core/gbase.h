@@ -259,6 +259,72 @@ public:
   void Dump();
 };
 
+//#//////////////////////////////////////////////
+/// Batch of edges grouped by node, used by AddEdgeBatch() of the graphs.
+class TEdgeBatch {
+private:
+  TIntV OffV;       // the values of node index KeyN are ValIdxV[OffV[KeyN]..OffV[KeyN+1])
+  TIntPrV ValIdxV;  // (value, index of the value in the batch)
+  TIntV MergeOffV, MergeLenV;  // the merged vector of node index KeyN
+  TIntV MergeV;
+public:
+  TEdgeBatch() : OffV(), ValIdxV(), MergeOffV(), MergeLenV(), MergeV() { }
+
+  /// Groups the values ValV[i] by the node indices KeyV[i] from 0 to Keys-1 (a counting sort).
+  void Gen(const TIntV& KeyV, const TIntV& ValV, const int& Keys);
+  /// Returns the number of node indices.
+  int GetKeys() const { return OffV.Len()-1; }
+  /// Returns the number of values of node index KeyN.
+  int GetVals(const int& KeyN) const { return OffV[KeyN+1]-OffV[KeyN]; }
+  /// Merges the values of each node index KeyN with the sorted vector *SortedVV[KeyN] (in parallel).
+  /// NewV[i] tells whether value i is neither in its sorted vector nor earlier in the batch.
+  /// With KeepMerged the merged vectors (sorted, without duplicates) are kept for GetMergedV().
+  void Merge(const TVec<TIntV*>& SortedVV, TBoolV& NewV, const bool& KeepMerged=true);
+  /// Returns the merged vector of node index KeyN as an external vector of the batch.
+  void GetMergedV(const int& KeyN, TIntV& MergedV) { MergedV.GenExt(MergeV.BegI()+MergeOffV[KeyN], MergeLenV[KeyN]); }
+};
+
+//#//////////////////////////////////////////////
+/// Map from node IDs to node indices 0...N-1, used to build the adjacency on node indices of the parallel algorithms.
+class TNIdxMap {
+public:
+  typedef TVec<TInt, int64> TNbrV;  // neighbor indices of all nodes, may exceed 2^31 entries
+private:
+  TIntV IdxV;  // node index of every node ID up to the largest one, -1 if not a node, empty if node IDs are sparse
+  TIntH IdxH;  // node index of every node ID if node IDs are sparse
+public:
+  TNIdxMap() : IdxV(), IdxH() { }
+
+  /// Returns true if Nodes node IDs from MnNId to MxNId are dense enough to be indexed by a vector of MxNId+1 elements.
+  static bool IsDense(const int& MnNId, const int& MxNId, const int64& Nodes) {
+    return MnNId >= 0 && MxNId < TInt::Mx && MxNId <= 4 * Nodes + 1024; }
+  /// Maps node NIdV[i] to index i.
+  void Gen(const TIntV& NIdV);
+  /// Returns the node index of node NId.
+  int GetIdx(const int& NId) const { return IdxV.Empty() ? IdxH.GetDat(NId).Val : IdxV[NId].Val; }
+  /// Builds the adjacency on node indices of nodes NIV, where NIV[i] is the node of index i. The neighbors of index i are
+  /// NbrV[OffV[i]...OffV[i+1]-1], its out-neighbors (if Out) followed by its in-neighbors (if In), one per edge.
+  template <class TNodeI> void GetNbrIdxV(const TVec<TNodeI>& NIV, const bool& Out, const bool& In, TVec<TInt64>& OffV, TNbrV& NbrV) const;
+};
+
+template <class TNodeI>
+void TNIdxMap::GetNbrIdxV(const TVec<TNodeI>& NIV, const bool& Out, const bool& In, TVec<TInt64>& OffV, TNbrV& NbrV) const {
+  const int Nodes = NIV.Len();
+  OffV.Gen(Nodes+1);
+  for (int i = 0; i < Nodes; i++) {
+    OffV[i+1] = OffV[i] + (Out ? NIV[i].GetOutDeg() : 0) + (In ? NIV[i].GetInDeg() : 0); }
+  NbrV.Gen(OffV[Nodes]);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic,1024)
+#endif
+  for (int i = 0; i < Nodes; i++) {
+    const TNodeI& NI = NIV[i];
+    int64 NbrN = OffV[i];
+    for (int e = 0; Out && e < NI.GetOutDeg(); e++) { NbrV[NbrN++] = GetIdx(NI.GetOutNId(e)); }
+    for (int e = 0; In && e < NI.GetInDeg(); e++) { NbrV[NbrN++] = GetIdx(NI.GetInNId(e)); }
+  }
+}
+
 //#//////////////////////////////////////////////
 /// Simple heap data structure. ##THeap
 template <class TVal, class TCmp = TLss<TVal> >
@@ -345,4 +345,181 @@ TVec<PNGraph> LoadDyNetGraphV(const TStr& FNm) {
   return GraphV;
 }
 
+namespace TSnapDetail {
+
+// Parses an integer field in the same way as TSsParser::GetInt(): {ws} [-] +{ddd}, nothing may follow.
+static bool GetEdgeListInt(const char* BegI, const char* EndI, int& Val) {
+  while (BegI < EndI && TCh::IsWs(*BegI)) { BegI++; }
+  const bool Minus = BegI < EndI && *BegI == '-';
+  if (Minus) { BegI++; }
+  if (BegI == EndI || ! TCh::IsNum(*BegI)) { return false; }
+  uint _Val = 0;
+  for (; BegI < EndI && TCh::IsNum(*BegI); BegI++) {
+    _Val = 10 * _Val + uint(*BegI - '0'); }
+  if (BegI != EndI) { return false; }
+  Val = int(Minus ? 0u - _Val : _Val);
+  return true;
+}
+
+// Parses the lines in [BegI, EndI), lines are skipped exactly when TSsParser and TSsParser::GetInt() skip them.
+static void LoadEdgeListBf(const char* BegI, const char* EndI, const int& SrcColId, const int& DstColId,
+ const bool& WhiteSep, const char& Separator, TIntV& SrcNIdV, TIntV& DstNIdV) {
+  const int MxColId = TMath::Mx(SrcColId, DstColId);
+  const char* FldBegI[2] = { NULL, NULL };
+  const char* FldEndI[2] = { NULL, NULL };
+  while (BegI < EndI) {
+    // memchr() scans for the end of line several bytes at a time
+    const char* LnEndI = (const char*) memchr(BegI, '\n', EndI - BegI);
+    const char* NextI = LnEndI == NULL ? EndI : LnEndI + 1;
+    if (LnEndI == NULL) { LnEndI = EndI; }
+    if (LnEndI > BegI && *(LnEndI-1) == '\r') { LnEndI--; }
+    const char* ChI = BegI;
+    BegI = NextI;
+    if (ChI == LnEndI || *ChI == '#') { continue; }
+    FldBegI[0] = FldBegI[1] = NULL;
+    for (int ColN = 0; ColN <= MxColId; ColN++) {
+      if (WhiteSep) {
+        while (ChI < LnEndI && TCh::IsWs(*ChI)) { ChI++; }
+        if (ChI == LnEndI) { break; }
+      } else if (ColN > 0) {
+        if (ChI == LnEndI) { break; }
+        ChI++;
+      }
+      const char* FldI = ChI;
+      if (WhiteSep) { while (ChI < LnEndI && ! TCh::IsWs(*ChI)) { ChI++; } }
+      else { while (ChI < LnEndI && *ChI != Separator) { ChI++; } }
+      if (ColN == SrcColId) { FldBegI[0] = FldI;  FldEndI[0] = ChI; }
+      if (ColN == DstColId) { FldBegI[1] = FldI;  FldEndI[1] = ChI; }
+    }
+    int SrcNId, DstNId;
+    if (FldBegI[0] == NULL || FldBegI[1] == NULL) { continue; }
+    if (! GetEdgeListInt(FldBegI[0], FldEndI[0], SrcNId) || ! GetEdgeListInt(FldBegI[1], FldEndI[1], DstNId)) { continue; }
+    SrcNIdV.Add(SrcNId);  DstNIdV.Add(DstNId);
+  }
+}
+
+void LoadEdgeListV(const TStr& InFNm, const int& SrcColId, const int& DstColId, const bool& WhiteSep, const char& Separator, TIntV& SrcNIdV, TIntV& DstNIdV) {
+  SrcNIdV.Clr();  DstNIdV.Clr();
+#ifdef GLib_LINUX
+  if (! TZipIn::IsZipFNm(InFNm)) {
+    const int64 FLen = int64(TFile::GetSize(InFNm));
+    if (FLen == 0) { return; }
+    TShMIn ShMIn(InFNm);
+    const char* Bf = ShMIn.getCursor();
+    // split the file into chunks at line boundaries, every chunk is parsed by one thread
+    int Chunks = 1;
+#ifdef USE_OPENMP
+    Chunks = omp_get_max_threads() * CHUNKS_PER_THREAD;
+#endif
+    Chunks = (int) TMath::Mx(int64(1), TMath::Mn(int64(Chunks), FLen / Kilo(64)));
+    TVec<TInt64> ChunkV(Chunks + 1);
+    ChunkV[0] = 0;
+    for (int c = 1; c < Chunks; c++) {
+      int64 Pos = TMath::Mx(ChunkV[c-1].Val, FLen * c / Chunks);
+      if (Pos > 0 && Pos < FLen && Bf[Pos-1] != '\n') {
+        const char* LnEndI = (const char*) memchr(Bf + Pos, '\n', FLen - Pos);
+        Pos = LnEndI == NULL ? FLen : LnEndI - Bf + 1;
+      }
+      ChunkV[c] = Pos;
+    }
+    ChunkV[Chunks] = FLen;
+    TVec<TIntV> SrcNIdVV(Chunks), DstNIdVV(Chunks);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int c = 0; c < Chunks; c++) {
+      LoadEdgeListBf(Bf + ChunkV[c], Bf + ChunkV[c+1], SrcColId, DstColId, WhiteSep, Separator, SrcNIdVV[c], DstNIdVV[c]); }
+    // concatenate the chunks in the file order
+    TIntV OffV(Chunks + 1);
+    OffV[0] = 0;
+    for (int c = 0; c < Chunks; c++) {
+      IAssertR(int64(OffV[c]) + SrcNIdVV[c].Len() <= TInt::Mx, "Too many edges in the edge list.");
+      OffV[c+1] = OffV[c] + SrcNIdVV[c].Len(); }
+    SrcNIdV.Gen(OffV[Chunks]);  DstNIdV.Gen(OffV[Chunks]);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int c = 0; c < Chunks; c++) {
+      for (int e = 0; e < SrcNIdVV[c].Len(); e++) {
+        SrcNIdV[OffV[c] + e] = SrcNIdVV[c][e];  DstNIdV[OffV[c] + e] = DstNIdVV[c][e]; }
+      SrcNIdVV[c].Clr();  DstNIdVV[c].Clr();
+    }
+    ShMIn.CloseMapping();
+    return;
+  }
+#endif
+  // compressed files (and platforms without mmap) are parsed sequentially
+  TSsParser* Ss = WhiteSep ? new TSsParser(InFNm, ssfWhiteSep, true, true, true) : new TSsParser(InFNm, Separator);
+  int SrcNId, DstNId;
+  while (Ss->Next()) {
+    if (! Ss->GetInt(SrcColId, SrcNId) || ! Ss->GetInt(DstColId, DstNId)) { continue; }
+    SrcNIdV.Add(SrcNId);  DstNIdV.Add(DstNId);
+  }
+  delete Ss;
+}
+
+// Returns the dense CSR indices of the nodes in the order of their first appearance in the edge list.
+template <class PCsrGraph>
+static void GetEdgeListNIdxV(const PCsrGraph& CsrGraph, const TIntV& SrcNIdV, const TIntV& DstNIdV, TIntV& NIdxV) {
+  TBoolV IsSeenV(CsrGraph->GetNodes());
+  IsSeenV.PutAll(false);
+  NIdxV.Gen(CsrGraph->GetNodes(), 0);
+  for (int e = 0; e < SrcNIdV.Len(); e++) {
+    const int SrcNIdx = CsrGraph->GetNIdx(SrcNIdV[e]);
+    if (! IsSeenV[SrcNIdx]) { IsSeenV[SrcNIdx] = true;  NIdxV.Add(SrcNIdx); }
+    const int DstNIdx = CsrGraph->GetNIdx(DstNIdV[e]);
+    if (! IsSeenV[DstNIdx]) { IsSeenV[DstNIdx] = true;  NIdxV.Add(DstNIdx); }
+  }
+}
+
+PUNGraph TEdgeListToGraph<PUNGraph>::New(const TIntV& SrcNIdV, const TIntV& DstNIdV) {
+  // the CSR graph sorts and deduplicates the adjacency lists in parallel
+  PUNCsrGraph CsrGraph = TUNCsrGraph::New(SrcNIdV, DstNIdV);
+  TIntV NIdxV;
+  GetEdgeListNIdxV(CsrGraph, SrcNIdV, DstNIdV, NIdxV);
+  PUNGraph Graph = TUNGraph::New(CsrGraph->GetNodes(), CsrGraph->GetEdges());
+  for (int n = 0; n < NIdxV.Len(); n++) {
+    const int NId = CsrGraph->GetNId(NIdxV[n]);
+    Graph->AddNodeUnchecked(NId);
+    Graph->ReserveNIdDeg(NId, CsrGraph->GetOutDegIdx(NIdxV[n]));
+  }
+  // adding edges (i, j), i <= j, in increasing order of i keeps all the neighbor lists sorted
+  for (int i = 0; i < CsrGraph->GetNodes(); i++) {
+    const int SrcNId = CsrGraph->GetNId(i);
+    for (const TInt* NbrI = CsrGraph->BegOutNbrI(i); NbrI < CsrGraph->EndOutNbrI(i); NbrI++) {
+      if (*NbrI >= i) { Graph->AddEdgeUnchecked(SrcNId, CsrGraph->GetNId(*NbrI)); } }
+  }
+  return Graph;
+}
+
+PNGraph TEdgeListToGraph<PNGraph>::New(const TIntV& SrcNIdV, const TIntV& DstNIdV) {
+  PNCsrGraph CsrGraph = TNCsrGraph::New(SrcNIdV, DstNIdV);
+  TIntV NIdxV;
+  GetEdgeListNIdxV(CsrGraph, SrcNIdV, DstNIdV, NIdxV);
+  PNGraph Graph = TNGraph::New(CsrGraph->GetNodes(), CsrGraph->GetEdges());
+  for (int n = 0; n < NIdxV.Len(); n++) {
+    const int NId = CsrGraph->GetNId(NIdxV[n]);
+    Graph->AddNodeUnchecked(NId);
+    Graph->ReserveNIdInDeg(NId, CsrGraph->GetInDegIdx(NIdxV[n]));
+    Graph->ReserveNIdOutDeg(NId, CsrGraph->GetOutDegIdx(NIdxV[n]));
+  }
+  // adding edges in increasing order of the source keeps the in- and out-neighbor lists sorted
+  for (int i = 0; i < CsrGraph->GetNodes(); i++) {
+    const int SrcNId = CsrGraph->GetNId(i);
+    for (const TInt* NbrI = CsrGraph->BegOutNbrI(i); NbrI < CsrGraph->EndOutNbrI(i); NbrI++) {
+      Graph->AddEdgeUnchecked(SrcNId, CsrGraph->GetNId(*NbrI)); }
+  }
+  return Graph;
+}
+
+} // namespace TSnapDetail
+
+void LoadEdgeListV(const TStr& InFNm, TIntV& SrcNIdV, TIntV& DstNIdV, const int& SrcColId, const int& DstColId) {
+  TSnapDetail::LoadEdgeListV(InFNm, SrcColId, DstColId, true, ' ', SrcNIdV, DstNIdV);
+}
+
+void LoadEdgeListV(const TStr& InFNm, TIntV& SrcNIdV, TIntV& DstNIdV, const int& SrcColId, const int& DstColId, const char& Separator) {
+  TSnapDetail::LoadEdgeListV(InFNm, SrcColId, DstColId, false, Separator, SrcNIdV, DstNIdV);
+}
+
 }; // namespace TSnap
@@ -18,6 +18,10 @@ const TStr NULL_VAL = ("__null__");
 template <class PGraph> PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId=0, const int& DstColId=1);
 /// Loads a (directed, undirected or multi) graph from a text file InFNm with 1 edge per line ('Separator' separated columns, integer node ids).
 template <class PGraph> PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId, const char& Separator);
+/// Loads the edges of a text file InFNm with 1 edge per line (whitespace separated columns, integer node ids) into SrcNIdV and DstNIdV. ##LoadEdgeListV
+void LoadEdgeListV(const TStr& InFNm, TIntV& SrcNIdV, TIntV& DstNIdV, const int& SrcColId=0, const int& DstColId=1);
+/// Loads the edges of a text file InFNm with 1 edge per line ('Separator' separated columns, integer node ids) into SrcNIdV and DstNIdV.
+void LoadEdgeListV(const TStr& InFNm, TIntV& SrcNIdV, TIntV& DstNIdV, const int& SrcColId, const int& DstColId, const char& Separator);
 /// Loads a network from the text file InFNm with 1 node/edge per line ('Separator' separated columns, integer node id(s) + node/edge attributes).
 PNEANet LoadEdgeListNet(const TStr& InFNm, const char& Separator);
 /// Loads a (directed, undirected or multi) graph from a text file InFNm with 1 edge per line (whitespace separated columns, arbitrary string node ids).
@@ -67,37 +71,60 @@ template<class PGraph> void SaveGViz(const PGraph& Graph, const TStr& OutFNm, co
 /////////////////////////////////////////////////
 // Implementation
 
+namespace TSnapDetail {
+/// Parses the edge list file InFNm in parallel, edges are returned in the order of lines.
+void LoadEdgeListV(const TStr& InFNm, const int& SrcColId, const int& DstColId, const bool& WhiteSep, const char& Separator, TIntV& SrcNIdV, TIntV& DstNIdV);
+
+/// Loads a graph from an edge list file. Nodes and edges are added while the lines are parsed,
+/// in the order of the lines, so the edge list is never held in memory.
+template <class PGraph>
+struct TEdgeListToGraph {
+  static PGraph Load(const TStr& InFNm, const int& SrcColId, const int& DstColId, const bool& WhiteSep, const char& Separator) {
+    PSsParser Ss = WhiteSep ? new TSsParser(InFNm, ssfWhiteSep, true, true, true) : new TSsParser(InFNm, Separator);
+    PGraph Graph = PGraph::TObj::New();
+    int SrcNId, DstNId;
+    while (Ss->Next()) {
+      if (! Ss->GetInt(SrcColId, SrcNId) || ! Ss->GetInt(DstColId, DstNId)) { continue; }
+      if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
+      if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
+      Graph->AddEdge(SrcNId, DstNId);
+    }
+    Graph->Defrag();
+    return Graph;
+  }
+};
+
+/// Parallel parsing and bulk construction of undirected graphs from the sorted adjacency lists of a CSR graph.
+template <>
+struct TEdgeListToGraph<PUNGraph> {
+  static PUNGraph Load(const TStr& InFNm, const int& SrcColId, const int& DstColId, const bool& WhiteSep, const char& Separator) {
+    TIntV SrcNIdV, DstNIdV;
+    LoadEdgeListV(InFNm, SrcColId, DstColId, WhiteSep, Separator, SrcNIdV, DstNIdV);
+    return New(SrcNIdV, DstNIdV); }
+  static PUNGraph New(const TIntV& SrcNIdV, const TIntV& DstNIdV);
+};
+
+/// Parallel parsing and bulk construction of directed graphs from the sorted adjacency lists of a CSR graph.
+template <>
+struct TEdgeListToGraph<PNGraph> {
+  static PNGraph Load(const TStr& InFNm, const int& SrcColId, const int& DstColId, const bool& WhiteSep, const char& Separator) {
+    TIntV SrcNIdV, DstNIdV;
+    LoadEdgeListV(InFNm, SrcColId, DstColId, WhiteSep, Separator, SrcNIdV, DstNIdV);
+    return New(SrcNIdV, DstNIdV); }
+  static PNGraph New(const TIntV& SrcNIdV, const TIntV& DstNIdV);
+};
+} // namespace TSnapDetail
+
 /// Loads the format saved by TSnap::SaveEdgeList() ##LoadEdgeList
 template <class PGraph>
 PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId) {
-  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
-  PGraph Graph = PGraph::TObj::New();
-  int SrcNId, DstNId;
-
-  while (Ss.Next()) {
-    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
-    if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
-    if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
-    Graph->AddEdge(SrcNId, DstNId);
-  }
-  Graph->Defrag();
-  return Graph;
+  return TSnapDetail::TEdgeListToGraph<PGraph>::Load(InFNm, SrcColId, DstColId, true, ' ');
 }
 
 /// Loads the format saved by TSnap::SaveEdgeList() if we set Separator='\t'. ##LoadEdgeList_Separator
 template <class PGraph>
 PGraph LoadEdgeList(const TStr& InFNm, const int& SrcColId, const int& DstColId, const char& Separator) {
-  TSsParser Ss(InFNm, Separator);
-  PGraph Graph = PGraph::TObj::New();
-  int SrcNId, DstNId;
-  while (Ss.Next()) {
-    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
-    if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
-    if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
-    Graph->AddEdge(SrcNId, DstNId);
-  }
-  Graph->Defrag();
-  return Graph;
+  return TSnapDetail::TEdgeListToGraph<PGraph>::Load(InFNm, SrcColId, DstColId, false, Separator);
 }
 
 /// Loads the format saved by TSnap::SaveEdgeList(), where node IDs are strings ##LoadEdgeListStr
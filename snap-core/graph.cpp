@@ -12,6 +12,7 @@ int TUNGraph::AddNode(int NId) {
     IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
     MxNId = TMath::Mx(NId+1, MxNId());
   }
+  ReserveNodeH();
   NodeH.AddDat(NId, TNode(NId));
   return NId;
 }
@@ -20,6 +21,7 @@ int TUNGraph::AddNode(int NId) {
 int TUNGraph::AddNodeUnchecked(int NId) {
   if (IsNode(NId)) { return -1;}
   MxNId = TMath::Mx(NId+1, MxNId());
+  ReserveNodeH();
   NodeH.AddDat(NId, TNode(NId));
   return NId;
 }
@@ -34,13 +36,14 @@ int TUNGraph::AddNode(const int& NId, const TIntV& NbrNIdV) {
     NewNId = NId;
     MxNId = TMath::Mx(NewNId+1, MxNId());
   }
+  ReserveNodeH();
   TNode& Node = NodeH.AddDat(NewNId);
   Node.Id = NewNId;
-  Node.NIdV = NbrNIdV;
+  if (UseArena) { NIdArena.AddV(Node.NIdV, NbrNIdV); } else { Node.NIdV = NbrNIdV; }
   Node.NIdV.Sort();
   NEdges += Node.GetDeg();
   for (int i = 0; i < NbrNIdV.Len(); i++) {
-    GetNode(NbrNIdV[i]).NIdV.AddSorted(NewNId);
+    AddNIdSorted(GetNode(NbrNIdV[i]).NIdV, NewNId);
   }
   return NewNId;
 }
@@ -55,9 +58,15 @@ int TUNGraph::AddNode(const int& NId, const TVecPool<TInt>& Pool, const int& NId
     NewNId = NId;
     MxNId = TMath::Mx(NewNId+1, MxNId()); 
   }
+  ReserveNodeH();
   TNode& Node = NodeH.AddDat(NewNId);
   Node.Id = NewNId;
-  Node.NIdV.GenExt(Pool.GetValVPt(NIdVId), Pool.GetVLen(NIdVId));
+  if (UseArena) { // the arena keeps a copy of the pool vector
+    TIntV NbrNIdV;  Pool.GetV(NIdVId, NbrNIdV);
+    NIdArena.AddV(Node.NIdV, NbrNIdV);
+  } else {
+    Node.NIdV.GenExt(Pool.GetValVPt(NIdVId), Pool.GetVLen(NIdVId));
+  }
   Node.NIdV.Sort();
   NEdges += Node.GetDeg();
   return NewNId;
@@ -74,8 +83,9 @@ void TUNGraph::DelNode(const int& NId) {
     TNode& N = GetNode(nbr);
     const int n = N.NIdV.SearchBin(NId);
     IAssert(n != -1); // if NId points to N, then N also should point back
-    if (n!= -1) { N.NIdV.Del(n); }
-  } }
+    if (n!= -1) { DelNIdN(N.NIdV, n); }
+  }
+  ClrNIdV(Node.NIdV); }
   NodeH.DelKey(NId);
 }
 
@@ -92,18 +102,18 @@ int TUNGraph::GetEdges() const {
 int TUNGraph::AddEdge(const int& SrcNId, const int& DstNId) {
   IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
   if (IsEdge(SrcNId, DstNId)) { return -2; } // edge already exists
-  GetNode(SrcNId).NIdV.AddSorted(DstNId);
+  AddNIdSorted(GetNode(SrcNId).NIdV, DstNId);
   if (SrcNId!=DstNId) { // not a self edge
-    GetNode(DstNId).NIdV.AddSorted(SrcNId); }
+    AddNIdSorted(GetNode(DstNId).NIdV, SrcNId); }
   NEdges++;
   return -1; // no edge id
 }
 
 // Add an edge between SrcNId and DstNId to the graph.
 int TUNGraph::AddEdgeUnchecked(const int& SrcNId, const int& DstNId) {
-  GetNode(SrcNId).NIdV.Add(DstNId);
+  AddNId(GetNode(SrcNId).NIdV, DstNId);
   if (SrcNId!=DstNId) { // not a self edge
-    GetNode(DstNId).NIdV.Add(SrcNId); }
+    AddNId(GetNode(DstNId).NIdV, SrcNId); }
   NEdges++;
   return -1; // no edge id
 }
@@ -113,23 +123,87 @@ int TUNGraph::AddEdge2(const int& SrcNId, const int& DstNId) {
   if (! IsNode(SrcNId)) { AddNode(SrcNId); }
   if (! IsNode(DstNId)) { AddNode(DstNId); }
   if (GetNode(SrcNId).IsNbrNId(DstNId)) { return -2; } // edge already exists
-  GetNode(SrcNId).NIdV.AddSorted(DstNId);
+  AddNIdSorted(GetNode(SrcNId).NIdV, DstNId);
   if (SrcNId!=DstNId) { // not a self edge
-    GetNode(DstNId).NIdV.AddSorted(SrcNId); }
+    AddNIdSorted(GetNode(DstNId).NIdV, SrcNId); }
   NEdges++;
   return -1; // no edge id
 }
 
+// Get the key ids of the nodes of a batch of edges, missing nodes are added if AddNodes is true.
+void TUNGraph::GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV) {
+  IAssert(SrcNIdV.Len() == DstNIdV.Len());
+  SrcKeyV.Gen(SrcNIdV.Len());  DstKeyV.Gen(DstNIdV.Len());
+  for (int i = 0; i < SrcNIdV.Len(); i++) {
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    int SrcKeyId = NodeH.GetKeyId(SrcNId), DstKeyId = NodeH.GetKeyId(DstNId);
+    if (SrcKeyId == -1 || DstKeyId == -1) {
+      IAssertR(AddNodes, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+      if (SrcKeyId == -1) { AddNode(SrcNId);  SrcKeyId = NodeH.GetKeyId(SrcNId); }
+      if (! IsNode(DstNId)) { AddNode(DstNId); }
+      DstKeyId = NodeH.GetKeyId(DstNId);
+    }
+    SrcKeyV[i] = SrcKeyId;  DstKeyV[i] = DstKeyId;
+  }
+}
+
+// Add a batch of edges. The new neighbors of each node are sorted and merged with its neighbor vector in one pass.
+int TUNGraph::AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes) {
+  const int Edges = SrcNIdV.Len();
+  TIntV SrcKeyV, DstKeyV;
+  GetBatchKeyIdV(SrcNIdV, DstNIdV, AddNodes, SrcKeyV, DstKeyV);
+  // edge i is neighbor 2*i of the node SrcNId and neighbor 2*i+1 of the node DstNId,
+  // so that the first of the edges between two nodes is the new one
+  TIntV KeyV(2*Edges), NbrV(2*Edges);
+  for (int i = 0; i < Edges; i++) {
+    KeyV[2*i] = SrcKeyV[i];  NbrV[2*i] = DstNIdV[i];
+    KeyV[2*i+1] = DstKeyV[i];  NbrV[2*i+1] = SrcNIdV[i];
+  }
+  SrcKeyV.Clr();  DstKeyV.Clr();
+  TEdgeBatch Batch;
+  Batch.Gen(KeyV, NbrV, NodeH.GetMxKeyIds());
+  KeyV.Clr();  NbrV.Clr();
+  TVec<TIntV*> NIdVV(Batch.GetKeys());
+  for (int KeyN = 0; KeyN < Batch.GetKeys(); KeyN++) {
+    NIdVV[KeyN] = Batch.GetVals(KeyN) > 0 ? &NodeH[KeyN].NIdV : NULL; }
+  TBoolV NewV;
+  Batch.Merge(NIdVV, NewV);
+  TIntV MergedV;
+  for (int KeyN = 0; KeyN < Batch.GetKeys(); KeyN++) {
+    if (Batch.GetVals(KeyN) == 0) { continue; }
+    Batch.GetMergedV(KeyN, MergedV);
+    SetNIdV(NodeH[KeyN].NIdV, MergedV);
+  }
+  int NewEdges = 0;
+  for (int i = 0; i < Edges; i++) {
+    if (NewV[2*i]) { NewEdges++; } }
+  NEdges += NewEdges;
+  return NewEdges;
+}
+
+int TUNGraph::AddEdgeBatch(const TIntPrV& EdgeV, const bool& AddNodes) {
+  TIntV SrcNIdV(EdgeV.Len()), DstNIdV(EdgeV.Len());
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    SrcNIdV[i] = EdgeV[i].Val1;  DstNIdV[i] = EdgeV[i].Val2; }
+  return AddEdgeBatch(SrcNIdV, DstNIdV, AddNodes);
+}
+
+int TUNGraph::AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& AddNodes) {
+  TIntV SrcNIdV, DstNIdV;
+  SrcNIdV.GenExt((TInt*) SrcNIdT, Edges);  DstNIdV.GenExt((TInt*) DstNIdT, Edges);
+  return AddEdgeBatch(SrcNIdV, DstNIdV, AddNodes);
+}
+
 // Delete an edge between node IDs SrcNId and DstNId from the graph.
 void TUNGraph::DelEdge(const int& SrcNId, const int& DstNId) {
   IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
   { TNode& N = GetNode(SrcNId);
   const int n = N.NIdV.SearchBin(DstNId);
-  if (n!= -1) { N.NIdV.Del(n);  NEdges--; } }
+  if (n!= -1) { DelNIdN(N.NIdV, n);  NEdges--; } }
   if (SrcNId != DstNId) { // not a self edge
     TNode& N = GetNode(DstNId);
     const int n = N.NIdV.SearchBin(SrcNId);
-    if (n!= -1) { N.NIdV.Del(n); }
+    if (n!= -1) { DelNIdN(N.NIdV, n); }
   }
 }
 
@@ -158,12 +232,46 @@ void TUNGraph::GetNIdV(TIntV& NIdV) const {
 
 // Defragment the graph.
 void TUNGraph::Defrag(const bool& OnlyNodeLinks) {
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) {
+    MoveNodeH(NodeH.Len());
+  }
+  if (UseArena) {
+    // the blocks of the vectors slide to the front of the arena
+    TVec<TIntV*> NIdVV(NodeH.Len(), 0);
+    for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+      NIdVV.Add(&NodeH[n].NIdV); }
+    NIdArena.Defrag(NIdVV);
+  } else {
+    for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+      NodeH[n].NIdV.Pack(); }
+  }
+}
+
+// Keep the adjacency vectors in the arena or in a heap allocation per node.
+void TUNGraph::SetArena(const bool& _UseArena) {
+  if (UseArena() == _UseArena) { return; }
+  // external vectors (in the arena or in a vector pool) are copied first
   for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
-    NodeH[n].NIdV.Pack();
+    if (NodeH[n].NIdV.IsExt()) {
+      TIntV NIdV(NodeH[n].NIdV);
+      NodeH[n].NIdV.Swap(NIdV);
+    }
   }
-  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) {
-    NodeH.Defrag();
+  NIdArena.Clr();
+  UseArena = _UseArena;
+  if (UseArena) { Defrag(true); }
+}
+
+// Move the nodes to a node hash table of MxNodes nodes without copying their adjacency vectors.
+void TUNGraph::MoveNodeH(const int& MxNodes) {
+  TNodeH NewNodeH(MxNodes);
+  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+    TNode& Node = NodeH[n];
+    TNode& NewNode = NewNodeH.AddDat(NodeH.GetKey(n));
+    NewNode.Id = Node.Id;
+    NewNode.NIdV.Swap(Node.NIdV);
   }
+  NodeH.Swap(NewNodeH);
 }
 
 // Check the graph data structure for internal consistency.
@@ -240,6 +348,7 @@ int TNGraph::AddNode(int NId) {
     IAssertR(!IsNode(NId), TStr::Fmt("NodeId %d already exists", NId));
     MxNId = TMath::Mx(NId+1, MxNId());
   }
+  ReserveNodeH();
   NodeH.AddDat(NId, TNode(NId));
   return NId;
 }
@@ -247,6 +356,7 @@ int TNGraph::AddNode(int NId) {
 int TNGraph::AddNodeUnchecked(int NId) {
   if (IsNode(NId)) { return NId;}
   MxNId = TMath::Mx(NId+1, MxNId());
+  ReserveNodeH();
   NodeH.AddDat(NId, TNode(NId));
   return NId;
 }
@@ -262,10 +372,14 @@ int TNGraph::AddNode(const int& NId, const TIntV& InNIdV, const TIntV& OutNIdV)
     NewNId = NId;
     MxNId = TMath::Mx(NewNId+1, MxNId());
   }
+  ReserveNodeH();
   TNode& Node = NodeH.AddDat(NewNId);
   Node.Id = NewNId;
-  Node.InNIdV = InNIdV;
-  Node.OutNIdV = OutNIdV;
+  if (UseArena) {
+    NIdArena.AddV(Node.InNIdV, InNIdV);  NIdArena.AddV(Node.OutNIdV, OutNIdV);
+  } else {
+    Node.InNIdV = InNIdV;  Node.OutNIdV = OutNIdV;
+  }
   Node.InNIdV.Sort();
   Node.OutNIdV.Sort();
   return NewNId;
@@ -282,10 +396,17 @@ int TNGraph::AddNode(const int& NId, const TVecPool<TInt>& Pool, const int& SrcV
     NewNId = NId;
     MxNId = TMath::Mx(NewNId+1, MxNId());
   }
+  ReserveNodeH();
   TNode& Node = NodeH.AddDat(NewNId);
   Node.Id = NewNId;
-  Node.InNIdV.GenExt(Pool.GetValVPt(SrcVId), Pool.GetVLen(SrcVId));
-  Node.OutNIdV.GenExt(Pool.GetValVPt(DstVId), Pool.GetVLen(DstVId));
+  if (UseArena) { // the arena keeps copies of the pool vectors
+    TIntV NbrNIdV;
+    Pool.GetV(SrcVId, NbrNIdV);  NIdArena.AddV(Node.InNIdV, NbrNIdV);
+    Pool.GetV(DstVId, NbrNIdV);  NIdArena.AddV(Node.OutNIdV, NbrNIdV);
+  } else {
+    Node.InNIdV.GenExt(Pool.GetValVPt(SrcVId), Pool.GetVLen(SrcVId));
+    Node.OutNIdV.GenExt(Pool.GetValVPt(DstVId), Pool.GetVLen(DstVId));
+  }
   Node.InNIdV.Sort();
   Node.OutNIdV.Sort();
   return NewNId;
@@ -298,15 +419,16 @@ void TNGraph::DelNode(const int& NId) {
   if (nbr == NId) { continue; }
     TNode& N = GetNode(nbr);
     const int n = N.InNIdV.SearchBin(NId);
-    if (n!= -1) { N.InNIdV.Del(n); }
+    if (n!= -1) { DelNIdN(N.InNIdV, n); }
   }
   for (int e = 0; e < Node.GetInDeg(); e++) {
   const int nbr = Node.GetInNId(e);
   if (nbr == NId) { continue; }
     TNode& N = GetNode(nbr);
     const int n = N.OutNIdV.SearchBin(NId);
-    if (n!= -1) { N.OutNIdV.Del(n); }
-  } }
+    if (n!= -1) { DelNIdN(N.OutNIdV, n); }
+  }
+  ClrNIdV(Node.InNIdV);  ClrNIdV(Node.OutNIdV); }
   NodeH.DelKey(NId);
 }
 
@@ -322,14 +444,14 @@ int TNGraph::AddEdge(const int& SrcNId, const int& DstNId) {
   IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
   //IAssert(! IsEdge(SrcNId, DstNId));
   if (IsEdge(SrcNId, DstNId)) { return -2; }
-  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
-  GetNode(DstNId).InNIdV.AddSorted(SrcNId);
+  AddNIdSorted(GetNode(SrcNId).OutNIdV, DstNId);
+  AddNIdSorted(GetNode(DstNId).InNIdV, SrcNId);
   return -1; // no edge id
 }
 
 int TNGraph::AddEdgeUnchecked(const int& SrcNId, const int& DstNId) {
-  GetNode(SrcNId).OutNIdV.Add(DstNId);
-  GetNode(DstNId).InNIdV.Add(SrcNId);
+  AddNId(GetNode(SrcNId).OutNIdV, DstNId);
+  AddNId(GetNode(DstNId).InNIdV, SrcNId);
   return -1; // no edge id
 }
 
@@ -337,26 +459,89 @@ int TNGraph::AddEdge2(const int& SrcNId, const int& DstNId) {
   if (! IsNode(SrcNId)) { AddNode(SrcNId); }
   if (! IsNode(DstNId)) { AddNode(DstNId); }
   if (GetNode(SrcNId).IsOutNId(DstNId)) { return -2; } // edge already exists
-  GetNode(SrcNId).OutNIdV.AddSorted(DstNId);
-  GetNode(DstNId).InNIdV.AddSorted(SrcNId);
+  AddNIdSorted(GetNode(SrcNId).OutNIdV, DstNId);
+  AddNIdSorted(GetNode(DstNId).InNIdV, SrcNId);
   return -1; // no edge id
 }
 
+// Get the key ids of the nodes of a batch of edges, missing nodes are added if AddNodes is true.
+void TNGraph::GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV) {
+  IAssert(SrcNIdV.Len() == DstNIdV.Len());
+  SrcKeyV.Gen(SrcNIdV.Len());  DstKeyV.Gen(DstNIdV.Len());
+  for (int i = 0; i < SrcNIdV.Len(); i++) {
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    int SrcKeyId = NodeH.GetKeyId(SrcNId), DstKeyId = NodeH.GetKeyId(DstNId);
+    if (SrcKeyId == -1 || DstKeyId == -1) {
+      IAssertR(AddNodes, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+      if (SrcKeyId == -1) { AddNode(SrcNId);  SrcKeyId = NodeH.GetKeyId(SrcNId); }
+      if (! IsNode(DstNId)) { AddNode(DstNId); }
+      DstKeyId = NodeH.GetKeyId(DstNId);
+    }
+    SrcKeyV[i] = SrcKeyId;  DstKeyV[i] = DstKeyId;
+  }
+}
+
+// Add a batch of edges. The new neighbors of each node are sorted and merged with its neighbor vectors in one pass.
+int TNGraph::AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes) {
+  const int Edges = SrcNIdV.Len();
+  TIntV SrcKeyV, DstKeyV;
+  GetBatchKeyIdV(SrcNIdV, DstNIdV, AddNodes, SrcKeyV, DstKeyV);
+  int NewEdges = 0;
+  TVec<TIntV*> NIdVV(NodeH.GetMxKeyIds());
+  TBoolV NewV;
+  TIntV MergedV;
+  // the out-neighbors, then the in-neighbors
+  for (int Dir = 0; Dir < 2; Dir++) {
+    const bool IsOut = Dir == 0;
+    TEdgeBatch Batch;
+    if (IsOut) { Batch.Gen(SrcKeyV, DstNIdV, NodeH.GetMxKeyIds()); }
+    else { Batch.Gen(DstKeyV, SrcNIdV, NodeH.GetMxKeyIds()); }
+    for (int KeyN = 0; KeyN < Batch.GetKeys(); KeyN++) {
+      NIdVV[KeyN] = NULL;
+      if (Batch.GetVals(KeyN) > 0) { NIdVV[KeyN] = IsOut ? &NodeH[KeyN].OutNIdV : &NodeH[KeyN].InNIdV; }
+    }
+    Batch.Merge(NIdVV, NewV);
+    for (int KeyN = 0; KeyN < Batch.GetKeys(); KeyN++) {
+      if (Batch.GetVals(KeyN) == 0) { continue; }
+      Batch.GetMergedV(KeyN, MergedV);
+      SetNIdV(*NIdVV[KeyN], MergedV);
+    }
+    if (IsOut) {
+      for (int i = 0; i < Edges; i++) {
+        if (NewV[i]) { NewEdges++; } }
+    }
+  }
+  return NewEdges;
+}
+
+int TNGraph::AddEdgeBatch(const TIntPrV& EdgeV, const bool& AddNodes) {
+  TIntV SrcNIdV(EdgeV.Len()), DstNIdV(EdgeV.Len());
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    SrcNIdV[i] = EdgeV[i].Val1;  DstNIdV[i] = EdgeV[i].Val2; }
+  return AddEdgeBatch(SrcNIdV, DstNIdV, AddNodes);
+}
+
+int TNGraph::AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& AddNodes) {
+  TIntV SrcNIdV, DstNIdV;
+  SrcNIdV.GenExt((TInt*) SrcNIdT, Edges);  DstNIdV.GenExt((TInt*) DstNIdT, Edges);
+  return AddEdgeBatch(SrcNIdV, DstNIdV, AddNodes);
+}
+
 void TNGraph::DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir) {
   IAssertR(IsNode(SrcNId) && IsNode(DstNId), TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
   { TNode& N = GetNode(SrcNId);
   const int n = N.OutNIdV.SearchBin(DstNId);
-  if (n!= -1) { N.OutNIdV.Del(n); } }
+  if (n!= -1) { DelNIdN(N.OutNIdV, n); } }
   { TNode& N = GetNode(DstNId);
   const int n = N.InNIdV.SearchBin(SrcNId);
-  if (n!= -1) { N.InNIdV.Del(n); } }
+  if (n!= -1) { DelNIdN(N.InNIdV, n); } }
   if (! IsDir) {
     { TNode& N = GetNode(SrcNId);
     const int n = N.InNIdV.SearchBin(DstNId);
-    if (n!= -1) { N.InNIdV.Del(n); } }
+    if (n!= -1) { DelNIdN(N.InNIdV, n); } }
     { TNode& N = GetNode(DstNId);
     const int n = N.OutNIdV.SearchBin(SrcNId);
-    if (n!= -1) { N.OutNIdV.Del(n); } }
+    if (n!= -1) { DelNIdN(N.OutNIdV, n); } }
   }
 }
 
@@ -380,11 +565,47 @@ void TNGraph::GetNIdV(TIntV& NIdV) const {
 }
 
 void TNGraph::Defrag(const bool& OnlyNodeLinks) {
+  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) { MoveNodeH(NodeH.Len()); }
+  if (UseArena) {
+    // the blocks of the vectors slide to the front of the arena
+    TVec<TIntV*> NIdVV(2*NodeH.Len(), 0);
+    for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+      TNode& Node = NodeH[n];
+      NIdVV.Add(&Node.InNIdV);  NIdVV.Add(&Node.OutNIdV);
+    }
+    NIdArena.Defrag(NIdVV);
+  } else {
+    for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+      TNode& Node = NodeH[n];
+      Node.InNIdV.Pack();  Node.OutNIdV.Pack();
+    }
+  }
+}
+
+void TNGraph::SetArena(const bool& _UseArena) {
+  if (UseArena() == _UseArena) { return; }
+  // external vectors (in the arena or in a vector pool) are copied first
   for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
     TNode& Node = NodeH[n];
-    Node.InNIdV.Pack();  Node.OutNIdV.Pack();
+    if (Node.InNIdV.IsExt()) { TIntV InNIdV(Node.InNIdV);  Node.InNIdV.Swap(InNIdV); }
+    if (Node.OutNIdV.IsExt()) { TIntV OutNIdV(Node.OutNIdV);  Node.OutNIdV.Swap(OutNIdV); }
   }
-  if (! OnlyNodeLinks && ! NodeH.IsKeyIdEqKeyN()) { NodeH.Defrag(); }
+  NIdArena.Clr();
+  UseArena = _UseArena;
+  if (UseArena) { Defrag(true); }
+}
+
+// move the nodes to a node hash table of MxNodes nodes without copying their adjacency vectors
+void TNGraph::MoveNodeH(const int& MxNodes) {
+  TNodeH NewNodeH(MxNodes);
+  for (int n = NodeH.FFirstKeyId(); NodeH.FNextKeyId(n); ) {
+    TNode& Node = NodeH[n];
+    TNode& NewNode = NewNodeH.AddDat(NodeH.GetKey(n));
+    NewNode.Id = Node.Id;
+    NewNode.InNIdV.Swap(Node.InNIdV);
+    NewNode.OutNIdV.Swap(Node.OutNIdV);
+  }
+  NodeH.Swap(NewNodeH);
 }
 
 // for each node check that their neighbors are also nodes
@@ -524,6 +745,77 @@ int TNEGraph::AddEdge(const int& SrcNId, const int& DstNId, int EId) {
   return EId;
 }
 
+// Get the key ids of the nodes of a batch of edges, missing nodes are added if AddNodes is true.
+void TNEGraph::GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV) {
+  IAssert(SrcNIdV.Len() == DstNIdV.Len());
+  SrcKeyV.Gen(SrcNIdV.Len());  DstKeyV.Gen(DstNIdV.Len());
+  for (int i = 0; i < SrcNIdV.Len(); i++) {
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    int SrcKeyId = NodeH.GetKeyId(SrcNId), DstKeyId = NodeH.GetKeyId(DstNId);
+    if (SrcKeyId == -1 || DstKeyId == -1) {
+      IAssertR(AddNodes, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+      if (SrcKeyId == -1) { AddNode(SrcNId);  SrcKeyId = NodeH.GetKeyId(SrcNId); }
+      if (! IsNode(DstNId)) { AddNode(DstNId); }
+      DstKeyId = NodeH.GetKeyId(DstNId);
+    }
+    SrcKeyV[i] = SrcKeyId;  DstKeyV[i] = DstKeyId;
+  }
+}
+
+// Add a batch of edges. With Dedup the edges that are in the graph or earlier in the batch are found by
+// grouping the batch by source node and merging each group with the sorted destinations of the node.
+int TNEGraph::AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& Dedup, const bool& AddNodes) {
+  const int Edges = SrcNIdV.Len();
+  TBoolV NewV;
+  if (Dedup) {
+    TIntV SrcKeyV, DstKeyV;
+    GetBatchKeyIdV(SrcNIdV, DstNIdV, AddNodes, SrcKeyV, DstKeyV);
+    TEdgeBatch Batch;
+    Batch.Gen(SrcKeyV, DstNIdV, NodeH.GetMxKeyIds());
+    TVec<TIntV> DstNIdVV(Batch.GetKeys());
+    TVec<TIntV*> DstNIdVPtV(Batch.GetKeys());
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+    for (int KeyN = 0; KeyN < Batch.GetKeys(); KeyN++) {
+      DstNIdVPtV[KeyN] = &DstNIdVV[KeyN];
+      if (Batch.GetVals(KeyN) == 0) { continue; }
+      const TNode& Node = NodeH[KeyN];
+      DstNIdVV[KeyN].Gen(Node.GetOutDeg(), 0);
+      for (int e = 0; e < Node.GetOutDeg(); e++) {
+        DstNIdVV[KeyN].Add(GetEdge(Node.GetOutEId(e)).GetDstNId()); }
+      DstNIdVV[KeyN].Sort();
+    }
+    Batch.Merge(DstNIdVPtV, NewV, false);
+  }
+  int NewEdges = 0;
+  for (int i = 0; i < Edges; i++) {
+    if (Dedup && ! NewV[i]) { continue; }
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    if (! Dedup && (! IsNode(SrcNId) || ! IsNode(DstNId))) {
+      IAssertR(AddNodes, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+      if (! IsNode(SrcNId)) { AddNode(SrcNId); }
+      if (! IsNode(DstNId)) { AddNode(DstNId); }
+    }
+    AddEdge(SrcNId, DstNId);
+    NewEdges++;
+  }
+  return NewEdges;
+}
+
+int TNEGraph::AddEdgeBatch(const TIntPrV& EdgeV, const bool& Dedup, const bool& AddNodes) {
+  TIntV SrcNIdV(EdgeV.Len()), DstNIdV(EdgeV.Len());
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    SrcNIdV[i] = EdgeV[i].Val1;  DstNIdV[i] = EdgeV[i].Val2; }
+  return AddEdgeBatch(SrcNIdV, DstNIdV, Dedup, AddNodes);
+}
+
+int TNEGraph::AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& Dedup, const bool& AddNodes) {
+  TIntV SrcNIdV, DstNIdV;
+  SrcNIdV.GenExt((TInt*) SrcNIdT, Edges);  DstNIdV.GenExt((TInt*) DstNIdT, Edges);
+  return AddEdgeBatch(SrcNIdV, DstNIdV, Dedup, AddNodes);
+}
+
 void TNEGraph::DelEdge(const int& EId) {
   IAssert(IsEdge(EId));
   const int SrcNId = GetEdge(EId).GetSrcNId();
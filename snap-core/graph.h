@@ -61,10 +61,12 @@ public:
     friend class TUNGraph;
     friend class TUNGraphMtx;
   };
+  /// Container of the nodes. THashFlat<TInt, TNode> is a drop-in replacement with the same iterators and file format.
+  typedef THash<TInt, TNode> TNodeH;
   /// Node iterator. Only forward iteration (operator++) is supported.
   class TNodeI {
   private:
-    typedef THash<TInt, TNode>::TIter THashIter;
+    typedef TNodeH::TIter THashIter;
     THashIter NodeHI;
   public:
     TNodeI() : NodeHI() { }
@@ -130,7 +132,9 @@ public:
 private:
   TCRef CRef;
   TInt MxNId, NEdges;
-  THash<TInt, TNode> NodeH;
+  TNodeH NodeH;
+  TBool UseArena;
+  TVecArena<TInt> NIdArena;
 private:
   class TLoadTNodeInitializer {
   public:
@@ -140,19 +144,31 @@ private:
 private:
   TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
   const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
+  void AddNId(TIntV& NIdV, const int& NId) { if (UseArena) { NIdArena.Add(NIdV, NId); } else { NIdV.Add(NId); } }
+  void AddNIdSorted(TIntV& NIdV, const int& NId) { if (UseArena) { NIdArena.AddSorted(NIdV, NId); } else { NIdV.AddSorted(NId); } }
+  void DelNIdN(TIntV& NIdV, const int& NIdN) { if (UseArena) { NIdArena.Del(NIdV, NIdN); } else { NIdV.Del(NIdN); } }
+  void ReserveNIdV(TIntV& NIdV, const int& MxVals) { if (UseArena) { NIdArena.Reserve(NIdV, MxVals); } else { NIdV.Reserve(MxVals); } }
+  void ClrNIdV(TIntV& NIdV) { if (UseArena) { NIdArena.Clr(NIdV); } else { NIdV.Clr(); } }
+  void SetNIdV(TIntV& NIdV, const TIntV& SrcV) { if (UseArena) { NIdArena.Clr(NIdV);  NIdArena.AddV(NIdV, SrcV); } else { NIdV = SrcV; } }
+  void GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV);
+  /// Makes room for one more node, so that the node hash table does not copy the adjacency vectors when it grows.
+  void ReserveNodeH() { if (NodeH.IsKeyIdEqKeyN() && NodeH.GetMxKeyIds() == NodeH.GetReservedKeyIds()) {
+    MoveNodeH(TMath::Mx(16, 2*NodeH.GetReservedKeyIds())); } }
+  void MoveNodeH(const int& MxNodes);
   void LoadGraphShM(TShMIn& ShMIn) {
+    UseArena = false;
     MxNId = TInt(ShMIn);
     NEdges = TInt(ShMIn);
     TLoadTNodeInitializer Fn;
     NodeH.LoadShM(ShMIn, Fn);
   }
 public:
-  TUNGraph() : CRef(), MxNId(0), NEdges(0), NodeH() { }
+  TUNGraph() : CRef(), MxNId(0), NEdges(0), NodeH(), UseArena(true), NIdArena() { }
   /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
-  explicit TUNGraph(const int& Nodes, const int& Edges) : MxNId(0), NEdges(0) { Reserve(Nodes, Edges); }
-  TUNGraph(const TUNGraph& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH) { }
+  explicit TUNGraph(const int& Nodes, const int& Edges) : MxNId(0), NEdges(0), UseArena(true) { Reserve(Nodes, Edges); }
+  TUNGraph(const TUNGraph& Graph) : MxNId(Graph.MxNId), NEdges(Graph.NEdges), NodeH(Graph.NodeH), UseArena(Graph.UseArena) { }
   /// Constructor that loads the graph from a (binary) stream SIn.
-  TUNGraph(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NodeH(SIn) { }
+  TUNGraph(TSIn& SIn) : MxNId(SIn), NEdges(SIn), NodeH(SIn), UseArena(true) { }
   /// Saves the graph to a (binary) stream SOut.
 
   void Save(TSOut& SOut) const { MxNId.Save(SOut); NEdges.Save(SOut); NodeH.Save(SOut); SOut.Flush(); }
@@ -170,7 +186,7 @@ public:
   }  /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
   bool HasFlag(const TGraphFlag& Flag) const;
   TUNGraph& operator = (const TUNGraph& Graph) {
-    if (this!=&Graph) { MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; } return *this; }
+    if (this!=&Graph) { MxNId=Graph.MxNId; NEdges=Graph.NEdges; NodeH=Graph.NodeH; NIdArena.Clr(); } return *this; }
   
   /// Returns the number of nodes in the graph.
   int GetNodes() const { return NodeH.Len(); }
@@ -211,6 +227,12 @@ public:
   int AddEdge2(const int& SrcNId, const int& DstNId);
   /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId()); }
+  /// Adds the edges of EdgeV that are not in the graph yet and returns the number of edges added. ##TUNGraph::AddEdgeBatch
+  int AddEdgeBatch(const TIntPrV& EdgeV, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdV[i], DstNIdV[i]) that are not in the graph yet and returns the number of edges added.
+  int AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdT[i], DstNIdT[i]) for i < Edges that are not in the graph yet and returns the number of edges added.
+  int AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& AddNodes=true);
   /// Deletes an edge between node IDs SrcNId and DstNId from the graph. ##TUNGraph::DelEdge
   void DelEdge(const int& SrcNId, const int& DstNId);
   /// Tests whether an edge between node IDs SrcNId and DstNId exists in the graph.
@@ -236,15 +258,20 @@ public:
   /// Tests whether the graph is empty (has zero nodes).
   bool Empty() const { return GetNodes()==0; }
   /// Deletes all nodes and edges from the graph.
-  void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); }
+  void Clr() { MxNId=0; NEdges=0; NodeH.Clr(); NIdArena.Clr(); }
   /// Sorts the adjacency lists of each node
   void SortNodeAdjV() { for (TNodeI NI = BegNI(); NI < EndNI(); NI++) { NI.SortNIdV();} }
   /// Reserves memory for a graph of Nodes nodes and Edges edges.
-  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) NodeH.Gen(Nodes/2); }
+  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); NIdArena.Clr(); } }
   /// Reserves memory for node ID NId having Deg edges.
-  void ReserveNIdDeg(const int& NId, const int& Deg) { GetNode(NId).NIdV.Reserve(Deg); }
+  void ReserveNIdDeg(const int& NId, const int& Deg) { ReserveNIdV(GetNode(NId).NIdV, Deg); }
   /// Defragments the graph. ##TUNGraph::Defrag
   void Defrag(const bool& OnlyNodeLinks=false);
+  /// Tests whether the adjacency vectors of the nodes are kept in an arena of large chunks.
+  bool IsArena() const { return UseArena; }
+  /// Keeps the adjacency vectors in an arena of large chunks (the default) or in one heap allocation per node.
+  /// Graphs loaded from shared memory do not use the arena.
+  void SetArena(const bool& _UseArena);
   /// Checks the graph data structure for internal consistency. ##TUNGraph::IsOk
   bool IsOk(const bool& ThrowExcept=true) const;
   /// Print the graph in a human readable form to an output stream OutF.
@@ -294,10 +321,12 @@ public:
     friend class TNGraph;
     friend class TNGraphMtx;
   };
+  /// Container of the nodes. THashFlat<TInt, TNode> is a drop-in replacement with the same iterators and file format.
+  typedef THash<TInt, TNode> TNodeH;
   /// Node iterator. Only forward iteration (operator++) is supported.
   class TNodeI {
   private:
-    typedef THash<TInt, TNode>::TIter THashIter;
+    typedef TNodeH::TIter THashIter;
     THashIter NodeHI;
   public:
     TNodeI() : NodeHI() { }
@@ -361,7 +390,9 @@ public:
 private:
   TCRef CRef;
   TInt MxNId;
-  THash<TInt, TNode> NodeH;
+  TNodeH NodeH;
+  TBool UseArena;
+  TVecArena<TInt> NIdArena;
 private:
   class TLoadTNodeInitializer {
   public:
@@ -371,19 +402,31 @@ private:
 private:
   TNode& GetNode(const int& NId) { return NodeH.GetDat(NId); }
   const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
+  void AddNId(TIntV& NIdV, const int& NId) { if (UseArena) { NIdArena.Add(NIdV, NId); } else { NIdV.Add(NId); } }
+  void AddNIdSorted(TIntV& NIdV, const int& NId) { if (UseArena) { NIdArena.AddSorted(NIdV, NId); } else { NIdV.AddSorted(NId); } }
+  void DelNIdN(TIntV& NIdV, const int& NIdN) { if (UseArena) { NIdArena.Del(NIdV, NIdN); } else { NIdV.Del(NIdN); } }
+  void ReserveNIdV(TIntV& NIdV, const int& MxVals) { if (UseArena) { NIdArena.Reserve(NIdV, MxVals); } else { NIdV.Reserve(MxVals); } }
+  void ClrNIdV(TIntV& NIdV) { if (UseArena) { NIdArena.Clr(NIdV); } else { NIdV.Clr(); } }
+  void SetNIdV(TIntV& NIdV, const TIntV& SrcV) { if (UseArena) { NIdArena.Clr(NIdV);  NIdArena.AddV(NIdV, SrcV); } else { NIdV = SrcV; } }
+  void GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV);
+  /// Makes room for one more node, so that the node hash table does not copy the adjacency vectors when it grows.
+  void ReserveNodeH() { if (NodeH.IsKeyIdEqKeyN() && NodeH.GetMxKeyIds() == NodeH.GetReservedKeyIds()) {
+    MoveNodeH(TMath::Mx(16, 2*NodeH.GetReservedKeyIds())); } }
+  void MoveNodeH(const int& MxNodes);
   void LoadGraphShM(TShMIn& ShMIn) {
+    UseArena = false;
     MxNId = TInt(ShMIn);
     TLoadTNodeInitializer Fn;
     NodeH.LoadShM(ShMIn, Fn);
   }
 
 public:
-  TNGraph() : CRef(), MxNId(0), NodeH() { }
+  TNGraph() : CRef(), MxNId(0), NodeH(), UseArena(true), NIdArena() { }
   /// Constructor that reserves enough memory for a graph of Nodes nodes and Edges edges.
-  explicit TNGraph(const int& Nodes, const int& Edges) : MxNId(0) { Reserve(Nodes, Edges); }
-  TNGraph(const TNGraph& Graph) : MxNId(Graph.MxNId), NodeH(Graph.NodeH) { }
+  explicit TNGraph(const int& Nodes, const int& Edges) : MxNId(0), UseArena(true) { Reserve(Nodes, Edges); }
+  TNGraph(const TNGraph& Graph) : MxNId(Graph.MxNId), NodeH(Graph.NodeH), UseArena(Graph.UseArena) { }
   /// Constructor that loads the graph from a (binary) stream SIn.
-  TNGraph(TSIn& SIn) : MxNId(SIn), NodeH(SIn) { }
+  TNGraph(TSIn& SIn) : MxNId(SIn), NodeH(SIn), UseArena(true) { }
   /// Saves the graph to a (binary) stream SOut.
   void Save(TSOut& SOut) const { MxNId.Save(SOut); NodeH.Save(SOut); SOut.Flush(); }
   /// Static constructor that returns a pointer to the graph. Call: PNGraph Graph = TNGraph::New().
@@ -401,7 +444,7 @@ public:
   /// Allows for run-time checking the type of the graph (see the TGraphFlag for flags).
   bool HasFlag(const TGraphFlag& Flag) const;
   TNGraph& operator = (const TNGraph& Graph) {
-    if (this!=&Graph) { MxNId=Graph.MxNId; NodeH=Graph.NodeH; }  return *this; }
+    if (this!=&Graph) { MxNId=Graph.MxNId; NodeH=Graph.NodeH; NIdArena.Clr(); }  return *this; }
   
   /// Returns the number of nodes in the graph.
   int GetNodes() const { return NodeH.Len(); }
@@ -444,6 +487,12 @@ public:
   int AddEdge2(const int& SrcNId, const int& DstNId);
   /// Adds an edge from EdgeI.GetSrcNId() to EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId()); }
+  /// Adds the edges of EdgeV that are not in the graph yet and returns the number of edges added. ##TNGraph::AddEdgeBatch
+  int AddEdgeBatch(const TIntPrV& EdgeV, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdV[i], DstNIdV[i]) that are not in the graph yet and returns the number of edges added.
+  int AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdT[i], DstNIdT[i]) for i < Edges that are not in the graph yet and returns the number of edges added.
+  int AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& AddNodes=true);
   /// Deletes an edge from node IDs SrcNId to DstNId from the graph. ##TNGraph::DelEdge
   void DelEdge(const int& SrcNId, const int& DstNId, const bool& IsDir = true);
   /// Tests whether an edge from node IDs SrcNId to DstNId exists in the graph.
@@ -469,17 +518,22 @@ public:
   /// Tests whether the graph is empty (has zero nodes).
   bool Empty() const { return GetNodes()==0; }
   /// Deletes all nodes and edges from the graph.
-  void Clr() { MxNId=0; NodeH.Clr(); }
+  void Clr() { MxNId=0; NodeH.Clr(); NIdArena.Clr(); }
   /// Reserves memory for a graph of Nodes nodes and Edges edges.
-  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); } }
+  void Reserve(const int& Nodes, const int& Edges) { if (Nodes>0) { NodeH.Gen(Nodes/2); NIdArena.Clr(); } }
   /// Reserves memory for node ID NId having InDeg in-edges.
-  void ReserveNIdInDeg(const int& NId, const int& InDeg) { GetNode(NId).InNIdV.Reserve(InDeg); }
+  void ReserveNIdInDeg(const int& NId, const int& InDeg) { ReserveNIdV(GetNode(NId).InNIdV, InDeg); }
   /// Reserves memory for node ID NId having OutDeg out-edges.
-  void ReserveNIdOutDeg(const int& NId, const int& OutDeg) { GetNode(NId).OutNIdV.Reserve(OutDeg); }
+  void ReserveNIdOutDeg(const int& NId, const int& OutDeg) { ReserveNIdV(GetNode(NId).OutNIdV, OutDeg); }
   /// Sorts the adjacency lists of each node
   void SortNodeAdjV() { for (TNodeI NI = BegNI(); NI < EndNI(); NI++) { NI.SortNIdV();} }
   /// Defragments the graph. ##TNGraph::Defrag
   void Defrag(const bool& OnlyNodeLinks=false);
+  /// Tests whether the adjacency vectors of the nodes are kept in an arena of large chunks.
+  bool IsArena() const { return UseArena; }
+  /// Keeps the adjacency vectors in an arena of large chunks (the default) or in one heap allocation per node.
+  /// Graphs loaded from shared memory do not use the arena.
+  void SetArena(const bool& _UseArena);
   /// Checks the graph data structure for internal consistency. ##TNGraph::IsOk
   bool IsOk(const bool& ThrowExcept=true) const;
   /// Print the graph in a human readable form to an output stream OutF.
@@ -620,6 +674,7 @@ private:
   const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
   TEdge& GetEdge(const int& EId) { return EdgeH.GetDat(EId); }
   const TEdge& GetEdge(const int& EId) const { return EdgeH.GetDat(EId); }
+  void GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV);
 private:
   TCRef CRef;
   TInt MxNId, MxEId;
@@ -672,6 +727,12 @@ public:
   int AddEdge(const int& SrcNId, const int& DstNId, int EId  = -1);
   /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId(), EdgeI.GetId()); }
+  /// Adds the edges of EdgeV and returns the number of edges added. ##TNEGraph::AddEdgeBatch
+  int AddEdgeBatch(const TIntPrV& EdgeV, const bool& Dedup=false, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdV[i], DstNIdV[i]) and returns the number of edges added.
+  int AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& Dedup=false, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdT[i], DstNIdT[i]) for i < Edges and returns the number of edges added.
+  int AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& Dedup=false, const bool& AddNodes=true);
   /// Deletes an edge with edge ID EId from the graph.
   void DelEdge(const int& EId);
   /// Deletes all edges between node IDs SrcNId and DstNId from the graph. ##TNEGraph::DelEdge
@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////
+// K-Core decomposition
+namespace TSnap {
+namespace TSnapDetail {
+
+void GetCoreV(const TVec<TInt64>& OffV, const TNIdxMap::TNbrV& NbrV, TIntV& CoreV) {
+  const int Nodes = OffV.Len() - 1;
+  int MxDeg = 0;
+  CoreV.Gen(Nodes);
+  for (int v = 0; v < Nodes; v++) {
+    CoreV[v] = int(OffV[v+1] - OffV[v]);
+    MxDeg = TMath::Mx(MxDeg, CoreV[v].Val);
+  }
+  // nodes sorted by degree in VertV, BinV[d] is the position of the first node of degree d
+  TIntV BinV(MxDeg+1), PosV(Nodes), VertV(Nodes);
+  for (int v = 0; v < Nodes; v++) { BinV[CoreV[v]] += 1; }
+  for (int d = 0, Start = 0; d <= MxDeg; d++) {
+    const int Num = BinV[d];
+    BinV[d] = Start;  Start += Num;
+  }
+  for (int v = 0; v < Nodes; v++) {
+    PosV[v] = BinV[CoreV[v]];
+    VertV[PosV[v]] = v;
+    BinV[CoreV[v]] += 1;
+  }
+  for (int d = MxDeg; d > 0; d--) { BinV[d] = BinV[d-1]; }
+  BinV[0] = 0;
+  // the node of the smallest degree is removed, its neighbors of a larger degree move one bucket down
+  for (int i = 0; i < Nodes; i++) {
+    const int v = VertV[i];
+    for (int64 e = OffV[v]; e < OffV[v+1]; e++) {
+      const int u = NbrV[e];
+      if (CoreV[u] <= CoreV[v]) { continue; }
+      const int DegU = CoreV[u], PosU = PosV[u];
+      const int PosW = BinV[DegU], w = VertV[PosW];
+      if (u != w) {
+        PosV[u] = PosW;  VertV[PosU] = w;
+        PosV[w] = PosU;  VertV[PosW] = u;
+      }
+      BinV[DegU] += 1;
+      CoreV[u] -= 1;
+    }
+  }
+}
+
+void GetCoreVMP(const TVec<TInt64>& OffV, const TNIdxMap::TNbrV& NbrV, TIntV& CoreV) {
+  const int Nodes = OffV.Len() - 1;
+  TIntV DegV(Nodes), RemV(Nodes);
+  for (int v = 0; v < Nodes; v++) {
+    DegV[v] = int(OffV[v+1] - OffV[v]);  RemV[v] = v; }
+#ifdef GCC_ATOMIC
+  TVec<TIntV> BufVV(omp_get_max_threads());
+#else
+  TVec<TIntV> BufVV(1);
+#endif
+  // level K removes all the nodes of the remaining degree K, including the ones that drop to K on the way.
+  // The remaining degree of a removed node is its core number.
+  int Level = 0;
+  while (! RemV.Empty()) {
+    const int Rems = RemV.Len();
+#ifdef GCC_ATOMIC
+    #pragma omp parallel
+#endif
+    {
+#ifdef GCC_ATOMIC
+      TIntV& BufV = BufVV[omp_get_thread_num()];
+#else
+      TIntV& BufV = BufVV[0];
+#endif
+      BufV.Clr(false);
+#ifdef GCC_ATOMIC
+      #pragma omp for schedule(static)
+#endif
+      for (int r = 0; r < Rems; r++) {
+        if (DegV[RemV[r]] == Level) { BufV.Add(RemV[r]); } }
+      for (int b = 0; b < BufV.Len(); b++) {
+        const int v = BufV[b];
+        for (int64 e = OffV[v]; e < OffV[v+1]; e++) {
+          const int u = NbrV[e];
+          if (u == v || DegV[u] <= Level) { continue; }
+#ifdef GCC_ATOMIC
+          const int OldDeg = __sync_fetch_and_sub(&DegV[u].Val, 1);
+          if (OldDeg == Level+1) { BufV.Add(u); }
+          // another thread got the degree of u to the level first
+          if (OldDeg <= Level) { __sync_fetch_and_add(&DegV[u].Val, 1); }
+#else
+          DegV[u] -= 1;
+          if (DegV[u] == Level) { BufV.Add(u); }
+#endif
+        }
+      }
+    }
+    // the next level is the smallest remaining degree
+    int NewRems = 0, MnDeg = TInt::Mx;
+    for (int r = 0; r < Rems; r++) {
+      const int v = RemV[r];
+      if (DegV[v] <= Level) { continue; }
+      RemV[NewRems++] = v;
+      MnDeg = TMath::Mn(MnDeg, DegV[v].Val);
+    }
+    RemV.Reduce(NewRems);
+    Level = MnDeg;
+  }
+  CoreV = DegV;
+}
+
+} // namespace TSnapDetail
+} // namespace TSnap
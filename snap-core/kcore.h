@@ -1,17 +1,30 @@
 // TODO ROK, Jure included basic documentation, finalize reference doc
 
+namespace TSnap {
+namespace TSnapDetail {
+/// Core numbers of nodes 0..OffV.Len()-2 whose neighbors are NbrV[OffV[i]..OffV[i+1]), with the Batagelj-Zaversnik bucket queue in linear time.
+void GetCoreV(const TVec<TInt64>& OffV, const TNIdxMap::TNbrV& NbrV, TIntV& CoreV);
+/// Core numbers with parallel level-synchronous peeling, gives the same result as GetCoreV().
+void GetCoreVMP(const TVec<TInt64>& OffV, const TNIdxMap::TNbrV& NbrV, TIntV& CoreV);
+} // namespace TSnapDetail
+} // namespace TSnap
+
 //#//////////////////////////////////////////////
 /// K-Core decomposition of a network.
 /// K-core is defined as a maximal subgraph of the original graph where every node points to at least K other nodes.
 /// K-core is obtained by repeatedly deleting nodes of degree < K from the graph until no nodes of degree < K exist.
 /// If the input graph is directed we treat it as undirected multigraph, i.e., we ignore the edge directions but there may be up to two edges between a pair of nodes.
+/// The core number of every node is computed once in the constructor, so cores of any order are then available without recomputation.
 /// See the kcores example (examples/kcores/kcores.cpp) for how to use the code.
 /// For example: for (KCore(Graph); KCore.GetNextCore()!=0; ) { } will produce a sequence of K-cores for K=1...
 template<class PGraph>
 class TKCore {
 private:
   PGraph Graph;
-  TIntH DegH;
+  TIntV AllNIdV;     // IDs of all the nodes, sorted
+  TIntV CoreV;       // core number of node AllNIdV[i]
+  TIntV CoreNodesV;  // number of nodes in the K-core, K=0...GetMxCore()
+  TIntV CoreEdgesV;  // number of edges in the K-core, K=0...GetMxCore()
   TInt CurK;
   TIntV NIdV;
 private:
@@ -32,7 +45,24 @@ public:
   /// Gets the number of nodes in the K-core (for the current value of K).
   int GetCoreNodes() const { return NIdV.Len(); }
   /// Gets the number of edges in the K-core (for the current value of K).
-  int GetCoreEdges() const;
+  int GetCoreEdges() const { return GetCoreEdges(CurK); }
+  /// Gets the number of nodes in the core of order K.
+  int GetCoreNodes(const int& K) const { return TMath::Mx(K, 0) > GetMxCore() ? 0 : CoreNodesV[TMath::Mx(K, 0)].Val; }
+  /// Gets the number of edges in the core of order K.
+  int GetCoreEdges(const int& K) const { return TMath::Mx(K, 0) > GetMxCore() ? 0 : CoreEdgesV[TMath::Mx(K, 0)].Val; }
+  /// Returns the largest K with a non-empty K-core, or -1 for an empty graph.
+  int GetMxCore() const { return CoreNodesV.Len() - 1; }
+  /// Returns the core number of node NId, the largest K such that the node is in the K-core.
+  int GetNodeCore(const int& NId) const {
+    const int NIdx = AllNIdV.SearchBin(NId);
+    IAssertR(NIdx >= 0, TStr::Fmt("NodeId %d does not exist", NId));
+    return CoreV[NIdx]; }
+  /// Returns the core numbers of all the nodes as a hash table from node IDs.
+  void GetNodeCoreH(TIntIntH& NIdCoreH) const;
+  /// Returns the IDs of all the nodes in the graph, sorted. Their core numbers are GetCoreV().
+  const TIntV& GetAllNIdV() const { return AllNIdV; }
+  /// Returns the core numbers of the nodes GetAllNIdV() as a dense vector.
+  const TIntV& GetCoreV() const { return CoreV; }
   /// Returns the IDs of the nodes in the current K-core.
   const TIntV& GetNIdV() const { return NIdV; }
   /// Returrns the graph of the current K-core.
@@ -41,60 +71,66 @@ public:
 
 template<class PGraph>
 void TKCore<PGraph>::Init() {
-  DegH.Gen(Graph->GetNodes());
+  const int Nodes = Graph->GetNodes();
+  AllNIdV.Gen(Nodes, 0);
   for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
-    //DegH.AddDat(NI.GetId(), NI.GetOutDeg());
-    DegH.AddDat(NI.GetId(), NI.GetDeg());
+    AllNIdV.Add(NI.GetId()); }
+  AllNIdV.Sort();
+  // adjacency on node indices, a neighbor appears once per edge, in both directions in directed graphs
+  TNIdxMap NIdxMap;
+  NIdxMap.Gen(AllNIdV);
+  TVec<typename PGraph::TObj::TNodeI> NIV(Nodes, 0);
+  for (int i = 0; i < Nodes; i++) { NIV.Add(Graph->GetNI(AllNIdV[i])); }
+  TVec<TInt64> OffV;
+  TNIdxMap::TNbrV NbrV;
+  NIdxMap.GetNbrIdxV(NIV, true, Graph->HasFlag(gfDirected), OffV, NbrV);
+#ifdef GCC_ATOMIC
+  if (omp_get_max_threads() > 1) { TSnap::TSnapDetail::GetCoreVMP(OffV, NbrV, CoreV); }
+  else { TSnap::TSnapDetail::GetCoreV(OffV, NbrV, CoreV); }
+#else
+  TSnap::TSnapDetail::GetCoreV(OffV, NbrV, CoreV);
+#endif
+  // an edge is in the K-core if both of its endpoints are, counts of nodes and edges are accumulated from the top core down
+  int MxCore = -1;
+  for (int i = 0; i < Nodes; i++) { MxCore = TMath::Mx(MxCore, CoreV[i].Val); }
+  CoreNodesV.Gen(MxCore+1);
+  TVec<TInt64> DegSumV(MxCore+1);
+  for (int i = 0; i < Nodes; i++) {
+    CoreNodesV[CoreV[i]] += 1;
+    for (int64 e = OffV[i]; e < OffV[i+1]; e++) {
+      DegSumV[TMath::Mn(CoreV[i], CoreV[NbrV[e]])] += 1; }
   }
+  for (int k = MxCore-1; k >= 0; k--) {
+    CoreNodesV[k] += CoreNodesV[k+1];
+    DegSumV[k] += DegSumV[k+1];
+  }
+  CoreEdgesV.Gen(MxCore+1);
+  for (int k = 0; k <= MxCore; k++) { CoreEdgesV[k] = int(DegSumV[k] / 2); }
   CurK = 0;
+  NIdV.Clr();
 }
 
 template<class PGraph>
-int TKCore<PGraph>::GetCoreEdges() const {
-  int CoreEdges = 0;
-  for (int k = DegH.FFirstKeyId(); DegH.FNextKeyId(k); ) {
-    CoreEdges += DegH[k];
+void TKCore<PGraph>::GetNodeCoreH(TIntIntH& NIdCoreH) const {
+  NIdCoreH.Gen(AllNIdV.Len());
+  for (int i = 0; i < AllNIdV.Len(); i++) {
+    NIdCoreH.AddDat(AllNIdV[i], CoreV[i]);
   }
-  return CoreEdges/2;
 }
 
 template<class PGraph>
 int TKCore<PGraph>::GetNextCore() {
-  TIntV DelV;
-  int NDel=-1, AllDeg=0; //Pass=1;
-  TExeTm ExeTm;
-  CurK++;
-  //printf("Get K-core: %d\n", CurK());
-  while (NDel != 0) {
-    NDel = 0;
-    for (int k = DegH.FFirstKeyId(); DegH.FNextKeyId(k); ) {
-      const int NId = DegH.GetKey(k);
-      const int Deg = DegH[k];
-      if (Deg < CurK) {
-        const typename PGraph::TObj::TNodeI NI = Graph->GetNI(NId);
-        for (int e = 0; e < NI.GetDeg(); e++) {
-          const int n = NI.GetNbrNId(e);
-          const int nk = DegH.GetKeyId(n);
-          if (nk != -1) { DegH[nk] -= 1; } // mark node deleted
-        }
-        DegH.DelKeyId(k);
-        NDel++;  AllDeg++;
-      }
-    }
-    //printf("\r  pass %d]  %d deleted,  %d all deleted  [%s]", Pass++, NDel, AllDeg, ExeTm.GetStr());
-  }
-  //printf("\n");
-  DegH.Defrag();
-  DegH.GetKeyV(NIdV);
-  NIdV.Sort();
-  return NIdV.Len(); // all nodes in the current core
+  return GetCoreK(CurK+1);
 }
 
 template<class PGraph>
 int TKCore<PGraph>::GetCoreK(const int& K) {
-  Init();
-  CurK = K-1;
-  return GetNextCore();
+  CurK = K;
+  NIdV.Gen(GetCoreNodes(K), 0);
+  for (int i = 0; i < AllNIdV.Len(); i++) {
+    if (CoreV[i] >= K) { NIdV.Add(AllNIdV[i]); }
+  }
+  return NIdV.Len(); // all nodes in the current core
 }
 
 /////////////////////////////////////////////////
@@ -115,10 +151,10 @@ int GetKCoreNodes(const PGraph& Graph, TIntPrV& CoreIdSzV) {
   TKCore<PGraph> KCore(Graph);
   CoreIdSzV.Clr();
   CoreIdSzV.Add(TIntPr(0, Graph->GetNodes()));
-  for (int i = 1; KCore.GetNextCore() > 0; i++) {
-    CoreIdSzV.Add(TIntPr(i, KCore.GetCoreNodes()));
+  for (int i = 1; i <= KCore.GetMxCore(); i++) {
+    CoreIdSzV.Add(TIntPr(i, KCore.GetCoreNodes(i)));
   }
-  return KCore.GetCurK();
+  return TMath::Mx(KCore.GetMxCore(), 0) + 1;
 }
 
 /// Returns the number of edges in each core of order K (where K=0, 1, ...)
@@ -127,10 +163,18 @@ int GetKCoreEdges(const PGraph& Graph, TIntPrV& CoreIdSzV) {
   TKCore<PGraph> KCore(Graph);
   CoreIdSzV.Clr();
   CoreIdSzV.Add(TIntPr(0, Graph->GetEdges()));
-  for (int i = 1; KCore.GetNextCore() > 0; i++) {
-    CoreIdSzV.Add(TIntPr(i, KCore.GetCoreEdges()));
+  for (int i = 1; i <= KCore.GetMxCore(); i++) {
+    CoreIdSzV.Add(TIntPr(i, KCore.GetCoreEdges(i)));
   }
-  return KCore.GetCurK();
+  return TMath::Mx(KCore.GetMxCore(), 0) + 1;
+}
+
+/// Returns the core number of every node, the largest K such that the node is in the K-core.
+template<class PGraph>
+int GetNodeCores(const PGraph& Graph, TIntIntH& NIdCoreH) {
+  TKCore<PGraph> KCore(Graph);
+  KCore.GetNodeCoreH(NIdCoreH);
+  return KCore.GetMxCore();
 }
 
 } // namespace TSnap
@@ -825,6 +825,77 @@ int TNEANet::AddEdge(const int& SrcNId, const int& DstNId, int EId) {
   return EId;
 }
 
+// Get the key ids of the nodes of a batch of edges, missing nodes are added if AddNodes is true.
+void TNEANet::GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV) {
+  IAssert(SrcNIdV.Len() == DstNIdV.Len());
+  SrcKeyV.Gen(SrcNIdV.Len());  DstKeyV.Gen(DstNIdV.Len());
+  for (int i = 0; i < SrcNIdV.Len(); i++) {
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    int SrcKeyId = NodeH.GetKeyId(SrcNId), DstKeyId = NodeH.GetKeyId(DstNId);
+    if (SrcKeyId == -1 || DstKeyId == -1) {
+      IAssertR(AddNodes, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+      if (SrcKeyId == -1) { AddNode(SrcNId);  SrcKeyId = NodeH.GetKeyId(SrcNId); }
+      if (! IsNode(DstNId)) { AddNode(DstNId); }
+      DstKeyId = NodeH.GetKeyId(DstNId);
+    }
+    SrcKeyV[i] = SrcKeyId;  DstKeyV[i] = DstKeyId;
+  }
+}
+
+// Add a batch of edges. With Dedup the edges that are in the graph or earlier in the batch are found by
+// grouping the batch by source node and merging each group with the sorted destinations of the node.
+int TNEANet::AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& Dedup, const bool& AddNodes) {
+  const int Edges = SrcNIdV.Len();
+  TBoolV NewV;
+  if (Dedup) {
+    TIntV SrcKeyV, DstKeyV;
+    GetBatchKeyIdV(SrcNIdV, DstNIdV, AddNodes, SrcKeyV, DstKeyV);
+    TEdgeBatch Batch;
+    Batch.Gen(SrcKeyV, DstNIdV, NodeH.GetMxKeyIds());
+    TVec<TIntV> DstNIdVV(Batch.GetKeys());
+    TVec<TIntV*> DstNIdVPtV(Batch.GetKeys());
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1000)
+#endif
+    for (int KeyN = 0; KeyN < Batch.GetKeys(); KeyN++) {
+      DstNIdVPtV[KeyN] = &DstNIdVV[KeyN];
+      if (Batch.GetVals(KeyN) == 0) { continue; }
+      const TNode& Node = NodeH[KeyN];
+      DstNIdVV[KeyN].Gen(Node.GetOutDeg(), 0);
+      for (int e = 0; e < Node.GetOutDeg(); e++) {
+        DstNIdVV[KeyN].Add(GetEdge(Node.GetOutEId(e)).GetDstNId()); }
+      DstNIdVV[KeyN].Sort();
+    }
+    Batch.Merge(DstNIdVPtV, NewV, false);
+  }
+  int NewEdges = 0;
+  for (int i = 0; i < Edges; i++) {
+    if (Dedup && ! NewV[i]) { continue; }
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    if (! Dedup && (! IsNode(SrcNId) || ! IsNode(DstNId))) {
+      IAssertR(AddNodes, TStr::Fmt("%d or %d not a node.", SrcNId, DstNId).CStr());
+      if (! IsNode(SrcNId)) { AddNode(SrcNId); }
+      if (! IsNode(DstNId)) { AddNode(DstNId); }
+    }
+    AddEdge(SrcNId, DstNId);
+    NewEdges++;
+  }
+  return NewEdges;
+}
+
+int TNEANet::AddEdgeBatch(const TIntPrV& EdgeV, const bool& Dedup, const bool& AddNodes) {
+  TIntV SrcNIdV(EdgeV.Len()), DstNIdV(EdgeV.Len());
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    SrcNIdV[i] = EdgeV[i].Val1;  DstNIdV[i] = EdgeV[i].Val2; }
+  return AddEdgeBatch(SrcNIdV, DstNIdV, Dedup, AddNodes);
+}
+
+int TNEANet::AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& Dedup, const bool& AddNodes) {
+  TIntV SrcNIdV, DstNIdV;
+  SrcNIdV.GenExt((TInt*) SrcNIdT, Edges);  DstNIdV.GenExt((TInt*) DstNIdT, Edges);
+  return AddEdgeBatch(SrcNIdV, DstNIdV, Dedup, AddNodes);
+}
+
 void TNEANet::DelEdge(const int& EId) {
   int i;
 
@@ -1494,6 +1565,36 @@ TFlt TNEANet::GetFltAttrIndDatE(const int& EId, const int& index) {
   return VecOfFltVecsE[index][EdgeH.GetKeyId(EId)];
 }
 
+TNEANet::TIntAttrCol TNEANet::GetIntAttrColN(const TStr& attr) {
+  IAssertR(KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == IntType, attr);
+  return TIntAttrCol(VecOfIntVecsN, KeyToIndexTypeN.GetDat(attr).Val2);
+}
+
+TNEANet::TFltAttrCol TNEANet::GetFltAttrColN(const TStr& attr) {
+  IAssertR(KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == FltType, attr);
+  return TFltAttrCol(VecOfFltVecsN, KeyToIndexTypeN.GetDat(attr).Val2);
+}
+
+TNEANet::TStrAttrCol TNEANet::GetStrAttrColN(const TStr& attr) {
+  IAssertR(KeyToIndexTypeN.IsKey(attr) && KeyToIndexTypeN.GetDat(attr).Val1 == StrType, attr);
+  return TStrAttrCol(VecOfStrVecsN, KeyToIndexTypeN.GetDat(attr).Val2);
+}
+
+TNEANet::TIntAttrCol TNEANet::GetIntAttrColE(const TStr& attr) {
+  IAssertR(KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == IntType, attr);
+  return TIntAttrCol(VecOfIntVecsE, KeyToIndexTypeE.GetDat(attr).Val2);
+}
+
+TNEANet::TFltAttrCol TNEANet::GetFltAttrColE(const TStr& attr) {
+  IAssertR(KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == FltType, attr);
+  return TFltAttrCol(VecOfFltVecsE, KeyToIndexTypeE.GetDat(attr).Val2);
+}
+
+TNEANet::TStrAttrCol TNEANet::GetStrAttrColE(const TStr& attr) {
+  IAssertR(KeyToIndexTypeE.IsKey(attr) && KeyToIndexTypeE.GetDat(attr).Val1 == StrType, attr);
+  return TStrAttrCol(VecOfStrVecsE, KeyToIndexTypeE.GetDat(attr).Val2);
+}
+
 int TNEANet::GetIntAttrIndE(const TStr& attr) {
   return KeyToIndexTypeE.GetDat(attr).Val2.Val;
 }
@@ -1833,21 +1934,20 @@ void TNEANet::GetAttrENames(TStrV& IntAttrNames, TStrV& FltAttrNames, TStrV& Str
 }
 
 TFlt TNEANet::GetWeightOutEdges(const TNodeI& NI, const TStr& attr) {
-  TNode Node = GetNode(NI.GetId());
-  TIntV OutEIdV = Node.OutEIdV;
+  const TFltAttrCol Col = GetFltAttrColE(attr);
+  const TNode& Node = NI.NodeHI.GetDat();
   TFlt total = 0;
   int len = Node.OutEIdV.Len();
   for (int i = 0; i < len; i++) {
-    total += GetFltAttrDatE(Node.OutEIdV[i], attr);
+    total += Col[EdgeH.GetKeyId(Node.OutEIdV[i])];
   }
   return total;
 }
 
 void TNEANet::GetWeightOutEdgesV(TFltV& OutWeights, const TFltV& AttrVal) {
   for (TEdgeI it = BegEI(); it < EndEI(); it++) {
-    int EId = it.GetId();
     int SrcId = it.GetSrcNId();
-    OutWeights[SrcId] +=AttrVal[GetFltKeyIdE(EId)];
+    OutWeights[SrcId] +=AttrVal[it.GetKeyId()];
   }
 }
 
@@ -1633,6 +1633,29 @@ public:
     }
     friend class TNEANet;
   };
+  /// Handle to one int, float or string attribute of all nodes or of all edges. ##TNEANet::TAttrCol
+  template <class TVal>
+  class TAttrCol {
+  private:
+    TVec<TVec<TVal> >* VecOfVecs;
+    int ColN;
+  public:
+    TAttrCol() : VecOfVecs(NULL), ColN(-1) { }
+    TAttrCol(TVec<TVec<TVal> >& VecOfVecsV, const int& Col) : VecOfVecs(&VecOfVecsV), ColN(Col) { }
+    TAttrCol(const TAttrCol& Col) : VecOfVecs(Col.VecOfVecs), ColN(Col.ColN) { }
+    TAttrCol& operator = (const TAttrCol& Col) { VecOfVecs = Col.VecOfVecs; ColN = Col.ColN; return *this; }
+    /// Tests whether the handle does not refer to an attribute.
+    bool Empty() const { return VecOfVecs == NULL; }
+    /// Returns the value of the node or edge with key id \c KeyId.
+    const TVal& operator [] (const int& KeyId) const { return (*VecOfVecs)[ColN][KeyId]; }
+    /// Returns the value of the node or edge with key id \c KeyId.
+    TVal& operator [] (const int& KeyId) { return (*VecOfVecs)[ColN][KeyId]; }
+    /// Returns the values of all nodes or edges, indexed by key id.
+    const TVec<TVal>& GetValV() const { return (*VecOfVecs)[ColN]; }
+  };
+  typedef TAttrCol<TInt> TIntAttrCol;
+  typedef TAttrCol<TFlt> TFltAttrCol;
+  typedef TAttrCol<TStr> TStrAttrCol;
   /// Node iterator. Only forward iteration (operator++) is supported.
   class TNodeI {
   protected:
@@ -1700,6 +1723,14 @@ public:
     void GetFltAttrNames(TStrV& Names) const { Graph->FltAttrNameNI(GetId(), Names); }
     /// Gets vector of flt attribute values.
     void GetFltAttrVal(TFltV& Val) const { Graph->FltAttrValueNI(GetId(), Val); }
+    /// Returns the key id of the current node, the index of its values in attribute columns.
+    int GetKeyId() const { return Graph->NodeH.GetKeyId(NodeHI); }
+    /// Gets the value of int attribute column \c Col for the current node. ##TNEANet::TNodeI::GetIntAttrDat
+    TInt GetIntAttrDat(const TIntAttrCol& Col) const { return Col[GetKeyId()]; }
+    /// Gets the value of flt attribute column \c Col for the current node.
+    TFlt GetFltAttrDat(const TFltAttrCol& Col) const { return Col[GetKeyId()]; }
+    /// Gets the value of str attribute column \c Col for the current node.
+    TStr GetStrAttrDat(const TStrAttrCol& Col) const { return Col[GetKeyId()]; }
     friend class TNEANet;
   };
   /// Edge iterator. Only forward iteration (operator++) is supported.
@@ -1743,6 +1774,14 @@ public:
     void GetFltAttrNames(TStrV& Names) const { Graph->FltAttrNameEI(GetId(), Names); }
     /// Gets vector of flt attribute values.
     void GetFltAttrVal(TFltV& Val) const { Graph->FltAttrValueEI(GetId(), Val); }
+    /// Returns the key id of the current edge, the index of its values in attribute columns.
+    int GetKeyId() const { return Graph->EdgeH.GetKeyId(EdgeHI); }
+    /// Gets the value of int attribute column \c Col for the current edge.
+    TInt GetIntAttrDat(const TIntAttrCol& Col) const { return Col[GetKeyId()]; }
+    /// Gets the value of flt attribute column \c Col for the current edge.
+    TFlt GetFltAttrDat(const TFltAttrCol& Col) const { return Col[GetKeyId()]; }
+    /// Gets the value of str attribute column \c Col for the current edge.
+    TStr GetStrAttrDat(const TStrAttrCol& Col) const { return Col[GetKeyId()]; }
     friend class TNEANet;
   };
 
@@ -1870,6 +1909,7 @@ protected:
   const TNode& GetNode(const int& NId) const { return NodeH.GetDat(NId); }
   TEdge& GetEdge(const int& EId) { return EdgeH.GetDat(EId); }
   const TEdge& GetEdge(const int& EId) const { return EdgeH.GetDat(EId); }
+  void GetBatchKeyIdV(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& AddNodes, TIntV& SrcKeyV, TIntV& DstKeyV);
   int AddAttributes(const int NId);
 
 protected:
@@ -2613,6 +2653,12 @@ public:
   int AddEdge(const int& SrcNId, const int& DstNId, int EId  = -1);
   /// Adds an edge between EdgeI.GetSrcNId() and EdgeI.GetDstNId() to the graph.
   int AddEdge(const TEdgeI& EdgeI) { return AddEdge(EdgeI.GetSrcNId(), EdgeI.GetDstNId(), EdgeI.GetId()); }
+  /// Adds the edges of EdgeV and returns the number of edges added. ##TNEANet::AddEdgeBatch
+  int AddEdgeBatch(const TIntPrV& EdgeV, const bool& Dedup=false, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdV[i], DstNIdV[i]) and returns the number of edges added.
+  int AddEdgeBatch(const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& Dedup=false, const bool& AddNodes=true);
+  /// Adds the edges (SrcNIdT[i], DstNIdT[i]) for i < Edges and returns the number of edges added.
+  int AddEdgeBatch(const int* SrcNIdT, const int* DstNIdT, const int& Edges, const bool& Dedup=false, const bool& AddNodes=true);
   /// Deletes an edge with edge ID EId from the graph.
   void DelEdge(const int& EId);
   /// Deletes all edges between node IDs SrcNId and DstNId from the graph. ##TNEANet::DelEdge
@@ -2781,6 +2827,19 @@ public:
   TFltV GetFltVAttrDatE(const TEdgeI& EdgeI, const TStr& attr) { return GetFltVAttrDatE(EdgeI.GetId(), attr); }
   TFltV GetFltVAttrDatE(const int& EId, const TStr& attr);
 
+  /// Gets a handle to the int node attr \c attr. ##TNEANet::GetIntAttrColN
+  TIntAttrCol GetIntAttrColN(const TStr& attr);
+  /// Gets a handle to the flt node attr \c attr.
+  TFltAttrCol GetFltAttrColN(const TStr& attr);
+  /// Gets a handle to the str node attr \c attr.
+  TStrAttrCol GetStrAttrColN(const TStr& attr);
+  /// Gets a handle to the int edge attr \c attr.
+  TIntAttrCol GetIntAttrColE(const TStr& attr);
+  /// Gets a handle to the flt edge attr \c attr.
+  TFltAttrCol GetFltAttrColE(const TStr& attr);
+  /// Gets a handle to the str edge attr \c attr.
+  TStrAttrCol GetStrAttrColE(const TStr& attr);
+
   /// Gets the index of the edge attr value vector specified by \c attr (same as GetAttrIndE for compatibility reasons).
   int GetIntAttrIndE(const TStr& attr);
   /// Gets the index of the edge attr value vector specified by \c attr.
@@ -146,4 +146,341 @@ template <class PGraph>
 
 }; // namespace TSnap
 
+/// Batched Personalized PageRank queries on a fixed graph.
+/// PPR(s, t) is the probability that a random walk from s stops at t, where the walk stops after each step with probability
+/// JumpProb and restarts at s if it reaches a dead-end node, as in SamplePersonalizedPageRank(). Pairwise queries use the
+/// bidirectional estimator of GetPersonalizedPageRankBidirectional() with the reverse push of every target cached and reused by
+/// all later queries to that target. Top-k queries use forward push from the source followed by random walks from the nodes that
+/// kept a residual, see "FORA: Simple and Effective Approximate Single-Source Personalized PageRank" by Wang et al., KDD 2017.
+/// The walks can come from an index of precomputed walk endpoints of bounded size, see BuildWalkIndex().
+/// Queries of a batch run in parallel, every thread samples walks with its own TRnd.
+template <class PGraph>
+class TPprBatch {
+private:
+  /// Per-thread scratch space of a push computation, dense over the node indices.
+  class TState {
+  public:
+    TFltV EstV, ResV;
+    TIntV QueueV, TouchV;
+    TBoolV InQueueV, TouchedV;
+  public:
+    void Gen(const int& Nodes) {
+      EstV.Gen(Nodes);  ResV.Gen(Nodes);  InQueueV.Gen(Nodes);  TouchedV.Gen(Nodes);
+      QueueV.Gen(Nodes, 0);  TouchV.Gen(Nodes, 0); }
+    void Touch(const int& NIdx) { if (! TouchedV[NIdx]) { TouchedV[NIdx] = true;  TouchV.Add(NIdx); } }
+    void Enqueue(const int& NIdx) { if (! InQueueV[NIdx]) { InQueueV[NIdx] = true;  QueueV.Add(NIdx); } }
+    void Reset() {
+      for (int i = 0; i < TouchV.Len(); i++) {
+        const int NIdx = TouchV[i];
+        EstV[NIdx] = 0;  ResV[NIdx] = 0;  TouchedV[NIdx] = false; }
+      TouchV.Clr(false); }
+  };
+private:
+  PGraph Graph;
+  double JumpProb, WalkRMaxRatio, FwdRMax, RevRMax;
+  TIntV NIdV;
+  TNIdxMap NIdxMap;
+  TIntV OutOffV, OutNbrV, InOffV, InNbrV;
+  TVec<TInt64> WalkOffV;  // walks from node index n are WalkEndV[WalkOffV[n]..WalkOffV[n+1]), the index may exceed 2^31 walks
+  TNIdxMap::TNbrV WalkEndV;
+  TIntIntH TrgSlotH;
+  TVec<TIntFltH> TrgEstHV, TrgResHV;
+  TFltV TrgMxResV;
+  int MxTrgCache, Seed;
+  TVec<TRnd> RndV;
+  TVec<TState> StateV;
+private:
+  int GetOutDeg(const int& NIdx) const { return OutOffV[NIdx+1] - OutOffV[NIdx]; }
+  int GetWalkEnd(const int& StartIdx, const int& SrcIdx, TRnd& Rnd) const;
+  int GetIndexWalkEnd(const int& StartIdx, const int& WalkN, const int& SrcIdx, TRnd& Rnd) const;
+  void ReversePush(const int& TrgIdx, TState& State, TIntFltH& EstH, TIntFltH& ResH, TFlt& MxRes) const;
+  void ForwardPush(const int& SrcIdx, TState& State) const;
+  int GetThreadN() const;
+  /// Adds a TRnd (and push scratch space if States is set) for every thread the next parallel region can use.
+  void InitThreads(const bool& States);
+public:
+  /// MinProbability, RelativeError and ProvableRelativeError have the same meaning as in GetPersonalizedPageRankBidirectional().
+  /// RndSeed seeds the random number generator of the first thread, the other threads use the following seeds.
+  TPprBatch(const PGraph& GraphPt, const double& _JumpProb, double MinProbability=-1.0, const double& RelativeError=0.1,
+    const bool& ProvableRelativeError=false, const int& RndSeed=1);
+  int GetNodes() const { return NIdV.Len(); }
+  /// Precomputes random walk endpoints for the residuals left by forward push, at most MxWalks in total (-1 for no limit).
+  /// Node u gets ceil(FwdRMax*OutDeg(u)*WalkRMaxRatio) walks, as many as any residual forward push can leave on u needs, so the full
+  /// index holds about sqrt(Edges*WalkRMaxRatio) walks. Walks beyond the index are sampled at query time. Returns the number of stored walks.
+  int64 BuildWalkIndex(const int64& MxWalks=-1);
+  /// Sets the maximum number of targets whose reverse push is cached. The cache is emptied when a batch does not fit in it,
+  /// a batch with more distinct targets is answered in rounds of at most MxTargets targets.
+  void SetMxTrgCache(const int& MxTargets) { MxTrgCache = MxTargets; }
+  int GetTrgCacheLen() const { return TrgSlotH.Len(); }
+  void ClrTrgCache() { TrgSlotH.Clr();  TrgEstHV.Clr();  TrgResHV.Clr();  TrgMxResV.Clr(); }
+  /// Estimates PPR(SrcNIdV[i], TrgNIdV[i]) for every i and stores it to PprV[i].
+  void GetPprV(const TIntV& SrcNIdV, const TIntV& TrgNIdV, TFltV& PprV);
+  /// Stores the K nodes with the highest PPR from SrcNIdV[i] to TopVV[i], sorted by decreasing PPR.
+  void GetTopPprV(const TIntV& SrcNIdV, const int& K, TVec<TIntFltKdV>& TopVV);
+};
+
+template <class PGraph>
+TPprBatch<PGraph>::TPprBatch(const PGraph& GraphPt, const double& _JumpProb, double MinProbability, const double& RelativeError,
+    const bool& ProvableRelativeError, const int& RndSeed) : Graph(GraphPt), JumpProb(_JumpProb), MxTrgCache(10000), Seed(RndSeed) {
+  const int Nodes = Graph->GetNodes();
+  NIdV.Gen(Nodes, 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIdV.Add(NI.GetId()); }
+  NIdxMap.Gen(NIdV);
+  OutOffV.Gen(Nodes+1, 0);  OutOffV.Add(0);
+  InOffV.Gen(Nodes+1, 0);  InOffV.Add(0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    for (int e = 0; e < NI.GetOutDeg(); e++) { OutNbrV.Add(NIdxMap.GetIdx(NI.GetOutNId(e))); }
+    for (int e = 0; e < NI.GetInDeg(); e++) { InNbrV.Add(NIdxMap.GetIdx(NI.GetInNId(e))); }
+    OutOffV.Add(OutNbrV.Len());
+    InOffV.Add(InNbrV.Len());
+  }
+  WalkOffV.Gen(Nodes+1);
+  // the walk count per unit of residual is the same as in GetPersonalizedPageRankBidirectional()
+  if (MinProbability <= 0.0) { MinProbability = 1.0 / TMath::Mx(Nodes, 1); }
+  const double ChernoffConstant = ProvableRelativeError ? 12 * exp((double) 1) * log(2 / 1.0e-9) : 0.07;
+  WalkRMaxRatio = ChernoffConstant / (RelativeError * RelativeError) / MinProbability;
+  // forward push leaves about sqrt(Edges*WalkRMaxRatio) walks (FORA), reverse push balances its work AvgDeg/RevRMax with the walks
+  FwdRMax = TMath::Mn(1.0, 1.0 / sqrt(TMath::Mx(OutNbrV.Len(), 1) * WalkRMaxRatio));
+  RevRMax = TMath::Mn(1.0, sqrt(TMath::Mx(OutNbrV.Len() / double(TMath::Mx(Nodes, 1)), 1.0) / WalkRMaxRatio));
+}
+
+template <class PGraph>
+int TPprBatch<PGraph>::GetThreadN() const {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+// The number of threads can grow between calls (omp_set_num_threads()), so it is checked before every parallel region.
+template <class PGraph>
+void TPprBatch<PGraph>::InitThreads(const bool& States) {
+  int Threads = 1;
+#ifdef USE_OPENMP
+  Threads = omp_get_max_threads();
+#endif
+  for (int t = RndV.Len(); t < Threads; t++) { RndV.Add(TRnd(Seed + t)); }
+  if (! States) { return; }
+  for (int t = StateV.Len(); t < Threads; t++) { StateV.Add(TState());  StateV.Last().Gen(GetNodes()); }
+}
+
+// Returns the endpoint of a walk from StartIdx that restarts at SrcIdx at dead ends, or -1 if the walk reaches a dead end and SrcIdx is -1.
+template <class PGraph>
+int TPprBatch<PGraph>::GetWalkEnd(const int& StartIdx, const int& SrcIdx, TRnd& Rnd) const {
+  int NIdx = StartIdx;
+  while (Rnd.GetUniDev() >= JumpProb) {
+    const int Deg = GetOutDeg(NIdx);
+    if (Deg > 0) { NIdx = OutNbrV[OutOffV[NIdx] + Rnd.GetUniDevInt(Deg)]; }
+    else if (SrcIdx == -1) { return -1; }
+    else { NIdx = SrcIdx; }
+  }
+  return NIdx;
+}
+
+// Returns the endpoint of the WalkN-th walk from StartIdx, from the index if it holds that many walks.
+// An indexed walk that reached a dead end continues as a fresh walk from SrcIdx.
+template <class PGraph>
+int TPprBatch<PGraph>::GetIndexWalkEnd(const int& StartIdx, const int& WalkN, const int& SrcIdx, TRnd& Rnd) const {
+  if (WalkN >= WalkOffV[StartIdx+1] - WalkOffV[StartIdx]) { return GetWalkEnd(StartIdx, SrcIdx, Rnd); }
+  const int NIdx = WalkEndV[WalkOffV[StartIdx] + WalkN];
+  return NIdx != -1 ? NIdx : GetWalkEnd(SrcIdx, SrcIdx, Rnd);
+}
+
+template <class PGraph>
+int64 TPprBatch<PGraph>::BuildWalkIndex(const int64& MxWalks) {
+  const int Nodes = GetNodes();
+  double Walks = 0;
+  for (int n = 0; n < Nodes; n++) { Walks += ceil(FwdRMax * GetOutDeg(n) * WalkRMaxRatio); }
+  const double Scale = MxWalks >= 0 && Walks > double(MxWalks) ? double(MxWalks) / Walks : 1.0;
+  WalkOffV.Gen(Nodes+1);
+  for (int n = 0; n < Nodes; n++) {
+    WalkOffV[n+1] = WalkOffV[n] + int64(floor(Scale * ceil(FwdRMax * GetOutDeg(n) * WalkRMaxRatio))); }
+  WalkEndV.Gen(WalkOffV.Last());
+  InitThreads(false);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (int n = 0; n < Nodes; n++) {
+    TRnd& Rnd = RndV[GetThreadN()];
+    for (int64 w = WalkOffV[n]; w < WalkOffV[n+1]; w++) {
+      WalkEndV[w] = GetWalkEnd(n, -1, Rnd); }
+  }
+  return WalkEndV.Len();
+}
+
+// Reverse push from TrgIdx until all residuals are at most RevRMax, see ApproxContributionsBalanced().
+// Like there, the restarts at dead ends are not taken into account.
+template <class PGraph>
+void TPprBatch<PGraph>::ReversePush(const int& TrgIdx, TState& State, TIntFltH& EstH, TIntFltH& ResH, TFlt& MxRes) const {
+  State.ResV[TrgIdx] = 1.0;
+  State.Touch(TrgIdx);
+  State.Enqueue(TrgIdx);
+  for (int i = 0; i < State.QueueV.Len(); i++) {
+    const int NIdx = State.QueueV[i];
+    State.InQueueV[NIdx] = false;
+    const double Res = State.ResV[NIdx];
+    State.ResV[NIdx] = 0;
+    State.EstV[NIdx] += JumpProb * Res;
+    for (int e = InOffV[NIdx]; e < InOffV[NIdx+1]; e++) {
+      const int InIdx = InNbrV[e];
+      State.ResV[InIdx] += (1.0 - JumpProb) * Res / GetOutDeg(InIdx);
+      State.Touch(InIdx);
+      if (State.ResV[InIdx] > RevRMax) { State.Enqueue(InIdx); }
+    }
+  }
+  State.QueueV.Clr(false);
+  EstH.Clr();  ResH.Clr();
+  MxRes = 0;
+  for (int i = 0; i < State.TouchV.Len(); i++) {
+    const int NIdx = State.TouchV[i];
+    if (State.EstV[NIdx] > 0) { EstH.AddDat(NIdx, State.EstV[NIdx]); }
+    if (State.ResV[NIdx] > 0) { ResH.AddDat(NIdx, State.ResV[NIdx]);  MxRes = TMath::Mx(MxRes.Val, State.ResV[NIdx].Val); }
+  }
+  State.Reset();
+}
+
+// Forward push from SrcIdx until the residual of every node is at most FwdRMax times its out-degree.
+// Dead ends push their residual back to SrcIdx, so they never keep any.
+template <class PGraph>
+void TPprBatch<PGraph>::ForwardPush(const int& SrcIdx, TState& State) const {
+  State.ResV[SrcIdx] = 1.0;
+  State.Touch(SrcIdx);
+  State.Enqueue(SrcIdx);
+  for (int i = 0; i < State.QueueV.Len(); i++) {
+    const int NIdx = State.QueueV[i];
+    State.InQueueV[NIdx] = false;
+    const double Res = State.ResV[NIdx];
+    State.ResV[NIdx] = 0;
+    State.EstV[NIdx] += JumpProb * Res;
+    const int Deg = GetOutDeg(NIdx);
+    if (Deg == 0 && NIdx == SrcIdx) {
+      // walks never leave a dead-end source
+      State.EstV[NIdx] += (1.0 - JumpProb) * Res;
+      continue;
+    }
+    if (Deg == 0) {
+      State.ResV[SrcIdx] += (1.0 - JumpProb) * Res;
+      if (State.ResV[SrcIdx] > FwdRMax * GetOutDeg(SrcIdx)) { State.Enqueue(SrcIdx); }
+      continue;
+    }
+    const double Push = (1.0 - JumpProb) * Res / Deg;
+    for (int e = OutOffV[NIdx]; e < OutOffV[NIdx+1]; e++) {
+      const int OutIdx = OutNbrV[e];
+      State.ResV[OutIdx] += Push;
+      State.Touch(OutIdx);
+      if (State.ResV[OutIdx] > FwdRMax * GetOutDeg(OutIdx)) { State.Enqueue(OutIdx); }
+    }
+  }
+  State.QueueV.Clr(false);
+}
+
+template <class PGraph>
+void TPprBatch<PGraph>::GetPprV(const TIntV& SrcNIdV, const TIntV& TrgNIdV, TFltV& PprV) {
+  IAssert(SrcNIdV.Len() == TrgNIdV.Len());
+  // reverse push of the targets that are not cached yet
+  TIntSet TrgSet;
+  for (int q = 0; q < TrgNIdV.Len(); q++) { TrgSet.AddKey(NIdxMap.GetIdx(TrgNIdV[q])); }
+  const int MxTrgs = TMath::Mx(MxTrgCache, 1);
+  if (TrgSet.Len() > MxTrgs) {
+    // answer the queries in rounds of at most MxTrgs distinct targets, so that the cache never holds more
+    const int Rounds = (TrgSet.Len() + MxTrgs - 1) / MxTrgs;
+    TVec<TIntV> QueryVV(Rounds);
+    for (int q = 0; q < TrgNIdV.Len(); q++) {
+      QueryVV[TrgSet.GetKeyId(NIdxMap.GetIdx(TrgNIdV[q])) / MxTrgs].Add(q); }
+    PprV.Gen(SrcNIdV.Len());
+    for (int r = 0; r < Rounds; r++) {
+      const TIntV& QueryV = QueryVV[r];
+      TIntV RoundSrcV(QueryV.Len(), 0), RoundTrgV(QueryV.Len(), 0);
+      for (int i = 0; i < QueryV.Len(); i++) {
+        RoundSrcV.Add(SrcNIdV[QueryV[i]]);  RoundTrgV.Add(TrgNIdV[QueryV[i]]); }
+      TFltV RoundPprV;
+      GetPprV(RoundSrcV, RoundTrgV, RoundPprV);
+      for (int i = 0; i < QueryV.Len(); i++) { PprV[QueryV[i]] = RoundPprV[i]; }
+    }
+    return;
+  }
+  TIntV NewTrgV;
+  for (int i = 0; i < TrgSet.Len(); i++) {
+    if (! TrgSlotH.IsKey(TrgSet[i])) { NewTrgV.Add(TrgSet[i]); } }
+  if (TrgSlotH.Len() + NewTrgV.Len() > MxTrgs) {
+    ClrTrgCache();
+    TrgSet.GetKeyV(NewTrgV);
+  }
+  const int FirstSlot = TrgSlotH.Len();
+  for (int i = 0; i < NewTrgV.Len(); i++) {
+    TrgSlotH.AddDat(NewTrgV[i], FirstSlot + i);
+    TrgEstHV.Add();  TrgResHV.Add();  TrgMxResV.Add();
+  }
+  InitThreads(true);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for (int i = 0; i < NewTrgV.Len(); i++) {
+    const int Slot = FirstSlot + i;
+    ReversePush(NewTrgV[i], StateV[GetThreadN()], TrgEstHV[Slot], TrgResHV[Slot], TrgMxResV[Slot]);
+  }
+  // PPR(s,t) is the estimate of s plus the average residual at the end of random walks from s
+  PprV.Gen(SrcNIdV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for (int q = 0; q < SrcNIdV.Len(); q++) {
+    TRnd& Rnd = RndV[GetThreadN()];
+    const int SrcIdx = NIdxMap.GetIdx(SrcNIdV[q]);
+    const int Slot = TrgSlotH.GetDat(NIdxMap.GetIdx(TrgNIdV[q]));
+    const TIntFltH& ResH = TrgResHV[Slot];
+    TFlt Ppr = 0, Res;
+    TrgEstHV[Slot].IsKeyGetDat(SrcIdx, Ppr);
+    const int Walks = int(WalkRMaxRatio * TrgMxResV[Slot]);
+    double ResSum = 0;
+    for (int w = 0; w < Walks; w++) {
+      if (ResH.IsKeyGetDat(GetIndexWalkEnd(SrcIdx, w, SrcIdx, Rnd), Res)) { ResSum += Res; }
+    }
+    PprV[q] = Ppr + (Walks > 0 ? ResSum / Walks : 0.0);
+  }
+}
+
+template <class PGraph>
+void TPprBatch<PGraph>::GetTopPprV(const TIntV& SrcNIdV, const int& K, TVec<TIntFltKdV>& TopVV) {
+  InitThreads(true);
+  TopVV.Gen(SrcNIdV.Len());
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for (int q = 0; q < SrcNIdV.Len(); q++) {
+    const int ThreadN = GetThreadN();
+    TState& State = StateV[ThreadN];
+    TRnd& Rnd = RndV[ThreadN];
+    const int SrcIdx = NIdxMap.GetIdx(SrcNIdV[q]);
+    ForwardPush(SrcIdx, State);
+    // spread the residuals of the nodes over the ends of walks from them
+    const int Touched = State.TouchV.Len();
+    for (int i = 0; i < Touched; i++) {
+      const int NIdx = State.TouchV[i];
+      const double Res = State.ResV[NIdx];
+      if (Res <= 0) { continue; }
+      const int Walks = int(ceil(Res * WalkRMaxRatio));
+      for (int w = 0; w < Walks; w++) {
+        const int EndIdx = GetIndexWalkEnd(NIdx, w, SrcIdx, Rnd);
+        State.EstV[EndIdx] += Res / Walks;
+        State.Touch(EndIdx);
+      }
+    }
+    TFltIntPrV PprNIdxV(State.TouchV.Len(), 0);
+    for (int i = 0; i < State.TouchV.Len(); i++) {
+      const int NIdx = State.TouchV[i];
+      if (State.EstV[NIdx] > 0) { PprNIdxV.Add(TFltIntPr(State.EstV[NIdx], NIdx)); }
+    }
+    State.Reset();
+    PprNIdxV.Sort(false);
+    TIntFltKdV& TopV = TopVV[q];
+    const int TopLen = TMath::Mn(K, PprNIdxV.Len());
+    TopV.Gen(TopLen, 0);
+    for (int i = 0; i < TopLen; i++) {
+      TopV.Add(TIntFltKd(NIdV[PprNIdxV[i].Val2], PprNIdxV[i].Val1)); }
+  }
+}
+
 #endif
@@ -0,0 +1,197 @@
+namespace TSnap {
+namespace TSnapDetail {
+
+// Adjacency of a graph with nodes 0..N-1 as seen by the orderings, in-lists are empty for undirected graphs.
+class TOrderGraph {
+public:
+  const TIntV& OffV;
+  const TIntV& NbrV;
+  const TIntV& InOffV;
+  const TIntV& InNbrV;
+public:
+  TOrderGraph(const TIntV& _OffV, const TIntV& _NbrV, const TIntV& _InOffV, const TIntV& _InNbrV) :
+    OffV(_OffV), NbrV(_NbrV), InOffV(_InOffV), InNbrV(_InNbrV) { }
+  bool IsDir() const { return ! InOffV.Empty(); }
+  int GetNodes() const { return OffV.Len()-1; }
+  int GetOutDeg(const int& NIdx) const { return OffV[NIdx+1] - OffV[NIdx]; }
+  int GetInDeg(const int& NIdx) const { return IsDir() ? InOffV[NIdx+1] - InOffV[NIdx] : GetOutDeg(NIdx); }
+  int GetDeg(const int& NIdx) const { return GetOutDeg(NIdx) + (IsDir() ? GetInDeg(NIdx) : 0); }
+  /// Adds the neighbors of NIdx in both directions to NbrIdxV.
+  void GetNbrV(const int& NIdx, TIntV& NbrIdxV) const {
+    NbrIdxV.Clr(false);
+    for (int e = OffV[NIdx]; e < OffV[NIdx+1]; e++) { NbrIdxV.Add(NbrV[e]); }
+    if (! IsDir()) { return; }
+    for (int e = InOffV[NIdx]; e < InOffV[NIdx+1]; e++) { NbrIdxV.Add(InNbrV[e]); }
+  }
+};
+
+// Breadth-first search over edges in both directions from StartIdx, appends the visited nodes to OrderV.
+// Unless NbrOrder is false, the neighbors of a node are visited by increasing degree (Cuthill-McKee).
+// Nodes with VisitV[i] == Mark are skipped, visited nodes get the mark. Returns the depth of the search.
+static int DoOrderBfs(const TOrderGraph& G, const int& StartIdx, const bool& NbrOrder, const int& Mark,
+    TIntV& VisitV, TIntV& OrderV, TIntV& LevelV) {
+  TIntV NbrIdxV;
+  TIntPrV DegNbrV;
+  const int Beg = OrderV.Len();
+  OrderV.Add(StartIdx);
+  VisitV[StartIdx] = Mark;
+  LevelV[StartIdx] = 0;
+  int Depth = 0;
+  for (int i = Beg; i < OrderV.Len(); i++) {
+    const int NIdx = OrderV[i];
+    G.GetNbrV(NIdx, NbrIdxV);
+    DegNbrV.Clr(false);
+    for (int e = 0; e < NbrIdxV.Len(); e++) {
+      const int Nbr = NbrIdxV[e];
+      if (VisitV[Nbr] == Mark) { continue; }
+      VisitV[Nbr] = Mark;
+      LevelV[Nbr] = LevelV[NIdx] + 1;
+      Depth = LevelV[Nbr];
+      if (NbrOrder) { DegNbrV.Add(TIntPr(G.GetDeg(Nbr), Nbr)); }
+      else { OrderV.Add(Nbr); }
+    }
+    if (NbrOrder) {
+      DegNbrV.Sort();
+      for (int e = 0; e < DegNbrV.Len(); e++) { OrderV.Add(DegNbrV[e].Val2); }
+    }
+  }
+  return Depth;
+}
+
+// Pseudo-peripheral node of the component of StartIdx (George and Liu, 1979): a node of minimum degree in the
+// last level of a breadth-first search becomes the next start while the depth of the search grows.
+static int GetPeripheralNode(const TOrderGraph& G, const int& StartIdx, int& Mark, TIntV& VisitV, TIntV& LevelV) {
+  TIntV OrderV;
+  int Root = StartIdx, Depth = -1;
+  while (true) {
+    OrderV.Clr(false);
+    const int NewDepth = DoOrderBfs(G, Root, false, ++Mark, VisitV, OrderV, LevelV);
+    if (NewDepth <= Depth) { return Root; }
+    Depth = NewDepth;
+    int Next = -1;
+    for (int i = OrderV.Len()-1; i >= 0 && LevelV[OrderV[i]] == Depth; i--) {
+      if (Next == -1 || G.GetDeg(OrderV[i]) < G.GetDeg(Next)) { Next = OrderV[i]; }
+    }
+    if (Next == Root) { return Root; }
+    Root = Next;
+  }
+}
+
+static void GetDegreeOrder(const TOrderGraph& G, TIntV& OrderV) {
+  TIntPrV DegNIdxV(G.GetNodes(), 0);
+  for (int n = 0; n < G.GetNodes(); n++) {
+    DegNIdxV.Add(TIntPr(-G.GetDeg(n), n)); }
+  DegNIdxV.Sort();
+  OrderV.Gen(G.GetNodes(), 0);
+  for (int n = 0; n < DegNIdxV.Len(); n++) {
+    OrderV.Add(DegNIdxV[n].Val2); }
+}
+
+// Components are started from their node of minimum (norRcm) or maximum (norBfs) degree, found by scanning
+// the nodes by degree; norRcm then moves the start to a pseudo-peripheral node.
+static void GetBfsOrder(const TOrderGraph& G, const bool& Rcm, TIntV& OrderV) {
+  const int Nodes = G.GetNodes();
+  TIntV DegOrderV;
+  GetDegreeOrder(G, DegOrderV);
+  if (Rcm) { DegOrderV.Reverse(); }
+  TIntV VisitV(Nodes), LevelV(Nodes), SearchV(Nodes), SearchLevelV(Nodes);
+  int Mark = 0;
+  OrderV.Gen(Nodes, 0);
+  for (int i = 0; i < Nodes; i++) {
+    const int StartIdx = DegOrderV[i];
+    if (VisitV[StartIdx] != 0) { continue; }
+    const int Root = Rcm ? GetPeripheralNode(G, StartIdx, Mark, SearchV, SearchLevelV) : StartIdx;
+    DoOrderBfs(G, Root, Rcm, 1, VisitV, OrderV, LevelV);
+  }
+  if (Rcm) { OrderV.Reverse(); }
+}
+
+// Max-priority queue over integer keys that only change by one, with constant time updates (the unit heap of Gorder).
+// Nodes with equal keys are kept in doubly linked lists.
+class TUnitHeap {
+private:
+  TIntV KeyV, PrevV, NextV, HeadV;
+  int Top;
+private:
+  void Unlink(const int& NIdx) {
+    if (PrevV[NIdx] != -1) { NextV[PrevV[NIdx]] = NextV[NIdx]; } else { HeadV[KeyV[NIdx]] = NextV[NIdx]; }
+    if (NextV[NIdx] != -1) { PrevV[NextV[NIdx]] = PrevV[NIdx]; }
+  }
+  void Link(const int& NIdx) {
+    const int Key = KeyV[NIdx];
+    while (HeadV.Len() <= Key) { HeadV.Add(-1); }
+    PrevV[NIdx] = -1;  NextV[NIdx] = HeadV[Key];
+    if (HeadV[Key] != -1) { PrevV[HeadV[Key]] = NIdx; }
+    HeadV[Key] = NIdx;
+    if (Key > Top) { Top = Key; }
+  }
+public:
+  TUnitHeap(const int& Nodes) : KeyV(Nodes), PrevV(Nodes), NextV(Nodes), HeadV(1), Top(0) {
+    HeadV[0] = -1;
+    for (int n = Nodes-1; n >= 0; n--) { Link(n); }
+  }
+  bool IsIn(const int& NIdx) const { return KeyV[NIdx] >= 0; }
+  void Inc(const int& NIdx) { if (IsIn(NIdx)) { Unlink(NIdx);  KeyV[NIdx]++;  Link(NIdx); } }
+  void Dec(const int& NIdx) { if (IsIn(NIdx)) { Unlink(NIdx);  KeyV[NIdx]--;  Link(NIdx); } }
+  void Del(const int& NIdx) { Unlink(NIdx);  KeyV[NIdx] = -1; }
+  int PopMax() {
+    while (HeadV[Top] == -1) { Top--; }
+    const int NIdx = HeadV[Top];
+    Del(NIdx);
+    return NIdx;
+  }
+};
+
+// Adds Add to the Gorder score of the nodes connected to NIdx: its neighbors and the nodes sharing an in-neighbor with it.
+// In-neighbors with more than HubDeg out-neighbors are skipped, as in the reference implementation.
+static void UpdateGorderScore(const TOrderGraph& G, const int& NIdx, const int& HubDeg, const bool& Add, TUnitHeap& Heap) {
+  for (int e = G.OffV[NIdx]; e < G.OffV[NIdx+1]; e++) {
+    if (Add) { Heap.Inc(G.NbrV[e]); } else { Heap.Dec(G.NbrV[e]); } }
+  const TIntV& InOffV = G.IsDir() ? G.InOffV : G.OffV;
+  const TIntV& InNbrV = G.IsDir() ? G.InNbrV : G.NbrV;
+  for (int e = InOffV[NIdx]; e < InOffV[NIdx+1]; e++) {
+    const int InIdx = InNbrV[e];
+    if (G.IsDir()) {
+      if (Add) { Heap.Inc(InIdx); } else { Heap.Dec(InIdx); } }
+    if (G.GetOutDeg(InIdx) > HubDeg) { continue; }
+    for (int s = G.OffV[InIdx]; s < G.OffV[InIdx+1]; s++) {
+      const int Sibling = G.NbrV[s];
+      if (Sibling == NIdx) { continue; }
+      if (Add) { Heap.Inc(Sibling); } else { Heap.Dec(Sibling); }
+    }
+  }
+}
+
+static void GetGorder(const TOrderGraph& G, const int& Window, TIntV& OrderV) {
+  const int Nodes = G.GetNodes();
+  OrderV.Gen(Nodes, 0);
+  if (Nodes == 0) { return; }
+  const int HubDeg = int(sqrt(double(Nodes)));
+  TUnitHeap Heap(Nodes);
+  int First = 0;
+  for (int n = 1; n < Nodes; n++) {
+    if (G.GetInDeg(n) > G.GetInDeg(First)) { First = n; } }
+  Heap.Del(First);
+  OrderV.Add(First);
+  for (int i = 1; i < Nodes; i++) {
+    // the last placed node enters the window, the node placed Window positions earlier leaves it
+    UpdateGorderScore(G, OrderV[i-1], HubDeg, true, Heap);
+    if (i > Window) { UpdateGorderScore(G, OrderV[i-Window-1], HubDeg, false, Heap); }
+    OrderV.Add(Heap.PopMax());
+  }
+}
+
+void GetNodeOrderV(const TIntV& OffV, const TIntV& NbrV, const TIntV& InOffV, const TIntV& InNbrV,
+    const TNodeOrder& Order, const int& Window, TIntV& OrderV) {
+  const TOrderGraph G(OffV, NbrV, InOffV, InNbrV);
+  switch (Order) {
+    case norDegree : GetDegreeOrder(G, OrderV);  break;
+    case norRcm : GetBfsOrder(G, true, OrderV);  break;
+    case norBfs : GetBfsOrder(G, false, OrderV);  break;
+    case norGorder : GetGorder(G, Window, OrderV);  break;
+    default : FailR("Unknown node order.");
+  }
+}
+
+} // namespace TSnapDetail
+} // namespace TSnap
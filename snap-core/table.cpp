@@ -153,11 +153,11 @@ TInt TRowIterator::GetRowIdx() const {
 }
 // We do not check column type in the iterator.
 TInt TRowIterator::GetIntAttr(TInt ColIdx) const {
-  return Table->IntCols[ColIdx][CurrRowIdx];
+  return Table->GetIntIdx(ColIdx, CurrRowIdx);
 }
 
 TFlt TRowIterator::GetFltAttr(TInt ColIdx) const {
-  return Table->FltCols[ColIdx][CurrRowIdx];
+  return Table->GetFltIdx(ColIdx, CurrRowIdx);
 }
 
 TStr TRowIterator::GetStrAttr(TInt ColIdx) const {
@@ -166,12 +166,12 @@ TStr TRowIterator::GetStrAttr(TInt ColIdx) const {
 
 TInt TRowIterator::GetIntAttr(const TStr& Col) const {
   TInt ColIdx = Table->GetColIdx(Col);
-  return Table->IntCols[ColIdx][CurrRowIdx];
+  return Table->GetIntIdx(ColIdx, CurrRowIdx);
 }
 
 TFlt TRowIterator::GetFltAttr(const TStr& Col) const {
   TInt ColIdx = Table->GetColIdx(Col);
-  return Table->FltCols[ColIdx][CurrRowIdx];
+  return Table->GetFltIdx(ColIdx, CurrRowIdx);
 }
 
 TStr TRowIterator::GetStrAttr(const TStr& Col) const {
@@ -180,11 +180,11 @@ TStr TRowIterator::GetStrAttr(const TStr& Col) const {
 
 TInt TRowIterator::GetStrMapByName(const TStr& Col) const {
   TInt ColIdx = Table->GetColIdx(Col);
-  return Table->StrColMaps[ColIdx][CurrRowIdx];
+  return Table->GetStrMapIdx(ColIdx, CurrRowIdx);
 }
 
 TInt TRowIterator::GetStrMapById(TInt ColIdx) const {
-  return Table->StrColMaps[ColIdx][CurrRowIdx];
+  return Table->GetStrMapIdx(ColIdx, CurrRowIdx);
 }
 
 TBool TRowIterator::CompareAtomicConst(TInt ColIdx, const TPrimitive& Val, TPredComp Cmp) {
@@ -246,11 +246,11 @@ TInt TRowIteratorWithRemove::GetNextRowIdx() const {
 
 // We do not check column type in the iterator.
 TInt TRowIteratorWithRemove::GetNextIntAttr(TInt ColIdx) const {
-  return Table->IntCols[ColIdx][GetNextRowIdx()];
+  return Table->GetIntIdx(ColIdx, GetNextRowIdx());
 }
 
 TFlt TRowIteratorWithRemove::GetNextFltAttr(TInt ColIdx) const {
-  return Table->FltCols[ColIdx][GetNextRowIdx()];
+  return Table->GetFltIdx(ColIdx, GetNextRowIdx());
 }
 
 TStr TRowIteratorWithRemove::GetNextStrAttr(TInt ColIdx) const {
@@ -259,12 +259,12 @@ TStr TRowIteratorWithRemove::GetNextStrAttr(TInt ColIdx) const {
 
 TInt TRowIteratorWithRemove::GetNextIntAttr(const TStr& Col) const {
   TInt ColIdx = Table->GetColIdx(Col);
-  return Table->IntCols[ColIdx][GetNextRowIdx()];
+  return Table->GetIntIdx(ColIdx, GetNextRowIdx());
 }
 
 TFlt TRowIteratorWithRemove::GetNextFltAttr(const TStr& Col) const {
   TInt ColIdx = Table->GetColIdx(Col);
-  return Table->FltCols[ColIdx][GetNextRowIdx()];
+  return Table->GetFltIdx(ColIdx, GetNextRowIdx());
 }
 
 TStr TRowIteratorWithRemove::GetNextStrAttr(const TStr& Col) const {
@@ -570,6 +570,7 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
   // allocate memory for columns
   TInt IntColIdx = 0;
   TInt FltColIdx = 0;
+  TInt StrColIdx = 0;
   for (TInt i = 0; i < RowLen; i++) {
     switch (ColTypes[i]) {
       case atInt:
@@ -581,16 +582,23 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
         FltColIdx++;
         break;
       case atStr:
+        T->StrColMaps[StrColIdx].Gen(Cnt);
+        StrColIdx++;
         break;
     }
   }
 
+  // every chunk interns its strings into its own shard, the shards are merged into the context below
+  TVec<TStrHash<TInt, TBigStrPool> > StrShardV(NumThreads);
+
   Cnt = 0;
   omp_set_num_threads(NumThreads);
   #pragma omp parallel for schedule(dynamic) reduction(+:Cnt)
   for (int i = 0; i < NumThreads; i++) {
     // calculate beginning of each line handled by thread
     TVec<uint64> LineStartPosV = Ss.GetStartPosV(StartIntV[i], StartIntV[i+1]);
+    TStrHash<TInt, TBigStrPool>& StrShard = StrShardV[i];
+    TChA StrVal;
 
     // parse line and fill rows
     for (uint64 k = 0; k < (uint64) LineStartPosV.Len(); k++) {
@@ -601,6 +609,7 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
       }
       TInt IntColIdx = 0;
       TInt FltColIdx = 0;
+      TInt StrColIdx = 0;
       TInt RowIdx = PrefixSumV[i] + k;
 
       for (TInt j = 0; j < RowLen; j++) {
@@ -626,7 +635,13 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
             FltColIdx++;
             break;
           case atStr:
-            TExcept::Throw("TTable::LoadSS:: Str Col found\n");
+            if (RelevantCols.Len() == 0) {
+              Ss.GetStrFromFldV(FieldsV, j, StrVal);
+            } else {
+              Ss.GetStrFromFldV(FieldsV, RelevantCols[j], StrVal);
+            }
+            T->StrColMaps[StrColIdx][RowIdx] = StrShard.AddKey(StrVal);
+            StrColIdx++;
             break;
         }
       }
@@ -634,6 +649,30 @@ void TTable::LoadSSPar(PTable& T, const Schema& S, const TStr& InFNm, const TInt
     }
   }
 
+  if (T->StrColMaps.Len() > 0) {
+    // only the distinct strings of each shard are added to the context, in the order of the
+    // chunks, so the ids are the same as with the sequential load
+    TVec<TIntV> StrIdVV(NumThreads);
+    for (int i = 0; i < NumThreads; i++) {
+      const TStrHash<TInt, TBigStrPool>& StrShard = StrShardV[i];
+      StrIdVV[i].Gen(StrShard.Len());
+      for (int KeyId = 0; KeyId < StrShard.Len(); KeyId++) {
+        StrIdVV[i][KeyId] = T->Context->StringVals.AddKey(StrShard.GetKey(KeyId));
+      }
+    }
+    omp_set_num_threads(NumThreads);
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < NumThreads; i++) {
+      const TIntV& StrIdV = StrIdVV[i];
+      for (int c = 0; c < T->StrColMaps.Len(); c++) {
+        TIntV& StrColV = T->StrColMaps[c];
+        for (int64 RowIdx = PrefixSumV[i]; RowIdx < int64(PrefixSumV[i] + LineCountV[i]); RowIdx++) {
+          StrColV[RowIdx] = StrIdV[StrColV[RowIdx]];
+        }
+      }
+    }
+  }
+
   // set number of rows and "Next" vector
   T->NumRows = Cnt;
   T->NumValidRows = T->NumRows;
@@ -757,7 +796,6 @@ void TTable::LoadSSSeq(
 PTable TTable::LoadSS(const Schema& S, const TStr& InFNm, TTableContext* Context,
  const TIntV& RelevantCols, const char& Separator, TBool HasTitleLine) {
   TVec<uint64> IntGroupByCols;
-  bool NoStringCols = true;
 
   // find the schema for the new table which contains only relevant columns
   Schema SR;
@@ -770,17 +808,8 @@ PTable TTable::LoadSS(const Schema& S, const TStr& InFNm, TTableContext* Context
   }
   PTable T = New(SR, Context);
 
-  // find col types and check for string cols
-  for (int i = 0; i < SR.Len(); i++) {
-    if (T->GetSchemaColType(i) == atStr) {
-      NoStringCols = false;
-      break;
-    }
-  }
-
-  if (GetMP() && NoStringCols) {
-    // Right now, can load in parallel only in Linux (for mmap) and if
-    // there are no string columns
+  if (GetMP()) {
+    // Right now, can load in parallel only in Linux (for mmap)
 #ifdef GLib_LINUX
     LoadSSPar(T, S, InFNm, RelevantCols, Separator, HasTitleLine);
 #else
@@ -851,15 +880,32 @@ void TTable::SaveBin(const TStr& OutFNm) {
   Save(SOut);
 }
 
+// Saves the columns ColV like TVec::Save does, packed columns are decoded a block at a time.
+template <class TVal, class TValV>
+static void SaveTableCols(TSOut& SOut, const TVec<TValV>& ColV, const TVec<TColPack>& PackV) {
+  SOut.Save(ColV.Len());  SOut.Save(ColV.Len());
+  TValV BlockV(TColPack::BlockLen);
+  for (int c = 0; c < ColV.Len(); c++) {
+    if (c >= PackV.Len() || PackV[c].Empty()) { ColV[c].Save(SOut);  continue; }
+    const int Vals = int(PackV[c].Len());
+    SOut.Save(Vals);  SOut.Save(Vals);
+    for (int Beg = 0; Beg < Vals; Beg += TColPack::BlockLen) {
+      const int Len = TMath::Mn(int(TColPack::BlockLen), Vals - Beg);
+      PackV[c].GetV(Beg, Beg + Len, (TVal*) BlockV.BegI());
+      for (int i = 0; i < Len; i++) { BlockV[i].Save(SOut); }
+    }
+  }
+}
+
 void TTable::Save(TSOut& SOut) {
   NumRows.Save(SOut);
   NumValidRows.Save(SOut);
   FirstValidRow.Save(SOut);
   LastValidRow.Save(SOut);
   Next.Save(SOut);
-  IntCols.Save(SOut);
-  FltCols.Save(SOut);
-  StrColMaps.Save(SOut);
+  SaveTableCols<int>(SOut, IntCols, IntColPacks);
+  SaveTableCols<double>(SOut, FltCols, FltColPacks);
+  SaveTableCols<int>(SOut, StrColMaps, StrColPacks);
 
   THash<TStr,TPair<TInt,TInt> > ColTypeIntMap;
   TInt atIntVal = TInt(0);
@@ -884,6 +930,219 @@ void TTable::Save(TSOut& SOut) {
   SOut.Flush();
 }
 
+void TTable::PutMmapBf(TSOut& SOut, int64& Pos, const int64& Off, const void* Bf, const int64& BfL) {
+  static const char ZeroBf[MmapPageSz] = { 0 };
+  IAssert(Pos <= Off);
+  while (Pos < Off) {
+    const int64 PadL = TMath::Mn(Off - Pos, int64(MmapPageSz));
+    SOut.PutBf(ZeroBf, TSize(PadL));  Pos += PadL;
+  }
+  if (BfL > 0) { SOut.PutBf(Bf, TSize(BfL));  Pos += BfL; }
+}
+
+void TTable::SaveMmap(TSOut& SOut) const {
+  const int Cols = Sch.Len();
+  // columns are read in chunks of rows, so packed columns are never decoded as a whole
+  const int ChunkLen = 1 << 16;
+  TIntV BufV;  TFltV FltBufV;
+  // the string dictionary holds only the strings used by the table; codes keep the order of the
+  // context ids, so a table whose strings are the first ids of its context is written unchanged
+  int MxStrId = -1;
+  for (int c = 0; c < StrColMaps.Len(); c++) {
+    for (int Beg = 0; Beg < NumRows; Beg += ChunkLen) {
+      const int Len = TMath::Mn(ChunkLen, NumRows - Beg);
+      const int* StrIdV = GetStrMapColBf(c, Beg, Len, BufV);
+      for (int RowN = 0; RowN < Len; RowN++) { MxStrId = TMath::Mx(MxStrId, StrIdV[RowN]); }
+    }
+  }
+  TIntV StrCodeV(MxStrId + 1);
+  StrCodeV.PutAll(-1);
+  for (int c = 0; c < StrColMaps.Len(); c++) {
+    for (int Beg = 0; Beg < NumRows; Beg += ChunkLen) {
+      const int Len = TMath::Mn(ChunkLen, NumRows - Beg);
+      const int* StrIdV = GetStrMapColBf(c, Beg, Len, BufV);
+      for (int RowN = 0; RowN < Len; RowN++) { StrCodeV[StrIdV[RowN]] = 0; }
+    }
+  }
+  TVec<TInt64> StrOffV;
+  TVec<char, int64> StrBf;
+  for (int StrId = 0; StrId <= MxStrId; StrId++) {
+    if (StrCodeV[StrId] == -1) { continue; }
+    StrCodeV[StrId] = StrOffV.Len();
+    StrOffV.Add(StrBf.Len());
+    // strings are stored with the terminating zero, so they can be used in place
+    const char* Str = Context->StringVals.GetKey(StrId);
+    do { StrBf.Add(*Str); } while (*Str++ != 0);
+  }
+  const bool IsStrIdCode = StrOffV.Len() == MxStrId + 1;
+  StrOffV.Add(StrBf.Len());
+
+  TMmapHdr Hdr;
+  memset(&Hdr, 0, sizeof(TMmapHdr));
+  memcpy(Hdr.Magic, "SNAPTBL", 8);
+  Hdr.ByteOrder = MmapByteOrder;  Hdr.Version = MmapVersion;
+  Hdr.Cols = Cols;  Hdr.IsNextDirty = IsNextDirty;
+  Hdr.NumRows = NumRows;  Hdr.NumValidRows = NumValidRows;
+  Hdr.FirstValidRow = FirstValidRow;  Hdr.LastValidRow = LastValidRow;
+  Hdr.Strs = StrOffV.Len() - 1;
+  // every array starts on a page boundary
+  int64 Off = MmapAlign(sizeof(TMmapHdr) + Cols * sizeof(TMmapCol));
+  Hdr.NextVOff = Off;  Off = MmapAlign(Off + NumRows * sizeof(TInt));
+  Hdr.StrOffVOff = Off;  Off = MmapAlign(Off + StrOffV.Len() * sizeof(TInt64));
+  Hdr.StrBfOff = Off;  Off = MmapAlign(Off + StrBf.Len());
+  TVec<TMmapCol> ColV(Cols);
+  for (int c = 0; c < Cols; c++) {
+    const TStr& ColNm = Sch[c].Val1;
+    const TPair<TAttrType, TInt>& ColType = ColTypeMap.GetDat(ColNm);
+    EAssertR(ColNm.Len() < int(sizeof(ColV[c].Nm)), "Column name '" + ColNm + "' is too long.");
+    memset(&ColV[c], 0, sizeof(TMmapCol));
+    memcpy(ColV[c].Nm, ColNm.CStr(), ColNm.Len());
+    ColV[c].Type = ColType.Val1;
+    ColV[c].Idx = ColType.Val2;
+    ColV[c].Off = Off;
+    Off = MmapAlign(Off + NumRows * (ColType.Val1 == atFlt ? sizeof(TFlt) : sizeof(TInt)));
+  }
+  Hdr.FileLen = Off;
+  int64 Pos = 0;
+  PutMmapBf(SOut, Pos, 0, &Hdr, sizeof(TMmapHdr));
+  for (int c = 0; c < Cols; c++) {
+    PutMmapBf(SOut, Pos, Pos, &ColV[c], sizeof(TMmapCol)); }
+  PutMmapBf(SOut, Pos, Hdr.NextVOff, Next.BegI(), NumRows * sizeof(TInt));
+  PutMmapBf(SOut, Pos, Hdr.StrOffVOff, StrOffV.BegI(), StrOffV.Len() * sizeof(TInt64));
+  PutMmapBf(SOut, Pos, Hdr.StrBfOff, StrBf.BegI(), StrBf.Len());
+  TIntV CodeV;
+  for (int c = 0; c < Cols; c++) {
+    const int Idx = ColV[c].Idx;
+    PutMmapBf(SOut, Pos, ColV[c].Off, NULL, 0);
+    for (int Beg = 0; Beg < NumRows; Beg += ChunkLen) {
+      const int Len = TMath::Mn(ChunkLen, NumRows - Beg);
+      switch (ColV[c].Type) {
+        case atInt:
+          PutMmapBf(SOut, Pos, Pos, GetIntColBf(Idx, Beg, Len, BufV), Len * sizeof(TInt));
+          break;
+        case atFlt:
+          PutMmapBf(SOut, Pos, Pos, GetFltColBf(Idx, Beg, Len, FltBufV), Len * sizeof(TFlt));
+          break;
+        case atStr: {
+          const int* StrIdV = GetStrMapColBf(Idx, Beg, Len, BufV);
+          if (IsStrIdCode) {
+            PutMmapBf(SOut, Pos, Pos, StrIdV, Len * sizeof(TInt));
+            break;
+          }
+          CodeV.Gen(Len);
+          for (int RowN = 0; RowN < Len; RowN++) { CodeV[RowN] = StrCodeV[StrIdV[RowN]]; }
+          PutMmapBf(SOut, Pos, Pos, CodeV.BegI(), Len * sizeof(TInt));
+          break;
+        }
+      }
+    }
+  }
+  PutMmapBf(SOut, Pos, Hdr.FileLen, NULL, 0);
+  SOut.Flush();
+}
+
+// Tests that [Off, Off+Len) lies within a memory-mapped table of FileLen bytes.
+static bool IsMmapRange(const int64& Off, const int64& Len, const int64& FileLen) {
+  return Off >= 0 && Len >= 0 && Off <= FileLen && Len <= FileLen - Off;
+}
+
+PTable TTable::LoadMmap(TShMIn& ShMIn, TTableContext* Context) {
+  char* Bf = ShMIn.getCursor();
+  const int64 BfL = int64(ShMIn.GetSizeLeft());
+  EAssertR(BfL >= int64(sizeof(TMmapHdr)), "Memory-mapped table is truncated.");
+  const TMmapHdr& Hdr = *(const TMmapHdr*) Bf;
+  EAssertR(memcmp(Hdr.Magic, "SNAPTBL", 8) == 0, "Input is not a memory-mapped table.");
+  EAssertR(Hdr.ByteOrder == MmapByteOrder, "Memory-mapped table was saved with a different byte order.");
+  EAssertR(Hdr.Version == MmapVersion, TStr::Fmt("Unsupported memory-mapped table version %d.", Hdr.Version));
+  // the header comes from the file, every array is checked to lie within it before it is used
+  const int64 FileLen = Hdr.FileLen;
+  EAssertR(IsMmapRange(0, FileLen, BfL), "Memory-mapped table is truncated.");
+  EAssertR(Hdr.NumRows >= 0 && Hdr.NumRows <= TInt::Mx && Hdr.NumValidRows >= 0 && Hdr.NumValidRows <= Hdr.NumRows,
+    "Invalid number of rows in memory-mapped table.");
+  EAssertR(Hdr.Cols >= 0 && IsMmapRange(sizeof(TMmapHdr), Hdr.Cols * int64(sizeof(TMmapCol)), FileLen),
+    "Invalid number of columns in memory-mapped table.");
+  EAssertR(IsMmapRange(Hdr.NextVOff, Hdr.NumRows * int64(sizeof(TInt)), FileLen), "Invalid offset of rows in memory-mapped table.");
+  EAssertR(Hdr.Strs >= 0 && Hdr.Strs <= TInt::Mx && IsMmapRange(Hdr.StrOffVOff, (Hdr.Strs + 1) * int64(sizeof(TInt64)), FileLen),
+    "Invalid string offsets in memory-mapped table.");
+  const TInt64* StrOffV = (const TInt64*) (Bf + Hdr.StrOffVOff);
+  const char* StrBf = Bf + Hdr.StrBfOff;
+  EAssertR(IsMmapRange(Hdr.StrBfOff, StrOffV[int(Hdr.Strs)], FileLen), "Invalid strings in memory-mapped table.");
+  for (int StrN = 0; StrN < Hdr.Strs; StrN++) {
+    const int64 StrEnd = StrOffV[StrN+1];
+    EAssertR(StrOffV[StrN] >= 0 && StrOffV[StrN] < StrEnd && StrBf[StrEnd-1] == 0, "Invalid strings in memory-mapped table.");
+  }
+  const TMmapCol* ColV = (const TMmapCol*) (Bf + sizeof(TMmapHdr));
+  int IntCols = 0, FltCols = 0, StrCols = 0;
+  for (int c = 0; c < Hdr.Cols; c++) {
+    EAssertR(memchr(ColV[c].Nm, 0, sizeof(ColV[c].Nm)) != NULL, "Invalid column name in memory-mapped table.");
+    switch (ColV[c].Type) {
+      case atInt: IntCols++; break;
+      case atFlt: FltCols++; break;
+      case atStr: StrCols++; break;
+      default: TExcept::Throw(TStr::Fmt("Unknown type of column '%s' in memory-mapped table.", ColV[c].Nm));
+    }
+    const int64 ElemSz = ColV[c].Type == atFlt ? sizeof(TFlt) : sizeof(TInt);
+    EAssertR(IsMmapRange(ColV[c].Off, Hdr.NumRows * ElemSz, FileLen),
+      TStr::Fmt("Invalid offset of column '%s' in memory-mapped table.", ColV[c].Nm));
+  }
+  // every column index of a type is used exactly once
+  TVec<TBoolV> IsColIdxV(3);
+  IsColIdxV[atInt].Gen(IntCols);  IsColIdxV[atFlt].Gen(FltCols);  IsColIdxV[atStr].Gen(StrCols);
+  for (int c = 0; c < Hdr.Cols; c++) {
+    TBoolV& IsIdxV = IsColIdxV[ColV[c].Type];
+    const int Idx = ColV[c].Idx;
+    EAssertR(0 <= Idx && Idx < IsIdxV.Len() && !IsIdxV[Idx],
+      TStr::Fmt("Invalid index of column '%s' in memory-mapped table.", ColV[c].Nm));
+    IsIdxV[Idx] = true;
+  }
+  PTable T = New(Context);
+  T->NumRows = int(Hdr.NumRows);  T->NumValidRows = int(Hdr.NumValidRows);
+  T->FirstValidRow = int(Hdr.FirstValidRow);  T->LastValidRow = int(Hdr.LastValidRow);
+  T->IsNextDirty = Hdr.IsNextDirty;
+  // the dictionary is added to the context, the codes are used as they are when they match the ids
+  TIntV StrIdV(int(Hdr.Strs));
+  bool IsStrIdCode = true;
+  for (int StrN = 0; StrN < Hdr.Strs; StrN++) {
+    StrIdV[StrN] = Context->AddStr(StrBf + StrOffV[StrN]);
+    IsStrIdCode = IsStrIdCode && StrIdV[StrN] == StrN;
+  }
+  // the vectors point into the mapped file, nothing is copied; they are copied before they are written
+  if (Hdr.NumRows > 0) { T->Next.GenExt((TInt*) (Bf + Hdr.NextVOff), int(Hdr.NumRows)); }
+  T->IntCols.Gen(IntCols);  T->FltCols.Gen(FltCols);  T->StrColMaps.Gen(StrCols);
+  for (int c = 0; c < Hdr.Cols; c++) {
+    const TAttrType ColType = TAttrType(ColV[c].Type);
+    const int Idx = ColV[c].Idx;
+    EAssertR(!T->IsColName(ColV[c].Nm), TStr::Fmt("Duplicate column '%s' in memory-mapped table.", ColV[c].Nm));
+    T->AddSchemaCol(ColV[c].Nm, ColType);
+    T->AddColType(ColV[c].Nm, ColType, Idx);
+    if (Hdr.NumRows == 0) { continue; }
+    if (ColType == atInt) {
+      T->IntCols[Idx].GenExt((TInt*) (Bf + ColV[c].Off), int(Hdr.NumRows));
+    } else if (ColType == atFlt) {
+      T->FltCols[Idx].GenExt((TFlt*) (Bf + ColV[c].Off), int(Hdr.NumRows));
+    } else if (IsStrIdCode) {
+      T->StrColMaps[Idx].GenExt((TInt*) (Bf + ColV[c].Off), int(Hdr.NumRows));
+    } else {
+      // the context already had other strings, the codes are translated to its ids
+      const TInt* CodeV = (const TInt*) (Bf + ColV[c].Off);
+      TIntV& StrColV = T->StrColMaps[Idx];
+      StrColV.Gen(int(Hdr.NumRows));
+      const int Rows = int(Hdr.NumRows), Strs = int(Hdr.Strs);
+      int BadCodes = 0;
+#ifdef USE_OPENMP
+      #pragma omp parallel for schedule(static) reduction(+:BadCodes)
+#endif
+      for (int RowN = 0; RowN < Rows; RowN++) {
+        const int Code = CodeV[RowN];
+        if (0 <= Code && Code < Strs) { StrColV[RowN] = StrIdV[Code]; } else { BadCodes++; }
+      }
+      EAssertR(BadCodes == 0, TStr::Fmt("Invalid string in column '%s' of memory-mapped table.", ColV[c].Nm));
+    }
+  }
+  ShMIn.AdvanceCursor(TSize(FileLen));
+  return T;
+}
+
 void TTable::Dump(FILE *OutF) const {
   TInt L = Sch.Len();
   Schema DSch = DenormalizeSchema();
@@ -934,7 +1193,7 @@ TTableContext* TTable::ChangeContext(TTableContext* NewContext) {
     // iterate over all rows
     for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
       TInt RowIdx = RowI.GetRowIdx();
-      TInt KeyId = StrColMaps[ColIdx][RowIdx];
+      TInt KeyId = GetStrMapIdx(ColIdx, RowIdx);
       printf("ChangeContext in  %d  %d  %d  .%s.\n",
           ColIdx.Val, RowIdx.Val, KeyId.Val, GetStrVal(ColIdx, RowIdx).CStr());
     }
@@ -950,6 +1209,7 @@ TTableContext* TTable::ChangeContext(TTableContext* NewContext) {
     }
 
     TInt ColIdx = GetColIdx(GetSchemaColName(i));
+    UnpackColIdx(atStr, ColIdx);
 
     // iterate over all rows
     for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
@@ -971,6 +1231,7 @@ TTableContext* TTable::ChangeContext(TTableContext* NewContext) {
 void TTable::AddStrVal(const TInt& ColIdx, const TStr& Key) {
   TInt KeyId = TInt(Context->StringVals.AddKey(Key));
   //printf("TTable::AddStrVal2  %d  .%s.  %d\n", ColIdx.Val, Key.CStr(), KeyId.Val);
+  UnpackColIdx(atStr, ColIdx);
   StrColMaps[ColIdx].Add(KeyId);
 }
 
@@ -1124,12 +1385,13 @@ void TTable::RemoveFirstRow() {
     LastValidRow = -1;
   }
 
+  CopyMappedV(Next);
   TInt Old = FirstValidRow;
   FirstValidRow = Next[FirstValidRow];
   Next[Old] = TTable::Invalid;
   NumValidRows--;
   TInt IdColIdx = GetColIdx(GetIdColName());
-  RowIdMap.AddDat(IntCols[IdColIdx][Old], Invalid);
+  if (IdColIdx >= 0) { RowIdMap.AddDat(GetIntIdx(IdColIdx, Old), Invalid); }
 }
 
 void TTable::RemoveRow(TInt RowIdx, TInt PrevRowIdx) {
@@ -1139,6 +1401,7 @@ void TTable::RemoveRow(TInt RowIdx, TInt PrevRowIdx) {
   }
   Assert(RowIdx != TTable::Invalid);
   if (RowIdx == TTable::Last) { return; }
+  CopyMappedV(Next);
   Next[PrevRowIdx] = Next[RowIdx];
   if (LastValidRow == RowIdx) {
     LastValidRow = RowIdx;
@@ -1146,7 +1409,7 @@ void TTable::RemoveRow(TInt RowIdx, TInt PrevRowIdx) {
   Next[RowIdx] = TTable::Invalid;
   NumValidRows--;
   TInt IdColIdx = GetColIdx(GetIdColName());
-  RowIdMap.AddDat(IntCols[IdColIdx][RowIdx], Invalid);
+  if (IdColIdx >= 0) { RowIdMap.AddDat(GetIntIdx(IdColIdx, RowIdx), Invalid); }
 }
 
 void TTable::KeepSortedRows(const TIntV& KeepV) {
@@ -1223,43 +1486,52 @@ void TTable::GroupingSanityCheck(const TStr& GroupBy, const TAttrType& AttrType)
 
 #ifdef GCC_ATOMIC
 void TTable::GroupByIntColMP(const TStr& GroupBy, THashMP<TInt, TIntV>& Grouping, TBool UsePhysicalIds) const {
-  timeval timer0;
-  gettimeofday(&timer0, NULL);
-  //double t1 = timer0.tv_sec + (timer0.tv_usec/1000000.0);
-  //printf("X\n");
   TInt IdColIdx = GetColIdx(IdColName);
   TInt GroupByColIdx = GetColIdx(GroupBy);
   if(!UsePhysicalIds && IdColIdx < 0){
   	TExcept::Throw("Grouping: Either use physical row ids, or have an id column");
   }
-  //double startFn = omp_get_wtime();
   GroupingSanityCheck(GroupBy, atInt);
   TIntPrV Partitions;
   GetPartitionRanges(Partitions, 8*CHUNKS_PER_THREAD);
-  TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-  //double endPart = omp_get_wtime();
-  //printf("Partition time = %f\n", endPart-startFn);
-
-  Grouping.Gen(NumValidRows);
-  //double endGen = omp_get_wtime();
-  //printf("Gen time = %f\n", endGen-endPart);
-  //printf("S\n");
-  #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD) //num_threads(1)
+
+  // count the rows of each group, the number of groups is not known up front
+  THashMPGrow<TInt, TInt> GroupH;
+  TIntV RowKeyIdV(NumRows);
+  #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD)
+  for (int i = 0; i < Partitions.Len(); i++){
+    TRowIterator RowI(Partitions[i].GetVal1(), this);
+    TRowIterator EndI(Partitions[i].GetVal2(), this);
+    while (RowI < EndI) {
+      const int KeyId = GroupH.AddKey(RowI.GetIntAttr(GroupByColIdx));
+      __sync_fetch_and_add(&GroupH[KeyId].Val, 1);
+      RowKeyIdV[RowI.GetRowIdx()] = KeyId;
+      RowI++;
+    }
+  }
+
+  // allocate the groups, the counts become the next free position of a group
+  Grouping.Gen(GroupH.Len());
+  TIntV GroupIdV(GroupH.GetMxKeyIds());
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (int KeyId = 0; KeyId < GroupH.GetMxKeyIds(); KeyId++) {
+    if (!GroupH.IsKeyId(KeyId)) { continue; }
+    GroupIdV[KeyId] = Grouping.AddKey(GroupH.GetKey(KeyId));
+    Grouping[GroupIdV[KeyId]].Gen(GroupH[KeyId]);
+    GroupH[KeyId] = 0;
+  }
+
+  #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD)
   for (int i = 0; i < Partitions.Len(); i++){
     TRowIterator RowI(Partitions[i].GetVal1(), this);
     TRowIterator EndI(Partitions[i].GetVal2(), this);
     while (RowI < EndI) {
+      const int KeyId = RowKeyIdV[RowI.GetRowIdx()];
       TInt idx = UsePhysicalIds ? RowI.GetRowIdx() : RowI.GetIntAttr(IdColIdx);
-      // printf("updating grouping with key = %d, row_id = %d\n", RowI.GetIntAttr(GroupBy).Val, idx.Val);
-      UpdateGrouping<TInt>(Grouping, RowI.GetIntAttr(GroupByColIdx), idx);
+      Grouping[GroupIdV[KeyId]][__sync_fetch_and_add(&GroupH[KeyId].Val, 1)] = idx;
       RowI++;
     }
   }
-  gettimeofday(&timer0, NULL);
-  //double t2 = timer0.tv_sec + (timer0.tv_usec/1000000.0);
-  //printf("Grouping time: %f\n", t2 - t1);
-  //double endAdd = omp_get_wtime();
-  //printf("Add time = %f\n", endAdd-endGen);
 }
 #endif // GCC_ATOMIC
 
@@ -1386,7 +1658,7 @@ void TTable::GroupAux(const TStrV& GroupBy, THash<TGroupKey, TPair<TInt, TIntV>
     TGroupKey GroupKey = TGroupKey(IKey, FKey);
 
     TInt RowIdx = it.GetRowIdx();
-    TInt idx = UsePhysicalIds ? it.GetRowIdx() : IntCols[IdColIdx][it.GetRowIdx()];
+    TInt idx = UsePhysicalIds ? it.GetRowIdx() : TInt(GetIntIdx(IdColIdx, it.GetRowIdx()));
     if (!Grouping.IsKey(GroupKey)) {
       // Grouping key hasn't been seen before, create a new group
       TPair<TInt, TIntV> NewGroup;
@@ -1510,7 +1782,7 @@ void TTable::GroupAuxMP(const TStrV& GroupBy, THashGenericMP<TGroupKey, TPair<TI
       TPair<TInt, TIntV> NewGroup;
       NewGroup.Val1 = GroupNum;
       if(IdColIdx > 0){
-      	NewGroup.Val2.Add(IntCols[IdColIdx][RowIdx]);
+      	NewGroup.Val2.Add(GetIntIdx(IdColIdx, RowIdx));
       }
       Grouping.AddDat(GroupKey, NewGroup);
       if (GroupColName != "") {
@@ -1525,7 +1797,7 @@ void TTable::GroupAuxMP(const TStrV& GroupBy, THashGenericMP<TGroupKey, TPair<TI
       if (!KeepUnique) {
         TPair<TInt, TIntV>& NewGroup = Grouping.GetDat(GroupKey);
         if(IdColIdx > 0){
-        	NewGroup.Val2.Add(IntCols[IdColIdx][RowIdx]);
+        	NewGroup.Val2.Add(GetIntIdx(IdColIdx, RowIdx));
         }
         if (GroupColName != "") {
           GroupAndRowIds.Add(TPair<TInt, TInt>(NewGroup.Val1, RowIdx));
@@ -1566,12 +1838,368 @@ void TTable::GroupAuxMP(const TStrV& GroupBy, THashGenericMP<TGroupKey, TPair<TI
 #endif // USE_OPENMP
 */
 
+// Column-wise grouping packs the group-by key of every row into one 64-bit word: int columns and string ids
+// take the bits of their value range, a float column takes all 64 bits.
+static const int TableGroupMPRows = 1<<16;
+static const int TableGroupDigitBits = 11;
+static const int TableGroupSamples = 1<<12;
+
+static inline uint64 TableHashMix(uint64 Key) {
+  Key ^= Key >> 33;
+  Key *= 0xff51afd7ed558ccdULL;
+  Key ^= Key >> 33;
+  Key *= 0xc4ceb9fe1a85ec53ULL;
+  return Key ^ (Key >> 33);
+}
+
+class TTableGroupHashFunc {
+public:
+  static inline int GetPrimHashCd(const TUInt64& Key) { return int(TableHashMix(Key.Val)); }
+  static inline int GetSecHashCd(const TUInt64& Key) { return int(TableHashMix(Key.Val) >> 32); }
+};
+
+static int GetTableGroupChunks(const int& Rows, const bool& MP) {
+#ifdef USE_OPENMP
+  if (MP && Rows > TableGroupMPRows) { return omp_get_max_threads(); }
+#endif
+  return 1;
+}
+
+// Estimates from evenly spaced rows whether the keys have few distinct values.
+static bool IsTableGroupFewKeys(const TVec<TUInt64>& KeyV) {
+  const int Rows = KeyV.Len();
+  const int Samples = TMath::Mn(Rows, TableGroupSamples);
+  TVec<TUInt64> SampleV(Samples);
+  for (int s = 0; s < Samples; s++) { SampleV[s] = KeyV[int(int64(s) * Rows / Samples)]; }
+  SampleV.Sort();
+  int Distinct = 0;
+  for (int s = 0; s < Samples; s++) {
+    if (s == 0 || SampleV[s] != SampleV[s-1]) { Distinct++; }
+  }
+  return 4 * Distinct <= Samples;
+}
+
+// Numbers distinct keys in the order of their first appearance. Every chunk of rows numbers its keys in a hash
+// table of its own, the chunk tables are then merged in chunk order. Suits keys with few distinct values.
+static int GetTableGroupIdsHash(const TVec<TUInt64>& KeyV, const bool& MP, TIntV& GroupIdV) {
+  typedef THashFlat<TUInt64, TInt, TTableGroupHashFunc> TKeyH;
+  const int Rows = KeyV.Len();
+  const int Chunks = GetTableGroupChunks(Rows, MP);
+  const int ChunkRows = (Rows + Chunks - 1) / Chunks;
+  TVec<TKeyH> ChunkHV(Chunks);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+  for (int c = 0; c < Chunks; c++) {
+    const int End = TMath::Mn(Rows, (c + 1) * ChunkRows);
+    for (int i = c * ChunkRows; i < End; i++) { GroupIdV[i] = ChunkHV[c].AddKey(KeyV[i]); }
+  }
+  if (Chunks == 1) { return ChunkHV[0].Len(); }
+  TKeyH GroupH;
+  TVec<TIntV> ChunkIdVV(Chunks);
+  for (int c = 0; c < Chunks; c++) {
+    ChunkIdVV[c].Gen(ChunkHV[c].Len());
+    for (int k = 0; k < ChunkHV[c].Len(); k++) { ChunkIdVV[c][k] = GroupH.AddKey(ChunkHV[c].GetKey(k)); }
+  }
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int c = 0; c < Chunks; c++) {
+    const int End = TMath::Mn(Rows, (c + 1) * ChunkRows);
+    for (int i = c * ChunkRows; i < End; i++) { GroupIdV[i] = ChunkIdVV[c][GroupIdV[i]]; }
+  }
+  return GroupH.Len();
+}
+
+// One stable pass of a LSD radix sort on the digit of KeyV at Shift.
+static void TableGroupSortPass(const TVec<TUInt64>& KeyV, const TIntV& PosV, const int& Shift, const bool& MP,
+ TVec<TUInt64>& OutKeyV, TIntV& OutPosV) {
+  const int Rows = KeyV.Len();
+  const int Digits = 1 << TableGroupDigitBits;
+  const int Chunks = GetTableGroupChunks(Rows, MP);
+  const int ChunkRows = (Rows + Chunks - 1) / Chunks;
+  // CntV holds the histogram of every chunk, and then the chunk's write position for every digit
+  TIntV CntV(Chunks * Digits);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+  for (int c = 0; c < Chunks; c++) {
+    int* Cnt = (int*) CntV.BegI() + c * Digits;
+    const int End = TMath::Mn(Rows, (c + 1) * ChunkRows);
+    for (int i = c * ChunkRows; i < End; i++) { Cnt[(KeyV[i].Val >> Shift) & (Digits - 1)]++; }
+  }
+  int Off = 0;
+  for (int d = 0; d < Digits; d++) {
+    for (int c = 0; c < Chunks; c++) {
+      const int Cnt = CntV[c * Digits + d];
+      CntV[c * Digits + d] = Off;
+      Off += Cnt;
+    }
+  }
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+  for (int c = 0; c < Chunks; c++) {
+    int* Pos = (int*) CntV.BegI() + c * Digits;
+    const int End = TMath::Mn(Rows, (c + 1) * ChunkRows);
+    for (int i = c * ChunkRows; i < End; i++) {
+      const int j = Pos[(KeyV[i].Val >> Shift) & (Digits - 1)]++;
+      OutKeyV[j] = KeyV[i];
+      OutPosV[j] = PosV[i];
+    }
+  }
+}
+
+// Numbers distinct keys in the order of their first appearance by a stable radix sort of the row positions
+// on the low Bits of the keys. Suits keys with many distinct values.
+static int GetTableGroupIdsSort(const TVec<TUInt64>& KeyV, const int& Bits, const bool& MP, TIntV& GroupIdV) {
+  const int Rows = KeyV.Len();
+  TVec<TUInt64> SrcKeyV(KeyV), DstKeyV(Rows);
+  TIntV SrcPosV(Rows), DstPosV(Rows);
+  for (int i = 0; i < Rows; i++) { SrcPosV[i] = i; }
+  for (int Shift = 0; Shift < Bits; Shift += TableGroupDigitBits) {
+    TableGroupSortPass(SrcKeyV, SrcPosV, Shift, MP, DstKeyV, DstPosV);
+    SrcKeyV.Swap(DstKeyV);
+    SrcPosV.Swap(DstPosV);
+  }
+  // a run of equal keys is a group, the sort is stable so a run starts at the group's first row
+  TIntV FirstIdV(Rows);
+  for (int k = 0; k < Rows; k++) {
+    if (k == 0 || SrcKeyV[k] != SrcKeyV[k-1]) { FirstIdV[SrcPosV[k]] = 1; }
+  }
+  int Groups = 0;
+  for (int i = 0; i < Rows; i++) {
+    if (FirstIdV[i] == 1) { FirstIdV[i] = Groups++; }
+  }
+  int GroupId = 0;
+  for (int k = 0; k < Rows; k++) {
+    if (k == 0 || SrcKeyV[k] != SrcKeyV[k-1]) { GroupId = FirstIdV[SrcPosV[k]]; }
+    GroupIdV[SrcPosV[k]] = GroupId;
+  }
+  return Groups;
+}
+
+// Lists the positions of every group one after another, positions of a group are in increasing order.
+static void GetTableGroupPosV(const TIntV& GroupIdV, const int& Groups, TIntV& GrpOffV, TIntV& GrpPosV) {
+  const int Rows = GroupIdV.Len();
+  GrpOffV.Gen(Groups + 1);
+  int* Off = (int*) GrpOffV.BegI();
+  for (int i = 0; i < Rows; i++) { Off[GroupIdV[i] + 1]++; }
+  for (int g = 0; g < Groups; g++) { Off[g + 1] += Off[g]; }
+  TIntV PosV(GrpOffV);
+  int* Pos = (int*) PosV.BegI();
+  GrpPosV.Gen(Rows);
+  for (int i = 0; i < Rows; i++) { GrpPosV[Pos[GroupIdV[i]]++] = i; }
+}
+
+// Aggregates the values of every group in one pass over its rows and stores the result in all of them.
+template <class TVal, class TSum>
+static void TableAggregateGroups(const TVal* ValV, const TIntV& GrpOffV, const TIntV& GrpRowV, TAttrAggr AggOp,
+ TVal* ResV, const bool& MP) {
+  const int Groups = GrpOffV.Len() - 1;
+#ifdef USE_OPENMP
+  #pragma omp parallel if (MP && GrpRowV.Len() > TableGroupMPRows)
+#endif
+  {
+    TVec<TVal> MedianV;
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (int g = 0; g < Groups; g++) {
+      const int Beg = GrpOffV[g];
+      const int End = GrpOffV[g+1];
+      if (Beg == End) { continue; }
+      TVal Res = ValV[GrpRowV[Beg]];
+      switch (AggOp) {
+        case aaMin:
+          for (int k = Beg + 1; k < End; k++) { if (ValV[GrpRowV[k]] < Res) { Res = ValV[GrpRowV[k]]; } }
+          break;
+        case aaMax:
+          for (int k = Beg + 1; k < End; k++) { if (ValV[GrpRowV[k]] > Res) { Res = ValV[GrpRowV[k]]; } }
+          break;
+        case aaLast:
+          Res = ValV[GrpRowV[End-1]];
+          break;
+        case aaSum:
+        case aaMean: {
+          TSum Sum = Res;
+          for (int k = Beg + 1; k < End; k++) { Sum += ValV[GrpRowV[k]]; }
+          if (AggOp == aaMean) { Sum /= (End - Beg); }
+          Res = TVal(Sum);
+          break;
+        }
+        case aaMedian:
+          MedianV.Clr(false);
+          for (int k = Beg; k < End; k++) { MedianV.Add(ValV[GrpRowV[k]]); }
+          MedianV.Sort();
+          Res = MedianV[MedianV.Len()/2];
+          break;
+        default:
+          break;
+      }
+      for (int k = Beg; k < End; k++) { ResV[GrpRowV[k]] = Res; }
+    }
+  }
+}
+
+TBool TTable::GetGroupIdV(const TStrV& GroupBy, const TBool& Ordered, TIntV& RowV, TIntV& GroupIdV, TInt& Groups) const {
+  TVec<TPair<TAttrType, TInt> > ColV;
+  TIntV TypeCntV(3);
+  for (int c = 0; c < GroupBy.Len(); c++) {
+    if (!IsColName(GroupBy[c])) { TExcept::Throw("no such column " + GroupBy[c]); }
+    ColV.Add(GetColTypeMap(GroupBy[c]));
+    TypeCntV[ColV.Last().Val1] += 1;
+  }
+  // unordered keys compare the values of each type as a multiset, GroupAux handles them
+  if (!Ordered && (TypeCntV[atInt] > 1 || TypeCntV[atFlt] > 1 || TypeCntV[atStr] > 1)) { return false; }
+  const bool MP = GetMP();
+  RowV.Gen(NumValidRows, 0);
+  for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) { RowV.Add(RowI.GetRowIdx()); }
+  const int Rows = RowV.Len();
+  const int Chunks = GetTableGroupChunks(Rows, MP);
+  const int ChunkRows = (Rows + Chunks - 1) / Chunks;
+  TVec<TUInt64> KeyV(Rows);
+  int Bits = 0;
+  for (int c = 0; c < ColV.Len(); c++) {
+    if (ColV[c].Val1 == atFlt) {
+      if (Bits > 0) { return false; }
+      Bits = 64;
+      const int ColIdx = ColV[c].Val2;
+#ifdef USE_OPENMP
+      #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+      for (int i = 0; i < Rows; i++) {
+        // 0.0 and -0.0 are the same key
+        const double Val = GetFltIdx(ColIdx, RowV[i]) + 0.0;
+        memcpy(&KeyV[i].Val, &Val, sizeof(Val));
+      }
+      continue;
+    }
+    const TAttrType Type = ColV[c].Val1;
+    const int ColIdx = ColV[c].Val2;
+    TIntV MnV(Chunks), MxV(Chunks);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+    for (int t = 0; t < Chunks; t++) {
+      const int End = TMath::Mn(Rows, (t + 1) * ChunkRows);
+      int Mn = TInt::Mx, Mx = TInt::Mn;
+      for (int i = t * ChunkRows; i < End; i++) {
+        const int Val = GetIntKeyIdx(Type, ColIdx, RowV[i]);
+        Mn = TMath::Mn(Mn, Val);
+        Mx = TMath::Mx(Mx, Val);
+      }
+      MnV[t] = Mn;
+      MxV[t] = Mx;
+    }
+    int Mn = TInt::Mx, Mx = TInt::Mn;
+    for (int t = 0; t < Chunks; t++) {
+      Mn = TMath::Mn(Mn, MnV[t].Val);
+      Mx = TMath::Mx(Mx, MxV[t].Val);
+    }
+    if (Rows == 0) { Mn = Mx = 0; }
+    const uint64 Range = uint64(int64(Mx) - int64(Mn));
+    int ColBits = 0;
+    while (ColBits < 64 && (Range >> ColBits) != 0) { ColBits++; }
+    if (Bits + ColBits > 64) { return false; }
+    Bits += ColBits;
+    if (ColBits == 0) { continue; }
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+    for (int i = 0; i < Rows; i++) {
+      KeyV[i].Val = (KeyV[i].Val << ColBits) | uint64(int64(GetIntKeyIdx(Type, ColIdx, RowV[i])) - int64(Mn));
+    }
+  }
+  GroupIdV.Gen(Rows);
+  if (Rows == 0) {
+    Groups = 0;
+  } else if (IsTableGroupFewKeys(KeyV)) {
+    Groups = GetTableGroupIdsHash(KeyV, MP, GroupIdV);
+  } else {
+    Groups = GetTableGroupIdsSort(KeyV, Bits, MP, GroupIdV);
+  }
+  return true;
+}
+
+void TTable::AggregateGroups(const TIntV& GrpOffV, const TIntV& GrpRowV, TAttrAggr AggOp, const TAttrType& ValType,
+ const TInt& ValColIdx, const TInt& ResColIdx) {
+  const bool MP = GetMP();
+  if (AggOp == aaCount) {
+    int* ResV = (int*) IntCols[ResColIdx].BegI();
+    const int Groups = GrpOffV.Len() - 1;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 64) if (MP && GrpRowV.Len() > TableGroupMPRows)
+#endif
+    for (int g = 0; g < Groups; g++) {
+      for (int k = GrpOffV[g]; k < GrpOffV[g+1]; k++) { ResV[GrpRowV[k]] = GrpOffV[g+1] - GrpOffV[g]; }
+    }
+  } else if (ValType == atInt) {
+    // groups read their rows in any order, so a packed value column is decoded to a buffer
+    TIntV BufV;
+    TableAggregateGroups<int, int64>(GetIntColBf(ValColIdx, 0, NumRows, BufV), GrpOffV, GrpRowV, AggOp,
+     (int*) IntCols[ResColIdx].BegI(), MP);
+  } else {
+    TFltV BufV;
+    TableAggregateGroups<double, double>(GetFltColBf(ValColIdx, 0, NumRows, BufV), GrpOffV, GrpRowV, AggOp,
+     (double*) FltCols[ResColIdx].BegI(), MP);
+  }
+}
+
 void TTable::Group(const TStrV& GroupBy, const TStr& GroupColName, TBool Ordered, TBool UsePhysicalIds) {
   TStrV NGroupBy = NormalizeColNameV(GroupBy);
   TStr NGroupColName = NormalizeColName(GroupColName);
-  TIntV UniqueVec;
-  THash<TGroupKey, TPair<TInt, TIntV> > Grouping;
-  GroupAux(NGroupBy, Grouping, Ordered, NGroupColName, false, UniqueVec, UsePhysicalIds);
+  TInt IdColIdx = GetColIdx(IdColName);
+  TIntV RowV, GroupIdV;
+  TInt Groups;
+  if ((!UsePhysicalIds && IdColIdx < 0) || !GetGroupIdV(NGroupBy, Ordered, RowV, GroupIdV, Groups)) {
+    TIntV UniqueVec;
+    THash<TGroupKey, TPair<TInt, TIntV> > Grouping;
+    GroupAux(NGroupBy, Grouping, Ordered, NGroupColName, false, UniqueVec, UsePhysicalIds);
+    return;
+  }
+  TIntV GrpOffV, GrpPosV;
+  GetTableGroupPosV(GroupIdV, Groups, GrpOffV, GrpPosV);
+
+  // update group mapping, group keys are taken from the first row of each group
+  GroupStmt Stmt(NGroupBy, Ordered, UsePhysicalIds);
+  GroupStmtNames.AddDat(NGroupColName, Stmt);
+  THash<TInt, TGroupKey>& IdMapping = GroupIDMapping.AddDat(Stmt);
+  THash<TGroupKey, TIntV>& KeyMapping = GroupMapping.AddDat(Stmt);
+  TIntV IntGroupByCols, FltGroupByCols, StrGroupByCols;
+  for (int c = 0; c < NGroupBy.Len(); c++) {
+    TPair<TAttrType, TInt> ColType = GetColTypeMap(NGroupBy[c]);
+    switch (ColType.Val1) {
+      case atInt: IntGroupByCols.Add(ColType.Val2); break;
+      case atFlt: FltGroupByCols.Add(ColType.Val2); break;
+      case atStr: StrGroupByCols.Add(ColType.Val2); break;
+    }
+  }
+  for (int g = 0; g < Groups; g++) {
+    const int FirstRow = RowV[GrpPosV[GrpOffV[g]]];
+    TIntV IKey(IntGroupByCols.Len() + StrGroupByCols.Len(), 0);
+    TFltV FKey(FltGroupByCols.Len(), 0);
+    for (int c = 0; c < IntGroupByCols.Len(); c++) { IKey.Add(GetIntIdx(IntGroupByCols[c], FirstRow)); }
+    for (int c = 0; c < StrGroupByCols.Len(); c++) { IKey.Add(GetStrMapIdx(StrGroupByCols[c], FirstRow)); }
+    for (int c = 0; c < FltGroupByCols.Len(); c++) { FKey.Add(GetFltIdx(FltGroupByCols[c], FirstRow)); }
+    TIntV GroupRows(GrpOffV[g+1] - GrpOffV[g], 0);
+    for (int k = GrpOffV[g]; k < GrpOffV[g+1]; k++) {
+      const int RowIdx = RowV[GrpPosV[k]];
+      GroupRows.Add(UsePhysicalIds ? RowIdx : GetIntIdx(IdColIdx, RowIdx));
+    }
+    TGroupKey GroupKey(IKey, FKey);
+    IdMapping.AddDat(g, GroupKey);
+    KeyMapping.AddDat(GroupKey, GroupRows);
+  }
+
+  // add a column to the table
+  if (NGroupColName != "") {
+    IntCols.Add(TIntV(NumRows));
+    TIntV& GroupCol = IntCols.Last();
+    AddColType(NGroupColName, atInt, IntCols.Len()-1);
+    for (int i = 0; i < RowV.Len(); i++) { GroupCol[RowV[i]] = GroupIdV[i]; }
+    AddSchemaCol(NGroupColName, atInt);
+  }
 }
 
 void TTable::InvalidatePhysicalGroupings(){
@@ -1591,86 +2219,49 @@ void TTable::Aggregate(const TStrV& GroupByAttrs, TAttrAggr AggOp,
     }
    }
     
-  // double startFn = omp_get_wtime();
   TStrV NGroupByAttrs = NormalizeColNameV(GroupByAttrs);
   TBool UsePhysicalIds = (GetColIdx(IdColName) < 0);
-  
-  THash<TInt,TIntV> GroupByIntMapping;
-  THash<TFlt,TIntV> GroupByFltMapping;
-  THash<TInt,TIntV> GroupByStrMapping;
-  THash<TGroupKey,TIntV> Mapping;
-#ifdef GCC_ATOMIC
-  THashMP<TInt,TIntV> GroupByIntMapping_MP(NumValidRows);
-  TIntV GroupByIntMPKeys(NumValidRows);
-#endif
-  TInt NumOfGroups = 0;
-  TInt GroupingCase = 0;
 
+  // rows of group g are the physical rows GrpRowV[GrpOffV[g]], ..., GrpRowV[GrpOffV[g+1]-1]
+  TIntV GrpOffV, GrpRowV;
+  TIntV RowV, GroupIdV;
+  TInt NumOfGroups = 0;
   // check if grouping already exists
   GroupStmt Stmt(NGroupByAttrs, Ordered, UsePhysicalIds);
-  if (GroupMapping.IsKey(Stmt)) {
-    Mapping = GroupMapping.GetDat(Stmt);
-  } else{
-  	if(NGroupByAttrs.Len() == 1){
-  		switch(GetColType(NGroupByAttrs[0])){
-  			case atInt:
-#ifdef GCC_ATOMIC
-  				if(GetMP()){
-  					GroupByIntColMP(NGroupByAttrs[0], GroupByIntMapping_MP, UsePhysicalIds);
-  					int x = 0;
-					for(THashMP<TInt,TIntV>::TIter it = GroupByIntMapping_MP.BegI(); it < GroupByIntMapping_MP.EndI(); it++){
-						GroupByIntMPKeys[x] = it.GetKey();
-						x++;
-						/*
-						printf("%d --> ", it.GetKey().Val);
-						TIntV& V = it.GetDat();
-						for(int i = 0; i < V.Len(); i++){
-							printf(" %d", V[i].Val); 
-						}
-						printf("\n");
-						*/
-					}
-  					NumOfGroups = x;
-  					GroupingCase = 4;
-  					//printf("Number of groups: %d\n", NumOfGroups.Val);
-  					break;
-  				}
-#endif // GCC_ATOMIC
-  				GroupByIntCol(NGroupByAttrs[0], GroupByIntMapping, TIntV(), true, UsePhysicalIds);
-  				NumOfGroups = GroupByIntMapping.Len();
-  				GroupingCase = 1;
-  				break;
-  			case atFlt:
-  				GroupByFltCol(NGroupByAttrs[0], GroupByFltMapping, TIntV(), true, UsePhysicalIds);
-  				NumOfGroups = GroupByFltMapping.Len();
-  				GroupingCase = 2;
-  				break;
-  			case atStr:
-  				GroupByStrCol(NGroupByAttrs[0], GroupByStrMapping, TIntV(), true, UsePhysicalIds);
-  				NumOfGroups = GroupByStrMapping.Len();
-  				GroupingCase = 3;
-  				break;
-  		}
-  	}
-  	else{
-  		TIntV UniqueVector;
-  		THash<TGroupKey, TPair<TInt, TIntV> > Mapping_aux;
-  		GroupAux(NGroupByAttrs, Mapping_aux, Ordered, "", false, UniqueVector, UsePhysicalIds);
-  		for(THash<TGroupKey, TPair<TInt, TIntV> >::TIter it = Mapping_aux.BegI(); it < Mapping_aux.EndI(); it++){
-  			Mapping.AddDat(it.GetKey(), it.GetDat().Val2);
-  		}
-  		NumOfGroups = Mapping.Len();
-  	}
+  if (!GroupMapping.IsKey(Stmt) && GetGroupIdV(NGroupByAttrs, Ordered, RowV, GroupIdV, NumOfGroups)) {
+    GetTableGroupPosV(GroupIdV, NumOfGroups, GrpOffV, GrpRowV);
+    for (int k = 0; k < GrpRowV.Len(); k++) { GrpRowV[k] = RowV[GrpRowV[k]]; }
+  } else {
+    if (!GroupMapping.IsKey(Stmt)) {
+      // GroupAux registers the grouping under Stmt
+      TIntV UniqueVector;
+      THash<TGroupKey, TPair<TInt, TIntV> > Mapping_aux;
+      GroupAux(NGroupByAttrs, Mapping_aux, Ordered, "", false, UniqueVector, UsePhysicalIds);
+    }
+    const THash<TGroupKey,TIntV>& Mapping = GroupMapping.GetDat(Stmt);
+    // groups hold row ids unless physical ids are used
+    GrpOffV.Gen(Mapping.Len() + 1, 0);
+    GrpRowV.Gen(NumValidRows, 0);
+    GrpOffV.Add(0);
+    for (THash<TGroupKey,TIntV>::TIter it = Mapping.BegI(); it < Mapping.EndI(); it++) {
+      const TIntV& GroupRows = it.GetDat();
+      for (int i = 0; i < GroupRows.Len(); i++) {
+        if (UsePhysicalIds) {
+          GrpRowV.Add(GroupRows[i]);
+        } else {
+          int KeyId = RowIdMap.GetKeyId(GroupRows[i]);
+          if (KeyId >= 0 && RowIdMap[KeyId] != Invalid) { GrpRowV.Add(RowIdMap[KeyId]); }
+        }
+      }
+      GrpOffV.Add(GrpRowV.Len());
+    }
   }
-    
-  // double endGroup = omp_get_wtime();
-  // printf("Group time = %f\n", endGroup-startFn);
-
-  TAttrType T = GetColType(ValAttr);
 
   // add column corresponding to result attribute type
+  TAttrType T = atInt;
   if (AggOp == aaCount) { AddIntCol(ResAttr); } 
   else {
+    T = GetColType(ValAttr);
     if (T == atInt) { AddIntCol(ResAttr); }
     else if (T == atFlt) { AddFltCol(ResAttr); }
     else {
@@ -1678,73 +2269,8 @@ void TTable::Aggregate(const TStrV& GroupByAttrs, TAttrAggr AggOp,
       TExcept::Throw("Invalid aggregation for Str type!");
     }
   }
-  TInt ColIdx = GetColIdx(ResAttr);
-  TInt AggrColIdx = GetColIdx(ValAttr);
-
-  // double endAdd = omp_get_wtime();
-  // printf("AddCol time = %f\n", endAdd-endGroup);
-
-#ifdef USE_OPENMP
-  #pragma omp parallel for schedule(dynamic)
-#endif 
-  for (int g = 0; g < NumOfGroups; g++) {
-  	TIntV* GroupRows = NULL;
-  	switch(GroupingCase){
-  		case 0:
-  			GroupRows = & Mapping.GetDat(Mapping.GetKey(g));
-  			break;
-  		case 1:
-  			GroupRows = & GroupByIntMapping.GetDat(GroupByIntMapping.GetKey(g));
-  			break;
-  		case 2:
-  			GroupRows = & GroupByIntMapping.GetDat(GroupByIntMapping.GetKey(g));
-  			break;
-  	    case 3:
-  			GroupRows = & GroupByStrMapping.GetDat(GroupByStrMapping.GetKey(g));
-  			break;
-  		case 4:
-#ifdef GCC_ATOMIC
-  			GroupRows = & GroupByIntMapping_MP.GetDat(GroupByIntMPKeys[g]);
-#endif
-  			break;
-  	}
-
-    // find valid rows of group
-    /*
-    TIntV ValidRows;
-    for (TInt i = 0; i < GroupRows.Len(); i++) {
-      // TODO: This should not be necessary
-      if (!RowIdMap.IsKey(GroupRows[i])) { continue; }
-      TInt RowId = RowIdMap.GetDat(GroupRows[i]);
-      // GroupRows has physical row indices
-      if (RowId != Invalid) { ValidRows.Add(RowId); }
-    }
-    */
-	TIntV& ValidRows = *GroupRows;
-    TInt sz = ValidRows.Len();
-    if (sz <= 0) continue;
-    // Count is handled separately (other operations have aggregation policies defined in a template)
-    if (AggOp == aaCount) {
-      for (TInt i = 0; i < sz; i++) { IntCols[ColIdx][ValidRows[i]] = sz; }
-    } else {
-      // aggregate based on column type
-      if (T == atInt) {
-        TIntV V;
-        for (TInt i = 0; i < sz; i++) { V.Add(IntCols[AggrColIdx][ValidRows[i]]); }
-        TInt Res = AggregateVector<TInt>(V, AggOp);
-        if (AggOp == aaMean) { Res = Res / sz; }
-        for (TInt i = 0; i < sz; i++) { IntCols[ColIdx][ValidRows[i]] = Res; }
-      } else {
-        TFltV V;
-        for (TInt i = 0; i < sz; i++) { V.Add(FltCols[AggrColIdx][ValidRows[i]]); }
-        TFlt Res = AggregateVector<TFlt>(V, AggOp);
-        if (AggOp == aaMean) { Res /= sz; }
-        for (TInt i = 0; i < sz; i++) { FltCols[ColIdx][ValidRows[i]] = Res; }
-      }
-    }
-  }
-  // double endIter = omp_get_wtime();
-  // printf("Iter time = %f\n", endIter-endAdd);
+  TInt AggrColIdx = AggOp == aaCount ? TInt(-1) : GetColIdx(ValAttr);
+  AggregateGroups(GrpOffV, GrpRowV, AggOp, T, AggrColIdx, GetColIdx(ResAttr));
 }
 
 void TTable::AggregateCols(const TStrV& AggrAttrs, TAttrAggr AggOp, const TStr& ResAttr) {
@@ -1764,7 +2290,7 @@ void TTable::AggregateCols(const TStrV& AggrAttrs, TAttrAggr AggOp, const TStr&
       TInt RowIdx = RI.GetRowIdx();
       TIntV V;
       for (TInt i = 0; i < AggrAttrs.Len(); i++) {
-        V.Add(IntCols[Info[i].Val2][RowIdx]);
+        V.Add(GetIntIdx(Info[i].Val2, RowIdx));
       }
       IntCols[ResIdx][RowIdx] = AggregateVector<TInt>(V, AggOp);
     }
@@ -1776,7 +2302,7 @@ void TTable::AggregateCols(const TStrV& AggrAttrs, TAttrAggr AggOp, const TStr&
       TInt RowIdx = RI.GetRowIdx();
       TFltV V;
       for (TInt i = 0; i < AggrAttrs.Len(); i++) {
-        V.Add(FltCols[Info[i].Val2][RowIdx]);
+        V.Add(GetFltIdx(Info[i].Val2, RowIdx));
       }
       FltCols[ResIdx][RowIdx] = AggregateVector<TFlt>(V, AggOp);
     }
@@ -1852,13 +2378,13 @@ TVec<PTable> TTable::SpliceByGroup(const TStrV& GroupBy, TBool Ordered) {
         // add row to new group
         switch (Info.Val1) {
           case atInt:
-            GroupTable->IntCols[ColIdx].Add(IntCols[V[c]][RowIdx]);
+            GroupTable->IntCols[ColIdx].Add(GetIntIdx(V[c], RowIdx));
             break;
           case atFlt:
-            GroupTable->FltCols[ColIdx].Add(FltCols[V[c]][RowIdx]);
+            GroupTable->FltCols[ColIdx].Add(GetFltIdx(V[c], RowIdx));
             break;
           case atStr:
-            GroupTable->StrColMaps[ColIdx].Add(StrColMaps[V[c]][RowIdx]);
+            GroupTable->StrColMaps[ColIdx].Add(GetStrMapIdx(V[c], RowIdx));
             break;
         }
 
@@ -1889,6 +2415,7 @@ void TTable::InitIds() {
 void TTable::Reindex() {
   RowIdMap.Clr();
   TInt IdColIdx = GetColIdx(IdColName);
+  UnpackColIdx(atInt, IdColIdx);
   TInt IdCnt = 0;
   for (TRowIterator RI = BegRI(); RI < EndRI(); RI++) {
     IntCols[IdColIdx][RI.GetRowIdx()] = IdCnt;
@@ -1956,25 +2483,25 @@ void TTable::AddIdColumn(const TStr& ColName) {
 
 void TTable::AddJointRow(const TTable& T1, const TTable& T2, TInt RowIdx1, TInt RowIdx2) {
   for (TInt i = 0; i < T1.IntCols.Len(); i++) {
-    IntCols[i].Add(T1.IntCols[i][RowIdx1]);
+    IntCols[i].Add(T1.GetIntIdx(i, RowIdx1));
   }
   for (TInt i = 0; i < T1.FltCols.Len(); i++) {
-    FltCols[i].Add(T1.FltCols[i][RowIdx1]);
+    FltCols[i].Add(T1.GetFltIdx(i, RowIdx1));
   }
   for (TInt i = 0; i < T1.StrColMaps.Len(); i++) {
-    StrColMaps[i].Add(T1.StrColMaps[i][RowIdx1]);
+    StrColMaps[i].Add(T1.GetStrMapIdx(i, RowIdx1));
   }
   TInt IntOffset = T1.IntCols.Len();
   TInt FltOffset = T1.FltCols.Len();
   TInt StrOffset = T1.StrColMaps.Len();
   for (TInt i = 0; i < T2.IntCols.Len(); i++) {
-    IntCols[i+IntOffset].Add(T2.IntCols[i][RowIdx2]);
+    IntCols[i+IntOffset].Add(T2.GetIntIdx(i, RowIdx2));
   }
   for (TInt i = 0; i < T2.FltCols.Len(); i++) {
-    FltCols[i+FltOffset].Add(T2.FltCols[i][RowIdx2]);
+    FltCols[i+FltOffset].Add(T2.GetFltIdx(i, RowIdx2));
   }
   for (TInt i = 0; i < T2.StrColMaps.Len(); i++) {
-    StrColMaps[i+StrOffset].Add(T2.StrColMaps[i][RowIdx2]);
+    StrColMaps[i+StrOffset].Add(T2.GetStrMapIdx(i, RowIdx2));
   }
   TInt IdOffset = IntOffset + T2.IntCols.Len(); 
   NumRows++;
@@ -2121,7 +2648,7 @@ PTable TTable::SelfSimJoinPerGroup(const TStr& GroupAttr, const TStr& SimCol, co
 	TInt SimColIdx = GetColIdx(SimCol);
 
 	for (TRowIterator RowI = this->BegRI(); RowI < this->EndRI(); RowI++) {
-		TInt GroupId = IntCols[GroupColIdx][RowI.GetRowIdx()];
+		TInt GroupId = GetIntIdx(GroupColIdx, RowI.GetRowIdx());
 	
 		if(attrType==atInt || attrType==atStr)
 		{
@@ -2131,7 +2658,7 @@ PTable TTable::SelfSimJoinPerGroup(const TStr& GroupAttr, const TStr& SimCol, co
 			}
 
 			THash<TInt, TInt>& TIntH = TIntHH.GetDat(GroupId);
-			TInt SimAttrVal = (attrType==atInt ? IntCols[SimColIdx][RowI.GetRowIdx()] : StrColMaps[SimColIdx][RowI.GetRowIdx()]);
+			TInt SimAttrVal = (attrType==atInt ? GetIntIdx(SimColIdx, RowI.GetRowIdx()) : GetStrMapIdx(SimColIdx, RowI.GetRowIdx()));
 			TIntH.AddDat(SimAttrVal, 0);
 		}
 		else
@@ -2218,8 +2745,8 @@ PTable TTable::SelfSimJoinPerGroup(const TStrV& GroupBy, const TStr& SimCol,
 	for(TRowIterator RowI = GroupJointTable->BegRI(); RowI < GroupJointTable->EndRI(); RowI++)
 	{
 		// The GroupJoinTable has a well defined structure - columns 0 and 1 are GroupIds
-		TInt GroupId1 = GroupJointTable->IntCols[0][RowI.GetRowIdx()];
-		TInt GroupId2 = GroupJointTable->IntCols[1][RowI.GetRowIdx()];
+		TInt GroupId1 = GroupJointTable->GetIntIdx(0, RowI.GetRowIdx());
+		TInt GroupId2 = GroupJointTable->GetIntIdx(1, RowI.GetRowIdx());
 
 		// Get the rows for groupid1 and groupid and arbitrary select one row
 		TInt RowId1 = GroupIdH.GetDat(GroupId1);
@@ -2269,8 +2796,262 @@ void TTable::IncrementNext()
  // This means only keeping joint row indices (pairs of original row indices), sorting them
  // and adding all rows in the end. Sorting can be expensive, but we would be able to pre-allocate 
  // memory for the joint table..
+// Radix-partitioned hash join. Both sides are split by the low bits of a key hash into partitions small enough
+// that a build side partition and its hash table stay in cache, then every partition is joined on its own.
+static const int TableJoinPartRows = 1<<13;
+static const int TableJoinMxBits = 12;
+
+static inline uint64 TableJoinHash(const int& Key) { return TableHashMix(uint64(int64(Key))); }
+
+static inline uint64 TableJoinHash(const double& Key) {
+  // -0.0 and 0.0 are equal keys, adding 0.0 maps both to 0.0
+  const double Val = Key + 0.0;
+  uint64 Bits;
+  memcpy(&Bits, &Val, sizeof(Bits));
+  return TableHashMix(Bits);
+}
+
+static inline void GetTablePackVal(const TColPack& Pack, const int& ValN, TInt& Val) { Val = Pack.GetInt(ValN); }
+static inline void GetTablePackVal(const TColPack& Pack, const int& ValN, TFlt& Val) { Val = Pack.GetFlt(ValN); }
+
+template <class TVal>
+static void TableGatherCol(const TVec<TVec<TVal> >& ColV, const TVec<TColPack>& PackV, const int& ColIdx,
+ const TIntV& RowIdxV, TVec<TVal>& DstV, const bool& MP) {
+  const int Rows = RowIdxV.Len();
+  if (ColIdx < PackV.Len() && !PackV[ColIdx].Empty()) {
+    // packed values are decoded one at a time, the column is never decoded as a whole
+    const TColPack& Pack = PackV[ColIdx];
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) if (MP && Rows > TableJoinPartRows)
+#endif
+    for (int i = 0; i < Rows; i++) { GetTablePackVal(Pack, RowIdxV[i], DstV[i]); }
+    return;
+  }
+  const TVec<TVal>& SrcV = ColV[ColIdx];
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) if (MP && Rows > TableJoinPartRows)
+#endif
+  for (int i = 0; i < Rows; i++) { DstV[i] = SrcV[RowIdxV[i]]; }
+}
+
+// Stable partitioning of KeyV into 2^Bits partitions. PartValV gets ValV, or the position in KeyV if ValV is NULL,
+// partition p occupies [PartOffV[p], PartOffV[p+1]).
+template <class TKey>
+static void TableRadixPartition(const TKey* KeyV, const int* ValV, const int& Rows, const int& Bits, const bool& MP,
+ TVec<TKey>& PartKeyV, TIntV& PartValV, TIntV& PartOffV) {
+  const int Parts = 1 << Bits;
+  int Chunks = 1;
+#ifdef USE_OPENMP
+  if (MP && Rows > TableJoinPartRows) { Chunks = omp_get_max_threads(); }
+#endif
+  const int ChunkRows = (Rows + Chunks - 1) / Chunks;
+  // CntV holds the histogram of every chunk, and then the chunk's write position in every partition
+  TIntV CntV(Chunks * Parts);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+  for (int c = 0; c < Chunks; c++) {
+    int* Cnt = (int*) CntV.BegI() + c * Parts;
+    const int End = TMath::Mn(Rows, (c + 1) * ChunkRows);
+    for (int i = c * ChunkRows; i < End; i++) { Cnt[TableJoinHash(KeyV[i]) & (Parts - 1)]++; }
+  }
+  PartOffV.Gen(Parts + 1);
+  int Off = 0;
+  for (int p = 0; p < Parts; p++) {
+    PartOffV[p] = Off;
+    for (int c = 0; c < Chunks; c++) {
+      const int Cnt = CntV[c * Parts + p];
+      CntV[c * Parts + p] = Off;
+      Off += Cnt;
+    }
+  }
+  PartOffV[Parts] = Off;
+  PartKeyV.Gen(Rows);
+  PartValV.Gen(Rows);
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(static) if (Chunks > 1)
+#endif
+  for (int c = 0; c < Chunks; c++) {
+    int* Pos = (int*) CntV.BegI() + c * Parts;
+    const int End = TMath::Mn(Rows, (c + 1) * ChunkRows);
+    for (int i = c * ChunkRows; i < End; i++) {
+      const int j = Pos[TableJoinHash(KeyV[i]) & (Parts - 1)]++;
+      PartKeyV[j] = KeyV[i];
+      PartValV[j] = ValV == NULL ? i : ValV[i];
+    }
+  }
+}
+
+// Joins build side keys KeySV of rows RowSV with probe side keys KeyBV of rows RowBV. Matching row pairs are
+// returned in MatchSV and MatchBV, ordered by the probe side and then by the build side, as a nested loop would.
+template <class TKey>
+static void TableRadixJoin(const TKey* KeySV, const TIntV& RowSV, const TKey* KeyBV, const TIntV& RowBV,
+ const bool& MP, TIntV& MatchSV, TIntV& MatchBV) {
+  const int RowsS = RowSV.Len();
+  const int RowsB = RowBV.Len();
+  MatchSV.Clr();
+  MatchBV.Clr();
+  if (RowsS == 0 || RowsB == 0) { return; }
+  int Bits = 0;
+  while ((RowsS >> Bits) > TableJoinPartRows && Bits < TableJoinMxBits) { Bits++; }
+#ifdef USE_OPENMP
+  // a small build side still needs enough partitions to spread the probe side over the threads
+  if (MP && RowsB > TableJoinPartRows) {
+    while ((1 << Bits) < omp_get_max_threads() * CHUNKS_PER_THREAD && Bits < TableJoinMxBits) { Bits++; }
+  }
+#endif
+  const int Parts = 1 << Bits;
+  TVec<TKey> PartKeySV, PartKeyBV;
+  TIntV PartRowSV, PartPosBV, PartOffSV, PartOffBV;
+  TableRadixPartition(KeySV, (const int*) RowSV.BegI(), RowsS, Bits, MP, PartKeySV, PartRowSV, PartOffSV);
+  TableRadixPartition(KeyBV, (const int*) NULL, RowsB, Bits, MP, PartKeyBV, PartPosBV, PartOffBV);
+
+  // matches of every partition as probe side positions and build side rows
+  TVec<TIntV> PartMatchBV(Parts), PartMatchSV(Parts);
+  // number of matches of every probe side position, turned into output offsets below
+  TIntV MatchOffV(RowsB);
+  int* MatchOff = (int*) MatchOffV.BegI();
+#ifdef USE_OPENMP
+  #pragma omp parallel if (MP && Parts > 1)
+#endif
+  {
+    TIntV HeadV, NextV;
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 1)
+#endif
+    for (int p = 0; p < Parts; p++) {
+      const int BegS = PartOffSV[p];
+      const int RowsP = PartOffSV[p+1] - BegS;
+      const int BegB = PartOffBV[p];
+      const int EndB = PartOffBV[p+1];
+      if (RowsP == 0 || BegB == EndB) { continue; }
+      int Buckets = 1;
+      while (Buckets < RowsP) { Buckets *= 2; }
+      if (HeadV.Len() < Buckets) { HeadV.Gen(Buckets); }
+      if (NextV.Len() < RowsP) { NextV.Gen(RowsP); }
+      int* Head = (int*) HeadV.BegI();
+      int* Next = (int*) NextV.BegI();
+      for (int b = 0; b < Buckets; b++) { Head[b] = -1; }
+      const TKey* KeyS = PartKeySV.BegI() + BegS;
+      // insert backwards, so that every chain lists the build rows in input order
+      for (int s = RowsP - 1; s >= 0; s--) {
+        const int b = int((TableJoinHash(KeyS[s]) >> Bits) & uint64(Buckets - 1));
+        Next[s] = Head[b];
+        Head[b] = s;
+      }
+      TIntV& MatchBP = PartMatchBV[p];
+      TIntV& MatchSP = PartMatchSV[p];
+      for (int j = BegB; j < EndB; j++) {
+        const TKey Key = PartKeyBV[j];
+        const int b = int((TableJoinHash(Key) >> Bits) & uint64(Buckets - 1));
+        for (int s = Head[b]; s != -1; s = Next[s]) {
+          if (KeyS[s] == Key) {
+            MatchBP.Add(PartPosBV[j]);
+            MatchSP.Add(PartRowSV[BegS + s]);
+            MatchOff[PartPosBV[j]]++;
+          }
+        }
+      }
+    }
+  }
+
+  int64 Matches = 0;
+  for (int i = 0; i < RowsB; i++) {
+    const int Cnt = MatchOff[i];
+    MatchOff[i] = int(Matches);
+    Matches += Cnt;
+    if (Matches > TInt::Mx) { TExcept::Throw("Join result has too many rows"); }
+  }
+  MatchSV.Gen(int(Matches));
+  MatchBV.Gen(int(Matches));
+  // every probe side position belongs to a single partition, so partitions can be scattered in parallel
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1) if (MP && Parts > 1)
+#endif
+  for (int p = 0; p < Parts; p++) {
+    TIntV& MatchBP = PartMatchBV[p];
+    TIntV& MatchSP = PartMatchSV[p];
+    for (int k = 0; k < MatchBP.Len(); k++) {
+      const int PosB = MatchBP[k];
+      const int Out = MatchOff[PosB]++;
+      MatchSV[Out] = MatchSP[k];
+      MatchBV[Out] = RowBV[PosB];
+    }
+    MatchBP.Clr();
+    MatchSP.Clr();
+  }
+}
+
+void TTable::GetJoinRowIdxV(const TInt& ColIdx1, const TTable& Table, const TInt& ColIdx2, const TAttrType& Type,
+ TIntV& RowIdx1V, TIntV& RowIdx2V) const {
+  // build on the smaller table, matches come out in the row order of the bigger one
+  const TBool ThisIsSmaller = (NumValidRows <= Table.NumValidRows);
+  const TTable& TS = ThisIsSmaller ? *this : Table;
+  const TTable& TB = ThisIsSmaller ? Table : *this;
+  const TInt ColIdxS = ThisIsSmaller ? ColIdx1 : ColIdx2;
+  const TInt ColIdxB = ThisIsSmaller ? ColIdx2 : ColIdx1;
+  TIntV& MatchSV = ThisIsSmaller ? RowIdx1V : RowIdx2V;
+  TIntV& MatchBV = ThisIsSmaller ? RowIdx2V : RowIdx1V;
+  const bool MP = GetMP();
+
+  TIntV RowSV(TS.NumValidRows, 0), RowBV(TB.NumValidRows, 0);
+  for (TRowIterator RowI = TS.BegRI(); RowI < TS.EndRI(); RowI++) { RowSV.Add(RowI.GetRowIdx()); }
+  for (TRowIterator RowI = TB.BegRI(); RowI < TB.EndRI(); RowI++) { RowBV.Add(RowI.GetRowIdx()); }
+  if (Type == atFlt) {
+    TFltV KeySV(RowSV.Len()), KeyBV(RowBV.Len());
+    TableGatherCol(TS.FltCols, TS.FltColPacks, ColIdxS, RowSV, KeySV, MP);
+    TableGatherCol(TB.FltCols, TB.FltColPacks, ColIdxB, RowBV, KeyBV, MP);
+    TableRadixJoin((const double*) KeySV.BegI(), RowSV, (const double*) KeyBV.BegI(), RowBV, MP, MatchSV, MatchBV);
+  } else {
+    // strings are joined on their ids in the context string pool
+    TIntV KeySV(RowSV.Len()), KeyBV(RowBV.Len());
+    TableGatherCol(Type == atInt ? TS.IntCols : TS.StrColMaps, Type == atInt ? TS.IntColPacks : TS.StrColPacks,
+     ColIdxS, RowSV, KeySV, MP);
+    TableGatherCol(Type == atInt ? TB.IntCols : TB.StrColMaps, Type == atInt ? TB.IntColPacks : TB.StrColPacks,
+     ColIdxB, RowBV, KeyBV, MP);
+    TableRadixJoin((const int*) KeySV.BegI(), RowSV, (const int*) KeyBV.BegI(), RowBV, MP, MatchSV, MatchBV);
+  }
+}
+
+void TTable::AddJointRowV(const TTable& T1, const TTable& T2, const TIntV& RowIdx1V, const TIntV& RowIdx2V) {
+  Assert(NumRows == 0 && RowIdx1V.Len() == RowIdx2V.Len());
+  const int Rows = RowIdx1V.Len();
+  if (Rows == 0) {
+    FirstValidRow = Last;
+    LastValidRow = Last;
+    return;
+  }
+  ResizeTable(Rows);
+  const bool MP = GetMP();
+  // output columns are filled one at a time, each reads a single source column
+  const TInt IntOffset = T1.IntCols.Len();
+  const TInt FltOffset = T1.FltCols.Len();
+  const TInt StrOffset = T1.StrColMaps.Len();
+  for (int i = 0; i < T1.IntCols.Len(); i++) { TableGatherCol(T1.IntCols, T1.IntColPacks, i, RowIdx1V, IntCols[i], MP); }
+  for (int i = 0; i < T1.FltCols.Len(); i++) { TableGatherCol(T1.FltCols, T1.FltColPacks, i, RowIdx1V, FltCols[i], MP); }
+  for (int i = 0; i < T1.StrColMaps.Len(); i++) {
+    TableGatherCol(T1.StrColMaps, T1.StrColPacks, i, RowIdx1V, StrColMaps[i], MP); }
+  for (int i = 0; i < T2.IntCols.Len(); i++) {
+    TableGatherCol(T2.IntCols, T2.IntColPacks, i, RowIdx2V, IntCols[i+IntOffset], MP); }
+  for (int i = 0; i < T2.FltCols.Len(); i++) {
+    TableGatherCol(T2.FltCols, T2.FltColPacks, i, RowIdx2V, FltCols[i+FltOffset], MP); }
+  for (int i = 0; i < T2.StrColMaps.Len(); i++) {
+    TableGatherCol(T2.StrColMaps, T2.StrColPacks, i, RowIdx2V, StrColMaps[i+StrOffset], MP); }
+  TIntV& IdV = IntCols[IntOffset + T2.IntCols.Len()];
+  for (int i = 0; i < Rows; i++) {
+    IdV[i] = i;
+    Next[i] = i + 1;
+  }
+  Next[Rows-1] = Last;
+  NumRows = Rows;
+  NumValidRows = Rows;
+  FirstValidRow = 0;
+  LastValidRow = Rows - 1;
+  RowIdMap.Gen(Rows);
+  for (int i = 0; i < Rows; i++) { RowIdMap.AddDat(i, i); }
+}
+
 PTable TTable::Join(const TStr& Col1, const TTable& Table, const TStr& Col2) {
-  // double startFn = omp_get_wtime();
   if (!IsColName(Col1)) {
     TExcept::Throw("no such column " + Col1);
     printf("no such column %s\n", Col1.CStr());
@@ -2283,196 +3064,13 @@ PTable TTable::Join(const TStr& Col1, const TTable& Table, const TStr& Col2) {
     TExcept::Throw("Trying to Join on columns of different type");
     printf("Trying to Join on columns of different type\n");
   }
-  //printf("passed initial checks\n");
   // initialize result table
   PTable JointTable = InitializeJointTable(Table);
-  //printf("initialized joint table\n");
-  // hash smaller table (group by column)
-  TAttrType ColType = GetColType(Col1);
-  TBool ThisIsSmaller = (NumValidRows <= Table.NumValidRows);
-  const TTable& TS = ThisIsSmaller ? *this : Table;
-  const TTable& TB = ThisIsSmaller ?  Table : *this;
-  TStr ColS = ThisIsSmaller ? Col1 : Col2;
-  TStr ColB = ThisIsSmaller ? Col2 : Col1;
-  TInt ColBId = ThisIsSmaller ? Table.GetColIdx(ColB) : GetColIdx(ColB);
-  // double endInit = omp_get_wtime();
-  // printf("Init time = %f\n", endInit-startFn);
-  // iterate over the rows of the bigger table and check for "collisions" 
-  // with the group keys for the small table.
-#ifdef GCC_ATOMIC
-  if (GetMP()) {
-    switch(ColType){
-      case atInt:{
-        THashMP<TInt, TIntV> T(TS.GetNumValidRows());
-        TS.GroupByIntColMP(ColS, T, true);
-        // double endGroup = omp_get_wtime();
-        // printf("Group time = %f\n", endGroup-endInit);
-        
-        TIntPrV Partitions;
-        TB.GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-        TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-        TVec<TIntPrV> JointRowIDSet(Partitions.Len());
-        // double endPart = omp_get_wtime();
-        // printf("Partition time = %f\n", endPart-endGroup);
-
-        #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD) 
-        for (int i = 0; i < Partitions.Len(); i++){
-          //double start = omp_get_wtime();
-          JointRowIDSet[i].Reserve(PartitionSize);
-          TRowIterator RowI(Partitions[i].GetVal1(), &TB);
-          TRowIterator EndI(Partitions[i].GetVal2(), &TB);
-          while (RowI < EndI) {
-            TInt K = RowI.GetIntAttr(ColBId);
-            if(T.IsKey(K)){
-              TIntV& Group = T.GetDat(K);
-              for(TInt j = 0; j < Group.Len(); j++){
-                if(ThisIsSmaller){
-                  JointRowIDSet[i].Add(TIntPr(Group[j], RowI.GetRowIdx()));
-                } else{
-                  JointRowIDSet[i].Add(TIntPr(RowI.GetRowIdx(), Group[j]));
-                }
-              }
-            }
-            RowI++;
-          }
-          //double end = omp_get_wtime();
-          //printf("END: Thread %d: i = %d, start = %d, end = %d, num = %d, time = %f\n", omp_get_thread_num(), i,
-          //    Partitions[i].GetVal1().Val, Partitions[i].GetVal2().Val, JointRowIDSet[i].Len(), end-start);
-        }
-        // double endJoin = omp_get_wtime();
-        // printf("Iterate time = %f\n", endJoin-endPart);
-        JointTable->AddNJointRowsMP(*this, Table, JointRowIDSet);      
-        // double endAdd = omp_get_wtime();
-        // printf("Add time = %f\n", endAdd-endJoin);
-        break;
-      }
-      case atFlt:{
-        THashMP<TFlt, TIntV> T(TS.GetNumValidRows());
-        TS.GroupByFltCol(ColS, T, TIntV(), true);
-
-        TIntPrV Partitions;
-        TB.GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-        TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-        TVec<TIntPrV> JointRowIDSet(Partitions.Len());
-
-        #pragma omp parallel for schedule(dynamic) 
-        for (int i = 0; i < Partitions.Len(); i++){
-          JointRowIDSet[i].Reserve(PartitionSize);
-          TRowIterator RowI(Partitions[i].GetVal1(), &TB);
-          TRowIterator EndI(Partitions[i].GetVal2(), &TB);
-          while (RowI < EndI) {
-            TFlt K = RowI.GetFltAttr(ColBId);
-            if(T.IsKey(K)){
-              TIntV& Group = T.GetDat(K);
-              for(TInt j = 0; j < Group.Len(); j++){
-                if(ThisIsSmaller){
-                  JointRowIDSet[i].Add(TIntPr(Group[j], RowI.GetRowIdx()));
-                } else{
-                  JointRowIDSet[i].Add(TIntPr(RowI.GetRowIdx(), Group[j]));
-                }
-              }
-            }
-            RowI++;
-          }
-        }
-        JointTable->AddNJointRowsMP(*this, Table, JointRowIDSet);
-        break;
-      }
-      case atStr:{
-        THashMP<TInt, TIntV> T(TS.GetNumValidRows());
-        TS.GroupByStrCol(ColS, T, TIntV(), true);
-
-        TIntPrV Partitions;
-        TB.GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-        TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-        TVec<TIntPrV> JointRowIDSet(Partitions.Len());
-
-        #pragma omp parallel for schedule(dynamic) 
-        for (int i = 0; i < Partitions.Len(); i++){
-          JointRowIDSet[i].Reserve(PartitionSize);
-          TRowIterator RowI(Partitions[i].GetVal1(), &TB);
-          TRowIterator EndI(Partitions[i].GetVal2(), &TB);
-          while (RowI < EndI) {
-            TInt K = RowI.GetStrMapById(ColBId);
-            if(T.IsKey(K)){
-              TIntV& Group = T.GetDat(K);
-              for(TInt j = 0; j < Group.Len(); j++){
-                if(ThisIsSmaller){
-                  JointRowIDSet[i].Add(TIntPr(Group[j], RowI.GetRowIdx()));
-                } else{
-                  JointRowIDSet[i].Add(TIntPr(RowI.GetRowIdx(), Group[j]));
-                }
-              }
-            }
-            RowI++;
-          }
-        }
-        JointTable->AddNJointRowsMP(*this, Table, JointRowIDSet);
-      }
-      break;
-    }
-  } else {
-#endif // GCC_ATOMIC
-    switch (ColType) {
-      case atInt:{
-        TIntIntVH T;
-        TS.GroupByIntCol(ColS, T, TIntV(), true);
-        for (TRowIterator RowI = TB.BegRI(); RowI < TB.EndRI(); RowI++) {
-          TInt K = RowI.GetIntAttr(ColBId);
-          if (T.IsKey(K)) {
-            TIntV& Group = T.GetDat(K);
-            for (TInt i = 0; i < Group.Len(); i++) {
-              if (ThisIsSmaller) {
-                JointTable->AddJointRow(*this, Table, Group[i], RowI.GetRowIdx());
-              } else {
-                JointTable->AddJointRow(*this, Table, RowI.GetRowIdx(), Group[i]);
-              }
-            }
-          }
-        }
-        break;
-      }
-      case atFlt:{
-        THash<TFlt, TIntV> T;
-        TS.GroupByFltCol(ColS, T, TIntV(), true);
-        for (TRowIterator RowI = TB.BegRI(); RowI < TB.EndRI(); RowI++) {
-          TFlt K = RowI.GetFltAttr(ColBId);
-          if (T.IsKey(K)) {
-            TIntV& Group = T.GetDat(K);
-            for (TInt i = 0; i < Group.Len(); i++) {
-              if (ThisIsSmaller) {
-                JointTable->AddJointRow(*this, Table, Group[i], RowI.GetRowIdx());
-              } else {
-                JointTable->AddJointRow(*this, Table, RowI.GetRowIdx(), Group[i]);
-              }
-            }
-          }
-        }
-        break;
-      }
-      case atStr:{
-        TIntIntVH T;
-        TS.GroupByStrCol(ColS, T, TIntV(), true);
-        for (TRowIterator RowI = TB.BegRI(); RowI < TB.EndRI(); RowI++) {
-          TInt K = RowI.GetStrMapById(ColBId);
-          if (T.IsKey(K)) {
-            TIntV& Group = T.GetDat(K);
-            for (TInt i = 0; i < Group.Len(); i++) {
-              if (ThisIsSmaller) {
-                JointTable->AddJointRow(*this, Table, Group[i], RowI.GetRowIdx());
-              } else {
-                JointTable->AddJointRow(*this, Table, RowI.GetRowIdx(), Group[i]);
-              }
-            }
-          }
-        }
-      }
-      break;
-    }
-#ifdef GCC_ATOMIC
-  }
-#endif
-  return JointTable; 
+  // match row ids first, then copy the output columns
+  TIntV RowIdx1V, RowIdx2V;
+  GetJoinRowIdxV(GetColIdx(Col1), Table, Table.GetColIdx(Col2), GetColType(Col1), RowIdx1V, RowIdx2V);
+  JointTable->AddJointRowV(*this, Table, RowIdx1V, RowIdx2V);
+  return JointTable;
 }
 
 void TTable::ThresholdJoinInputCorrectness(const TStr& KeyCol1, const TStr& JoinCol1, const TTable& Table, 
@@ -2503,124 +3101,62 @@ void TTable::ThresholdJoinInputCorrectness(const TStr& KeyCol1, const TStr& Join
   }
 }
 
-void TTable::ThresholdJoinCountCollisions(const TTable& TB, const TTable& TS, 
-  const TIntIntVH& T, TInt JoinColIdxB, TInt KeyColIdxB, TInt KeyColIdxS, 
-  THash<TIntPr,TIntTr>& Counters, TBool ThisIsSmaller, TAttrType JoinColType, TAttrType KeyType){
-    // iterate over big table and count / record joint tuples
-    for (TRowIterator RowI = TB.BegRI(); RowI < TB.EndRI(); RowI++) {
-    // value to join on from big table
-      TInt JVal = 0;
-      if(JoinColType == atStr){
-        JVal = RowI.GetStrMapById(JoinColIdxB);
-      } else{
-        JVal = RowI.GetIntAttr(JoinColIdxB);
+void TTable::ThresholdJoinCountCollisions(const TTable& Table, const TIntV& RowIdx1V, const TIntV& RowIdx2V,
+  TInt KeyColIdx1, TInt KeyColIdx2, THash<TIntPr,TIntTr>& Counters, TAttrType KeyType){
+    // iterate over joint tuples and count them per key pair
+    for (int i = 0; i < RowIdx1V.Len(); i++) {
+      // create a pair of keys - serves as a key in Counters
+      TIntPr Keys(GetIntKeyIdx(KeyType, KeyColIdx1, RowIdx1V[i]), Table.GetIntKeyIdx(KeyType, KeyColIdx2, RowIdx2V[i]));
+      int KeyId = Counters.GetKeyId(Keys);
+      if (KeyId >= 0) {
+        // if the key pair has been seen before - increment its counter by 1
+        TIntTr& V = Counters[KeyId];
+        V.Val3 = V.Val3 + 1;
+      } else {
+        // if the key pair hasn't been seen before - add it with value of 
+        // row indices that create a joint record with this key pair
+        Counters.AddDat(Keys, TIntTr(RowIdx1V[i], RowIdx2V[i], 1));
       }
-      //printf("JVal: %d\n", JVal.Val);
-      if(T.IsKey(JVal)){
-        // read key attribute of big table row
-        TInt KeyB = 0;
-        if(KeyType == atStr){
-          KeyB = RowI.GetStrMapById(KeyColIdxB);
-        } else{
-          KeyB = RowI.GetIntAttr(KeyColIdxB);
-        } 
-        // read row ids from small table with join attribute value of JVal
-        const TIntV& RelevantRows = T.GetDat(JVal);
-        for(int i = 0; i < RelevantRows.Len(); i++){
-          // read key attribute of relevant row from small table
-          TInt KeyS = 0;
-          if(KeyType == atStr){
-            KeyS = TS.StrColMaps[KeyColIdxS][RelevantRows[i]];
-          } else{
-            KeyS = TS.IntCols[KeyColIdxS][RelevantRows[i]];
-          }
-          // create a pair of keys - serves as a key in Counters
-          TIntPr Keys = ThisIsSmaller ? TIntPr(KeyS, KeyB) : TIntPr(KeyB, KeyS);
-          if(Counters.IsKey(Keys)){
-          // if the key pair has been seen before - increment its counter by 1
-            TIntTr& V = Counters.GetDat(Keys);
-            V.Val3 = V.Val3 + 1;
-          } else{
-            // if the key pair hasn't been seen before - add it with value of 
-            // row indices that create a joint record with this key pair
-            if(ThisIsSmaller){
-              Counters.AddDat(Keys, TIntTr(RelevantRows[i], RowI.GetRowIdx(),1));
-            } else{
-              Counters.AddDat(Keys, TIntTr(RowI.GetRowIdx(), RelevantRows[i],1));
-            }
-          }
-        }	// end of for loop
-      }	// end of if statement
-    } // end of for loop
-}
-
-void TTable::ThresholdJoinCountPerJoinKeyCollisions(const TTable& TB, const TTable& TS, 
-  const TIntIntVH& T, TInt JoinColIdxB, TInt KeyColIdxB, TInt KeyColIdxS, 
-  THash<TIntTr,TIntTr>& Counters, TBool ThisIsSmaller, TAttrType JoinColType, TAttrType KeyType){
-    for (TRowIterator RowI = TB.BegRI(); RowI < TB.EndRI(); RowI++) {
-      // value to join on from big table
-      TInt JVal = 0;
-      if(JoinColType == atStr){
-        JVal = RowI.GetStrMapById(JoinColIdxB);
-       } else{
-        JVal = RowI.GetIntAttr(JoinColIdxB);
-       }
-      //printf("JVal: %d\n", JVal.Val);
-      if(T.IsKey(JVal)){
-        // read key attribute of big table row
-        TInt KeyB = 0;
-        if(KeyType == atStr){
-          KeyB = RowI.GetStrMapById(KeyColIdxB);
-        } else{
-          KeyB = RowI.GetIntAttr(KeyColIdxB);
-        } 
-        // read row ids from small table with join attribute value of JVal
-        const TIntV& RelevantRows = T.GetDat(JVal);
-        for(int i = 0; i < RelevantRows.Len(); i++){
-          // read key attribute of relevant row from small table
-          TInt KeyS = 0;
-          if(KeyType == atStr){
-            KeyS = TS.StrColMaps[KeyColIdxS][RelevantRows[i]];
-          } else{
-            KeyS = TS.IntCols[KeyColIdxS][RelevantRows[i]];
-          }
-        	// create a pair of keys - serves as a key in Counters
-        	TIntPr Keys = ThisIsSmaller ? TIntPr(KeyS, KeyB) : TIntPr(KeyB, KeyS);
-        	TIntTr K(Keys.Val1,Keys.Val2,JVal);
-          if(Counters.IsKey(K)){
-            // if the key pair has been seen before - increment its counter by 1
-            TIntTr& V = Counters.GetDat(K);
-            V.Val3 = V.Val3 + 1;
-          } else{
-            // if the key pair hasn't been seen before - add it with value of 
-            // row indices that create a joint record with this key pair
-            if(ThisIsSmaller){
-              Counters.AddDat(K, TIntTr(RelevantRows[i], RowI.GetRowIdx(),1));
-            } else{
-              Counters.AddDat(K, TIntTr(RowI.GetRowIdx(), RelevantRows[i],1));
-            }
-          }
-        }	// end of for loop
-      }	// end of if statement
-    } // end of for loop
+    }
+}
+
+void TTable::ThresholdJoinCountPerJoinKeyCollisions(const TTable& Table, const TIntV& RowIdx1V, const TIntV& RowIdx2V,
+  TInt KeyColIdx1, TInt KeyColIdx2, TInt JoinColIdx1, THash<TIntTr,TIntTr>& Counters, TAttrType JoinColType, TAttrType KeyType){
+    for (int i = 0; i < RowIdx1V.Len(); i++) {
+      // value joined on, equal in both rows of a joint tuple
+      TIntTr K(GetIntKeyIdx(KeyType, KeyColIdx1, RowIdx1V[i]), Table.GetIntKeyIdx(KeyType, KeyColIdx2, RowIdx2V[i]),
+       GetIntKeyIdx(JoinColType, JoinColIdx1, RowIdx1V[i]));
+      int KeyId = Counters.GetKeyId(K);
+      if (KeyId >= 0) {
+        // if the key pair has been seen before - increment its counter by 1
+        TIntTr& V = Counters[KeyId];
+        V.Val3 = V.Val3 + 1;
+      } else {
+        // if the key pair hasn't been seen before - add it with value of 
+        // row indices that create a joint record with this key pair
+        Counters.AddDat(K, TIntTr(RowIdx1V[i], RowIdx2V[i], 1));
+      }
+    }
   }
 
 PTable TTable::ThresholdJoinOutputTable(const THash<TIntPr,TIntTr>& Counters, TInt Threshold, const TTable& Table){
   // initialize result table
   PTable JointTable = InitializeJointTable(Table);
+  TIntV RowIdx1V, RowIdx2V;
   for(THash<TIntPr,TIntTr>::TIter iter = Counters.BegI(); iter < Counters.EndI(); iter++){
     TIntTr& Counter = iter.GetDat();
-    //printf("keys: %d, %d\n", iter.GetKey().Val1.Val, iter.GetKey().Val2.Val);
-    //printf("selected rows: %d,%d, counter: %d\n", Counter.Val1.Val, Counter.Val2.Val, Counter.Val3.Val);
     if(Counter.Val3 >= Threshold){
-      JointTable->AddJointRow(*this, Table, Counter.Val1, Counter.Val2);
+      RowIdx1V.Add(Counter.Val1);
+      RowIdx2V.Add(Counter.Val2);
     }
   }
+  JointTable->AddJointRowV(*this, Table, RowIdx1V, RowIdx2V);
   return JointTable;
 }
 
 PTable TTable::ThresholdJoinPerJoinKeyOutputTable(const THash<TIntTr,TIntTr>& Counters, TInt Threshold, const TTable& Table){
   PTable JointTable = InitializeJointTable(Table);
+  TIntV RowIdx1V, RowIdx2V;
   for(THash<TIntTr,TIntTr>::TIter iter = Counters.BegI(); iter < Counters.EndI(); iter++){
     const TIntTr& Counter = iter.GetDat();
     const TIntTr& Keys = iter.GetKey();
@@ -2629,10 +3165,12 @@ PTable TTable::ThresholdJoinPerJoinKeyOutputTable(const THash<TIntTr,TIntTr>& Co
       TIntPr K(Keys.Val1,Keys.Val2);
       if(!Pairs.IsKey(K)){
         Pairs.AddKey(K);
-        JointTable->AddJointRow(*this, Table, Counter.Val1, Counter.Val2);
+        RowIdx1V.Add(Counter.Val1);
+        RowIdx2V.Add(Counter.Val2);
       }
     }
   }
+  JointTable->AddJointRowV(*this, Table, RowIdx1V, RowIdx2V);
   return JointTable;
 }
 
@@ -2645,30 +3183,13 @@ PTable TTable::ThresholdJoin(const TStr& KeyCol1, const TStr& JoinCol1, const TT
   const TStr& KeyCol2, const TStr& JoinCol2, TInt Threshold, TBool PerJoinKey){
   // test input correctness
   ThresholdJoinInputCorrectness(KeyCol1, JoinCol1, Table, KeyCol2, JoinCol2);
-  //printf("verified input correctness\n");
   // type of column on which we join (currently support only int)
   TAttrType JoinColType = GetColType(JoinCol1);
   // type of key column (currently support only int)
   TAttrType KeyType = GetColType(KeyCol1);
-  // Determine which table is smaller
-  TBool ThisIsSmaller = (NumValidRows <= Table.NumValidRows);
-  const TTable& TS = ThisIsSmaller ? *this : Table;
-  const TTable& TB = ThisIsSmaller ?  Table : *this;
-  TStr JoinColS = JoinCol1;
-  TInt JoinColIdxB = GetColIdx(JoinCol2);
-  TInt KeyColIdxS = GetColIdx(KeyCol1);
-  TInt KeyColIdxB = GetColIdx(KeyCol2);
-  if(!ThisIsSmaller){
-  	JoinColS = JoinCol2;
-    JoinColIdxB = GetColIdx(JoinCol1);
-  	KeyColIdxS = GetColIdx(KeyCol2);
-    KeyColIdxB = GetColIdx(KeyCol1);
-  }
-  
-  // debug print
-  //printf("JoinColS = %d, JoinColIdxB = %d, KeyColIdxS = %d, KeyColIdxB = %d\n", 
-  	//GetColIdx(JoinColS).Val, JoinColIdxB.Val, KeyColIdxS.Val, KeyColIdxB.Val);
-  //printf("starting switch-case\n");
+  TInt KeyColIdx1 = GetColIdx(KeyCol1);
+  TInt KeyColIdx2 = Table.GetColIdx(KeyCol2);
+  TInt JoinColIdx1 = GetColIdx(JoinCol1);
   
   if(KeyType != atInt && KeyType != atStr){
     printf("ThresholdJoin only supports integer or string key attributes\n");
@@ -2678,77 +3199,213 @@ PTable TTable::ThresholdJoin(const TStr& KeyCol1, const TStr& JoinCol1, const TT
     printf("ThresholdJoin only supports integer or string join attributes\n");
     TExcept::Throw("ThresholdJoin only supports integer or string join attributes");
   }
-  //printf("starting the real stuff!\n");
-  // hash the smaller table T: join col value --> physical row ids of rows with that value
-  TIntIntVH T;
-  if(JoinColType == atInt){
-    TS.GroupByIntCol(JoinColS, T, TIntV(), true);
-  } else if(JoinColType == atStr){
-    TS.GroupByStrCol(JoinColS, T, TIntV(), true);
-  } else{
-    TExcept::Throw("ThresholdJoin only supports integer or string join attributes");
-  } 
+  // joint tuples as pairs of physical row ids, in the same order as Join
+  TIntV RowIdx1V, RowIdx2V;
+  GetJoinRowIdxV(JoinColIdx1, Table, Table.GetColIdx(JoinCol2), JoinColType, RowIdx1V, RowIdx2V);
   
- /*
-  for(THash<TInt,TIntV>::TIter it = T.BegI(); it < T.EndI(); it++){
-    if(JoinColType == atStr){
-      printf("%s -->", Context.StringVals.GetKey(it.GetKey().Val));
-    } else{
-      printf("%d -->", it.GetKey().Val);
+  // Counters: (K1,K2) --> (RowIdx1,RowIdx2, count) where K1 is a key from KeyCol1, 
+  // K2 is a key from Table's KeyCol2; RowIdx1 and RowIdx2 are physical row ids
+  // that participates in a joint tuple that satisfies (1).
+  // count is the count of joint records that satisfy (1).
+  // In case of string attributes - the integer mappings of the key attribute values are used.
+  if(PerJoinKey){
+    THash<TIntTr,TIntTr> Counters;
+    ThresholdJoinCountPerJoinKeyCollisions(Table, RowIdx1V, RowIdx2V, KeyColIdx1, KeyColIdx2, JoinColIdx1, Counters, JoinColType, KeyType);
+    return ThresholdJoinPerJoinKeyOutputTable(Counters, Threshold, Table);
+  } else{
+    THash<TIntPr,TIntTr> Counters;
+    ThresholdJoinCountCollisions(Table, RowIdx1V, RowIdx2V, KeyColIdx1, KeyColIdx2, Counters, KeyType);
+    return ThresholdJoinOutputTable(Counters, Threshold, Table);
+  }
+}
+
+
+// Column-wise Select works on row bitmaps: bit b of word w stands for physical row 64*w+b.
+static const int TableBlockRows = 1<<16;
+
+template <int Cmp, class TVal>
+static inline bool TableCmp(const TVal& Val1, const TVal& Val2) {
+  switch (Cmp) {
+    case LT: return Val1 < Val2;
+    case LTE: return Val1 <= Val2;
+    case EQ: return Val1 == Val2;
+    case NEQ: return Val1 != Val2;
+    case GTE: return Val1 >= Val2;
+    case GT: return Val1 > Val2;
+    default: return false;
+  }
+}
+
+// Compares ValV with Val2V, or with Val if Val2V is NULL, for Rows rows.
+template <int Cmp, class TVal>
+static void TableCmpBitV(const TVal* ValV, const TVal* Val2V, const TVal& Val, const int& Rows, uint64* RowBitV) {
+  for (int Beg = 0; Beg < Rows; Beg += 64) {
+    const int Bits = TMath::Mn(Rows - Beg, 64);
+    uint64 Word = 0;
+    if (Val2V == NULL) {
+      for (int b = 0; b < Bits; b++) { Word |= uint64(TableCmp<Cmp>(ValV[Beg+b], Val)) << b; }
+    } else {
+      for (int b = 0; b < Bits; b++) { Word |= uint64(TableCmp<Cmp>(ValV[Beg+b], Val2V[Beg+b])) << b; }
+    }
+    RowBitV[Beg/64] = Word;
+  }
+}
+
+template <class TVal>
+static void GetTableCmpBitV(const TVal* ValV, const TVal* Val2V, const TVal& Val, TPredComp Cmp, const int& Rows, uint64* RowBitV) {
+  switch (Cmp) {
+    case LT: TableCmpBitV<LT>(ValV, Val2V, Val, Rows, RowBitV); break;
+    case LTE: TableCmpBitV<LTE>(ValV, Val2V, Val, Rows, RowBitV); break;
+    case EQ: TableCmpBitV<EQ>(ValV, Val2V, Val, Rows, RowBitV); break;
+    case NEQ: TableCmpBitV<NEQ>(ValV, Val2V, Val, Rows, RowBitV); break;
+    case GTE: TableCmpBitV<GTE>(ValV, Val2V, Val, Rows, RowBitV); break;
+    case GT: TableCmpBitV<GT>(ValV, Val2V, Val, Rows, RowBitV); break;
+    default: TableCmpBitV<-1>(ValV, Val2V, Val, Rows, RowBitV); break;
+  }
+}
+
+void TTable::GetSelectBitV(const TAttrType& Type, const TInt& ColIdx1, const TInt& ColIdx2,
+ const TPrimitive& Val, TPredComp Cmp, TVec<TUInt64>& RowBitV) const {
+  const int Rows = NumRows;
+  RowBitV.Gen((Rows + 63) / 64);
+  uint64* BitV = (uint64*) RowBitV.BegI();
+  // string equality compares pool ids, a constant that is not in the pool has id -1
+  const bool StrIds = Type == atStr && (Cmp == EQ || Cmp == NEQ);
+  const int StrId = (Type == atStr && ColIdx2 < 0) ? Context->StringVals.GetKeyId(Val.GetStr()) : -1;
+  const TStr StrVal = Val.GetStr();
+  const int Blocks = (Rows + TableBlockRows - 1) / TableBlockRows;
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1) if (GetMP() && Blocks > 1)
+#endif
+  for (int b = 0; b < Blocks; b++) {
+    const int Beg = b * TableBlockRows;
+    const int Len = TMath::Mn(Rows - Beg, TableBlockRows);
+    // packed columns are decoded one block at a time
+    if (Type == atInt) {
+      TIntV BufV, Buf2V;
+      const int* ValV = GetIntColBf(ColIdx1, Beg, Len, BufV);
+      const int* Val2V = ColIdx2 < 0 ? NULL : GetIntColBf(ColIdx2, Beg, Len, Buf2V);
+      GetTableCmpBitV(ValV, Val2V, Val.GetInt().Val, Cmp, Len, BitV + Beg/64);
+    } else if (Type == atFlt) {
+      TFltV BufV, Buf2V;
+      const double* ValV = GetFltColBf(ColIdx1, Beg, Len, BufV);
+      const double* Val2V = ColIdx2 < 0 ? NULL : GetFltColBf(ColIdx2, Beg, Len, Buf2V);
+      GetTableCmpBitV(ValV, Val2V, Val.GetFlt().Val, Cmp, Len, BitV + Beg/64);
+    } else if (StrIds) {
+      TIntV BufV, Buf2V;
+      const int* ValV = GetStrMapColBf(ColIdx1, Beg, Len, BufV);
+      const int* Val2V = ColIdx2 < 0 ? NULL : GetStrMapColBf(ColIdx2, Beg, Len, Buf2V);
+      GetTableCmpBitV(ValV, Val2V, StrId, Cmp, Len, BitV + Beg/64);
+    } else {
+      for (int i = 0; i < Len; i += 64) {
+        const int Bits = TMath::Mn(Len - i, 64);
+        uint64 Word = 0;
+        for (int j = 0; j < Bits; j++) {
+          const TStr Str1 = GetStrValIdx(ColIdx1, Beg+i+j);
+          const TStr Str2 = ColIdx2 < 0 ? StrVal : GetStrValIdx(ColIdx2, Beg+i+j);
+          if (TPredicate::EvalStrAtom(Str1, Str2, Cmp)) { Word |= uint64(1) << j; }
+        }
+        BitV[(Beg+i)/64] = Word;
+      }
+    }
+  }
+}
+
+bool TTable::GetSelectBitV(const TPredicateNode* Node, TVec<TUInt64>& RowBitV) const {
+  if (Node == NULL) { return false; }
+  if (Node->Op == NOP) {
+    const TAtomicPredicate& Atom = Node->Atom;
+    if (!IsColName(Atom.Lvar) || GetColType(Atom.Lvar) != Atom.Type) { return false; }
+    TInt ColIdx2 = -1;
+    if (!Atom.IsConst) {
+      if (!IsColName(Atom.Rvar) || GetColType(Atom.Rvar) != Atom.Type) { return false; }
+      ColIdx2 = GetColIdx(Atom.Rvar);
     }
-    const TIntV& V = it.GetDat();
-    for(int sr = 0; sr < V.Len(); sr++){
-      printf(" %d", V[sr].Val);
+    if (Atom.Type == atStr && (Atom.Compare == SUBSTR || Atom.Compare == SUPERSTR)) {
+      // TPredicate does not evaluate substring atoms, they are always false
+      RowBitV.Gen((NumRows + 63) / 64);
+      return true;
     }
-    printf("\n");
-  }
-  */
-  
-  // Counters: (K1,K2) --> (RowIdx1,RowIdx2, count) where K1 is a key from KeyCol1, 
-  // K2 is a key from Table's KeyCol2; RowIdx1 and RowIdx2 are physical row ids
-  // that participates in a joint tuple that satisfies (1).
-  // count is the count of joint records that satisfy (1).
-  // In case of string attributes - the integer mappings of the key attribute values are used.
-  if(PerJoinKey){
-    //printf("PerJoinKey\n");
-    THash<TIntTr,TIntTr> Counters;
-    ThresholdJoinCountPerJoinKeyCollisions(TB, TS, T, JoinColIdxB, KeyColIdxB, KeyColIdxS, Counters, ThisIsSmaller, JoinColType, KeyType);
-    /*
-    for(THash<TIntTr,TIntTr>::TIter it = Counters.BegI(); it < Counters.EndI(); it++){
-      const TIntTr& K = it.GetKey();
-      const TIntTr& V = it.GetDat();
-      if(KeyType == atStr){
-        printf("%s %s --> %d %d %d\n", Context->StringVals.GetKey(K.Val1), Context->StringVals.GetKey(K.Val2), V.Val1.Val, V.Val2.Val, V.Val3.Val);
-      } else{
-        printf("%d %d --> %d %d %d\n", K.Val1.Val, K.Val2.Val, V.Val1.Val, V.Val2.Val, V.Val3.Val); 
-      }
+    TPrimitive Val;
+    switch (Atom.Type) {
+      case atInt: Val = TPrimitive(Atom.IntConst); break;
+      case atFlt: Val = TPrimitive(Atom.FltConst); break;
+      case atStr: Val = TPrimitive(Atom.StrConst); break;
     }
-    */
-    //printf("found collisions\n");
-    return ThresholdJoinPerJoinKeyOutputTable(Counters, Threshold, Table);
-  } else{
-    //printf("not PerJoinKey\n");
-    THash<TIntPr,TIntTr> Counters;
-    ThresholdJoinCountCollisions(TB, TS, T, JoinColIdxB, KeyColIdxB, KeyColIdxS, Counters, ThisIsSmaller, JoinColType, KeyType);
-    /*
-    for(THash<TIntPr,TIntTr>::TIter it = Counters.BegI(); it < Counters.EndI(); it++){
-      const TIntPr& K = it.GetKey();
-      const TIntTr& V = it.GetDat();
-      if(KeyType == atStr){
-        printf("%s %s --> %d %d %d\n", Context->StringVals.GetKey(K.Val1), Context->StringVals.GetKey(K.Val2), V.Val1.Val, V.Val2.Val, V.Val3.Val);
-      } else{
-        printf("%d %d --> %d %d %d\n", K.Val1.Val, K.Val2.Val, V.Val1.Val, V.Val2.Val, V.Val3.Val); 
-      }
+    GetSelectBitV(Atom.Type, GetColIdx(Atom.Lvar), ColIdx2, Val, Atom.Compare, RowBitV);
+    return true;
+  }
+  if (Node->Op == NOT) {
+    if (!GetSelectBitV(Node->Left != NULL ? Node->Left : Node->Right, RowBitV)) { return false; }
+    for (int w = 0; w < RowBitV.Len(); w++) { RowBitV[w].Val = ~RowBitV[w].Val; }
+    return true;
+  }
+  TVec<TUInt64> RightBitV;
+  if (!GetSelectBitV(Node->Left, RowBitV) || !GetSelectBitV(Node->Right, RightBitV)) { return false; }
+  if (Node->Op == AND) {
+    for (int w = 0; w < RowBitV.Len(); w++) { RowBitV[w].Val &= RightBitV[w].Val; }
+  } else {
+    for (int w = 0; w < RowBitV.Len(); w++) { RowBitV[w].Val |= RightBitV[w].Val; }
+  }
+  return true;
+}
+
+void TTable::KeepRowBitV(const TVec<TUInt64>& RowBitV) {
+  if (NumValidRows == 0) { return; }
+  CopyMappedV(Next);
+  const TInt IdColIdx = GetColIdx(IdColName);
+  int PrevRowIdx = Invalid;
+  int RowIdx = FirstValidRow;
+  while (RowIdx != Last) {
+    const int NextRowIdx = Next[RowIdx];
+    if ((RowBitV[RowIdx/64].Val >> (RowIdx%64)) & 1) {
+      if (PrevRowIdx == Invalid) { FirstValidRow = RowIdx; }
+      else { Next[PrevRowIdx] = RowIdx; }
+      PrevRowIdx = RowIdx;
+    } else {
+      Next[RowIdx] = Invalid;
+      NumValidRows--;
+      if (IdColIdx >= 0) { RowIdMap.AddDat(GetIntIdx(IdColIdx, RowIdx), Invalid); }
     }
-    */
-    //printf("found collisions\n");
-    return ThresholdJoinOutputTable(Counters, Threshold, Table);
+    RowIdx = NextRowIdx;
+  }
+  if (PrevRowIdx == Invalid) {
+    FirstValidRow = Last;
+    LastValidRow = Last;
+  } else {
+    Next[PrevRowIdx] = Last;
+    LastValidRow = PrevRowIdx;
+  }
+  IsNextDirty = 1;
+}
+
+void TTable::GetRowBitV(const TVec<TUInt64>& RowBitV, TIntV& RowV) const {
+  if (NumValidRows == 0) { return; }
+  for (int RowIdx = FirstValidRow; RowIdx != Last; RowIdx = Next[RowIdx]) {
+    if ((RowBitV[RowIdx/64].Val >> (RowIdx%64)) & 1) { RowV.Add(RowIdx); }
   }
 }
 
+void TTable::GetValidRowRanges(TIntPrV& RangeV, const int& MxRows) const {
+  RangeV.Clr(false);
+  int Beg = 0;
+  while (Beg < NumRows) {
+    while (Beg < NumRows && Next[Beg] == Invalid) { Beg++; }
+    int End = Beg;
+    while (End < NumRows && End - Beg < MxRows && Next[End] != Invalid) { End++; }
+    if (Beg < End) { RangeV.Add(TIntPr(Beg, End)); }
+    Beg = End;
+  }
+}
 
 void TTable::Select(TPredicate& Predicate, TIntV& SelectedRows, TBool Remove) {
-  TIntV Selected;
+  TVec<TUInt64> RowBitV;
+  if (GetSelectBitV(Predicate.Root, RowBitV)) {
+    if (Remove) { KeepRowBitV(RowBitV); }
+    else { GetRowBitV(RowBitV, SelectedRows); }
+    return;
+  }
+  // predicates that mix column types are evaluated one row at a time
   TStrV RelevantCols;
   Predicate.GetVariables(RelevantCols);
   TInt NumRelevantCols = RelevantCols.Len();
@@ -2809,7 +3466,6 @@ void TTable::Classify(TPredicate& Predicate, const TStr& LabelName, const TInt&
 }
 
 
-// Further optimization: both comparison operation and type of columns don't change between rows..
 void TTable::SelectAtomic(const TStr& Col1, const TStr& Col2, TPredComp Cmp, TIntV& SelectedRows, TBool Remove) {
   const TAttrType Ty1 = GetColType(Col1);
   const TAttrType Ty2 = GetColType(Col2);
@@ -2820,46 +3476,12 @@ void TTable::SelectAtomic(const TStr& Col1, const TStr& Col2, TPredComp Cmp, TIn
   }
   if (Cmp == SUBSTR || Cmp == SUPERSTR) { Assert(Ty1 == atStr); }
 
+  TVec<TUInt64> RowBitV;
+  GetSelectBitV(Ty1, ColIdx1, ColIdx2, TPrimitive(), Cmp, RowBitV);
   if (Remove) {
-    TRowIteratorWithRemove RowI = BegRIWR();
-    while (RowI.GetNextRowIdx() != Last) {
-
-      TBool Result;
-      switch (Ty1) {
-        case atInt:
-          Result = TPredicate::EvalAtom(RowI.GetNextIntAttr(ColIdx1), RowI.GetNextIntAttr(ColIdx2), Cmp);
-          break;
-        case atFlt:
-          Result = TPredicate::EvalAtom(RowI.GetNextFltAttr(ColIdx1), RowI.GetNextFltAttr(ColIdx2), Cmp);
-          break;
-        case atStr:
-          Result = TPredicate::EvalStrAtom(RowI.GetNextStrAttr(ColIdx1), RowI.GetNextStrAttr(ColIdx2), Cmp);
-          break;
-      }
-			
-      if (!Result) { 
-        RowI.RemoveNext();
-      } else {
-        RowI++;
-      }
-
-    }
+    KeepRowBitV(RowBitV);
   } else {
-    for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
-      TBool Result;
-      switch (Ty1) {
-        case atInt:
-          Result = TPredicate::EvalAtom(RowI.GetIntAttr(Col1), RowI.GetIntAttr(Col2), Cmp);
-          break;
-        case atFlt:
-          Result = TPredicate::EvalAtom(RowI.GetFltAttr(Col1), RowI.GetFltAttr(Col2), Cmp);
-          break;
-        case atStr:
-          Result = TPredicate::EvalStrAtom(RowI.GetStrAttr(Col1), RowI.GetStrAttr(Col2), Cmp);
-          break;
-      }
-      if (Result) { SelectedRows.Add(RowI.GetRowIdx()); }
-    }
+    GetRowBitV(RowBitV, SelectedRows);
   }
 }
 
@@ -2870,194 +3492,38 @@ void TTable::ClassifyAtomic(const TStr& Col1, const TStr& Col2, TPredComp Cmp,
   ClassifyAux(SelectedRows, LabelName, PositiveLabel, NegativeLabel);
 }
 
-void TTable::SelectAtomicConst(const TStr& Col, const TPrimitive& Val, TPredComp Cmp, 
+void TTable::SelectAtomicConst(const TStr& Col, const TPrimitive& Val, TPredComp Cmp,
   TIntV& SelectedRows, PTable& SelectedTable, TBool Remove, TBool Table) {
-  //double startFn = omp_get_wtime();
-  TStr ValTStr(Val.GetStr());
   TAttrType Type = GetColType(Col);
   TInt ColIdx = GetColIdx(Col);
 
-  if (Type != Val.GetType()) { 
-    TExcept::Throw("SelectAtomicConst: coltype does not match const type"); 
+  if (Type != Val.GetType()) {
+    TExcept::Throw("SelectAtomicConst: coltype does not match const type");
   }
 
-  if(Remove){
-#ifdef USE_OPENMP
-    if (GetMP()) {
-      //double endInit = omp_get_wtime();
-      //printf("Init time = %f\n", endInit-startFn);
-      TIntPrV Partitions;
-      GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-      TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-      int RemoveCount = 0;
-      //double endPart = omp_get_wtime();
-      //printf("Partition time = %f\n", endPart-endInit);
-
-      TIntPrV Bounds(Partitions.Len());
-    
-      // #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD) reduction(+:RemoveCount) shared(Val)
-      #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD) reduction(+:RemoveCount)
-      for (int i = 0; i < Partitions.Len(); i++){
-        //TPrimitive ThreadLocalVal(Val);
-        TRowIterator RowI(Partitions[i].GetVal1(), this);
-        TRowIterator EndI(Partitions[i].GetVal2(), this);
-        TInt FirstRowIdx = TTable::Invalid;
-        TInt LastRowIdx = TTable::Invalid;
-        TBool First = true;
-        while (RowI < EndI) {
-          TInt CurrRowIdx = RowI.GetRowIdx();
-          TBool Result;
-          if (Type != atStr) {
-            Result = RowI.CompareAtomicConst(ColIdx, Val, Cmp);
-          } else {
-            Result = RowI.CompareAtomicConstTStr(ColIdx, ValTStr, Cmp);
-          }
-          RowI++;
-          if(!Result) {
-            Next[CurrRowIdx] = TTable::Invalid;
-            RemoveCount++;
-          } else { 
-            if (First) { FirstRowIdx = CurrRowIdx; First = false; } 
-            else { Next[LastRowIdx] = CurrRowIdx; }
-            LastRowIdx = CurrRowIdx; 
-          }
-        }
-        Bounds[i] = TIntPr(FirstRowIdx, LastRowIdx);
-        //printf("Thread %d: i = %d, start = %d, end = %d\n", omp_get_thread_num(), i,
-        //  Partitions[i].GetVal1().Val, Partitions[i].GetVal2().Val);
-      }
-      //double endIter = omp_get_wtime();
-      //printf("Iter time = %f\n", endIter-endPart);
-      
-      // repair the next vector
-      TInt CurrBound = 0;
-      while (CurrBound < Bounds.Len() && Bounds[CurrBound].Val1 == TTable::Invalid) {
-        CurrBound++;
-      }
-      if (CurrBound == Bounds.Len()) {
-        // selected table is empty
-        Assert(NumValidRows == RemoveCount);
-        NumValidRows = 0;
-        FirstValidRow = TTable::Invalid;
-        LastValidRow = TTable::Invalid;
-      } else {
-        NumValidRows -= RemoveCount;
-        FirstValidRow = Bounds[CurrBound].Val1;
-        LastValidRow = Bounds[CurrBound].Val2;
-        TInt PrevBound = CurrBound;
-        CurrBound++;
-        while (CurrBound < Bounds.Len()) {
-          if (Bounds[CurrBound].Val1 == TTable::Invalid) { CurrBound++; continue; }
-          Next[Bounds[PrevBound].Val2] = Bounds[CurrBound].Val1;
-          LastValidRow = Bounds[CurrBound].Val2;
-          PrevBound = CurrBound;
-          CurrBound++;
-        }
-        Next[Bounds[PrevBound].Val2] = TTable::Last;
-      }
-      IsNextDirty = 1;
-      //double endRepair = omp_get_wtime();
-      //printf("Repair time = %f\n", endRepair-endIter);
-    } else {
-#endif
-      TRowIteratorWithRemove RowI = BegRIWR();
-      while(RowI.GetNextRowIdx() != Last){
-        if (!RowI.CompareAtomicConst(ColIdx, Val, Cmp)) {
-          RowI.RemoveNext();
-        } else {
-          RowI++;
-        }
-      }
-      IsNextDirty = 1;
-#ifdef USE_OPENMP
-    }
-#endif
+  TVec<TUInt64> RowBitV;
+  GetSelectBitV(Type, ColIdx, -1, Val, Cmp, RowBitV);
+  if (Remove) {
+    KeepRowBitV(RowBitV);
   } else if (Table) {
+    TIntV RowV;
+    GetRowBitV(RowBitV, RowV);
 #ifdef USE_OPENMP
     if (GetMP()) {
-      //double endInit = omp_get_wtime();
-      //printf("Init time = %f\n", endInit-startFn);
-      TIntPrV Partitions;
-      GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-      TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-      //double endPart = omp_get_wtime();
-      //printf("Partition time = %f\n", endPart-endInit);
-
-      int TotalSelectedRows = 0;
-      #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD) reduction(+:TotalSelectedRows)
-      for (int i = 0; i < Partitions.Len(); i++){
-        TRowIterator RowI(Partitions[i].GetVal1(), this);
-        TRowIterator EndI(Partitions[i].GetVal2(), this);
-        while (RowI < EndI) {
-          if (Type != atStr) {
-            if (RowI.CompareAtomicConst(ColIdx, Val, Cmp)) { 
-              TotalSelectedRows++;
-            }
-          } else {
-            if (RowI.CompareAtomicConstTStr(ColIdx, ValTStr, Cmp)) { 
-              TotalSelectedRows++;
-            }
-          }
-          RowI++;
-        }
-      }
-      //double endCount = omp_get_wtime();
-      //printf("Count time = %f\n", endCount-endPart);
-
-      SelectedTable->ResizeTable(TotalSelectedRows);
-      //double endResize = omp_get_wtime();
-      //printf("Resize time = %f\n", endResize-endCount);
-
-      if (TotalSelectedRows == 0) {
-        // printf("Select: Empty output!\n");
-        return;
-      }
-    
-      #pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD)
-      for (int i = 0; i < Partitions.Len(); i++){
-        TIntV LocalSelectedRows;
-        LocalSelectedRows.Reserve(PartitionSize);
-        TRowIterator RowI(Partitions[i].GetVal1(), this);
-        TRowIterator EndI(Partitions[i].GetVal2(), this);
-        while (RowI < EndI) {
-          if (Type != atStr) {
-            if (RowI.CompareAtomicConst(ColIdx, Val, Cmp)) { 
-              LocalSelectedRows.Add(RowI.GetRowIdx());
-            }
-          } else {
-            if (RowI.CompareAtomicConstTStr(ColIdx, ValTStr, Cmp)) { 
-              LocalSelectedRows.Add(RowI.GetRowIdx());
-            }
-          }
-          RowI++;
-        }
-        SelectedTable->AddSelectedRows(*this, LocalSelectedRows);
-        //printf("Thread %d: i = %d, start = %d, end = %d\n", omp_get_thread_num(), i,
-        //  Partitions[i].GetVal1().Val, Partitions[i].GetVal2().Val);
-      }
-      //double endIter = omp_get_wtime();
-      //printf("Iter time = %f\n", endIter-endResize);
-
-      //SelectedTable->ResizeTable(SelectedTable->GetNumValidRows());
-      //double endResize2 = omp_get_wtime();
-      //printf("Resize2 time = %f\n", endResize2-endIter);      
+      SelectedTable->ResizeTable(RowV.Len());
+      if (RowV.Len() == 0) { return; }
+      SelectedTable->AddSelectedRows(*this, RowV);
       SelectedTable->SetFirstValidRow();
     } else {
 #endif
-      for(TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++){
-        if (RowI.CompareAtomicConst(ColIdx, Val, Cmp)) { 
-          SelectedTable->AddRowI(RowI);
-        }
+      for (int i = 0; i < RowV.Len(); i++) {
+        SelectedTable->AddRowI(TRowIterator(RowV[i], this));
       }
 #ifdef USE_OPENMP
     }
 #endif
   } else {
-    for(TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++){
-      if (RowI.CompareAtomicConst(ColIdx, Val, Cmp)) { 
-        SelectedRows.Add(RowI.GetRowIdx());
-      }
-    }
+    GetRowBitV(RowBitV, SelectedRows);
   }
 }
 
@@ -3065,13 +3531,13 @@ inline TInt TTable::CompareRows(TInt R1, TInt R2, const TAttrType& CompareByType
   //printf("comparing rows %d %d by %s\n", R1.Val, R2.Val, CompareBy.CStr());
   switch (CompareByType) {
     case atInt:{
-      if (IntCols[CompareByIndex][R1] > IntCols[CompareByIndex][R2]) { return (Asc ? 1 : -1); }
-      if (IntCols[CompareByIndex][R1] < IntCols[CompareByIndex][R2]) { return (Asc ? -1 : 1); }
+      if (GetIntIdx(CompareByIndex, R1) > GetIntIdx(CompareByIndex, R2)) { return (Asc ? 1 : -1); }
+      if (GetIntIdx(CompareByIndex, R1) < GetIntIdx(CompareByIndex, R2)) { return (Asc ? -1 : 1); }
       return 0;
     }
     case atFlt:{
-      if (FltCols[CompareByIndex][R1] > FltCols[CompareByIndex][R2]) { return (Asc ? 1 : -1); }
-      if (FltCols[CompareByIndex][R1] < FltCols[CompareByIndex][R2]) { return (Asc ? -1 : 1); }
+      if (GetFltIdx(CompareByIndex, R1) > GetFltIdx(CompareByIndex, R2)) { return (Asc ? 1 : -1); }
+      if (GetFltIdx(CompareByIndex, R1) < GetFltIdx(CompareByIndex, R2)) { return (Asc ? -1 : 1); }
       return 0;
     }
     case atStr:{
@@ -3237,6 +3703,120 @@ void TTable::QSortPar(TIntV& V, const TVec<TAttrType>& SortByTypes, const TIntV&
 }
 #endif // USE_OPENMP
 
+// Multi-column sort: the values of every sort column are mapped to unsigned keys with the same order, the keys of
+// adjacent columns are packed into 64-bit words, and the rows are radix sorted on the words from the last to the first.
+class TTableStrIdCmp {
+private:
+  const TStrHash<TInt, TBigStrPool>& StrH;
+public:
+  TTableStrIdCmp(const TStrHash<TInt, TBigStrPool>& _StrH) : StrH(_StrH) { }
+  bool operator () (const TInt& Id1, const TInt& Id2) const { return strcmp(StrH.GetKey(Id1), StrH.GetKey(Id2)) < 0; }
+};
+
+class TTableSortCol {
+public:
+  TAttrType Type;
+  const int* IntV;
+  const double* FltV;
+  int Mn, Bits;
+  uint64 Mx;
+  TIntV RankV;  // rank of every string id in the order of the strings
+public:
+  TTableSortCol() : Type(atInt), IntV(NULL), FltV(NULL), Mn(0), Bits(0), Mx(0) { }
+  uint64 GetKey(const int& RowIdx, const bool& Asc) const {
+    uint64 Key = 0;
+    if (Type == atFlt) {
+      // flip the sign bit of positive values and all the bits of negative values, 0.0 and -0.0 are equal
+      const double Val = FltV[RowIdx] + 0.0;
+      memcpy(&Key, &Val, sizeof(Val));
+      Key = (Key >> 63) ? ~Key : (Key | (uint64(1) << 63));
+    } else if (Type == atInt) {
+      Key = uint64(int64(IntV[RowIdx]) - int64(Mn));
+    } else {
+      Key = RankV[IntV[RowIdx]].Val;
+    }
+    return Asc ? Key : Mx - Key;
+  }
+};
+
+void TTable::SortRowV(TIntV& RowV, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices, TBool Asc) const {
+  const int Rows = RowV.Len();
+  if (Rows < 2) { return; }
+  const bool MP = GetMP();
+  const int Cols = SortByTypes.Len();
+  TVec<TTableSortCol> ColV(Cols);
+  // rows are read in any order, so packed sort columns are decoded to buffers
+  TVec<TIntV> IntBufV(Cols);
+  TVec<TFltV> FltBufV(Cols);
+  for (int c = 0; c < Cols; c++) {
+    TTableSortCol& Col = ColV[c];
+    Col.Type = SortByTypes[c];
+    if (Col.Type == atFlt) {
+      Col.FltV = GetFltColBf(SortByIndices[c], 0, NumRows, FltBufV[c]);
+      Col.Bits = 64;  Col.Mx = TUInt64::Mx;
+      continue;
+    }
+    Col.IntV = Col.Type == atInt ? GetIntColBf(SortByIndices[c], 0, NumRows, IntBufV[c]) :
+     GetStrMapColBf(SortByIndices[c], 0, NumRows, IntBufV[c]);
+    int Mn = TInt::Mx, Mx = TInt::Mn;
+    for (int i = 0; i < Rows; i++) {
+      Mn = TMath::Mn(Mn, Col.IntV[RowV[i]]);
+      Mx = TMath::Mx(Mx, Col.IntV[RowV[i]]);
+    }
+    if (Col.Type == atStr) {
+      // rank the distinct strings of the column
+      Col.RankV.Gen(Mx + 1);
+      for (int i = 0; i < Rows; i++) { Col.RankV[Col.IntV[RowV[i]]] = 1; }
+      TIntV IdV;
+      for (int Id = Mn; Id <= Mx; Id++) {
+        if (Col.RankV[Id] == 1) { IdV.Add(Id); }
+      }
+      IdV.SortCmp(TTableStrIdCmp(Context->StringVals));
+      for (int r = 0; r < IdV.Len(); r++) { Col.RankV[IdV[r]] = r; }
+      Mn = 0;  Mx = IdV.Len() - 1;
+    }
+    Col.Mn = Mn;
+    Col.Mx = uint64(int64(Mx) - int64(Mn));
+    while (Col.Bits < 64 && (Col.Mx >> Col.Bits) != 0) { Col.Bits++; }
+  }
+  // columns [ColBegV[w], ColBegV[w+1]) make word w, the last word holds the first column
+  TIntV ColBegV;
+  ColBegV.Add(Cols);
+  for (int c = Cols - 1, WordBits = 0; c >= 0; c--) {
+    if (WordBits + ColV[c].Bits > 64) {
+      ColBegV.Add(c + 1);
+      WordBits = 0;
+    }
+    WordBits += ColV[c].Bits;
+  }
+  ColBegV.Add(0);
+  ColBegV.Reverse();
+  TVec<TUInt64> KeyV(Rows), OutKeyV(Rows);
+  TIntV OutRowV(Rows);
+  for (int w = ColBegV.Len() - 2; w >= 0; w--) {
+    int Bits = 0;
+    for (int c = ColBegV[w]; c < ColBegV[w+1]; c++) { Bits += ColV[c].Bits; }
+    if (Bits == 0) { continue; }
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) if (MP && Rows > TableGroupMPRows)
+#endif
+    for (int i = 0; i < Rows; i++) {
+      uint64 Key = 0;
+      for (int c = ColBegV[w]; c < ColBegV[w+1]; c++) {
+        if (ColV[c].Bits == 0) { continue; }
+        Key = (ColV[c].Bits == 64 ? 0 : Key << ColV[c].Bits) | ColV[c].GetKey(RowV[i], Asc);
+      }
+      KeyV[i] = Key;
+    }
+    // stable passes keep the order of the less significant words
+    for (int Shift = 0; Shift < Bits; Shift += TableGroupDigitBits) {
+      TableGroupSortPass(KeyV, RowV, Shift, MP, OutKeyV, OutRowV);
+      KeyV.Swap(OutKeyV);
+      RowV.Swap(OutRowV);
+    }
+  }
+}
+
 void TTable::Order(const TStrV& OrderBy, TStr OrderColName, TBool ResetRankByMSC, TBool Asc) {
   // get a vector of all valid row indices
   TIntV ValidRows = TIntV(NumValidRows);
@@ -3259,17 +3839,10 @@ void TTable::Order(const TStrV& OrderBy, TStr OrderColName, TBool ResetRankByMSC
   }
 
   // sort that vector according to the attributes given in "OrderBy" in lexicographic order
-#ifdef USE_OPENMP
-  if (GetMP()) {
-    QSortPar(ValidRows, OrderByTypes, OrderByIndices, Asc);
-  } else {
-#endif
-    QSort(ValidRows, 0, NumValidRows-1, OrderByTypes, OrderByIndices, Asc);
-#ifdef USE_OPENMP
-  }
-#endif
+  SortRowV(ValidRows, OrderByTypes, OrderByIndices, Asc);
 
   // rewire Next vector
+  CopyMappedV(Next);
   IsNextDirty = 1;
   if (NumValidRows > 0) {
     FirstValidRow = ValidRows[0];
@@ -3309,6 +3882,8 @@ void TTable::Order(const TStrV& OrderBy, TStr OrderColName, TBool ResetRankByMSC
 }
 
 void TTable::Defrag() {
+  // rows are moved within the columns
+  Unpack();
   TInt FreeIndex = 0;
   TIntV Mapping;  // Mapping[old_index] = new_index/invalid
 
@@ -3331,7 +3906,7 @@ void TTable::Defrag() {
         Mapping.Add(Last);
       }
 
-      RowIdMap.AddDat(IntCols[IdColIdx][i], FreeIndex);
+      if (IdColIdx >= 0) { RowIdMap.AddDat(IntCols[IdColIdx][i], FreeIndex); }
 
       for (TInt j = 0; j < IntCols.Len(); j++) {
         IntCols[j][FreeIndex] = IntCols[j][i];
@@ -3374,6 +3949,7 @@ void TTable::SelectFirstNRows(const TInt& N) {
     return; // The table contains exactly N rows
   }
   // The table contains more than N rows
+  CopyMappedV(Next);
   TInt CurrId = LastId;
   while (Next[CurrId] != Last) {
     Assert(Next[CurrId] != Invalid);
@@ -3399,10 +3975,10 @@ inline void TTable::AddEdgeAttributes(PNEANet& Graph, int RowId) {
     TInt Index = GetColIdx(ColName);
     switch (T) {
       case atInt:
-        Graph->AddIntAttrDatE(RowId, IntCols[Index][RowId], ColName);
+        Graph->AddIntAttrDatE(RowId, GetIntIdx(Index, RowId), ColName);
         break;
       case atFlt:
-        Graph->AddFltAttrDatE(RowId, FltCols[Index][RowId], ColName);
+        Graph->AddFltAttrDatE(RowId, GetFltIdx(Index, RowId), ColName);
         break;
       case atStr:
         Graph->AddStrAttrDatE(RowId, GetStrValIdx(Index, RowId), ColName);
@@ -3427,11 +4003,11 @@ inline void TTable::AddNodeAttributes(TInt NId, TStrV NodeAttrV, TInt RowId, THa
     if (CT == atInt) {
       if (!NodeIntAttrs.IsKey(NId)) { NodeIntAttrs.AddKey(NId); }
       if (!NodeIntAttrs.GetDat(NId).IsKey(ColAttr)) { NodeIntAttrs.GetDat(NId).AddKey(ColAttr); }
-      NodeIntAttrs.GetDat(NId).GetDat(ColAttr).Add(IntCols[ColId][RowId]);
+      NodeIntAttrs.GetDat(NId).GetDat(ColAttr).Add(GetIntIdx(ColId, RowId));
     } else if (CT == atFlt) {
       if (!NodeFltAttrs.IsKey(NId)) { NodeFltAttrs.AddKey(NId); }
       if (!NodeFltAttrs.GetDat(NId).IsKey(ColAttr)) { NodeFltAttrs.GetDat(NId).AddKey(ColAttr); }
-      NodeFltAttrs.GetDat(NId).GetDat(ColAttr).Add(FltCols[ColId][RowId]);
+      NodeFltAttrs.GetDat(NId).GetDat(ColAttr).Add(GetFltIdx(ColId, RowId));
     } else {
       if (!NodeStrAttrs.IsKey(NId)) { NodeStrAttrs.AddKey(NId); }
       if (!NodeStrAttrs.GetDat(NId).IsKey(ColAttr)) { NodeStrAttrs.GetDat(NId).AddKey(ColAttr); }
@@ -3466,18 +4042,18 @@ PNEANet TTable::BuildGraph(const TIntV& RowIds, TAttrAggr AggrPolicy) {
     // add src and dst nodes to graph if they are not seen earlier
     TInt SVal, DVal;
     if (NodeType == atFlt) {
-      TFlt FSVal = FltCols[SrcColIdx][CurrRowIdx];
+      TFlt FSVal = GetFltIdx(SrcColIdx, CurrRowIdx);
       SVal = CheckAndAddFltNode(Graph, FltNodeVals, FSVal);
-      TFlt FDVal = FltCols[SrcColIdx][CurrRowIdx];
+      TFlt FDVal = GetFltIdx(SrcColIdx, CurrRowIdx);
       DVal = CheckAndAddFltNode(Graph, FltNodeVals, FDVal);
     } else if (NodeType == atInt || NodeType == atStr) {
       if (NodeType == atInt) {
-        SVal = IntCols[SrcColIdx][CurrRowIdx];
-        DVal = IntCols[DstColIdx][CurrRowIdx];
+        SVal = GetIntIdx(SrcColIdx, CurrRowIdx);
+        DVal = GetIntIdx(DstColIdx, CurrRowIdx);
       } else {
-        SVal = StrColMaps[SrcColIdx][CurrRowIdx];
+        SVal = GetStrMapIdx(SrcColIdx, CurrRowIdx);
         if (strlen(Context->StringVals.GetKey(SVal)) == 0) { continue; }  //illegal value
-        DVal = StrColMaps[DstColIdx][CurrRowIdx];
+        DVal = GetStrMapIdx(DstColIdx, CurrRowIdx);
         if (strlen(Context->StringVals.GetKey(DVal)) == 0) { continue; }  //illegal value
       }
       if (!Graph->IsNode(SVal)) { Graph->AddNode(SVal); }
@@ -3555,11 +4131,11 @@ void TTable::FillBucketsByWindow(TStr SplitAttr, TInt JumpSize, TInt WindowSize,
     TInt MaxValue = TInt::Mn;
     for (TInt i = 0; i < Next.Len(); i++) {
       if (Next[i] != Invalid) { 
-        if (MinValue > IntCols[SplitColId][i]) {
-          MinValue = IntCols[SplitColId][i];
+        if (MinValue > GetIntIdx(SplitColId, i)) {
+          MinValue = GetIntIdx(SplitColId, i);
         }
-        if (MaxValue < IntCols[SplitColId][i]) {
-          MaxValue = IntCols[SplitColId][i];
+        if (MaxValue < GetIntIdx(SplitColId, i)) {
+          MaxValue = GetIntIdx(SplitColId, i);
         }
       }
     }
@@ -3579,7 +4155,7 @@ void TTable::FillBucketsByWindow(TStr SplitAttr, TInt JumpSize, TInt WindowSize,
   // populate RowIdSets by computing the range of buckets for each row
   for (TInt i = 0; i < Next.Len(); i++) {
     if (Next[i] == Invalid) { continue; }
-    int SplitVal = IntCols[SplitColId][i];
+    int SplitVal = GetIntIdx(SplitColId, i);
     if (SplitVal < StartVal || SplitVal > EndVal) { continue; }
     int RowVal = SplitVal - StartVal;
     if (JumpSize == 0) { // expanding windows
@@ -3601,15 +4177,31 @@ void TTable::FillBucketsByInterval(TStr SplitAttr, TIntPrV SplitIntervals) {
   int NumBuckets = SplitIntervals.Len();
   InitRowIdBuckets(NumBuckets);
 
-  // populate RowIdSets by computing the range of buckets for each row
+  // sort the rows on the split values once, the rows of an interval are then a range of the sorted rows
+  TIntV RowV(NumValidRows, 0);
   for (TInt i = 0; i < Next.Len(); i++) {
-    if (Next[i] == Invalid) { continue; }
-    int SplitVal = IntCols[SplitColId][i];
-    for (TInt j = 0; j < SplitIntervals.Len(); j++) { 
-      if (SplitVal >= SplitIntervals[j].Val1 && SplitVal < SplitIntervals[j].Val2) {
-        RowIdBuckets[j].Add(i);
+    if (Next[i] != Invalid) { RowV.Add(i); }
+  }
+  TVec<TAttrType> SortByTypes;  SortByTypes.Add(atInt);
+  TIntV SortByIndices;  SortByIndices.Add(SplitColId);
+  SortRowV(RowV, SortByTypes, SortByIndices);
+  TIntV SplitValV(RowV.Len());
+  for (int i = 0; i < RowV.Len(); i++) { SplitValV[i] = GetIntIdx(SplitColId, RowV[i]); }
+  for (int j = 0; j < NumBuckets; j++) {
+    int Beg = 0, End = 0;
+    for (int Bound = 0; Bound < 2; Bound++) {
+      // the first sorted row with a value of at least the bound of the interval
+      const int BoundVal = Bound == 0 ? SplitIntervals[j].Val1 : SplitIntervals[j].Val2;
+      int Lo = 0, Hi = SplitValV.Len();
+      while (Lo < Hi) {
+        const int Mid = (Lo + Hi) / 2;
+        if (SplitValV[Mid] < BoundVal) { Lo = Mid + 1; } else { Hi = Mid; }
       }
+      if (Bound == 0) { Beg = Lo; } else { End = Lo; }
     }
+    for (int k = Beg; k < End; k++) { RowIdBuckets[j].Add(RowV[k]); }
+    // the rows of a bucket are in the physical order
+    RowIdBuckets[j].Sort();
   }
 }
 
@@ -3935,20 +4527,31 @@ void TTable::PrintSize(){
 	printf("Number of Str columns: %d\n", StrColMaps.Len());
 	TSize MemUsed = GetMemUsedKB();
 	printf("Approximate table size is %s KB\n", TUInt64::GetStr(MemUsed).CStr());
+	if (HasPackedCols()) {
+		TSize LogicalMemUsed = GetLogicalMemUsedKB();
+		printf("Approximate unpacked table size is %s KB\n", TUInt64::GetStr(LogicalMemUsed).CStr());
+	}
+}
+
+// Memory of the columns ColV in [KB], packed columns count with their compressed or their unpacked size.
+template <class TValV>
+static TSize GetTableColsMemUsedKB(const TVec<TValV>& ColV, const TVec<TColPack>& PackV, const bool& Logical) {
+  TSize ApproxSize = 0;
+  for (int i = 0; i < ColV.Len(); i++) {
+    ApproxSize += ColV[i].GetMemUsed()/1000;
+    if (i < PackV.Len() && !PackV[i].Empty()) {
+      ApproxSize += (Logical ? PackV[i].Len() * sizeof(ColV[i][0]) : PackV[i].GetMemUsed())/1000;
+    }
+  }
+  return ApproxSize;
 }
 
 TSize TTable::GetMemUsedKB() {
   TSize ApproxSize = 0;
   ApproxSize += Next.GetMemUsed()/1000;  // Next vector
-  for(int i = 0; i < IntCols.Len(); i++){
-  	ApproxSize += IntCols[i].GetMemUsed()/1000;
-  }
-  for(int i = 0; i < FltCols.Len(); i++){
-  	ApproxSize += FltCols[i].GetMemUsed()/1000;
-  }
-  for(int i = 0; i < StrColMaps.Len(); i++){
-  	ApproxSize += StrColMaps[i].GetMemUsed()/1000;
-  }
+  ApproxSize += GetTableColsMemUsedKB(IntCols, IntColPacks, false);
+  ApproxSize += GetTableColsMemUsedKB(FltCols, FltColPacks, false);
+  ApproxSize += GetTableColsMemUsedKB(StrColMaps, StrColPacks, false);
   ApproxSize += RowIdMap.GetMemUsed()/1000;
   ApproxSize += GroupIDMapping.GetMemUsed()/1000;
   ApproxSize += GroupMapping.GetMemUsed()/1000;
@@ -3956,6 +4559,126 @@ TSize TTable::GetMemUsedKB() {
   return ApproxSize;
 }
 
+TSize TTable::GetLogicalMemUsedKB() {
+  TSize ApproxSize = GetMemUsedKB();
+  ApproxSize -= GetTableColsMemUsedKB(IntCols, IntColPacks, false) + GetTableColsMemUsedKB(FltCols, FltColPacks, false) +
+   GetTableColsMemUsedKB(StrColMaps, StrColPacks, false);
+  ApproxSize += GetTableColsMemUsedKB(IntCols, IntColPacks, true) + GetTableColsMemUsedKB(FltCols, FltColPacks, true) +
+   GetTableColsMemUsedKB(StrColMaps, StrColPacks, true);
+  return ApproxSize;
+}
+
+const int* TTable::GetIntColBf(const int& ColIdx, const int& Beg, const int& Len, TIntV& BufV) const {
+  if (!IsPackedIdx(IntColPacks, ColIdx)) { return (const int*) IntCols[ColIdx].BegI() + Beg; }
+  BufV.Gen(Len);
+  IntColPacks[ColIdx].GetV(Beg, Beg + Len, (int*) BufV.BegI());
+  return (const int*) BufV.BegI();
+}
+
+const double* TTable::GetFltColBf(const int& ColIdx, const int& Beg, const int& Len, TFltV& BufV) const {
+  if (!IsPackedIdx(FltColPacks, ColIdx)) { return (const double*) FltCols[ColIdx].BegI() + Beg; }
+  BufV.Gen(Len);
+  FltColPacks[ColIdx].GetV(Beg, Beg + Len, (double*) BufV.BegI());
+  return (const double*) BufV.BegI();
+}
+
+const int* TTable::GetStrMapColBf(const int& ColIdx, const int& Beg, const int& Len, TIntV& BufV) const {
+  if (!IsPackedIdx(StrColPacks, ColIdx)) { return (const int*) StrColMaps[ColIdx].BegI() + Beg; }
+  BufV.Gen(Len);
+  StrColPacks[ColIdx].GetV(Beg, Beg + Len, (int*) BufV.BegI());
+  return (const int*) BufV.BegI();
+}
+
+// Moves column ColIdx of ColV to PackV, or back if Pack is false.
+template <class TValV>
+static void PackTableCol(TVec<TValV>& ColV, TVec<TColPack>& PackV, const int& ColIdx, const bool& Pack, const TColEnc& Enc) {
+  if (ColIdx < PackV.Len() && !PackV[ColIdx].Empty()) {
+    PackV[ColIdx].GetV(ColV[ColIdx]);
+    PackV[ColIdx].Clr();
+  }
+  if (Pack) {
+    if (PackV.Len() < ColV.Len()) { PackV.Reserve(ColV.Len(), ColV.Len()); }
+    PackV[ColIdx].Pack(ColV[ColIdx], Enc);
+    ColV[ColIdx].Clr(true);
+  }
+  bool Packed = false;
+  for (int i = 0; i < PackV.Len() && !Packed; i++) { Packed = !PackV[i].Empty(); }
+  if (!Packed) { PackV.Clr(); }
+}
+
+void TTable::PackCol(const TStr& ColName, const TColEnc& Enc) {
+  if (!IsColName(ColName)) { TExcept::Throw(ColName + ": no such column"); }
+  const TPair<TAttrType,TInt> ColType = GetColTypeMap(ColName);
+  switch (ColType.Val1) {
+    case atInt: PackTableCol(IntCols, IntColPacks, ColType.Val2, true, Enc); break;
+    case atFlt: PackTableCol(FltCols, FltColPacks, ColType.Val2, true, Enc); break;
+    case atStr: PackTableCol(StrColMaps, StrColPacks, ColType.Val2, true, Enc); break;
+  }
+}
+
+void TTable::Pack(const TColEnc& Enc) {
+  for (int c = 0; c < Sch.Len(); c++) { PackCol(GetSchemaColName(c), Enc); }
+}
+
+void TTable::UnpackCol(const TStr& ColName) {
+  if (!IsColName(ColName)) { TExcept::Throw(ColName + ": no such column"); }
+  const TPair<TAttrType,TInt> ColType = GetColTypeMap(ColName);
+  UnpackColIdx(ColType.Val1, ColType.Val2);
+}
+
+void TTable::UnpackColIdx(const TAttrType& Type, const int& ColIdx) {
+  switch (Type) {
+    case atInt:
+      if (IsPackedIdx(IntColPacks, ColIdx)) { PackTableCol(IntCols, IntColPacks, ColIdx, false, ceAuto); }
+      else { CopyMappedV(IntCols[ColIdx]); }
+      break;
+    case atFlt:
+      if (IsPackedIdx(FltColPacks, ColIdx)) { PackTableCol(FltCols, FltColPacks, ColIdx, false, ceAuto); }
+      else { CopyMappedV(FltCols[ColIdx]); }
+      break;
+    case atStr:
+      if (IsPackedIdx(StrColPacks, ColIdx)) { PackTableCol(StrColMaps, StrColPacks, ColIdx, false, ceAuto); }
+      else { CopyMappedV(StrColMaps[ColIdx]); }
+      break;
+  }
+}
+
+void TTable::Unpack() {
+  // columns of a table opened with LoadMmap() are read-only, they are copied before rows are moved
+  CopyMappedV(Next);
+  for (int i = 0; i < IntCols.Len(); i++) { CopyMappedV(IntCols[i]); }
+  for (int i = 0; i < FltCols.Len(); i++) { CopyMappedV(FltCols[i]); }
+  for (int i = 0; i < StrColMaps.Len(); i++) { CopyMappedV(StrColMaps[i]); }
+  if (!HasPackedCols()) { return; }
+  const int FltOffset = IntColPacks.Len();
+  const int StrOffset = FltOffset + FltColPacks.Len();
+  const int TotalCols = StrOffset + StrColPacks.Len();
+#ifdef USE_OPENMP
+  #pragma omp parallel for schedule(dynamic, 1) if (GetMP())
+#endif
+  for (int i = 0; i < TotalCols; i++) {
+    if (i < FltOffset) {
+      if (!IntColPacks[i].Empty()) { IntColPacks[i].GetV(IntCols[i]); }
+    } else if (i < StrOffset) {
+      if (!FltColPacks[i-FltOffset].Empty()) { FltColPacks[i-FltOffset].GetV(FltCols[i-FltOffset]); }
+    } else {
+      if (!StrColPacks[i-StrOffset].Empty()) { StrColPacks[i-StrOffset].GetV(StrColMaps[i-StrOffset]); }
+    }
+  }
+  IntColPacks.Clr();  FltColPacks.Clr();  StrColPacks.Clr();
+}
+
+bool TTable::IsPackedCol(const TStr& ColName) const {
+  if (!IsColName(ColName)) { return false; }
+  const TPair<TAttrType,TInt> ColType = GetColTypeMap(ColName);
+  switch (ColType.Val1) {
+    case atInt: return IsPackedIdx(IntColPacks, ColType.Val2);
+    case atFlt: return IsPackedIdx(FltColPacks, ColType.Val2);
+    case atStr: return IsPackedIdx(StrColPacks, ColType.Val2);
+  }
+  return false;
+}
+
 void TTable::PrintContextSize(){
 	printf("Number of strings in pool: ");
 	printf("%d\n", Context->StringVals.Len());
@@ -3972,10 +4695,21 @@ TSize TTable::GetContextMemUsedKB(){
 	return ApproxSize;
 }
 
+// Appends column ColIdx of ColV to DstV, a packed column is decoded a block at a time.
+template <class TVal, class TValV>
+static void AddTableCol(TValV& DstV, const TVec<TValV>& ColV, const TVec<TColPack>& PackV, const int& ColIdx) {
+  if (ColIdx >= PackV.Len() || PackV[ColIdx].Empty()) { DstV.AddV(ColV[ColIdx]);  return; }
+  const int Beg = DstV.Len();
+  const int Vals = int(PackV[ColIdx].Len());
+  DstV.Reserve(Beg + Vals, Beg + Vals);
+  PackV[ColIdx].GetV(0, Vals, (TVal*) DstV.BegI() + Beg);
+}
+
 void TTable::AddTable(const TTable& T) {
   //for (TInt c = 0; c < S.Len(); c++) {
   //  if (S[c] != T.S[c]) { printf("(%s,%d) != (%s,%d)\n", S[c].Val1.CStr(), S[c].Val2, T.S[c].Val1.CStr(), T.S[c].Val2); TExcept::Throw("when adding tables, their schemas must match!"); }
   //}
+  Unpack();
   for (TInt c = 0; c < Sch.Len(); c++) {
     TStr ColName = GetSchemaColName(c);
     TInt ColIdx = GetColIdx(ColName);
@@ -3983,13 +4717,13 @@ void TTable::AddTable(const TTable& T) {
     if (TColIdx < 0) { TExcept::Throw("when adding a table, it must contain all columns of source table!"); }
     switch (GetColType(ColName)) { 
     case atInt:
-       IntCols[ColIdx].AddV(T.IntCols[TColIdx]);
+       AddTableCol<int>(IntCols[ColIdx], T.IntCols, T.IntColPacks, TColIdx);
        break;
     case atFlt:
-       FltCols[ColIdx].AddV(T.FltCols[TColIdx]);
+       AddTableCol<double>(FltCols[ColIdx], T.FltCols, T.FltColPacks, TColIdx);
        break;
     case atStr:
-       StrColMaps[ColIdx].AddV(T.StrColMaps[TColIdx]);
+       AddTableCol<int>(StrColMaps[ColIdx], T.StrColMaps, T.StrColPacks, TColIdx);
        break;
     }
   }
@@ -4151,6 +4885,7 @@ void TTable::UpdateTableForNewRow() {
 #ifdef GCC_ATOMIC
 void TTable::SetFltColToConstMP(TInt UpdateColIdx, TFlt DefaultFltVal){
     if(!GetMP()){ TExcept::Throw("Not Using MP!");}
+	UnpackColIdx(atFlt, UpdateColIdx);
 	TIntPrV Partitions;
 	GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
 	TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
@@ -4191,6 +4926,7 @@ void TTable::UpdateFltFromTableMP(const TStr& KeyAttr, const TStr& UpdateAttr,
   TInt UpdateColIdx = GetColIdx(UpdateAttr);
   TInt FKeyColIdx = GetColIdx(FKeyAttr);
   TInt ReadColIdx = GetColIdx(ReadAttr);
+  UnpackColIdx(atFlt, UpdateColIdx);
 
   // TODO: this should be a generic vector operation
   SetFltColToConstMP(UpdateColIdx, DefaultFltVal);
@@ -4264,6 +5000,7 @@ void TTable::UpdateFltFromTable(const TStr& KeyAttr, const TStr& UpdateAttr, con
   TStr NFKeyAttr = Table.NormalizeColName(FKeyAttr);
   TStr NReadAttr = Table.NormalizeColName(ReadAttr);
   TInt UpdateColIdx = GetColIdx(UpdateAttr);
+  UnpackColIdx(atFlt, UpdateColIdx);
   	
   for(TRowIterator iter = BegRI(); iter < EndRI(); iter++){
     FltCols[UpdateColIdx][iter.GetRowIdx()] = DefaultFltVal;
@@ -4293,6 +5030,7 @@ void TTable::UpdateFltFromTable(const TStr& KeyAttr, const TStr& UpdateAttr, con
 
 // can ONLY be called when a table is being initialised (before IDs are allocated)
 void TTable::AddRowI(const TRowIterator& RI) {
+  Unpack();
   for (TInt c = 0; c < Sch.Len(); c++) {
     TStr ColName = GetSchemaColName(c);
     if (ColName == IdColName) { continue; }
@@ -4315,6 +5053,7 @@ void TTable::AddRowI(const TRowIterator& RI) {
 }
 
 void TTable::AddRowV(const TIntV& IntVals, const TFltV& FltVals, const TStrV& StrVals) {
+  Unpack();
   for (TInt c = 0; c < IntVals.Len(); c++) {
     IntCols[c].Add(IntVals[c]);
   }
@@ -4328,6 +5067,7 @@ void TTable::AddRowV(const TIntV& IntVals, const TFltV& FltVals, const TStrV& St
 }
 
 void TTable::ResizeTable(int RowCount) {
+  Unpack();
   if (RowCount == 0) {
     // initialize empty table
     NumValidRows = 0;
@@ -4404,13 +5144,13 @@ void TTable::AddSelectedRows(const TTable& Table, const TIntV& RowIDs) {
   for (TInt r = 0; r < NewRows; r++) {
     TInt CurrRowIdx = RowIDs[r];
     for (TInt i = 0; i < Table.IntCols.Len(); i++) {
-      IntCols[i][start+r] = Table.IntCols[i][CurrRowIdx];
+      IntCols[i][start+r] = Table.GetIntIdx(i, CurrRowIdx);
     }
     for (TInt i = 0; i < Table.FltCols.Len(); i++) {
-      FltCols[i][start+r] = Table.FltCols[i][CurrRowIdx];
+      FltCols[i][start+r] = Table.GetFltIdx(i, CurrRowIdx);
     }
     for (TInt i = 0; i < Table.StrColMaps.Len(); i++) {
-      StrColMaps[i][start+r] = Table.StrColMaps[i][CurrRowIdx];
+      StrColMaps[i][start+r] = Table.GetStrMapIdx(i, CurrRowIdx);
     }
   }
   for (TInt r = 0; r < NewRows-1; r++) {
@@ -4478,22 +5218,22 @@ void TTable::AddNJointRowsMP(const TTable& T1, const TTable& T2, const TVec<TInt
     for (TInt r = 0; r < NewRows; r++){
       TIntPr CurrRowIdPr = RowIDs[r]; 
       for(TInt i = 0; i < T1.IntCols.Len(); i++){
-        IntCols[i][start+r] = T1.IntCols[i][CurrRowIdPr.GetVal1()];
+        IntCols[i][start+r] = T1.GetIntIdx(i, CurrRowIdPr.GetVal1());
       }
       for(TInt i = 0; i < T1.FltCols.Len(); i++){
-        FltCols[i][start+r] = T1.FltCols[i][CurrRowIdPr.GetVal1()];
+        FltCols[i][start+r] = T1.GetFltIdx(i, CurrRowIdPr.GetVal1());
       }
       for(TInt i = 0; i < T1.StrColMaps.Len(); i++){
-        StrColMaps[i][start+r] = T1.StrColMaps[i][CurrRowIdPr.GetVal1()];
+        StrColMaps[i][start+r] = T1.GetStrMapIdx(i, CurrRowIdPr.GetVal1());
       }
       for(TInt i = 0; i < T2.IntCols.Len(); i++){
-        IntCols[i+IntOffset][start+r] = T2.IntCols[i][CurrRowIdPr.GetVal2()];
+        IntCols[i+IntOffset][start+r] = T2.GetIntIdx(i, CurrRowIdPr.GetVal2());
       }
       for(TInt i = 0; i < T2.FltCols.Len(); i++){
-        FltCols[i+FltOffset][start+r] = T2.FltCols[i][CurrRowIdPr.GetVal2()];
+        FltCols[i+FltOffset][start+r] = T2.GetFltIdx(i, CurrRowIdPr.GetVal2());
       }
       for(TInt i = 0; i < T2.StrColMaps.Len(); i++){
-        StrColMaps[i+StrOffset][start+r] = T2.StrColMaps[i][CurrRowIdPr.GetVal2()];
+        StrColMaps[i+StrOffset][start+r] = T2.GetStrMapIdx(i, CurrRowIdPr.GetVal2());
       }
       IntCols[IdOffset][start+r] = start+r;
     }
@@ -4704,50 +5444,90 @@ void TTable::ClassifyAux(const TIntV& SelectedRows, const TStr& LabelName, const
   }
 }
 
+// Column-wise arithmetic kernels. The operation is a template argument, so every loop is branch free.
+// Float modulo is rejected before any kernel runs, the double overload only lets the kernels compile.
+static inline int TableMod(const int& Val1, const int& Val2) { return Val1 % Val2; }
+static inline double TableMod(const double& Val1, const double& Val2) { return fmod(Val1, Val2); }
+
+template <int Op, class TRes>
+static inline TRes TableArith(const TRes& Val1, const TRes& Val2) {
+  switch (Op) {
+    case aoAdd: return Val1 + Val2;
+    case aoSub: return Val1 - Val2;
+    case aoMul: return Val1 * Val2;
+    case aoDiv: return Val1 / Val2;
+    case aoMod: return TableMod(Val1, Val2);
+    case aoMin: return (Val1 < Val2) ? Val1 : Val2;
+    default: return (Val1 > Val2) ? Val1 : Val2;
+  }
+}
+
+// Computes ResV[i] = Arg1V[i] Op Arg2V[i], or Arg1V[i] Op Arg2 if Arg2V is NULL.
+template <int Op, class TArg1, class TArg2, class TRes>
+static void TableColOpLoop(const TArg1* Arg1V, const TArg2* Arg2V, const TRes& Arg2, TRes* ResV, const int& Rows) {
+  if (Arg2V == NULL) {
+    for (int i = 0; i < Rows; i++) { ResV[i] = TableArith<Op>(TRes(Arg1V[i]), Arg2); }
+  } else {
+    for (int i = 0; i < Rows; i++) { ResV[i] = TableArith<Op>(TRes(Arg1V[i]), TRes(Arg2V[i])); }
+  }
+}
+
+template <class TArg1, class TArg2, class TRes>
+static void TableColOp(const TArg1* Arg1V, const TArg2* Arg2V, const TRes& Arg2, TRes* ResV, const int& Rows, TArithOp Op) {
+  switch (Op) {
+    case aoAdd: TableColOpLoop<aoAdd>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+    case aoSub: TableColOpLoop<aoSub>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+    case aoMul: TableColOpLoop<aoMul>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+    case aoDiv: TableColOpLoop<aoDiv>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+    case aoMod: TableColOpLoop<aoMod>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+    case aoMin: TableColOpLoop<aoMin>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+    case aoMax: TableColOpLoop<aoMax>(Arg1V, Arg2V, Arg2, ResV, Rows); break;
+  }
+}
+
+// Dispatches on column types, exactly one of each pair of argument pointers is set, or none of Arg2 for a constant.
+static void TableColOp(const int* Arg1IntV, const double* Arg1FltV, const int* Arg2IntV, const double* Arg2FltV,
+ const double& Num, int* ResIntV, double* ResFltV, const int& Rows, TArithOp Op) {
+  if (ResIntV != NULL) {
+    TableColOp(Arg1IntV, Arg2IntV, static_cast<int>(Num), ResIntV, Rows, Op);
+  } else if (Arg1IntV != NULL) {
+    if (Arg2FltV != NULL) { TableColOp(Arg1IntV, Arg2FltV, Num, ResFltV, Rows, Op); }
+    else { TableColOp(Arg1IntV, Arg2IntV, Num, ResFltV, Rows, Op); }
+  } else {
+    if (Arg2FltV != NULL) { TableColOp(Arg1FltV, Arg2FltV, Num, ResFltV, Rows, Op); }
+    else { TableColOp(Arg1FltV, Arg2IntV, Num, ResFltV, Rows, Op); }
+  }
+}
+
+void TTable::ColGenericOpRanges(const TAttrType& ArgType1, const TInt& ArgColIdx1, const TAttrType& ArgType2,
+ const TInt& ArgColIdx2, const TFlt& Num, const TAttrType& ResType, const TInt& ResColIdx, TArithOp Op) {
+  if (Op == aoMod && ResType == atFlt) { TExcept::Throw("Cannot find modulo for float columns"); }
+  // the result column is written in place, packed argument columns are decoded a range at a time
+  UnpackColIdx(ResType, ResColIdx);
+  TIntPrV RangeV;
+  GetValidRowRanges(RangeV, TableBlockRows);
 #ifdef USE_OPENMP
-void TTable::ColGenericOpMP(TInt ArgColIdx1, TInt ArgColIdx2, TAttrType ArgType1, TAttrType ArgType2, TInt ResColIdx, TArithOp op){
-	TAttrType ResType = atFlt;
-	if(ArgType1 == atInt && ArgType2 == atInt){ ResType = atInt;}
-	TIntPrV Partitions;
-	GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-	TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-	#pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD)
-	for (int i = 0; i < Partitions.Len(); i++){
-		TRowIterator RowI(Partitions[i].GetVal1(), this);
-		TRowIterator EndI(Partitions[i].GetVal2(), this);
-		while(RowI < EndI){
-			if(ResType == atInt){
-				TInt V1 = RowI.GetIntAttr(ArgColIdx1);
-				TInt V2 = RowI.GetIntAttr(ArgColIdx2);
-				if (op == aoAdd) { IntCols[ResColIdx][RowI.GetRowIdx()] = V1 + V2; }
-      			if (op == aoSub) { IntCols[ResColIdx][RowI.GetRowIdx()] = V1 - V2; }
-      			if (op == aoMul) { IntCols[ResColIdx][RowI.GetRowIdx()] = V1 * V2; }
-      			if (op == aoDiv) { IntCols[ResColIdx][RowI.GetRowIdx()] = V1 / V2; }
-      			if (op == aoMod) { IntCols[ResColIdx][RowI.GetRowIdx()] = V1 % V2; }
-      			if (op == aoMin) { IntCols[ResColIdx][RowI.GetRowIdx()] = (V1 < V2) ? V1 : V2;}
-      			if (op == aoMax) { IntCols[ResColIdx][RowI.GetRowIdx()] = (V1 > V2) ? V1 : V2;}
-			} else{
-			    TFlt V1 = (ArgType1 == atInt) ? (TFlt)RowI.GetIntAttr(ArgColIdx1) : RowI.GetFltAttr(ArgColIdx1);
-			    TFlt V2 = (ArgType2 == atInt) ? (TFlt)RowI.GetIntAttr(ArgColIdx2) : RowI.GetFltAttr(ArgColIdx2);
-				if (op == aoAdd) { FltCols[ResColIdx][RowI.GetRowIdx()] = V1 + V2; }
-      			if (op == aoSub) { FltCols[ResColIdx][RowI.GetRowIdx()] = V1 - V2; }
-      			if (op == aoMul) { FltCols[ResColIdx][RowI.GetRowIdx()] = V1 * V2; }
-      			if (op == aoDiv) { FltCols[ResColIdx][RowI.GetRowIdx()] = V1 / V2; }
-      			if (op == aoMod) { TExcept::Throw("Cannot find modulo for float columns");  }
-      			if (op == aoMin) { FltCols[ResColIdx][RowI.GetRowIdx()] = (V1 < V2) ? V1 : V2;}
-      			if (op == aoMax) { FltCols[ResColIdx][RowI.GetRowIdx()] = (V1 > V2) ? V1 : V2;}
-			}
-			RowI++;
-		}
-	}
+  #pragma omp parallel for schedule(dynamic, 1) if (GetMP() && RangeV.Len() > 1)
+#endif
+  for (int r = 0; r < RangeV.Len(); r++) {
+    const int Beg = RangeV[r].Val1;
+    const int Rows = RangeV[r].Val2 - Beg;
+    TIntV IntBuf1V, IntBuf2V;
+    TFltV FltBuf1V, FltBuf2V;
+    const int* Arg1IntV = ArgType1 == atInt ? GetIntColBf(ArgColIdx1, Beg, Rows, IntBuf1V) : NULL;
+    const double* Arg1FltV = ArgType1 == atFlt ? GetFltColBf(ArgColIdx1, Beg, Rows, FltBuf1V) : NULL;
+    const int* Arg2IntV = (ArgColIdx2 >= 0 && ArgType2 == atInt) ? GetIntColBf(ArgColIdx2, Beg, Rows, IntBuf2V) : NULL;
+    const double* Arg2FltV = (ArgColIdx2 >= 0 && ArgType2 == atFlt) ? GetFltColBf(ArgColIdx2, Beg, Rows, FltBuf2V) : NULL;
+    int* ResIntV = ResType == atInt ? (int*) IntCols[ResColIdx].BegI() + Beg : NULL;
+    double* ResFltV = ResType == atFlt ? (double*) FltCols[ResColIdx].BegI() + Beg : NULL;
+    TableColOp(Arg1IntV, Arg1FltV, Arg2IntV, Arg2FltV, Num, ResIntV, ResFltV, Rows, Op);
+  }
 }
-#endif	// USE_OPENMP
 
 /* Performs generic operations on two numeric attributes
  * Operation can be +, -, *, /, %, min or max
- * Alternative is to write separate functions for each operation
- * Branch prediction may result in as fast performance anyway ?
- *
+ * The operation is applied to runs of valid rows with tight loops over the columns,
+ * see TTable::ColGenericOpRanges
  */
 void TTable::ColGenericOp(const TStr& Attr1, const TStr& Attr2, const TStr& ResAttr, TArithOp op) {
   // check if attributes are valid
@@ -4766,7 +5546,7 @@ void TTable::ColGenericOp(const TStr& Attr1, const TStr& Attr2, const TStr& ResA
   // source column indices
   TInt ColIdx1 = Info1.Val2;
   TInt ColIdx2 = Info2.Val2;
-  
+
   // destination column index
   TInt ColIdx3 = ColIdx1;
   // Create empty result column with type that of first attribute
@@ -4779,38 +5559,9 @@ void TTable::ColGenericOp(const TStr& Attr1, const TStr& Attr2, const TStr& ResA
       }
       ColIdx3 = GetColIdx(ResAttr);
   }
-#ifdef USE_OPENMP
-  if(GetMP()){
-  	ColGenericOpMP(ColIdx1, ColIdx2, Arg1Type, Arg2Type, ColIdx3, op);
-  	return;
-  }
-#endif	//USE_OPENMP
   TAttrType ResType = atFlt;
-  if(Arg1Type == atInt && Arg2Type == atInt){ printf("hooray!\n"); ResType = atInt;}
-  for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
-  	//printf("%d %d %d %d\n", ColIdx1.Val, ColIdx2.Val, ColIdx3.Val, RowI.GetRowIdx().Val);
-		if(ResType == atInt){
-			TInt V1 = RowI.GetIntAttr(ColIdx1);
-			TInt V2 = RowI.GetIntAttr(ColIdx2);
-			if (op == aoAdd) { IntCols[ColIdx3][RowI.GetRowIdx()] = V1 + V2; }
-      		if (op == aoSub) { IntCols[ColIdx3][RowI.GetRowIdx()] = V1 - V2; }
-      		if (op == aoMul) { IntCols[ColIdx3][RowI.GetRowIdx()] = V1 * V2; }
-      		if (op == aoDiv) { IntCols[ColIdx3][RowI.GetRowIdx()] = V1 / V2; }
-      		if (op == aoMod) { IntCols[ColIdx3][RowI.GetRowIdx()] = V1 % V2; }
-      		if (op == aoMin) { IntCols[ColIdx3][RowI.GetRowIdx()] = (V1 < V2) ? V1 : V2;}
-      		if (op == aoMax) { IntCols[ColIdx3][RowI.GetRowIdx()] = (V1 > V2) ? V1 : V2;}
-		} else{
-			TFlt V1 = (Arg1Type == atInt) ? (TFlt)RowI.GetIntAttr(ColIdx1) : RowI.GetFltAttr(ColIdx1);
-			TFlt V2 = (Arg2Type == atInt) ? (TFlt)RowI.GetIntAttr(ColIdx2) : RowI.GetFltAttr(ColIdx2);
-			if (op == aoAdd) { FltCols[ColIdx3][RowI.GetRowIdx()] = V1 + V2; }
-      		if (op == aoSub) { FltCols[ColIdx3][RowI.GetRowIdx()] = V1 - V2; }
-      		if (op == aoMul) { FltCols[ColIdx3][RowI.GetRowIdx()] = V1 * V2; }
-      		if (op == aoDiv) { FltCols[ColIdx3][RowI.GetRowIdx()] = V1 / V2; }
-      		if (op == aoMod) { TExcept::Throw("Cannot find modulo for float columns");  }
-      		if (op == aoMin) { FltCols[ColIdx3][RowI.GetRowIdx()] = (V1 < V2) ? V1 : V2;}
-      		if (op == aoMax) { FltCols[ColIdx3][RowI.GetRowIdx()] = (V1 > V2) ? V1 : V2;}
-		}
-  }
+  if (Arg1Type == atInt && Arg2Type == atInt) { ResType = atInt; }
+  ColGenericOpRanges(Arg1Type, ColIdx1, Arg2Type, ColIdx2, 0, ResType, ColIdx3, op);
 }
 
 void TTable::ColAdd(const TStr& Attr1, const TStr& Attr2, const TStr& ResultAttrName) {
@@ -4888,62 +5639,52 @@ void TTable::ColGenericOp(const TStr& Attr1, TTable& Table, const TStr& Attr2, c
     }
   }
   
-  /*
-  #ifdef USE_OPENMP
-  if(GetMP()){
-  	ColGenericOpMP(Table, AddToFirstTable, ColIdx1, ColIdx2, Arg1Type, Arg2Type, ColIdx3, op);
-  	return;
-  }
-  #endif	//USE_OPENMP
-  */
-	
-  TRowIterator RI1, RI2;
-  RI1 = BegRI();
-  RI2 = Table.BegRI();
   TAttrType ResType = atFlt;
   if(Arg1Type == atInt && Arg2Type == atInt){ ResType = atInt;}
-  while (RI1 < EndRI() && RI2 < Table.EndRI()) {
-    if (ResType == atInt) {
-		TInt V1 = RI1.GetIntAttr(ColIdx1);
-		TInt V2 = RI2.GetIntAttr(ColIdx2);
-        if (AddToFirstTable) {
-        	if (op == aoAdd) { IntCols[ColIdx3][RI1.GetRowIdx()] = V1 + V2; }
-        	if (op == aoSub) { IntCols[ColIdx3][RI1.GetRowIdx()] = V1 - V2; }
-        	if (op == aoMul) { IntCols[ColIdx3][RI1.GetRowIdx()] = V1 * V2; }
-        	if (op == aoDiv) { IntCols[ColIdx3][RI1.GetRowIdx()] = V1 / V2; }
-       		if (op == aoMod) { IntCols[ColIdx3][RI1.GetRowIdx()] = V1 % V2; }
-      	}
-      	else {
-        	if (op == aoAdd) { Table.IntCols[ColIdx3][RI2.GetRowIdx()] = V1 + V2; }
-        	if (op == aoSub) { Table.IntCols[ColIdx3][RI2.GetRowIdx()] = V1 - V2; }
-        	if (op == aoMul) { Table.IntCols[ColIdx3][RI2.GetRowIdx()] = V1 * V2; }
-        	if (op == aoDiv) { Table.IntCols[ColIdx3][RI2.GetRowIdx()] = V1 / V2; }
-        	if (op == aoMod) { Table.IntCols[ColIdx3][RI2.GetRowIdx()] = V1 % V2; }
-      	}
-    } else {
-	  	TFlt V1 = (Arg1Type == atInt) ? (TFlt)RI1.GetIntAttr(ColIdx1) : RI2.GetFltAttr(ColIdx1);
-		TFlt V2 = (Arg2Type == atInt) ? (TFlt)RI1.GetIntAttr(ColIdx2) : RI2.GetFltAttr(ColIdx2);
-      	if (AddToFirstTable) {
-        	if (op == aoAdd) { FltCols[ColIdx3][RI1.GetRowIdx()] = V1 + V2; }
-        	if (op == aoSub) { FltCols[ColIdx3][RI1.GetRowIdx()] = V1 - V2; }
-        	if (op == aoMul) { FltCols[ColIdx3][RI1.GetRowIdx()] = V1 * V2; }
-       	 	if (op == aoDiv) { FltCols[ColIdx3][RI1.GetRowIdx()] = V1 / V2; }
-        	if (op == aoMod) { TExcept::Throw("Cannot find modulo for float columns"); }
-      	} else {
-        	if (op == aoAdd) { Table.FltCols[ColIdx3][RI2.GetRowIdx()] = V1 + V2; }
-        	if (op == aoSub) { Table.FltCols[ColIdx3][RI2.GetRowIdx()] = V1 - V2; }
-        	if (op == aoMul) { Table.FltCols[ColIdx3][RI2.GetRowIdx()] = V1 * V2; }
-        	if (op == aoDiv) { Table.FltCols[ColIdx3][RI2.GetRowIdx()] = V1 / V2; }
-        	if (op == aoMod) { TExcept::Throw("Cannot find modulo for float columns"); }
-      	}
-    }
-    RI1++;
-    RI2++;
-  }
-
-  if (RI1 != EndRI() || RI2 != Table.EndRI()) {
+  if (op == aoMod && ResType == atFlt) { TExcept::Throw("Cannot find modulo for float columns"); }
+
+  // the tables can store their rows in different physical orders, so the operands
+  // are gathered in iteration order, computed in one pass and scattered back
+  TIntV RowV1(NumValidRows, 0), RowV2(Table.NumValidRows, 0);
+  for (TRowIterator RI = BegRI(); RI < EndRI(); RI++) { RowV1.Add(RI.GetRowIdx()); }
+  for (TRowIterator RI = Table.BegRI(); RI < Table.EndRI(); RI++) { RowV2.Add(RI.GetRowIdx()); }
+  if (RowV1.Len() != RowV2.Len()) {
     TExcept::Throw("ColGenericOp: Iteration error");
   }
+  const int Rows = RowV1.Len();
+  TIntV Arg1IntV, Arg2IntV;
+  TFltV Arg1FltV, Arg2FltV;
+  if (Arg1Type == atInt) {
+    Arg1IntV.Gen(Rows);
+    for (int i = 0; i < Rows; i++) { Arg1IntV[i] = GetIntIdx(ColIdx1, RowV1[i]); }
+  } else {
+    Arg1FltV.Gen(Rows);
+    for (int i = 0; i < Rows; i++) { Arg1FltV[i] = GetFltIdx(ColIdx1, RowV1[i]); }
+  }
+  if (Arg2Type == atInt) {
+    Arg2IntV.Gen(Rows);
+    for (int i = 0; i < Rows; i++) { Arg2IntV[i] = Table.GetIntIdx(ColIdx2, RowV2[i]); }
+  } else {
+    Arg2FltV.Gen(Rows);
+    for (int i = 0; i < Rows; i++) { Arg2FltV[i] = Table.GetFltIdx(ColIdx2, RowV2[i]); }
+  }
+  TTable& ResTable = AddToFirstTable ? *this : Table;
+  const TIntV& ResRowV = AddToFirstTable ? RowV1 : RowV2;
+  ResTable.UnpackColIdx(ResType, ColIdx3);
+  if (ResType == atInt) {
+    TIntV ResV(Rows);
+    TableColOp((const int*) Arg1IntV.BegI(), NULL, (const int*) Arg2IntV.BegI(), NULL, 0,
+     (int*) ResV.BegI(), NULL, Rows, op);
+    for (int i = 0; i < Rows; i++) { ResTable.IntCols[ColIdx3][ResRowV[i]] = ResV[i]; }
+  } else {
+    TFltV ResV(Rows);
+    TableColOp(Arg1Type == atInt ? (const int*) Arg1IntV.BegI() : NULL,
+     Arg1Type == atFlt ? (const double*) Arg1FltV.BegI() : NULL,
+     Arg2Type == atInt ? (const int*) Arg2IntV.BegI() : NULL,
+     Arg2Type == atFlt ? (const double*) Arg2FltV.BegI() : NULL, 0,
+     NULL, (double*) ResV.BegI(), Rows, op);
+    for (int i = 0; i < Rows; i++) { ResTable.FltCols[ColIdx3][ResRowV[i]] = ResV[i]; }
+  }
 }
 
 void TTable::ColAdd(const TStr& Attr1, TTable& Table, const TStr& Attr2, 
@@ -5000,66 +5741,10 @@ void TTable::ColGenericOp(const TStr& Attr1, const TFlt& Num, const TStr& ResAtt
     shouldCast = false;
   }
   
-  #ifdef USE_OPENMP
-  if(GetMP()){
-  	ColGenericOpMP(ColIdx1, ColIdx2, ArgType, Num, op, shouldCast);
-  	return;
-  }
-  #endif  //USE_OPENMP
-	
-  for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
-    if ((ArgType == atInt) && !shouldCast) {
-      TInt CurVal = RowI.GetIntAttr(ColIdx1);
-      TInt Val = static_cast<int>(Num);
-      if (op == aoAdd) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal + Val; }
-      if (op == aoSub) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal - Val; }
-      if (op == aoMul) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal * Val; }
-      if (op == aoDiv) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal / Val; }
-      if (op == aoMod) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal % Val; }
-    }
-    else {
-      TFlt CurVal = (ArgType == atFlt) ? RowI.GetFltAttr(ColIdx1) : (TFlt) RowI.GetIntAttr(ColIdx1);
-      if (op == aoAdd) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal + Num; }
-      if (op == aoSub) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal - Num; }
-      if (op == aoMul) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal * Num; }
-      if (op == aoDiv) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal / Num; }
-      if (op == aoMod) { TExcept::Throw("Cannot find modulo for float columns"); }
-    }
-  }
+  TAttrType ResType = ((ArgType == atInt) && !shouldCast) ? atInt : atFlt;
+  ColGenericOpRanges(ArgType, ColIdx1, atFlt, -1, Num, ResType, ColIdx2, op);
 }
 
-#ifdef USE_OPENMP
-void TTable::ColGenericOpMP(const TInt& ColIdx1, const TInt& ColIdx2, TAttrType ArgType, const TFlt& Num, TArithOp op, TBool ShouldCast){
-	TIntPrV Partitions;
-	GetPartitionRanges(Partitions, omp_get_max_threads()*CHUNKS_PER_THREAD);
-	TInt PartitionSize = Partitions[0].GetVal2()-Partitions[0].GetVal1()+1;
-	#pragma omp parallel for schedule(dynamic, CHUNKS_PER_THREAD)
-	for (int i = 0; i < Partitions.Len(); i++){
-		TRowIterator RowI(Partitions[i].GetVal1(), this);
-		TRowIterator EndI(Partitions[i].GetVal2(), this);
-		while(RowI < EndI){
-			if ((ArgType == atInt) && !ShouldCast) {
-      			TInt CurVal = RowI.GetIntAttr(ColIdx1);
-      			TInt Val = static_cast<int>(Num);
-      			if (op == aoAdd) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal + Val; }
-      			if (op == aoSub) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal - Val; }
-      			if (op == aoMul) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal * Val; }
-      			if (op == aoDiv) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal / Val; }
-      			if (op == aoMod) { IntCols[ColIdx2][RowI.GetRowIdx()] = CurVal % Val; }
-    		} else {
-     			TFlt CurVal = (ArgType == atFlt) ? RowI.GetFltAttr(ColIdx1) : (TFlt) RowI.GetIntAttr(ColIdx1);
-      			if (op == aoAdd) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal + Num; }
-      			if (op == aoSub) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal - Num; }
-      			if (op == aoMul) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal * Num; }
-      			if (op == aoDiv) { FltCols[ColIdx2][RowI.GetRowIdx()] = CurVal / Num; }
-      			if (op == aoMod) { TExcept::Throw("Cannot find modulo for float columns"); }
-    		}
-    		RowI++;
-		}
-	}
-}
-#endif
-
 void TTable::ColAdd(const TStr& Attr1, const TFlt& Num, const TStr& ResultAttrName, const TBool floatCast) {
   ColGenericOp(Attr1, Num, ResultAttrName, aoAdd, floatCast);
 }
@@ -5104,6 +5789,7 @@ void TTable::ColConcat(const TStr& Attr1, const TStr& Attr2, const TStr& Sep, co
       AddStrCol(ResAttr);
       ColIdx3 = GetColIdx(ResAttr);
   }
+  UnpackColIdx(atStr, ColIdx3);
 
   for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
     TStr CurVal1 = RowI.GetStrAttr(ColIdx1);
@@ -5153,6 +5839,11 @@ void TTable::ColConcat(const TStr& Attr1, TTable& Table, const TStr& Attr2, cons
       ColIdx3 = Table.GetColIdx(ResAttr);
     }
   }
+  if (AddToFirstTable) {
+    UnpackColIdx(atStr, ColIdx3);
+  } else {
+    Table.UnpackColIdx(atStr, ColIdx3);
+  }
 
   TRowIterator RI1, RI2;
 
@@ -5200,6 +5891,7 @@ void TTable::ColConcatConst(const TStr& Attr1, const TStr& Val, const TStr& Sep,
     AddStrCol(ResAttr);
     ColIdx2 = GetColIdx(ResAttr);
   }
+  UnpackColIdx(atStr, ColIdx2);
 
   for (TRowIterator RowI = BegRI(); RowI < EndRI(); RowI++) {
     TStr CurVal = RowI.GetStrAttr(ColIdx1);
@@ -5248,15 +5940,19 @@ void TTable::ProjectInPlace(const TStrV& ProjectCols) {
     if (ProjectColsSet.IsKey(ColName) || ColName == IdColName) { continue; }
     TAttrType ColType = GetSchemaColType(i);
     TInt ColId = GetColIdx(ColName);
+    // packed columns are dropped along with their column vectors
     switch (ColType) {
       case atInt:
         IntCols.Del(ColId);
+        if (ColId < IntColPacks.Len()) { IntColPacks.Del(ColId); }
         break;
       case atFlt:
         FltCols.Del(ColId);
+        if (ColId < FltColPacks.Len()) { FltColPacks.Del(ColId); }
         break;
       case atStr:
         StrColMaps.Del(ColId);
+        if (ColId < StrColPacks.Len()) { StrColPacks.Del(ColId); }
         break;
     }
   }
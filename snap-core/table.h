@@ -44,6 +44,7 @@ class TAtomicPredicate {
       FltConst(0), StrConst("") {}
     friend class TPredicate;
 		friend class TPredicateNode;
+		friend class TTable;
 };
 
 //#//////////////////////////////////////////////
@@ -133,6 +134,7 @@ class TPredicate {
 				default: return false;
 			}
 		}
+		friend class TTable;
 };
 
 //#//////////////////////////////////////////////
@@ -550,6 +552,9 @@ protected:
   TVec<TIntV> IntCols; ///< Data columns of integer attributes.
   TVec<TFltV> FltCols; ///< Data columns of floating point attributes.
   TVec<TIntV> StrColMaps; ///< Data columns of integer mappings of string attributes. ##TTable::StrColMaps
+  TVec<TColPack> IntColPacks; ///< Packed integer columns, the column is in IntColPacks[i] instead of IntCols[i] if it is not empty. ##TTable::PackCol
+  TVec<TColPack> FltColPacks; ///< Packed floating point columns.
+  TVec<TColPack> StrColPacks; ///< Packed integer mappings of string columns.
   THash<TStr,TPair<TAttrType,TInt> > ColTypeMap; /// A mapping from column name to column type and column index among columns of the same type.
   TStr IdColName; ///< Name of column associated with (optional) permanent row identifiers.
   TIntIntH RowIdMap; ///< Mapping of permanent row ids to physical id.
@@ -578,6 +583,23 @@ protected:
 
   TInt IsNextDirty; ///< Flag to signify whether the rows are stored in logical sequence or reordered. Used for optimizing GetPartitionRanges.
 
+  /// Header of the memory-mapped format, see SaveMmap(). All the offsets are relative to the start of the header.
+  struct TMmapHdr {
+    char Magic[8];
+    int32 ByteOrder, Version, Cols, IsNextDirty;
+    int64 FileLen, NumRows, NumValidRows, FirstValidRow, LastValidRow;
+    int64 NextVOff, Strs, StrOffVOff, StrBfOff;
+  };
+  /// Column entry of the memory-mapped format. Entries follow the header in the schema order.
+  struct TMmapCol {
+    char Nm[64];
+    int32 Type, Idx;
+    int64 Off;
+  };
+  enum { MmapVersion = 1, MmapPageSz = 4096, MmapByteOrder = 0x01020304 };
+  static int64 MmapAlign(const int64& Pos) { return (Pos + MmapPageSz - 1) / MmapPageSz * MmapPageSz; }
+  static void PutMmapBf(TSOut& SOut, int64& Pos, const int64& Off, const void* Bf, const int64& BfL);
+
 /***** Utility functions *****/
 public:
   /// Adds an integer column with name \c ColName.
@@ -600,7 +622,7 @@ protected:
   }
   /// Gets the value in column with id \c ColIdx at row \c RowIdx.
   TStr GetStrValIdx(TInt ColIdx, TInt RowIdx) const {
-    return TStr(Context->StringVals.GetKey(StrColMaps[ColIdx][RowIdx]));
+    return TStr(Context->StringVals.GetKey(GetStrMapIdx(ColIdx, RowIdx)));
   }
   /// Adds \c Val in column with id \c ColIdx.
   void AddStrVal(const TInt& ColIdx, const TStr& Val);
@@ -643,6 +665,41 @@ protected:
     TStr NColName = NormalizeColName(ColName);
     return ColTypeMap.GetDat(NColName);
   }
+
+/***** Utility functions for handling packed columns *****/
+  static bool IsPackedIdx(const TVec<TColPack>& PackV, const int& ColIdx) {
+    return ColIdx < PackV.Len() && !PackV[ColIdx].Empty();
+  }
+  bool HasPackedCols() const { return !IntColPacks.Empty() || !FltColPacks.Empty() || !StrColPacks.Empty(); }
+  /// Gets the integer value at column \c ColIdx and row \c RowIdx of a packed or plain column.
+  int GetIntIdx(const int& ColIdx, const int& RowIdx) const {
+    return IsPackedIdx(IntColPacks, ColIdx) ? IntColPacks[ColIdx].GetInt(RowIdx) : IntCols[ColIdx][RowIdx].Val;
+  }
+  /// Gets the float value at column \c ColIdx and row \c RowIdx of a packed or plain column.
+  double GetFltIdx(const int& ColIdx, const int& RowIdx) const {
+    return IsPackedIdx(FltColPacks, ColIdx) ? FltColPacks[ColIdx].GetFlt(RowIdx) : FltCols[ColIdx][RowIdx].Val;
+  }
+  /// Gets the string id at column \c ColIdx and row \c RowIdx of a packed or plain column.
+  int GetStrMapIdx(const int& ColIdx, const int& RowIdx) const {
+    return IsPackedIdx(StrColPacks, ColIdx) ? StrColPacks[ColIdx].GetInt(RowIdx) : StrColMaps[ColIdx][RowIdx].Val;
+  }
+  /// Gets the integer value or the string id at column \c ColIdx of type \c Type and row \c RowIdx.
+  int GetIntKeyIdx(const TAttrType& Type, const int& ColIdx, const int& RowIdx) const {
+    return Type == atStr ? GetStrMapIdx(ColIdx, RowIdx) : GetIntIdx(ColIdx, RowIdx);
+  }
+  /// Gets the rows [Beg, Beg+Len) of int column \c ColIdx, packed columns are decoded to \c BufV.
+  const int* GetIntColBf(const int& ColIdx, const int& Beg, const int& Len, TIntV& BufV) const;
+  /// Gets the rows [Beg, Beg+Len) of float column \c ColIdx, packed columns are decoded to \c BufV.
+  const double* GetFltColBf(const int& ColIdx, const int& Beg, const int& Len, TFltV& BufV) const;
+  /// Gets the rows [Beg, Beg+Len) of string column \c ColIdx, packed columns are decoded to \c BufV.
+  const int* GetStrMapColBf(const int& ColIdx, const int& Beg, const int& Len, TIntV& BufV) const;
+  /// Unpacks column \c ColIdx of type \c Type if it is packed or copies it if it is mapped, columns are unpacked before they are written.
+  void UnpackColIdx(const TAttrType& Type, const int& ColIdx);
+  /// Copies a vector that points into the file of a table opened with LoadMmap(), the mapping is read-only.
+  template <class TVal>
+  static void CopyMappedV(TVec<TVal>& V) {
+    if (V.IsExt()) { TVec<TVal> CopyV(V);  V.Swap(CopyV); }
+  }
   /// Returns a re-numbered column name based on number of existing columns with conflicting names.
   TStr RenumberColName(const TStr& ColName) const;
   /// Removes suffix to column name if exists
@@ -745,6 +802,8 @@ protected:
   /// Helper function for parallel QSort.
   void Merge(TIntV& V, TInt Idx1, TInt Idx2, TInt Idx3, const TVec<TAttrType>& SortByTypes,
     const TIntV& SortByIndices, TBool Asc = true);
+  /// Sorts the row indices of \c RowV by the given columns with a parallel radix sort. ##TTable::SortRowV
+  void SortRowV(TIntV& RowV, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices, TBool Asc = true) const;
 #ifdef USE_OPENMP
   /// Performs QSort in parallel on given vector \c V.
   void QSortPar(TIntV& V, const TVec<TAttrType>& SortByTypes, const TIntV& SortByIndices,
@@ -770,21 +829,40 @@ protected:
     TExcept::Throw("SetFirstValidRow: Table is empty");
   }
 
+/***** Utility functions for column-wise Select and arithmetic *****/
+  /// Evaluates a comparison over whole columns into a row bitmap. ##TTable::GetSelectBitV
+  void GetSelectBitV(const TAttrType& Type, const TInt& ColIdx1, const TInt& ColIdx2,
+   const TPrimitive& Val, TPredComp Cmp, TVec<TUInt64>& RowBitV) const;
+  /// Evaluates the predicate tree rooted at \c Node into a row bitmap. Returns false if the tree cannot be evaluated column-wise.
+  bool GetSelectBitV(const TPredicateNode* Node, TVec<TUInt64>& RowBitV) const;
+  /// Removes all valid rows whose bit in \c RowBitV is not set.
+  void KeepRowBitV(const TVec<TUInt64>& RowBitV);
+  /// Appends the valid rows whose bit in \c RowBitV is set to \c RowV, in table order.
+  void GetRowBitV(const TVec<TUInt64>& RowBitV, TIntV& RowV) const;
+  /// Gets runs [Beg, End) of consecutive valid physical rows, at most \c MxRows rows each.
+  void GetValidRowRanges(TIntPrV& RangeV, const int& MxRows) const;
+  /// Computes column \c ResColIdx from two columns, or from a column and \c Num if \c ArgColIdx2 is negative. ##TTable::ColGenericOpRanges
+  void ColGenericOpRanges(const TAttrType& ArgType1, const TInt& ArgColIdx1, const TAttrType& ArgType2,
+   const TInt& ArgColIdx2, const TFlt& Num, const TAttrType& ResType, const TInt& ResColIdx, TArithOp Op);
+
 /***** Utility functions for Join *****/
   /// Initializes an empty table for the join of this table with the given table.
   PTable InitializeJointTable(const TTable& Table);
   /// Adds joint row T1[RowIdx1]<=>T2[RowIdx2].
   void AddJointRow(const TTable& T1, const TTable& T2, TInt RowIdx1, TInt RowIdx2);
+  /// Adds joint rows T1[RowIdx1V[i]]<=>T2[RowIdx2V[i]] to an empty joint table, one column at a time.
+  void AddJointRowV(const TTable& T1, const TTable& T2, const TIntV& RowIdx1V, const TIntV& RowIdx2V);
+  /// Gets physical row ids of all row pairs with equal values in column \c ColIdx1 and \c Table's \c ColIdx2. ##TTable::GetJoinRowIdxV
+  void GetJoinRowIdxV(const TInt& ColIdx1, const TTable& Table, const TInt& ColIdx2, const TAttrType& Type,
+   TIntV& RowIdx1V, TIntV& RowIdx2V) const;
 /***** Utility functions for Threshold Join *****/
   void ThresholdJoinInputCorrectness(const TStr& KeyCol1, const TStr& JoinCol1, const TTable& Table, 
     const TStr& KeyCol2, const TStr& JoinCol2);
-  void ThresholdJoinCountCollisions(const TTable& TB, const TTable& TS, 
-    const TIntIntVH& T, TInt JoinColIdxB, TInt KeyColIdxB, TInt KeyColIdxS, 
-    THash<TIntPr,TIntTr>& Counters, TBool ThisIsSmaller, TAttrType JoinColType, TAttrType KeyType);
+  void ThresholdJoinCountCollisions(const TTable& Table, const TIntV& RowIdx1V, const TIntV& RowIdx2V,
+    TInt KeyColIdx1, TInt KeyColIdx2, THash<TIntPr,TIntTr>& Counters, TAttrType KeyType);
   PTable ThresholdJoinOutputTable(const THash<TIntPr,TIntTr>& Counters, TInt Threshold, const TTable& Table);
-  void ThresholdJoinCountPerJoinKeyCollisions(const TTable& TB, const TTable& TS, 
-    const TIntIntVH& T, TInt JoinColIdxB, TInt KeyColIdxB, TInt KeyColIdxS, 
-    THash<TIntTr,TIntTr>& Counters, TBool ThisIsSmaller, TAttrType JoinColType, TAttrType KeyType);
+  void ThresholdJoinCountPerJoinKeyCollisions(const TTable& Table, const TIntV& RowIdx1V, const TIntV& RowIdx2V,
+    TInt KeyColIdx1, TInt KeyColIdx2, TInt JoinColIdx1, THash<TIntTr,TIntTr>& Counters, TAttrType JoinColType, TAttrType KeyType);
   PTable ThresholdJoinPerJoinKeyOutputTable(const THash<TIntTr,TIntTr>& Counters, TInt Threshold, const TTable& Table);
 
   /// Resizes the table to hold \c RowCount rows.
@@ -804,7 +882,7 @@ protected:
   void UpdateTableForNewRow();
 
 #ifdef GCC_ATOMIC
-  /// Parallelly loads data from input file at InFNm into NewTable. Only work when NewTable has no string columns.
+  /// Parallelly loads data from input file at InFNm into NewTable. ##TTable::LoadSSPar
   static void LoadSSPar(PTable& NewTable, const Schema& S, const TStr& InFNm, const TIntV& RelevantCols, const char& Separator, TBool HasTitleLine);
 #endif // GCC_ATOMIC
   /// Sequentially loads data from input file at InFNm into NewTable
@@ -819,6 +897,11 @@ protected:
   //void GroupAuxMP(const TStrV& GroupBy, THashGenericMP<TGroupKey, TPair<TInt, TIntV> >& Grouping, 
   // TBool Ordered, const TStr& GroupColName, TBool KeepUnique, TIntV& UniqueVec, TBool UsePhysicalIds = false);
 #endif // USE_OPENMP
+  /// Gets valid rows in iteration order and their group ids, numbered by first appearance. ##TTable::GetGroupIdV
+  TBool GetGroupIdV(const TStrV& GroupBy, const TBool& Ordered, TIntV& RowV, TIntV& GroupIdV, TInt& Groups) const;
+  /// Aggregates column \c ValColIdx over groups of physical rows into column \c ResColIdx of every row.
+  void AggregateGroups(const TIntV& GrpOffV, const TIntV& GrpRowV, TAttrAggr AggOp, const TAttrType& ValType,
+   const TInt& ValColIdx, const TInt& ResColIdx);
   /// Stores column for a group. Physical row ids have to be passed.
   void StoreGroupCol(const TStr& GroupColName, const TVec<TPair<TInt, TInt> >& GroupAndRowIds);
   /// Register (cache) result of a grouping statement by a single group-by attribute
@@ -877,7 +960,9 @@ public:
     SrcCol(Table.SrcCol), DstCol(Table.DstCol),
     EdgeAttrV(Table.EdgeAttrV), SrcNodeAttrV(Table.SrcNodeAttrV),
     DstNodeAttrV(Table.DstNodeAttrV), CommonNodeAttrs(Table.CommonNodeAttrs),
-    IsNextDirty(Table.IsNextDirty) {}
+    IsNextDirty(Table.IsNextDirty) {
+    IntColPacks = Table.IntColPacks;  FltColPacks = Table.FltColPacks;  StrColPacks = Table.StrColPacks;
+  }
 
   TTable(const TTable& Table, const TIntV& RowIds);
 
@@ -926,6 +1011,10 @@ public:
   }
   /// Saves table schema and content to a binary format. ##TTable::Save
   void Save(TSOut& SOut);
+  /// Saves the table in the page-aligned columnar memory-mapped format. ##TTable::SaveMmap
+  void SaveMmap(TSOut& SOut) const;
+  /// Static constructor that opens a table saved with SaveMmap() without copying the columns. ##TTable::LoadMmap
+  static PTable LoadMmap(TShMIn& ShMIn, TTableContext* Context);
   /// Prints table contents to a text file.
   void Dump(FILE *OutF=stdout) const;
 
@@ -963,11 +1052,11 @@ public:
   // No type checking. Assuming ColName actually refers to the right type.
   /// Gets the value of integer attribute \c ColName at row \c RowIdx.
   TInt GetIntVal(const TStr& ColName, const TInt& RowIdx) {
-    return IntCols[GetColIdx(ColName)][RowIdx];
+    return GetIntIdx(GetColIdx(ColName), RowIdx);
   }
   /// Gets the value of float attribute \c ColName at row \c RowIdx.
   TFlt GetFltVal(const TStr& ColName, const TInt& RowIdx) {
-    return FltCols[GetColIdx(ColName)][RowIdx];
+    return GetFltIdx(GetColIdx(ColName), RowIdx);
   }
   /// Gets the value of string attribute \c ColName at row \c RowIdx.
   TStr GetStrVal(const TStr& ColName, const TInt& RowIdx) const {
@@ -976,12 +1065,12 @@ public:
 
   /// Gets the integer mapping of the string at column \c ColIdx at row \c RowIdx.
   TInt GetStrMapById(TInt ColIdx, TInt RowIdx) const {
-    return StrColMaps[ColIdx][RowIdx];
+    return GetStrMapIdx(ColIdx, RowIdx);
   }
 
   /// Gets the integer mapping of the string at column \c ColName at row \c RowIdx.
   TInt GetStrMapByName(const TStr& ColName, TInt RowIdx) const {
-    return StrColMaps[GetColIdx(ColName)][RowIdx];
+    return GetStrMapIdx(GetColIdx(ColName), RowIdx);
   }
 
   /// Gets the value of the string attribute at column \c ColIdx at row \c RowIdx.
@@ -1017,11 +1106,11 @@ public:
   // No type and bound checking
   /// Get the integer value at column \c ColIdx and row \c RowIdx
   TInt GetIntValAtRowIdx(const TInt& ColIdx, const TInt& RowIdx) {
-    return IntCols[ColIdx][RowIdx];
+    return GetIntIdx(ColIdx, RowIdx);
   }
   /// Get the float value at column \c ColIdx and row \c RowIdx
   TFlt GetFltValAtRowIdx(const TInt& ColIdx, const TInt& RowIdx) {
-    return FltCols[ColIdx][RowIdx];
+    return GetFltIdx(ColIdx, RowIdx);
   }
 
   /// Gets the schema of this table.
@@ -1306,9 +1395,6 @@ public:
 
   /// Performs columnwise arithmetic operation ##TTable::ColGenericOp
   void ColGenericOp(const TStr& Attr1, const TStr& Attr2, const TStr& ResAttr, TArithOp op);
-#ifdef USE_OPENMP
-  void ColGenericOpMP(TInt ArgColIdx1, TInt ArgColIdx2, TAttrType ArgType1, TAttrType ArgType2, TInt ResColIdx, TArithOp op);
-#endif // USE_OPENMP
   /// Performs columnwise addition. See TTable::ColGenericOp
   void ColAdd(const TStr& Attr1, const TStr& Attr2, const TStr& ResultAttrName="");
   /// Performs columnwise subtraction. See TTable::ColGenericOp
@@ -1347,9 +1433,6 @@ public:
 
   /// Performs arithmetic op of column values and given \c Num
   void ColGenericOp(const TStr& Attr1, const TFlt& Num, const TStr& ResAttr, TArithOp op, const TBool floatCast);
-#ifdef USE_OPENMP
-  void ColGenericOpMP(const TInt& ColIdx1, const TInt& ColIdx2, TAttrType ArgType, const TFlt& Num, TArithOp op, TBool ShouldCast);
-#endif // USE_OPENMP
   /// Performs addition of column values and given \c Num
   void ColAdd(const TStr& Attr1, const TFlt& Num, const TStr& ResultAttrName="", const TBool floatCast=false);
   /// Performs subtraction of column values and given \c Num
@@ -1386,8 +1469,22 @@ public:
   
   void PrintSize();
   void PrintContextSize();
-  /// Returns approximate memory used by table in [KB]
+  /// Returns approximate memory used by table in [KB], packed columns count with their compressed size.
   TSize GetMemUsedKB();
+  /// Returns approximate memory used by table in [KB] if no columns were packed.
+  TSize GetLogicalMemUsedKB();
+
+/***** Packed columns *****/
+  /// Packs column \c ColName into compressed blocks. ##TTable::PackCol
+  void PackCol(const TStr& ColName, const TColEnc& Enc = ceAuto);
+  /// Packs all the columns.
+  void Pack(const TColEnc& Enc = ceAuto);
+  /// Unpacks column \c ColName.
+  void UnpackCol(const TStr& ColName);
+  /// Unpacks all the columns. ##TTable::Unpack
+  void Unpack();
+  /// Checks if column \c ColName is packed.
+  bool IsPackedCol(const TStr& ColName) const;
   /// Returns approximate memory used by table context in [KB]
   TSize GetContextMemUsedKB();
 
@@ -1483,9 +1580,8 @@ void TTable::GroupByIntCol(const TStr& GroupBy, T& Grouping,
     for (TInt i = 0; i < IndexSet.Len(); i++) {
       if (IsRowValid(IndexSet[i])) {
         TInt RowIdx = IndexSet[i];
-        const TIntV& Col = IntCols[GetColIdx(GroupBy)];
-        TInt idx = UsePhysicalIds ? RowIdx : IntCols[IdColIdx][RowIdx];       
-        UpdateGrouping<TInt>(Grouping, Col[RowIdx], idx);
+        TInt idx = UsePhysicalIds ? RowIdx : TInt(GetIntIdx(IdColIdx, RowIdx));
+        UpdateGrouping<TInt>(Grouping, GetIntIdx(GetColIdx(GroupBy), RowIdx), idx);
       }
     }
   }
@@ -1510,9 +1606,8 @@ void TTable::GroupByFltCol(const TStr& GroupBy, T& Grouping,
     for (TInt i = 0; i < IndexSet.Len(); i++) {
       if (IsRowValid(IndexSet[i])) {
         TInt RowIdx = IndexSet[i];
-        const TFltV& Col = FltCols[GetColIdx(GroupBy)];   
-        TInt idx = UsePhysicalIds ? RowIdx : IntCols[IdColIdx][RowIdx];     
-        UpdateGrouping<TFlt>(Grouping, Col[RowIdx], idx);
+        TInt idx = UsePhysicalIds ? RowIdx : TInt(GetIntIdx(IdColIdx, RowIdx));
+        UpdateGrouping<TFlt>(Grouping, GetFltIdx(GetColIdx(GroupBy), RowIdx), idx);
       }
     }
   }
@@ -1538,8 +1633,8 @@ void TTable::GroupByStrCol(const TStr& GroupBy, T& Grouping,
       if (IsRowValid(IndexSet[i])) {
         TInt RowIdx = IndexSet[i];
         TInt ColIdx = GetColIdx(GroupBy);
-        TInt idx = UsePhysicalIds ? RowIdx : IntCols[IdColIdx][RowIdx];  
-        UpdateGrouping<TInt>(Grouping, StrColMaps[ColIdx][RowIdx], idx);
+        TInt idx = UsePhysicalIds ? RowIdx : TInt(GetIntIdx(IdColIdx, RowIdx));
+        UpdateGrouping<TInt>(Grouping, GetStrMapIdx(ColIdx, RowIdx), idx);
       }
     }
   }
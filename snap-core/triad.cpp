@@ -99,3 +99,200 @@ int GetCommon(TIntV& A, TIntV& B) {
 }
 
 } // namespace TSnap
+
+/////////////////////////////////////////////////
+// Triangle counting engine
+
+// Neighbor lists of TUNGraph and TNGraph map to a sorted run of out-neighbors UNbrV[Beg..Mid) and a sorted run of
+// in-neighbors UNbrV[Mid..End), which are merged, other lists are sorted. The scratch SortV holds one node's neighbors.
+int TTriangleCnt::GetUniqNbrs(TNIdxMap::TNbrV& UNbrV, const int64& Beg, const int64& Mid, const int64& End, TIntV& SortV) {
+  bool IsSorted = true;
+  for (int64 e = Beg+1; e < End && IsSorted; e++) {
+    if (e != Mid && UNbrV[e-1] > UNbrV[e]) { IsSorted = false; } }
+  SortV.Clr(false);
+  if (IsSorted) {
+    int64 i = Beg, j = Mid;
+    while (i < Mid && j < End) { SortV.Add(UNbrV[i] <= UNbrV[j] ? UNbrV[i++] : UNbrV[j++]); }
+    while (i < Mid) { SortV.Add(UNbrV[i++]); }
+    while (j < End) { SortV.Add(UNbrV[j++]); }
+  } else {
+    for (int64 e = Beg; e < End; e++) { SortV.Add(UNbrV[e]); }
+    SortV.Sort();
+  }
+  int Len = 0;
+  for (int e = 0; e < SortV.Len(); e++) {
+    if (Len == 0 || SortV[e] != UNbrV[Beg+Len-1]) { UNbrV[Beg+Len] = SortV[e];  Len++; } }
+  return Len;
+}
+
+void TTriangleCnt::Gen(const TVec<TInt64>& UOffV, const TNIdxMap::TNbrV& UNbrV) {
+  const int Nodes = NIdV.Len();
+  // rank the nodes by degree, ties by index, with a counting sort
+  int MxDeg = 0;
+  for (int i = 0; i < Nodes; i++) { MxDeg = TMath::Mx(MxDeg, DegV[i].Val); }
+  TIntV DegPosV(MxDeg+2);
+  for (int i = 0; i < Nodes; i++) { DegPosV[DegV[i]+1] += 1; }
+  for (int d = 0; d <= MxDeg; d++) { DegPosV[d+1] += DegPosV[d]; }
+  RankV.Gen(Nodes);
+  TIntV ByRankV(Nodes);
+  for (int i = 0; i < Nodes; i++) {
+    RankV[i] = DegPosV[DegV[i]];
+    DegPosV[DegV[i]] += 1;
+    ByRankV[RankV[i]] = i;
+  }
+  // orient every edge towards the higher ranked endpoint, so that no node has more than
+  // O(sqrt(edges)) out-neighbors, and store the ranks of the out-neighbors
+  OffV.Gen(Nodes+1);
+  for (int i = 0; i < Nodes; i++) {
+    for (int64 e = UOffV[i]; e < UOffV[i] + DegV[i]; e++) {
+      if (RankV[UNbrV[e]] > RankV[i]) { OffV[RankV[i]+1] += 1; }
+    }
+  }
+  for (int r = 0; r < Nodes; r++) { OffV[r+1] += OffV[r]; }
+  NbrV.Gen(OffV[Nodes]);
+  TVec<TInt64> PosV(OffV);
+  // nodes are visited by increasing rank, which keeps the lists sorted
+  for (int r = 0; r < Nodes; r++) {
+    const int i = ByRankV[r];
+    for (int64 e = UOffV[i]; e < UOffV[i] + DegV[i]; e++) {
+      const int NbrRank = RankV[UNbrV[e]];
+      if (NbrRank < r) {
+        NbrV[PosV[NbrRank]] = r;
+        PosV[NbrRank] += 1;
+      }
+    }
+  }
+}
+
+// Every triangle u < v < w (by rank) is found once, as the common out-neighbor w of the edge (u, v).
+// Triangles of nodes are added to one counter per node, atomically when the count runs in parallel.
+void TTriangleCnt::CountTriangles(const bool& DoNodeCnt) {
+  const int Nodes = NIdV.Len();
+  TVec<TInt64> RankTriV(DoNodeCnt ? Nodes : 0);
+  int64 Cnt = 0;
+#ifdef GCC_ATOMIC
+  #pragma omp parallel reduction(+:Cnt)
+#endif
+  {
+    TIntV CmnV;
+#ifdef GCC_ATOMIC
+    #pragma omp for schedule(dynamic,64)
+#endif
+    for (int u = 0; u < Nodes; u++) {
+      int64 UCnt = 0;
+      for (int64 e = OffV[u]; e < OffV[u+1]-1; e++) {
+        // out-neighbors of u after v are the candidates, they all have a higher rank than v
+        const int v = NbrV[e];
+        const TInt* CandV = NbrV.BegI() + e + 1;
+        const int CandLen = int(OffV[u+1] - e - 1);
+        const int VLen = int(OffV[v+1] - OffV[v]);
+        if (VLen == 0) { continue; }
+        if (! DoNodeCnt) {
+          Cnt += GetCmnCnt(CandV, CandLen, NbrV.BegI() + OffV[v], VLen);
+          continue;
+        }
+        if (CmnV.Len() < CandLen) { CmnV.Gen(CandLen); }
+        const int Cmn = GetCmnCnt(CandV, CandLen, NbrV.BegI() + OffV[v], VLen, CmnV.BegI());
+        if (Cmn == 0) { continue; }
+        Cnt += Cmn;
+        UCnt += Cmn;
+#ifdef GCC_ATOMIC
+        __sync_fetch_and_add(&RankTriV[v].Val, int64(Cmn));
+        for (int c = 0; c < Cmn; c++) { __sync_fetch_and_add(&RankTriV[CmnV[c]].Val, int64(1)); }
+#else
+        RankTriV[v] += Cmn;
+        for (int c = 0; c < Cmn; c++) { RankTriV[CmnV[c]] += 1; }
+#endif
+      }
+      if (UCnt == 0) { continue; }
+#ifdef GCC_ATOMIC
+      __sync_fetch_and_add(&RankTriV[u].Val, UCnt);
+#else
+      RankTriV[u] += UCnt;
+#endif
+    }
+  }
+  Triangles = Cnt;
+  NodeTriV.Clr();
+  if (DoNodeCnt) {
+    NodeTriV.Gen(Nodes);
+    for (int i = 0; i < Nodes; i++) { NodeTriV[i] = RankTriV[RankV[i]]; }
+  }
+}
+
+void TTriangleCnt::GetNodeTriads(TIntTrV& NIdCOTriadV) const {
+  IAssertR(NodeTriV.Len() == NIdV.Len(), "Triangles of nodes were not counted.");
+  NIdCOTriadV.Gen(NIdV.Len(), 0);
+  for (int i = 0; i < NIdV.Len(); i++) {
+    const int64 Pairs = int64(DegV[i]) * (DegV[i]-1) / 2;
+    NIdCOTriadV.Add(TIntTr(NIdV[i], int(NodeTriV[i]), int(Pairs - NodeTriV[i])));
+  }
+}
+
+void TTriangleCnt::GetNodeClustCf(TIntFltH& NIdCCfH) const {
+  IAssertR(NodeTriV.Len() == NIdV.Len(), "Triangles of nodes were not counted.");
+  NIdCCfH.Gen(NIdV.Len());
+  for (int i = 0; i < NIdV.Len(); i++) {
+    const int64 Pairs = int64(DegV[i]) * (DegV[i]-1) / 2;
+    NIdCCfH.AddDat(NIdV[i], Pairs > 0 ? double(NodeTriV[i]) / double(Pairs) : 0.0);
+  }
+}
+
+double TTriangleCnt::GetClustCf() const {
+  IAssertR(NodeTriV.Len() == NIdV.Len(), "Triangles of nodes were not counted.");
+  if (NIdV.Empty()) { return 0.0; }
+  double SumCcf = 0.0;
+  for (int i = 0; i < NIdV.Len(); i++) {
+    const int64 Pairs = int64(DegV[i]) * (DegV[i]-1) / 2;
+    if (Pairs > 0) { SumCcf += double(NodeTriV[i]) / double(Pairs); }
+  }
+  return SumCcf / double(NIdV.Len());
+}
+
+// Lists of very different lengths are intersected by galloping through the longer one,
+// otherwise by a merge whose inner loop has no data dependent branches.
+int TTriangleCnt::GetCmnCnt(const TInt* A, const int& ALen, const TInt* B, const int& BLen, TInt* CmnV) {
+  if (ALen > BLen) { return GetCmnCnt(B, BLen, A, ALen, CmnV); }
+  if (ALen == 0) { return 0; }
+  int Cmn = 0;
+  if (BLen / ALen >= 32) {
+    int j = 0;
+    for (int i = 0; i < ALen && j < BLen; i++) {
+      const int Val = A[i];
+      if (B[j] < Val) {
+        // exponential search followed by a binary search for the first B[j] >= Val
+        int Lo = j, Step = 1;
+        while (Lo + Step < BLen && B[Lo+Step] < Val) { Lo += Step;  Step *= 2; }
+        int Hi = TMath::Mn(Lo + Step, BLen);
+        while (Hi - Lo > 1) {
+          const int Mid = (Lo + Hi) / 2;
+          if (B[Mid] < Val) { Lo = Mid; } else { Hi = Mid; }
+        }
+        j = Hi;
+      }
+      if (j < BLen && B[j] == Val) {
+        if (CmnV != NULL) { CmnV[Cmn] = Val; }
+        Cmn++;  j++;
+      }
+    }
+    return Cmn;
+  }
+  int i = 0, j = 0;
+  if (CmnV == NULL) {
+    while (i < ALen && j < BLen) {
+      const int ValA = A[i], ValB = B[j];
+      Cmn += ValA == ValB;
+      i += ValA <= ValB;
+      j += ValB <= ValA;
+    }
+  } else {
+    while (i < ALen && j < BLen) {
+      const int ValA = A[i], ValB = B[j];
+      CmnV[Cmn] = ValA;
+      Cmn += ValA == ValB;
+      i += ValA <= ValB;
+      j += ValB <= ValA;
+    }
+  }
+  return Cmn;
+}
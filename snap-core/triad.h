@@ -1,6 +1,88 @@
 #ifndef TRIAD_H
 #define TRIAD_H
 
+/////////////////////////////////////////////////
+// Triangle counting engine
+/// Counts triangles of a graph, considered as a simple undirected graph. ##TTriangleCnt
+class TTriangleCnt {
+private:
+  TIntV NIdV;              // node ids in the order of the node iterator
+  TIntV DegV;              // number of distinct neighbors of each node, self-loops excluded
+  TIntV RankV;             // position of each node in the (degree, index) order
+  TVec<TInt64> OffV;       // oriented graph indexed by rank: sorted ranks of the higher ranked neighbors
+  TNIdxMap::TNbrV NbrV;
+  TVec<TInt64> NodeTriV;   // number of triangles of each node
+  int64 Triangles;
+private:
+  static int GetUniqNbrs(TNIdxMap::TNbrV& UNbrV, const int64& Beg, const int64& Mid, const int64& End, TIntV& SortV);
+  void Gen(const TVec<TInt64>& UOffV, const TNIdxMap::TNbrV& UNbrV);
+  void CountTriangles(const bool& DoNodeCnt);
+public:
+  TTriangleCnt() : Triangles(0) { }
+  /// Counts triangles of Graph. With DoNodeCnt=false only the total number of triangles is computed.
+  template <class PGraph> TTriangleCnt(const PGraph& Graph, const bool& DoNodeCnt=true);
+  int GetNodes() const { return NIdV.Len(); }
+  /// Returns the number of triangles in the graph.
+  int64 GetTriangles() const { return Triangles; }
+  /// Returns the number of triangles of the N-th node of the node iterator.
+  int64 GetNodeTriangles(const int& NodeN) const { return NodeTriV[NodeN]; }
+  /// Returns the id of the N-th node of the node iterator.
+  int GetNId(const int& NodeN) const { return NIdV[NodeN]; }
+  /// Returns (node id, closed triads, open triads) of every node, as TSnap::GetTriads().
+  void GetNodeTriads(TIntTrV& NIdCOTriadV) const;
+  /// Returns the local clustering coefficient of every node.
+  void GetNodeClustCf(TIntFltH& NIdCCfH) const;
+  /// Returns the average local clustering coefficient.
+  double GetClustCf() const;
+  /// Returns the number of common elements of sorted arrays A and B, which are stored to CmnV if it is not NULL.
+  static int GetCmnCnt(const TInt* A, const int& ALen, const TInt* B, const int& BLen, TInt* CmnV=NULL);
+};
+
+template <class PGraph>
+TTriangleCnt::TTriangleCnt(const PGraph& Graph, const bool& DoNodeCnt) : Triangles(0) {
+  const int Nodes = Graph->GetNodes();
+  const bool IsDir = Graph->HasFlag(gfDirected);
+  TVec<typename PGraph::TObj::TNodeI> NIV(Nodes, 0);
+  NIdV.Gen(Nodes, 0);
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    NIV.Add(NI);
+    NIdV.Add(NI.GetId());
+  }
+  TNIdxMap NIdxMap;
+  NIdxMap.Gen(NIdV);
+  // distinct neighbors of every node, there are at most in-degree plus out-degree of them
+  TVec<TInt64> UOffV(Nodes+1);
+  for (int i = 0; i < Nodes; i++) {
+    UOffV[i+1] = UOffV[i] + NIV[i].GetOutDeg() + (IsDir ? NIV[i].GetInDeg() : 0); }
+  TNIdxMap::TNbrV UNbrV(UOffV[Nodes]);
+  DegV.Gen(Nodes);
+#ifdef USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    TIntV SortV;
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic,256)
+#endif
+    for (int i = 0; i < Nodes; i++) {
+      const typename PGraph::TObj::TNodeI& NI = NIV[i];
+      int64 Mid = UOffV[i];
+      for (int e = 0; e < NI.GetOutDeg(); e++) {
+        const int j = NIdxMap.GetIdx(NI.GetOutNId(e));
+        if (j != i) { UNbrV[Mid++] = j; }
+      }
+      int64 End = Mid;
+      for (int e = 0; IsDir && e < NI.GetInDeg(); e++) {
+        const int j = NIdxMap.GetIdx(NI.GetInNId(e));
+        if (j != i) { UNbrV[End++] = j; }
+      }
+      DegV[i] = GetUniqNbrs(UNbrV, UOffV[i], Mid, End, SortV);
+    }
+  }
+  Gen(UOffV, UNbrV);
+  CountTriangles(DoNodeCnt);
+}
+
 namespace TSnap {
 
 /////////////////////////////////////////////////
@@ -243,84 +325,51 @@ void GetTriads_v0(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
 }
 
 // Function pretends that the graph is undirected (count unique connected triples of nodes)
-// This implementation is faster, it converts hash tables to vectors
+// This implementation is faster, it counts triangles with TTriangleCnt or only looks at the sampled nodes
 template <class PGraph>
 void GetTriads(const PGraph& Graph, TIntTrV& NIdCOTriadV, int SampleNodes) {
+  if (SampleNodes == -1 || SampleNodes >= Graph->GetNodes()) {
+    TTriangleCnt TriangleCnt(Graph);
+    TriangleCnt.GetNodeTriads(NIdCOTriadV);
+    return;
+  }
   const bool IsDir = Graph->HasFlag(gfDirected);
-  TIntSet NbrH;
   TIntV NIdV;
-  //TRnd Rnd(0);
   TRnd Rnd(1);
-  int NNodes;
-  TIntV Nbrs;
-  int NId;
-
-  int64 hcount;
-
-  hcount = 0;
-
-  NNodes = Graph->GetNodes();
   Graph->GetNIdV(NIdV);
   NIdV.Shuffle(Rnd);
-  if (SampleNodes == -1) {
-    SampleNodes = NNodes;
-  }
-
-  int MxId = -1;
-  for (int i = 0; i < NNodes; i++) {
-    if (NIdV[i] > MxId) {
-      MxId = NIdV[i];
-    }
-  }
-
-  TVec<TIntV> NbrV(MxId + 1);
-
-  if (IsDir) {
-    // get in and out neighbors
-    for (int node = 0; node < NNodes; node++) {
-      int NId = NIdV[node];
-      NbrV[NId] = TIntV();
-      GetUniqueNbrV(Graph, NId, NbrV[NId]);
-    }
-  } else {
-    // get only out neighbors
-    for (int node = 0; node < NNodes; node++) {
-      int NId = NIdV[node];
-      typename PGraph::TObj::TNodeI NI = Graph->GetNI(NId);
-      NbrV[NId] = TIntV();
-      NbrV[NId].Reserve(NI.GetOutDeg());
-      NbrV[NId].Reduce(0);
-      for (int i = 0; i < NI.GetOutDeg(); i++) {
-        NbrV[NId].Add(NI.GetOutNId(i));
-      }
-    }
-  }
-
+  TIntSet NbrH, SeenH;
   NIdCOTriadV.Clr(false);
   NIdCOTriadV.Reserve(SampleNodes);
   for (int node = 0; node < SampleNodes; node++) {
     typename PGraph::TObj::TNodeI NI = Graph->GetNI(NIdV[node]);
-    int NLen;
-
-    NId = NI.GetId();
-    hcount++;
-    if (NI.GetDeg() < 2) {
-      NIdCOTriadV.Add(TIntTr(NId, 0, 0)); // zero triangles
-      continue;
-    }
-
-    Nbrs = NbrV[NId];
-    NLen = Nbrs.Len();
-
-    // count connected neighbors
-    int OpenCnt1 = 0, CloseCnt1 = 0;
-    for (int srcNbr = 0; srcNbr < NLen; srcNbr++) {
-      int Count = GetCommon(NbrV[NbrV[NId][srcNbr]],Nbrs);
-      CloseCnt1 += Count;
+    const int NId = NI.GetId();
+    // find neighborhood
+    NbrH.Clr(false);
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      if (NI.GetOutNId(e) != NId) { NbrH.AddKey(NI.GetOutNId(e)); }
+    }
+    for (int e = 0; IsDir && e < NI.GetInDeg(); e++) {
+      if (NI.GetInNId(e) != NId) { NbrH.AddKey(NI.GetInNId(e)); }
+    }
+    // count the distinct neighbors of every neighbor that are also neighbors of NId
+    int64 CloseCnt = 0;
+    for (int n = 0; n < NbrH.Len(); n++) {
+      const typename PGraph::TObj::TNodeI NbrI = Graph->GetNI(NbrH.GetKey(n));
+      SeenH.Clr(false);
+      for (int e = 0; e < NbrI.GetOutDeg(); e++) {
+        const int DstNId = NbrI.GetOutNId(e);
+        if (DstNId != NbrI.GetId() && NbrH.IsKey(DstNId)) { SeenH.AddKey(DstNId); }
+      }
+      for (int e = 0; IsDir && e < NbrI.GetInDeg(); e++) {
+        const int SrcNId = NbrI.GetInNId(e);
+        if (SrcNId != NbrI.GetId() && NbrH.IsKey(SrcNId)) { SeenH.AddKey(SrcNId); }
+      }
+      CloseCnt += SeenH.Len();
     }
-    CloseCnt1 /= 2;
-    OpenCnt1 = (NLen*(NLen-1))/2 - CloseCnt1;
-    NIdCOTriadV.Add(TIntTr(NId, CloseCnt1, OpenCnt1));
+    CloseCnt /= 2;
+    const int64 Pairs = int64(NbrH.Len()) * (NbrH.Len()-1) / 2;
+    NIdCOTriadV.Add(TIntTr(NId, int(CloseCnt), int(Pairs - CloseCnt)));
   }
 }
 
@@ -382,74 +431,8 @@ int64 CountTriangles(const PGraph& Graph) {
 
 template<class PGraph>
 int64 GetTriangleCnt(const PGraph& Graph) {
-  const int NNodes = Graph->GetNodes();
-
-  TIntV MapV(NNodes);
-  TVec<typename PGraph::TObj::TNodeI> NV(NNodes);
-  NV.Reduce(0);
-
-  int MxId = -1;
-  int ind = 0;
-  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++)   {
-    NV.Add(NI);
-    int Id = NI.GetId();
-    if (Id > MxId) {
-      MxId = Id;
-    }
-    MapV[ind] = Id;
-    ind++;
-  }
-
-  TIntV IndV(MxId+1);
-
-  for (int j = 0; j < NNodes; j++) {
-    IndV[MapV[j]] = j;
-  }
-
-  ind = MapV.Len();
-
-  TVec<TIntV> HigherDegNbrV(ind);
-
-  for (int i = 0; i < ind; i++) {
-    HigherDegNbrV[i] = TVec<TInt>();
-    HigherDegNbrV[i].Reserve(NV[i].GetDeg());
-    HigherDegNbrV[i].Reduce(0);
-  }
-
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(dynamic)
-#endif
-  for (int i = 0; i < ind; i++) {
-    typename PGraph::TObj::TNodeI NI = NV[i];
-    MergeNbrs<PGraph>(HigherDegNbrV[i], NI);
-
-    int k = 0;
-    for (int j = 0; j < HigherDegNbrV[i].Len(); j++) {
-      TInt Vert = HigherDegNbrV[i][j];
-      TInt Deg = NV[IndV[Vert]].GetDeg();
-      if (Deg > NI.GetDeg() ||
-         (Deg == NI.GetDeg() && Vert > NI.GetId())) {
-        HigherDegNbrV[i][k] = Vert;
-        k++;
-      }
-    }
-    HigherDegNbrV[i].Reduce(k);
-  }
-
-  int64 cnt = 0;
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(dynamic) reduction(+:cnt)
-#endif
-  for (int i = 0; i < HigherDegNbrV.Len(); i++) {
-    for (int j = 0; j < HigherDegNbrV[i].Len(); j++) {
-      TInt NbrInd = IndV[HigherDegNbrV[i][j]];
-
-      int64 num = GetCommon(HigherDegNbrV[i], HigherDegNbrV[NbrInd]);
-      cnt += num;
-    }
-  }
-
-  return cnt;
+  TTriangleCnt TriangleCnt(Graph, false);
+  return TriangleCnt.GetTriangles();
 }
 
 template<class PGraph>
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+static void CheckColPack(const TIntV& ValV, const TColEnc& Enc) {
+  TColPack Pack;
+  Pack.Pack(ValV, Enc);
+  EXPECT_EQ(ValV.Len(), Pack.Len());
+  TIntV PackV;
+  Pack.GetV(PackV);
+  EXPECT_EQ(ValV, PackV);
+  for (int i = 0; i < ValV.Len(); i += 7) { EXPECT_EQ(ValV[i].Val, Pack.GetInt(i)); }
+  // a range that starts and ends inside blocks
+  if (ValV.Len() > 3000) {
+    TIntV RangeV(2000);
+    Pack.GetV(1000, 3000, (int*) RangeV.BegI());
+    for (int i = 0; i < RangeV.Len(); i++) { EXPECT_EQ(ValV[1000 + i].Val, RangeV[i].Val); }
+  }
+}
+
+// Every encoding decodes to the packed values, ceAuto picks the smallest encoding.
+TEST(TColPack, Encodings) {
+  const int Vals = 5000;
+  TRnd Rnd(1);
+  TIntV TmV, RunV, DictV, SmallV, WideV;
+  for (int i = 0; i < Vals; i++) {
+    TmV.Add(1400000000 + 60*i + Rnd.GetUniDevInt(3));
+    RunV.Add(i / 300);
+    DictV.Add(i % 3 == 0 ? TInt::Mn : (i % 3 == 1 ? TInt::Mx : Rnd.GetUniDevInt(2)));
+    SmallV.Add(Rnd.GetUniDevInt(1000) - 500);
+    WideV.Add(Rnd.GetUniDevInt(TInt::Mx) - Rnd.GetUniDevInt(TInt::Mx));
+  }
+  const TIntV* ValVV[] = { &TmV, &RunV, &DictV, &SmallV, &WideV };
+  for (int v = 0; v < 5; v++) {
+    for (int Enc = ceAuto; Enc <= ceDict; Enc++) { CheckColPack(*ValVV[v], TColEnc(Enc)); }
+  }
+  TColPack TmPack, RunPack, DictPack, SmallPack;
+  TmPack.Pack(TmV);  RunPack.Pack(RunV);  DictPack.Pack(DictV);  SmallPack.Pack(SmallV);
+  EXPECT_EQ(5, TmPack.GetBlocks());
+  for (int b = 0; b < TmPack.GetBlocks(); b++) {
+    EXPECT_EQ(ceDelta, TmPack.GetBlockEnc(b));
+    EXPECT_EQ(ceRle, RunPack.GetBlockEnc(b));
+    EXPECT_EQ(ceDict, DictPack.GetBlockEnc(b));
+    EXPECT_EQ(ceFor, SmallPack.GetBlockEnc(b));
+  }
+  EXPECT_GT(TmV.GetMemUsed() / 8, TmPack.GetMemUsed());
+  EXPECT_GT(RunV.GetMemUsed() / 50, RunPack.GetMemUsed());
+
+  // floating point values are packed by their bit patterns
+  TFltV FltV, PackFltV;
+  for (int i = 0; i < Vals; i++) { FltV.Add(i % 5 == 0 ? Rnd.GetUniDev() : double(i / 100)); }
+  FltV.Add(-0.0);  FltV.Add(TFlt::Mn);  FltV.Add(TFlt::Mx);
+  for (int Enc = ceAuto; Enc <= ceDict; Enc++) {
+    TColPack Pack;
+    Pack.Pack(FltV, TColEnc(Enc));
+    Pack.GetV(PackFltV);
+    EXPECT_EQ(0, memcmp(FltV.BegI(), PackFltV.BegI(), FltV.Len() * sizeof(double)));
+    for (int i = 0; i < FltV.Len(); i += 11) { EXPECT_EQ(FltV[i].Val, Pack.GetFlt(i)); }
+  }
+
+  // empty and single value columns
+  CheckColPack(TIntV(), ceAuto);
+  CheckColPack(TIntV(1), ceAuto);
+  CheckColPack(TIntV(1), ceDelta);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Test the default constructor
+TEST(TCsrGraph, DefaultConstructor) {
+  PNCsrGraph Graph = TNCsrGraph::New();
+  EXPECT_EQ(0,Graph->GetNodes());
+  EXPECT_EQ(0,Graph->GetEdges());
+  EXPECT_EQ(1,Graph->Empty());
+  EXPECT_EQ(1,Graph->HasFlag(gfDirected));
+
+  PUNCsrGraph UGraph = TUNCsrGraph::New();
+  EXPECT_EQ(0,UGraph->GetNodes());
+  EXPECT_EQ(0,UGraph->HasFlag(gfDirected));
+}
+
+// Compares the CSR graph with the graph it was built from
+template <class PGraph, class PCsrGraph>
+void CheckSameGraph(const PGraph& Graph, const PCsrGraph& CsrGraph) {
+  EXPECT_EQ(1,CsrGraph->IsOk());
+  EXPECT_EQ(Graph->GetNodes(),CsrGraph->GetNodes());
+  EXPECT_EQ(Graph->GetEdges(),CsrGraph->GetEdges());
+  EXPECT_EQ(Graph->GetMxNId(),CsrGraph->GetMxNId());
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    typename PCsrGraph::TObj::TNodeI CNI = CsrGraph->GetNI(NI.GetId());
+    EXPECT_EQ(NI.GetId(),CNI.GetId());
+    EXPECT_EQ(NI.GetId(),CsrGraph->GetNId(CsrGraph->GetNIdx(NI.GetId())));
+    EXPECT_EQ(NI.GetInDeg(),CNI.GetInDeg());
+    EXPECT_EQ(NI.GetOutDeg(),CNI.GetOutDeg());
+    for (int e = 0; e < NI.GetOutDeg(); e++) {
+      EXPECT_EQ(NI.GetOutNId(e),CNI.GetOutNId(e));
+    }
+    for (int e = 0; e < NI.GetInDeg(); e++) {
+      EXPECT_EQ(NI.GetInNId(e),CNI.GetInNId(e));
+    }
+  }
+  int EdgeCnt = 0;
+  for (typename PCsrGraph::TObj::TEdgeI EI = CsrGraph->BegEI(); EI < CsrGraph->EndEI(); EI++) {
+    EXPECT_EQ(1,Graph->IsEdge(EI.GetSrcNId(), EI.GetDstNId()));
+    EdgeCnt++;
+  }
+  EXPECT_EQ(Graph->GetEdges(),EdgeCnt);
+}
+
+// Test conversion from TNGraph and TUNGraph
+TEST(TCsrGraph, FromGraph) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(1000, 10000);
+  Graph->AddNode(5000);
+  Graph->AddEdge(5000, 5000);
+  Graph->AddEdge(5000, 3);
+  CheckSameGraph(Graph, TNCsrGraph::New(Graph));
+
+  PUNGraph UGraph = TSnap::GenRndGnm<PUNGraph>(1000, 10000);
+  UGraph->AddEdge(7, 7);
+  CheckSameGraph(UGraph, TUNCsrGraph::New(UGraph));
+
+  // sparse node IDs use binary search instead of the lookup table
+  PNGraph SparseGraph = TNGraph::New();
+  for (int n = 0; n < 100; n++) { SparseGraph->AddNode(n*100000); }
+  for (int n = 1; n < 100; n++) { SparseGraph->AddEdge(n*100000, (n-1)*100000); }
+  CheckSameGraph(SparseGraph, TNCsrGraph::New(SparseGraph));
+  EXPECT_EQ(-1,TNCsrGraph::New(SparseGraph)->GetNIdx(5));
+
+  // directions are ignored in the undirected CSR graph
+  PUNGraph UCopy = TSnap::ConvertGraph<PUNGraph>(Graph);
+  PUNCsrGraph UCsrGraph = TUNCsrGraph::New(Graph);
+  CheckSameGraph(UCopy, UCsrGraph);
+}
+
+// Test building from an edge list and from a table
+TEST(TCsrGraph, FromEdges) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(500, 3000);
+  TIntV SrcNIdV, DstNIdV;
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    SrcNIdV.Add(EI.GetSrcNId());  DstNIdV.Add(EI.GetDstNId());
+    // duplicate edges are merged
+    SrcNIdV.Add(EI.GetSrcNId());  DstNIdV.Add(EI.GetDstNId());
+  }
+  PNCsrGraph CsrGraph = TNCsrGraph::New(SrcNIdV, DstNIdV);
+  PNGraph NoIsolated = TSnap::GetSubGraph(Graph, CsrGraph->GetNIdIdxV());
+  CheckSameGraph(NoIsolated, CsrGraph);
+
+  TTableContext Context;
+  Schema EdgeSchema;
+  EdgeSchema.Add(TPair<TStr,TAttrType>("Src", atInt));
+  EdgeSchema.Add(TPair<TStr,TAttrType>("Dst", atInt));
+  PTable Table = TTable::New(EdgeSchema, &Context);
+  for (int e = 0; e < SrcNIdV.Len(); e++) {
+    TTableRow Row;
+    Row.AddInt(SrcNIdV[e]);  Row.AddInt(DstNIdV[e]);
+    Table->AddRow(Row);
+  }
+  PNCsrGraph TableGraph = TSnap::ToCsrGraph<PNCsrGraph>(Table, "Src", "Dst");
+  CheckSameGraph(NoIsolated, TableGraph);
+}
+
+// Test that graph algorithms compile and agree with TNGraph
+TEST(TCsrGraph, Algorithms) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(300, 1200);
+  PNCsrGraph CsrGraph = TNCsrGraph::New(Graph);
+
+  TIntH DistH, CsrDistH;
+  TSnap::GetShortPath(Graph, 0, DistH, true);
+  TSnap::GetShortPath(CsrGraph, 0, CsrDistH, true);
+  EXPECT_EQ(DistH.Len(),CsrDistH.Len());
+  for (int i = 0; i < DistH.Len(); i++) {
+    EXPECT_EQ(DistH[i],CsrDistH.GetDat(DistH.GetKey(i)));
+  }
+
+  TCnComV CnComV, CsrCnComV;
+  TSnap::GetSccs(Graph, CnComV);
+  TSnap::GetSccs(CsrGraph, CsrCnComV);
+  EXPECT_EQ(CnComV.Len(),CsrCnComV.Len());
+  TSnap::GetWccs(Graph, CnComV);
+  TSnap::GetWccs(CsrGraph, CsrCnComV);
+  EXPECT_EQ(CnComV.Len(),CsrCnComV.Len());
+
+  EXPECT_EQ(TSnap::GetTriads(Graph),TSnap::GetTriads(CsrGraph));
+  EXPECT_NEAR(TSnap::GetClustCf(Graph),TSnap::GetClustCf(CsrGraph),1e-6);
+
+  TIntFltH PRankH, CsrPRankH;
+  TSnap::GetPageRank(Graph, PRankH);
+  TSnap::GetPageRank(CsrGraph, CsrPRankH);
+  for (int i = 0; i < PRankH.Len(); i++) {
+    EXPECT_NEAR(PRankH[i],CsrPRankH.GetDat(PRankH.GetKey(i)),1e-6);
+  }
+  TIntFltKdV DistNbrsV;
+  TSnap::GetAnf(CsrGraph, DistNbrsV, 20, false, 32);
+  EXPECT_LT(0,DistNbrsV.Len());
+}
+
+// Test saving and loading, including the shared memory loader
+TEST(TCsrGraph, SaveLoad) {
+  const TStr FName = "test.csrgraph.dat";
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(1000, 5000);
+  PUNCsrGraph CsrGraph = TUNCsrGraph::New(Graph);
+  {
+    TFOut FOut(FName);
+    CsrGraph->Save(FOut);
+  }
+  {
+    TFIn FIn(FName);
+    CheckSameGraph(Graph, TUNCsrGraph::Load(FIn));
+  }
+  TShMIn ShMIn(FName);
+  CheckSameGraph(Graph, TUNCsrGraph::LoadShM(ShMIn));
+}
+
+// Test the memory-mapped format with node attributes
+TEST(TCsrGraph, SaveLoadMmap) {
+  const TStr FName = "test.csrgraph.mmap.dat";
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(2000, 10000);
+  PNCsrGraph CsrGraph = TNCsrGraph::New(Graph);
+  TIntV DegV(CsrGraph->GetNodes());
+  TFltV HalfV(CsrGraph->GetNodes());
+  for (int n = 0; n < CsrGraph->GetNodes(); n++) {
+    DegV[n] = CsrGraph->GetNIByIdx(n).GetOutDeg();
+    HalfV[n] = CsrGraph->GetNId(n) / 2.0;
+  }
+  CsrGraph->AddIntAttrN("OutDeg", DegV);
+  CsrGraph->AddFltAttrN("Half", HalfV);
+  {
+    TFOut FOut(FName);
+    CsrGraph->SaveMmap(FOut);
+  }
+  TShMIn ShMIn(FName);
+  EXPECT_EQ(0,ShMIn.Len() % 4096);
+  PNCsrGraph MmapGraph = TNCsrGraph::LoadMmap(ShMIn);
+  CheckSameGraph(Graph, MmapGraph);
+  EXPECT_EQ(1,ShMIn.Eof());
+  EXPECT_EQ(1,MmapGraph->IsIntAttrN("OutDeg"));
+  EXPECT_EQ(0,MmapGraph->IsIntAttrN("Half"));
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_EQ(NI.GetOutDeg(),MmapGraph->GetIntAttrDatN(NI.GetId(), "OutDeg"));
+    EXPECT_EQ(NI.GetId() / 2.0,MmapGraph->GetFltAttrDatN(NI.GetId(), "Half"));
+  }
+
+  // a directed graph cannot be opened as an undirected one
+  TShMIn ShMIn2(FName);
+  EXPECT_ANY_THROW(TUNCsrGraph::LoadMmap(ShMIn2));
+
+  // truncated and corrupted inputs are rejected before any section is read
+  TShMIn ShMInBf(FName);
+  TMem Bf(ShMInBf.Len());
+  Bf.AddBf(ShMInBf.getCursor(), ShMInBf.Len());
+  TShMIn ShMInShort(Bf(), Bf.Len() - 4096);
+  EXPECT_ANY_THROW(TNCsrGraph::LoadMmap(ShMInShort));
+  TShMIn ShMInHdr(Bf(), 64);
+  EXPECT_ANY_THROW(TNCsrGraph::LoadMmap(ShMInHdr));
+  TMem BadBf(Bf);
+  // the offset of the node ids points past the end of the file
+  *(int64*) (BadBf() + 8 + 4*sizeof(int32) + 7*sizeof(int64)) = int64(1) << 40;
+  TShMIn ShMInBad(BadBf(), BadBf.Len());
+  EXPECT_ANY_THROW(TNCsrGraph::LoadMmap(ShMInBad));
+
+  // the graph without in-edges and with sparse node IDs
+  PUNGraph UGraph = TUNGraph::New();
+  for (int n = 0; n <= 50; n++) { UGraph->AddNode(n*100000); }
+  for (int n = 0; n < 50; n++) { UGraph->AddEdge(n*100000, (n+1)*100000); }
+  {
+    TFOut FOut(FName);
+    TUNCsrGraph::New(UGraph)->SaveMmap(FOut);
+  }
+  TShMIn ShMIn3(FName);
+  CheckSameGraph(UGraph, TUNCsrGraph::LoadMmap(ShMIn3));
+}
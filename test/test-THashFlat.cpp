@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Random adds, deletes and lookups give the same key ids and iteration as THash
+TEST(THashFlat, SameAsTHash) {
+  TIntIntFH FlatH;
+  TIntIntH H;
+  TRnd Rnd(1);
+  EXPECT_TRUE(FlatH.Empty());
+  EXPECT_EQ(-1, FlatH.GetKeyId(5));
+  for (int i = 0; i < 200000; i++) {
+    const int Key = Rnd.GetUniDevInt(5000) - 1000;
+    const int Op = Rnd.GetUniDevInt(10);
+    if (Op < 6) {
+      EXPECT_EQ(H.AddKey(Key), FlatH.AddKey(Key));
+      H.GetDat(Key) = i;  FlatH.GetDat(Key) = i;
+    } else if (Op < 9) {
+      EXPECT_EQ(H.DelIfKey(Key), FlatH.DelIfKey(Key));
+    } else {
+      EXPECT_EQ(H.GetKeyId(Key), FlatH.GetKeyId(Key));
+    }
+  }
+  EXPECT_EQ(H.Len(), FlatH.Len());
+  EXPECT_EQ(H.GetMxKeyIds(), FlatH.GetMxKeyIds());
+  TIntIntH::TIter HI = H.BegI();
+  for (TIntIntFH::TIter FlatHI = FlatH.BegI(); FlatHI < FlatH.EndI(); FlatHI++, HI++) {
+    EXPECT_EQ(HI.GetKey(), FlatHI.GetKey());
+    EXPECT_EQ(HI.GetDat(), FlatHI.GetDat());
+  }
+  EXPECT_TRUE(HI == H.EndI());
+  for (int KeyId = FlatH.FFirstKeyId(); FlatH.FNextKeyId(KeyId); ) {
+    EXPECT_EQ(KeyId, FlatH.GetKeyId(FlatH.GetKey(KeyId)));
+    EXPECT_EQ(H[KeyId], FlatH[KeyId]);
+  }
+  // deleting everything leaves an empty table that is still usable
+  TIntV KeyV;
+  FlatH.GetKeyV(KeyV);
+  for (int i = 0; i < KeyV.Len(); i++) { FlatH.DelKey(KeyV[i]); }
+  EXPECT_EQ(0, FlatH.Len());
+  EXPECT_FALSE(FlatH.IsKey(KeyV[0]));
+  FlatH.AddDat(7, 8);
+  EXPECT_EQ(8, FlatH.GetDat(7));
+}
+
+// Files of THash load into THashFlat and the other way around
+TEST(THashFlat, SaveLoad) {
+  const char *FName = "test.hashflat.dat";
+  TIntIntH H;
+  for (int i = 0; i < 10000; i++) { H.AddDat(i * 7919, i); }
+  for (int i = 0; i < 10000; i += 3) { H.DelKey(i * 7919); }
+  {
+    TFOut FOut(FName);
+    H.Save(FOut);
+  }
+  TIntIntFH FlatH;
+  {
+    TFIn FIn(FName);
+    FlatH.Load(FIn);
+  }
+  EXPECT_EQ(H.Len(), FlatH.Len());
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(H.GetKeyId(i * 7919), FlatH.GetKeyId(i * 7919)); }
+  FlatH.AddDat(-1, -1);
+  H.AddDat(-1, -1);
+  {
+    TFOut FOut(FName);
+    FlatH.Save(FOut);
+  }
+  TFIn FIn(FName);
+  TIntIntH H2(FIn);
+  EXPECT_TRUE(H2 == H);
+  EXPECT_EQ(H.GetKeyId(-1), H2.GetKeyId(-1));
+  // THash keeps working on the loaded ports and chains
+  H2.AddDat(123456, 1);
+  H2.DelKey(7919);
+  EXPECT_EQ(1, H2.GetDat(123456));
+  EXPECT_FALSE(H2.IsKey(7919));
+}
+
+// Defrag and sort renumber the keys and keep the lookups valid
+TEST(THashFlat, DefragSort) {
+  THashFlat<TStr, TInt> FlatH;
+  for (int i = 0; i < 1000; i++) { FlatH.AddDat(TInt::GetStr(i), i); }
+  for (int i = 0; i < 1000; i += 2) { FlatH.DelKey(TInt::GetStr(i)); }
+  EXPECT_FALSE(FlatH.IsKeyIdEqKeyN());
+  FlatH.Defrag();
+  EXPECT_TRUE(FlatH.IsKeyIdEqKeyN());
+  EXPECT_EQ(500, FlatH.Len());
+  EXPECT_EQ(1, FlatH[0]);
+  FlatH.SortByDat(false);
+  EXPECT_EQ(999, FlatH[0]);
+  for (int i = 1; i < 1000; i += 2) {
+    EXPECT_EQ(i, FlatH.GetDat(TInt::GetStr(i))); }
+  EXPECT_FALSE(FlatH.IsKey("0"));
+  THashFlat<TStr, TInt> FlatH2(FlatH);
+  EXPECT_TRUE(FlatH2 == FlatH);
+  FlatH2.Clr();
+  EXPECT_TRUE(FlatH2.Empty());
+  EXPECT_FALSE(FlatH2.IsKey("1"));
+}
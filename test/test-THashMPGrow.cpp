@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+#ifdef GCC_ATOMIC
+// Without concurrency the table gives the key ids of THash while it grows
+TEST(THashMPGrow, SameAsTHash) {
+  THashMPGrow<TInt, TInt> GrowH;
+  TIntIntH H;
+  TRnd Rnd(1);
+  EXPECT_TRUE(GrowH.Empty());
+  EXPECT_EQ(-1, GrowH.GetKeyId(5));
+  const int Slots = GrowH.GetIdxSlots();
+  for (int i = 0; i < 100000; i++) {
+    const int Key = Rnd.GetUniDevInt(50000) - 1000;
+    bool Found;
+    const bool IsKey = H.IsKey(Key);
+    EXPECT_EQ(H.AddKey(Key), GrowH.AddKey(Key, Found));
+    EXPECT_EQ(IsKey, Found);
+    H.GetDat(Key) = i;  GrowH.GetDat(Key) = i;
+    EXPECT_EQ(H.GetKeyId(Key + 1), GrowH.GetKeyId(Key + 1));
+  }
+  EXPECT_LT(Slots, GrowH.GetIdxSlots());
+  EXPECT_EQ(H.Len(), GrowH.Len());
+  EXPECT_EQ(H.GetMxKeyIds(), GrowH.GetMxKeyIds());
+  for (int KeyId = GrowH.FFirstKeyId(); GrowH.FNextKeyId(KeyId); ) {
+    EXPECT_EQ(H.GetKey(KeyId), GrowH.GetKey(KeyId));
+    EXPECT_EQ(H[KeyId], GrowH[KeyId]);
+  }
+  TIntPrV KeyDatPrV, GrowKeyDatPrV;
+  H.GetKeyDatPrV(KeyDatPrV);
+  GrowH.GetKeyDatPrV(GrowKeyDatPrV);
+  EXPECT_TRUE(KeyDatPrV == GrowKeyDatPrV);
+  // a cleared table is usable again
+  GrowH.Clr();
+  EXPECT_EQ(0, GrowH.Len());
+  EXPECT_EQ(-1, GrowH.GetKeyId(5));
+  GrowH.AddDat(5, 7);
+  EXPECT_EQ(7, GrowH.GetDat(5));
+}
+
+// Concurrent inserts of repeated keys add every key once and keep the data
+TEST(THashMPGrow, Parallel) {
+  const int Keys = 200000, Adds = 4*Keys;
+  for (int ExpectVals = 0; ExpectVals <= Keys; ExpectVals += Keys) {
+    THashMPGrow<TUInt64, TInt> GrowH(ExpectVals);
+    TIntV KeyIdV(Adds);
+    int Misses = 0;
+    #pragma omp parallel for schedule(dynamic, 1000) num_threads(8) reduction(+:Misses)
+    for (int i = 0; i < Adds; i++) {
+      // keys are edges (i % Keys, (i % Keys) / 7)
+      const uint64 Src = i % Keys;
+      const int KeyId = GrowH.AddKey(TUInt64((Src << 32) | (Src / 7)));
+      __sync_fetch_and_add(&GrowH[KeyId].Val, 1);
+      KeyIdV[i] = KeyId;
+      if (GrowH.GetKeyId(TUInt64((Src << 32) | (Src / 7))) != KeyId) { Misses++; }
+    }
+    EXPECT_EQ(0, Misses);
+    EXPECT_EQ(Keys, GrowH.Len());
+    int KeyIds = 0;
+    for (int KeyId = GrowH.FFirstKeyId(); GrowH.FNextKeyId(KeyId); KeyIds++) {
+      EXPECT_EQ(4, GrowH[KeyId]);
+    }
+    EXPECT_EQ(Keys, KeyIds);
+    for (int i = 0; i < Adds; i++) {
+      const uint64 Src = i % Keys;
+      ASSERT_EQ(KeyIdV[i], GrowH.GetKeyId(TUInt64((Src << 32) | (Src / 7))));
+      ASSERT_TRUE(GrowH.IsKeyId(KeyIdV[i]));
+    }
+    EXPECT_EQ(-1, GrowH.GetKeyId(TUInt64(Keys)));
+  }
+}
+#endif // GCC_ATOMIC
@@ -1907,3 +1907,85 @@ TEST(TNEANet, AddEdgeAttributeError) {
     ASSERT_EQ(Graph->GetStrAttrDatE(j, StrAttr), Val.GetStr());
   }
 }
+
+// A batch of edges gets the edge ids and the default attribute values of adding
+// the edges one by one, with Dedup only the first edge between two nodes is added
+TEST(TNEANet, AddEdgeBatch) {
+  for (int Dedup = 0; Dedup < 2; Dedup++) {
+    PNEANet Graph = TNEANet::New();
+    PNEANet BatchGraph = TNEANet::New();
+    Graph->AddIntAttrE("Weight", 7);  BatchGraph->AddIntAttrE("Weight", 7);
+    TRnd Rnd(1);
+    for (int Batch = 0; Batch < 2; Batch++) {
+      TIntV SrcNIdV, DstNIdV;
+      for (int i = 0; i < 5000; i++) {
+        SrcNIdV.Add(Rnd.GetUniDevInt(100));  DstNIdV.Add(Rnd.GetUniDevInt(200)); }
+      int Edges = 0;
+      for (int i = 0; i < SrcNIdV.Len(); i++) {
+        if (! Graph->IsNode(SrcNIdV[i])) { Graph->AddNode(SrcNIdV[i]); }
+        if (! Graph->IsNode(DstNIdV[i])) { Graph->AddNode(DstNIdV[i]); }
+        if (Dedup == 1 && Graph->IsEdge(SrcNIdV[i], DstNIdV[i])) { continue; }
+        Graph->AddEdge(SrcNIdV[i], DstNIdV[i]);
+        Edges++;
+      }
+      EXPECT_EQ(Edges, BatchGraph->AddEdgeBatch(SrcNIdV, DstNIdV, Dedup == 1));
+      EXPECT_TRUE(BatchGraph->IsOk());
+      EXPECT_EQ(Graph->GetNodes(), BatchGraph->GetNodes());
+      EXPECT_EQ(Graph->GetEdges(), BatchGraph->GetEdges());
+      for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+        ASSERT_TRUE(BatchGraph->IsEdge(EI.GetId()));
+        TNEANet::TEdgeI BatchEI = BatchGraph->GetEI(EI.GetId());
+        ASSERT_EQ(EI.GetSrcNId(), BatchEI.GetSrcNId());
+        ASSERT_EQ(EI.GetDstNId(), BatchEI.GetDstNId());
+        ASSERT_EQ(7, BatchGraph->GetIntAttrDatE(EI.GetId(), "Weight"));
+      }
+    }
+  }
+}
+
+// Attribute column handles read and write the values of the string based accessors,
+// also after nodes, edges and attributes are added or deleted
+TEST(TNEANet, AttrCol) {
+  PNEANet Graph = TNEANet::New();
+  Graph->AddIntAttrN("Age");  Graph->AddFltAttrN("Score");  Graph->AddStrAttrN("Name");
+  Graph->AddIntAttrE("Cap");  Graph->AddFltAttrE("Weight");  Graph->AddStrAttrE("Label");
+  TNEANet::TIntAttrCol AgeCol = Graph->GetIntAttrColN("Age");
+  TNEANet::TFltAttrCol ScoreCol = Graph->GetFltAttrColN("Score");
+  TNEANet::TStrAttrCol NameCol = Graph->GetStrAttrColN("Name");
+  TNEANet::TIntAttrCol CapCol = Graph->GetIntAttrColE("Cap");
+  TNEANet::TFltAttrCol WeightCol = Graph->GetFltAttrColE("Weight");
+  TNEANet::TStrAttrCol LabelCol = Graph->GetStrAttrColE("Label");
+  EXPECT_FALSE(AgeCol.Empty());
+  EXPECT_TRUE(TNEANet::TIntAttrCol().Empty());
+  for (int i = 0; i < 100; i++) { Graph->AddNode(3 * i); }
+  for (int i = 0; i < 300; i++) { Graph->AddEdge(3 * (i % 100), 3 * ((7 * i) % 100), i); }
+  // deleted nodes and edges leave holes in the key ids
+  for (int i = 0; i < 100; i += 7) { Graph->DelNode(3 * i); }
+  Graph->AddFltAttrN("Other");
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    Graph->AddIntAttrDatN(NI, NI.GetId() + 1, "Age");
+    Graph->AddFltAttrDatN(NI, NI.GetId() * 0.5, "Score");
+    Graph->AddStrAttrDatN(NI, TInt::GetStr(NI.GetId()), "Name");
+  }
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    Graph->AddIntAttrDatE(EI, 2 * EI.GetId(), "Cap");
+    Graph->AddFltAttrDatE(EI, EI.GetId() * 0.25, "Weight");
+    Graph->AddStrAttrDatE(EI, TInt::GetStr(EI.GetId()), "Label");
+  }
+  for (TNEANet::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_EQ(Graph->GetIntAttrDatN(NI, "Age"), NI.GetIntAttrDat(AgeCol));
+    EXPECT_EQ(Graph->GetFltAttrDatN(NI, "Score"), NI.GetFltAttrDat(ScoreCol));
+    EXPECT_EQ(Graph->GetStrAttrDatN(NI, "Name"), NI.GetStrAttrDat(NameCol));
+    EXPECT_EQ(NI.GetId() + 1, AgeCol[NI.GetKeyId()]);
+  }
+  for (TNEANet::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_EQ(Graph->GetFltKeyIdE(EI.GetId()), EI.GetKeyId());
+    EXPECT_EQ(Graph->GetIntAttrDatE(EI, "Cap"), EI.GetIntAttrDat(CapCol));
+    EXPECT_EQ(Graph->GetFltAttrDatE(EI, "Weight"), EI.GetFltAttrDat(WeightCol));
+    EXPECT_EQ(Graph->GetStrAttrDatE(EI, "Label"), EI.GetStrAttrDat(LabelCol));
+    // writes through the handle are seen by the string based accessors
+    CapCol[EI.GetKeyId()] = EI.GetId() + 5;
+    EXPECT_EQ(EI.GetId() + 5, Graph->GetIntAttrDatE(EI, "Cap"));
+  }
+  EXPECT_EQ(Graph->GetFltAttrVecE("Weight").Len(), WeightCol.GetValV().Len());
+}
@@ -159,3 +159,37 @@ TEST(TNEGraph, GetSmallGraph) {
   EXPECT_EQ(1,Graph->HasFlag(gfDirected));
 }
 
+
+// A batch of edges gets the edge ids of adding the edges one by one, with Dedup
+// only the first edge between two nodes is added
+TEST(TNEGraph, AddEdgeBatch) {
+  for (int Dedup = 0; Dedup < 2; Dedup++) {
+    PNEGraph Graph = TNEGraph::New();
+    PNEGraph BatchGraph = TNEGraph::New();
+    TRnd Rnd(1);
+    for (int Batch = 0; Batch < 2; Batch++) {
+      TIntPrV EdgeV;
+      for (int i = 0; i < 10000; i++) {
+        EdgeV.Add(TIntPr(Rnd.GetUniDevInt(100), Rnd.GetUniDevInt(200))); }
+      int Edges = 0;
+      for (int i = 0; i < EdgeV.Len(); i++) {
+        const int SrcNId = EdgeV[i].Val1, DstNId = EdgeV[i].Val2;
+        if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
+        if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
+        if (Dedup == 1 && Graph->IsEdge(SrcNId, DstNId)) { continue; }
+        Graph->AddEdge(SrcNId, DstNId);
+        Edges++;
+      }
+      EXPECT_EQ(Edges, BatchGraph->AddEdgeBatch(EdgeV, Dedup == 1));
+      EXPECT_TRUE(BatchGraph->IsOk());
+      EXPECT_EQ(Graph->GetNodes(), BatchGraph->GetNodes());
+      EXPECT_EQ(Graph->GetEdges(), BatchGraph->GetEdges());
+      for (TNEGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+        ASSERT_TRUE(BatchGraph->IsEdge(EI.GetId()));
+        TNEGraph::TEdgeI BatchEI = BatchGraph->GetEI(EI.GetId());
+        ASSERT_EQ(EI.GetSrcNId(), BatchEI.GetSrcNId());
+        ASSERT_EQ(EI.GetDstNId(), BatchEI.GetDstNId());
+      }
+    }
+  }
+}
@@ -158,4 +158,73 @@ TEST(TNGraph, GetSmallGraph) {
   EXPECT_EQ(1,Graph->IsOk());
   EXPECT_EQ(0,Graph->Empty());
   EXPECT_EQ(1,Graph->HasFlag(gfDirected));
-}
\ No newline at end of file
+}
+// The arena and the heap adjacency vectors give the same graph
+TEST(TNGraph, Arena) {
+  PNGraph Graph = TNGraph::New();
+  PNGraph HeapGraph = TNGraph::New();
+  HeapGraph->SetArena(false);
+  EXPECT_TRUE(Graph->IsArena());
+  EXPECT_FALSE(HeapGraph->IsArena());
+  TRnd Rnd(1);
+  for (int i = 0; i < 20000; i++) {
+    const int SrcNId = Rnd.GetUniDevInt(1000), DstNId = Rnd.GetUniDevInt(1000);
+    if (i % 100 == 99 && Graph->IsNode(SrcNId)) {
+      Graph->DelNode(SrcNId);  HeapGraph->DelNode(SrcNId);
+    } else if (i % 4 == 3) {
+      if (Graph->IsNode(SrcNId) && Graph->IsNode(DstNId)) {
+        Graph->DelEdge(SrcNId, DstNId);  HeapGraph->DelEdge(SrcNId, DstNId); }
+    } else {
+      EXPECT_EQ(HeapGraph->AddEdge2(SrcNId, DstNId), Graph->AddEdge2(SrcNId, DstNId));
+    }
+  }
+  EXPECT_TRUE(Graph->IsOk());
+  for (int Round = 0; Round < 4; Round++) {
+    EXPECT_EQ(HeapGraph->GetNodes(), Graph->GetNodes());
+    EXPECT_EQ(HeapGraph->GetEdges(), Graph->GetEdges());
+    for (TNGraph::TNodeI NI = HeapGraph->BegNI(); NI < HeapGraph->EndNI(); NI++) {
+      TNGraph::TNodeI ArenaNI = Graph->GetNI(NI.GetId());
+      ASSERT_EQ(NI.GetOutDeg(), ArenaNI.GetOutDeg());
+      ASSERT_EQ(NI.GetInDeg(), ArenaNI.GetInDeg());
+      for (int e = 0; e < NI.GetOutDeg(); e++) { ASSERT_EQ(NI.GetOutNId(e), ArenaNI.GetOutNId(e)); }
+      for (int e = 0; e < NI.GetInDeg(); e++) { ASSERT_EQ(NI.GetInNId(e), ArenaNI.GetInNId(e)); }
+    }
+    if (Round == 0) { Graph->Defrag(); }
+    if (Round == 1) { Graph = PNGraph(new TNGraph(*Graph));  Graph->AddEdge2(1000, 5);  HeapGraph->AddEdge2(1000, 5); }
+    if (Round == 2) { Graph->SetArena(false);  Graph->SetArena(true); }
+  }
+  EXPECT_TRUE(Graph->IsOk());
+}
+
+// Adding a batch of edges gives the same graph as adding the edges one by one
+TEST(TNGraph, AddEdgeBatch) {
+  for (int UseArena = 0; UseArena < 2; UseArena++) {
+    PNGraph Graph = TNGraph::New();
+    PNGraph BatchGraph = TNGraph::New();
+    BatchGraph->SetArena(UseArena == 1);
+    TRnd Rnd(1);
+    for (int Batch = 0; Batch < 3; Batch++) {
+      // hubs, repeated edges and self loops
+      TIntV SrcNIdV, DstNIdV;
+      for (int i = 0; i < 10000; i++) {
+        const int SrcNId = Rnd.GetUniDevInt(10) == 0 ? Rnd.GetUniDevInt(5) : Rnd.GetUniDevInt(2000);
+        SrcNIdV.Add(SrcNId);
+        DstNIdV.Add(Rnd.GetUniDevInt(10) == 0 ? SrcNId : Rnd.GetUniDevInt(2000));
+      }
+      int Edges = 0;
+      for (int i = 0; i < SrcNIdV.Len(); i++) {
+        if (Graph->AddEdge2(SrcNIdV[i], DstNIdV[i]) == -1) { Edges++; } }
+      EXPECT_EQ(Edges, BatchGraph->AddEdgeBatch(SrcNIdV, DstNIdV));
+      EXPECT_TRUE(BatchGraph->IsOk());
+      EXPECT_EQ(Graph->GetNodes(), BatchGraph->GetNodes());
+      EXPECT_EQ(Graph->GetEdges(), BatchGraph->GetEdges());
+      for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+        TNGraph::TNodeI BatchNI = BatchGraph->GetNI(NI.GetId());
+        ASSERT_EQ(NI.GetOutDeg(), BatchNI.GetOutDeg());
+        ASSERT_EQ(NI.GetInDeg(), BatchNI.GetInDeg());
+        for (int e = 0; e < NI.GetOutDeg(); e++) { ASSERT_EQ(NI.GetOutNId(e), BatchNI.GetOutNId(e)); }
+        for (int e = 0; e < NI.GetInDeg(); e++) { ASSERT_EQ(NI.GetInNId(e), BatchNI.GetInNId(e)); }
+      }
+    }
+  }
+}
@@ -163,4 +163,866 @@ TEST(TTable, ToGraphMP) {
   EXPECT_EQ(499,Graph->GetEdges());
   EXPECT_EQ(1,Graph->IsOk());
 }
+
+// Tests parallel grouping, the number of groups is not known in advance.
+TEST(TTable, ParallelGroupBy) {
+  TTableContext Context;
+  TIntIntH RowH, CntH;
+  TRnd Rnd(1);
+  for (int i = 0; i < 50000; i++) {
+    const int Group = Rnd.GetUniDevInt(5000) * 13;
+    RowH.AddDat(i, Group);  CntH.AddDat(Group)++;
+  }
+  PTable T1 = TTable::New(RowH, "Row", "Group", &Context);
+  TStrV GroupByV;  GroupByV.Add("Group");
+  const int Threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+  T1->Aggregate(GroupByV, aaCount, "Row", "Count");
+  omp_set_num_threads(Threads);
+
+  for (int i = 0; i < T1->GetNumRows(); i++) {
+    EXPECT_EQ(CntH.GetDat(T1->GetIntVal("Group", i)), T1->GetIntVal("Count", i));
+  }
+}
 #endif // GCC_ATOMIC
+
+// Builds a table with int columns A and B, float column X and string column S.
+static PTable GetSelectTable(TTableContext& Context, const int& Rows) {
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("A", atInt));
+  S.Add(TPair<TStr,TAttrType>("B", atInt));
+  S.Add(TPair<TStr,TAttrType>("X", atFlt));
+  S.Add(TPair<TStr,TAttrType>("S", atStr));
+  PTable T = TTable::New(S, &Context);
+  TRnd Rnd(1);
+  for (int i = 0; i < Rows; i++) {
+    TTableRow Row;
+    Row.AddInt(Rnd.GetUniDevInt(100));  Row.AddInt(Rnd.GetUniDevInt(100) + 1);
+    Row.AddFlt(Rnd.GetUniDev());  Row.AddStr(TStr::Fmt("s%d", Rnd.GetUniDevInt(10)));
+    T->AddRow(Row);
+  }
+  return T;
+}
+
+static void GetTableRowV(const PTable& T, TIntV& RowV) {
+  RowV.Clr();
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) { RowV.Add(RI.GetRowIdx()); }
+}
+
+// Tests column-wise selection against row-at-a-time evaluation.
+TEST(TTable, SelectColumnWise) {
+  TTableContext Context;
+  PTable T = GetSelectTable(Context, 3001);
+  TIntV RowV;
+  GetTableRowV(T, RowV);
+  for (int Cmp = LT; Cmp <= GT; Cmp++) {
+    TIntV ExpV, IntV, FltV, StrV, ColV;
+    PTable Empty;
+    T->SelectAtomicConst("A", TPrimitive(TInt(50)), TPredComp(Cmp), IntV, Empty, false, false);
+    T->SelectAtomicConst("X", TPrimitive(TFlt(0.25)), TPredComp(Cmp), FltV, Empty, false, false);
+    T->SelectAtomicConst("S", TPrimitive(TStr("s4")), TPredComp(Cmp), StrV, Empty, false, false);
+    T->SelectAtomic("A", "B", TPredComp(Cmp), ColV, false);
+    TIntV ExpIntV, ExpFltV, ExpStrV, ExpColV;
+    for (int i = 0; i < RowV.Len(); i++) {
+      const int Row = RowV[i];
+      if (TPredicate::EvalAtom(T->GetIntVal("A", Row), TInt(50), TPredComp(Cmp))) { ExpIntV.Add(Row); }
+      if (TPredicate::EvalAtom(T->GetFltVal("X", Row), TFlt(0.25), TPredComp(Cmp))) { ExpFltV.Add(Row); }
+      if (TPredicate::EvalStrAtom(T->GetStrVal("S", Row), "s4", TPredComp(Cmp))) { ExpStrV.Add(Row); }
+      if (TPredicate::EvalAtom(T->GetIntVal("A", Row), T->GetIntVal("B", Row), TPredComp(Cmp))) { ExpColV.Add(Row); }
+    }
+    EXPECT_EQ(ExpIntV, IntV);
+    EXPECT_EQ(ExpFltV, FltV);
+    EXPECT_EQ(ExpStrV, StrV);
+    EXPECT_EQ(ExpColV, ColV);
+  }
+
+  // a string constant that does not occur in the table
+  TIntV StrV;
+  PTable Empty;
+  T->SelectAtomicConst("S", TPrimitive(TStr("none")), EQ, StrV, Empty, false, false);
+  EXPECT_EQ(0, StrV.Len());
+  T->SelectAtomicConst("S", TPrimitive(TStr("none")), NEQ, StrV, Empty, false, false);
+  EXPECT_EQ(RowV, StrV);
+
+  // (A < 50 && !(S == "s3")) || X >= 0.75
+  TPredicateNode And(AND), Not(NOT), Or(OR);
+  TPredicateNode ALt(TAtomicPredicate(atInt, true, LT, "A", "", 50, 0, ""));
+  TPredicateNode SEq(TAtomicPredicate(atStr, true, EQ, "S", "", 0, 0, "s3"));
+  TPredicateNode XGte(TAtomicPredicate(atFlt, true, GTE, "X", "", 0, 0.75, ""));
+  Not.AddLeftChild(&SEq);
+  And.AddLeftChild(&ALt);  And.AddRightChild(&Not);
+  Or.AddLeftChild(&And);  Or.AddRightChild(&XGte);
+  TPredicate Pred(&Or);
+  TIntV PredV, ExpPredV;
+  T->Select(Pred, PredV, false);
+  for (int i = 0; i < RowV.Len(); i++) {
+    const int Row = RowV[i];
+    if ((T->GetIntVal("A", Row) < 50 && T->GetStrVal("S", Row) != "s3") || T->GetFltVal("X", Row) >= 0.75) {
+      ExpPredV.Add(Row);
+    }
+  }
+  EXPECT_EQ(ExpPredV, PredV);
+
+  // in-place selection keeps the order of a reordered table with removed rows
+  TStrV OrderBy;  OrderBy.Add("B");
+  T->Order(OrderBy);
+  T->SelectAtomicIntConst("A", 20, GTE);
+  GetTableRowV(T, RowV);
+  TIntV ExpV;
+  for (int i = 0; i < RowV.Len(); i++) {
+    if (T->GetFltVal("X", RowV[i]) < 0.5) { ExpV.Add(RowV[i]); }
+  }
+  T->SelectAtomicFltConst("X", 0.5, LT);
+  GetTableRowV(T, RowV);
+  EXPECT_EQ(ExpV, RowV);
+  EXPECT_EQ(ExpV.Len(), T->GetNumValidRows().Val);
+  for (int i = 1; i < RowV.Len(); i++) {
+    EXPECT_LE(T->GetIntVal("B", RowV[i-1]), T->GetIntVal("B", RowV[i]));
+  }
+  T->Select(Pred);
+  GetTableRowV(T, RowV);
+  TIntV ExpPredRowV;
+  for (int i = 0; i < ExpV.Len(); i++) {
+    if (ExpPredV.IsIn(ExpV[i])) { ExpPredRowV.Add(ExpV[i]); }
+  }
+  EXPECT_EQ(ExpPredRowV, RowV);
+
+  // selection into a new table copies the rows in table order
+  PTable T2 = TTable::New(T->GetSchema(), &Context);
+  T->SelectAtomicIntConst("A", 60, LT, T2);
+  TIntV SelV;
+  PTable Empty2;
+  T->SelectAtomicConst("A", TPrimitive(TInt(60)), LT, SelV, Empty2, false, false);
+  EXPECT_EQ(SelV.Len(), T2->GetNumValidRows().Val);
+  int Row2 = 0;
+  for (TRowIterator RI = T2->BegRI(); RI < T2->EndRI(); RI++, Row2++) {
+    EXPECT_EQ(T->GetIntVal("A", SelV[Row2]), RI.GetIntAttr("A"));
+    EXPECT_EQ(T->GetStrVal("S", SelV[Row2]), RI.GetStrAttr("S"));
+  }
+
+  // removing every row leaves an empty table
+  T->SelectAtomicIntConst("A", -1, LT);
+  EXPECT_EQ(0, T->GetNumValidRows().Val);
+  EXPECT_FALSE(T->BegRI() < T->EndRI());
+}
+
+// Tests column-wise arithmetic on tables with removed and reordered rows.
+TEST(TTable, ColOpColumnWise) {
+  TTableContext Context;
+  PTable T = GetSelectTable(Context, 2000);
+  T->SelectAtomicIntConst("A", 10, GTE);
+  TIntV RowV;
+  GetTableRowV(T, RowV);
+
+  T->ColAdd("A", "B", "Sum");
+  T->ColMin("A", "B", "Min");
+  T->ColMul("A", "X", "Prod");
+  T->ColMod("B", "A", "Mod");
+  T->ColDiv("A", 3.0, "Third", true);
+  T->ColDiv("A", 3.0, "IntThird");
+  for (int i = 0; i < RowV.Len(); i++) {
+    const int Row = RowV[i];
+    const int A = T->GetIntVal("A", Row), B = T->GetIntVal("B", Row);
+    EXPECT_EQ(A + B, T->GetIntVal("Sum", Row).Val);
+    EXPECT_EQ(TMath::Mn(A, B), T->GetIntVal("Min", Row).Val);
+    EXPECT_DOUBLE_EQ(A * T->GetFltVal("X", Row), T->GetFltVal("Prod", Row).Val);
+    EXPECT_EQ(B % A, T->GetIntVal("Mod", Row).Val);
+    EXPECT_DOUBLE_EQ(A / 3.0, T->GetFltVal("Third", Row).Val);
+    EXPECT_EQ(A / 3, T->GetIntVal("IntThird", Row).Val);
+  }
+  EXPECT_ANY_THROW(T->ColMod("X", "A", "FltMod"));
+
+  // in place
+  T->ColSub("B", 1);
+  T->ColMax("X", "Prod");
+  for (int i = 0; i < RowV.Len(); i++) {
+    const int Row = RowV[i];
+    EXPECT_EQ(T->GetIntVal("Sum", Row) - T->GetIntVal("A", Row) - 1, T->GetIntVal("B", Row).Val);
+    EXPECT_DOUBLE_EQ(TMath::Mx(T->GetFltVal("Prod", Row).Val, T->GetFltVal("Prod", Row) / T->GetIntVal("A", Row)),
+     T->GetFltVal("X", Row).Val);
+  }
+
+  // two tables are combined in iteration order
+  PTable T2 = GetSelectTable(Context, 2000);
+  T2->SelectAtomicIntConst("A", 10, GTE);
+  TStrV OrderBy;  OrderBy.Add("X");
+  T2->Order(OrderBy);
+  TIntV RowV2;
+  GetTableRowV(T2, RowV2);
+  T->ColAdd("A", *T2, "B", "Sum2");
+  T->ColMul("X", *T2, "A", "Prod2", false);
+  for (int i = 0; i < RowV.Len(); i++) {
+    EXPECT_EQ(T->GetIntVal("A", RowV[i]) + T2->GetIntVal("B", RowV2[i]), T->GetIntVal("Sum2", RowV[i]).Val);
+    EXPECT_DOUBLE_EQ(T->GetFltVal("X", RowV[i]) * T2->GetIntVal("A", RowV2[i]), T2->GetFltVal("Prod2", RowV2[i]).Val);
+  }
+}
+
+// Builds a table with columns A, B, X and S like GetSelectTable, with join keys in A, X and S spread over Rows values.
+static PTable GetJoinTable(TTableContext& Context, const int& Rows, const int& Seed) {
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("A", atInt));
+  S.Add(TPair<TStr,TAttrType>("B", atInt));
+  S.Add(TPair<TStr,TAttrType>("X", atFlt));
+  S.Add(TPair<TStr,TAttrType>("S", atStr));
+  PTable T = TTable::New(S, &Context);
+  TRnd Rnd(Seed);
+  for (int i = 0; i < Rows; i++) {
+    TTableRow Row;
+    Row.AddInt(Rnd.GetUniDevInt(Rows) - Rows/2);  Row.AddInt(i);
+    // 0.0 and -0.0 are equal keys
+    double X = (Rnd.GetUniDevInt(Rows) - Rows/2) / 4.0;
+    if (X == 0.0 && i % 2 == 1) { X = -X; }
+    Row.AddFlt(X);  Row.AddStr(TStr::Fmt("s%d", Rnd.GetUniDevInt(Rows)));
+    T->AddRow(Row);
+  }
+  return T;
+}
+
+// Gets values of column Col in iteration order, strings are replaced by their position in StrH.
+static void GetJoinKeyV(const PTable& T, const TStr& Col, TStrIntH& StrH, TFltV& KeyV) {
+  KeyV.Clr();
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    switch (T->GetColType(Col)) {
+      case atInt: KeyV.Add(RI.GetIntAttr(Col).Val); break;
+      case atFlt: KeyV.Add(RI.GetFltAttr(Col)); break;
+      case atStr: KeyV.Add(StrH.AddKey(RI.GetStrAttr(Col))); break;
+    }
+  }
+}
+
+// Checks the join of T1 and T2 against a nested loop over the bigger and then the smaller table.
+static void CheckJoin(const PTable& T1, const TStr& Col1, const PTable& T2, const TStr& Col2, const PTable& J) {
+  TIntV RowV1, RowV2;
+  GetTableRowV(T1, RowV1);
+  GetTableRowV(T2, RowV2);
+  TStrIntH StrH;
+  TFltV KeyV1, KeyV2;
+  GetJoinKeyV(T1, Col1, StrH, KeyV1);
+  GetJoinKeyV(T2, Col2, StrH, KeyV2);
+  TIntPrV ExpV;
+  if (RowV1.Len() <= RowV2.Len()) {
+    for (int j = 0; j < RowV2.Len(); j++) {
+      for (int i = 0; i < RowV1.Len(); i++) {
+        if (KeyV1[i] == KeyV2[j]) { ExpV.Add(TIntPr(RowV1[i], RowV2[j])); }
+      }
+    }
+  } else {
+    for (int i = 0; i < RowV1.Len(); i++) {
+      for (int j = 0; j < RowV2.Len(); j++) {
+        if (KeyV1[i] == KeyV2[j]) { ExpV.Add(TIntPr(RowV1[i], RowV2[j])); }
+      }
+    }
+  }
+  TIntV JRowV;
+  GetTableRowV(J, JRowV);
+  ASSERT_EQ(ExpV.Len(), JRowV.Len());
+  ASSERT_EQ(ExpV.Len(), J->GetNumValidRows().Val);
+  for (int k = 0; k < ExpV.Len(); k++) {
+    const int Row1 = ExpV[k].Val1;
+    const int Row2 = ExpV[k].Val2;
+    const int Row = JRowV[k];
+    EXPECT_EQ(k, Row);
+    EXPECT_EQ(T1->GetIntVal("A", Row1), J->GetIntVal("A-1", Row));
+    EXPECT_EQ(T1->GetIntVal("B", Row1), J->GetIntVal("B-1", Row));
+    EXPECT_EQ(T1->GetFltVal("X", Row1), J->GetFltVal("X-1", Row));
+    EXPECT_EQ(T1->GetStrVal("S", Row1), J->GetStrVal("S-1", Row));
+    EXPECT_EQ(T2->GetIntVal("A", Row2), J->GetIntVal("A-2", Row));
+    EXPECT_EQ(T2->GetIntVal("B", Row2), J->GetIntVal("B-2", Row));
+    EXPECT_EQ(T2->GetFltVal("X", Row2), J->GetFltVal("X-2", Row));
+    EXPECT_EQ(T2->GetStrVal("S", Row2), J->GetStrVal("S-2", Row));
+    EXPECT_EQ(k, J->GetIntVal("_id", Row).Val);
+  }
+}
+
+// Tests radix-partitioned join against a nested loop join.
+TEST(TTable, JoinPartitioned) {
+  TTableContext Context;
+  PTable T1 = GetJoinTable(Context, 9000, 1);
+  PTable T2 = GetJoinTable(Context, 12000, 2);
+  // iteration order of T2 is not its physical order
+  T2->SelectAtomicIntConst("B", 500, GTE);
+  TStrV OrderBy;  OrderBy.Add("X");
+  T2->Order(OrderBy);
+  PTable T3 = GetSelectTable(Context, 300);
+
+  const char* ColV[] = {"A", "X", "S"};
+  for (int c = 0; c < 3; c++) {
+    CheckJoin(T1, ColV[c], T2, ColV[c], T1->Join(ColV[c], T2, ColV[c]));
+    CheckJoin(T2, ColV[c], T1, ColV[c], T2->Join(ColV[c], T1, ColV[c]));
+    CheckJoin(T3, ColV[c], T2, ColV[c], T3->Join(ColV[c], T2, ColV[c]));
+  }
+  CheckJoin(T3, "A", T3, "A", T3->SelfJoin("A"));
+  CheckJoin(T3, "B", T1, "A", T3->Join("B", T1, "A"));
+
+  // no matches give an empty table
+  T3->SelectAtomicIntConst("A", 1000, GT);
+  PTable J = T1->Join("A", T3, "A");
+  EXPECT_EQ(0, J->GetNumValidRows().Val);
+  EXPECT_EQ(9, J->GetSchema().Len());
+}
+
+// Tests threshold join against counts of key pairs over a nested loop join.
+TEST(TTable, ThresholdJoin) {
+  TTableContext Context;
+  PTable T1 = GetSelectTable(Context, 400);
+  PTable T2 = GetSelectTable(Context, 300);
+  T2->SelectAtomicIntConst("A", 10, GTE);
+  TIntV RowV1, RowV2;
+  GetTableRowV(T1, RowV1);
+  GetTableRowV(T2, RowV2);
+  const char* JoinColV[] = {"A", "S"};
+  for (int c = 0; c < 2; c++) {
+    const TStr JoinCol = JoinColV[c];
+    // key pairs (B, B) of joint rows, with their count and first joint rows
+    THash<TIntPr, TIntTr> CntH;
+    for (int j = 0; j < RowV1.Len(); j++) {
+      for (int i = 0; i < RowV2.Len(); i++) {
+        const bool Eq = JoinCol == "A" ? T1->GetIntVal("A", RowV1[j]) == T2->GetIntVal("A", RowV2[i]) :
+         T1->GetStrVal("S", RowV1[j]) == T2->GetStrVal("S", RowV2[i]);
+        if (!Eq) { continue; }
+        TIntPr Key(T1->GetIntVal("B", RowV1[j]), T2->GetIntVal("B", RowV2[i]));
+        if (CntH.IsKey(Key)) { CntH.GetDat(Key).Val3 += 1; }
+        else { CntH.AddDat(Key, TIntTr(RowV1[j], RowV2[i], 1)); }
+      }
+    }
+    const int Threshold = 2;
+    int ExpRows = 0;
+    for (int k = 0; k < CntH.Len(); k++) {
+      if (CntH[k].Val3 >= Threshold) { ExpRows++; }
+    }
+    EXPECT_LT(0, ExpRows);
+    PTable J = T1->ThresholdJoin("B", JoinCol, *T2, "B", JoinCol, Threshold);
+    ASSERT_EQ(ExpRows, J->GetNumValidRows().Val);
+    for (TRowIterator RI = J->BegRI(); RI < J->EndRI(); RI++) {
+      TIntPr Key(RI.GetIntAttr("B-1"), RI.GetIntAttr("B-2"));
+      ASSERT_TRUE(CntH.IsKey(Key));
+      const TIntTr& Cnt = CntH.GetDat(Key);
+      EXPECT_LE(Threshold, Cnt.Val3.Val);
+      EXPECT_EQ(T1->GetFltVal("X", Cnt.Val1), RI.GetFltAttr("X-1"));
+      EXPECT_EQ(T2->GetFltVal("X", Cnt.Val2), RI.GetFltAttr("X-2"));
+    }
+  }
+}
+
+// Checks that rows of T are in the same group of column Col exactly when their keys are equal,
+// and that groups are numbered in the order of their first row.
+static void CheckGroupCol(const PTable& T, const TStr& Col, const TStrV& GroupBy) {
+  THash<TStr, TInt> KeyH;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    TStr Key;
+    for (int c = 0; c < GroupBy.Len(); c++) {
+      switch (T->GetColType(GroupBy[c])) {
+        case atInt: Key += TStr::Fmt("%d|", RI.GetIntAttr(GroupBy[c]).Val); break;
+        case atFlt: Key += TStr::Fmt("%.17g|", RI.GetFltAttr(GroupBy[c]).Val); break;
+        case atStr: Key += RI.GetStrAttr(GroupBy[c]) + "|"; break;
+      }
+    }
+    if (!KeyH.IsKey(Key)) { KeyH.AddDat(Key, KeyH.Len()); }
+    EXPECT_EQ(KeyH.GetDat(Key), RI.GetIntAttr(Col));
+  }
+}
+
+// Checks aggregate column Col of T against values of column ValCol collected per group of column GroupCol.
+static void CheckAggregateCol(const PTable& T, const TStr& GroupCol, const TStr& ValCol, TAttrAggr AggOp,
+ const TStr& Col) {
+  THash<TInt, TFltV> ValVH;
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    const double Val = T->GetColType(ValCol) == atInt ? double(RI.GetIntAttr(ValCol)) : double(RI.GetFltAttr(ValCol));
+    ValVH.AddDat(RI.GetIntAttr(GroupCol)).Add(Val);
+  }
+  const bool IsInt = T->GetColType(Col) == atInt;
+  THash<TInt, TFlt> ExpH;
+  for (int g = 0; g < ValVH.Len(); g++) {
+    TFltV& ValV = ValVH[g];
+    double Exp = 0;
+    switch (AggOp) {
+      case aaCount: Exp = ValV.Len(); break;
+      case aaMin: Exp = ValV[0]; for (int i = 1; i < ValV.Len(); i++) { Exp = TMath::Mn(Exp, ValV[i].Val); } break;
+      case aaMax: Exp = ValV[0]; for (int i = 1; i < ValV.Len(); i++) { Exp = TMath::Mx(Exp, ValV[i].Val); } break;
+      case aaFirst: Exp = ValV[0]; break;
+      case aaLast: Exp = ValV.Last(); break;
+      case aaSum: case aaMean:
+        for (int i = 0; i < ValV.Len(); i++) { Exp += ValV[i]; }
+        if (AggOp == aaMean) { Exp = IsInt ? double(int(Exp) / ValV.Len()) : Exp / ValV.Len(); }
+        break;
+      case aaMedian: ValV.Sort(); Exp = ValV[ValV.Len()/2]; break;
+    }
+    ExpH.AddDat(ValVH.GetKey(g), Exp);
+  }
+  for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+    const double Exp = ExpH.GetDat(RI.GetIntAttr(GroupCol));
+    const double Val = IsInt ? double(RI.GetIntAttr(Col)) : double(RI.GetFltAttr(Col));
+    EXPECT_NEAR(Exp, Val, 1e-9 * (1 + fabs(Exp)));
+  }
+}
+
+// Tests packed-key grouping and aggregation against per-row keys, on few and on many distinct keys.
+TEST(TTable, GroupAggregateColumnWise) {
+  TTableContext Context;
+  const int Threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+  const int RowsV[] = {3001, 70001};
+  for (int r = 0; r < 2; r++) {
+    PTable T = GetSelectTable(Context, RowsV[r]);
+    // iteration order is not the physical order
+    T->SelectAtomicIntConst("B", 3, GTE);
+    TStrV OrderBy;  OrderBy.Add("X");
+    T->Order(OrderBy);
+
+    const char* GroupByV[][2] = {{"A", ""}, {"S", ""}, {"X", ""}, {"A", "S"}, {"S", "B"}, {"A", "B"}};
+    for (int g = 0; g < 6; g++) {
+      TStrV GroupBy;
+      for (int c = 0; c < 2; c++) { if (TStr(GroupByV[g][c]) != "") { GroupBy.Add(GroupByV[g][c]); } }
+      const TStr Col = TStr::Fmt("G%d", g);
+      T->Group(GroupBy, Col);
+      CheckGroupCol(T, Col, GroupBy);
+    }
+    // a float and an int column do not fit one key, grouping falls back to GroupAux
+    TStrV GroupBy;  GroupBy.Add("X");  GroupBy.Add("A");
+    T->Group(GroupBy, "GXA");
+    CheckGroupCol(T, "GXA", GroupBy);
+
+    const TAttrAggr AggOpV[] = {aaMin, aaMax, aaFirst, aaLast, aaMean, aaMedian, aaSum, aaCount};
+    const char* ValColV[] = {"B", "X"};
+    for (int g = 0; g < 4; g++) {
+      TStrV AggGroupBy;
+      AggGroupBy.Add(GroupByV[g][0]);
+      if (TStr(GroupByV[g][1]) != "") { AggGroupBy.Add(GroupByV[g][1]); }
+      for (int a = 0; a < 8; a++) {
+        for (int v = 0; v < 2; v++) {
+          const TStr Col = TStr::Fmt("R%d_%d_%d", g, a, v);
+          T->Aggregate(AggGroupBy, AggOpV[a], ValColV[v], Col);
+          CheckAggregateCol(T, TStr::Fmt("G%d", g), ValColV[v], AggOpV[a], Col);
+        }
+      }
+    }
+  }
+  omp_set_num_threads(Threads);
+}
+
+static void CheckSameTable(const PTable& T, const PTable& T2) {
+  EXPECT_EQ(T->GetNumRows().Val, T2->GetNumRows().Val);
+  EXPECT_EQ(T->GetNumValidRows().Val, T2->GetNumValidRows().Val);
+  TIntV RowV, RowV2;
+  GetTableRowV(T, RowV);
+  GetTableRowV(T2, RowV2);
+  EXPECT_EQ(RowV, RowV2);
+  for (int i = 0; i < RowV.Len(); i++) {
+    const int RowIdx = RowV[i];
+    EXPECT_EQ(T->GetIntVal("A", RowIdx).Val, T2->GetIntVal("A", RowIdx).Val);
+    EXPECT_EQ(T->GetIntVal("B", RowIdx).Val, T2->GetIntVal("B", RowIdx).Val);
+    EXPECT_EQ(T->GetFltVal("X", RowIdx).Val, T2->GetFltVal("X", RowIdx).Val);
+    EXPECT_STREQ(T->GetStrVal("S", RowIdx).CStr(), T2->GetStrVal("S", RowIdx).CStr());
+  }
+}
+
+// Tests save and load of the memory-mapped columnar format.
+TEST(TTable, SaveLoadMmap) {
+  const TStr FName = "test.table.mmap.dat";
+  TTableContext Context;
+  PTable T = GetSelectTable(Context, 5001);
+  // removed rows and a reordered Next vector are kept
+  T->SelectAtomicIntConst("B", 10, GTE);
+  TStrV OrderBy;  OrderBy.Add("X");
+  T->Order(OrderBy);
+  {
+    TFOut FOut(FName);
+    T->SaveMmap(FOut);
+  }
+  TShMIn ShMIn(FName);
+  EXPECT_EQ(0,ShMIn.Len() % 4096);
+  TTableContext Context2;
+  PTable T2 = TTable::LoadMmap(ShMIn, &Context2);
+  EXPECT_EQ(1,ShMIn.Eof());
+  CheckSameTable(T, T2);
+  // only the 10 distinct strings were added to the context
+  EXPECT_EQ(10,Context2.AddStr("new").Val);
+
+  // a context with other strings gets its own ids for the string columns
+  TTableContext Context3;
+  Context3.AddStr("s7");  Context3.AddStr("other");
+  TShMIn ShMIn2(FName);
+  CheckSameTable(T, TTable::LoadMmap(ShMIn2, &Context3));
+
+  // the strings of the table are not the first ids of its context
+  TTableContext Context4;
+  Context4.AddStr("unused");
+  PTable T4 = GetSelectTable(Context4, 1000);
+  for (int i = 0; i < 1000; i++) {
+    TTableRow Row;
+    Row.AddInt(i);  Row.AddInt(-i);  Row.AddFlt(i / 3.0);  Row.AddStr(TStr::Fmt("distinct string %d", i));
+    T4->AddRow(Row);
+  }
+  {
+    TFOut FOut(FName);
+    T4->SaveMmap(FOut);
+  }
+  TShMIn ShMIn3(FName);
+  TTableContext Context5;
+  CheckSameTable(T4, TTable::LoadMmap(ShMIn3, &Context5));
+  EXPECT_EQ(1010,Context5.AddStr("unused").Val);
+
+  // an empty table
+  PTable Empty = TTable::New(T->GetSchema(), &Context);
+  {
+    TFOut FOut(FName);
+    Empty->SaveMmap(FOut);
+  }
+  TShMIn ShMIn4(FName);
+  PTable Empty2 = TTable::LoadMmap(ShMIn4, &Context2);
+  EXPECT_EQ(0,Empty2->GetNumRows().Val);
+  EXPECT_EQ(T->GetSchema().Len(),Empty2->GetSchema().Len());
+}
+
+// Tests that a table opened with LoadMmap() can be modified and that corrupted inputs are rejected.
+TEST(TTable, LoadMmapWrite) {
+  const TStr FName = "test.table.mmap.dat";
+  TTableContext Context;
+  PTable T = GetSelectTable(Context, 3001);
+  {
+    TFOut FOut(FName);
+    T->SaveMmap(FOut);
+  }
+  TShMIn ShMIn(FName);
+  TTableContext Context2;
+  PTable T2 = TTable::LoadMmap(ShMIn, &Context2);
+  // the mapping is read-only, the written vectors are copied first
+  T->SelectAtomicIntConst("B", 10, GTE);
+  T2->SelectAtomicIntConst("B", 10, GTE);
+  CheckSameTable(T, T2);
+  T->ColAdd("A", 5);
+  T2->ColAdd("A", 5);
+  T->Defrag();
+  T2->Defrag();
+  CheckSameTable(T, T2);
+  TTableRow Row;
+  Row.AddInt(1);  Row.AddInt(2);  Row.AddFlt(3.0);  Row.AddStr("s1");
+  T->AddRow(Row);
+  T2->AddRow(Row);
+  CheckSameTable(T, T2);
+  // ordering a freshly mapped table rewires its Next vector
+  TShMIn ShMInOrder(FName);
+  TTableContext ContextOrder;
+  PTable TOrder = TTable::LoadMmap(ShMInOrder, &ContextOrder);
+  PTable TOrder2 = GetSelectTable(Context, 3001);
+  TStrV OrderBy;  OrderBy.Add("X");
+  TOrder->Order(OrderBy);
+  TOrder2->Order(OrderBy);
+  CheckSameTable(TOrder2, TOrder);
+  // the file is unchanged
+  TShMIn ShMIn2(FName);
+  TTableContext Context3;
+  PTable T3 = TTable::LoadMmap(ShMIn2, &Context3);
+  TTableContext Context4;
+  CheckSameTable(GetSelectTable(Context4, 3001), T3);
+
+  // truncated and corrupted inputs are rejected before any array is read
+  TShMIn ShMInBf(FName);
+  TMem Bf(ShMInBf.Len());
+  Bf.AddBf(ShMInBf.getCursor(), ShMInBf.Len());
+  TShMIn ShMInShort(Bf(), Bf.Len() - 4096);
+  EXPECT_ANY_THROW(TTable::LoadMmap(ShMInShort, &Context3));
+  TShMIn ShMInHdr(Bf(), 64);
+  EXPECT_ANY_THROW(TTable::LoadMmap(ShMInHdr, &Context3));
+  // the header is followed by the column entries: name, type, index and offset
+  const int ColOff = 8 + 4*sizeof(int32) + 9*sizeof(int64);
+  TMem BadNmBf(Bf);
+  memset(BadNmBf() + ColOff, 'a', 64);
+  TShMIn ShMInNm(BadNmBf(), BadNmBf.Len());
+  EXPECT_ANY_THROW(TTable::LoadMmap(ShMInNm, &Context3));
+  TMem BadIdxBf(Bf);
+  *(int32*) (BadIdxBf() + ColOff + 64 + sizeof(int32)) = 5;
+  TShMIn ShMInIdx(BadIdxBf(), BadIdxBf.Len());
+  EXPECT_ANY_THROW(TTable::LoadMmap(ShMInIdx, &Context3));
+  TMem BadOffBf(Bf);
+  *(int64*) (BadOffBf() + ColOff + 64 + 2*sizeof(int32)) = Bf.Len() - 4096;
+  TShMIn ShMInOff(BadOffBf(), BadOffBf.Len());
+  EXPECT_ANY_THROW(TTable::LoadMmap(ShMInOff, &Context3));
+  TMem BadLenBf(Bf);
+  *(int64*) (BadLenBf() + 8 + 4*sizeof(int32)) = Bf.Len() + 4096;
+  TShMIn ShMInLen(BadLenBf(), BadLenBf.Len());
+  EXPECT_ANY_THROW(TTable::LoadMmap(ShMInLen, &Context3));
+}
+
+// Tests that the parallel load interns strings with the same ids as the sequential load.
+TEST(TTable, LoadSSParStr) {
+  const TStr FName = "test.table.strings.dat";
+  {
+    TFOut FOut(FName);
+    TRnd Rnd(1);
+    for (int i = 0; i < 20000; i++) {
+      FOut.PutStr(TStr::Fmt("u%d\t%d\tv%d\n", Rnd.GetUniDevInt(i % 2 ? 50 : 5000), i, Rnd.GetUniDevInt(100)));
+    }
+  }
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("U", atStr));
+  S.Add(TPair<TStr,TAttrType>("I", atInt));
+  S.Add(TPair<TStr,TAttrType>("V", atStr));
+  const TInt MP = TTable::GetMP();
+  const int Threads = omp_get_max_threads();
+  TTableContext SeqContext, ParContext;
+  TTable::SetMP(0);
+  PTable SeqT = TTable::LoadSS(S, FName, &SeqContext);
+  TTable::SetMP(1);
+  omp_set_num_threads(4);
+  PTable ParT = TTable::LoadSS(S, FName, &ParContext);
+  omp_set_num_threads(Threads);
+  TTable::SetMP(MP);
+
+  EXPECT_EQ(20000, ParT->GetNumRows().Val);
+  EXPECT_EQ(SeqT->GetNumRows().Val, ParT->GetNumRows().Val);
+  for (int i = 0; i < ParT->GetNumRows(); i++) {
+    EXPECT_EQ(SeqT->GetIntVal("I", i).Val, ParT->GetIntVal("I", i).Val);
+    EXPECT_EQ(SeqT->GetStrMapByName("U", i).Val, ParT->GetStrMapByName("U", i).Val);
+    EXPECT_EQ(SeqT->GetStrMapByName("V", i).Val, ParT->GetStrMapByName("V", i).Val);
+    EXPECT_STREQ(SeqT->GetStrVal("V", i).CStr(), ParT->GetStrVal("V", i).CStr());
+  }
+  EXPECT_EQ(SeqContext.AddStr("new").Val, ParContext.AddStr("new").Val);
+
+  // only some of the columns
+  TIntV RelevantCols;
+  RelevantCols.Add(2);  RelevantCols.Add(1);
+  TTableContext RelContext;
+  PTable RelT = TTable::LoadSS(S, FName, &RelContext, RelevantCols);
+  EXPECT_EQ(20000, RelT->GetNumRows().Val);
+  for (int i = 0; i < RelT->GetNumRows(); i += 7) {
+    EXPECT_EQ(SeqT->GetIntVal("I", i).Val, RelT->GetIntVal("I", i).Val);
+    EXPECT_STREQ(SeqT->GetStrVal("V", i).CStr(), RelT->GetStrVal("V", i).CStr());
+  }
+}
+
+// Tests packed columns against an unpacked copy of the table.
+TEST(TTable, PackCol) {
+  TTableContext Context;
+  PTable T = GetSelectTable(Context, 5001);
+  PTable PackT = GetSelectTable(Context, 5001);
+  PackT->PackCol("A");
+  EXPECT_TRUE(PackT->IsPackedCol("A"));
+  EXPECT_FALSE(PackT->IsPackedCol("B"));
+  PackT->Pack();
+  EXPECT_TRUE(PackT->IsPackedCol("B"));
+  EXPECT_TRUE(PackT->IsPackedCol("X"));
+  EXPECT_TRUE(PackT->IsPackedCol("S"));
+  EXPECT_GT(PackT->GetLogicalMemUsedKB(), PackT->GetMemUsedKB());
+  CheckSameTable(T, PackT);
+
+  // selections decode the packed columns a block at a time
+  for (int Cmp = LT; Cmp <= GT; Cmp++) {
+    TIntV IntV, PackIntV, FltV, PackFltV, StrV, PackStrV, ColV, PackColV;
+    PTable Empty;
+    T->SelectAtomicConst("A", TPrimitive(TInt(50)), TPredComp(Cmp), IntV, Empty, false, false);
+    PackT->SelectAtomicConst("A", TPrimitive(TInt(50)), TPredComp(Cmp), PackIntV, Empty, false, false);
+    T->SelectAtomicConst("X", TPrimitive(TFlt(0.25)), TPredComp(Cmp), FltV, Empty, false, false);
+    PackT->SelectAtomicConst("X", TPrimitive(TFlt(0.25)), TPredComp(Cmp), PackFltV, Empty, false, false);
+    T->SelectAtomicConst("S", TPrimitive(TStr("s4")), TPredComp(Cmp), StrV, Empty, false, false);
+    PackT->SelectAtomicConst("S", TPrimitive(TStr("s4")), TPredComp(Cmp), PackStrV, Empty, false, false);
+    T->SelectAtomic("A", "B", TPredComp(Cmp), ColV, false);
+    PackT->SelectAtomic("A", "B", TPredComp(Cmp), PackColV, false);
+    EXPECT_EQ(IntV, PackIntV);
+    EXPECT_EQ(FltV, PackFltV);
+    EXPECT_EQ(StrV, PackStrV);
+    EXPECT_EQ(ColV, PackColV);
+  }
+  T->SelectAtomicIntConst("B", 10, GTE);
+  PackT->SelectAtomicIntConst("B", 10, GTE);
+  EXPECT_TRUE(PackT->IsPackedCol("B"));
+  CheckSameTable(T, PackT);
+
+  // a copy stays packed, saving it does not change it
+  PTable CopyT = new TTable(*PackT);
+  EXPECT_TRUE(CopyT->IsPackedCol("X"));
+  {
+    TFOut FOut("test.table.pack.dat");
+    CopyT->Save(FOut);
+  }
+  TFIn FIn("test.table.pack.dat");
+  CheckSameTable(T, TTable::Load(FIn, &Context));
+  CheckSameTable(T, CopyT);
+
+  // ordering reads the packed sort columns, the table stays packed
+  TStrV OrderBy;  OrderBy.Add("X");
+  T->Order(OrderBy);
+  PackT->Order(OrderBy);
+  EXPECT_TRUE(PackT->IsPackedCol("A"));
+  EXPECT_TRUE(PackT->IsPackedCol("X"));
+  CheckSameTable(T, PackT);
+  PackT->PackCol("S", ceDict);
+  PackT->UnpackCol("S");
+  EXPECT_FALSE(PackT->IsPackedCol("S"));
+  CheckSameTable(T, PackT);
+}
+
+// Checks that tables T and T2 have the same valid rows and the same values in the columns of T.
+static void CheckSameCols(const PTable& T, const PTable& T2) {
+  TIntV RowV, RowV2;
+  GetTableRowV(T, RowV);
+  GetTableRowV(T2, RowV2);
+  EXPECT_EQ(RowV, RowV2);
+  Schema S = T->GetSchema();
+  for (int c = 0; c < S.Len(); c++) {
+    for (int i = 0; i < RowV.Len(); i++) {
+      switch (S[c].Val2) {
+        case atInt: EXPECT_EQ(T->GetIntVal(S[c].Val1, RowV[i]).Val, T2->GetIntVal(S[c].Val1, RowV[i]).Val); break;
+        case atFlt: EXPECT_EQ(T->GetFltVal(S[c].Val1, RowV[i]).Val, T2->GetFltVal(S[c].Val1, RowV[i]).Val); break;
+        case atStr: EXPECT_STREQ(T->GetStrVal(S[c].Val1, RowV[i]).CStr(), T2->GetStrVal(S[c].Val1, RowV[i]).CStr()); break;
+      }
+    }
+  }
+}
+
+// Tests operations on packed tables against the same operations on plain tables.
+TEST(TTable, PackedOps) {
+  TTableContext Context;
+  PTable T = GetSelectTable(Context, 5001);
+  PTable PackT = GetSelectTable(Context, 5001);
+  T->SelectAtomicIntConst("B", 10, GTE);
+  PackT->SelectAtomicIntConst("B", 10, GTE);
+  PackT->Pack();
+
+  // grouping, joining, conversion and saving decode only the columns they read
+  TStrV GroupBy;  GroupBy.Add("S");  GroupBy.Add("A");
+  T->Group(GroupBy, "G");
+  PackT->Group(GroupBy, "G");
+  CheckSameCols(T, PackT);
+  CheckSameCols(T->Join("A", *T, "B"), PackT->Join("A", *PackT, "B"));
+  T->Aggregate(GroupBy, aaSum, "X", "XSum");
+  PackT->Aggregate(GroupBy, aaSum, "X", "XSum");
+  CheckSameCols(T, PackT);
+  PNGraph Graph = TSnap::ToGraph<PNGraph>(T, "A", "B", aaFirst);
+  PNGraph PackGraph = TSnap::ToGraph<PNGraph>(PackT, "A", "B", aaFirst);
+  EXPECT_EQ(Graph->GetEdges(), PackGraph->GetEdges());
+  {
+    TFOut FOut("test.table.pack.dat");
+    PackT->Save(FOut);
+  }
+  TFIn FIn("test.table.pack.dat");
+  CheckSameCols(T, TTable::Load(FIn, &Context));
+  EXPECT_TRUE(PackT->IsPackedCol("A"));
+  EXPECT_TRUE(PackT->IsPackedCol("X"));
+  EXPECT_TRUE(PackT->IsPackedCol("S"));
+
+  // in place arithmetic unpacks only the result column
+  T->ColAdd("A", "B");
+  PackT->ColAdd("A", "B");
+  EXPECT_FALSE(PackT->IsPackedCol("A"));
+  EXPECT_TRUE(PackT->IsPackedCol("B"));
+  CheckSameCols(T, PackT);
+  PackT->Pack();
+  T->ColMul("X", 2.0);
+  PackT->ColMul("X", 2.0);
+  EXPECT_TRUE(PackT->IsPackedCol("A"));
+  CheckSameCols(T, PackT);
+  PackT->Pack();
+  T->ColAdd("A", 5);
+  PackT->ColAdd("A", 5);
+  CheckSameCols(T, PackT);
+  PackT->Pack();
+  T->ColMin("A", "B");
+  PackT->ColMin("A", "B");
+  CheckSameCols(T, PackT);
+  PackT->Pack();
+  T->ColMax("B", "A", "M");
+  PackT->ColMax("B", "A", "M");
+  CheckSameCols(T, PackT);
+
+  // row operations
+  PackT->Pack();
+  T->Unique("S");
+  PackT->Unique("S");
+  CheckSameCols(T, PackT);
+  PackT->Pack();
+  T->Defrag();
+  PackT->Defrag();
+  CheckSameCols(T, PackT);
+  PackT->Pack();
+  TStrV ProjectCols;  ProjectCols.Add("B");  ProjectCols.Add("X");
+  T->ProjectInPlace(ProjectCols);
+  PackT->ProjectInPlace(ProjectCols);
+  EXPECT_TRUE(PackT->IsPackedCol("B"));
+  EXPECT_TRUE(PackT->IsPackedCol("X"));
+  EXPECT_EQ(PackT->GetSchema().Len(), T->GetSchema().Len());
+  CheckSameCols(T, PackT);
+}
+
+// Tests the radix sort of Order against a row comparison, rows with equal keys keep their order.
+TEST(TTable, OrderRadix) {
+  TTableContext Context;
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("A", atInt));
+  S.Add(TPair<TStr,TAttrType>("B", atInt));
+  S.Add(TPair<TStr,TAttrType>("X", atFlt));
+  S.Add(TPair<TStr,TAttrType>("Y", atFlt));
+  S.Add(TPair<TStr,TAttrType>("S", atStr));
+  PTable T0 = TTable::New(S, &Context);
+  TRnd Rnd(1);
+  for (int i = 0; i < 20000; i++) {
+    TTableRow Row;
+    Row.AddInt(Rnd.GetUniDevInt(20) - 10);
+    Row.AddInt(i % 3 == 0 ? TInt::Mn : (i % 3 == 1 ? TInt::Mx : Rnd.GetUniDevInt(TInt::Mx)));
+    const double Flt = Rnd.GetUniDevInt(10) - 5.0;
+    Row.AddFlt(Flt == 0.0 && i % 2 ? -0.0 : Flt);
+    Row.AddFlt(Rnd.GetUniDev() * 1e10 - 5e9);
+    Row.AddStr(TStr::Fmt("s%d", Rnd.GetUniDevInt(300)));
+    T0->AddRow(Row);
+  }
+  T0->SelectAtomicIntConst("A", 8, LT);
+  const char* OrderByV[] = { "A", "B", "X", "Y", "S", "S,A", "A,B", "X,Y", "S,X,B", "Y,A" };
+  for (int o = 0; o < 10; o++) {
+    TStrV OrderBy;
+    TStr(OrderByV[o]).SplitOnAllCh(',', OrderBy);
+    for (int Asc = 0; Asc < 2; Asc++) {
+      PTable T = new TTable(*T0);
+      TIntV PrevRowV;
+      GetTableRowV(T, PrevRowV);
+      TIntV PrevPosV(T->GetNumRows());
+      for (int i = 0; i < PrevRowV.Len(); i++) { PrevPosV[PrevRowV[i]] = i; }
+      T->Order(OrderBy, "", false, Asc == 1);
+      TIntV RowV;
+      GetTableRowV(T, RowV);
+      EXPECT_EQ(PrevRowV.Len(), RowV.Len());
+      for (int i = 1; i < RowV.Len(); i++) {
+        int Cmp = 0;
+        for (int c = 0; c < OrderBy.Len() && Cmp == 0; c++) {
+          switch (T->GetColType(OrderBy[c])) {
+            case atInt: {
+              const int Val1 = T->GetIntVal(OrderBy[c], RowV[i-1]), Val2 = T->GetIntVal(OrderBy[c], RowV[i]);
+              Cmp = Val1 < Val2 ? -1 : (Val1 > Val2 ? 1 : 0);
+              break;
+            }
+            case atFlt: {
+              const double Val1 = T->GetFltVal(OrderBy[c], RowV[i-1]), Val2 = T->GetFltVal(OrderBy[c], RowV[i]);
+              Cmp = Val1 < Val2 ? -1 : (Val1 > Val2 ? 1 : 0);
+              break;
+            }
+            case atStr: Cmp = strcmp(T->GetStrVal(OrderBy[c], RowV[i-1]).CStr(), T->GetStrVal(OrderBy[c], RowV[i]).CStr()); break;
+          }
+        }
+        if (Asc == 0) { Cmp = -Cmp; }
+        EXPECT_LE(Cmp, 0);
+        if (Cmp == 0) { EXPECT_LT(PrevPosV[RowV[i-1]].Val, PrevPosV[RowV[i]].Val); }
+      }
+    }
+  }
+
+  // the rows of an interval of a variable graph sequence
+  PTable T = new TTable(*T0);
+  T->SetSrcCol("S");
+  T->SetDstCol("S");
+  TIntPrV IntervalV;
+  IntervalV.Add(TIntPr(-10, -5));  IntervalV.Add(TIntPr(-7, 0));  IntervalV.Add(TIntPr(3, 3));
+  IntervalV.Add(TIntPr(5, 100));  IntervalV.Add(TIntPr(-100, 100));
+  TVec<PNEANet> GraphV = T->ToVarGraphSequence("A", aaFirst, IntervalV);
+  EXPECT_EQ(4, GraphV.Len());
+  for (int j = 0, g = 0; j < IntervalV.Len(); j++) {
+    TIntV ExpEIdV;
+    for (TRowIterator RI = T->BegRI(); RI < T->EndRI(); RI++) {
+      if (RI.GetIntAttr("A") >= IntervalV[j].Val1 && RI.GetIntAttr("A") < IntervalV[j].Val2) { ExpEIdV.Add(RI.GetRowIdx()); }
+    }
+    if (ExpEIdV.Empty()) { continue; }
+    TIntV EIdV;
+    for (TNEANet::TEdgeI EI = GraphV[g]->BegEI(); EI < GraphV[g]->EndEI(); EI++) { EIdV.Add(EI.GetId()); }
+    EIdV.Sort();
+    EXPECT_EQ(ExpEIdV, EIdV);
+    g++;
+  }
+}
@@ -289,4 +289,78 @@ TEST(TUNGraph, GetSmallGraph) {
   EXPECT_EQ(1,Graph->IsOk());
   EXPECT_EQ(0,Graph->Empty());
   EXPECT_EQ(0,Graph->HasFlag(gfDirected));
-}
\ No newline at end of file
+}
+// The arena and the heap adjacency vectors give the same graph
+TEST(TUNGraph, Arena) {
+  PUNGraph Graph = TUNGraph::New();
+  PUNGraph HeapGraph = TUNGraph::New();
+  HeapGraph->SetArena(false);
+  EXPECT_TRUE(Graph->IsArena());
+  EXPECT_FALSE(HeapGraph->IsArena());
+  TRnd Rnd(1);
+  for (int i = 0; i < 20000; i++) {
+    const int SrcNId = Rnd.GetUniDevInt(1000), DstNId = Rnd.GetUniDevInt(1000);
+    if (i % 100 == 99 && Graph->IsNode(SrcNId)) {
+      Graph->DelNode(SrcNId);  HeapGraph->DelNode(SrcNId);
+    } else if (i % 4 == 3) {
+      if (Graph->IsNode(SrcNId) && Graph->IsNode(DstNId)) {
+        Graph->DelEdge(SrcNId, DstNId);  HeapGraph->DelEdge(SrcNId, DstNId); }
+    } else {
+      EXPECT_EQ(HeapGraph->AddEdge2(SrcNId, DstNId), Graph->AddEdge2(SrcNId, DstNId));
+    }
+  }
+  TIntV NbrNIdV;
+  for (TUNGraph::TNodeI NI = Graph->BegNI(); NbrNIdV.Len() < 3; NI++) { NbrNIdV.Add(NI.GetId()); }
+  const int NId = Graph->AddNode(-1, NbrNIdV);
+  EXPECT_EQ(NId, HeapGraph->AddNode(-1, NbrNIdV));
+  EXPECT_TRUE(Graph->IsOk());
+  for (int Round = 0; Round < 4; Round++) {
+    EXPECT_EQ(HeapGraph->GetNodes(), Graph->GetNodes());
+    EXPECT_EQ(HeapGraph->GetEdges(), Graph->GetEdges());
+    for (TUNGraph::TNodeI NI = HeapGraph->BegNI(); NI < HeapGraph->EndNI(); NI++) {
+      TUNGraph::TNodeI ArenaNI = Graph->GetNI(NI.GetId());
+      ASSERT_EQ(NI.GetDeg(), ArenaNI.GetDeg());
+      for (int e = 0; e < NI.GetDeg(); e++) { ASSERT_EQ(NI.GetNbrNId(e), ArenaNI.GetNbrNId(e)); }
+    }
+    if (Round == 0) { Graph->Defrag(); }
+    if (Round == 1) { Graph = PUNGraph(new TUNGraph(*Graph));  Graph->AddEdge2(NId, 1000);  HeapGraph->AddEdge2(NId, 1000); }
+    if (Round == 2) { Graph->SetArena(false);  Graph->SetArena(true); }
+  }
+  EXPECT_TRUE(Graph->IsOk());
+}
+
+// Adding a batch of edges gives the same graph as adding the edges one by one
+TEST(TUNGraph, AddEdgeBatch) {
+  for (int UseArena = 0; UseArena < 2; UseArena++) {
+    PUNGraph Graph = TUNGraph::New();
+    PUNGraph BatchGraph = TUNGraph::New();
+    BatchGraph->SetArena(UseArena == 1);
+    TRnd Rnd(1);
+    for (int Batch = 0; Batch < 3; Batch++) {
+      // hubs, repeated edges and self loops
+      TIntPrV EdgeV;
+      for (int i = 0; i < 10000; i++) {
+        const int SrcNId = Rnd.GetUniDevInt(10) == 0 ? Rnd.GetUniDevInt(5) : Rnd.GetUniDevInt(2000);
+        EdgeV.Add(TIntPr(SrcNId, Rnd.GetUniDevInt(10) == 0 ? SrcNId : Rnd.GetUniDevInt(2000)));
+      }
+      int Edges = 0;
+      for (int i = 0; i < EdgeV.Len(); i++) {
+        if (Graph->AddEdge2(EdgeV[i].Val1, EdgeV[i].Val2) == -1) { Edges++; } }
+      if (Batch == 2) {
+        TIntV SrcNIdV, DstNIdV;
+        for (int i = 0; i < EdgeV.Len(); i++) { SrcNIdV.Add(EdgeV[i].Val1);  DstNIdV.Add(EdgeV[i].Val2); }
+        EXPECT_EQ(Edges, BatchGraph->AddEdgeBatch((const int*) SrcNIdV.BegI(), (const int*) DstNIdV.BegI(), SrcNIdV.Len(), false));
+      } else {
+        EXPECT_EQ(Edges, BatchGraph->AddEdgeBatch(EdgeV));
+      }
+      EXPECT_TRUE(BatchGraph->IsOk());
+      EXPECT_EQ(Graph->GetNodes(), BatchGraph->GetNodes());
+      EXPECT_EQ(Graph->GetEdges(), BatchGraph->GetEdges());
+      for (TUNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+        TUNGraph::TNodeI BatchNI = BatchGraph->GetNI(NI.GetId());
+        ASSERT_EQ(NI.GetDeg(), BatchNI.GetDeg());
+        for (int e = 0; e < NI.GetDeg(); e++) { ASSERT_EQ(NI.GetNbrNId(e), BatchNI.GetNbrNId(e)); }
+      }
+    }
+  }
+}
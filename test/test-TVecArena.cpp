@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Random adds, sorted adds and deletes on vectors of the arena give the same
+// vectors as on plain TIntV; some vectors start out as owned vectors
+TEST(TVecArena, SameAsTVec) {
+  const int Vecs = 1000;
+  TVecArena<TInt> Arena;
+  TVec<TIntV> ArenaVV(Vecs), VV(Vecs);
+  TRnd Rnd(1);
+  for (int i = 0; i < Vecs; i += 10) { ArenaVV[i].Gen(4, 0); }
+  for (int i = 0; i < 200000; i++) {
+    const int VecN = Rnd.GetUniDevInt(Vecs);
+    const int Val = Rnd.GetUniDevInt(1000);
+    TIntV& ArenaV = ArenaVV[VecN];
+    TIntV& V = VV[VecN];
+    switch (Rnd.GetUniDevInt(4)) {
+      case 0: EXPECT_EQ(V.Add(Val), Arena.Add(ArenaV, Val));  break;
+      case 1: V.Sort();  ArenaV.Sort();
+        EXPECT_EQ(V.AddSorted(Val), Arena.AddSorted(ArenaV, Val));  break;
+      case 2: if (! V.Empty()) {
+          const int ValN = Rnd.GetUniDevInt(V.Len());
+          V.Del(ValN);  Arena.Del(ArenaV, ValN); }
+        break;
+      case 3: if (Rnd.GetUniDevInt(100) == 0) { V.Clr();  Arena.Clr(ArenaV); }
+        break;
+    }
+    ASSERT_TRUE(V == ArenaV);
+    ASSERT_LE(ArenaV.Len(), TVecArena<TInt>::GetMxVals(ArenaV));
+  }
+  TIntV SrcV;
+  for (int i = 0; i < 100; i++) { SrcV.Add(i); }
+  Arena.Reserve(ArenaVV[0], ArenaVV[0].Len() + 500);
+  EXPECT_LE(ArenaVV[0].Len() + 500, TVecArena<TInt>::GetMxVals(ArenaVV[0]));
+  VV[0].AddV(SrcV);  Arena.AddV(ArenaVV[0], SrcV);
+  EXPECT_TRUE(VV[0] == ArenaVV[0]);
+  // a copy of an arena vector owns its values
+  TIntV CopyV(ArenaVV[0]);
+  EXPECT_FALSE(CopyV.IsExt());
+  EXPECT_TRUE(CopyV == VV[0]);
+
+  // defragmentation leaves no spare capacity
+  const uint64 MemUsed = Arena.GetMemUsed();
+  TVec<TIntV*> ArenaVPtV;
+  for (int i = 0; i < Vecs; i++) { ArenaVPtV.Add(&ArenaVV[i]); }
+  Arena.Defrag(ArenaVPtV);
+  EXPECT_GE(MemUsed, Arena.GetMemUsed());
+  for (int i = 0; i < Vecs; i++) {
+    EXPECT_TRUE(VV[i] == ArenaVV[i]);
+    EXPECT_EQ(VV[i].Empty(), ! ArenaVV[i].IsExt());
+  }
+  // vectors grow again after defragmentation
+  for (int i = 0; i < Vecs; i++) {
+    VV[i].Add(i);  Arena.Add(ArenaVV[i], i);
+    EXPECT_TRUE(VV[i] == ArenaVV[i]);
+  }
+  for (int i = 0; i < Vecs; i++) { Arena.Clr(ArenaVV[i]); }
+  Arena.Clr();
+  EXPECT_EQ(0, Arena.GetChunks());
+}
+
+// Blocks of freed vectors are reused, the arena does not grow
+TEST(TVecArena, Reuse) {
+  TVecArena<TInt> Arena;
+  TVec<TIntV> VV(1000);
+  for (int Round = 0; Round < 10; Round++) {
+    for (int i = 0; i < VV.Len(); i++) {
+      for (int j = 0; j < i % 50; j++) { Arena.Add(VV[i], j); }
+    }
+    for (int i = 0; i < VV.Len(); i++) { Arena.Clr(VV[i]); }
+  }
+  const uint64 MemUsed = Arena.GetMemUsed();
+  for (int i = 0; i < VV.Len(); i++) {
+    for (int j = 0; j < i % 50; j++) { Arena.Add(VV[i], j); }
+    EXPECT_EQ(i % 50, VV[i].Len());
+  }
+  EXPECT_EQ(MemUsed, Arena.GetMemUsed());
+  // defragmentation of empty vectors frees all but the first chunk
+  TVec<TIntV*> VPtV;
+  for (int i = 0; i < VV.Len(); i++) { Arena.Clr(VV[i]);  VPtV.Add(&VV[i]); }
+  Arena.Defrag(VPtV);
+  EXPECT_EQ(1, Arena.GetChunks());
+  EXPECT_GT(MemUsed, Arena.GetMemUsed());
+}
+
+// Vectors that grow side by side leave blocks behind that the sweeps merge
+// for the larger vectors, and defragmentation slides the blocks together
+TEST(TVecArena, Sweep) {
+  const int Vecs = 100000, Vals = 48;
+  TVecArena<TInt> Arena;
+  TVec<TIntV> VV(Vecs);
+  for (int ValN = 0; ValN < Vals; ValN++) {
+    for (int i = 0; i < Vecs; i++) { Arena.Add(VV[i], i + ValN); }
+  }
+  // the vectors hold 48 values in blocks of 64 and a header
+  const uint64 LiveMem = uint64(Vecs) * 65 * sizeof(TInt);
+  EXPECT_GT(1.5 * LiveMem, Arena.GetMemUsed());
+  TVec<TIntV*> VPtV;
+  for (int i = 0; i < Vecs; i++) {
+    if (i % 2 == 0) { Arena.Clr(VV[i]); }
+    VPtV.Add(&VV[i]);
+  }
+  Arena.Defrag(VPtV);
+  // half of the vectors are left, chunks are freed as a whole
+  EXPECT_GT(0.75 * LiveMem, Arena.GetMemUsed());
+  for (int i = 0; i < Vecs; i++) {
+    ASSERT_EQ(i % 2 == 0 ? 0 : Vals, VV[i].Len());
+    for (int ValN = 0; ValN < VV[i].Len(); ValN++) { ASSERT_EQ(i + ValN, VV[i][ValN]); }
+  }
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Exact number of pairs of nodes reachable in <= H hops, computed by BFS from every node
+template <class PGraph>
+void GetExactAnf(const PGraph& Graph, const bool& IsDir, TFltV& PairsV) {
+  TIntPrV HopCntV;
+  PairsV.Clr();
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    TSnap::GetNodesAtHops(Graph, NI.GetId(), HopCntV, IsDir);
+    for (int h = 0; h < HopCntV.Len(); h++) {
+      if (PairsV.Len() <= h) { PairsV.Add(0.0); }
+      PairsV[h] += HopCntV[h].Val2;
+    }
+  }
+  for (int h = 1; h < PairsV.Len(); h++) { PairsV[h] += PairsV[h-1]; }
+}
+
+// Compare the HyperANF neighborhood function to the exact one
+template <class PGraph>
+void TestHyperAnf(const PGraph& Graph, const bool& IsDir) {
+  TFltV ExactV;
+  GetExactAnf(Graph, IsDir, ExactV);
+  TIntFltKdV DistNbrsV;
+  THyperAnf<PGraph> Anf(Graph, 256, 1);
+  Anf.GetGraphAnf(DistNbrsV, -1, IsDir, false);
+  EXPECT_EQ(0, DistNbrsV[0].Key);
+  EXPECT_EQ(Graph->GetNodes(), DistNbrsV[0].Dat);
+  for (int i = 1; i < DistNbrsV.Len(); i++) {
+    const double Exact = ExactV[TMath::Mn(DistNbrsV[i].Key.Val, ExactV.Len()-1)];
+    EXPECT_NEAR(1.0, DistNbrsV[i].Dat / Exact, 0.15);
+    EXPECT_LE(DistNbrsV[i-1].Dat, DistNbrsV[i].Dat);
+  }
+  // counters of single nodes
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    EXPECT_LT(0.5, Anf.GetNodeCnt(NI.GetId()));
+  }
+}
+
+TEST(AnfTest, HyperAnf) {
+  TestHyperAnf(TSnap::GenRndGnm<PUNGraph>(2000, 6000, false), false);
+  TestHyperAnf(TSnap::GenRndGnm<PNGraph>(2000, 6000, true), true);
+  TestHyperAnf(TSnap::GenRndGnm<PNGraph>(2000, 6000, true), false);
+  TestHyperAnf(TSnap::GenGrid<PUNGraph>(30, 30, false), false);
+}
+
+// Directed cycle of length 10, every node reaches all others in 9 hops
+TEST(AnfTest, Cycle) {
+  PNGraph Graph = TNGraph::New();
+  for (int n = 0; n < 10; n++) { Graph->AddNode(n); }
+  for (int n = 0; n < 10; n++) { Graph->AddEdge(n, (n+1) % 10); }
+  TIntFltKdV DistNbrsV;
+  THyperAnf<PNGraph> Anf(Graph, 256, 1);
+  Anf.GetGraphAnf(DistNbrsV, -1, true, false);
+  // the counters stop changing after 9 hops
+  EXPECT_EQ(11, DistNbrsV.Len());
+  EXPECT_NEAR(100.0, DistNbrsV.Last().Dat, 5.0);
+  // limited number of hops
+  Anf.GetGraphAnf(DistNbrsV, 4, true, false);
+  EXPECT_EQ(4, DistNbrsV.Len());
+  EXPECT_NEAR(40.0, DistNbrsV.Last().Dat, 2.0);
+}
+
+// Effective diameter of HyperANF and of BFS from all nodes
+TEST(AnfTest, EffDiam) {
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(3000, 9000, false);
+  const double AnfEffDiam = TSnap::GetAnfEffDiam(Graph, false, 0.9, 64);
+  const double BfsEffDiam = TSnap::GetBfsEffDiam(Graph, Graph->GetNodes(), false);
+  EXPECT_NEAR(BfsEffDiam, AnfEffDiam, 0.5);
+  TIntFltKdV DistNbrsV;
+  TSnap::GetAnf(Graph, DistNbrsV, -1, false, 32);
+  EXPECT_EQ(Graph->GetNodes(), DistNbrsV[0].Dat);
+}
@@ -348,3 +348,168 @@ TEST(BfsDfsTest, CompleteGraph) {
   TestFullBfsDfs<PNEGraph>();
   
 }
+
+// Compare the distances of DoBfsMP() to DoBfs() from several start nodes
+template <class PGraph>
+void TestBfsMP(const PGraph& G) {
+  TBreathFS<PGraph> BFS(G), BFSMP(G);
+  TIntV NIdV, HopCntV;
+  G->GetNIdV(NIdV);
+  for (int i = 0; i < 10; i++) {
+    const int StartNId = NIdV[(i * 7919) % NIdV.Len()];
+    for (int Dir = 0; Dir < 3; Dir++) {
+      const bool FollowOut = Dir != 1, FollowIn = Dir != 0;
+      const int MaxDist = BFS.DoBfs(StartNId, FollowOut, FollowIn, -1, TInt::Mx);
+      EXPECT_EQ(MaxDist, BFSMP.DoBfsMP(StartNId, FollowOut, FollowIn, -1, TInt::Mx));
+      EXPECT_EQ(BFS.GetNVisited(), BFSMP.GetNVisited());
+      for (int n = 0; n < BFS.NIdDistH.Len(); n++) {
+        EXPECT_EQ(BFS.NIdDistH[n], BFSMP.GetHops(StartNId, BFS.NIdDistH.GetKey(n)));
+      }
+      // distances are listed level by level
+      for (int n = 1; n < BFSMP.NIdDistH.Len(); n++) {
+        EXPECT_LE(BFSMP.NIdDistH[n-1], BFSMP.NIdDistH[n]);
+      }
+      BFSMP.GetHopCntV(HopCntV);
+      EXPECT_EQ(MaxDist+1, HopCntV.Len());
+      int Visited = 0;
+      for (int h = 0; h < HopCntV.Len(); h++) { Visited += HopCntV[h]; }
+      EXPECT_EQ(BFS.GetNVisited(), Visited);
+      // limited distance
+      BFS.DoBfs(StartNId, FollowOut, FollowIn, -1, 2);
+      BFSMP.DoBfsMP(StartNId, FollowOut, FollowIn, -1, 2);
+      EXPECT_EQ(BFS.GetNVisited(), BFSMP.GetNVisited());
+      // target node
+      const int DstNId = NIdV[(i * 104729 + 1) % NIdV.Len()];
+      BFS.DoBfs(StartNId, FollowOut, FollowIn, DstNId, TInt::Mx);
+      const int Dist = BFSMP.DoBfsMP(StartNId, FollowOut, FollowIn, DstNId, TInt::Mx);
+      EXPECT_EQ(BFS.GetHops(StartNId, DstNId), BFSMP.GetHops(StartNId, DstNId));
+      if (BFS.GetHops(StartNId, DstNId) > 0) {
+        EXPECT_EQ(BFS.GetHops(StartNId, DstNId), Dist);
+      }
+    }
+  }
+}
+
+// Test the multi-threaded BFS on random graphs of each type
+TEST(BfsDfsTest, DoBfsMP) {
+  TestBfsMP(GenRndGnm<PUNGraph>(2000, 4000, false));
+  TestBfsMP(GenRndGnm<PNGraph>(2000, 6000, true));
+  TestBfsMP(GenRndGnm<PNEANet>(2000, 6000, true));
+  PNGraph RMat = GenRMat(1 << 14, 1 << 17, 0.57, 0.19, 0.19);
+  TestBfsMP(RMat);
+  TestBfsMP(TNCsrGraph::New(RMat));
+  TestBfsMP(TUNCsrGraph::New(RMat));
+
+  // sparse node IDs
+  PNGraph G = TNGraph::New();
+  for (int e = 0; e < RMat->GetEdges() / 4; e++) {
+    const int SrcNId = TInt::Rnd.GetUniDevInt(1000) * 100003, DstNId = TInt::Rnd.GetUniDevInt(1000) * 100003;
+    if (! G->IsNode(SrcNId)) { G->AddNode(SrcNId); }
+    if (! G->IsNode(DstNId)) { G->AddNode(DstNId); }
+    G->AddEdge(SrcNId, DstNId);
+  }
+  TestBfsMP(G);
+
+  // the graph changes between searches
+  TBreathFS<PUNGraph> BFS(TUNGraph::New());
+  PUNGraph UG = GenGrid<PUNGraph>(10, 10, false);
+  BFS.SetGraph(UG);
+  EXPECT_EQ(18, BFS.DoBfsMP(0, true, false));
+  UG->AddEdge(0, 99);
+  BFS.SetGraph(UG);
+  EXPECT_EQ(9, BFS.DoBfsMP(0, true, false));
+  EXPECT_EQ(1, BFS.GetHops(0, 99));
+  // a node is replaced by another one, the number of nodes stays the same
+  UG->DelNode(55);
+  UG->AddNode(1000);
+  UG->AddEdge(99, 1000);
+  TBreathFS<PUNGraph> BFSSeq(UG);
+  EXPECT_EQ(BFSSeq.DoBfs(0, true, false), BFS.DoBfsMP(0, true, false));
+  EXPECT_EQ(2, BFS.GetHops(0, 1000));
+  EXPECT_EQ(-1, BFS.GetHops(0, 55));
+  // the node arrays are reused while the nodes stay the same, new edges are followed
+  UG->AddEdge(0, 1000);
+  BFS.DoBfsMP(0, true, false);
+  EXPECT_EQ(1, BFS.GetHops(0, 1000));
+
+  // repeated searches list the nodes in the same order
+  TBreathFS<PNGraph> RMatBFS(RMat);
+  TIntV NIdV1, NIdV2;
+  RMatBFS.DoBfsMP(0, true, true);
+  RMatBFS.GetVisitedNIdV(NIdV1);
+  RMatBFS.DoBfsMP(0, true, true);
+  RMatBFS.GetVisitedNIdV(NIdV2);
+  EXPECT_TRUE(NIdV1 == NIdV2);
+}
+
+// Compare the hop counts of the multi-source BFS to single-source BFS
+template <class PGraph>
+void TestMsBfs(const PGraph& G, const int& Srcs) {
+  TIntV NIdV, SrcNIdV;
+  G->GetNIdV(NIdV);
+  for (int i = 0; i < Srcs; i++) {
+    SrcNIdV.Add(NIdV[(i * 7919) % NIdV.Len()]);
+  }
+  TIntPrV HopCntV;
+  for (int IsDir = 0; IsDir < 2; IsDir++) {
+    TVec<TIntV> HopCntVV;
+    GetNodesAtHopsV(G, SrcNIdV, HopCntVV, IsDir == 1);
+    EXPECT_EQ(Srcs, HopCntVV.Len());
+    for (int i = 0; i < Srcs; i++) {
+      GetNodesAtHops(G, SrcNIdV[i], HopCntV, IsDir == 1);
+      EXPECT_EQ(HopCntV.Len(), HopCntVV[i].Len());
+      for (int Hop = 0; Hop < TMath::Mn(HopCntV.Len(), HopCntVV[i].Len()); Hop++) {
+        EXPECT_EQ(HopCntV[Hop].Val2, HopCntVV[i][Hop]);
+      }
+    }
+  }
+  // in-links only
+  TBreathFS<PGraph> BFS(G);
+  TVec<TIntV> HopCntVV;
+  TIntV CntV;
+  BFS.DoMsBfs(SrcNIdV, false, true, HopCntVV);
+  for (int i = 0; i < Srcs; i++) {
+    BFS.DoBfsMP(SrcNIdV[i], false, true);
+    BFS.GetHopCntV(CntV);
+    EXPECT_EQ(CntV, HopCntVV[i]);
+  }
+}
+
+// Test the multi-source BFS and the centrality measures based on it
+TEST(BfsDfsTest, DoMsBfs) {
+  TestMsBfs(GenRndGnm<PUNGraph>(2000, 3000, false), 300);
+  TestMsBfs(GenRndGnm<PNGraph>(2000, 6000, true), 300);
+  TestMsBfs(GenRndGnm<PNEANet>(500, 1500, true), 64);
+  TestMsBfs(GenGrid<PUNGraph>(30, 30, false), 70);
+  PNGraph RMat = GenRMat(1 << 12, 1 << 15, 0.57, 0.19, 0.19);
+  TestMsBfs(RMat, 600);
+  TestMsBfs(TNCsrGraph::New(RMat), 100);
+
+  // sparse node IDs and repeated sources
+  PNGraph G = TNGraph::New();
+  for (int e = 0; e < 2000; e++) {
+    const int SrcNId = TInt::Rnd.GetUniDevInt(500) * 100003, DstNId = TInt::Rnd.GetUniDevInt(500) * 100003;
+    if (! G->IsNode(SrcNId)) { G->AddNode(SrcNId); }
+    if (! G->IsNode(DstNId)) { G->AddNode(DstNId); }
+    G->AddEdge(SrcNId, DstNId);
+  }
+  TestMsBfs(G, G->GetNodes() + 10);
+
+  // farness and closeness of all nodes
+  PUNGraph UG = GenRndGnm<PUNGraph>(1000, 1500, false);
+  TIntFltH FarH, CloseH;
+  GetFarnessCentr(UG, FarH);
+  GetClosenessCentr(UG, CloseH, false);
+  EXPECT_EQ(UG->GetNodes(), FarH.Len());
+  EXPECT_EQ(UG->GetNodes(), CloseH.Len());
+  TIntH NIdDistH;
+  for (TUNGraph::TNodeI NI = UG->BegNI(); NI < UG->EndNI(); NI++) {
+    GetShortPath(UG, NI.GetId(), NIdDistH);
+    double SumDist = 0;
+    for (int i = 0; i < NIdDistH.Len(); i++) { SumDist += NIdDistH[i]; }
+    const double Farness = NIdDistH.Len() > 1 ? SumDist / (NIdDistH.Len()-1) * (UG->GetNodes()-1) / (NIdDistH.Len()-1) : 0.0;
+    EXPECT_NEAR(Farness, FarH.GetDat(NI.GetId()), EPSILON);
+    EXPECT_NEAR(GetFarnessCentr(UG, NI.GetId()), FarH.GetDat(NI.GetId()), EPSILON);
+    EXPECT_NEAR(GetClosenessCentr(UG, NI.GetId(), false), CloseH.GetDat(NI.GetId()), EPSILON);
+  }
+}
@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Exact node betweenness from the number of shortest paths between all pairs of nodes,
+// on the same scale as TSnap::GetBetweennessCentr()
+void GetExactBtw(const PNGraph& Graph, const bool& IsDir, TIntFltH& NIdBtwH) {
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  const int Nodes = NIdV.Len();
+  TVec<TIntV> DistVV(Nodes);
+  TVec<TFltV> SigmaVV(Nodes);
+  for (int s = 0; s < Nodes; s++) {
+    TIntH NIdDistH;
+    TSnap::GetShortPath(Graph, NIdV[s], NIdDistH, IsDir);
+    DistVV[s].Gen(Nodes);  DistVV[s].PutAll(-1);
+    SigmaVV[s].Gen(Nodes);
+    TIntPrV DistNIdxV;
+    for (int t = 0; t < Nodes; t++) {
+      if (NIdDistH.IsKey(NIdV[t])) {
+        DistVV[s][t] = NIdDistH.GetDat(NIdV[t]);
+        DistNIdxV.Add(TIntPr(DistVV[s][t], t));
+      }
+    }
+    DistNIdxV.Sort();
+    SigmaVV[s][s] = 1;
+    for (int i = 1; i < DistNIdxV.Len(); i++) {
+      const int t = DistNIdxV[i].Val2;
+      for (int u = 0; u < Nodes; u++) {
+        const bool IsNbr = Graph->IsEdge(NIdV[u], NIdV[t]) || (! IsDir && Graph->IsEdge(NIdV[t], NIdV[u]));
+        if (IsNbr && DistVV[s][u] >= 0 && DistVV[s][u] + 1 == DistVV[s][t]) {
+          SigmaVV[s][t] += SigmaVV[s][u]; }
+      }
+    }
+  }
+  NIdBtwH.Clr();
+  for (int v = 0; v < Nodes; v++) {
+    double Btw = 0;
+    for (int s = 0; s < Nodes; s++) {
+      for (int t = 0; t < Nodes; t++) {
+        if (s == v || t == v || s == t || DistVV[s][v] < 0 || DistVV[v][t] < 0) { continue; }
+        if (DistVV[s][v] + DistVV[v][t] == DistVV[s][t]) {
+          Btw += SigmaVV[s][v] * SigmaVV[v][t] / SigmaVV[s][t]; }
+      }
+    }
+    NIdBtwH.AddDat(NIdV[v], Btw / 2.0);
+  }
+}
+
+// Exact betweenness of a path, a star and a cycle
+TEST(CentrTest, Betweenness) {
+  PUNGraph Path = TUNGraph::New();
+  for (int i = 0; i < 5; i++) { Path->AddNode(i); }
+  for (int i = 0; i < 4; i++) { Path->AddEdge(i, i+1); }
+  TIntFltH NIdBtwH;
+  TIntPrFltH EdgeBtwH;
+  TSnap::GetBetweennessCentr(Path, NIdBtwH, EdgeBtwH);
+  EXPECT_EQ(5, NIdBtwH.Len());
+  EXPECT_DOUBLE_EQ(0.0, NIdBtwH.GetDat(0));
+  EXPECT_DOUBLE_EQ(3.0, NIdBtwH.GetDat(1));
+  EXPECT_DOUBLE_EQ(4.0, NIdBtwH.GetDat(2));
+  EXPECT_DOUBLE_EQ(3.0, NIdBtwH.GetDat(3));
+  // edges are counted once for every source
+  EXPECT_EQ(4, EdgeBtwH.Len());
+  EXPECT_DOUBLE_EQ(8.0, EdgeBtwH.GetDat(TIntPr(0, 1)));
+  EXPECT_DOUBLE_EQ(12.0, EdgeBtwH.GetDat(TIntPr(1, 2)));
+
+  PUNGraph Star = TSnap::GenStar<PUNGraph>(10, false);
+  TSnap::GetBetweennessCentr(Star, NIdBtwH);
+  EXPECT_DOUBLE_EQ(36.0, NIdBtwH.GetDat(0));
+  EXPECT_DOUBLE_EQ(0.0, NIdBtwH.GetDat(1));
+
+  // two shortest paths between opposite nodes of an even cycle
+  PUNGraph Cycle = TSnap::GenCircle<PUNGraph>(6, 1, false);
+  TSnap::GetBetweennessCentr(Cycle, NIdBtwH);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_DOUBLE_EQ(2.0, NIdBtwH.GetDat(i));
+  }
+}
+
+// Compare to betweenness computed from all pairs shortest paths
+TEST(CentrTest, BetweennessRnd) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(60, 150, true, TInt::Rnd);
+  for (int IsDir = 0; IsDir < 2; IsDir++) {
+    TIntFltH ExactH, NIdBtwH;
+    GetExactBtw(Graph, IsDir == 1, ExactH);
+    TSnap::GetBetweennessCentr(Graph, NIdBtwH, 1.0, IsDir == 1);
+    EXPECT_EQ(ExactH.Len(), NIdBtwH.Len());
+    for (int i = 0; i < ExactH.Len(); i++) {
+      EXPECT_NEAR(ExactH[i], NIdBtwH.GetDat(ExactH.GetKey(i)), 1e-6);
+    }
+  }
+  // edge betweenness over all edges equals the sum of all shortest path lengths
+  PUNGraph UGraph = TSnap::ConvertGraph<PUNGraph>(Graph);
+  TIntFltH NIdBtwH;
+  TIntPrFltH EdgeBtwH;
+  TSnap::GetBetweennessCentr(UGraph, NIdBtwH, EdgeBtwH);
+  double EdgeSum = 0, PathLenSum = 0;
+  for (int i = 0; i < EdgeBtwH.Len(); i++) { EdgeSum += EdgeBtwH[i]; }
+  for (TUNGraph::TNodeI NI = UGraph->BegNI(); NI < UGraph->EndNI(); NI++) {
+    TIntH NIdDistH;
+    TSnap::GetShortPath(UGraph, NI.GetId(), NIdDistH);
+    for (int i = 0; i < NIdDistH.Len(); i++) { PathLenSum += NIdDistH[i]; }
+  }
+  EXPECT_NEAR(PathLenSum, EdgeSum, 1e-6);
+}
+
+// Weighted betweenness uses Dijkstra's algorithm
+TEST(CentrTest, WeightedBetweenness) {
+  PNEANet Net = TNEANet::New();
+  for (int i = 0; i < 4; i++) { Net->AddNode(i); }
+  TFltV WgtV;
+  // the direct edge 0-3 is longer than the path over 1 and 2
+  Net->AddEdge(0, 1, 0);  WgtV.Add(1.0);
+  Net->AddEdge(1, 2, 1);  WgtV.Add(1.5);
+  Net->AddEdge(2, 3, 2);  WgtV.Add(0.5);
+  Net->AddEdge(0, 3, 3);  WgtV.Add(5.0);
+  TIntFltH NIdBtwH;
+  TIntPrFltH EdgeBtwH;
+  TSnap::GetWeightedBetweennessCentr(Net, NIdBtwH, EdgeBtwH, WgtV, 1.0, false);
+  EXPECT_DOUBLE_EQ(0.0, NIdBtwH.GetDat(0));
+  EXPECT_DOUBLE_EQ(2.0, NIdBtwH.GetDat(1));
+  EXPECT_DOUBLE_EQ(2.0, NIdBtwH.GetDat(2));
+  EXPECT_DOUBLE_EQ(0.0, EdgeBtwH.GetDat(TIntPr(0, 3)));
+  // directed: paths 0-2 and 0-3 go over 1, paths 0-3 and 1-3 over 2
+  TSnap::GetWeightedBetweennessCentr(Net, NIdBtwH, WgtV, 1.0, true);
+  EXPECT_DOUBLE_EQ(1.0, NIdBtwH.GetDat(1));
+  EXPECT_DOUBLE_EQ(1.0, NIdBtwH.GetDat(2));
+  // zero weights are rejected with an exception
+  TFltV ZeroWgtV(WgtV);
+  ZeroWgtV[1] = 0.0;
+  EXPECT_ANY_THROW(TSnap::GetWeightedBetweennessCentr(Net, NIdBtwH, ZeroWgtV, 1.0, false));
+  EXPECT_ANY_THROW(TSnap::GetWeightedBetweennessCentrApprox(Net, NIdBtwH, ZeroWgtV));
+
+  // with unit weights the values match the unweighted betweenness
+  PNEANet RndNet = TSnap::GenRndGnm<PNEANet>(80, 240, true, TInt::Rnd);
+  TFltV UnitV(RndNet->GetMxEId());
+  UnitV.PutAll(1.0);
+  TIntFltH BtwH;
+  TSnap::GetBetweennessCentr(RndNet, BtwH, 1.0, false);
+  TSnap::GetWeightedBetweennessCentr(RndNet, NIdBtwH, UnitV, 1.0, false);
+  for (int i = 0; i < BtwH.Len(); i++) {
+    EXPECT_NEAR(BtwH[i], NIdBtwH.GetDat(BtwH.GetKey(i)), 1e-6);
+  }
+}
+
+// Adaptive sampling must be within Eps of the exact normalized betweenness
+TEST(CentrTest, BetweennessApprox) {
+  const double Eps = 0.02;
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(300, 900, false, TInt::Rnd);
+  const double Pairs = 0.5 * Graph->GetNodes() * (Graph->GetNodes()-1);
+  TIntFltH ExactH, ApproxH;
+  TSnap::GetBetweennessCentr(Graph, ExactH);
+  const int Samples = TSnap::GetBetweennessCentrApprox(Graph, ApproxH, Eps, 0.1, false, 1);
+  EXPECT_LT(0, Samples);
+  EXPECT_EQ(ExactH.Len(), ApproxH.Len());
+  for (int i = 0; i < ExactH.Len(); i++) {
+    EXPECT_NEAR(ExactH[i] / Pairs, ApproxH.GetDat(ExactH.GetKey(i)) / Pairs, Eps);
+  }
+
+  PNEANet Net = TSnap::ConvertGraph<PNEANet>(Graph);
+  TFltV WgtV(Net->GetMxEId());
+  for (int e = 0; e < WgtV.Len(); e++) { WgtV[e] = 1.0 + e % 3; }
+  TSnap::GetWeightedBetweennessCentr(Net, ExactH, WgtV, 1.0, false);
+  TSnap::GetWeightedBetweennessCentrApprox(Net, ApproxH, WgtV, Eps, 0.1, false, 1);
+  for (int i = 0; i < ExactH.Len(); i++) {
+    EXPECT_NEAR(ExactH[i] / Pairs, ApproxH.GetDat(ExactH.GetKey(i)) / Pairs, Eps);
+  }
+}
+
+// The pull engine must match the reference implementation, the other modes converge to the same ranks
+TEST(CentrTest, PageRank) {
+  // few edges per node, so that many nodes have no out-edges
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(500, 800, true, TInt::Rnd);
+  TIntFltH RefH, PRankH;
+  TSnap::GetPageRank_v1(Graph, RefH);
+  TSnap::GetPageRank(Graph, PRankH);
+  ASSERT_EQ(RefH.Len(), PRankH.Len());
+  for (int i = 0; i < RefH.Len(); i++) {
+    EXPECT_EQ(RefH.GetKey(i), PRankH.GetKey(i));
+    EXPECT_NEAR(RefH[i], PRankH[i], 1e-12);
+  }
+
+  TFltV ResidualV;
+  TSnap::GetPageRank(Graph, RefH, prmPull, ResidualV, 0.85, 1e-12, 1000);
+  const TPageRankMode Modes[] = { prmPull, prmGaussSeidel, prmPush };
+  TIntV ItersV;
+  for (int m = 0; m < 3; m++) {
+    const int Iters = TSnap::GetPageRank(Graph, PRankH, Modes[m], ResidualV, 0.85, 1e-9, 1000);
+    ItersV.Add(Iters);
+    EXPECT_EQ(Iters, ResidualV.Len());
+    EXPECT_GT(1e-9, ResidualV.Last());
+    double Sum = 0;
+    for (int i = 0; i < RefH.Len(); i++) {
+      EXPECT_NEAR(RefH[i], PRankH.GetDat(RefH.GetKey(i)), 1e-8);
+      Sum += PRankH[i];
+    }
+    EXPECT_NEAR(1.0, Sum, 1e-9);
+  }
+  // Gauss-Seidel needs fewer sweeps than the power iteration
+  EXPECT_GT(ItersV[0], ItersV[1]);
+
+  // undirected graphs follow every edge in both directions
+  PUNGraph UGraph = TSnap::GenRndGnm<PUNGraph>(300, 900, false, TInt::Rnd);
+  TSnap::GetPageRank_v1(UGraph, RefH);
+  for (int m = 0; m < 3; m++) {
+    TSnap::GetPageRank(UGraph, PRankH, Modes[m], ResidualV, 0.85, 1e-10, 1000);
+    for (int i = 0; i < RefH.Len(); i++) {
+      EXPECT_NEAR(RefH[i], PRankH.GetDat(RefH.GetKey(i)), 1e-4);
+    }
+  }
+
+  // every node of a cycle has the same rank
+  PNGraph Cycle = TSnap::GenCircle<PNGraph>(10, 1, true);
+  TSnap::GetPageRank(Cycle, PRankH, prmPush, ResidualV);
+  for (int i = 0; i < PRankH.Len(); i++) {
+    EXPECT_NEAR(0.1, PRankH[i], 1e-6);
+  }
+  TSnap::GetPageRank(TNGraph::New(), PRankH);
+  EXPECT_EQ(0, PRankH.Len());
+
+  // node ids far apart do not change the ranks
+  PNGraph SparseGraph = TNGraph::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) { SparseGraph->AddNode(NI.GetId() * 1000003); }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    SparseGraph->AddEdge(EI.GetSrcNId() * 1000003, EI.GetDstNId() * 1000003); }
+  TSnap::GetPageRank(Graph, RefH);
+  TSnap::GetPageRank(SparseGraph, PRankH);
+  ASSERT_EQ(RefH.Len(), PRankH.Len());
+  for (int i = 0; i < RefH.Len(); i++) {
+    EXPECT_NEAR(RefH[i], PRankH.GetDat(RefH.GetKey(i) * 1000003), 1e-12);
+  }
+}
+
+TEST(CentrTest, WeightedPageRank) {
+  PNEANet Net = TSnap::GenRndGnm<PNEANet>(300, 1200, true, TInt::Rnd);
+  TIntFltH RefH, PRankH;
+  EXPECT_EQ(-1, TSnap::GetWeightedPageRank(Net, PRankH, "Weight"));
+  // equal weights give the unweighted ranks
+  for (TNEANet::TEdgeI EI = Net->BegEI(); EI < Net->EndEI(); EI++) {
+    Net->AddFltAttrDatE(EI, 2.0, "Weight"); }
+  TSnap::GetPageRank(Net, RefH);
+  EXPECT_EQ(0, TSnap::GetWeightedPageRank(Net, PRankH, "Weight"));
+  for (int i = 0; i < RefH.Len(); i++) {
+    EXPECT_NEAR(RefH[i], PRankH[i], 1e-12);
+  }
+  // a parallel edge counts like an edge with twice the weight
+  PNEANet Net2 = TNEANet::New();
+  for (int n = 0; n < 3; n++) { Net2->AddNode(n); }
+  Net2->AddEdge(0, 1);  Net2->AddEdge(0, 1);  Net2->AddEdge(0, 2);
+  Net2->AddEdge(1, 0);  Net2->AddEdge(2, 0);
+  PNEANet Net3 = TNEANet::New();
+  for (int n = 0; n < 3; n++) { Net3->AddNode(n); }
+  Net3->AddEdge(0, 1);  Net3->AddEdge(0, 2);  Net3->AddEdge(1, 0);  Net3->AddEdge(2, 0);
+  for (TNEANet::TEdgeI EI = Net2->BegEI(); EI < Net2->EndEI(); EI++) {
+    Net2->AddFltAttrDatE(EI, 1.0, "Weight"); }
+  for (TNEANet::TEdgeI EI = Net3->BegEI(); EI < Net3->EndEI(); EI++) {
+    Net3->AddFltAttrDatE(EI, EI.GetSrcNId() == 0 && EI.GetDstNId() == 1 ? 2.0 : 1.0, "Weight"); }
+  TFltV ResidualV;
+  const TPageRankMode Modes[] = { prmPull, prmGaussSeidel, prmPush };
+  TSnap::GetWeightedPageRank(Net3, RefH, "Weight", prmPull, ResidualV, 0.85, 1e-12, 1000);
+  EXPECT_GT(RefH.GetDat(1), RefH.GetDat(2));
+  for (int m = 0; m < 3; m++) {
+    const int Iters = TSnap::GetWeightedPageRank(Net2, PRankH, "Weight", Modes[m], ResidualV, 0.85, 1e-10, 1000);
+    EXPECT_EQ(Iters, ResidualV.Len());
+    for (int n = 0; n < 3; n++) {
+      EXPECT_NEAR(RefH.GetDat(n), PRankH.GetDat(n), 1e-8);
+    }
+  }
+
+  // node ids far apart do not change the ranks
+  PNEANet SparseNet = TNEANet::New();
+  for (TNEANet::TNodeI NI = Net3->BegNI(); NI < Net3->EndNI(); NI++) { SparseNet->AddNode(NI.GetId() * 1000003); }
+  for (TNEANet::TEdgeI EI = Net3->BegEI(); EI < Net3->EndEI(); EI++) {
+    const int EId = SparseNet->AddEdge(EI.GetSrcNId() * 1000003, EI.GetDstNId() * 1000003);
+    SparseNet->AddFltAttrDatE(EId, Net3->GetFltAttrDatE(EI.GetId(), "Weight"), "Weight");
+  }
+  TSnap::GetWeightedPageRank(SparseNet, PRankH, "Weight", prmPull, ResidualV, 0.85, 1e-12, 1000);
+  for (int n = 0; n < 3; n++) {
+    EXPECT_NEAR(RefH.GetDat(n), PRankH.GetDat(n * 1000003), 1e-12);
+  }
+}
+
+TEST(CentrTest, Hits) {
+  // all edges go out of node 0
+  PNGraph Star = TSnap::GenStar<PNGraph>(5, true);
+  TIntFltH HubH, AuthH;
+  TSnap::GetHits(Star, HubH, AuthH);
+  EXPECT_NEAR(1.0, HubH.GetDat(0), 1e-12);
+  EXPECT_NEAR(0.0, AuthH.GetDat(0), 1e-12);
+  for (int n = 1; n < 5; n++) {
+    EXPECT_NEAR(0.0, HubH.GetDat(n), 1e-12);
+    EXPECT_NEAR(0.5, AuthH.GetDat(n), 1e-12);
+  }
+  // scores have L2 norm 1 and authorities sum the hub scores of the in-neighbors
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 1000, true, TInt::Rnd);
+  TSnap::GetHits(Graph, HubH, AuthH, 100);
+  double HubNorm = 0, AuthNorm = 0;
+  for (int i = 0; i < HubH.Len(); i++) {
+    HubNorm += HubH[i] * HubH[i];  AuthNorm += AuthH[i] * AuthH[i]; }
+  EXPECT_NEAR(1.0, HubNorm, 1e-9);
+  EXPECT_NEAR(1.0, AuthNorm, 1e-9);
+  TFltV SumV;
+  double Norm = 0;
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    double Sum = 0;
+    for (int e = 0; e < NI.GetInDeg(); e++) { Sum += HubH.GetDat(NI.GetInNId(e)); }
+    SumV.Add(Sum);
+    Norm += Sum * Sum;
+  }
+  for (int i = 0; i < SumV.Len(); i++) {
+    EXPECT_NEAR(SumV[i] / sqrt(Norm), AuthH[i], 1e-6);
+  }
+#ifdef USE_OPENMP
+  TIntFltH HubH2, AuthH2;
+  TSnap::GetHitsMP(Graph, HubH2, AuthH2, 100);
+  for (int i = 0; i < HubH.Len(); i++) {
+    EXPECT_DOUBLE_EQ(HubH[i], HubH2[i]);
+    EXPECT_DOUBLE_EQ(AuthH[i], AuthH2[i]);
+  }
+#endif
+}
@@ -305,3 +305,127 @@ TEST(CnComTest, CompleteGraph) {
   Get1CnCom(G, Cn1ComV);
   EXPECT_TRUE(Cn1ComV.Len() == 0);
 }
+
+// Reference components: Tarjan's algorithm for SCCs, one BFS per component for WCCs
+template <class PGraph>
+void GetRefCnComs(const PGraph& G, TCnComV& WccV, TCnComV& SccV) {
+  TIntSet SeenSet;
+  WccV.Clr();
+  for (typename PGraph::TObj::TNodeI NI = G->BegNI(); NI < G->EndNI(); NI++) {
+    if (SeenSet.IsKey(NI.GetId())) { continue; }
+    TIntV NIdV;
+    GetNodeWcc(G, NI.GetId(), NIdV);
+    for (int i = 0; i < NIdV.Len(); i++) { SeenSet.AddKey(NIdV[i]); }
+    NIdV.Sort();
+    WccV.Add(TCnCom(NIdV));
+  }
+  WccV.Sort(false);
+  TSccVisitor<PGraph, false> Visitor(G);
+  TCnCom::GetDfsVisitor(G, Visitor);
+  SccV = Visitor.CnComV;
+  for (int c = 0; c < SccV.Len(); c++) { SccV[c].Sort(); }
+  SccV.Sort(false);
+}
+
+// Parallel WCCs and SCCs give the same components as the sequential algorithms
+TEST(CnComTest, ParallelCnComs) {
+  TRnd Rnd(0);
+  for (int t = 0; t < 4; t++) {
+    // sparse graphs with many small components, isolated nodes, self-loops and node ids that are far apart
+    PNGraph G = GenRndGnm<PNGraph>(2000, 1500 + 1000*t, true, Rnd);
+    if (t % 2 == 1) {
+      PNGraph G2 = TNGraph::New();
+      for (TNGraph::TNodeI NI = G->BegNI(); NI < G->EndNI(); NI++) { G2->AddNode(NI.GetId() * 10007); }
+      for (TNGraph::TEdgeI EI = G->BegEI(); EI < G->EndEI(); EI++) {
+        G2->AddEdge(EI.GetSrcNId() * 10007, EI.GetDstNId() * 10007); }
+      G = G2;
+    }
+    for (int i = 0; i < 20; i++) {
+      const int NId = G->GetRndNId(Rnd);
+      G->AddEdge(NId, NId);
+    }
+    TCnComV RefWccV, RefSccV, WccV, SccV;
+    GetRefCnComs(G, RefWccV, RefSccV);
+    GetWccs(G, WccV);
+    GetSccs(G, SccV);
+    EXPECT_TRUE(RefWccV == WccV);
+    EXPECT_TRUE(RefSccV == SccV);
+    // the undirected version has the same weakly connected components
+    PUNGraph UG = ConvertGraph<PUNGraph>(G);
+    GetWccs(UG, WccV);
+    EXPECT_TRUE(RefWccV == WccV);
+    GetSccs(UG, SccV);
+    EXPECT_TRUE(RefWccV == SccV);
+
+    TIntPrV SzCntV;
+    GetSccSzCnt(G, SzCntV);
+    int Comps = 0, Nodes = 0;
+    for (int i = 0; i < SzCntV.Len(); i++) {
+      Comps += SzCntV[i].Val2;  Nodes += SzCntV[i].Val1 * SzCntV[i].Val2; }
+    EXPECT_EQ(RefSccV.Len(), Comps);
+    EXPECT_EQ(G->GetNodes(), Nodes);
+    EXPECT_EQ(RefSccV[0].Len(), SzCntV.Last().Val1);
+  }
+  // several large strongly connected components, all but one are found by coloring
+  PNGraph G = TNGraph::New();
+  for (int b = 0; b < 5; b++) {
+    PNGraph Block = GenRndGnm<PNGraph>(200, 800, true, Rnd);
+    for (int n = 0; n < 200; n++) { G->AddNode(b*200 + n); }
+    for (TNGraph::TEdgeI EI = Block->BegEI(); EI < Block->EndEI(); EI++) {
+      G->AddEdge(b*200 + EI.GetSrcNId(), b*200 + EI.GetDstNId()); }
+    if (b > 0) { G->AddEdge((b-1)*200, b*200); }
+  }
+  TCnComV RefWccV, RefSccV, SccV;
+  GetRefCnComs(G, RefWccV, RefSccV);
+  GetSccs(G, SccV);
+  EXPECT_TRUE(RefSccV == SccV);
+}
+
+// A chain of 2-cycles linked from higher to lower node ids, coloring removes a single component per round
+TEST(CnComTest, SccChain) {
+  const int Pairs = 5000;
+  PNGraph G = TNGraph::New();
+  for (int n = 0; n < 2*Pairs; n++) { G->AddNode(n); }
+  for (int k = 0; k < Pairs; k++) {
+    G->AddEdge(2*k, 2*k+1);
+    G->AddEdge(2*k+1, 2*k);
+    if (k+1 < Pairs) { G->AddEdge(2*(k+1), 2*k); }
+  }
+  TCnComV RefWccV, RefSccV, SccV;
+  GetRefCnComs(G, RefWccV, RefSccV);
+  GetSccs(G, SccV);
+  EXPECT_EQ(Pairs, SccV.Len());
+  EXPECT_TRUE(RefSccV == SccV);
+}
+
+// Weakly connected components of an edge stream
+TEST(CnComTest, StreamWcc) {
+  PNGraph G = GenRndGnm<PNGraph>(3000, 2500, true, TInt::Rnd);
+  TCnComV WccV, StreamWccV;
+  GetWccs(G, WccV);
+  TIntPrV SzCntV, StreamSzCntV;
+  GetWccSzCnt(G, SzCntV);
+
+  TStreamWcc StreamWcc;
+  for (TNGraph::TNodeI NI = G->BegNI(); NI < G->EndNI(); NI++) { StreamWcc.AddNode(NI.GetId()); }
+  for (TNGraph::TEdgeI EI = G->BegEI(); EI < G->EndEI(); EI++) {
+    StreamWcc.AddEdge(EI.GetSrcNId(), EI.GetDstNId()); }
+  EXPECT_EQ(G->GetNodes(), StreamWcc.GetNodes());
+  EXPECT_EQ(WccV.Len(), StreamWcc.GetWccCnt());
+  StreamWcc.GetWccs(StreamWccV);
+  EXPECT_TRUE(WccV == StreamWccV);
+  StreamWcc.GetWccSzCnt(StreamSzCntV);
+  EXPECT_TRUE(SzCntV == StreamSzCntV);
+  EXPECT_TRUE(StreamWcc.IsSameWcc(WccV[0][0], WccV[0].NIdV.Last()));
+  EXPECT_FALSE(StreamWcc.IsSameWcc(WccV[0][0], WccV.Last()[0]));
+
+  // the edge list file only contains nodes with edges
+  const TStr FNm = TStr::Fmt("%s/stream.txt", DIRNAME);
+  SaveEdgeList(G, FNm);
+  PNGraph G2 = LoadEdgeList<PNGraph>(FNm);
+  GetWccs(G2, WccV);
+  TStreamWcc FileWcc;
+  FileWcc.LoadEdgeList(FNm);
+  FileWcc.GetWccs(StreamWccV);
+  EXPECT_TRUE(WccV == StreamWccV);
+}
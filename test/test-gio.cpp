@@ -74,6 +74,84 @@ TEST(GIOTest, SaveLoadEdgeList) {
  
 }
 
+// Loads an edge list line by line with TSsParser, the way LoadEdgeList() worked before the parallel loader
+template <class PGraph>
+PGraph LoadEdgeListSs(TSsParser& Ss, const int& SrcColId, const int& DstColId) {
+  PGraph Graph = PGraph::TObj::New();
+  int SrcNId, DstNId;
+  while (Ss.Next()) {
+    if (! Ss.GetInt(SrcColId, SrcNId) || ! Ss.GetInt(DstColId, DstNId)) { continue; }
+    if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
+    if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
+    Graph->AddEdge(SrcNId, DstNId);
+  }
+  return Graph;
+}
+
+// Checks that the graphs have the same nodes and edges in the same order
+template <class PGraph>
+void CheckIdenticalGraphs(const PGraph& Graph1, const PGraph& Graph2) {
+  EXPECT_EQ(Graph1->GetNodes(), Graph2->GetNodes());
+  EXPECT_EQ(Graph1->GetEdges(), Graph2->GetEdges());
+  EXPECT_EQ(Graph1->GetMxNId(), Graph2->GetMxNId());
+  typename PGraph::TObj::TNodeI NI2 = Graph2->BegNI();
+  for (typename PGraph::TObj::TNodeI NI1 = Graph1->BegNI(); NI1 < Graph1->EndNI() && NI2 < Graph2->EndNI(); NI1++, NI2++) {
+    EXPECT_EQ(NI1.GetId(), NI2.GetId());
+    ASSERT_EQ(NI1.GetOutDeg(), NI2.GetOutDeg());
+    ASSERT_EQ(NI1.GetInDeg(), NI2.GetInDeg());
+    for (int e = 0; e < NI1.GetOutDeg(); e++) { EXPECT_EQ(NI1.GetOutNId(e), NI2.GetOutNId(e)); }
+    for (int e = 0; e < NI1.GetInDeg(); e++) { EXPECT_EQ(NI1.GetInNId(e), NI2.GetInNId(e)); }
+  }
+  typename PGraph::TObj::TEdgeI EI2 = Graph2->BegEI();
+  for (typename PGraph::TObj::TEdgeI EI1 = Graph1->BegEI(); EI1 < Graph1->EndEI() && EI2 < Graph2->EndEI(); EI1++, EI2++) {
+    EXPECT_EQ(EI1.GetId(), EI2.GetId());
+    EXPECT_EQ(EI1.GetSrcNId(), EI2.GetSrcNId());
+    EXPECT_EQ(EI1.GetDstNId(), EI2.GetDstNId());
+  }
+}
+
+template <class PGraph>
+void TestEdgeListParallel(const char* FName) {
+  TSsParser Ss(FName, ssfWhiteSep, true, true, true);
+  CheckIdenticalGraphs(LoadEdgeListSs<PGraph>(Ss, 1, 3), LoadEdgeList<PGraph>(FName, 1, 3));
+  TSsParser SsTab(FName, '\t');
+  CheckIdenticalGraphs(LoadEdgeListSs<PGraph>(SsTab, 1, 2), LoadEdgeList<PGraph>(FName, 1, 2, '\t'));
+}
+
+// Tests that the parallel edge list loader gives the same graphs as line by line parsing
+TEST(GIOTest, LoadEdgeListParallel) {
+  const char *FName = "test.edgelist.dat";
+  {
+    TFOut FOut(FName);
+    FOut.PutStr("# comment\n\n");
+    FOut.PutStr("x\t5\t7\t8\r\n");
+    FOut.PutStr("  y  -3\t-3 3 \n");
+    FOut.PutStr("z\t1\t\t2\n");
+    FOut.PutStr("z\t 4\t2 \t4\n");
+    FOut.PutStr("z\t+4\t3\t4\n");
+    FOut.PutStr("z\t4x\t3\t4\n");
+    FOut.PutStr("#z\t8\t9\t10\n");
+    FOut.PutStr("z 12\n");
+    TRnd Rnd(1);
+    // enough lines to split the file into several chunks
+    for (int e = 0; e < 200000; e++) {
+      FOut.PutStr(TStr::Fmt("%d\t%d\t%d\t%d\n", e % 7, Rnd.GetUniDevInt(20000), Rnd.GetUniDevInt(20000), Rnd.GetUniDevInt(20000)));
+    }
+    FOut.PutStr("w\t100000\t100001\t100000\r");
+  }
+  TestEdgeListParallel<PUNGraph>(FName);
+  TestEdgeListParallel<PNGraph>(FName);
+  TestEdgeListParallel<PNEGraph>(FName);
+  TestEdgeListParallel<PNEANet>(FName);
+
+  TIntV SrcNIdV, DstNIdV;
+  LoadEdgeListV(FName, SrcNIdV, DstNIdV, 1, 3);
+  EXPECT_EQ(200004, SrcNIdV.Len());
+  EXPECT_EQ(-3, SrcNIdV[1]);
+  EXPECT_EQ(3, DstNIdV[1]);
+  EXPECT_EQ(100000, DstNIdV.Last());
+}
+
 // Function for testing saving / loading of directed, undirected and multi-graphs, where node names are strings
 template <class PGraph>
 void TestEdgeListStr() {
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// K-core by repeated deletion of the nodes of degree less than K
+template <class PGraph>
+int GetRefKCore(const PGraph& Graph, const int& K, TIntV& NIdV) {
+  TIntH DegH;
+  for (typename PGraph::TObj::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    DegH.AddDat(NI.GetId(), NI.GetDeg()); }
+  int NDel = -1;
+  while (NDel != 0) {
+    NDel = 0;
+    for (int k = DegH.FFirstKeyId(); DegH.FNextKeyId(k); ) {
+      if (DegH[k] >= K) { continue; }
+      const typename PGraph::TObj::TNodeI NI = Graph->GetNI(DegH.GetKey(k));
+      for (int e = 0; e < NI.GetDeg(); e++) {
+        const int nk = DegH.GetKeyId(NI.GetNbrNId(e));
+        if (nk != -1) { DegH[nk] -= 1; }
+      }
+      DegH.DelKeyId(k);
+      NDel++;
+    }
+  }
+  DegH.Defrag();
+  DegH.GetKeyV(NIdV);
+  NIdV.Sort();
+  int Edges = 0;
+  for (int k = 0; k < DegH.Len(); k++) { Edges += DegH[k]; }
+  return Edges / 2;
+}
+
+template <class PGraph>
+void TestKCore(const PGraph& Graph) {
+  TKCore<PGraph> KCore(Graph);
+  TIntIntH NIdCoreH;
+  KCore.GetNodeCoreH(NIdCoreH);
+  EXPECT_EQ(Graph->GetNodes(), NIdCoreH.Len());
+  TIntV RefNIdV;
+  int K = 1;
+  for (; KCore.GetNextCore() > 0; K++) {
+    const int RefEdges = GetRefKCore(Graph, K, RefNIdV);
+    EXPECT_EQ(K, KCore.GetCurK());
+    EXPECT_TRUE(RefNIdV == KCore.GetNIdV());
+    EXPECT_EQ(RefEdges, KCore.GetCoreEdges());
+    for (int i = 0; i < RefNIdV.Len(); i++) {
+      EXPECT_LE(K, KCore.GetNodeCore(RefNIdV[i]));
+      EXPECT_LE(K, NIdCoreH.GetDat(RefNIdV[i]));
+    }
+  }
+  EXPECT_EQ(Graph->Empty() ? -1 : K - 1, KCore.GetMxCore());
+  EXPECT_EQ(0, GetRefKCore(Graph, K, RefNIdV));
+  EXPECT_EQ(0, RefNIdV.Len());
+  // any order can be asked for directly
+  EXPECT_EQ(KCore.GetCoreNodes(2), KCore.GetCoreK(2));
+  GetRefKCore(Graph, 2, RefNIdV);
+  EXPECT_TRUE(RefNIdV == KCore.GetNIdV());
+
+  TIntPrV CoreNodesV, CoreEdgesV;
+  EXPECT_EQ(K, TSnap::GetKCoreNodes(Graph, CoreNodesV));
+  EXPECT_EQ(K, TSnap::GetKCoreEdges(Graph, CoreEdgesV));
+  EXPECT_EQ(K, CoreNodesV.Len());
+  EXPECT_EQ(TIntPr(0, Graph->GetNodes()), CoreNodesV[0]);
+  EXPECT_EQ(TIntPr(0, Graph->GetEdges()), CoreEdgesV[0]);
+  for (int k = 1; k < CoreNodesV.Len(); k++) {
+    const int RefEdges = GetRefKCore(Graph, k, RefNIdV);
+    EXPECT_EQ(TIntPr(k, RefNIdV.Len()), CoreNodesV[k]);
+    EXPECT_EQ(TIntPr(k, RefEdges), CoreEdgesV[k]);
+  }
+}
+
+// Cores of undirected and directed graphs, with self-loops and multi-edges
+TEST(KCoreTest, Cores) {
+  TRnd Rnd(0);
+  TestKCore(TSnap::GenRndGnm<PUNGraph>(500, 2500, false, Rnd));
+  TestKCore(TSnap::GenRMat(1024, 8192, 0.57, 0.19, 0.19, Rnd));
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(400, 2400, true, Rnd);
+  for (int i = 0; i < 50; i++) {
+    const int NId = Graph->GetRndNId(Rnd);
+    Graph->AddEdge(NId, NId);
+  }
+  Graph->AddNode(10000);
+  TestKCore(Graph);
+  PNEANet Net = TSnap::ConvertGraph<PNEANet>(Graph);
+  for (int i = 0; i < 200; i++) {
+    Net->AddEdge(Net->GetRndNId(Rnd), Net->GetRndNId(Rnd)); }
+  TestKCore(Net);
+  TestKCore(TSnap::GenFull<PUNGraph>(30));
+  TestKCore(TUNGraph::New());
+}
+
+// Bucket queue and parallel peeling give the same core numbers
+TEST(KCoreTest, CoreV) {
+  PUNGraph Graph = TSnap::GenRndGnm<PUNGraph>(5000, 40000, false, TInt::Rnd);
+  TVec<TInt64> OffV(Graph->GetNodes()+1);
+  TNIdxMap::TNbrV NbrV;
+  for (int NId = 0; NId < Graph->GetNodes(); NId++) {
+    const TUNGraph::TNodeI NI = Graph->GetNI(NId);
+    for (int e = 0; e < NI.GetDeg(); e++) { NbrV.Add(NI.GetNbrNId(e)); }
+    OffV[NId+1] = NbrV.Len();
+  }
+  TIntV CoreV, CoreMPV;
+  TSnap::TSnapDetail::GetCoreV(OffV, NbrV, CoreV);
+  TSnap::TSnapDetail::GetCoreVMP(OffV, NbrV, CoreMPV);
+  EXPECT_TRUE(CoreV == CoreMPV);
+  TKCore<PUNGraph> KCore(Graph);
+  EXPECT_TRUE(CoreV == KCore.GetCoreV());
+}
+
+TEST(KCoreTest, SparseNIds) {
+  // node ids far apart are mapped by a hash table, the cores do not depend on the ids
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(2000, 10000, true, TInt::Rnd);
+  PNGraph SparseGraph = TNGraph::New();
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) { SparseGraph->AddNode(NI.GetId() * 10007); }
+  for (TNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    SparseGraph->AddEdge(EI.GetSrcNId() * 10007, EI.GetDstNId() * 10007); }
+  TKCore<PNGraph> KCore(Graph), SparseKCore(SparseGraph);
+  EXPECT_TRUE(KCore.GetCoreV() == SparseKCore.GetCoreV());
+  EXPECT_EQ(KCore.GetMxCore(), SparseKCore.GetMxCore());
+  for (int NId = 0; NId < Graph->GetNodes(); NId += 97) {
+    EXPECT_EQ(KCore.GetNodeCore(NId), SparseKCore.GetNodeCore(NId * 10007)); }
+}
@@ -36,3 +36,120 @@ TEST(RandWalkTest, CorrectOnLineGraph) {
     EXPECT_TRUE( relError < 0.2);
   }
 }
+
+// Exact PPR from SrcNId by power iteration, walks restart at SrcNId at dead ends
+void GetExactPpr(const PNGraph& Graph, const double JumpProb, const int SrcNId, TIntFltH& PprH) {
+  TIntFltH WalkH;  // probability to be at a node after a number of steps
+  for (TNGraph::TNodeI NI = Graph->BegNI(); NI < Graph->EndNI(); NI++) {
+    WalkH.AddDat(NI.GetId(), NI.GetId() == SrcNId ? 1.0 : 0.0);
+    PprH.AddDat(NI.GetId(), 0.0);
+  }
+  for (int Step = 0; Step < 200; Step++) {
+    TIntFltH NextH;
+    for (int i = 0; i < WalkH.Len(); i++) {
+      const int NId = WalkH.GetKey(i);
+      PprH.GetDat(NId) += JumpProb * WalkH[i];
+      TNGraph::TNodeI NI = Graph->GetNI(NId);
+      if (NI.GetOutDeg() == 0) {
+        NextH.AddDat(SrcNId) += (1.0 - JumpProb) * WalkH[i];
+      }
+      for (int e = 0; e < NI.GetOutDeg(); e++) {
+        NextH.AddDat(NI.GetOutNId(e)) += (1.0 - JumpProb) * WalkH[i] / NI.GetOutDeg();
+      }
+    }
+    WalkH = NextH;
+  }
+}
+
+TEST(RandWalkTest, BatchOnSmallGraph) {
+  PNGraph Graph = TSnap::LoadEdgeList<PNGraph>("randwalk/test_graph.txt", false);
+  TIntV SrcNIdV, TrgNIdV;
+  TFltV TruePprV, PprV;
+  FILE* TruePprFile = fopen("randwalk/test_pprs.txt", "r");
+  int s, t;
+  float TruePpr;
+  while (fscanf(TruePprFile, "%d %d %f", &s, &t, &TruePpr) == 3) {
+    SrcNIdV.Add(s);  TrgNIdV.Add(t);  TruePprV.Add(TruePpr);
+  }
+  fclose(TruePprFile);
+  TPprBatch<PNGraph> Ppr(Graph, 0.2, 0.03, 0.1, true);
+  Ppr.GetPprV(SrcNIdV, TrgNIdV, PprV);
+  ASSERT_EQ(TruePprV.Len(), PprV.Len());
+  for (int i = 0; i < PprV.Len(); i++) {
+    EXPECT_LT(fabs(PprV[i] - TruePprV[i]) / TruePprV[i], 0.1);
+  }
+  // the second batch reuses the reverse push of the targets, also from the walk index
+  const int Targets = Ppr.GetTrgCacheLen();
+  EXPECT_LT(0, Ppr.BuildWalkIndex());
+  Ppr.GetPprV(SrcNIdV, TrgNIdV, PprV);
+  EXPECT_EQ(Targets, Ppr.GetTrgCacheLen());
+  for (int i = 0; i < PprV.Len(); i++) {
+    EXPECT_LT(fabs(PprV[i] - TruePprV[i]) / TruePprV[i], 0.1);
+  }
+  // a batch with more targets than the cache holds is answered in rounds
+  Ppr.SetMxTrgCache(1);
+  Ppr.GetPprV(SrcNIdV, TrgNIdV, PprV);
+  EXPECT_EQ(1, Ppr.GetTrgCacheLen());
+  for (int i = 0; i < PprV.Len(); i++) {
+    EXPECT_LT(fabs(PprV[i] - TruePprV[i]) / TruePprV[i], 0.1);
+  }
+#ifdef USE_OPENMP
+  // queries may use more threads than there were when the batch was created
+  const int Threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  TPprBatch<PNGraph> Ppr2(Graph, 0.2, 0.03, 0.1, true);
+  omp_set_num_threads(8);
+  Ppr2.BuildWalkIndex();
+  Ppr2.GetPprV(SrcNIdV, TrgNIdV, PprV);
+  TVec<TIntFltKdV> TopVV;
+  Ppr2.GetTopPprV(SrcNIdV, 5, TopVV);
+  omp_set_num_threads(Threads);
+  for (int i = 0; i < PprV.Len(); i++) {
+    EXPECT_LT(fabs(PprV[i] - TruePprV[i]) / TruePprV[i], 0.1);
+  }
+  EXPECT_EQ(SrcNIdV.Len(), TopVV.Len());
+#endif
+}
+
+TEST(RandWalkTest, BatchTopPpr) {
+  // on a line the PPR falls geometrically with the distance from the source
+  PNGraph Line = TNGraph::New();
+  for (int i = 0; i < 100; i++) { Line->AddNode(i); }
+  for (int i = 0; i < 99; i++) { Line->AddEdge(i, i + 1); }
+  TPprBatch<PNGraph> LinePpr(Line, 0.2, 0.01, 0.1, true);
+  TVec<TIntFltKdV> TopVV;
+  LinePpr.GetTopPprV(TIntV::GetV(0, 50), 5, TopVV);
+  ASSERT_EQ(2, TopVV.Len());
+  for (int q = 0; q < 2; q++) {
+    ASSERT_EQ(5, TopVV[q].Len());
+    for (int i = 0; i < 5; i++) {
+      EXPECT_EQ(q * 50 + i, TopVV[q][i].Key);
+      EXPECT_NEAR(0.2 * pow(0.8, i), TopVV[q][i].Dat, 0.02 * pow(0.8, i));
+    }
+  }
+  // top nodes of a random graph, with and without the walk index
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 600, true, TInt::Rnd);
+  TIntV SrcNIdV;
+  for (int i = 0; i < 10; i++) { SrcNIdV.Add(Graph->GetRndNId(TInt::Rnd)); }
+  TPprBatch<PNGraph> Ppr(Graph, 0.15, 0.01, 0.1, true);
+  for (int Index = 0; Index < 2; Index++) {
+    if (Index == 1) { EXPECT_LT(0, Ppr.BuildWalkIndex()); }
+    Ppr.GetTopPprV(SrcNIdV, 10, TopVV);
+    for (int q = 0; q < SrcNIdV.Len(); q++) {
+      TIntFltH ExactH;
+      GetExactPpr(Graph, 0.15, SrcNIdV[q], ExactH);
+      ExactH.SortByDat(false);
+      int Reached = 0;
+      for (int i = 0; i < ExactH.Len(); i++) { Reached += ExactH[i] > 0 ? 1 : 0; }
+      ASSERT_EQ(TMath::Mn(10, Reached), TopVV[q].Len());
+      // the source has the highest PPR
+      EXPECT_EQ(SrcNIdV[q], TopVV[q][0].Key);
+      for (int i = 0; i < TopVV[q].Len(); i++) {
+        const double Exact = ExactH.GetDat(TopVV[q][i].Key);
+        EXPECT_NEAR(Exact, TopVV[q][i].Dat, TMath::Mx(0.1 * Exact, 0.002));
+        // the i-th estimate is close to the i-th highest exact PPR
+        EXPECT_NEAR(ExactH[i], TopVV[q][i].Dat, TMath::Mx(0.1 * ExactH[i], 0.002));
+      }
+    }
+  }
+}
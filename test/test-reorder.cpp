@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "Snap.h"
+
+// Checks that NewGraph is Graph with node ids mapped by NIdMapH to 0..N-1, in the order NIdV
+template <class PGraph>
+void CheckReordered(const PGraph& Graph, const PGraph& NewGraph, const TIntV& NIdV, const TIntIntH& NIdMapH) {
+  ASSERT_EQ(Graph->GetNodes(), NewGraph->GetNodes());
+  ASSERT_EQ(Graph->GetEdges(), NewGraph->GetEdges());
+  ASSERT_EQ(Graph->GetNodes(), NIdV.Len());
+  ASSERT_EQ(Graph->GetNodes(), NIdMapH.Len());
+  int NId = 0;
+  for (typename PGraph::TObj::TNodeI NI = NewGraph->BegNI(); NI < NewGraph->EndNI(); NI++, NId++) {
+    EXPECT_EQ(NId, NI.GetId());
+    EXPECT_EQ(NId, NIdMapH.GetDat(NIdV[NId]));
+    EXPECT_EQ(Graph->GetNI(NIdV[NId]).GetOutDeg(), NI.GetOutDeg());
+  }
+  for (typename PGraph::TObj::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    EXPECT_TRUE(NewGraph->IsEdge(NIdMapH.GetDat(EI.GetSrcNId()), NIdMapH.GetDat(EI.GetDstNId())));
+  }
+}
+
+// Largest difference of the new ids of neighbors
+int GetBandwidth(const PUNGraph& Graph) {
+  int Bandwidth = 0;
+  for (TUNGraph::TEdgeI EI = Graph->BegEI(); EI < Graph->EndEI(); EI++) {
+    Bandwidth = TMath::Mx(Bandwidth, abs(EI.GetSrcNId() - EI.GetDstNId()));
+  }
+  return Bandwidth;
+}
+
+// Every order is a permutation and the copies keep all edges
+TEST(ReorderTest, AllOrders) {
+  PUNGraph UGraph = TSnap::GenRndGnm<PUNGraph>(300, 900, false, TInt::Rnd);
+  UGraph->AddNode(1000);  // isolated node
+  UGraph->AddEdge(5, 5);  // self loop
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(300, 900, true, TInt::Rnd);
+  Graph->AddNode(1000);
+  PNEANet Net = TSnap::ConvertGraph<PNEANet>(Graph);
+  Net->AddEdge(0, 1);  Net->AddEdge(0, 1);  // parallel edges
+  const TNodeOrder Orders[] = { norDegree, norRcm, norBfs, norGorder };
+  for (int o = 0; o < 4; o++) {
+    TIntV NIdV;
+    TIntIntH NIdMapH;
+    TSnap::GetNodeOrder(UGraph, Orders[o], NIdV);
+    PUNGraph NewUGraph = TSnap::ReorderNodes(UGraph, Orders[o], NIdMapH);
+    CheckReordered(UGraph, NewUGraph, NIdV, NIdMapH);
+    TSnap::GetNodeOrder(Graph, Orders[o], NIdV);
+    PNGraph NewGraph = TSnap::ReorderNodes(Graph, Orders[o], NIdMapH);
+    CheckReordered(Graph, NewGraph, NIdV, NIdMapH);
+    TSnap::GetNodeOrder(Net, Orders[o], NIdV);
+    PNEANet NewNet = TSnap::ReorderNodes(Net, Orders[o], NIdMapH);
+    CheckReordered(Net, NewNet, NIdV, NIdMapH);
+    EXPECT_EQ(2, NewNet->GetNI(NIdMapH.GetDat(0)).GetOutDeg() - Graph->GetNI(0).GetOutDeg());
+    PNGraph Empty = TSnap::ReorderNodes(TNGraph::New(), Orders[o], NIdMapH);
+    EXPECT_EQ(0, Empty->GetNodes());
+  }
+}
+
+TEST(ReorderTest, Degree) {
+  PNGraph Graph = TSnap::GenRndGnm<PNGraph>(200, 1000, true, TInt::Rnd);
+  TIntIntH NIdMapH;
+  PNGraph NewGraph = TSnap::ReorderNodes(Graph, norDegree, NIdMapH);
+  for (int n = 1; n < NewGraph->GetNodes(); n++) {
+    EXPECT_GE(NewGraph->GetNI(n-1).GetDeg(), NewGraph->GetNI(n).GetDeg());
+  }
+}
+
+// RCM and BFS recover small bandwidths of a grid and a path with shuffled node ids
+TEST(ReorderTest, Bandwidth) {
+  PUNGraph Grid = TSnap::GenGrid<PUNGraph>(20, 20, false);
+  TIntV PermV;
+  Grid->GetNIdV(PermV);
+  TRnd Rnd(1);
+  PermV.Shuffle(Rnd);
+  TIntIntH NIdMapH;
+  PUNGraph Shuffled = TSnap::ReorderNodes(Grid, PermV, NIdMapH);
+  EXPECT_LT(100, GetBandwidth(Shuffled));
+  EXPECT_GE(21, GetBandwidth(TSnap::ReorderNodes(Shuffled, norRcm, NIdMapH)));
+  EXPECT_GE(40, GetBandwidth(TSnap::ReorderNodes(Shuffled, norBfs, NIdMapH)));
+
+  // RCM starts from an end of the path
+  PUNGraph Path = TUNGraph::New();
+  for (int n = 0; n < 100; n++) { Path->AddNode(n); }
+  for (int n = 0; n < 99; n++) { Path->AddEdge(n, n+1); }
+  Path->GetNIdV(PermV);
+  PermV.Shuffle(Rnd);
+  Shuffled = TSnap::ReorderNodes(Path, PermV, NIdMapH);
+  PUNGraph Rcm = TSnap::ReorderNodes(Shuffled, norRcm, NIdMapH);
+  EXPECT_EQ(1, GetBandwidth(Rcm));
+  // the BFS order of every component is contiguous
+  PUNGraph Two = TSnap::GenRndGnm<PUNGraph>(50, 200, false, TInt::Rnd);
+  for (int n = 0; n < 50; n++) { Two->AddNode(100 + n); }
+  for (int n = 0; n < 50; n++) { Two->AddEdge(100 + n, 100 + (n+1) % 50); }
+  TIntV NIdV;
+  TSnap::GetNodeOrder(Two, norBfs, NIdV);
+  int Switches = 0;
+  for (int i = 1; i < NIdV.Len(); i++) {
+    if ((NIdV[i-1] >= 100) != (NIdV[i] >= 100)) { Switches++; } }
+  EXPECT_EQ(1, Switches);
+}
+
+// Gorder places the nodes of a clique next to each other
+TEST(ReorderTest, Gorder) {
+  PUNGraph Graph = TUNGraph::New();
+  for (int n = 0; n < 20; n++) { Graph->AddNode(n); }
+  // four cliques of five nodes with interleaved ids
+  for (int u = 0; u < 20; u++) {
+    for (int v = u+1; v < 20; v++) {
+      if (u % 4 == v % 4) { Graph->AddEdge(u, v); } }
+  }
+  TIntV NIdV;
+  TSnap::GetNodeOrder(Graph, norGorder, NIdV);
+  ASSERT_EQ(20, NIdV.Len());
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(NIdV[i - i % 5] % 4, NIdV[i] % 4);
+  }
+}
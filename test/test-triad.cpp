@@ -527,6 +527,61 @@ TEST(triad, TestGetLen2Paths) {
   }
 }
 
+// Compare TTriangleCnt to the hash table based GetTriads_v0()
+template <class PGraph>
+void TestTriangleCnt(const PGraph& Graph) {
+  TIntTrV ExpV, NIdCOTriadV;
+  TSnap::GetTriads_v0(Graph, ExpV, -1);
+  THash<TInt, TIntTr> ExpH;
+  int64 ExpTriangles = 0;
+  for (int i = 0; i < ExpV.Len(); i++) {
+    ExpH.AddDat(ExpV[i].Val1, ExpV[i]);
+    ExpTriangles += ExpV[i].Val2;
+  }
+  TTriangleCnt TriangleCnt(Graph);
+  EXPECT_EQ(ExpTriangles / 3, TriangleCnt.GetTriangles());
+  EXPECT_EQ(ExpTriangles / 3, TSnap::GetTriangleCnt(Graph));
+  TriangleCnt.GetNodeTriads(NIdCOTriadV);
+  EXPECT_EQ(Graph->GetNodes(), NIdCOTriadV.Len());
+  for (int i = 0; i < NIdCOTriadV.Len(); i++) {
+    EXPECT_EQ(ExpH.GetDat(NIdCOTriadV[i].Val1), NIdCOTriadV[i]);
+  }
+  // sampled nodes are counted without the engine
+  TSnap::GetTriads(Graph, NIdCOTriadV, 50);
+  EXPECT_EQ(50, NIdCOTriadV.Len());
+  for (int i = 0; i < NIdCOTriadV.Len(); i++) {
+    EXPECT_EQ(ExpH.GetDat(NIdCOTriadV[i].Val1), NIdCOTriadV[i]);
+  }
+  TIntFltH NIdCCfH;
+  TriangleCnt.GetNodeClustCf(NIdCCfH);
+  EXPECT_NEAR(TSnap::GetClustCf(Graph), TriangleCnt.GetClustCf(), 1e-12);
+}
+
+// Test triangle counting engine on random graphs
+TEST(triad, TestTriangleCnt) {
+  TestTriangleCnt(TSnap::GenRndGnm<PUNGraph>(500, 5000, false, TInt::Rnd));
+  // out- and in-neighbors are merged into one list
+  TestTriangleCnt(TSnap::GenRndGnm<PNGraph>(500, 5000, true, TInt::Rnd));
+  // skewed degrees exercise galloping intersection
+  TestTriangleCnt(TSnap::GenRMat(1 << 12, 1 << 16, 0.6, 0.15, 0.15, TInt::Rnd));
+  // multi-edges and self-loops are ignored
+  PNEGraph Graph = TSnap::GenRndGnm<PNEGraph>(300, 3000, true, TInt::Rnd);
+  for (int i = 0; i < 100; i++) {
+    Graph->AddEdge(i, (i * 7) % 300);
+    Graph->AddEdge(i, i);
+  }
+  TestTriangleCnt(Graph);
+
+  // intersection of sorted vectors
+  TIntV AV, BV, CmnV(3);
+  AV.Add(5);  AV.Add(40);  AV.Add(1000);
+  for (int i = 0; i < 600; i++) { BV.Add(2*i); }
+  EXPECT_EQ(2, TTriangleCnt::GetCmnCnt(AV.BegI(), AV.Len(), BV.BegI(), BV.Len(), CmnV.BegI()));
+  EXPECT_EQ(40, CmnV[0]);
+  EXPECT_EQ(2, TTriangleCnt::GetCmnCnt(BV.BegI(), BV.Len(), AV.BegI(), AV.Len()));
+  EXPECT_EQ(600, TTriangleCnt::GetCmnCnt(BV.BegI(), BV.Len(), BV.BegI(), BV.Len()));
+}
+
 // Helper: Testing Opened/Closed Triads for Specific Generated Graph
 void TestOpenCloseVector(TIntTrV& NIdCOTriadV) {
   for (TIntTr *Vec = NIdCOTriadV.BegI(); Vec < NIdCOTriadV.EndI(); Vec++) {
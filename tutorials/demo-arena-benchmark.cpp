@@ -0,0 +1,80 @@
+#include "Snap.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+// build time and memory of TUNGraph and TNGraph with the adjacency vectors in
+// the arena (the default) and in one heap allocation per node; every graph is
+// built in its own process, so that its resident memory can be measured
+
+// resident memory of the process in MB
+double GetRssMB() {
+  FILE* F = fopen("/proc/self/statm", "r");
+  if (F == NULL) { return 0.0; }
+  long Pages = 0, RssPages = 0;
+  if (fscanf(F, "%ld %ld", &Pages, &RssPages) != 2) { RssPages = 0; }
+  fclose(F);
+  return double(RssPages) * sysconf(_SC_PAGESIZE) / double(1<<20);
+}
+
+// peak resident memory of the process in MB
+double GetPeakRssMB() {
+  struct rusage Usage;
+  getrusage(RUSAGE_SELF, &Usage);
+  return Usage.ru_maxrss / 1024.0;
+}
+
+template <class PGraph>
+void BuildBench(const char* Nm, const bool& UseArena, const int& Nodes, const int& Edges) {
+  TIntPrV EdgeV(Edges, 0);
+  TRnd Rnd(0);
+  for (int i = 0; i < Edges; i++) {
+    // skewed degrees: low node ids are the hubs
+    const int SrcNId = int(Nodes * pow(Rnd.GetUniDev(), 3.0));
+    EdgeV.Add(TIntPr(SrcNId, Rnd.GetUniDevInt(Nodes))); }
+  const double Rss0 = GetRssMB();
+  PGraph Graph = PGraph::TObj::New();
+  Graph->SetArena(UseArena);
+  double T0 = omp_get_wtime();
+  for (int i = 0; i < Edges; i++) {
+    Graph->AddEdge2(EdgeV[i].Val1, EdgeV[i].Val2); }
+  const double BuildSecs = omp_get_wtime() - T0;
+  const double BuildRss = GetRssMB() - Rss0;
+  // deleted nodes leave holes in the node table and the adjacency vectors
+  for (int NId = 0; NId < Nodes; NId += 10) {
+    if (Graph->IsNode(NId)) { Graph->DelNode(NId); } }
+  T0 = omp_get_wtime();
+  Graph->Defrag();
+  const double DefragSecs = omp_get_wtime() - T0;
+  printf("  %-8s %-5s build %7.2fs %9.1f MB   defrag %6.2fs %9.1f MB   peak %9.1f MB\n",
+    Nm, UseArena ? "arena" : "heap", BuildSecs, BuildRss, DefragSecs,
+    GetRssMB() - Rss0, GetPeakRssMB() - Rss0);
+  fflush(stdout);
+}
+
+// runs Bench in a child process
+void RunBench(void (*Bench)(const char*, const bool&, const int&, const int&),
+ const char* Nm, const bool& UseArena, const int& Nodes, const int& Edges) {
+#ifndef _WIN32
+  fflush(stdout);
+  const pid_t Pid = fork();
+  if (Pid == 0) { Bench(Nm, UseArena, Nodes, Edges);  _exit(0); }
+  int Status;
+  waitpid(Pid, &Status, 0);
+#else
+  Bench(Nm, UseArena, Nodes, Edges);
+#endif
+}
+
+int main(int argc, char* argv[]) {
+  const int Nodes = argc > 1 ? TStr(argv[1]).GetInt() : 1 << 22;
+  const int AvgDeg = argc > 2 ? TStr(argv[2]).GetInt() : 8;
+  printf("%d nodes, %d edges (memory is resident memory above the edge list)\n", Nodes, Nodes*AvgDeg);
+  for (int UseArena = 0; UseArena < 2; UseArena++) {
+    RunBench(BuildBench<PUNGraph>, "TUNGraph", UseArena == 1, Nodes, Nodes*AvgDeg); }
+  for (int UseArena = 0; UseArena < 2; UseArena++) {
+    RunBench(BuildBench<PNGraph>, "TNGraph", UseArena == 1, Nodes, Nodes*AvgDeg); }
+  return 0;
+}
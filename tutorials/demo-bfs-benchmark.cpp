@@ -0,0 +1,101 @@
+#include "Snap.h"
+
+// runs BFS from the same start nodes with DoBfs(), DoBfsHybrid() and DoBfsMP()
+template <class PGraph>
+void BfsBench(const PGraph& Graph, const TStr& GraphNm, const int& NTestNodes) {
+  TBreathFS<PGraph> BFS(Graph);
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  TRnd Rnd(0);
+  NIdV.Shuffle(Rnd);
+  const int Tests = TMath::Mn(NTestNodes, NIdV.Len());
+  printf("%-8s nodes %d, edges %d, %d start nodes\n", GraphNm.CStr(), Graph->GetNodes(), Graph->GetEdges(), Tests);
+  int64 Visited1 = 0, Visited2 = 0, Visited3 = 0;
+  uint64 T0 = TTm::GetCurUniMSecs();
+  for (int i = 0; i < Tests; i++) {
+    BFS.DoBfs(NIdV[i], true, false);  Visited1 += BFS.GetNVisited(); }
+  uint64 T1 = TTm::GetCurUniMSecs();
+  for (int i = 0; i < Tests; i++) {
+    BFS.DoBfsHybrid(NIdV[i], true, false);  Visited2 += BFS.GetNVisited(); }
+  uint64 T2 = TTm::GetCurUniMSecs();
+  TIntV HopCntV;
+  for (int i = 0; i < Tests; i++) {
+    BFS.DoBfsMP(NIdV[i], true, false, -1, TInt::Mx, false);
+    BFS.GetHopCntV(HopCntV);
+    for (int h = 0; h < HopCntV.Len(); h++) { Visited3 += HopCntV[h]; }
+  }
+  uint64 T3 = TTm::GetCurUniMSecs();
+  const double Secs1 = TMath::Mx(T1 - T0, uint64(1)) / 1000.0;
+  const double Secs2 = TMath::Mx(T2 - T1, uint64(1)) / 1000.0;
+  const double Secs3 = TMath::Mx(T3 - T2, uint64(1)) / 1000.0;
+  printf("%-8s DoBfs       %7.3fs\n", GraphNm.CStr(), Secs1);
+  printf("%-8s DoBfsHybrid %7.3fs, speedup %.2fx\n", GraphNm.CStr(), Secs2, Secs1 / Secs2);
+  printf("%-8s DoBfsMP     %7.3fs, speedup %.2fx\n", GraphNm.CStr(), Secs3, Secs1 / Secs3);
+  if (Visited1 != Visited2 || Visited1 != Visited3) {
+    printf("*** visited nodes differ\n");
+  }
+  // effective diameter, now computed with DoBfsMP()
+  T0 = TTm::GetCurUniMSecs();
+  double EffDiam, AvgSPL;
+  int FullDiam;
+  TSnap::GetBfsEffDiam(Graph, Tests, false, EffDiam, FullDiam, AvgSPL);
+  T1 = TTm::GetCurUniMSecs();
+  printf("%-8s GetBfsEffDiam %7.3fs, effective diameter %.3f, diameter %d\n", GraphNm.CStr(), (T1 - T0) / 1000.0, EffDiam, FullDiam);
+}
+
+// computes the hop counts from many start nodes one by one and with the multi-source BFS
+template <class PGraph>
+void MsBfsBench(const PGraph& Graph, const TStr& GraphNm, const int& NTestNodes) {
+  TBreathFS<PGraph> BFS(Graph);
+  TIntV NIdV, HopCntV;
+  Graph->GetNIdV(NIdV);
+  TRnd Rnd(0);
+  NIdV.Shuffle(Rnd);
+  NIdV.Reduce(TMath::Mn(NTestNodes, NIdV.Len()));
+  int64 Visited1 = 0, Visited2 = 0;
+  uint64 T0 = TTm::GetCurUniMSecs();
+  for (int i = 0; i < NIdV.Len(); i++) {
+    BFS.DoBfsMP(NIdV[i], true, false, -1, TInt::Mx, false);
+    BFS.GetHopCntV(HopCntV);
+    for (int h = 0; h < HopCntV.Len(); h++) { Visited1 += HopCntV[h]; }
+  }
+  uint64 T1 = TTm::GetCurUniMSecs();
+  TVec<TIntV> HopCntVV;
+  BFS.DoMsBfs(NIdV, true, false, HopCntVV);
+  for (int i = 0; i < HopCntVV.Len(); i++) {
+    for (int h = 0; h < HopCntVV[i].Len(); h++) { Visited2 += HopCntVV[i][h]; }
+  }
+  uint64 T2 = TTm::GetCurUniMSecs();
+  const double Secs1 = TMath::Mx(T1 - T0, uint64(1)) / 1000.0;
+  const double Secs2 = TMath::Mx(T2 - T1, uint64(1)) / 1000.0;
+  printf("%-8s %d start nodes\n", GraphNm.CStr(), NIdV.Len());
+  printf("%-8s DoBfsMP     %7.3fs\n", GraphNm.CStr(), Secs1);
+  printf("%-8s DoMsBfs     %7.3fs, speedup %.2fx\n", GraphNm.CStr(), Secs2, Secs1 / Secs2);
+  if (Visited1 != Visited2) {
+    printf("*** visited nodes differ\n");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  // usage: demo-bfs-benchmark [edge list file]
+#ifdef USE_OPENMP
+  printf("threads: %d\n", omp_get_max_threads());
+#endif
+  if (argc > 1) {
+    PNGraph Graph = TSnap::LoadEdgeList<PNGraph>(argv[1]);
+    BfsBench(Graph, TStr("input"), 20);
+    BfsBench(TNCsrGraph::New(Graph), TStr("inputCsr"), 20);
+    MsBfsBench(Graph, TStr("input"), 1024);
+    return 0;
+  }
+  // random graphs as in examples/testgraph, scaled up
+  BfsBench(TSnap::GenRndGnm<PUNGraph>(1000000, 10000000, false), TStr("GnmU"), 20);
+  BfsBench(TSnap::GenRndGnm<PNGraph>(1000000, 10000000, true), TStr("GnmD"), 20);
+  // power-law RMAT graphs
+  PNGraph RMat = TSnap::GenRMat(1 << 20, 16 << 20, 0.57, 0.19, 0.19);
+  BfsBench(RMat, TStr("RMat"), 20);
+  BfsBench(TNCsrGraph::New(RMat), TStr("RMatCsr"), 20);
+  // multi-source BFS on a smaller RMAT graph
+  MsBfsBench(TSnap::GenRMat(1 << 18, 4 << 18, 0.57, 0.19, 0.19), TStr("RMat18"), 1024);
+  return 0;
+}
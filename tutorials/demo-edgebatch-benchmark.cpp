@@ -0,0 +1,62 @@
+#include "Snap.h"
+
+// time to build graphs edge by edge and with AddEdgeBatch() on an edge list with
+// skewed degrees, where the adjacency vectors of the hubs grow long
+
+// simple graphs: AddEdge2() keeps each adjacency vector sorted by insertion
+template <class PGraph>
+void SimpleBench(const char* Nm, const TIntV& SrcNIdV, const TIntV& DstNIdV) {
+  PGraph Graph = PGraph::TObj::New();
+  double T0 = omp_get_wtime();
+  for (int i = 0; i < SrcNIdV.Len(); i++) { Graph->AddEdge2(SrcNIdV[i], DstNIdV[i]); }
+  const double EdgeSecs = omp_get_wtime() - T0;
+  PGraph BatchGraph = PGraph::TObj::New();
+  T0 = omp_get_wtime();
+  BatchGraph->AddEdgeBatch(SrcNIdV, DstNIdV);
+  const double BatchSecs = omp_get_wtime() - T0;
+  printf("  %-8s AddEdge2 %7.2fs   AddEdgeBatch %7.2fs   (%d edges)\n",
+    Nm, EdgeSecs, BatchSecs, BatchGraph->GetEdges());
+  fflush(stdout);
+}
+
+// multigraphs: AddEdge() appends, with deduplication each edge is looked up first
+template <class PGraph>
+void MultiBench(const char* Nm, const TIntV& SrcNIdV, const TIntV& DstNIdV, const bool& Dedup) {
+  PGraph Graph = PGraph::TObj::New();
+  double T0 = omp_get_wtime();
+  for (int i = 0; i < SrcNIdV.Len(); i++) {
+    const int SrcNId = SrcNIdV[i], DstNId = DstNIdV[i];
+    if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
+    if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
+    if (! Dedup || ! Graph->IsEdge(SrcNId, DstNId)) { Graph->AddEdge(SrcNId, DstNId); }
+  }
+  const double EdgeSecs = omp_get_wtime() - T0;
+  PGraph BatchGraph = PGraph::TObj::New();
+  T0 = omp_get_wtime();
+  BatchGraph->AddEdgeBatch(SrcNIdV, DstNIdV, Dedup);
+  const double BatchSecs = omp_get_wtime() - T0;
+  printf("  %-8s %-7s AddEdge  %7.2fs   AddEdgeBatch %7.2fs   (%d edges)\n",
+    Nm, Dedup ? "dedup" : "", EdgeSecs, BatchSecs, BatchGraph->GetEdges());
+  fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+  const int Nodes = argc > 1 ? TStr(argv[1]).GetInt() : 1 << 18;
+  const int AvgDeg = argc > 2 ? TStr(argv[2]).GetInt() : 16;
+  const int Edges = Nodes * AvgDeg;
+  TIntV SrcNIdV(Edges), DstNIdV(Edges);
+  TRnd Rnd(0);
+  for (int i = 0; i < Edges; i++) {
+    // low node ids are the hubs
+    SrcNIdV[i] = int(Nodes * pow(Rnd.GetUniDev(), 3.0));
+    DstNIdV[i] = Rnd.GetUniDevInt(Nodes);
+  }
+  printf("%d nodes, %d edges, %d threads\n", Nodes, Edges, omp_get_max_threads());
+  SimpleBench<PUNGraph>("TUNGraph", SrcNIdV, DstNIdV);
+  SimpleBench<PNGraph>("TNGraph", SrcNIdV, DstNIdV);
+  MultiBench<PNEGraph>("TNEGraph", SrcNIdV, DstNIdV, false);
+  MultiBench<PNEGraph>("TNEGraph", SrcNIdV, DstNIdV, true);
+  MultiBench<PNEANet>("TNEANet", SrcNIdV, DstNIdV, false);
+  MultiBench<PNEANet>("TNEANet", SrcNIdV, DstNIdV, true);
+  return 0;
+}
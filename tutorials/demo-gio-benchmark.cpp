@@ -0,0 +1,63 @@
+#include "Snap.h"
+
+// Loads an edge list line by line with TSsParser and AddEdge(), the sequential reference path
+template <class PGraph>
+PGraph LoadEdgeListSeq(const TStr& InFNm) {
+  TSsParser Ss(InFNm, ssfWhiteSep, true, true, true);
+  PGraph Graph = PGraph::TObj::New();
+  int SrcNId, DstNId;
+  while (Ss.Next()) {
+    if (! Ss.GetInt(0, SrcNId) || ! Ss.GetInt(1, DstNId)) { continue; }
+    if (! Graph->IsNode(SrcNId)) { Graph->AddNode(SrcNId); }
+    if (! Graph->IsNode(DstNId)) { Graph->AddNode(DstNId); }
+    Graph->AddEdge(SrcNId, DstNId);
+  }
+  Graph->Defrag();
+  return Graph;
+}
+
+// compares the sequential and the parallel edge list loader
+template <class PGraph>
+void LoadBench(const TStr& InFNm, const TStr& GraphNm, const int& Lines) {
+  uint64 T0 = TTm::GetCurUniMSecs();
+  PGraph Graph1 = LoadEdgeListSeq<PGraph>(InFNm);
+  uint64 T1 = TTm::GetCurUniMSecs();
+  PGraph Graph2 = TSnap::LoadEdgeList<PGraph>(InFNm);
+  uint64 T2 = TTm::GetCurUniMSecs();
+  const double Secs1 = TMath::Mx(T1 - T0, uint64(1)) / 1000.0;
+  const double Secs2 = TMath::Mx(T2 - T1, uint64(1)) / 1000.0;
+  printf("%-8s nodes %d, edges %d\n", GraphNm.CStr(), Graph2->GetNodes(), Graph2->GetEdges());
+  printf("%-8s sequential %7.3fs %10.0f lines/s\n", GraphNm.CStr(), Secs1, Lines / Secs1);
+  printf("%-8s parallel   %7.3fs %10.0f lines/s, speedup %.2fx\n", GraphNm.CStr(), Secs2, Lines / Secs2, Secs1 / Secs2);
+  if (Graph1->GetNodes() != Graph2->GetNodes() || Graph1->GetEdges() != Graph2->GetEdges()) {
+    printf("*** graphs differ\n");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  // usage: demo-gio-benchmark [edge list file]
+  TStr InFNm = argc > 1 ? TStr(argv[1]) : TStr("demo-gio-benchmark.dat");
+  int Lines = 0;
+  if (argc <= 1) {
+    const int Nodes = 1000000, Edges = 10000000;
+    printf("generating %d random edges on %d nodes\n", Edges, Nodes);
+    TRnd Rnd(0);
+    TFOut FOut(InFNm);
+    FOut.PutStr("# Random edge list for the edge list loader benchmark\n");
+    for (int e = 0; e < Edges; e++) {
+      FOut.PutStr(TStr::Fmt("%d\t%d\n", Rnd.GetUniDevInt(Nodes), Rnd.GetUniDevInt(Nodes)));
+    }
+    Lines = Edges;
+  } else {
+    TIntV SrcNIdV, DstNIdV;
+    TSnap::LoadEdgeListV(InFNm, SrcNIdV, DstNIdV);
+    Lines = SrcNIdV.Len();
+  }
+#ifdef USE_OPENMP
+  printf("threads: %d\n", omp_get_max_threads());
+#endif
+  LoadBench<PUNGraph>(InFNm, "TUNGraph", Lines);
+  LoadBench<PNGraph>(InFNm, "TNGraph", Lines);
+  LoadBench<PNEANet>(InFNm, "TNEANet", Lines);
+  return 0;
+}
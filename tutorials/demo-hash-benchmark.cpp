@@ -0,0 +1,78 @@
+#include "Snap.h"
+
+// microbenchmarks of THash, THashFlat and THashMP on integer keys
+
+// adds KeyV to an empty table, then looks up every key in the order of LookupV and as many absent keys;
+// THashMP does not grow, so it is sized in advance (Presize)
+template <class THashT>
+void HashBench(const TStr& HashNm, const TIntV& KeyV, const TIntV& LookupV, const TIntV& MissV,
+    const int& Rounds, const bool& Presize, const bool& DoMiss) {
+  double AddSecs = 0, HitSecs = 0, MissSecs = 0;
+  int64 Sum = 0;
+  for (int r = 0; r < Rounds; r++) {
+    THashT Hash;
+    if (Presize) { Hash.Gen(KeyV.Len()); }
+    TExeTm ExeTm;
+    for (int i = 0; i < KeyV.Len(); i++) { Hash.AddDat(KeyV[i], i); }
+    AddSecs += ExeTm.GetSecs();  ExeTm.Tick();
+    for (int i = 0; i < LookupV.Len(); i++) { Sum += Hash.GetDat(LookupV[i]); }
+    HitSecs += ExeTm.GetSecs();  ExeTm.Tick();
+    for (int i = 0; DoMiss && i < MissV.Len(); i++) { Sum += Hash.IsKey(MissV[i]); }
+    MissSecs += ExeTm.GetSecs();
+  }
+  const double Ops = double(KeyV.Len()) * Rounds / 1e6;
+  printf("  %-10s add %7.1f  hit %7.1f  miss %7.1f  Mops/s  (%s)\n", HashNm.CStr(),
+    Ops / AddSecs, Ops / HitSecs, DoMiss ? Ops / MissSecs : 0.0, TUInt64::GetStr(Sum).CStr());
+}
+
+// deletes and re-adds random keys in a full table
+template <class THashT>
+void ChurnBench(const TStr& HashNm, const TIntV& KeyV, const int& Ops) {
+  THashT Hash;
+  for (int i = 0; i < KeyV.Len(); i++) { Hash.AddDat(KeyV[i], i); }
+  TRnd Rnd(1);
+  TExeTm ExeTm;
+  for (int i = 0; i < Ops; i++) {
+    const int Key = KeyV[Rnd.GetUniDevInt(KeyV.Len())];
+    Hash.DelKey(Key);
+    Hash.AddDat(Key, i);
+  }
+  printf("  %-10s delete+add %7.1f Mops/s  (%d)\n", HashNm.CStr(), Ops / 1e6 / ExeTm.GetSecs(), Hash.Len());
+}
+
+void KeyBench(const TStr& KeysNm, const TIntV& KeyV, const int& Rounds, const bool& DenseIds) {
+  TIntV LookupV(KeyV), MissV;
+  TRnd Rnd(0);
+  LookupV.Shuffle(Rnd);
+  TIntSet KeySet(KeyV);
+  while (MissV.Len() < KeyV.Len()) {
+    const int Key = Rnd.GetUniDevInt(TInt::Mx);
+    if (! KeySet.IsKey(Key)) { MissV.Add(Key); }
+  }
+  printf("%s, %d keys\n", KeysNm.CStr(), KeyV.Len());
+  HashBench<TIntIntH>("THash", KeyV, LookupV, MissV, Rounds, false, true);
+  HashBench<TIntIntFH>("THashFlat", KeyV, LookupV, MissV, Rounds, false, true);
+#ifdef GCC_ATOMIC
+  // dense ids fill one run of the linear probing table of THashMP, a miss then scans it (not measured)
+  HashBench<THashMP<TInt, TInt> >("THashMP", KeyV, LookupV, MissV, Rounds, true, ! DenseIds);
+#endif
+  ChurnBench<TIntIntH>("THash", KeyV, KeyV.Len());
+  ChurnBench<TIntIntFH>("THashFlat", KeyV, KeyV.Len());
+}
+
+int main(int argc, char* argv[]) {
+  const int MxKeys = argc > 1 ? TStr(argv[1]).GetInt() : 1 << 23;
+  for (int Keys = 1 << 10; Keys <= MxKeys; Keys *= 32) {
+    const int Rounds = TMath::Mx(1, (1 << 22) / Keys);
+    // node ids of a loaded graph: 0..N-1, and sparse random ids
+    TIntV KeyV(Keys, 0);
+    for (int i = 0; i < Keys; i++) { KeyV.Add(i); }
+    KeyBench("dense ids", KeyV, Rounds, true);
+    TRnd Rnd(1);
+    TIntSet KeySet(Keys);
+    while (KeySet.Len() < Keys) { KeySet.AddKey(Rnd.GetUniDevInt(TInt::Mx)); }
+    KeySet.GetKeyV(KeyV);
+    KeyBench("random ids", KeyV, Rounds, false);
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include "Snap.h"
+
+// throughput of the concurrent hash tables from 1 to 64 threads: node insertion and
+// edge deduplication on a random edge list, and grouping of an int column of TTable
+
+#ifdef GCC_ATOMIC
+// THashMP can not grow, it is sized to the number of keys as TNGraphMP and ToGraphMP do;
+// AddKey12() is the find-or-add of TNGraphMP
+int AddMP(THashMP<TInt, TInt>& Hash, const TInt& Key) {
+  bool Found = false;
+  Hash.AddKey12(abs(Key.GetPrimHashCd() % Hash.GetMxKeyIds()), Key, Found);
+  return Found ? 0 : 1;
+}
+int AddMP(THashMP<TIntPr, TInt>& Hash, const TIntPr& Key) {
+  bool Found = false;
+  Hash.AddKey12(abs(Key.GetPrimHashCd() % Hash.GetMxKeyIds()), Key, Found);
+  return Found ? 0 : 1;
+}
+int AddMP(THashMPGrow<TInt, TInt>& Hash, const TInt& Key) {
+  bool Found;
+  Hash.AddKey(Key, Found);
+  return Found ? 0 : 1;
+}
+int AddMP(THashMPGrow<TIntPr, TInt>& Hash, const TIntPr& Key) {
+  bool Found;
+  Hash.AddKey(Key, Found);
+  return Found ? 0 : 1;
+}
+
+// adds both endpoints of every edge, returns the number of nodes
+template <class THashT>
+int AddNodes(THashT& Hash, const TIntPrV& EdgeV) {
+  int Nodes = 0;
+  #pragma omp parallel for schedule(dynamic, 10000) reduction(+:Nodes)
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    Nodes += AddMP(Hash, EdgeV[i].Val1) + AddMP(Hash, EdgeV[i].Val2); }
+  return Nodes;
+}
+
+// adds every edge, returns the number of distinct edges
+template <class THashT>
+int AddEdges(THashT& Hash, const TIntPrV& EdgeV) {
+  int Edges = 0;
+  #pragma omp parallel for schedule(dynamic, 10000) reduction(+:Edges)
+  for (int i = 0; i < EdgeV.Len(); i++) {
+    Edges += AddMP(Hash, EdgeV[i]); }
+  return Edges;
+}
+
+void PrintRate(const char* Nm, const int& Threads, const int& Ops, const double& Secs, const int& Keys) {
+  printf("  %-28s %2d threads %8.2f Mops/s  (%d keys)\n", Nm, Threads, Ops / 1e6 / Secs, Keys);
+}
+
+void GraphBench(const TIntPrV& EdgeV, const int& Nodes, const int& MxThreads) {
+  printf("edge list: %d edges on %d node ids\n", EdgeV.Len(), Nodes);
+  for (int Threads = 1; Threads <= MxThreads; Threads *= 2) {
+    omp_set_num_threads(Threads);
+    double T0 = omp_get_wtime();
+    { THashMP<TInt, TInt> Hash(Nodes);
+      PrintRate("nodes THashMP (sized)", Threads, 2*EdgeV.Len(), omp_get_wtime() - T0, AddNodes(Hash, EdgeV)); }
+    T0 = omp_get_wtime();
+    { THashMPGrow<TInt, TInt> Hash;
+      PrintRate("nodes THashMPGrow", Threads, 2*EdgeV.Len(), omp_get_wtime() - T0, AddNodes(Hash, EdgeV)); }
+    T0 = omp_get_wtime();
+    { THashMP<TIntPr, TInt> Hash(EdgeV.Len());
+      PrintRate("edges THashMP (sized)", Threads, EdgeV.Len(), omp_get_wtime() - T0, AddEdges(Hash, EdgeV)); }
+    T0 = omp_get_wtime();
+    { THashMPGrow<TIntPr, TInt> Hash;
+      PrintRate("edges THashMPGrow", Threads, EdgeV.Len(), omp_get_wtime() - T0, AddEdges(Hash, EdgeV)); }
+  }
+}
+
+// counts the rows of each group; with MP on, Aggregate sorts the packed group keys with parallel radix passes
+void GroupBench(const int& Rows, const int& Groups, const int& MxThreads) {
+  TTableContext Context;
+  TIntIntH RowH(Rows);
+  TRnd Rnd(1);
+  for (int i = 0; i < Rows; i++) { RowH.AddDat(i, Rnd.GetUniDevInt(Groups)); }
+  printf("table: %d rows in up to %d groups\n", Rows, Groups);
+  TStrV GroupByV;  GroupByV.Add("Group");
+  for (int Threads = 1; Threads <= MxThreads; Threads *= 2) {
+    omp_set_num_threads(Threads);
+    TTable::SetMP(Threads > 1 ? 1 : 0);
+    PTable Table = TTable::New(RowH, "Row", "Group", &Context);
+    const double T0 = omp_get_wtime();
+    Table->Aggregate(GroupByV, aaCount, "Row", "Count");
+    PrintRate(Threads > 1 ? "group by TTable MP" : "group by TTable", Threads, Rows, omp_get_wtime() - T0, Groups);
+  }
+  TTable::SetMP(1);
+}
+#endif // GCC_ATOMIC
+
+int main(int argc, char* argv[]) {
+#ifdef GCC_ATOMIC
+  const int Edges = argc > 1 ? TStr(argv[1]).GetInt() : 1 << 24;
+  const int MxThreads = argc > 2 ? TStr(argv[2]).GetInt() : 64;
+  // a sparse graph with some repeated edges, and a table with few and with many groups
+  const int Nodes = Edges / 8;
+  TIntPrV EdgeV(Edges, 0);
+  TRnd Rnd(0);
+  for (int i = 0; i < Edges; i++) {
+    const int Src = Rnd.GetUniDevInt(Nodes);
+    EdgeV.Add(TIntPr(Src, i % 4 == 0 ? (Src + 1) % Nodes : Rnd.GetUniDevInt(Nodes)));
+  }
+  GraphBench(EdgeV, Nodes, MxThreads);
+  GroupBench(Edges / 4, 1000, MxThreads);
+  GroupBench(Edges / 4, Edges / 16, MxThreads);
+#else
+  printf("needs OpenMP and GCC atomics\n");
+#endif // GCC_ATOMIC
+  return 0;
+}
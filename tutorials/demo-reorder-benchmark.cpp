@@ -0,0 +1,58 @@
+#include "Snap.h"
+
+// times BFS from the same start nodes and PageRank on a graph
+template <class PGraph>
+void TraverseBench(const PGraph& Graph, const TIntV& StartNIdV, const TStr& GraphNm, const TStr& OrderNm, const double& ReorderSecs) {
+  TBreathFS<PGraph> BFS(Graph);
+  int64 Visited = 0;
+  uint64 T0 = TTm::GetCurUniMSecs();
+  for (int i = 0; i < StartNIdV.Len(); i++) {
+    BFS.DoBfs(StartNIdV[i], true, true);  Visited += BFS.GetNVisited(); }
+  uint64 T1 = TTm::GetCurUniMSecs();
+  TIntFltH PRankH;
+  TSnap::GetPageRank(Graph, PRankH, 0.85, 1e-4, 10);
+  uint64 T2 = TTm::GetCurUniMSecs();
+  printf("%-8s %-8s reorder %7.3fs  BFS %7.3fs  PageRank %7.3fs  (%s visited)\n", GraphNm.CStr(), OrderNm.CStr(),
+    ReorderSecs, (T1 - T0) / 1000.0, (T2 - T1) / 1000.0, TUInt64::GetStr(Visited).CStr());
+}
+
+// compares the input order, a random order and the locality orders
+template <class PGraph>
+void ReorderBench(const PGraph& Graph, const TStr& GraphNm, const int& NTestNodes) {
+  printf("%-8s nodes %d, edges %d\n", GraphNm.CStr(), Graph->GetNodes(), Graph->GetEdges());
+  TIntV NIdV;
+  Graph->GetNIdV(NIdV);
+  TRnd Rnd(0);
+  NIdV.Shuffle(Rnd);
+  TIntV StartNIdV(NIdV);
+  StartNIdV.Reduce(TMath::Mn(NTestNodes, NIdV.Len()));
+  TIntIntH NIdMapH;
+  // the input ids, then random ids as a graph loaded from an arbitrary file would have
+  TraverseBench(Graph, StartNIdV, GraphNm, "input", 0.0);
+  PGraph RndGraph = TSnap::ReorderNodes(Graph, NIdV, NIdMapH);
+  for (int i = 0; i < StartNIdV.Len(); i++) { StartNIdV[i] = NIdMapH.GetDat(StartNIdV[i]); }
+  TraverseBench(RndGraph, StartNIdV, GraphNm, "random", 0.0);
+  const TNodeOrder Orders[] = { norDegree, norRcm, norBfs, norGorder };
+  const char* OrderNms[] = { "degree", "rcm", "bfs", "gorder" };
+  for (int o = 0; o < 4; o++) {
+    uint64 T0 = TTm::GetCurUniMSecs();
+    PGraph NewGraph = TSnap::ReorderNodes(RndGraph, Orders[o], NIdMapH);
+    uint64 T1 = TTm::GetCurUniMSecs();
+    TIntV NewStartNIdV;
+    for (int i = 0; i < StartNIdV.Len(); i++) { NewStartNIdV.Add(NIdMapH.GetDat(StartNIdV[i])); }
+    TraverseBench(NewGraph, NewStartNIdV, GraphNm, OrderNms[o], (T1 - T0) / 1000.0);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  // usage: demo-reorder-benchmark [edge list file]
+  if (argc > 1) {
+    ReorderBench(TSnap::LoadEdgeList<PNGraph>(argv[1]), TStr("input"), 20);
+    return 0;
+  }
+  ReorderBench(TSnap::LoadEdgeList<PUNGraph>("../examples/as20graph.txt"), TStr("as20"), 500);
+  // power-law RMAT graphs
+  ReorderBench(TSnap::GenRMat(1 << 18, 4 << 20, 0.57, 0.19, 0.19), TStr("RMat"), 20);
+  ReorderBench(TSnap::ConvertGraph<PUNGraph>(TSnap::GenRMat(1 << 18, 4 << 20, 0.57, 0.19, 0.19)), TStr("RMatU"), 20);
+  return 0;
+}
@@ -0,0 +1,127 @@
+#include "Snap.h"
+
+// time of TTable selections and column arithmetic on a table with two int columns
+// and a float column, of grouping and aggregation, and of joins of two edge tables
+
+PTable GetTable(TTableContext& Context, const int& Rows) {
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("A", atInt));
+  S.Add(TPair<TStr,TAttrType>("B", atInt));
+  S.Add(TPair<TStr,TAttrType>("X", atFlt));
+  PTable T = TTable::New(S, &Context);
+  TRnd Rnd(1);
+  for (int i = 0; i < Rows; i++) {
+    TTableRow Row;
+    Row.AddInt(Rnd.GetUniDevInt(1000));  Row.AddInt(Rnd.GetUniDevInt(1000) + 1);
+    Row.AddFlt(Rnd.GetUniDev());
+    T->AddRow(Row);
+  }
+  return T;
+}
+
+PTable GetEdgeTable(TTableContext& Context, const int& Rows, const int& Seed) {
+  Schema S;
+  S.Add(TPair<TStr,TAttrType>("Src", atInt));
+  S.Add(TPair<TStr,TAttrType>("Dst", atInt));
+  PTable T = TTable::New(S, &Context);
+  TRnd Rnd(Seed);
+  for (int i = 0; i < Rows; i++) {
+    TTableRow Row;
+    Row.AddInt(Rnd.GetUniDevInt(Rows));  Row.AddInt(Rnd.GetUniDevInt(Rows));
+    T->AddRow(Row);
+  }
+  return T;
+}
+
+int main(int argc, char* argv[]) {
+  const int Rows = argc > 1 ? TStr(argv[1]).GetInt() : 1 << 23;
+  TTableContext Context;
+  PTable T = GetTable(Context, Rows);
+  printf("%d rows, %d threads\n", Rows, omp_get_max_threads());
+
+  TIntV SelV;
+  PTable Empty;
+  double T0 = omp_get_wtime();
+  T->SelectAtomicConst("A", TPrimitive(TInt(500)), LT, SelV, Empty, false, false);
+  printf("  SelectAtomicConst int rows      %7.3fs   (%d rows)\n", omp_get_wtime() - T0, SelV.Len());
+  SelV.Clr();
+  T0 = omp_get_wtime();
+  T->SelectAtomicConst("X", TPrimitive(TFlt(0.5)), GTE, SelV, Empty, false, false);
+  printf("  SelectAtomicConst flt rows      %7.3fs   (%d rows)\n", omp_get_wtime() - T0, SelV.Len());
+  SelV.Clr();
+  T0 = omp_get_wtime();
+  T->SelectAtomic("A", "B", LT, SelV, false);
+  printf("  SelectAtomic int rows           %7.3fs   (%d rows)\n", omp_get_wtime() - T0, SelV.Len());
+
+  PTable T2 = TTable::New(T->GetSchema(), &Context);
+  T0 = omp_get_wtime();
+  T->SelectAtomicIntConst("A", 500, LT, T2);
+  printf("  SelectAtomicConst int table     %7.3fs   (%d rows)\n", omp_get_wtime() - T0, T2->GetNumValidRows().Val);
+
+  // A < 500 && !(X < 0.5)
+  TPredicateNode And(AND), Not(NOT);
+  TPredicateNode ALt(TAtomicPredicate(atInt, true, LT, "A", "", 500, 0, ""));
+  TPredicateNode XLt(TAtomicPredicate(atFlt, true, LT, "X", "", 0, 0.5, ""));
+  Not.AddLeftChild(&XLt);
+  And.AddLeftChild(&ALt);  And.AddRightChild(&Not);
+  TPredicate Pred(&And);
+  SelV.Clr();
+  T0 = omp_get_wtime();
+  T->Select(Pred, SelV, false);
+  printf("  Select predicate rows           %7.3fs   (%d rows)\n", omp_get_wtime() - T0, SelV.Len());
+
+  T0 = omp_get_wtime();
+  T->ColAdd("A", "B", "Sum");
+  printf("  ColAdd int                      %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  T->ColMul("X", "A", "Prod");
+  printf("  ColMul flt                      %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  T->ColMul("X", 2.0);
+  printf("  ColMul const                    %7.3fs\n", omp_get_wtime() - T0);
+
+  T0 = omp_get_wtime();
+  T->SelectAtomicIntConst("A", 500, LT);
+  printf("  SelectAtomicConst in place      %7.3fs   (%d rows)\n", omp_get_wtime() - T0, T->GetNumValidRows().Val);
+  T0 = omp_get_wtime();
+  T->Select(Pred);
+  printf("  Select predicate in place       %7.3fs   (%d rows)\n", omp_get_wtime() - T0, T->GetNumValidRows().Val);
+  T0 = omp_get_wtime();
+  T->ColAdd("A", "B", "Sum2");
+  printf("  ColAdd int after removal        %7.3fs\n", omp_get_wtime() - T0);
+
+  PTable G = GetTable(Context, Rows);
+  TStrV GroupByA;  GroupByA.Add("A");
+  TStrV GroupByAB;  GroupByAB.Add("A");  GroupByAB.Add("B");
+  T0 = omp_get_wtime();
+  G->Group(GroupByA, "GA");
+  printf("  Group A                         %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  G->Group(GroupByAB, "GAB");
+  printf("  Group A, B                      %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  G->Aggregate(GroupByA, aaSum, "X", "SumX");
+  printf("  Aggregate sum by A              %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  G->Aggregate(GroupByAB, aaMean, "X", "MeanX");
+  printf("  Aggregate mean by A, B          %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  G->Aggregate(GroupByAB, aaMedian, "X", "MedX");
+  printf("  Aggregate median by A, B        %7.3fs\n", omp_get_wtime() - T0);
+  T0 = omp_get_wtime();
+  G->Count("B", "CntB");
+  printf("  Count B                         %7.3fs\n", omp_get_wtime() - T0);
+
+  PTable E1 = GetEdgeTable(Context, Rows / 2, 2);
+  PTable E2 = GetEdgeTable(Context, Rows / 2, 3);
+  T0 = omp_get_wtime();
+  PTable J = E1->Join("Dst", E2, "Src");
+  printf("  Join                            %7.3fs   (%d rows)\n", omp_get_wtime() - T0, J->GetNumValidRows().Val);
+  T0 = omp_get_wtime();
+  J = E1->SelfJoin("Src");
+  printf("  SelfJoin                        %7.3fs   (%d rows)\n", omp_get_wtime() - T0, J->GetNumValidRows().Val);
+  T0 = omp_get_wtime();
+  J = E1->ThresholdJoin("Src", "Dst", *E2, "Dst", "Src", 1);
+  printf("  ThresholdJoin                   %7.3fs   (%d rows)\n", omp_get_wtime() - T0, J->GetNumValidRows().Val);
+  return 0;
+}